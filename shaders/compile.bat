@@ -1,3 +1,82 @@
-C:/VulkanSDK/1.4.321.1/Bin/glslc.exe shader.vert -o vert.spv
-C:/VulkanSDK/1.4.321.1/Bin/glslc.exe shader.frag -o frag.spv
-pause
\ No newline at end of file
+@echo off
+rem Compiles every shader the engine loads into the SPIR-V binary next to its source.
+rem Finds glslc through VULKAN_SDK, else in the SDK versions the project file links against. The build
+rem runs this as a pre-build step with /nopause; a failed compile stops the build. Without any SDK the
+rem committed binaries are kept and the build goes on with a warning.
+setlocal
+set GLSLC=
+if not "%VULKAN_SDK%"=="" set GLSLC="%VULKAN_SDK%\Bin\glslc.exe"
+if not defined GLSLC for %%V in (1.4.328.1 1.4.321.1 1.4.313.2) do (
+    if not defined GLSLC if exist "C:\VulkanSDK\%%V\Bin\glslc.exe" set GLSLC="C:\VulkanSDK\%%V\Bin\glslc.exe"
+)
+if not defined GLSLC (
+    echo compile.bat: warning: no Vulkan SDK found ^(VULKAN_SDK unset, nothing under C:\VulkanSDK^); keeping the committed .spv files.
+    if not "%~1"=="/nopause" pause
+    exit /b 0
+)
+set FAILED=0
+pushd "%~dp0"
+
+rem --- Scene materials ---
+call :glslc shader.vert -o vert.spv
+call :glslc shader.frag -o frag.spv
+call :glslc phong.vert -o phong_vert.spv
+call :glslc phong.frag -o phong_frag.spv
+call :glslc base.frag -o base_frag.spv
+call :glslc sand.frag -o sand_frag.spv
+call :glslc glass.frag -o glass_frag.spv
+call :glslc water.vert -o water_vert.spv
+call :glslc water.frag -o water_frag.spv
+call :glslc transparent.frag -o transparent_frag.spv
+call :glslc shadow.vert -o shadow_vert.spv
+call :glslc shadow.frag -o shadow_frag.spv
+call :glslc depth.vert -o depth_vert.spv
+call :glslc skybox.vert -o skybox_vert.spv
+call :glslc skybox.frag -o skybox_frag.spv
+call :glslc cull.comp -o cull_comp.spv
+
+rem --- Post-processing and weighted OIT ---
+call :glslc post.vert -o post_vert.spv
+call :glslc post.frag -o post_frag.spv
+call :glslc oit_resolve.frag -o oit_resolve_frag.spv
+call :glslc glass.frag -DWEIGHTED_OIT -o glass_oit_frag.spv
+call :glslc water.frag -DWEIGHTED_OIT -o water_oit_frag.spv
+
+rem --- Particle sets: <set>_comp, _vert, _frag and _oit_frag ---
+for %%S in (dust fire smoke rain snow) do (
+    call :glslc %%S.comp -o %%S_comp.spv
+    call :glslc %%S.vert -o %%S_vert.spv
+    call :glslc %%S.frag -o %%S_frag.spv
+    call :glslc %%S.frag -DWEIGHTED_OIT -o %%S_oit_frag.spv
+)
+
+rem --- Compressed SoA layout (fire and smoke only) ---
+for %%S in (fire smoke) do (
+    call :glslc %%S.comp -DPARTICLE_SOA -o %%S_soa_comp.spv
+    call :glslc %%S.vert -DPARTICLE_SOA -o %%S_soa_vert.spv
+)
+
+rem --- Shared particle passes ---
+call :glslc spark_select.comp -o spark_select_comp.spv
+call :glslc spark_select.comp -DPARTICLE_SOA -o spark_select_soa_comp.spv
+call :glslc particle_sort.comp -o particle_sort_comp.spv
+call :glslc particle_sort.comp -DPARTICLE_SOA -o particle_sort_soa_comp.spv
+call :glslc particle_unified.comp -o particle_unified_comp.spv
+call :glslc particle_unified.vert -o particle_unified_vert.spv
+call :glslc particle_unified.frag -o particle_unified_frag.spv
+call :glslc particle_unified.frag -DWEIGHTED_OIT -o particle_unified_oit_frag.spv
+call :glslc snow_melt.comp -o snow_melt_comp.spv
+call :glslc wind_field.comp -o wind_field_comp.spv
+
+popd
+if "%FAILED%"=="1" echo compile.bat: One or more shaders failed to compile.
+if not "%~1"=="/nopause" pause
+exit /b %FAILED%
+
+:glslc
+%GLSLC% %*
+if errorlevel 1 (
+    echo compile.bat: FAILED glslc %*
+    set FAILED=1
+)
+exit /b 0
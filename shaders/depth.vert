@@ -0,0 +1,55 @@
+#version 450
+
+/**
+ * @file depth.vert
+ * @brief Position-only vertex shader for the camera depth pre-pass.
+ *
+ * Used without a fragment stage: only depth is written, so the colour pass
+ * that follows shades each visible pixel exactly once. The transform mirrors
+ * phong.vert operation for operation.
+ */
+
+// --- Inputs (Vertex Attributes) ---
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;    
+layout(location = 2) in vec2 inTexCoord; 
+layout(location = 3) in vec3 inNormal;   
+
+// --- Outputs ---
+// Must produce bit-identical depth to phong.vert for the EQUAL-tested colour pass.
+invariant gl_Position;
+
+// --- Data Structures ---
+struct SparkLight {
+    vec3 position;
+    vec3 color;
+};
+
+// --- Set 0: Global Data ---
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+    mat4 lightSpaceMatrix;
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+    int  useGouraud;
+    float time;
+    SparkLight sparks[4]; 
+} ubo;
+
+// --- Set 2: Per-Object Data (written once per frame on the CPU) ---
+struct ObjectData {
+    mat4 model;
+    mat4 normal; // transpose(inverse(model)), upper 3x3 used
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
+
+void main() {
+    // 1. CAMERA CLIP-SPACE TRANSFORMATION (identical to phong.vert)
+    vec4 worldPos = objects[gl_InstanceIndex].model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view * worldPos;
+}
\ No newline at end of file
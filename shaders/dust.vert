@@ -32,7 +32,11 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     vec3 lightColor;
     int  useGouraud;
     float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
     SparkLight sparks[4]; // Matches C++ EngineConstants::MAX_SPARKS
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
 } ubo;
 
 void main() {
@@ -52,8 +56,8 @@ void main() {
      * HABOOB MULTIPLIER (10.0): Adjusted to maintain the "dusty" density within the globe.
      * Higher multipliers result in larger "fluffy" billboards, while lower values look like fine sand.
      */
-    gl_PointSize = inPosition.w * (1.0 / dist) * 10.0;
+    gl_PointSize = inPosition.w * (1.0 / dist) * 10.0 * ubo.renderScale * ubo.particleLod.y;
 
     // Pass the compute-generated color (including alpha fade) to the fragment stage
-    fragColor = inColor; 
+    fragColor = vec4(inColor.rgb, min(inColor.a * ubo.particleLod.z, 1.0));
 }
\ No newline at end of file
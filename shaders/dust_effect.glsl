@@ -0,0 +1,87 @@
+/**
+ * @file dust_effect.glsl
+ * @brief Emission and simulation steps of the Dust Vortex effect.
+ *
+ * Included by dust.comp and by particle_unified.comp. The including shader declares the Particle
+ * struct, the ubo parameters (deltaTime, totalTime, lightColor, emitterPos) and SPAWN_RADIUS first.
+ * Light grains ride the shared wind field along with the vortex.
+ */
+
+#include "particle_common.glsl"
+#include "particle_wind.glsl"
+
+/**
+ * @brief RESPAWN LOGIC: places a recycled grain on the spawn ring at ground level.
+ */
+void emitParticle(inout Particle p, uint index) {
+    float seed        = float(index) + ubo.totalTime;
+    float angle       = hash(seed) * 6.28318;
+    float spawnRadius = 0.25 + hash(seed + 1.0) * max(SPAWN_RADIUS - 0.25, 0.0);
+    
+    p.position.x = cos(angle) * spawnRadius;
+    p.position.z = sin(angle) * spawnRadius;
+    p.position.y = 0.0;
+    
+    p.velocity.w = 0.0; // Reset age
+    p.velocity.y = 0.01 + hash(seed + 2.0) * 0.02; // Vertical drift speed
+    p.position.w = 4.0 + hash(seed + 3.0) * 4.0;   // Particle point size
+    p.color.a    = 0.2;
+}
+
+/**
+ * @brief Advances one grain; it dies at its age limit or when it reaches the centre.
+ */
+bool simulateParticle(inout Particle p, uint index) {
+    // 1. RANDOMIZED DECAY
+    // Each particle has a unique lifespan to ensure a continuous stream rather than bursts.
+    float decaySpeed = 0.15 + (hash(float(index) * 0.5) * 0.2);
+    p.velocity.w += ubo.deltaTime * decaySpeed;
+    float age = p.velocity.w;
+
+    // 2. VORTEX PHYSICS (Angular Velocity)
+    // Particles rotate around a central vertical axis.
+    vec2 center = vec2(0.0, 0.0);
+    vec2 relPos = p.position.xz - center;
+    float dist  = length(relPos);
+    
+    // Rotation speed is inversely proportional to distance (faster at the center)
+    float swirlSpeed = 0.35 / (dist + 0.2); 
+    float angleShift = ubo.deltaTime * swirlSpeed;
+    float s = sin(angleShift);
+    float c = cos(angleShift);
+    
+    // Standard 2D Rotation Matrix application
+    p.position.x = center.x + (relPos.x * c - relPos.y * s);
+    p.position.z = center.y + (relPos.x * s + relPos.y * c);
+
+    // 3. INWARD SUCTION (Centripetal Force)
+    // Pulls particles toward the center to maintain the "cone" shape of the vortex.
+    p.position.xz -= normalize(relPos) * ubo.deltaTime * 0.15;
+
+    // 4. WIND DRIFT
+    // Fine sand follows the air completely; the vertical constraint below keeps it near the ground.
+    p.position.xyz += sampleWind(p.position.xyz) * ubo.deltaTime;
+
+    // 5. VERTICAL CONSTRAINT
+    // Particles drift upward and are clamped to prevent them from exiting the snow globe.
+    p.position.y += p.velocity.y * ubo.deltaTime;
+    if (p.position.y > 0.45) p.velocity.y = -0.015; 
+    if (p.position.y < -0.05) p.position.y = 0.0;
+
+    // 6. DYNAMIC SAND COLORING
+    // Grains are randomly tinted between two desert base colors.
+    vec3 tanBase    = vec3(0.76, 0.70, 0.50);
+    vec3 brownBase  = vec3(0.55, 0.45, 0.30);
+    vec3 sandAlbedo = mix(tanBase, brownBase, hash(float(index)));
+
+    // Environmental Tinting: The dust grains reflect the project's global lightColor.
+    p.color.rgb = sandAlbedo * ubo.lightColor * 0.7;
+    
+    // Radial Fade: Masks the "singularity" at the center to prevent vertical flickering.
+    float radialFade = smoothstep(0.02, 0.15, dist);
+    // Alpha pulsates over the lifespan: Fade in -> Peak -> Fade out.
+    p.color.a = sin(age * 3.14159) * 0.4 * radialFade;
+
+    // 7. Aged out or swallowed by the centre: back to the dead list for recycling
+    return (age <= 1.0) && (dist >= 0.02);
+}
@@ -6,12 +6,19 @@
  *
  * Transforms simulated particle positions into clip space and calculates
  * perspective-accurate point sizes for the flame embers.
+ * Compiled with -DPARTICLE_SOA it reads the compressed streams and derives the
+ * thermal colour from life instead of fetching it.
  */
 
 // --- Inputs (Directly from the Storage Buffer / Vertex Input) ---
+#ifdef PARTICLE_SOA
+layout(location = 0) in vec3 inPosition; // position stream
+layout(location = 1) in vec2 inLifeSize; // half2 stream: x = life, y = size
+#else
 layout(location = 0) in vec4 inPosition; // xyz = pos, w = size
 layout(location = 1) in vec4 inVelocity; // xyz = vel, w = life
 layout(location = 2) in vec4 inColor;
+#endif
 
 // --- Outputs ---
 layout(location = 0) out vec4 fragColor;
@@ -33,10 +40,36 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     vec3 lightColor; 
     int  useGouraud; 
     float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
     SparkLight sparks[4]; // Matches Experience.h refactor
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
 } ubo;
 
+#ifdef PARTICLE_SOA
+/**
+ * @brief Thermal gradient of fire.comp: Hot (Yellow/White) -> Mid (Orange) -> Cool (Red), alpha fading with life.
+ */
+vec4 thermalColor(float life) {
+    vec3 hotColor  = vec3(1.0, 1.0, 0.7);
+    vec3 midColor  = vec3(1.0, 0.4, 0.0);
+    vec3 coolColor = vec3(0.5, 0.0, 0.0);
+
+    vec3 rgb = (life > 0.7) ? mix(midColor, hotColor, (life - 0.7) * 3.3) : mix(coolColor, midColor, life * 1.4);
+    return vec4(rgb, life * 0.8);
+}
+#endif
+
 void main() {
+#ifdef PARTICLE_SOA
+    float pointSize = inLifeSize.y;
+    vec4 color = thermalColor(inLifeSize.x);
+#else
+    float pointSize = inPosition.w;
+    vec4 color = inColor;
+#endif
+
     // 1. WORLD TO VIEW SPACE TRANSFORMATION
     vec4 viewPos = ubo.view * vec4(inPosition.xyz, 1.0);
     
@@ -48,8 +81,8 @@ void main() {
     
     // REDUCED MULTIPLIER: Use 15.0 or 20.0 instead of 50.0
     // This keeps them bulky but prevents the "white wall" effect
-    gl_PointSize = inPosition.w * (1.0 / dist) * 20.0; 
+    gl_PointSize = pointSize * (1.0 / dist) * 20.0 * ubo.renderScale * ubo.particleLod.y; 
 
     // 4. DATA PASSTHROUGH
-    fragColor = inColor;
+    fragColor = vec4(color.rgb, min(color.a * ubo.particleLod.z, 1.0));
 }
\ No newline at end of file
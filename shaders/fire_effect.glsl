@@ -0,0 +1,99 @@
+/**
+ * @file fire_effect.glsl
+ * @brief Emission and simulation steps of the Bonfire effect.
+ *
+ * Included by fire.comp and by particle_unified.comp. The including shader declares the Particle
+ * struct, the ubo parameters (deltaTime, totalTime, lightColor, emitterPos) and SPAWN_RADIUS first.
+ * Flames lean with the shared wind field; the radius profile keeps them on the fire.
+ */
+
+#include "particle_common.glsl"
+#include "particle_wind.glsl"
+
+/**
+ * @brief DIAMOND SPAWNER: places a recycled particle on the ring at the base of the fire.
+ */
+void emitParticle(inout Particle p, uint index) {
+    vec2 center = ubo.emitterPos.xz;
+    float seed  = float(index) + ubo.totalTime * 512.0; 
+    float angle = hash(seed) * 6.28318;
+    
+    p.position.x = center.x + cos(angle) * SPAWN_RADIUS;
+    p.position.y = -0.12; // Ground level height
+    p.position.z = center.y + sin(angle) * SPAWN_RADIUS;
+    
+    p.velocity.w = 1.0; // Reset life
+    
+    // Initial outward burst (clamped to prevent wide dispersion)
+    p.velocity.x = cos(angle) * 0.15;
+    p.velocity.z = sin(angle) * 0.15;
+    p.velocity.y = 0.12 + hash(seed + 3.0) * 0.15; 
+}
+
+/**
+ * @brief Advances one flame particle; it dies once its life runs out.
+ */
+bool simulateParticle(inout Particle p, uint index) {
+    // 1. LIFESPAN AND DYNAMIC DECAY
+    // Particles lose life over time based on a randomized speed for continuous flow.
+    float decaySpeed = 2.4 + (hash(float(index) * 0.1) * 1.5);
+    p.velocity.w -= ubo.deltaTime * decaySpeed;
+    float life = p.velocity.w;
+
+    // 2. THERMAL COLOR GRADIENT
+    // Interpolates through Hot (Yellow/White) -> Mid (Orange) -> Cool (Red) based on life.
+    vec3 hotColor  = vec3(1.0, 1.0, 0.7); 
+    vec3 midColor  = vec3(1.0, 0.4, 0.0); 
+    vec3 coolColor = vec3(0.5, 0.0, 0.0); 
+    
+    if (life > 0.7) {
+        p.color.rgb = mix(midColor, hotColor, (life - 0.7) * 3.3);
+    } else {
+        p.color.rgb = mix(coolColor, midColor, life * 1.4);
+    }
+    
+    // Alpha fades linearly with the remaining life
+    p.color.a = life * 0.8; 
+
+    // 3. THE BONFIRE "WHIRL" (Angular Velocity)
+    // Applies a 2D rotation matrix around the emitter origin to simulate rising heat turbulence.
+    float swirlStrength = 5.0 * life;
+    float angleShift    = ubo.deltaTime * swirlStrength;
+    float s = sin(angleShift);
+    float c = cos(angleShift);
+    
+    vec2 center = ubo.emitterPos.xz;
+    vec2 relPos = p.position.xz - center;
+    
+    p.position.x = center.x + (relPos.x * c - relPos.y * s);
+    p.position.z = center.y + (relPos.x * s + relPos.y * c);
+
+    // 4. CONTROLLED RADIUS CONVERGENCE
+    // Forces the flame into a specific profile (diamond shape) by clamping the max radius.
+    float targetRadius = 0.12 * sin(life * 3.14159); // Maximum width occurs at life 0.5
+    vec2 toCenter      = center - p.position.xz;
+    float currentDist  = length(-toCenter);
+    
+    // Pull particles inside if they drift outside the target radius profile
+    if (currentDist > targetRadius) {
+        p.position.xz += (toCenter / currentDist) * (currentDist - targetRadius) * 0.5;
+    }
+    
+    // Constant centripetal pull to ensure the flame "tips" close correctly
+    p.position.xz += toCenter * ubo.deltaTime * 5.0;
+
+    // 5. PHYSICS AND TURBULENCE
+    // Calculates randomized noise to break up mechanical regularity.
+    float noiseX = hash(p.position.x * 20.0 + ubo.totalTime);
+    float noiseZ = hash(p.position.z * 20.0 + ubo.totalTime);
+    
+    p.velocity.x += (noiseX - 0.5) * 0.15 * life; 
+    p.velocity.z += (noiseZ - 0.5) * 0.15 * life;
+
+    // Apply integrated velocity and buoyancy drift; the flame leans with a fraction of the wind
+    p.position.xyz += (p.velocity.xyz + sampleWind(p.position.xyz) * 0.3) * ubo.deltaTime;
+    p.velocity.y   += ubo.deltaTime * 0.05; 
+
+    // 6. Burned out: back to the dead list until the spawner recycles it
+    return p.velocity.w > 0.0;
+}
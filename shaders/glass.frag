@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 /**
  * @file glass.frag
@@ -42,7 +43,8 @@ layout(set = 0, binding = 1) uniform sampler2D shadowMap;
 layout(set = 0, binding = 2) uniform sampler2D sceneSampler; 
 
 // --- Outputs ---
-layout(location = 0) out vec4 outColor;
+// outColor, or the accumulation/revealage pair when compiled with -DWEIGHTED_OIT
+#include "oit.glsl"
 
 void main() {
     // 1. HORIZON CLAMP (The Experiment)
@@ -84,5 +86,5 @@ void main() {
     // too opaque or fully invisible during the 'Night' phase.
     float alpha = clamp(0.5 + (height * 0.2), 0.4, 0.7);
     
-    outColor = vec4(finalColor, alpha); 
+    writeTransparent(vec4(finalColor, alpha)); 
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ * @file oit.glsl
+ * @brief Shared output stage of the transparent shaders (glass, water and particles).
+ *
+ * Compiled normally, a transparent shader writes one straight-alpha colour that the
+ * fixed-function blender composites in draw order. Compiled with -DWEIGHTED_OIT, the
+ * same shader writes weighted blended order-independent transparency terms instead
+ * (McGuire & Bavoil, 2013):
+ *   location 0, accumulation (blend ONE, ONE):              premultiplied colour and alpha, times w
+ *   location 1, revealage    (blend ZERO, ONE_MINUS_SRC):   alpha
+ * The resolve pass divides the accumulated colour by its alpha and composites it over
+ * the opaque scene with a coverage of (1 - revealage).
+ */
+
+#ifdef WEIGHTED_OIT
+
+// --- Outputs (Weighted OIT targets) ---
+layout(location = 0) out vec4 outAccum;
+layout(location = 1) out float outReveal;
+
+/**
+ * @brief Depth/coverage weight: nearer and more opaque fragments dominate the average.
+ * The scale keeps dense particle overlap well inside the RGBA16F range.
+ */
+float oitWeight(float depth, float alpha) {
+    float coverage = min(1.0, alpha * 10.0) + 0.01;
+    float nearness = 1.0 - (depth * 0.9);
+    return clamp(pow(coverage, 3.0) * 3e3 * pow(nearness, 3.0), 1e-2, 3e2);
+}
+
+void writeTransparent(vec4 color) {
+    float w = oitWeight(gl_FragCoord.z, color.a);
+    outAccum = vec4(color.rgb * color.a, color.a) * w;
+    outReveal = color.a;
+}
+
+#else
+
+// --- Outputs (Ordered alpha blending) ---
+layout(location = 0) out vec4 outColor;
+
+void writeTransparent(vec4 color) {
+    outColor = color;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#version 450
+
+/**
+ * @file oit_resolve.frag
+ * @brief Composites the weighted blended OIT targets over the resolved opaque scene.
+ *
+ * Runs as a fullscreen triangle (post.vert) with SRC_ALPHA / ONE_MINUS_SRC_ALPHA
+ * blending into the 1x HDR resolve target, before the final post-processing pass.
+ */
+
+// --- Interpolated Inputs ---
+layout(location = 0) in vec2 inUV;
+
+// --- Outputs ---
+layout(location = 0) out vec4 outColor;
+
+// --- Set 0: Resolved OIT Targets ---
+layout(set = 0, binding = 0) uniform sampler2D accumSampler;
+layout(set = 0, binding = 1) uniform sampler2D revealSampler;
+
+void main() {
+    // 1. COVERAGE
+    // Revealage is the product of (1 - alpha) over every transparent layer.
+    float revealage = texture(revealSampler, inUV).r;
+
+    // Pixels without transparent surfaces keep the opaque scene untouched.
+    if (revealage >= 0.9999) discard;
+
+    // 2. WEIGHTED AVERAGE COLOUR
+    vec4 accum = texture(accumSampler, inUV);
+    vec3 averageColor = accum.rgb / max(accum.a, 1e-5);
+
+    outColor = vec4(averageColor, 1.0 - revealage);
+}
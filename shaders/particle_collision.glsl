@@ -0,0 +1,59 @@
+/**
+ * @file particle_collision.glsl
+ * @brief Collision of particles with the previous frame's scene depth, and the snow cover they settle into.
+ *
+ * The scene UBO and both resources come from the global scene set (Set 1 of the simulations, see
+ * particle_scene.glsl). The simulation runs before this frame's opaque pass, so the depth it samples
+ * is the previous frame's: each particle is reprojected with the view-projection that depth was
+ * rendered with and compared against one texel of it. Only particles less than SURFACE_THICKNESS behind the surface
+ * collide, so a particle that merely passes behind an object (as seen from the camera) survives.
+ * Guarded, so the unified shader gets one copy.
+ */
+
+#ifndef PARTICLE_COLLISION_GLSL
+#define PARTICLE_COLLISION_GLSL
+
+#include "particle_scene.glsl"
+#include "snow_cover.glsl"
+
+// Multisampled opaque depth of the previous frame; sample 0 is precise enough for collision
+layout(set = 1, binding = 3) uniform sampler2DMS sceneDepth;
+
+layout(std430, set = 1, binding = 4) buffer SnowCoverBlock {
+    uint snowCover[];
+};
+
+const float SURFACE_THICKNESS = 0.15;   // World depth behind a surface that still counts as inside it
+
+/**
+ * @brief Returns true if the position lies just behind the opaque surface the scene depth shows there.
+ * Positions outside the previous frame's view never collide. Costs one texel fetch.
+ */
+bool hitsSceneDepth(vec3 position) {
+    vec2 extent = scene.depthParams.xy;
+    vec4 clip = scene.depthViewProj * vec4(position, 1.0);
+    if ((extent.x <= 0.0) || (clip.w <= 0.0)) return false;
+
+    vec2 ndc = clip.xy / clip.w;
+    if (any(greaterThan(abs(ndc), vec2(1.0)))) return false;
+
+    // The depth only covers the render extent of the frame that wrote it (dynamic resolution)
+    ivec2 texel = min(ivec2((ndc * 0.5 + 0.5) * extent), ivec2(extent) - 1);
+    float depth = texelFetch(sceneDepth, texel, 0).r;
+
+    // View distance of the surface, from the projection's depth terms (proj[2][3] is -1)
+    float surfaceW = scene.depthParams.w / (depth + scene.depthParams.z);
+    return (clip.w > surfaceW) && (clip.w < surfaceW + SURFACE_THICKNESS);
+}
+
+/**
+ * @brief Adds one settled flake to the snow cover cell under the position (nothing outside the grid).
+ */
+void depositSnow(vec3 position) {
+    int cell = snowCoverCell(ivec2(floor(snowCoverCoord(position.xz))));
+    if (cell >= 0) {
+        atomicAdd(snowCover[cell], SNOW_UNITS_PER_FLAKE);
+    }
+}
+
+#endif
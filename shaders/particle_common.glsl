@@ -0,0 +1,22 @@
+/**
+ * @file particle_common.glsl
+ * @brief Helpers shared by the particle effects (the *_effect.glsl files).
+ *
+ * Guarded, so a shader that includes several effects (particle_unified.comp) gets one copy.
+ */
+
+#ifndef PARTICLE_COMMON_GLSL
+#define PARTICLE_COMMON_GLSL
+
+// --- Globe Bounds (the glass the weather effects are kept inside) ---
+const vec3 SPHERE_CENTER = vec3(0.0, -0.3, 0.0);
+const float GLOBE_RADIUS = 1.70; // Tightened from 1.75 for safety buffer (and no z-fighting with the glass)
+
+/**
+ * @brief Deterministic pseudo-random hash function.
+ */
+float hash(float n) {
+    return fract(sin(n) * 43758.5453123);
+}
+
+#endif
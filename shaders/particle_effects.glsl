@@ -0,0 +1,15 @@
+/**
+ * @file particle_effects.glsl
+ * @brief Effect ids of the unified particle path (mirrors ParticleEngine::Effect).
+ *
+ * The simulation branches on the id in each emitter's parameter block. Each emitter's draw
+ * command carries its id in firstInstance, so the vertex and fragment stages read it from
+ * gl_InstanceIndex.
+ */
+
+const uint EFFECT_DUST = 0;
+const uint EFFECT_FIRE = 1;
+const uint EFFECT_SMOKE = 2;
+const uint EFFECT_RAIN = 3;
+const uint EFFECT_SNOW = 4;
+const uint EFFECT_COUNT = 5;
@@ -0,0 +1,68 @@
+/**
+ * @file particle_layout.glsl
+ * @brief Storage layout of the particle buffer, shared by the simulation and selection shaders.
+ *
+ * Compiled normally, particles are interleaved: three std140 vec4s (48 bytes) per particle at
+ * binding 1. Compiled with -DPARTICLE_SOA, the same buffer holds three compressed streams
+ * (24 bytes per particle), each bound as its own range:
+ *   binding 1, positions: float3
+ *   binding 2, life/size: half2 (x = life, y = point size), also fetched by the vertex shader
+ *   binding 3, velocity:  half3 (the last 16 bits are unused)
+ * Colour is not stored in the compressed layout; the vertex shader derives it from life.
+ * Shaders go through loadParticle()/storeParticle() and never index the buffer directly.
+ */
+
+struct Particle {
+    vec4 position; // xyz = position, w = point size
+    vec4 velocity; // xyz = velocity, w = life
+    vec4 color;    // rgba (interleaved layout only)
+};
+
+#ifdef PARTICLE_SOA
+
+layout(std430, binding = 1) buffer PositionStream {
+    float positions[];
+};
+
+layout(std430, binding = 2) buffer LifeSizeStream {
+    uint lifeSize[];
+};
+
+layout(std430, binding = 3) buffer VelocityStream {
+    uvec2 velocities[];
+};
+
+Particle loadParticle(uint i) {
+    vec2 packedLifeSize = unpackHalf2x16(lifeSize[i]);
+    uvec2 packedVelocity = velocities[i];
+
+    Particle p;
+    p.position = vec4(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2], packedLifeSize.y);
+    p.velocity = vec4(unpackHalf2x16(packedVelocity.x), unpackHalf2x16(packedVelocity.y).x, packedLifeSize.x);
+    p.color = vec4(1.0);
+    return p;
+}
+
+void storeParticle(uint i, Particle p) {
+    positions[3 * i] = p.position.x;
+    positions[3 * i + 1] = p.position.y;
+    positions[3 * i + 2] = p.position.z;
+    lifeSize[i] = packHalf2x16(vec2(p.velocity.w, p.position.w));
+    velocities[i] = uvec2(packHalf2x16(p.velocity.xy), packHalf2x16(vec2(p.velocity.z, 0.0)));
+}
+
+#else
+
+layout(std140, binding = 1) buffer ParticleBuffer {
+    Particle particles[];
+};
+
+Particle loadParticle(uint i) {
+    return particles[i];
+}
+
+void storeParticle(uint i, Particle p) {
+    particles[i] = p;
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file particle_lists.glsl
+ * @brief Alive/dead index lists of a particle system and the counters that drive its indirect work.
+ *
+ * The list buffer holds three lists of PARTICLE_CAPACITY indices: two alive lists that swap roles
+ * every frame (the simulation reads one and appends survivors to the other) and the dead list.
+ * The state block doubles as the indirect argument buffer: the emission and simulation dispatches
+ * and the draw (vkCmdDrawIndexedIndirect over the survivor list) read their sizes straight from it.
+ * Requires PARTICLE_CAPACITY to be declared before inclusion.
+ */
+
+layout(std430, binding = 5) buffer ListState {
+    uint deadCount;            // Entries of the dead list
+    uint emitCount;            // Particles this frame emits (dead list and spawn budget permitting)
+    uint aliveCount;           // Entries of the current list: last frame's survivors plus this frame's emissions
+    uint reserved;
+    uvec4 emitDispatch;        // VkDispatchIndirectCommand (xyz) of the emission pass
+    uvec4 simulateDispatch;    // VkDispatchIndirectCommand (xyz) of the simulation pass
+    uint drawIndexCount;       // VkDrawIndexedIndirectCommand; the count doubles as the survivor counter
+    uint drawInstanceCount;
+    uint drawFirstIndex;
+    int drawVertexOffset;
+    uint drawFirstInstance;
+} state;
+
+layout(std430, binding = 6) buffer ParticleLists {
+    uint lists[];              // [alive list 0 | alive list 1 | dead list]
+};
+
+/**
+ * @brief Returns the first entry of alive list 0 or 1.
+ */
+uint aliveListBase(uint list) {
+    return list * PARTICLE_CAPACITY;
+}
+
+/**
+ * @brief Returns the first entry of the dead list.
+ */
+uint deadListBase() {
+    return 2 * PARTICLE_CAPACITY;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file particle_scene.glsl
+ * @brief The global scene UBO as the particle simulations see it.
+ *
+ * Particle simulations bind their own set at 0 and the global scene set (Set 0 of the draws) at 1.
+ * The block mirrors UniformBufferObject up to the last field a simulation reads. Guarded, so the
+ * collision and wind helpers can both include it.
+ */
+
+#ifndef PARTICLE_SCENE_GLSL
+#define PARTICLE_SCENE_GLSL
+
+struct SceneSparkLight {
+    vec3 position;
+    vec3 color;
+};
+
+// Global UBO (UniformBufferObject); the simulations read the depth reprojection and wind fields
+layout(set = 1, binding = 0) uniform SceneUniforms {
+    mat4 view;
+    mat4 proj;
+    mat4 lightSpaceMatrix;
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+    int useGouraud;
+    float time;
+    float renderScale;
+    SceneSparkLight sparks[4];
+    mat4 depthViewProj;   // View-projection the scene depth was rendered with
+    vec4 depthParams;     // Its render extent in pixels (xy, zero: no collision) and proj[2][2], proj[3][2] (zw)
+    vec4 particleLod;     // Draw-side LOD compensation (unused by the simulations)
+    float windStrength;   // Scale of the shared wind field (zero: no wind)
+} scene;
+
+#endif
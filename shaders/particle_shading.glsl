@@ -0,0 +1,159 @@
+/**
+ * @file particle_shading.glsl
+ * @brief Point-sprite shading of every particle effect, one function per effect.
+ *
+ * Each function turns the interpolated particle colour into the fragment's straight-alpha colour
+ * (or discards it); the caller hands the result to writeTransparent(). The per-effect fragment
+ * shaders call their own function, particle_unified.frag picks one per draw.
+ */
+
+/** @brief Scene depth: the shadow map binding, reused as a depth reference for soft-blending (dust). */
+layout(set = 0, binding = 1) uniform sampler2D depthMap;
+
+/**
+ * @brief Dust vortex grains: soft round clouds that fade out near scene geometry (soft particles).
+ */
+vec4 shadeDust(vec4 baseColor) {
+    // 1. CIRCULAR SHAPING
+    // gl_PointCoord provides coordinates [0, 1] across the point primitive.
+    // We shift it to [-0.5, 0.5] to calculate distance from the center.
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    float dist = length(coord);
+
+    // Hard clip outside the radius to maintain circularity
+    if (dist > 0.5) discard;
+
+    // 2. RADIAL GRADIENT (Cloud Density)
+    // Using a power of 2.0 creates a "fluffy" falloff that is denser at the center.
+    float softAlpha = pow(smoothstep(0.5, 0.0, dist), 2.0);
+    
+    // 3. SOFT PARTICLE BLENDING
+    // This prevents particles from "cutting" through the sand terrain.
+    // Calculate the screen-space UV to sample the current scene depth.
+    vec2 screenUV = gl_FragCoord.xy / textureSize(depthMap, 0);
+    float sceneDepth = texture(depthMap, screenUV).r;
+    float particleDepth = gl_FragCoord.z;
+
+    // Fade Distance: Larger values (0.01) create a smoother transition near geometry.
+    float fadeDistance = 0.01; 
+    float diff = sceneDepth - particleDepth;
+    
+    // If the particle is behind geometry (diff < 0), it is hidden.
+    // If it is near geometry, it fades out using smoothstep.
+    float softness = smoothstep(0.0, fadeDistance, diff);
+
+    // 4. FINAL COMPOSITION
+    // Base Color (from vertex) * Radial Shape * Depth Softness * Global Density Multiplier.
+    // The 0.25 multiplier ensures that overlapping dust clouds don't become oversaturated.
+    vec4 color = vec4(baseColor.rgb, baseColor.a * softAlpha * softness * 0.25);
+    
+    // Alpha Discard: Prevents invisible fragments from writing to the frame buffer.
+    if (color.a < 0.001) discard;
+
+    return color;
+}
+
+/**
+ * @brief Fire embers: a dual-layer radial falloff with an exponential HDR boost in the core.
+ */
+vec4 shadeFire(vec4 baseColor) {
+    // 1. CIRCULAR SHAPING
+    // gl_PointCoord goes from 0.0 to 1.0 across the point quad.
+    // We shift it to [-0.5, 0.5] to calculate distance from the center.
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    float dist = length(coord);
+
+    // CRITICAL: Hard radial mask to remove square corners.
+    if (dist > 0.5) discard;
+
+    // 2. DUAL-LAYER FALLOFF
+    // Improved Dual-Layer Falloff for fire density.
+    float core      = exp(-dist * dist * 30.0); // Tighter core
+    float wisps     = exp(-dist * dist * 8.0) * 0.4;
+    float softAlpha = (core + wisps);
+
+    // 3. EXPONENTIAL HDR BOOST
+    // Restores the high-luminosity appearance (Screenshot 2026-01-02 look).
+    vec3 fireColor = baseColor.rgb;
+    
+    // Boost intensity based on proximity to center (core)
+    fireColor *= (1.0 + core * 5.0); 
+
+    // 4. FINAL COMPOSITION
+    return vec4(fireColor, baseColor.a * softAlpha * 1.5);
+}
+
+/**
+ * @brief Smoke: a cubic radial falloff that fades linearly with the normalized age.
+ */
+vec4 shadeSmoke(vec4 baseColor, float age) {
+    // 1. CIRCULAR SHAPING
+    // gl_PointCoord provides coordinates [0, 1] across the point primitive.
+    // We shift it to [-0.5, 0.5] to calculate distance from the center.
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    float dist = length(coord);
+
+    // Hard clip outside the radius to maintain perfect circularity.
+    if (dist > 0.5) discard;
+
+    // 2. RADIAL FALLOFF (Soot Density)
+    // Using a power of 3.0 creates a "heavy" falloff that is denser at the center.
+    float alpha = pow(smoothstep(0.5, 0.0, dist), 3.0);
+    
+    // 3. DISSIPATION OVER TIME
+    // Fades the particle based on its normalized age.
+    float lifeFade = 1.0 - age;
+
+    // 4. FINAL COMPOSITION
+    // Output dark soot color (Blackened) with a global 0.6 density multiplier.
+    return vec4(baseColor.rgb, baseColor.a * alpha * lifeFade * 0.6);
+}
+
+/**
+ * @brief Rain: the point is squeezed into a thin vertical streak with a soft edge.
+ */
+vec4 shadeRain(vec4 baseColor) {
+    // 1. COORDINATE RE-CENTERING
+    // Shift gl_PointCoord from [0, 1] to [-0.5, 0.5] for centered calculations.
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    
+    // 2. STREAK MASK GENERATION
+    // Compress the X-axis by 8.0x to transform the circle into a thin vertical needle.
+    float streak = length(coord * vec2(8.0, 1.0)); 
+    
+    // Hard discard for corners outside the needle radius.
+    if (streak > 0.5) discard;
+
+    // 3. SOFT EDGE FALLOFF
+    // Creates translucency at the edges of the drop for a smoother look.
+    float softEdge = smoothstep(0.5, 0.1, streak);
+    
+    // 4. FINAL COMPOSITION
+    // Output the tinted drop with a base alpha multiplier of 0.4.
+    return vec4(baseColor.rgb, baseColor.a * softEdge * 0.4);
+}
+
+/**
+ * @brief Snow: feathered flakes with a sharp central glimmer.
+ */
+vec4 shadeSnow(vec4 baseColor) {
+    // 1. COORDINATE RE-CENTERING
+    // Shift gl_PointCoord from [0, 1] to [-0.5, 0.5] for radial calculations.
+    vec2 coord = gl_PointCoord - vec2(0.5);
+    float dist = length(coord);
+
+    // Hard clip outside the circle boundary.
+    if (dist > 0.5) discard;
+
+    // 2. FEATHERED ALPHA FALLOFF
+    // Starts falling off early (0.05) to create a "fuzzy" or "fluffy" appearance.
+    float softAlpha = smoothstep(0.5, 0.05, dist);
+    
+    // 3. CRYSTALLINE GLIMMER
+    // A sharp, localized highlight in the center of the flake to simulate reflection.
+    float glimmer = pow(1.0 - dist * 2.0, 6.0) * 0.3;
+
+    // 4. FINAL COMPOSITION
+    // Combine the base blue-tinted color with the glimmer highlight.
+    return vec4(baseColor.rgb + glimmer, baseColor.a * softAlpha);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file particle_simulation.glsl
+ * @brief Shared main() of the particle simulations: three passes over the alive/dead lists.
+ *
+ *   PASS_BEGIN     one invocation: last frame's survivors become the current list, the emission is
+ *                  sized to min(dead particles, spawn budget) and the indirect arguments are written
+ *   PASS_EMIT      one invocation per emitted particle: pops the dead list, calls emitParticle()
+ *                  and appends the particle to the current list
+ *   PASS_SIMULATE  one invocation per current entry: calls simulateParticle() and appends the
+ *                  particle to the next list if it is still alive, to the dead list otherwise
+ * Emission stops while ubo.spawnEnabled is off, so an idle system drains to zero work. It is also
+ * capped so that no more than simulation.activeLimit particles live (particle LOD); above the limit
+ * the surplus dies out over its lifetime.
+ * The including shader declares PARTICLE_CAPACITY, the ubo block and the particle layout first,
+ * and defines emitParticle() and simulateParticle().
+ */
+
+#include "particle_lists.glsl"
+
+layout(constant_id = 3) const uint SPAWN_BUDGET = 500; // Particles emitted per frame at most
+
+const uint PASS_BEGIN = 0;
+const uint PASS_EMIT = 1;
+const uint PASS_SIMULATE = 2;
+
+layout(push_constant) uniform SimulationParams {
+    uint pass;
+    uint current;   // Alive list the frame starts from (0 or 1); survivors go to the other one
+    uint activeLimit; // Live particles at most (LOD); emission only refills up to it
+} simulation;
+
+/** @brief Initializes a particle popped from the dead list. */
+void emitParticle(inout Particle p, uint index);
+
+/** @brief Advances a live particle by one step; returns false once it died. */
+bool simulateParticle(inout Particle p, uint index);
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    uint currentList = aliveListBase(simulation.current);
+
+    if (simulation.pass == PASS_BEGIN) {
+        if (i != 0) return;
+
+        uint budget = (ubo.spawnEnabled > 0.5) ? SPAWN_BUDGET : 0;
+        uint groupSize = gl_WorkGroupSize.x;
+        uint room = (simulation.activeLimit > state.drawIndexCount) ? (simulation.activeLimit - state.drawIndexCount) : 0;
+        state.emitCount = min(min(state.deadCount, budget), room);
+        state.aliveCount = state.drawIndexCount;
+        state.emitDispatch = uvec4((state.emitCount + groupSize - 1) / groupSize, 1, 1, 0);
+        state.simulateDispatch = uvec4((state.aliveCount + state.emitCount + groupSize - 1) / groupSize, 1, 1, 0);
+
+        state.drawIndexCount = 0;
+        state.drawInstanceCount = 1;
+        state.drawFirstIndex = 0;
+        state.drawVertexOffset = 0;
+        state.drawFirstInstance = 0;
+        return;
+    }
+
+    if (simulation.pass == PASS_EMIT) {
+        if (i >= state.emitCount) return;
+
+        // emitCount never exceeds the dead count, so every pop finds an entry
+        uint index = lists[deadListBase() + atomicAdd(state.deadCount, 0xFFFFFFFFu) - 1];
+        Particle p = loadParticle(index);
+        emitParticle(p, index);
+        storeParticle(index, p);
+        lists[currentList + atomicAdd(state.aliveCount, 1)] = index;
+        return;
+    }
+
+    if (i >= state.aliveCount) return;
+
+    uint index = lists[currentList + i];
+    Particle p = loadParticle(index);
+    bool alive = simulateParticle(p, index);
+    storeParticle(index, p);
+
+    if (alive) {
+        lists[aliveListBase(1 - simulation.current) + atomicAdd(state.drawIndexCount, 1)] = index;
+    } else {
+        lists[deadListBase() + atomicAdd(state.deadCount, 1)] = index;
+    }
+}
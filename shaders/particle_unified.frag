@@ -0,0 +1,36 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+/**
+ * @file particle_unified.frag
+ * @brief Fragment shader of the unified particle draw.
+ *
+ * Shades each point with its emitter's effect (the same functions as the per-effect fragment
+ * shaders). All fragments of one draw command share the effect id, so the branch is uniform.
+ */
+
+// --- Inputs (Interpolated from particle_unified.vert) ---
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in float fragLife;
+layout(location = 2) flat in uint fragEffect;
+
+// --- Outputs ---
+// outColor, or the accumulation/revealage pair when compiled with -DWEIGHTED_OIT
+#include "oit.glsl"
+
+#include "particle_effects.glsl"
+
+// --- Effect Shading (shadeDust() ... shadeSnow()) ---
+#include "particle_shading.glsl"
+
+void main() {
+    vec4 color;
+    switch (fragEffect) {
+        case EFFECT_DUST:   color = shadeDust(fragColor); break;
+        case EFFECT_FIRE:   color = shadeFire(fragColor); break;
+        case EFFECT_SMOKE:  color = shadeSmoke(fragColor, fragLife); break;
+        case EFFECT_RAIN:   color = shadeRain(fragColor); break;
+        default:            color = shadeSnow(fragColor); break;
+    }
+    writeTransparent(color);
+}
@@ -0,0 +1,66 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+/**
+ * @file particle_unified.vert
+ * @brief Vertex shader of the unified particle draw: every emitter of the pool in one multi-draw.
+ *
+ * Each emitter's draw command carries its effect id in firstInstance. The id selects the point-size
+ * multiplier the per-effect vertex shaders hard-code, and is passed on to the fragment stage, which
+ * shades the point with that effect.
+ */
+
+#include "particle_effects.glsl"
+
+// --- Inputs (Directly from the pool / Vertex Input) ---
+layout(location = 0) in vec4 inPosition; // xyz = World Position, w = Base Size
+layout(location = 1) in vec4 inVelocity; // xyz = Velocity, w = life or age (the effect decides)
+layout(location = 2) in vec4 inColor;    // Color calculated in compute shader
+
+// --- Outputs ---
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out float fragLife;
+layout(location = 2) flat out uint fragEffect;
+
+// --- Data Structures ---
+struct SparkLight {
+    vec3 position;
+    vec3 color;
+};
+
+// --- Uniform Data (Global Engine State) ---
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+    mat4 lightSpaceMatrix;
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+    int  useGouraud;
+    float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
+    SparkLight sparks[4]; // Matches C++ EngineConstants::MAX_SPARK_LIGHTS
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
+} ubo;
+
+// Point-size multipliers of dust.vert, fire.vert, smoke.vert, rain.vert and snow.vert, by effect id
+const float POINT_SIZE_SCALE[EFFECT_COUNT] = float[](10.0, 20.0, 30.0, 12.0, 8.0);
+
+void main() {
+    uint effect = min(uint(gl_InstanceIndex), EFFECT_COUNT - 1);
+
+    // 1. POSITION TRANSFORMATION
+    vec4 viewPos = ubo.view * vec4(inPosition.xyz, 1.0);
+    gl_Position = ubo.proj * viewPos;
+
+    // 2. PERSPECTIVE POINT ATTENUATION
+    float dist = length(viewPos.xyz);
+    gl_PointSize = inPosition.w * (1.0 / dist) * POINT_SIZE_SCALE[effect] * ubo.renderScale * ubo.particleLod.y;
+
+    // 3. DATA PASSTHROUGH
+    fragColor = vec4(inColor.rgb, min(inColor.a * ubo.particleLod.z, 1.0));
+    fragLife = inVelocity.w;
+    fragEffect = effect;
+}
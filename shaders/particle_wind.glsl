@@ -0,0 +1,27 @@
+/**
+ * @file particle_wind.glsl
+ * @brief The shared wind field as the particle simulations sample it.
+ *
+ * The field (wind_field.comp) is bound in the global scene set, Set 1 of the simulations. It holds
+ * air velocities; each effect decides how strongly its particles follow them, from dust and smoke
+ * that drift with the air to rain that only slants. scene.windStrength scales the whole field and is
+ * zero while the wind is off. One filtered fetch per call. Guarded, so the unified shader gets one copy.
+ */
+
+#ifndef PARTICLE_WIND_GLSL
+#define PARTICLE_WIND_GLSL
+
+#include "particle_scene.glsl"
+#include "wind_field.glsl"
+
+// Low-resolution air velocities over the globe's bounding box, clamped at its faces
+layout(set = 1, binding = 5) uniform sampler3D windField;
+
+/**
+ * @brief Returns the air velocity at a world position, in world units per second.
+ */
+vec3 sampleWind(vec3 position) {
+    return textureLod(windField, windFieldCoord(position), 0.0).xyz * scene.windStrength;
+}
+
+#endif
@@ -16,6 +16,8 @@ layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inNormal;
 
 // --- Outputs ---
+// Invariant so the depth pre-pass (depth.vert) reproduces this depth exactly.
+invariant gl_Position;
 layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec2 fragTexCoord;
 layout(location = 2) out vec3 fragNormal;
@@ -41,22 +43,30 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     SparkLight sparks[4]; // Must match C++ exactly
 } ubo;
 
-// --- Push Constants ---
-layout(push_constant) uniform PushConstants { 
-    mat4 model; 
-} push;
+// --- Set 2: Per-Object Data (written once per frame on the CPU) ---
+struct ObjectData {
+    mat4 model;
+    mat4 normal; // transpose(inverse(model)), upper 3x3 used
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
 
 void main() {
+    // gl_InstanceIndex carries the object index through firstInstance (CPU and indirect draws alike).
+    ObjectData object = objects[gl_InstanceIndex];
+
     // 1. GEOMETRY TRANSFORMATION
     // Transform position to world-space and clip-space.
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec4 worldPos = object.model * vec4(inPosition, 1.0);
     gl_Position = ubo.proj * ubo.view * worldPos;
 
     // 2. DATA PASSTHROUGH
     // Prepare world-space attributes for the fragment stage.
     fragPos = vec3(worldPos);
     fragTexCoord = inTexCoord;
-    fragNormal = mat3(transpose(inverse(push.model))) * inNormal;
+    fragNormal = mat3(object.normal) * inNormal;
     
     // 3. SHADOW COORDINATE CALCULATION
     // Transform position into light-perspective for shadow sampling.
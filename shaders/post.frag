@@ -7,6 +7,8 @@
  * This shader performs high-level image effects on the resolved HDR scene, 
  * including a soft-knee bloom with a 9-tap Gaussian-style blur, 
  * Reinhard tone mapping to convert HDR to SDR, and gamma correction.
+ * With dynamic resolution the scene only fills the top-left part of its target;
+ * that region is bilinearly upsampled over the whole swapchain image.
  */
 
 // --- Interpolated Inputs ---
@@ -22,6 +24,8 @@ layout(set = 0, binding = 0) uniform sampler2D sceneSampler;
 
 // --- Push Constants ---
 layout(push_constant) uniform PushConsts {
+    vec2 uvScale;    // Rendered region / target size
+    vec2 uvClamp;    // Last texel centre of the rendered region
     int enableBloom;
 } push;
 
@@ -49,7 +53,8 @@ vec3 blur(sampler2D tex, vec2 uv) {
     );
 
     for(int i = 0; i < 9; i++) {
-        result += texture(tex, uv + (offsets[i] * texelSize * 2.0)).rgb * kernel[i];
+        vec2 tapUV = min(uv + (offsets[i] * texelSize * 2.0), push.uvClamp);
+        result += texture(tex, tapUV).rgb * kernel[i];
     }
     
     return result;
@@ -57,8 +62,9 @@ vec3 blur(sampler2D tex, vec2 uv) {
 
 void main() {
     // 1. SCENE SAMPLING
-    // Sample the resolved HDR scene.
-    vec3 sceneColor = texture(sceneSampler, inUV).rgb;
+    // Sample the resolved HDR scene, stretching the rendered region over the screen.
+    vec2 sceneUV = min(inUV * push.uvScale, push.uvClamp);
+    vec3 sceneColor = texture(sceneSampler, sceneUV).rgb;
     vec3 result = sceneColor;
 
     if (push.enableBloom == 1) {
@@ -68,7 +74,7 @@ void main() {
         
         if(brightness > 0.7) {
             // Apply a wider 9-tap blur to spread the light.
-            vec3 bloomColor = blur(sceneSampler, inUV);
+            vec3 bloomColor = blur(sceneSampler, sceneUV);
             
             // STRENGTH BOOST: 1.5 multiplier used for noticeable luminosity.
             result += bloomColor * 1.5; 
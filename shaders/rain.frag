@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 /**
  * @file rain.frag
@@ -13,25 +14,12 @@
 layout(location = 0) in vec4 fragColor;
 
 // --- Outputs ---
-layout(location = 0) out vec4 outColor;
+// outColor, or the accumulation/revealage pair when compiled with -DWEIGHTED_OIT
+#include "oit.glsl"
 
-void main() {
-    // 1. COORDINATE RE-CENTERING
-    // Shift gl_PointCoord from [0, 1] to [-0.5, 0.5] for centered calculations.
-    vec2 coord = gl_PointCoord - vec2(0.5);
-    
-    // 2. STREAK MASK GENERATION
-    // Compress the X-axis by 8.0x to transform the circle into a thin vertical needle.
-    float streak = length(coord * vec2(8.0, 1.0)); 
-    
-    // Hard discard for corners outside the needle radius.
-    if (streak > 0.5) discard;
+// --- Effect Shading (shadeDust() ... shadeSnow()) ---
+#include "particle_shading.glsl"
 
-    // 3. SOFT EDGE FALLOFF
-    // Creates translucency at the edges of the drop for a smoother look.
-    float softEdge = smoothstep(0.5, 0.1, streak);
-    
-    // 4. FINAL COMPOSITION
-    // Output the tinted drop with a base alpha multiplier of 0.4.
-    outColor = vec4(fragColor.rgb, fragColor.a * softEdge * 0.4);
-}
\ No newline at end of file
+void main() {
+    writeTransparent(shadeRain(fragColor));
+}
@@ -33,7 +33,11 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     vec3 lightColor;
     int useGouraud;
     float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
     SparkLight sparks[4]; // Matches C++ EngineConstants::MAX_SPARKS
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
 } ubo;
 
 void main() {
@@ -54,8 +58,8 @@ void main() {
      * (Compared to 25.0 used for fluffy snow particles).
      */
     float multiplier = 12.0;
-    gl_PointSize = inPosition.w * (1.0 / dist) * multiplier;
+    gl_PointSize = inPosition.w * (1.0 / dist) * multiplier * ubo.renderScale * ubo.particleLod.y;
 
     // 4. DATA PASSTHROUGH
-    fragColor = inColor;
+    fragColor = vec4(inColor.rgb, min(inColor.a * ubo.particleLod.z, 1.0));
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * @file rain_effect.glsl
+ * @brief Emission and simulation steps of the Rain effect.
+ *
+ * Included by rain.comp and by particle_unified.comp. The including shader declares the Particle
+ * struct, the ubo parameters (deltaTime, totalTime, lightColor, emitterPos) and SPAWN_RADIUS first.
+ * Drops die on the floor and on whatever the scene depth shows in their way. Heavy drops only slant
+ * with the horizontal part of the shared wind field.
+ */
+
+#include "particle_common.glsl"
+#include "particle_collision.glsl"
+#include "particle_wind.glsl"
+
+/**
+ * @brief TOP-HEMISPHERE RESPAWN LOGIC: places a recycled drop inside the top half of the globe.
+ */
+void emitParticle(inout Particle p, uint index) {
+    float seed = float(index) + ubo.totalTime;
+    
+    // Generate a point inside the top half of the sphere (0 to 90 degrees)
+    float r = min(SPAWN_RADIUS, GLOBE_RADIUS - 0.05) * pow(hash(seed), 0.33);
+    float phi = hash(seed + 1.0) * 1.57; 
+    float theta = hash(seed + 2.0) * 6.28318;
+    
+    p.position.x = r * sin(phi) * cos(theta);
+    p.position.z = r * sin(phi) * sin(theta);
+    p.position.y = r * cos(phi); 
+
+    // Offset by the physical center of the globe
+    p.position.xyz += SPHERE_CENTER;
+    
+    // PHYSICS & ATTRIBUTE INITIALIZATION
+    p.velocity.xyz = vec3(0.0, -4.5, 0.0); // Constant downward terminal velocity
+    p.velocity.w   = 1.0;                  // Reset age
+    p.color        = vec4(0.6, 0.7, 1.0, 0.4);
+    p.position.w   = 1.2;                  // Rain drop size
+}
+
+/**
+ * @brief Advances one drop; it dies on the floor or the scene, outside the glass or when its life runs out.
+ */
+bool simulateParticle(inout Particle p, uint index) {
+    // 1. KINEMATICS
+    // Apply integrated velocity over time; the wind pushes the falling drop sideways.
+    p.position.xyz += p.velocity.xyz * ubo.deltaTime;
+    p.position.xz += sampleWind(p.position.xyz).xz * 0.5 * ubo.deltaTime;
+    
+    // 2. STRICTOR BOUNDS ENFORCEMENT
+    // Defines the spherical volume of the globe and the ground plane.
+    float distFromCenter = length(p.position.xyz - SPHERE_CENTER);
+    
+    // 3. RESET TRIGGER DETECTION
+    // Determines if the particle has hit the floor, exited the glass, or died.
+    bool hitFloor = p.position.y < -0.12;
+    bool exitedGlass = distFromCenter > GLOBE_RADIUS;
+    if (hitFloor || exitedGlass || p.velocity.w <= 0.0) return false;
+
+    // 4. SCENE COLLISION
+    // The house, rocks and figures stop the drop (one depth fetch, only for drops still in flight).
+    return !hitsSceneDepth(p.position.xyz);
+}
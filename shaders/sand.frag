@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 /**
  * @file sand.frag
@@ -7,8 +8,11 @@
  * Implements Blinn-Phong lighting with shadow mapping, normal mapping, 
  * and multi-point spark lighting for dynamic fire effects. It utilizes 
  * global light color to drive dynamic ambient levels for day/night transitions.
+ * Settled snow (the SnowCover heightmap) whitens the sand where it has piled up.
  */
 
+#include "snow_cover.glsl"
+
 // --- Interpolated Inputs ---
 layout(location = 0) in vec3 fragPos;
 layout(location = 1) in vec2 fragTexCoord;
@@ -37,6 +41,11 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
 
 layout(set = 0, binding = 1) uniform sampler2D shadowMap;
 
+// Snow heightmap filled by the snow simulation (Set 0, binding 4)
+layout(std430, set = 0, binding = 4) readonly buffer SnowCoverBlock {
+    uint snowCover[];
+};
+
 // --- Set 1: Material Textures ---
 layout(set = 1, binding = 0) uniform sampler2D texSampler;    // Base Color
 layout(set = 1, binding = 1) uniform sampler2D normalSampler; // Normal Map
@@ -98,11 +107,30 @@ vec3 calculateSparkLighting(vec3 N, vec3 fragPos, vec3 albedo) {
     return totalSparkLight + fireAmbient;
 }
 
+/**
+ * @brief Returns the snow cover under a world position (0 bare, 1 fully white).
+ * Bilinear over the four nearest cells, so the cover has no visible cell edges.
+ */
+float sampleSnowCover(vec3 worldPos) {
+    vec2 coord = snowCoverCoord(worldPos.xz) - 0.5;
+    ivec2 base = ivec2(floor(coord));
+    vec2 f = coord - vec2(base);
+
+    float corners[4];
+    for (int i = 0; i < 4; i++) {
+        int cell = snowCoverCell(base + ivec2(i & 1, i >> 1));
+        corners[i] = (cell >= 0) ? float(snowCover[cell]) : 0.0;
+    }
+    float units = mix(mix(corners[0], corners[1], f.x), mix(corners[2], corners[3], f.x), f.y);
+    return smoothstep(0.0, 1.0, units / SNOW_UNITS_FULL);
+}
+
 void main() {
     // 1. TEXTURE SAMPLING
-    // Sample base albedo and ambient occlusion maps.
+    // Sample base albedo and ambient occlusion maps, then lay the settled snow over the sand.
     vec3 albedo = texture(texSampler, fragTexCoord).rgb;
     float ao = texture(aoSampler, fragTexCoord).r;
+    albedo = mix(albedo, vec3(0.92, 0.94, 0.97), sampleSnowCover(fragPos));
     
     // 2. NORMAL RECONSTRUCTION
     // Combine interpolated normal with detail map normals.
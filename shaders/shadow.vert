@@ -37,10 +37,15 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     SparkLight sparks[4]; 
 } ubo;
 
-// --- Push Constants ---
-layout(push_constant) uniform PushConstants { 
-    mat4 model; 
-} push;
+// --- Set 2: Per-Object Data (written once per frame on the CPU) ---
+struct ObjectData {
+    mat4 model;
+    mat4 normal; // transpose(inverse(model)), upper 3x3 used
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
 
 void main() {
     // 1. DATA PASSTHROUGH
@@ -50,5 +55,5 @@ void main() {
     // 2. LIGHT-SPACE TRANSFORMATION
     // Transform the vertex directly into light-perspective clip space.
     // gl_Position = LightProjection * LightView * Model * Position
-    gl_Position = ubo.lightSpaceMatrix * push.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.lightSpaceMatrix * objects[gl_InstanceIndex].model * vec4(inPosition, 1.0);
 }
\ No newline at end of file
@@ -7,12 +7,21 @@
  * Transforms simulated smoke particle positions into clip space and calculates
  * perspective-accurate point sizes. It passes the normalized particle age to 
  * the fragment stage to facilitate dissipation effects.
+ * Compiled with -DPARTICLE_SOA it reads the compressed streams; the soot colour
+ * is constant, so it is not fetched.
  */
 
 // --- Inputs (Directly from the Storage Buffer / Vertex Input) ---
+#ifdef PARTICLE_SOA
+layout(location = 0) in vec3 inPosition; // position stream
+layout(location = 1) in vec2 inLifeSize; // half2 stream: x = age, y = size
+
+const vec4 SOOT_COLOR = vec4(0.005, 0.005, 0.005, 0.95); // Matches the respawn colour in smoke.comp
+#else
 layout(location = 0) in vec4 inPosition; // xyz = World Position, w = Base Size
 layout(location = 1) in vec4 inVelocity; // xyz = Velocity, w = Particle Age
 layout(location = 2) in vec4 inColor;    // Color calculated in compute shader
+#endif
 
 // --- Outputs ---
 layout(location = 0) out vec4 fragColor;
@@ -34,10 +43,24 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     vec3 lightColor;
     int  useGouraud;
     float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
     SparkLight sparks[4]; // Matches C++ EngineConstants::MAX_SPARKS
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
 } ubo;
 
 void main() {
+#ifdef PARTICLE_SOA
+    float pointSize = inLifeSize.y;
+    float age = inLifeSize.x;
+    vec4 color = SOOT_COLOR;
+#else
+    float pointSize = inPosition.w;
+    float age = inVelocity.w;
+    vec4 color = inColor;
+#endif
+
     // 1. POSITION TRANSFORMATION
     // Transform the particle into view-space and then to clip-space.
     vec4 viewPos = ubo.view * vec4(inPosition.xyz, 1.0);
@@ -54,10 +77,10 @@ void main() {
      * without reaching the massive scale of the Haboob dust clouds.
      */
     float multiplier = 30.0; 
-    gl_PointSize = inPosition.w * (1.0 / dist) * multiplier; 
+    gl_PointSize = pointSize * (1.0 / dist) * multiplier * ubo.renderScale * ubo.particleLod.y; 
 
     // 3. DATA PASSTHROUGH
     // Sending color and normalized age (0.0 to 1.0) for fragment fade-out logic.
-    fragColor = inColor;
-    fragAge = inVelocity.w;
+    fragColor = vec4(color.rgb, min(color.a * ubo.particleLod.z, 1.0));
+    fragAge = age;
 }
\ No newline at end of file
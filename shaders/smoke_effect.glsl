@@ -0,0 +1,61 @@
+/**
+ * @file smoke_effect.glsl
+ * @brief Emission and simulation steps of the Smoke effect.
+ *
+ * Included by smoke.comp and by particle_unified.comp. The including shader declares the Particle
+ * struct, the ubo parameters (deltaTime, totalTime, lightColor, emitterPos) and SPAWN_RADIUS first.
+ * Smoke is carried by the shared wind field, the fire's updraft included.
+ */
+
+#include "particle_common.glsl"
+#include "particle_wind.glsl"
+
+/**
+ * @brief Places a recycled particle just above the emitter.
+ */
+void emitParticle(inout Particle p, uint index) {
+    float seed = float(index) + ubo.totalTime;
+    
+    // SPAWN OFFSET: Initiates smoke 0.15 units above the emitter to clear fire height.
+    p.position.x = ubo.emitterPos.x + (hash(seed) - 0.5) * 2.0 * SPAWN_RADIUS;
+    p.position.z = ubo.emitterPos.z + (hash(seed + 1.0) - 0.5) * 2.0 * SPAWN_RADIUS;
+    p.position.y = ubo.emitterPos.y + 0.15; 
+    
+    // Vertical buoyancy reset
+    p.velocity.xyz = vec3(0.0, 0.6 + hash(seed + 2.0) * 0.4, 0.0);
+    p.velocity.w = 0.0;
+    
+    // VISUAL ATTRIBUTES
+    // Randomized size and dark charcoal color (0.005) for realistic soot.
+    p.position.w = 4.0 + hash(seed + 3.0) * 4.0;
+    p.color = vec4(0.005, 0.005, 0.005, 0.95); 
+}
+
+/**
+ * @brief Advances one smoke particle; it dies at the end of its lifespan or at the glass.
+ */
+bool simulateParticle(inout Particle p, uint index) {
+    // 1. AGE DECAY
+    // Slower decay rate (0.3) allows for better vertical cone height.
+    p.velocity.w += ubo.deltaTime * 0.3; 
+    float age = p.velocity.w;
+
+    // 2. CONE PHYSICS & KINEMATICS
+    // Horizontal drift (X and Z) increases with age to create a widening cone shape.
+    float expansion = age * 0.5; 
+    p.position.xyz += p.velocity.xyz * ubo.deltaTime;
+    p.position.x += sin(ubo.totalTime + float(index)) * expansion * ubo.deltaTime;
+    p.position.z += cos(ubo.totalTime + float(index)) * expansion * ubo.deltaTime;
+
+    // Soot drifts with the air: storm gusts bend the column, the updraft lifts it
+    p.position.xyz += sampleWind(p.position.xyz) * ubo.deltaTime;
+
+    // 3. SPHERICAL CONTAINMENT
+    // Defines the boundary of the globe to prevent particles from exiting the glass.
+    vec3 sphereCenter = vec3(0.0, -0.3, 0.0);
+    float globeRadius = 1.70;
+    float distFromCenter = length(p.position.xyz - sphereCenter);
+
+    // 4. Expired or touching the glass: back to the dead list for recycling
+    return (age <= 1.0) && (distFromCenter <= globeRadius);
+}
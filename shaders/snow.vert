@@ -34,7 +34,11 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     vec3 lightColor;
     int useGouraud;
     float time;
+    float renderScale;   // Scene extent / window extent (dynamic resolution)
     SparkLight sparks[4]; // Matches C++ EngineConstants::MAX_SPARKS
+    mat4 depthViewProj;
+    vec4 depthParams;
+    vec4 particleLod;    // Kept fraction, point-size and alpha compensation (ParticleLodController)
 } ubo;
 
 void main() {
@@ -54,9 +58,9 @@ void main() {
      * "puffy" look, creating a finer, more realistic precipitation effect.
      */
     float multiplier = 8.0; 
-    gl_PointSize = inPosition.w * (1.0 / dist) * multiplier;
+    gl_PointSize = inPosition.w * (1.0 / dist) * multiplier * ubo.renderScale * ubo.particleLod.y;
 
     // 3. DATA PASSTHROUGH
     // Pass the blue-tinted color to the fragment stage.
-    fragColor = inColor; 
+    fragColor = vec4(inColor.rgb, min(inColor.a * ubo.particleLod.z, 1.0));
 }
\ No newline at end of file
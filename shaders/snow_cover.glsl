@@ -0,0 +1,40 @@
+/**
+ * @file snow_cover.glsl
+ * @brief Grid of the top-down snow heightmap (SnowCover on the C++ side).
+ *
+ * SNOW_COVER_RES x SNOW_COVER_RES cells span the globe's footprint on the XZ plane. Each cell counts
+ * the snow that landed on it in fixed point: flakes add SNOW_UNITS_PER_FLAKE when they settle
+ * (snow_effect.glsl), snow_melt.comp scales the counts down as the weather warms, and sand.frag turns
+ * them into cover. The including shader declares the uint buffer itself, since the binding differs
+ * between the simulation, the melt pass and the sand material.
+ */
+
+#ifndef SNOW_COVER_GLSL
+#define SNOW_COVER_GLSL
+
+const uint SNOW_COVER_RES = 64;              // Cells per side (SnowCover::RESOLUTION)
+const vec2 SNOW_COVER_MIN = vec2(-1.7);      // World XZ of the grid's first corner
+const float SNOW_COVER_SIZE = 3.4;           // World extent of the grid along X and Z (the globe's diameter)
+
+const uint SNOW_UNITS_PER_FLAKE = 256;       // What one settled flake adds to its cell
+const float SNOW_UNITS_FULL = 1024.0;        // Cell content at which the sand is fully white
+const float SNOW_UNITS_MAX = 4096.0;         // Cap applied by the melt pass, far below uint overflow
+
+/**
+ * @brief Returns the continuous grid coordinate of a world XZ position (cell centres at .5).
+ */
+vec2 snowCoverCoord(vec2 xz) {
+    return (xz - SNOW_COVER_MIN) / SNOW_COVER_SIZE * float(SNOW_COVER_RES);
+}
+
+/**
+ * @brief Returns the cell index of an integer grid coordinate, or -1 outside the grid.
+ */
+int snowCoverCell(ivec2 coord) {
+    if (any(lessThan(coord, ivec2(0))) || any(greaterThanEqual(coord, ivec2(SNOW_COVER_RES)))) {
+        return -1;
+    }
+    return coord.y * int(SNOW_COVER_RES) + coord.x;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file snow_effect.glsl
+ * @brief Emission and simulation steps of the Snow effect.
+ *
+ * Included by snow.comp and by particle_unified.comp. The including shader declares the Particle
+ * struct, the ubo parameters (deltaTime, totalTime, lightColor, emitterPos) and SPAWN_RADIUS first.
+ * Flakes settle on the floor and on whatever the scene depth shows under them, and add to the snow cover.
+ * They drift with the shared wind field; the per-flake sway adds flutter on top.
+ */
+
+#include "particle_common.glsl"
+#include "particle_collision.glsl"
+#include "particle_wind.glsl"
+
+/**
+ * @brief SPHERICAL RESPAWN LOGIC: places a recycled flake inside the top half of the globe.
+ */
+void emitParticle(inout Particle p, uint index) {
+    float seed = float(index) + ubo.totalTime;
+    
+    // Generate a point within the top-hemisphere volume.
+    float r = min(SPAWN_RADIUS, GLOBE_RADIUS - 0.05) * pow(hash(seed), 0.33);
+    float phi = hash(seed + 1.0) * 1.57;
+    float theta = hash(seed + 2.0) * 6.28318;
+    
+    p.position.x = r * sin(phi) * cos(theta);
+    p.position.z = r * sin(phi) * sin(theta);
+    p.position.y = r * cos(phi);
+    p.position.xyz += SPHERE_CENTER;
+
+    // ATTRIBUTE INITIALIZATION
+    // SMALLER SIZE: (0.4 to 0.8 range) for fine snowflakes.
+    p.position.w = 0.4 + hash(seed + 4.0) * 0.4;
+    
+    // Drift velocity: Slow downward descent
+    p.velocity.y = -0.3 - (hash(seed + 3.0) * 0.2);
+    p.color = vec4(0.9, 0.9, 1.0, 0.8);
+}
+
+/**
+ * @brief Advances one flake; it dies outside the glass, or settles (and dies) on the floor or the scene.
+ */
+bool simulateParticle(inout Particle p, uint index) {
+    // 1. KINEMATICS WITH SWAY
+    // Implements sinusoidal horizontal movement to simulate fluttering snow.
+    float sway = sin(ubo.totalTime * 1.5 + float(index)) * 0.2;
+    p.position.x += sway * ubo.deltaTime;
+    p.position.z += cos(ubo.totalTime * 1.2 + float(index)) * 0.1 * ubo.deltaTime;
+    p.position.y += p.velocity.y * ubo.deltaTime;
+
+    // Light flakes follow most of the wind, storm gusts included
+    p.position.xyz += sampleWind(p.position.xyz) * 0.8 * ubo.deltaTime;
+
+    // 2. STRICTOR BOUNDS ENFORCEMENT
+    // The flake dies if it exits the sphere.
+    float distFromCenter = length(p.position.xyz - SPHERE_CENTER);
+    if (distFromCenter > GLOBE_RADIUS) return false;
+
+    // 3. LANDING
+    // A flake on the floor (-0.12) or on the house, rocks or figures settles into the snow cover.
+    bool landed = (p.position.y < -0.12) || hitsSceneDepth(p.position.xyz);
+    if (landed) {
+        depositSnow(p.position.xyz);
+    }
+    return !landed;
+}
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 /**
  * @file water.frag
@@ -47,7 +48,8 @@ layout(set = 0, binding = 2) uniform sampler2D sceneSampler;
 layout(set = 1, binding = 1) uniform sampler2D normalSampler;
 
 // --- Outputs ---
-layout(location = 0) out vec4 outColor;
+// outColor, or the accumulation/revealage pair when compiled with -DWEIGHTED_OIT
+#include "oit.glsl"
 
 void main() {
     // 1. HORIZON CLAMP (The Experiment)
@@ -88,5 +90,5 @@ void main() {
     vec3 finalColor = mix(background, skyReflection, fresnel);
 
     // Alpha remains high (0.85) to ensure the floor is visible but distorted.
-    outColor = vec4(finalColor, 0.85);
+    writeTransparent(vec4(finalColor, 0.85));
 }
\ No newline at end of file
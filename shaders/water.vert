@@ -40,12 +40,19 @@ layout(set = 0, binding = 0) uniform UniformBufferObject {
     SparkLight sparks[4]; // Must match C++ exactly
 } ubo;
 
-// --- Push Constants ---
-layout(push_constant) uniform PushConstants { 
-    mat4 model; 
-} push;
+// --- Set 2: Per-Object Data (written once per frame on the CPU) ---
+struct ObjectData {
+    mat4 model;
+    mat4 normal; // transpose(inverse(model)), upper 3x3 used
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
 
 void main() {
+    ObjectData object = objects[gl_InstanceIndex];
+
     // 1. WAVE ANIMATION LOGIC
     // Apply a simple vertical displacement (Sine wave) to simulate surface ripples.
     vec3 pos = inPosition;
@@ -54,7 +61,7 @@ void main() {
 
     // 2. GEOMETRY TRANSFORMATION
     // Transform the displaced vertex into world-space and clip-space.
-    vec4 worldPos = push.model * vec4(pos, 1.0);
+    vec4 worldPos = object.model * vec4(pos, 1.0);
     gl_Position = ubo.proj * ubo.view * worldPos;
 
     // 3. DATA PASSTHROUGH
@@ -64,7 +71,7 @@ void main() {
 
     // 4. NORMAL RECONSTRUCTION
     // Note: This calculates the normal based on the original mesh orientation.
-    fragNormal = mat3(transpose(inverse(push.model))) * inNormal;
+    fragNormal = mat3(object.normal) * inNormal;
 
     // 5. FALLBACK INITIALIZATION
     fragGouraudColor = vec3(1.0);
@@ -0,0 +1,30 @@
+/**
+ * @file wind_field.glsl
+ * @brief Grid of the shared wind field (WindField on the C++ side).
+ *
+ * A cube of cells spans the globe's bounding box; each holds the air velocity at its centre in world
+ * units per second. wind_field.comp writes the cells and the particle simulations sample them with
+ * linear filtering (particle_wind.glsl). The resolution is the image's, so it is not fixed here.
+ */
+
+#ifndef WIND_FIELD_GLSL
+#define WIND_FIELD_GLSL
+
+const vec3 WIND_FIELD_CENTER = vec3(0.0, -0.3, 0.0);   // The globe's centre (SPHERE_CENTER)
+const float WIND_FIELD_HALF_EXTENT = 1.8;               // Half the cube's side (WindField::HALF_EXTENT)
+
+/**
+ * @brief Returns the normalized texture coordinate of a world position (0 and 1 on the cube's faces).
+ */
+vec3 windFieldCoord(vec3 position) {
+    return (position - WIND_FIELD_CENTER) / (2.0 * WIND_FIELD_HALF_EXTENT) + 0.5;
+}
+
+/**
+ * @brief Returns the world position of a cell's centre in a field of the given size.
+ */
+vec3 windFieldPosition(ivec3 cell, ivec3 size) {
+    return WIND_FIELD_CENTER + ((vec3(cell) + 0.5) / vec3(size) - 0.5) * (2.0 * WIND_FIELD_HALF_EXTENT);
+}
+
+#endif
@@ -68,7 +68,8 @@ std::unique_ptr<Model> AssetManager::loadModel(
     const std::function<std::shared_ptr<Material>(const std::string&)>& materialSelector,
     const VkCommandBuffer setupCmd,
     std::vector<VkBuffer>& stagingBuffers,
-    std::vector<VkDeviceMemory>& stagingMemories)
+    std::vector<VkDeviceMemory>& stagingMemories,
+    std::vector<OBJLoader::MeshData>* const cpuGeometry)
 {
     // Step 1: Initialize the Model container.
     auto model = std::make_unique<Model>(context);
@@ -83,6 +84,11 @@ std::unique_ptr<Model> AssetManager::loadModel(
         if (selectedMat != nullptr) {
             // Transfer RAII ownership of processed mesh to the model container.
             model->addMesh(std::move(processMeshData(data, selectedMat, setupCmd, stagingBuffers, stagingMemories)));
+
+            // Optional CPU copy (e.g. occluder geometry for the CPU occlusion culler)
+            if (cpuGeometry != nullptr) {
+                cpuGeometry->push_back(data);
+            }
         }
     }
 
@@ -187,7 +193,9 @@ std::unique_ptr<Mesh> AssetManager::processMeshData(
     VkBuffer deviceBuffer{ VK_NULL_HANDLE };
     VkBufferCreateInfo bufferInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
     bufferInfo.size = totalSize;
-    bufferInfo.usage = (VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    // TRANSFER_SRC lets the GPU-driven path copy this mesh into its merged geometry pool
+    bufferInfo.usage = (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     if (vkCreateBuffer(context->device, &bufferInfo, nullptr, &deviceBuffer) != VK_SUCCESS) {
@@ -215,6 +223,7 @@ std::unique_ptr<Mesh> AssetManager::processMeshData(
         context, deviceBuffer, static_cast<uint32_t>(data.indices.size()), vertexSize, material
     );
     mesh->setName(data.name);
+    mesh->setLocalBounds(data.bounds);
 
     return mesh;
 }
\ No newline at end of file
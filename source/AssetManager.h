@@ -63,13 +63,15 @@ public:
 
     /**
      * @brief Loads a 3D model, using the provided selector function to resolve materials by name.
+     * If cpuGeometry is given it receives the parsed data of every mesh added, in mesh order.
      */
     std::unique_ptr<Model> loadModel(
         const std::string& path,
         const std::function<std::shared_ptr<Material>(const std::string&)>& materialSelector,
         const VkCommandBuffer setupCmd,
         std::vector<VkBuffer>& stagingBuffers,
-        std::vector<VkDeviceMemory>& stagingMemories
+        std::vector<VkDeviceMemory>& stagingMemories,
+        std::vector<OBJLoader::MeshData>* const cpuGeometry = nullptr
     );
 
     /**
@@ -34,6 +34,7 @@ void ClimateManager::update(const float dt, const float totalTime, const bool au
     float targetWaterOffset = 0.0f;
     float targetStormStrength = 0.0f;
     glm::vec3 tintTarget = glm::vec3(1.0f);
+    float targetSnowMelt = 0.15f;                  // Settled snow fades slowly in the summer heat
 
     if (currentState == WeatherState::RAIN) {
         targetGrowth = 1.3f;
@@ -41,10 +42,12 @@ void ClimateManager::update(const float dt, const float totalTime, const bool au
         targetWaterOffset = 0.01f;
         targetStormStrength = 0.7f;                // 70% Storm influence over ambient colors
         tintTarget = glm::vec3(0.8f, 0.82f, 0.85f); // Subtle Grey-Blue
+        targetSnowMelt = 0.35f;                    // Rain washes the snow away fastest
     }
     else if (currentState == WeatherState::SNOW) {
         targetStormStrength = 0.5f;                // 50% Storm influence
         tintTarget = glm::vec3(0.9f, 0.95f, 1.1f);  // Subtle Icy Blue
+        targetSnowMelt = 0.0f;                     // Snow keeps piling up
     }
 
     // Step 4: Smooth Transitions - Prevent jarring visual pops when weather changes
@@ -56,6 +59,12 @@ void ClimateManager::update(const float dt, const float totalTime, const bool au
     currentWaterOffset = glm::mix(currentWaterOffset, targetWaterOffset, lerpFactor);
     currentStormInfluence = glm::mix(currentStormInfluence, targetStormStrength, lerpFactor);
     weatherTint = glm::mix(weatherTint, tintTarget, lerpFactor);
+    currentSnowMelt = glm::mix(currentSnowMelt, targetSnowMelt, lerpFactor);
+
+    // Gusts move faster as the storm builds; the phase is the wind field's curl-noise time
+    static constexpr float WIND_CALM_RATE = 0.3f;
+    static constexpr float WIND_STORM_RATE = 1.5f;
+    currentWindPhase += clampedDt * (WIND_CALM_RATE + (WIND_STORM_RATE * currentStormInfluence));
 
     // Step 5: Sun Position Calculation - Orbital mechanics
     if (autoOrbit) {
@@ -51,6 +51,8 @@ public:
         currentWaterScale = glm::vec3(1.0f);
         currentWaterOffset = 0.0f;
         weatherTint = glm::vec3(1.0f);
+        currentSnowMelt = 0.0f;
+        currentWindPhase = 0.0f;
 
         // Step 3: Flag a state transition to notify dependent systems
         transitionTriggered = true;
@@ -73,6 +75,15 @@ public:
 
     float getWaterOffset() const { return currentWaterOffset; }
 
+    /** @brief Returns the fraction of the settled snow that melts per second (SnowCover). */
+    float getSnowMeltRate() const { return currentSnowMelt; }
+
+    /** @brief Returns how far the weather has turned stormy (0 calm, 0.7 in the rain); drives the wind field. */
+    float getStormInfluence() const { return currentStormInfluence; }
+
+    /** @brief Returns the wind phase: a time offset that advances faster in storms (moves the wind field's gusts). */
+    float getWindPhase() const { return currentWindPhase; }
+
     /** @brief Returns tint by const reference to satisfy OPT.14. */
     const glm::vec3& getTint() const { return weatherTint; }
 
@@ -151,6 +162,8 @@ private:
     glm::vec3 currentWaterScale{ 1.0f };
     float     currentWaterOffset{ 0.0f };
     glm::vec3 weatherTint{ 1.0f };
+    float     currentSnowMelt{ 0.0f };
+    float     currentWindPhase{ 0.0f };
 
     // --- Atmospheric State ---
     glm::vec3 currentSunPos{ 0.0f };
@@ -0,0 +1,131 @@
+#include "CommandEncoder.h"
+
+#include "Pipeline.h"
+#include "CommonStructs.h"
+
+/**
+ * @brief Forgets all tracked state, forcing the next binds to be recorded.
+ */
+void CommandEncoder::invalidate() {
+    boundPipeline = nullptr;
+    boundGlobalSet = VK_NULL_HANDLE;
+    boundMaterialSet = VK_NULL_HANDLE;
+    boundObjectSet = VK_NULL_HANDLE;
+    boundVertexBuffer = VK_NULL_HANDLE;
+    boundIndexBuffer = VK_NULL_HANDLE;
+    boundIndexOffset = 0U;
+}
+
+/**
+ * @brief Binds a graphics pipeline unless it is already bound.
+ * A null pipeline records nothing and is not counted: it is not a redundant bind.
+ */
+void CommandEncoder::bindPipeline(const Pipeline* const pipeline) {
+    if (pipeline == nullptr) {
+        return;
+    }
+    if (pipeline == boundPipeline) {
+        ++stats.bindsSkipped;
+        return;
+    }
+
+    pipeline->bind(commandBuffer);
+    boundPipeline = pipeline;
+    ++stats.bindsIssued;
+}
+
+/**
+ * @brief Binds the global and material sets, re-recording only the sets that changed.
+ */
+void CommandEncoder::bindDescriptorSets(const VkPipelineLayout layout, const VkDescriptorSet globalSet, const VkDescriptorSet materialSet) {
+    // Step 1: A new global set forces both sets to be rebound in one call
+    if (globalSet != boundGlobalSet) {
+        const VkDescriptorSet sets[SET_COUNT] = { globalSet, materialSet };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            layout, SET_GLOBAL, SET_COUNT, sets, 0U, nullptr);
+
+        boundGlobalSet = globalSet;
+        boundMaterialSet = materialSet;
+        ++stats.bindsIssued;
+        return;
+    }
+
+    // Step 2: Otherwise only the material set may need to change
+    if (materialSet != boundMaterialSet) {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            layout, SET_MATERIAL, EngineConstants::COUNT_ONE, &materialSet, 0U, nullptr);
+
+        boundMaterialSet = materialSet;
+        ++stats.bindsIssued;
+        return;
+    }
+
+    ++stats.bindsSkipped;
+}
+
+/**
+ * @brief Binds the interleaved vertex/index buffer unless it is already bound at this offset.
+ */
+void CommandEncoder::bindGeometry(const VkBuffer buffer, const VkDeviceSize indexOffset) {
+    // Step 1: Vertex stream
+    if (buffer != boundVertexBuffer) {
+        const VkDeviceSize offsets[BUFFER_COUNT_ONE] = { 0ULL };
+        vkCmdBindVertexBuffers(commandBuffer, BINDING_FIRST, BUFFER_COUNT_ONE, &buffer, offsets);
+        boundVertexBuffer = buffer;
+        ++stats.bindsIssued;
+    }
+    else {
+        ++stats.bindsSkipped;
+    }
+
+    // Step 2: Index stream (the offset is part of the binding)
+    if ((buffer != boundIndexBuffer) || (indexOffset != boundIndexOffset)) {
+        vkCmdBindIndexBuffer(commandBuffer, buffer, indexOffset, VK_INDEX_TYPE_UINT32);
+        boundIndexBuffer = buffer;
+        boundIndexOffset = indexOffset;
+        ++stats.bindsIssued;
+    }
+    else {
+        ++stats.bindsSkipped;
+    }
+}
+
+/**
+ * @brief Binds the per-object matrix set unless it is already bound.
+ */
+void CommandEncoder::bindObjectSet(const VkPipelineLayout layout, const VkDescriptorSet objectSet) {
+    if (objectSet == boundObjectSet) {
+        ++stats.bindsSkipped;
+        return;
+    }
+
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        layout, SET_OBJECTS, EngineConstants::COUNT_ONE, &objectSet, 0U, nullptr);
+    boundObjectSet = objectSet;
+    ++stats.bindsIssued;
+}
+
+/**
+ * @brief Records an indexed draw with the currently bound state.
+ * firstInstance is the object index; shaders read it back as gl_InstanceIndex.
+ */
+void CommandEncoder::drawIndexed(const uint32_t indexCount, const uint32_t firstInstance) {
+    vkCmdDrawIndexed(commandBuffer, indexCount, INSTANCE_COUNT_ONE, 0U, 0, firstInstance);
+    ++stats.drawCalls;
+}
+
+/**
+ * @brief Records a GPU-filled indirect range.
+ * With VK_KHR_draw_indirect_count the GPU-written counter bounds the range; otherwise the whole
+ * range is issued and culled slots are zeroed commands that draw nothing.
+ */
+void CommandEncoder::drawIndexedIndirect(const IndirectDrawRange& range) {
+    if (range.drawCount != nullptr) {
+        range.drawCount(commandBuffer, range.commands, range.commandOffset, range.counts, range.countOffset,
+            range.maxDrawCount, range.stride);
+    }
+    else {
+        vkCmdDrawIndexedIndirect(commandBuffer, range.commands, range.commandOffset, range.maxDrawCount, range.stride);
+    }
+    ++stats.drawCalls;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+/* parasoft-end-suppress ALL */
+
+class Pipeline;
+
+/**
+ * @struct EncoderStats
+ * @brief Per-frame bind counters used to measure the effect of draw sorting.
+ */
+struct EncoderStats final {
+    uint32_t bindsIssued{ 0U };   /**< Pipeline, descriptor and buffer binds actually recorded. */
+    uint32_t bindsSkipped{ 0U };  /**< Binds elided because the state was already current. */
+    uint32_t drawCalls{ 0U };     /**< Indexed draws recorded through the encoder (an indirect range counts once). */
+};
+
+/**
+ * @struct IndirectDrawRange
+ * @brief A GPU-written range of VkDrawIndexedIndirectCommand records and its optional draw counter.
+ */
+struct IndirectDrawRange final {
+    VkBuffer commands{ VK_NULL_HANDLE };
+    VkDeviceSize commandOffset{ 0U };
+    VkBuffer counts{ VK_NULL_HANDLE };
+    VkDeviceSize countOffset{ 0U };
+    uint32_t maxDrawCount{ 0U };
+    uint32_t stride{ 0U };
+    PFN_vkCmdDrawIndexedIndirectCountKHR drawCount{ nullptr }; /**< When null, unused slots must hold zeroed commands. */
+};
+
+/**
+ * @class CommandEncoder
+ * @brief Thin command-buffer front end that tracks bound state and drops redundant binds.
+ * * All scene pipelines share the global, material and object set layouts and use no push
+ * constants, so their layouts are compatible and bound descriptor sets survive pipeline switches.
+ * Any code that binds state behind the encoder's back must call invalidate() afterwards.
+ */
+class CommandEncoder final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t SET_GLOBAL = 0U;
+    static constexpr uint32_t SET_MATERIAL = 1U;
+    static constexpr uint32_t SET_COUNT = 2U;
+    static constexpr uint32_t SET_OBJECTS = 2U;
+    static constexpr uint32_t BINDING_FIRST = 0U;
+    static constexpr uint32_t BUFFER_COUNT_ONE = 1U;
+    static constexpr uint32_t INSTANCE_COUNT_ONE = 1U;
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Wraps a command buffer in the recording state with no tracked bindings. */
+    explicit CommandEncoder(const VkCommandBuffer inCommandBuffer) : commandBuffer(inCommandBuffer) {}
+
+    /** @brief Destructor: The command buffer is owned by the SyncManager. */
+    ~CommandEncoder() = default;
+
+    // RAII: Tracked state mirrors one command buffer; copies would diverge from it.
+    CommandEncoder(const CommandEncoder&) = delete;
+    CommandEncoder& operator=(const CommandEncoder&) = delete;
+
+    // --- State Binding ---
+
+    /** @brief Forgets all tracked state, forcing the next binds to be recorded. */
+    void invalidate();
+
+    /** @brief Binds a graphics pipeline unless it is already bound. */
+    void bindPipeline(const Pipeline* const pipeline);
+
+    /** @brief Binds the global and material sets, re-recording only the sets that changed. */
+    void bindDescriptorSets(const VkPipelineLayout layout, const VkDescriptorSet globalSet, const VkDescriptorSet materialSet);
+
+    /** @brief Binds the interleaved vertex/index buffer unless it is already bound at this offset. */
+    void bindGeometry(const VkBuffer buffer, const VkDeviceSize indexOffset);
+
+    /** @brief Binds the per-object matrix set (Set 2) unless it is already bound. */
+    void bindObjectSet(const VkPipelineLayout layout, const VkDescriptorSet objectSet);
+
+    /** @brief Records an indexed draw of one object; firstInstance selects its matrices in Set 2. */
+    void drawIndexed(const uint32_t indexCount, const uint32_t firstInstance);
+
+    /** @brief Records a GPU-filled indirect range, using the count buffer when the device supports it. */
+    void drawIndexedIndirect(const IndirectDrawRange& range);
+
+    // --- Accessors ---
+
+    /** @brief Returns the raw command buffer for commands outside the encoder's scope. */
+    VkCommandBuffer getCommandBuffer() const { return commandBuffer; }
+
+    /** @brief Returns the bind counters accumulated since construction. */
+    const EncoderStats& getStats() const { return stats; }
+
+private:
+    // --- Internal State ---
+    VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+    EncoderStats stats{};
+
+    // --- Tracked Bindings ---
+    const Pipeline* boundPipeline{ nullptr };
+    VkDescriptorSet boundGlobalSet{ VK_NULL_HANDLE };
+    VkDescriptorSet boundMaterialSet{ VK_NULL_HANDLE };
+    VkDescriptorSet boundObjectSet{ VK_NULL_HANDLE };
+    VkBuffer boundVertexBuffer{ VK_NULL_HANDLE };
+    VkBuffer boundIndexBuffer{ VK_NULL_HANDLE };
+    VkDeviceSize boundIndexOffset{ 0U };
+};
@@ -13,7 +13,6 @@
 namespace EngineConstants {
     // --- Global Simulation & Rendering ---
     static constexpr uint32_t SHADOW_MAP_RES = 2048U;       /**< Resolution for the depth-pass texture. */
-    static constexpr uint32_t PARTICLE_POOL_SIZE = 20000U;  /**< Maximum number of active particles. */
     static constexpr uint32_t MAX_SPARK_LIGHTS = 4U;        /**< Max dynamic emitters from particle system. */
 
     // --- Logic Sanitization ---
@@ -37,6 +36,10 @@ namespace EngineConstants {
     // --- Descriptor Set Bindings ---
     static constexpr uint32_t BINDING_UBO = 0U;            /**< Binding for Global UBO (Set 0). */
     static constexpr uint32_t BINDING_SHADOW_SAMPLER = 1U; /**< Binding for Shadow Depth Sampler. */
+    static constexpr uint32_t BINDING_SCENE_DEPTH = 3U;    /**< Binding for the previous frame's scene depth (Set 0, compute). */
+    static constexpr uint32_t BINDING_SNOW_COVER = 4U;     /**< Binding for the snow heightmap storage buffer (Set 0). */
+    static constexpr uint32_t BINDING_WIND_FIELD = 5U;     /**< Binding for the shared wind field 3D texture (Set 0, compute). */
+    static constexpr uint32_t BINDING_OBJECTS = 0U;        /**< Binding for the per-object storage buffer (Set 2). */
 
     // --- Environmental & Orbital Parameters ---
     static const glm::vec3 COLOR_DAY{ 1.0f, 1.0f, 1.0f };
@@ -46,6 +49,58 @@ namespace EngineConstants {
     static constexpr float NIGHT_INTENSITY = 0.5f;
 }
 
+/**
+ * @struct BoundingVolume
+ * @brief Axis-aligned box and enclosing sphere of a mesh, in local or world space.
+ * * Meshes without computed bounds keep valid == false and are never culled.
+ */
+struct BoundingVolume {
+    glm::vec3 aabbMin{ 0.0f, 0.0f, 0.0f };
+    glm::vec3 aabbMax{ 0.0f, 0.0f, 0.0f };
+    glm::vec3 sphereCenter{ 0.0f, 0.0f, 0.0f };
+    float sphereRadius{ 0.0f };
+    bool valid{ false };
+};
+
+/**
+ * @struct RecordTimings
+ * @brief CPU time spent recording each parallel pass, and the wall time of the whole frame recording.
+ * When the passes overlap, the wall time approaches the slowest pass instead of the sum.
+ */
+struct RecordTimings final {
+    double shadowMs{ 0.0 };
+    double opaqueMs{ 0.0 };
+    double transparentMs{ 0.0 };
+    double wallMs{ 0.0 };
+    uint32_t threads{ 0U };
+};
+
+/**
+ * @struct BundleStats
+ * @brief Session counters of the pre-recorded static geometry bundles.
+ * savedMs sums, over every frame that reused a bundle, the CPU time that bundle took to record.
+ */
+struct BundleStats final {
+    uint32_t draws{ 0U };          /**< Meshes baked into the most recent recording. */
+    uint64_t recordings{ 0U };
+    uint64_t reusedFrames{ 0U };
+    double lastRecordMs{ 0.0 };
+    double savedMs{ 0.0 };
+};
+
+/**
+ * @struct ParticlePathStats
+ * @brief Work one frame's particle simulation recorded, to compare the per-system and unified paths.
+ * gpuMs spans the simulation dispatches (and spark readback) only; the depth sorts and draws are not included.
+ */
+struct ParticlePathStats final {
+    bool unified{ false };
+    uint32_t dispatches{ 0U };
+    uint32_t barriers{ 0U };
+    uint32_t drawCalls{ 0U };
+    float gpuMs{ 0.0f };
+};
+
 /**
  * @struct SparkLight
  * @brief Light data for procedural spark particles, aligned for GPU consumption.
@@ -76,7 +131,18 @@ struct UniformBufferObject {
     // 3. Simulation Logic Flags and Scalars
     int32_t useGouraud{ EngineConstants::SHADER_FALSE };
     float time{ 0.0f };
+    float renderScale{ 1.0f };   /**< Dynamic resolution scale; fills std140 padding, so sparks keep their offset. */
 
     // 4. Dynamic Light Data Array
     alignas(16) SparkLight sparks[EngineConstants::MAX_SPARK_LIGHTS]{};
+
+    // 5. Particle Collision (read by the particle simulations against the previous frame's depth)
+    alignas(16) glm::mat4 depthViewProj{ 1.0f };   /**< View-projection the scene depth was rendered with. */
+    alignas(16) glm::vec4 depthParams{ 0.0f };     /**< Render extent (xy, zero disables collision), proj[2][2] and proj[3][2] (zw). */
+
+    // 6. Particle LOD (read by the particle draws, see ParticleLodController)
+    alignas(16) glm::vec4 particleLod{ 1.0f, 1.0f, 1.0f, 0.0f };   /**< Kept fraction, point-size scale and alpha scale (xyz). */
+
+    // 7. Wind Field (read by the particle simulations, see WindField)
+    float windStrength{ 0.0f };   /**< Scale of the sampled wind field; zero disables the wind. */
 };
\ No newline at end of file
@@ -70,12 +70,22 @@ std::map<std::string, ObjectTransform> ConfigLoader::loadConfig(const std::strin
                 >> configs[currentObject].color.b;
         }
         // Parse Generic Dynamic Parameters (handles dynamic material or simulation properties)
+        // Values that do not start with a number are kept verbatim as labels.
         else if (!key.empty() && (key.back() == CHAR_KEY_DELIM)) {
-            float val{ 0.0f };
-            ss >> val;
+            std::string value{ "" };
+            ss >> value;
 
             const size_t keyLen = static_cast<size_t>(key.size() - EngineConstants::OFFSET_ONE);
-            configs[currentObject].params[key.substr(INDEX_FIRST, keyLen)] = val;
+            const std::string name = key.substr(INDEX_FIRST, keyLen);
+
+            std::stringstream numeric(value);
+            float val{ 0.0f };
+            if (numeric >> val) {
+                configs[currentObject].params[name] = val;
+            }
+            else {
+                configs[currentObject].labels[name] = value;
+            }
         }
     }
 
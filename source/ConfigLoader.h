@@ -27,6 +27,9 @@ struct ObjectTransform {
     // --- Dynamic Parameters ---
     /** @brief Map for custom properties like material intensity or growth factors. */
     std::map<std::string, float> params{};
+
+    /** @brief Map for custom properties whose value is not a number (e.g. an emitter's shader set). */
+    std::map<std::string, std::string> labels{};
 };
 
 /**
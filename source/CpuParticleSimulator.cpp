@@ -0,0 +1,923 @@
+#include "CpuParticleSimulator.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+// MSVC compiles AVX2 intrinsics without /arch:AVX2, so the kernels are always built and picked at
+// run time; other compilers need the target enabled (-mavx2) to build them at all.
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__AVX2__)
+#define CPU_PARTICLES_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define CPU_PARTICLES_AVX2 0
+#endif
+/* parasoft-end-suppress ALL */
+
+#include "CommonStructs.h"
+#include "SnowCover.h"
+#include "WindField.h"
+
+namespace {
+
+// ========================================================================
+// SECTION 1: LANE TYPES
+// ========================================================================
+
+/**
+ * @struct KernelParams
+ * @brief Per-step constants of a kernel (the ubo fields and SPAWN_RADIUS of the shaders, and the scene set).
+ */
+struct KernelParams {
+    float deltaTime;
+    float totalTime;
+    glm::vec3 lightColor;
+    glm::vec3 emitterPos;
+    float spawnRadius;
+    const CpuParticleScene* scene;   // Null or windless: still air; null or no depth extent: no scene collision
+};
+
+/**
+ * @struct Lanes
+ * @brief The Particle fields of one lane group, one member per component (structure of arrays).
+ */
+template <typename F>
+struct Lanes {
+    F px, py, pz, size;    // position.xyzw
+    F vx, vy, vz, life;    // velocity.xyzw
+    F r, g, b, a;          // color
+    F index;               // float(index), as the kernels hash it
+};
+
+// Cephes single precision sine/cosine: octant reduction in three parts, then the minimax polynomials.
+// Both lane types evaluate it with the same operations, so the AVX2 and scalar paths agree bit for bit.
+constexpr float FOUR_OVER_PI = 1.27323954473516f;
+constexpr float REDUCE_1 = -0.78515625f;
+constexpr float REDUCE_2 = -2.4187564849853515625e-4f;
+constexpr float REDUCE_3 = -3.77489497744594108e-8f;
+constexpr float COS_P0 = 2.443315711809948e-5f;
+constexpr float COS_P1 = -1.388731625493765e-3f;
+constexpr float COS_P2 = 4.166664568298827e-2f;
+constexpr float SIN_P0 = -1.9515295891e-4f;
+constexpr float SIN_P1 = 8.3321608736e-3f;
+constexpr float SIN_P2 = -1.6666654611e-1f;
+
+/**
+ * @namespace lanes
+ * @brief GLSL built-ins over a lane type: float (one particle) or Vec8 (eight, AVX2).
+ */
+namespace lanes {
+    inline float select(const bool mask, const float a, const float b) { return mask ? a : b; }
+    inline bool both(const bool a, const bool b) { return a && b; }
+    inline bool either(const bool a, const bool b) { return a || b; }
+    inline float sqrt(const float x) { return std::sqrt(x); }
+    inline float floor(const float x) { return std::floor(x); }
+    inline float min(const float a, const float b) { return std::min(a, b); }
+    inline float max(const float a, const float b) { return std::max(a, b); }
+    inline uint32_t bits(const bool mask) { return mask ? 1U : 0U; }
+
+    /** @brief Sine and cosine of one lane; within a few ulp of std::sin/std::cos while |x| < 8192. */
+    inline void sinCos(const float x, float& sinOut, float& cosOut) {
+        // Step 1: |x| in octants; j rounded up to even picks the polynomial and the signs
+        float ax = std::fabs(x);
+        const int32_t j = (static_cast<int32_t>(ax * FOUR_OVER_PI) + 1) & ~1;
+        const float y = static_cast<float>(j);
+        const bool sinNegative = std::signbit(x) != ((j & 4) != 0);
+        const bool cosNegative = ((j - 2) & 4) == 0;
+        const bool sinPoly = (j & 2) == 0;
+
+        // Step 2: Extended precision reduction to [-pi/4, pi/4]
+        ax = ax + (y * REDUCE_1);
+        ax = ax + (y * REDUCE_2);
+        ax = ax + (y * REDUCE_3);
+        const float z = ax * ax;
+
+        // Step 3: Cosine and sine polynomials on the reduced argument
+        float c = (COS_P0 * z) + COS_P1;
+        c = (c * z) + COS_P2;
+        c = (c * z) * z;
+        c = (c - (z * 0.5f)) + 1.0f;
+
+        float s = (SIN_P0 * z) + SIN_P1;
+        s = (s * z) + SIN_P2;
+        s = ((s * z) * ax) + ax;
+
+        // Step 4: Octants 1, 2, 5, 6 swap the polynomials
+        const float sinValue = sinPoly ? s : c;
+        const float cosValue = sinPoly ? c : s;
+        sinOut = sinNegative ? -sinValue : sinValue;
+        cosOut = cosNegative ? -cosValue : cosValue;
+    }
+
+    inline float sin(const float x) { float s = 0.0f; float c = 0.0f; sinCos(x, s, c); return s; }
+    inline float cos(const float x) { float s = 0.0f; float c = 0.0f; sinCos(x, s, c); return c; }
+}
+
+#if CPU_PARTICLES_AVX2
+/**
+ * @struct Vec8
+ * @brief Eight float lanes. Converts implicitly from a float (broadcast) so kernel constants read as in GLSL.
+ */
+struct Vec8 {
+    __m256 v;
+    Vec8() : v(_mm256_setzero_ps()) {}
+    Vec8(const float s) : v(_mm256_set1_ps(s)) {}
+    explicit Vec8(const __m256 x) : v(x) {}
+};
+
+/** @brief Per-lane comparison result (all bits set where true). */
+struct Mask8 {
+    __m256 m;
+};
+
+inline Vec8 operator+(const Vec8& a, const Vec8& b) { return Vec8(_mm256_add_ps(a.v, b.v)); }
+inline Vec8 operator-(const Vec8& a, const Vec8& b) { return Vec8(_mm256_sub_ps(a.v, b.v)); }
+inline Vec8 operator*(const Vec8& a, const Vec8& b) { return Vec8(_mm256_mul_ps(a.v, b.v)); }
+inline Vec8 operator/(const Vec8& a, const Vec8& b) { return Vec8(_mm256_div_ps(a.v, b.v)); }
+inline Vec8 operator-(const Vec8& a) { return Vec8(_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))); }
+inline Vec8& operator+=(Vec8& a, const Vec8& b) { a = a + b; return a; }
+inline Vec8& operator-=(Vec8& a, const Vec8& b) { a = a - b; return a; }
+inline Mask8 operator<(const Vec8& a, const Vec8& b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline Mask8 operator>(const Vec8& a, const Vec8& b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline Mask8 operator<=(const Vec8& a, const Vec8& b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline Mask8 operator>=(const Vec8& a, const Vec8& b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+
+namespace lanes {
+    inline Vec8 select(const Mask8& mask, const Vec8& a, const Vec8& b) { return Vec8(_mm256_blendv_ps(b.v, a.v, mask.m)); }
+    inline Mask8 both(const Mask8& a, const Mask8& b) { return { _mm256_and_ps(a.m, b.m) }; }
+    inline Mask8 either(const Mask8& a, const Mask8& b) { return { _mm256_or_ps(a.m, b.m) }; }
+    inline Vec8 sqrt(const Vec8& x) { return Vec8(_mm256_sqrt_ps(x.v)); }
+    inline Vec8 floor(const Vec8& x) { return Vec8(_mm256_floor_ps(x.v)); }
+    inline Vec8 min(const Vec8& a, const Vec8& b) { return Vec8(_mm256_min_ps(a.v, b.v)); }
+    inline Vec8 max(const Vec8& a, const Vec8& b) { return Vec8(_mm256_max_ps(a.v, b.v)); }
+    inline uint32_t bits(const Mask8& mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask.m)); }
+
+    /** @brief Sine and cosine of eight lanes; the scalar sinCos() step for step. */
+    inline void sinCos(const Vec8& x, Vec8& sinOut, Vec8& cosOut) {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i two = _mm256_set1_epi32(2);
+        const __m256i four = _mm256_set1_epi32(4);
+
+        // Step 1: |x| in octants; j rounded up to even picks the polynomial and the signs
+        __m256 sinSign = _mm256_and_ps(x.v, signMask);
+        __m256 ax = _mm256_andnot_ps(signMask, x.v);
+        __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(ax, _mm256_set1_ps(FOUR_OVER_PI)));
+        j = _mm256_andnot_si256(one, _mm256_add_epi32(j, one));
+        const __m256 y = _mm256_cvtepi32_ps(j);
+
+        sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, four), 29)));
+        const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, two), four), 29));
+        const __m256 sinPoly = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, two), _mm256_setzero_si256()));
+
+        // Step 2: Extended precision reduction to [-pi/4, pi/4]
+        ax = _mm256_add_ps(ax, _mm256_mul_ps(y, _mm256_set1_ps(REDUCE_1)));
+        ax = _mm256_add_ps(ax, _mm256_mul_ps(y, _mm256_set1_ps(REDUCE_2)));
+        ax = _mm256_add_ps(ax, _mm256_mul_ps(y, _mm256_set1_ps(REDUCE_3)));
+        const __m256 z = _mm256_mul_ps(ax, ax);
+
+        // Step 3: Cosine and sine polynomials on the reduced argument
+        __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_P0), z), _mm256_set1_ps(COS_P1));
+        c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(COS_P2));
+        c = _mm256_mul_ps(_mm256_mul_ps(c, z), z);
+        c = _mm256_add_ps(_mm256_sub_ps(c, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_P0), z), _mm256_set1_ps(SIN_P1));
+        s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(SIN_P2));
+        s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, z), ax), ax);
+
+        // Step 4: Octants 1, 2, 5, 6 swap the polynomials
+        sinOut = Vec8(_mm256_xor_ps(_mm256_blendv_ps(c, s, sinPoly), sinSign));
+        cosOut = Vec8(_mm256_xor_ps(_mm256_blendv_ps(s, c, sinPoly), cosSign));
+    }
+
+    inline Vec8 sin(const Vec8& x) { Vec8 s{}; Vec8 c{}; sinCos(x, s, c); return s; }
+    inline Vec8 cos(const Vec8& x) { Vec8 s{}; Vec8 c{}; sinCos(x, s, c); return c; }
+}
+#endif
+
+namespace lanes {
+    template <typename F> F fract(const F& x) { return x - floor(x); }
+    template <typename F> F mix(const F& x, const F& y, const F& t) { return (x * (F(1.0f) - t)) + (y * t); }
+    template <typename F> F length(const F& x, const F& y) { return sqrt((x * x) + (y * y)); }
+    template <typename F> F length(const F& x, const F& y, const F& z) { return sqrt((x * x) + (y * y) + (z * z)); }
+
+    template <typename F> F smoothstep(const float edge0, const float edge1, const F& x) {
+        const F t = min(max((x - F(edge0)) / F(edge1 - edge0), F(0.0f)), F(1.0f));
+        return t * t * (F(3.0f) - (F(2.0f) * t));
+    }
+
+    /** @brief particle_common.glsl hash(): amplifies sin() by 43758, so it is only as exact as sin(). */
+    template <typename F> F hash(const F& n) { return fract(sin(n) * F(43758.5453123f)); }
+}
+
+// ========================================================================
+// SECTION 2: SCENE SET (particle_wind.glsl and particle_collision.glsl)
+// ========================================================================
+
+// World placement of the wind field and the collision depth of particle_collision.glsl
+constexpr float WIND_FIELD_CENTER_Y = -0.3f;
+constexpr float SURFACE_THICKNESS = 0.15f;
+
+/**
+ * @brief sampleWind(): the field filtered as its sampler does (trilinear, clamped to the edge), times the strength.
+ */
+glm::vec3 sampleWind(const CpuParticleScene& scene, const glm::vec3& position) {
+    const int32_t size = static_cast<int32_t>(scene.windResolution);
+    const glm::vec3 coord = ((position - glm::vec3(0.0f, WIND_FIELD_CENTER_Y, 0.0f)) / (2.0f * WindField::HALF_EXTENT)) + 0.5f;
+
+    // Step 1: Texel space; the eight neighbours of the sample point, clamped at the faces
+    const glm::vec3 texel = (coord * static_cast<float>(size)) - 0.5f;
+    const glm::vec3 base = glm::floor(texel);
+    const glm::vec3 weight = texel - base;
+    const glm::ivec3 lo = glm::clamp(glm::ivec3(base), glm::ivec3(0), glm::ivec3(size - 1));
+    const glm::ivec3 hi = glm::clamp(glm::ivec3(base) + 1, glm::ivec3(0), glm::ivec3(size - 1));
+
+    // Step 2: Blend along x, then y, then z
+    const auto cell = [&scene, size](const int32_t x, const int32_t y, const int32_t z) {
+        return glm::vec3(scene.windField[static_cast<size_t>((((z * size) + y) * size) + x)]);
+    };
+    const glm::vec3 y0z0 = glm::mix(cell(lo.x, lo.y, lo.z), cell(hi.x, lo.y, lo.z), weight.x);
+    const glm::vec3 y1z0 = glm::mix(cell(lo.x, hi.y, lo.z), cell(hi.x, hi.y, lo.z), weight.x);
+    const glm::vec3 y0z1 = glm::mix(cell(lo.x, lo.y, hi.z), cell(hi.x, lo.y, hi.z), weight.x);
+    const glm::vec3 y1z1 = glm::mix(cell(lo.x, hi.y, hi.z), cell(hi.x, hi.y, hi.z), weight.x);
+    const glm::vec3 z0 = glm::mix(y0z0, y1z0, weight.y);
+    const glm::vec3 z1 = glm::mix(y0z1, y1z1, weight.y);
+    return glm::mix(z0, z1, weight.z) * scene.windStrength;
+}
+
+/**
+ * @brief hitsSceneDepth(): true just behind the surface that the depth texel under the position shows.
+ */
+bool hitsSceneDepth(const CpuParticleScene& scene, const glm::vec3& position) {
+    const glm::vec2 extent(scene.depthParams.x, scene.depthParams.y);
+    const glm::vec4 clip = scene.depthViewProj * glm::vec4(position, 1.0f);
+    if ((extent.x <= 0.0f) || (clip.w <= 0.0f)) {
+        return false;
+    }
+
+    const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+    if ((std::fabs(ndc.x) > 1.0f) || (std::fabs(ndc.y) > 1.0f)) {
+        return false;
+    }
+
+    const glm::ivec2 texel = glm::min(glm::ivec2(((ndc * 0.5f) + 0.5f) * extent), glm::ivec2(extent) - 1);
+    const size_t offset = (static_cast<size_t>(texel.y) * scene.depthRowLength) + static_cast<size_t>(texel.x);
+    if (offset >= scene.sceneDepth.size()) {
+        return false;
+    }
+
+    const float surfaceW = scene.depthParams.w / (scene.sceneDepth[offset] + scene.depthParams.z);
+    return (clip.w > surfaceW) && (clip.w < (surfaceW + SURFACE_THICKNESS));
+}
+
+/**
+ * @brief snowCoverCell() of the cell under the position, or -1 outside the grid.
+ */
+int32_t snowCoverCell(const glm::vec3& position) {
+    const float scale = static_cast<float>(SnowCover::RESOLUTION) / SnowCover::GRID_SIZE;
+    const int32_t x = static_cast<int32_t>(std::floor((position.x - SnowCover::GRID_MIN) * scale));
+    const int32_t z = static_cast<int32_t>(std::floor((position.z - SnowCover::GRID_MIN) * scale));
+    const int32_t size = static_cast<int32_t>(SnowCover::RESOLUTION);
+    if ((x < 0) || (z < 0) || (x >= size) || (z >= size)) {
+        return -1;
+    }
+    return (z * size) + x;
+}
+
+/**
+ * @brief True if the step's scene has a whole field to sample and a non-zero strength.
+ */
+bool hasWind(const KernelParams& k) {
+    if ((k.scene == nullptr) || (k.scene->windStrength == 0.0f)) {
+        return false;
+    }
+    const size_t size = k.scene->windResolution;
+    return (size > 0U) && (k.scene->windField.size() >= (size * size * size));
+}
+
+namespace lanes {
+    inline bool invert(const bool mask) { return !mask; }
+
+    /** @brief Wind at one lane's position; zero without a windy scene. */
+    inline void wind(const KernelParams& k, const float x, const float y, const float z, float& wx, float& wy, float& wz) {
+        const glm::vec3 w = hasWind(k) ? sampleWind(*k.scene, glm::vec3(x, y, z)) : glm::vec3(0.0f);
+        wx = w.x;
+        wy = w.y;
+        wz = w.z;
+    }
+
+    /** @brief Scene collision of one lane; never without a scene. */
+    inline bool hitsScene(const KernelParams& k, const float x, const float y, const float z) {
+        return (k.scene != nullptr) && hitsSceneDepth(*k.scene, glm::vec3(x, y, z));
+    }
+}
+
+#if CPU_PARTICLES_AVX2
+namespace lanes {
+    inline Mask8 invert(const Mask8& mask) { return { _mm256_xor_ps(mask.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))) }; }
+
+    /** @brief Wind at eight positions: the fetches are gathers, so the lanes go through the scalar sampler. */
+    inline void wind(const KernelParams& k, const Vec8& x, const Vec8& y, const Vec8& z, Vec8& wx, Vec8& wy, Vec8& wz) {
+        if (!hasWind(k)) {
+            wx = Vec8(0.0f);
+            wy = Vec8(0.0f);
+            wz = Vec8(0.0f);
+            return;
+        }
+
+        alignas(32) std::array<std::array<float, CpuParticleSimulator::LANE_WIDTH>, 3U> in{};
+        alignas(32) std::array<std::array<float, CpuParticleSimulator::LANE_WIDTH>, 3U> out{};
+        _mm256_store_ps(in[0].data(), x.v);
+        _mm256_store_ps(in[1].data(), y.v);
+        _mm256_store_ps(in[2].data(), z.v);
+        for (uint32_t lane = 0U; lane < CpuParticleSimulator::LANE_WIDTH; ++lane) {
+            wind(k, in[0][lane], in[1][lane], in[2][lane], out[0][lane], out[1][lane], out[2][lane]);
+        }
+        wx = Vec8(_mm256_load_ps(out[0].data()));
+        wy = Vec8(_mm256_load_ps(out[1].data()));
+        wz = Vec8(_mm256_load_ps(out[2].data()));
+    }
+
+    /** @brief Scene collision of eight lanes, one depth texel each through the scalar test. */
+    inline Mask8 hitsScene(const KernelParams& k, const Vec8& x, const Vec8& y, const Vec8& z) {
+        alignas(32) std::array<std::array<float, CpuParticleSimulator::LANE_WIDTH>, 3U> in{};
+        alignas(32) std::array<int32_t, CpuParticleSimulator::LANE_WIDTH> hit{};
+        if (k.scene != nullptr) {
+            _mm256_store_ps(in[0].data(), x.v);
+            _mm256_store_ps(in[1].data(), y.v);
+            _mm256_store_ps(in[2].data(), z.v);
+            for (uint32_t lane = 0U; lane < CpuParticleSimulator::LANE_WIDTH; ++lane) {
+                hit[lane] = hitsScene(k, in[0][lane], in[1][lane], in[2][lane]) ? -1 : 0;
+            }
+        }
+        return { _mm256_castsi256_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(hit.data()))) };
+    }
+}
+#endif
+
+// ========================================================================
+// SECTION 3: KERNELS (one per *_effect.glsl simulateParticle)
+// ========================================================================
+
+// Globe bounds of particle_common.glsl
+constexpr float SPHERE_CENTER_Y = -0.3f;
+constexpr float GLOBE_RADIUS = 1.70f;
+constexpr float FLOOR_Y = -0.12f;
+
+template <typename F>
+auto simulateDust(Lanes<F>& p, const KernelParams& k) {
+    using namespace lanes;
+    const F dt(k.deltaTime);
+
+    // 1. Randomized decay
+    const F decaySpeed = F(0.15f) + (hash(p.index * F(0.5f)) * F(0.2f));
+    p.life += dt * decaySpeed;
+    const F age = p.life;
+
+    // 2. Vortex rotation, faster near the axis
+    const F relX = p.px;
+    const F relZ = p.pz;
+    const F dist = length(relX, relZ);
+    const F angleShift = dt * (F(0.35f) / (dist + F(0.2f)));
+    const F s = sin(angleShift);
+    const F c = cos(angleShift);
+    p.px = (relX * c) - (relZ * s);
+    p.pz = (relX * s) + (relZ * c);
+
+    // 3. Inward suction along the pre-rotation direction
+    const F suction = dt * F(0.15f);
+    p.px -= (relX / dist) * suction;
+    p.pz -= (relZ / dist) * suction;
+
+    // 4. Wind drift: fine sand follows the air completely
+    F windX{};
+    F windY{};
+    F windZ{};
+    wind(k, p.px, p.py, p.pz, windX, windY, windZ);
+    p.px += windX * dt;
+    p.py += windY * dt;
+    p.pz += windZ * dt;
+
+    // 5. Vertical drift and clamps
+    p.py += p.vy * dt;
+    p.vy = select(p.py > F(0.45f), F(-0.015f), p.vy);
+    p.py = select(p.py < F(-0.05f), F(0.0f), p.py);
+
+    // 6. Sand tint under the scene light, radial fade and pulsing alpha
+    const F tint = hash(p.index);
+    p.r = mix(F(0.76f), F(0.55f), tint) * F(k.lightColor.x) * F(0.7f);
+    p.g = mix(F(0.70f), F(0.45f), tint) * F(k.lightColor.y) * F(0.7f);
+    p.b = mix(F(0.50f), F(0.30f), tint) * F(k.lightColor.z) * F(0.7f);
+    p.a = sin(age * F(3.14159f)) * F(0.4f) * smoothstep(0.02f, 0.15f, dist);
+
+    return both(age <= F(1.0f), dist >= F(0.02f));
+}
+
+template <typename F>
+auto simulateFire(Lanes<F>& p, const KernelParams& k) {
+    using namespace lanes;
+    const F dt(k.deltaTime);
+
+    // 1. Decay
+    const F decaySpeed = F(2.4f) + (hash(p.index * F(0.1f)) * F(1.5f));
+    p.life -= dt * decaySpeed;
+    const F life = p.life;
+
+    // 2. Thermal gradient: cool -> mid below 0.7, mid -> hot above
+    const auto hot = life > F(0.7f);
+    const F hotT = (life - F(0.7f)) * F(3.3f);
+    const F coolT = life * F(1.4f);
+    p.r = select(hot, mix(F(1.0f), F(1.0f), hotT), mix(F(0.5f), F(1.0f), coolT));
+    p.g = select(hot, mix(F(0.4f), F(1.0f), hotT), mix(F(0.0f), F(0.4f), coolT));
+    p.b = select(hot, mix(F(0.0f), F(0.7f), hotT), mix(F(0.0f), F(0.0f), coolT));
+    p.a = life * F(0.8f);
+
+    // 3. Whirl around the emitter axis
+    const F angleShift = dt * (F(5.0f) * life);
+    const F s = sin(angleShift);
+    const F c = cos(angleShift);
+    const F centerX(k.emitterPos.x);
+    const F centerZ(k.emitterPos.z);
+    const F relX = p.px - centerX;
+    const F relZ = p.pz - centerZ;
+    p.px = centerX + ((relX * c) - (relZ * s));
+    p.pz = centerZ + ((relX * s) + (relZ * c));
+
+    // 4. Radius profile: pull back inside the diamond, then the constant centripetal pull
+    const F targetRadius = F(0.12f) * sin(life * F(3.14159f));
+    const F toCenterX = centerX - p.px;
+    const F toCenterZ = centerZ - p.pz;
+    const F currentDist = length(toCenterX, toCenterZ);
+    const F pull = (currentDist - targetRadius) * F(0.5f);
+    const auto outside = currentDist > targetRadius;
+    p.px = select(outside, p.px + ((toCenterX / currentDist) * pull), p.px);
+    p.pz = select(outside, p.pz + ((toCenterZ / currentDist) * pull), p.pz);
+    p.px += toCenterX * dt * F(5.0f);
+    p.pz += toCenterZ * dt * F(5.0f);
+
+    // 5. Turbulence, integration with a fraction of the wind, and buoyancy
+    const F time(k.totalTime);
+    const F noiseX = hash((p.px * F(20.0f)) + time);
+    const F noiseZ = hash((p.pz * F(20.0f)) + time);
+    p.vx += (noiseX - F(0.5f)) * F(0.15f) * life;
+    p.vz += (noiseZ - F(0.5f)) * F(0.15f) * life;
+
+    F windX{};
+    F windY{};
+    F windZ{};
+    wind(k, p.px, p.py, p.pz, windX, windY, windZ);
+    p.px += (p.vx + (windX * F(0.3f))) * dt;
+    p.py += (p.vy + (windY * F(0.3f))) * dt;
+    p.pz += (p.vz + (windZ * F(0.3f))) * dt;
+    p.vy += dt * F(0.05f);
+
+    return p.life > F(0.0f);
+}
+
+template <typename F>
+auto simulateSmoke(Lanes<F>& p, const KernelParams& k) {
+    using namespace lanes;
+    const F dt(k.deltaTime);
+
+    // 1. Age
+    p.life += dt * F(0.3f);
+    const F age = p.life;
+
+    // 2. Rise and widen with age
+    const F expansion = age * F(0.5f);
+    const F phase = F(k.totalTime) + p.index;
+    p.px += p.vx * dt;
+    p.py += p.vy * dt;
+    p.pz += p.vz * dt;
+    p.px += sin(phase) * expansion * dt;
+    p.pz += cos(phase) * expansion * dt;
+
+    // 3. Drift with the air
+    F windX{};
+    F windY{};
+    F windZ{};
+    wind(k, p.px, p.py, p.pz, windX, windY, windZ);
+    p.px += windX * dt;
+    p.py += windY * dt;
+    p.pz += windZ * dt;
+
+    // 4. Expired or at the glass
+    const F distFromCenter = length(p.px, p.py - F(SPHERE_CENTER_Y), p.pz);
+    return both(age <= F(1.0f), distFromCenter <= F(GLOBE_RADIUS));
+}
+
+template <typename F>
+auto simulateRain(Lanes<F>& p, const KernelParams& k) {
+    using namespace lanes;
+    const F dt(k.deltaTime);
+
+    // Integration; the wind only pushes the drop sideways
+    p.px += p.vx * dt;
+    p.py += p.vy * dt;
+    p.pz += p.vz * dt;
+
+    F windX{};
+    F windY{};
+    F windZ{};
+    wind(k, p.px, p.py, p.pz, windX, windY, windZ);
+    p.px += windX * F(0.5f) * dt;
+    p.pz += windZ * F(0.5f) * dt;
+
+    // Floor, glass and life, then the scene depth
+    const F distFromCenter = length(p.px, p.py - F(SPHERE_CENTER_Y), p.pz);
+    const auto inFlight = both(both(p.py >= F(FLOOR_Y), distFromCenter <= F(GLOBE_RADIUS)), p.life > F(0.0f));
+    return both(inFlight, invert(hitsScene(k, p.px, p.py, p.pz)));
+}
+
+template <typename F>
+auto simulateSnow(Lanes<F>& p, const KernelParams& k, uint32_t& settled) {
+    using namespace lanes;
+    const F dt(k.deltaTime);
+    const F time(k.totalTime);
+
+    // Sway, fall, then most of the wind
+    p.px += sin((time * F(1.5f)) + p.index) * F(0.2f) * dt;
+    p.pz += cos((time * F(1.2f)) + p.index) * F(0.1f) * dt;
+    p.py += p.vy * dt;
+
+    F windX{};
+    F windY{};
+    F windZ{};
+    wind(k, p.px, p.py, p.pz, windX, windY, windZ);
+    p.px += windX * F(0.8f) * dt;
+    p.py += windY * F(0.8f) * dt;
+    p.pz += windZ * F(0.8f) * dt;
+
+    // Outside the glass a flake just dies; on the floor or the scene it settles into the snow cover
+    const F distFromCenter = length(p.px, p.py - F(SPHERE_CENTER_Y), p.pz);
+    const auto inside = distFromCenter <= F(GLOBE_RADIUS);
+    const auto landed = both(inside, either(p.py < F(FLOOR_Y), hitsScene(k, p.px, p.py, p.pz)));
+    settled = bits(landed);
+    return both(inside, invert(landed));
+}
+
+/**
+ * @brief Runs the effect's kernel and returns one alive bit per lane; settled gets one bit per flake that landed.
+ */
+template <typename F>
+uint32_t simulateLanes(const CpuParticleSimulator::Effect effect, Lanes<F>& p, const KernelParams& k, uint32_t& settled) {
+    settled = 0U;
+    switch (effect) {
+    case CpuParticleSimulator::Effect::Dust:
+        return lanes::bits(simulateDust(p, k));
+    case CpuParticleSimulator::Effect::Fire:
+        return lanes::bits(simulateFire(p, k));
+    case CpuParticleSimulator::Effect::Smoke:
+        return lanes::bits(simulateSmoke(p, k));
+    case CpuParticleSimulator::Effect::Rain:
+        return lanes::bits(simulateRain(p, k));
+    default:
+        return lanes::bits(simulateSnow(p, k, settled));
+    }
+}
+
+/** @brief Loads one particle into a scalar lane group. */
+void loadLanes(const std::vector<Particle>& particles, const uint32_t* const indices, Lanes<float>& p) {
+    const Particle& src = particles[indices[0]];
+    p = { src.position.x, src.position.y, src.position.z, src.position.w,
+        src.velocity.x, src.velocity.y, src.velocity.z, src.velocity.w,
+        src.color.r, src.color.g, src.color.b, src.color.a, static_cast<float>(indices[0]) };
+}
+
+/** @brief Stores a scalar lane group back into its particle. */
+void storeLanes(std::vector<Particle>& particles, const uint32_t* const indices, const Lanes<float>& p) {
+    Particle& dst = particles[indices[0]];
+    dst.position = glm::vec4(p.px, p.py, p.pz, p.size);
+    dst.velocity = glm::vec4(p.vx, p.vy, p.vz, p.life);
+    dst.color = glm::vec4(p.r, p.g, p.b, p.a);
+}
+
+#if CPU_PARTICLES_AVX2
+constexpr size_t FIELD_COUNT = 12U;   // Lane fields loaded from a Particle (all but the index)
+constexpr size_t COMPONENTS = 4U;
+
+/** @brief The Particle vectors and the lane fields their components map to, in the same order. */
+const std::array<glm::vec4 Particle::*, 3> PARTICLE_VECTORS = { &Particle::position, &Particle::velocity, &Particle::color };
+const std::array<Vec8 Lanes<Vec8>::*, FIELD_COUNT> LANE_FIELDS = {
+    &Lanes<Vec8>::px, &Lanes<Vec8>::py, &Lanes<Vec8>::pz, &Lanes<Vec8>::size,
+    &Lanes<Vec8>::vx, &Lanes<Vec8>::vy, &Lanes<Vec8>::vz, &Lanes<Vec8>::life,
+    &Lanes<Vec8>::r, &Lanes<Vec8>::g, &Lanes<Vec8>::b, &Lanes<Vec8>::a
+};
+
+/** @brief Transposes eight particles into a lane group. */
+void loadLanes(const std::vector<Particle>& particles, const uint32_t* const indices, Lanes<Vec8>& p) {
+    alignas(32) std::array<std::array<float, CpuParticleSimulator::LANE_WIDTH>, FIELD_COUNT> fields{};
+    alignas(32) std::array<float, CpuParticleSimulator::LANE_WIDTH> index{};
+    for (uint32_t lane = 0U; lane < CpuParticleSimulator::LANE_WIDTH; ++lane) {
+        const Particle& src = particles[indices[lane]];
+        for (size_t f = 0U; f < FIELD_COUNT; ++f) {
+            fields[f][lane] = (src.*PARTICLE_VECTORS[f / COMPONENTS])[static_cast<glm::length_t>(f % COMPONENTS)];
+        }
+        index[lane] = static_cast<float>(indices[lane]);
+    }
+
+    for (size_t f = 0U; f < FIELD_COUNT; ++f) {
+        p.*LANE_FIELDS[f] = Vec8(_mm256_load_ps(fields[f].data()));
+    }
+    p.index = Vec8(_mm256_load_ps(index.data()));
+}
+
+/** @brief Transposes a lane group back into its eight particles. */
+void storeLanes(std::vector<Particle>& particles, const uint32_t* const indices, const Lanes<Vec8>& p) {
+    alignas(32) std::array<std::array<float, CpuParticleSimulator::LANE_WIDTH>, FIELD_COUNT> fields{};
+    for (size_t f = 0U; f < FIELD_COUNT; ++f) {
+        _mm256_store_ps(fields[f].data(), (p.*LANE_FIELDS[f]).v);
+    }
+
+    for (uint32_t lane = 0U; lane < CpuParticleSimulator::LANE_WIDTH; ++lane) {
+        Particle& dst = particles[indices[lane]];
+        for (size_t f = 0U; f < FIELD_COUNT; ++f) {
+            (dst.*PARTICLE_VECTORS[f / COMPONENTS])[static_cast<glm::length_t>(f % COMPONENTS)] = fields[f][lane];
+        }
+    }
+}
+#endif
+
+} // namespace
+
+// ========================================================================
+// SECTION 4: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Every particle starts dead, and the workers are started for the simulation ranges.
+ */
+CpuParticleSimulator::CpuParticleSimulator(const Effect inEffect, const uint32_t capacity, const float inSpawnRadius,
+    const uint32_t inSpawnBudget, const uint32_t workerCount)
+    : effect(inEffect),
+    spawnRadius(inSpawnRadius),
+    spawnBudget(inSpawnBudget),
+    avx2(isAvx2Supported()),
+    particles(capacity),
+    snowCover(SnowCover::CELL_COUNT, 0U)
+{
+    // Step 1: All dead; the dead list is popped from the back, so index 0 is emitted first
+    deadList.resize(capacity);
+    for (uint32_t i = 0U; i < capacity; ++i) {
+        deadList[i] = capacity - 1U - i;
+    }
+    aliveList.reserve(capacity);
+    survivorList.reserve(capacity);
+
+    // Step 2: The calling thread runs the last range itself, so it needs one worker less
+    const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), EngineConstants::COUNT_ONE);
+    rangeCount = (workerCount == 0U) ? hardwareThreads : workerCount;
+    ranges.resize(rangeCount);
+    if (rangeCount > EngineConstants::COUNT_ONE) {
+        workers = std::make_unique<PassWorkerPool>(rangeCount - EngineConstants::COUNT_ONE);
+    }
+}
+
+/**
+ * @brief Maps the built-in shader sets to their kernels.
+ */
+std::optional<CpuParticleSimulator::Effect> CpuParticleSimulator::effectOf(const std::string& shaderSet) {
+    static const std::array<std::pair<const char*, Effect>, 5> effects = { {
+        { "dust", Effect::Dust }, { "fire", Effect::Fire }, { "smoke", Effect::Smoke },
+        { "rain", Effect::Rain }, { "snow", Effect::Snow }
+    } };
+
+    for (const auto& entry : effects) {
+        if (shaderSet == entry.first) {
+            return entry.second;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Checks the CPU's AVX2 flag and that the OS saves the YMM registers.
+ */
+bool CpuParticleSimulator::isAvx2Supported() {
+#if CPU_PARTICLES_AVX2 && defined(_MSC_VER)
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info.data(), 1);
+    const bool osSavesYmm = ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) &&
+        ((_xgetbv(0U) & 0x6ULL) == 0x6ULL);
+
+    __cpuidex(info.data(), 7, 0);
+    return osSavesYmm && ((info[1] & (1 << 5)) != 0);
+#elif CPU_PARTICLES_AVX2
+    return true;   // Built with -mavx2: the binary already requires it
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Takes over a system's particles with all of them alive, as a new system's first frame sees them.
+ */
+void CpuParticleSimulator::reset(const std::vector<Particle>& state, const std::vector<uint32_t>& alive) {
+    if (state.size() != particles.size()) {
+        throw std::runtime_error("CpuParticleSimulator: Reset with " + std::to_string(state.size()) +
+            " particles, capacity is " + std::to_string(particles.size()));
+    }
+
+    // Step 1: Validate the alive list; an index twice or out of range would corrupt the lists
+    std::vector<bool> isAlive(particles.size(), false);
+    for (const uint32_t index : alive) {
+        if ((index >= isAlive.size()) || isAlive[index]) {
+            throw std::runtime_error("CpuParticleSimulator: Invalid alive list entry " + std::to_string(index));
+        }
+        isAlive[index] = true;
+    }
+
+    // Step 2: Adopt the state; the dead list is the complement, lowest index emitted first
+    particles = state;
+    aliveList = alive;
+    deadList.clear();
+    for (size_t i = isAlive.size(); i > 0U; --i) {
+        if (!isAlive[i - 1U]) {
+            deadList.push_back(static_cast<uint32_t>(i - 1U));
+        }
+    }
+}
+
+// ========================================================================
+// SECTION 5: SIMULATION
+// ========================================================================
+
+/**
+ * @brief Emission, then the simulation of the alive list split over the workers, then the list merge.
+ */
+void CpuParticleSimulator::step(const CpuSimulationStep& params) {
+    // Step 1: Emission pops min(dead, budget, room below the limit) particles into the alive list (none while spawning is off)
+    const size_t room = (params.activeLimit > aliveList.size()) ? (params.activeLimit - aliveList.size()) : 0U;
+    const size_t emitCount = params.spawnEnabled ? std::min({ deadList.size(), static_cast<size_t>(spawnBudget), room }) : 0U;
+    const size_t firstEmitted = aliveList.size();
+    for (size_t i = 0U; i < emitCount; ++i) {
+        aliveList.push_back(deadList.back());
+        deadList.pop_back();
+    }
+    emit(params, firstEmitted);
+
+    // Step 2: Contiguous shares of the alive list; small lists use fewer workers
+    const size_t aliveCount = aliveList.size();
+    const size_t wanted = (aliveCount + MIN_RANGE - 1U) / MIN_RANGE;
+    const size_t used = std::clamp(wanted, static_cast<size_t>(EngineConstants::COUNT_ONE), static_cast<size_t>(rangeCount));
+    const size_t share = (aliveCount + used - 1U) / used;
+
+    if ((used == EngineConstants::COUNT_ONE) || (workers == nullptr)) {
+        simulateRange(params, 0U, aliveCount, ranges[0]);
+    }
+    else {
+        std::vector<std::function<void()>> jobs{};
+        jobs.reserve(used);
+        for (size_t r = 0U; r < used; ++r) {
+            const size_t first = std::min(r * share, aliveCount);
+            const size_t last = std::min(first + share, aliveCount);
+            jobs.push_back([this, &params, first, last, r]() { simulateRange(params, first, last, ranges[r]); });
+        }
+        workers->run(jobs);
+    }
+
+    // Step 3: Survivors in range order become the alive list; the dead go back to the dead list, settled flakes into the cover
+    survivorList.clear();
+    for (size_t r = 0U; r < used; ++r) {
+        survivorList.insert(survivorList.end(), ranges[r].survivors.begin(), ranges[r].survivors.end());
+        deadList.insert(deadList.end(), ranges[r].deaths.begin(), ranges[r].deaths.end());
+        for (const uint32_t cell : ranges[r].deposits) {
+            snowCover[cell] += SnowCover::UNITS_PER_FLAKE;
+        }
+    }
+    aliveList.swap(survivorList);
+}
+
+/**
+ * @brief Runs the effect's emitParticle() on the particles popped this step (few per step, so scalar).
+ */
+void CpuParticleSimulator::emit(const CpuSimulationStep& params, const size_t firstEmitted) {
+    using lanes::hash;
+
+    for (size_t i = firstEmitted; i < aliveList.size(); ++i) {
+        const uint32_t index = aliveList[i];
+        Particle& p = particles[index];
+        const float id = static_cast<float>(index);
+
+        switch (effect) {
+        case Effect::Dust: {
+            // Spawn ring at ground level
+            const float seed = id + params.totalTime;
+            const float angle = hash(seed) * 6.28318f;
+            const float radius = 0.25f + (hash(seed + 1.0f) * std::max(spawnRadius - 0.25f, 0.0f));
+            p.position = glm::vec4(lanes::cos(angle) * radius, 0.0f, lanes::sin(angle) * radius, 4.0f + (hash(seed + 3.0f) * 4.0f));
+            p.velocity.w = 0.0f;
+            p.velocity.y = 0.01f + (hash(seed + 2.0f) * 0.02f);
+            p.color.a = 0.2f;
+            break;
+        }
+        case Effect::Fire: {
+            // Ring at the base of the fire with an outward burst
+            const float seed = id + (params.totalTime * 512.0f);
+            const float angle = hash(seed) * 6.28318f;
+            p.position.x = params.emitterPos.x + (lanes::cos(angle) * spawnRadius);
+            p.position.y = -0.12f;
+            p.position.z = params.emitterPos.z + (lanes::sin(angle) * spawnRadius);
+            p.velocity = glm::vec4(lanes::cos(angle) * 0.15f, 0.12f + (hash(seed + 3.0f) * 0.15f), lanes::sin(angle) * 0.15f, 1.0f);
+            break;
+        }
+        case Effect::Smoke: {
+            // Just above the emitter, rising
+            const float seed = id + params.totalTime;
+            p.position = glm::vec4(params.emitterPos.x + ((hash(seed) - 0.5f) * 2.0f * spawnRadius), params.emitterPos.y + 0.15f,
+                params.emitterPos.z + ((hash(seed + 1.0f) - 0.5f) * 2.0f * spawnRadius), 4.0f + (hash(seed + 3.0f) * 4.0f));
+            p.velocity = glm::vec4(0.0f, 0.6f + (hash(seed + 2.0f) * 0.4f), 0.0f, 0.0f);
+            p.color = glm::vec4(0.005f, 0.005f, 0.005f, 0.95f);
+            break;
+        }
+        default: {
+            // Rain and snow: a point in the top half of the globe
+            const float seed = id + params.totalTime;
+            const float r = std::min(spawnRadius, GLOBE_RADIUS - 0.05f) * std::pow(hash(seed), 0.33f);
+            const float phi = hash(seed + 1.0f) * 1.57f;
+            const float theta = hash(seed + 2.0f) * 6.28318f;
+            p.position.x = r * lanes::sin(phi) * lanes::cos(theta);
+            p.position.z = r * lanes::sin(phi) * lanes::sin(theta);
+            p.position.y = (r * lanes::cos(phi)) + SPHERE_CENTER_Y;
+
+            if (effect == Effect::Rain) {
+                p.velocity = glm::vec4(0.0f, -4.5f, 0.0f, 1.0f);
+                p.color = glm::vec4(0.6f, 0.7f, 1.0f, 0.4f);
+                p.position.w = 1.2f;
+            }
+            else {
+                p.position.w = 0.4f + (hash(seed + 4.0f) * 0.4f);
+                p.velocity.y = -0.3f - (hash(seed + 3.0f) * 0.2f);
+                p.color = glm::vec4(0.9f, 0.9f, 1.0f, 0.8f);
+            }
+            break;
+        }
+        }
+    }
+}
+
+/**
+ * @brief Simulates a share of the alive list, eight particles at a time with AVX2, then the remainder one by one.
+ */
+void CpuParticleSimulator::simulateRange(const CpuSimulationStep& params, const size_t first, const size_t last, Range& out) {
+    const KernelParams kernel{ params.deltaTime, params.totalTime, params.lightColor, params.emitterPos, spawnRadius, params.scene };
+    const uint32_t* const entries = aliveList.data();
+    out.survivors.clear();
+    out.deaths.clear();
+    out.deposits.clear();
+
+    // A settled flake is deposited where it stopped, as depositSnow() does after the move
+    const auto deposit = [this, &out](const uint32_t index) {
+        const int32_t cell = snowCoverCell(glm::vec3(particles[index].position));
+        if (cell >= 0) {
+            out.deposits.push_back(static_cast<uint32_t>(cell));
+        }
+    };
+
+    size_t i = first;
+#if CPU_PARTICLES_AVX2
+    if (avx2) {
+        for (; (i + LANE_WIDTH) <= last; i += LANE_WIDTH) {
+            Lanes<Vec8> group{};
+            loadLanes(particles, entries + i, group);
+            uint32_t settled{ 0U };
+            const uint32_t alive = simulateLanes(effect, group, kernel, settled);
+            storeLanes(particles, entries + i, group);
+
+            for (uint32_t lane = 0U; lane < LANE_WIDTH; ++lane) {
+                std::vector<uint32_t>& list = (((alive >> lane) & 1U) != 0U) ? out.survivors : out.deaths;
+                list.push_back(entries[i + lane]);
+                if (((settled >> lane) & 1U) != 0U) {
+                    deposit(entries[i + lane]);
+                }
+            }
+        }
+    }
+#endif
+
+    for (; i < last; ++i) {
+        Lanes<float> single{};
+        loadLanes(particles, entries + i, single);
+        uint32_t settled{ 0U };
+        const uint32_t alive = simulateLanes(effect, single, kernel, settled);
+        storeLanes(particles, entries + i, single);
+        ((alive != 0U) ? out.survivors : out.deaths).push_back(entries[i]);
+        if (settled != 0U) {
+            deposit(entries[i]);
+        }
+    }
+}
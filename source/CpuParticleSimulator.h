@@ -0,0 +1,168 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "Particle.h"
+#include "PassWorkerPool.h"
+
+/**
+ * @struct CpuParticleScene
+ * @brief Host copies of what the simulations read from the global scene set (their Set 1).
+ * * The wind field and sample 0 of the scene depth, with the scene UBO fields that go with them; see
+ * particle_wind.glsl and particle_collision.glsl. A default scene has still air and no collision.
+ */
+struct CpuParticleScene final {
+    std::vector<glm::vec4> windField{};       /**< windResolution^3 cells, x fastest (WindField::readBack()). */
+    uint32_t windResolution{ 0U };
+    float windStrength{ 0.0f };               /**< scene.windStrength; zero: still air. */
+    std::vector<float> sceneDepth{};          /**< Depth texels, row by row. */
+    uint32_t depthRowLength{ 0U };            /**< Texels per row of sceneDepth (the image width, at least the extent). */
+    glm::mat4 depthViewProj{ 1.0f };          /**< scene.depthViewProj. */
+    glm::vec4 depthParams{ 0.0f };            /**< scene.depthParams: extent (xy, zero: no collision), proj[2][2] and proj[3][2] (zw). */
+};
+
+/**
+ * @struct CpuSimulationStep
+ * @brief Inputs of one host simulation step; mirrors the ParameterUBO of the compute shaders.
+ */
+struct CpuSimulationStep final {
+    float deltaTime{ 0.0f };
+    float totalTime{ 0.0f };
+    bool spawnEnabled{ true };
+    glm::vec3 lightColor{ 1.0f, 1.0f, 1.0f };
+    glm::vec3 emitterPos{ 0.0f, 0.0f, 0.0f };
+    uint32_t activeLimit{ UINT32_MAX };   /**< Live particles at most (LOD); emission only refills up to it. */
+    const CpuParticleScene* scene{ nullptr };   /**< Wind and scene depth; null: still air, no scene collision. */
+};
+
+/**
+ * @class CpuParticleSimulator
+ * @brief Host port of the particle simulations (the *_effect.glsl kernels driven by particle_simulation.glsl).
+ * * Works on the same Particle layout and follows the same list protocol as the compute path: a step
+ * emits min(dead particles, spawn budget, room below the active limit) particles popped from the back of the dead list and appends
+ * them to the alive list, then simulates the alive list; survivors keep their order and the particles
+ * that died are appended to the dead list.
+ * * The kernels are written once over a lane type and run eight particles at a time with AVX2 when the
+ * CPU supports it, one at a time otherwise; both evaluate the same operations in the same order (sin
+ * and cos included), so the two paths give the same results. The alive list is split into ranges of
+ * at least MIN_RANGE particles that run on persistent workers; every range keeps its own survivors and
+ * deaths, so the result does not depend on the worker count.
+ * * Wind and scene collision follow the shaders when a step carries a CpuParticleScene: every effect
+ * samples the wind field (trilinear, clamped at the faces, as the sampler filters it) with its own
+ * factor, and rain and snow test one depth texel. Settled flakes are counted into a host snow cover
+ * (getSnowCover()). The live host path (ParticleSystem with cpuSimulation) has no host copy of the
+ * wind field or the depth, so its steps carry no scene: its particles move in still air, rain and snow
+ * collide with the floor and the glass only, and its snow cover never reaches the sand.
+ */
+class CpuParticleSimulator final {
+public:
+    /**
+     * @enum Effect
+     * @brief Kernel a simulator runs; one per shader set that ships a host port.
+     */
+    enum class Effect : uint32_t {
+        Dust = 0U,
+        Fire = 1U,
+        Smoke = 2U,
+        Rain = 3U,
+        Snow = 4U
+    };
+
+    // --- Named Constants ---
+    static constexpr uint32_t LANE_WIDTH = 8U;     /**< Particles one AVX2 kernel call advances. */
+    static constexpr uint32_t MIN_RANGE = 1024U;   /**< Fewest particles handed to one worker. */
+
+    // --- Lifecycle ---
+
+    /**
+     * @brief Creates a simulator whose particles are all dead, so spawning fills them.
+     * @param spawnBudget Particles emitted per step at most (already resolved: never 0).
+     * @param workerCount Threads the simulation is split over; 0 uses one per hardware thread.
+     */
+    explicit CpuParticleSimulator(const Effect inEffect, const uint32_t capacity, const float inSpawnRadius,
+        const uint32_t inSpawnBudget, const uint32_t workerCount = 0U);
+
+    /** @brief Destructor: Joins the workers. */
+    ~CpuParticleSimulator() = default;
+
+    // RAII: Owns worker threads; prevent duplication.
+    CpuParticleSimulator(const CpuParticleSimulator&) = delete;
+    CpuParticleSimulator& operator=(const CpuParticleSimulator&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Returns the kernel of a shader set, or nothing if the set has no host port. */
+    static std::optional<Effect> effectOf(const std::string& shaderSet);
+
+    /** @brief Returns true if the CPU and the OS support AVX2 and this build has the AVX2 kernels. */
+    static bool isAvx2Supported();
+
+    /**
+     * @brief Adopts a state (e.g. read back from a ParticleSystem): the particles by buffer index and the
+     * alive list; every other particle is dead. Throws if the count differs from the capacity or an
+     * alive entry is out of range or repeated.
+     */
+    void reset(const std::vector<Particle>& state, const std::vector<uint32_t>& alive);
+
+    /** @brief Emits and simulates one step. */
+    void step(const CpuSimulationStep& params);
+
+    // --- Accessors ---
+
+    /** @brief Returns every particle, alive or not, by buffer index. */
+    const std::vector<Particle>& getParticles() const { return particles; }
+
+    /** @brief Returns the indices of the live particles (the draw's index list). */
+    const std::vector<uint32_t>& getAliveList() const { return aliveList; }
+
+    /** @brief Returns the snow cover cells (SnowCover::CELL_COUNT) the settled flakes were added to since construction. */
+    const std::vector<uint32_t>& getSnowCover() const { return snowCover; }
+
+    /** @brief Returns the number of dead particles. */
+    uint32_t getDeadCount() const { return static_cast<uint32_t>(deadList.size()); }
+
+    /** @brief Returns true if the steps run the AVX2 kernels. */
+    bool usesAvx2() const { return avx2; }
+
+private:
+    /**
+     * @struct Range
+     * @brief Output of one worker's share of the alive list, in list order.
+     */
+    struct Range {
+        std::vector<uint32_t> survivors;
+        std::vector<uint32_t> deaths;
+        std::vector<uint32_t> deposits;   /**< Snow cover cell of every flake that settled. */
+    };
+
+    /** @brief Initializes the particles just popped from the dead list. */
+    void emit(const CpuSimulationStep& params, const size_t firstEmitted);
+
+    /** @brief Simulates entries [first, last) of the alive list into one range. */
+    void simulateRange(const CpuSimulationStep& params, const size_t first, const size_t last, Range& out);
+
+    // --- Configuration ---
+    Effect effect;
+    float spawnRadius;
+    uint32_t spawnBudget;
+    bool avx2;
+
+    // --- State ---
+    std::vector<Particle> particles{};
+    std::vector<uint32_t> aliveList{};
+    std::vector<uint32_t> deadList{};
+    std::vector<uint32_t> survivorList{};   /**< Next alive list, swapped in at the end of a step. */
+    std::vector<uint32_t> snowCover{};
+
+    // --- Parallel Simulation ---
+    std::unique_ptr<PassWorkerPool> workers{};
+    uint32_t rangeCount{ 1U };
+    std::vector<Range> ranges{};
+};
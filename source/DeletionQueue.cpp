@@ -0,0 +1,35 @@
+#include "DeletionQueue.h"
+
+/**
+ * @brief Schedules a deleter to run once the current frame has finished on the GPU.
+ */
+void DeletionQueue::retire(std::function<void()> deleter) {
+    if (deleter) {
+        pending.emplace_back(frameIndex, std::move(deleter));
+    }
+}
+
+/**
+ * @brief Runs every deleter whose frame has completed.
+ */
+void DeletionQueue::collect() {
+    // Step 1: A resource tagged with frame N is safe once frame N + framesInFlight is being recorded,
+    // because the fence waited on for that slot was signaled by frame N's submission.
+    while (!pending.empty() && ((pending.front().first + static_cast<uint64_t>(framesInFlight)) <= frameIndex)) {
+        // Step 2: Detach the entry before running it so a deleter may safely retire further work
+        std::function<void()> deleter = std::move(pending.front().second);
+        pending.pop_front();
+        deleter();
+    }
+}
+
+/**
+ * @brief Runs every pending deleter immediately. Only valid once the device is idle.
+ */
+void DeletionQueue::flush() {
+    while (!pending.empty()) {
+        std::function<void()> deleter = std::move(pending.front().second);
+        pending.pop_front();
+        deleter();
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class DeletionQueue
+ * @brief Defers the destruction of GPU resources until every frame that could reference them has retired.
+ * * Resources retired while frame N is being recorded are tagged with N and released once the
+ * in-flight fence of frame N has been observed as signaled, which is guaranteed when frame
+ * N + framesInFlight begins. This replaces vkDeviceWaitIdle around swapchain recreation and resizes.
+ */
+class DeletionQueue final {
+public:
+    /** @brief Default frame overlap; matches Experience::MAX_FRAMES_IN_FLIGHT. */
+    static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2U;
+
+    // --- Lifecycle ---
+
+    DeletionQueue() = default;
+
+    /** @brief Destructor: Pending deleters are dropped; callers must flush() after the device is idle. */
+    ~DeletionQueue() = default;
+
+    // RAII: The queue owns the only reference to each deferred deleter.
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Sets how many frames may be in flight, i.e. how long a retired resource must survive. */
+    void setFramesInFlight(const uint32_t count) { framesInFlight = count; }
+
+    /**
+     * @brief Schedules a deleter to run once the current frame has finished on the GPU.
+     * The callable must capture every handle it destroys by value.
+     */
+    void retire(std::function<void()> deleter);
+
+    /**
+     * @brief Runs every deleter whose frame has completed.
+     * Must be called right after the current frame's in-flight fence has been waited on.
+     */
+    void collect();
+
+    /** @brief Advances the frame counter; called once per submitted frame. */
+    void advanceFrame() { ++frameIndex; }
+
+    /** @brief Runs every pending deleter immediately. Only valid once the device is idle. */
+    void flush();
+
+    // --- Diagnostics ---
+
+    /** @brief Returns the number of resources awaiting destruction. */
+    size_t getPendingCount() const { return pending.size(); }
+
+    /** @brief Returns the monotonically increasing frame counter used for tagging. */
+    uint64_t getFrameIndex() const { return frameIndex; }
+
+private:
+    // --- Internal State ---
+    uint32_t framesInFlight{ DEFAULT_FRAMES_IN_FLIGHT };  /**< Number of frames a retired resource must outlive. */
+    uint64_t frameIndex{ 0U };                            /**< Frame currently being recorded. */
+
+    /** @brief FIFO of (retire frame, deleter); tags are monotonic so collection stops at the first young entry. */
+    std::deque<std::pair<uint64_t, std::function<void()>>> pending{};
+};
@@ -0,0 +1,82 @@
+#include "DrawList.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+/* parasoft-end-suppress ALL */
+
+#include "Mesh.h"
+#include "Pipeline.h"
+
+/**
+ * @brief Clears the items and sets the reference point used for depth buckets.
+ */
+void DrawList::begin(const glm::vec3& inEyePos) {
+    items.clear();
+    eyePos = inEyePos;
+    sequence = 0U;
+}
+
+/**
+ * @brief Adds a mesh draw and encodes its sort key.
+ */
+void DrawList::add(const Pass pass, const Mesh* const mesh, const Pipeline* const pipelineOverride) {
+    if (mesh == nullptr) {
+        return;
+    }
+
+    // Step 1: Resolve the pipeline exactly as Mesh::draw would
+    const Pipeline* const pipeline = mesh->resolvePipeline(pipelineOverride);
+    if (pipeline == nullptr) {
+        return;
+    }
+
+    uint64_t key = (static_cast<uint64_t>(pass) << PASS_SHIFT);
+
+    // Step 2: Order-dependent draws keep authored order; opaque draws group by state then depth
+    if ((pass == Pass::Transparent) || pipeline->isBlended()) {
+        key |= (1ULL << LAYER_SHIFT);
+        key |= ((sequence & SEQUENCE_MASK) << SEQUENCE_SHIFT);
+    }
+    else {
+        const uint64_t pipelineId = static_cast<uint64_t>(internId(pipelineIds, pipeline)) & PIPELINE_MASK;
+        const uint64_t materialId = static_cast<uint64_t>(internId(materialIds, mesh->getMaterial())) & MATERIAL_MASK;
+        key |= (pipelineId << PIPELINE_SHIFT);
+        key |= (materialId << MATERIAL_SHIFT);
+        key |= (depthBucket(mesh) << DEPTH_SHIFT);
+    }
+
+    ++sequence;
+    items.push_back(DrawItem{ key, mesh, pipeline });
+}
+
+/**
+ * @brief Orders the items by key (stable, so equal keys keep submission order).
+ */
+void DrawList::sort() {
+    std::stable_sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b) {
+        return a.key < b.key;
+    });
+}
+
+/**
+ * @brief Returns a dense id for a state object.
+ */
+uint32_t DrawList::internId(std::unordered_map<const void*, uint32_t>& table, const void* const object) {
+    const auto found = table.find(object);
+    if (found != table.end()) {
+        return found->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(table.size());
+    static_cast<void>(table.emplace(object, id));
+    return id;
+}
+
+/**
+ * @brief Quantizes the eye distance to a mesh origin into the depth bucket range.
+ */
+uint64_t DrawList::depthBucket(const Mesh* const mesh) const {
+    const glm::vec3 origin = glm::vec3(mesh->getModelMatrix()[3]);
+    const float normalized = std::clamp(glm::length(origin - eyePos) / DEPTH_RANGE, 0.0f, 1.0f);
+    return static_cast<uint64_t>(normalized * static_cast<float>(DEPTH_MASK));
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+class Mesh;
+class Pipeline;
+
+/**
+ * @class DrawList
+ * @brief Per-pass list of mesh draws ordered by a 64-bit sort key.
+ * * Key layout (MSB -> LSB):
+ *   [63:62] pass | [61] ordered layer | opaque: [60:48] pipeline, [47:28] material, [27:4] depth bucket
+ *                                     | ordered: [60:37] submission order
+ * * Opaque draws are grouped by pipeline then material, front-to-back within a group, which
+ * minimizes state changes and favors early depth rejection. Transparent-pass and blended draws
+ * keep their authored order: the glass globe encloses the water, so centroid depth sorting would
+ * invert them, and neither writes depth to resolve the overlap itself.
+ */
+class DrawList final {
+public:
+    /** @brief Render pass a draw belongs to; occupies the most significant key bits. */
+    enum class Pass : uint32_t {
+        Shadow = 0U,
+        Opaque = 1U,
+        Transparent = 2U
+    };
+
+    /**
+     * @struct DrawItem
+     * @brief A single sorted draw: the key, the mesh and its resolved pipeline.
+     */
+    struct DrawItem {
+        uint64_t key;
+        const Mesh* mesh;
+        const Pipeline* pipeline;
+    };
+
+    // --- Key Layout Constants ---
+    static constexpr uint32_t PASS_SHIFT = 62U;
+    static constexpr uint32_t LAYER_SHIFT = 61U;
+    static constexpr uint32_t PIPELINE_SHIFT = 48U;
+    static constexpr uint32_t MATERIAL_SHIFT = 28U;
+    static constexpr uint32_t DEPTH_SHIFT = 4U;
+    static constexpr uint32_t SEQUENCE_SHIFT = 37U;
+
+    static constexpr uint64_t PIPELINE_MASK = (1ULL << 13U) - 1ULL;
+    static constexpr uint64_t MATERIAL_MASK = (1ULL << 20U) - 1ULL;
+    static constexpr uint64_t DEPTH_MASK = (1ULL << 24U) - 1ULL;
+    static constexpr uint64_t SEQUENCE_MASK = (1ULL << 24U) - 1ULL;
+
+    /** @brief World-space distance mapped onto the full depth bucket range. */
+    static constexpr float DEPTH_RANGE = 64.0f;
+
+    // --- Lifecycle ---
+
+    DrawList() = default;
+    ~DrawList() = default;
+
+    // RAII: The id tables are tied to live pipelines and materials; prevent copies.
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Clears the items and sets the reference point used for depth buckets. */
+    void begin(const glm::vec3& inEyePos);
+
+    /** @brief Adds a mesh draw; the pipeline override (e.g. shadow) replaces the material pipeline. */
+    void add(const Pass pass, const Mesh* const mesh, const Pipeline* const pipelineOverride = nullptr);
+
+    /** @brief Orders the items by key (stable, so equal keys keep submission order). */
+    void sort();
+
+    /** @brief Returns the sorted items. */
+    const std::vector<DrawItem>& getItems() const { return items; }
+
+private:
+    /** @brief Returns a dense id for a state object; ids persist so ordering is stable across frames. */
+    static uint32_t internId(std::unordered_map<const void*, uint32_t>& table, const void* const object);
+
+    /** @brief Quantizes the eye distance to a mesh origin into the depth bucket range. */
+    uint64_t depthBucket(const Mesh* const mesh) const;
+
+    // --- Internal State ---
+    std::vector<DrawItem> items{};
+    std::unordered_map<const void*, uint32_t> pipelineIds{};
+    std::unordered_map<const void*, uint32_t> materialIds{};
+    glm::vec3 eyePos{ 0.0f };
+    uint64_t sequence{ 0U };
+};
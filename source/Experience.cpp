@@ -5,7 +5,9 @@
 #include <stdexcept>
 #include <array>
 #include <fstream>
+#include <cmath>
 #include <cstring>
+#include <unordered_set>
 /* parasoft-end-suppress ALL */
 
 /**
@@ -47,10 +49,20 @@ Experience::Experience(const uint32_t width, const uint32_t height, char const*
     // Step 3: Hardware Linkage - Connect managers to the Vulkan device
     resources->init(vulkanEngine.get(), MAX_FRAMES_IN_FLIGHT);
     assetManager->setDescriptorPool(resources->getDescriptorPool());
+    context->deletionQueue.setFramesInFlight(MAX_FRAMES_IN_FLIGHT);
 
     // Step 4: Logic Layers - Initialize simulation and UI managers
     imagesInFlight.resize(vulkanEngine->getSwapChainImageCount(), VK_NULL_HANDLE);
     renderer = std::make_unique<Renderer>(context.get());
+    objectBuffer = std::make_unique<ObjectBuffer>(context.get(), MAX_FRAMES_IN_FLIGHT);
+    indirectDraws = std::make_unique<IndirectDrawSystem>(context.get(), MAX_FRAMES_IN_FLIGHT);
+    occlusionCuller = std::make_unique<OcclusionCuller>();
+    staticBundle = std::make_unique<StaticDrawBundle>(context.get(), MAX_FRAMES_IN_FLIGHT,
+        vulkanEngine->getQueueFamilyIndices().graphicsFamily.value());
+    gpuTimer = std::make_unique<GpuFrameTimer>(context.get(), MAX_FRAMES_IN_FLIGHT,
+        vulkanEngine->getQueueFamilyIndices().graphicsFamily.value());
+    particleTimer = std::make_unique<GpuFrameTimer>(context.get(), MAX_FRAMES_IN_FLIGHT,
+        vulkanEngine->getQueueFamilyIndices().graphicsFamily.value());
     scene = std::make_unique<Scene>(context.get());
     inputManager = std::make_unique<InputManager>(window, context.get(), timeManager.get());
     uiManager = std::make_unique<IMGUIManager>(context.get());
@@ -77,20 +89,95 @@ Experience::Experience(const uint32_t width, const uint32_t height, char const*
     const ObjectTransform& lightCfg = cachedConfig.at("MainLight");
     mainLight = SystemFactory::createLightSystem(lightCfg.pos, lightCfg.color, lightCfg.params.at("intensity"));
 
+    const auto shadowCfg = cachedConfig.find("ShadowCache");
+    if (shadowCfg != cachedConfig.end()) {
+        const auto threshold = shadowCfg->second.params.find("angleThreshold");
+        if (threshold != shadowCfg->second.params.end()) {
+            shadowCache.setAngleThreshold(threshold->second);
+        }
+    }
+
+    const auto resolutionCfg = cachedConfig.find("DynamicResolution");
+    if (resolutionCfg != cachedConfig.end()) {
+        const auto target = resolutionCfg->second.params.find("targetFrameMs");
+        if (target != resolutionCfg->second.params.end()) {
+            resolutionController.setTargetFrameTime(target->second);
+        }
+    }
+
+    const auto lodCfg = cachedConfig.find("ParticleLod");
+    if (lodCfg != cachedConfig.end()) {
+        const std::map<std::string, float>& lodParams = lodCfg->second.params;
+        const auto param = [&lodParams](const char* const name, const float fallback) {
+            const auto it = lodParams.find(name);
+            return (it != lodParams.end()) ? it->second : fallback;
+        };
+        particleLod.setThresholds(param("fullCoverage", ParticleLodController::DEFAULT_FULL_COVERAGE),
+            param("minCoverage", ParticleLodController::DEFAULT_MIN_COVERAGE),
+            param("minFraction", ParticleLodController::DEFAULT_MIN_FRACTION),
+            param("maxSizeScale", ParticleLodController::DEFAULT_MAX_SIZE_SCALE));
+    }
+
     const VkSampleCountFlagBits msaa = vulkanEngine->getMsaaSamples();
     const VkRenderPass transRP = postProcessor->getTransparentRenderPass();
+    const VkRenderPass oitRP = postProcessor->getOitRenderPass();
 
-    dustParticleSystem = SystemFactory::createDustSystem(context.get(), transRP, msaa);
-    fireParticleSystem = SystemFactory::createFireSystem(context.get(), transRP, msaa);
-    smokeParticleSystem = SystemFactory::createSmokeSystem(context.get(), transRP, msaa);
-    rainParticleSystem = SystemFactory::createRainSystem(context.get(), transRP, msaa);
-    snowParticleSystem = SystemFactory::createSnowSystem(context.get(), transRP, msaa);
+    // Particle pipelines are queued here and compiled together with the scene pipelines in initVulkan()
+    PipelineBuildQueue pipelineJobs{};
+    dustParticleSystem = SystemFactory::createDustSystem(context.get(), transRP, oitRP, msaa, cachedConfig, &pipelineJobs);
+    fireParticleSystem = SystemFactory::createFireSystem(context.get(), transRP, oitRP, msaa, cachedConfig, &pipelineJobs);
+    if (fireParticleSystem != nullptr) {
+        fireParticleSystem->enableLightReadback(MAX_FRAMES_IN_FLIGHT, &pipelineJobs);
+    }
+    smokeParticleSystem = SystemFactory::createSmokeSystem(context.get(), transRP, oitRP, msaa, cachedConfig, &pipelineJobs);
+    rainParticleSystem = SystemFactory::createRainSystem(context.get(), transRP, oitRP, msaa, cachedConfig, &pipelineJobs);
+    snowParticleSystem = SystemFactory::createSnowSystem(context.get(), transRP, oitRP, msaa, cachedConfig, &pipelineJobs);
+    for (ParticleSystem* const system : getParticleSystems()) {
+        if ((system != nullptr) && system->wantsDepthSort()) {
+            system->enableDepthSort(MAX_FRAMES_IN_FLIGHT, vulkanEngine->getQueueFamilyIndices().graphicsFamily.value(), &pipelineJobs);
+        }
+    }
+
+    // The unified path simulates the same emitters from one pool; the UI switches between the two
+    particleEngine = SystemFactory::createParticleEngine(context.get(), transRP, oitRP, msaa, cachedConfig,
+        MAX_FRAMES_IN_FLIGHT, &pipelineJobs);
+
+    // Snow settles into a heightmap bound in the global set, so it exists before the sets are written
+    snowCover = std::make_unique<SnowCover>(context.get(), &pipelineJobs);
+
+    // The wind field is bound there too; its size and refresh rate bound the cost of rebuilding it
+    uint32_t windResolution = WindField::DEFAULT_RESOLUTION;
+    uint32_t windInterval = WindField::DEFAULT_UPDATE_INTERVAL;
+    float windStrength = WindField::DEFAULT_STRENGTH;
+    const auto windCfg = cachedConfig.find("WindField");
+    if (windCfg != cachedConfig.end()) {
+        const std::map<std::string, float>& windParams = windCfg->second.params;
+        const auto resolution = windParams.find("resolution");
+        if ((resolution != windParams.end()) && (resolution->second > 0.0f)) {
+            windResolution = static_cast<uint32_t>(resolution->second);
+        }
+        const auto interval = windParams.find("updateInterval");
+        if ((interval != windParams.end()) && (interval->second > 0.0f)) {
+            windInterval = static_cast<uint32_t>(interval->second);
+        }
+        const auto strength = windParams.find("strength");
+        if (strength != windParams.end()) {
+            windStrength = strength->second;
+        }
+    }
+    windField = std::make_unique<WindField>(context.get(), windResolution, windInterval, &pipelineJobs);
+    windField->setStrength(windStrength);
 
     // Step 9: Finalization - Hardware handshake and Asset loading
-    initVulkan();
+    initVulkan(pipelineJobs);
     uiManager->init(window, vulkanEngine.get());
     initSkybox();
     loadAssets();
+    initObjectBuffer();
+    initIndirectDraws();
+    initStaticBundle();
+    initDepthPrePass();
+    initWeightedOit();
 }
 
 /**
@@ -111,10 +198,21 @@ Experience::~Experience() {
 
 /**
  * @brief Triggers the creation of pipelines and synchronization of descriptor sets.
+ * Every queued pipeline (scene and particle) is compiled in a single parallel batch.
  */
-void Experience::initVulkan() {
-    createGraphicsPipelines();
-    resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get());
+void Experience::initVulkan(PipelineBuildQueue& pipelineJobs) {
+    createGraphicsPipelines(pipelineJobs);
+    pipelineJobs.execute(&context->pipelineCache);
+
+    // The final pass is rebuilt here because it may retire the previous pipeline, which is main-thread only
+    postProcessor->createPipeline(vulkanEngine->getFinalRenderPass());
+    try {
+        postProcessor->createOitResolvePipeline();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: Weighted OIT disabled (" << e.what() << ")" << std::endl;
+    }
+    resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get(), snowCover.get(), windField.get());
 }
 
 /**
@@ -202,8 +300,9 @@ void Experience::mouseCallback(GLFWwindow* pWindow, double xpos, double ypos) {
  * @brief Initializes the graphics pipelines for all scene materials.
  * Logic: Transparent objects (Glass/Water) are configured NOT to write
  * to the depth buffer to ensure internal particles remain visible.
+ * Pipelines are submitted to the build queue; their slots are filled once it is executed.
  */
-void Experience::createGraphicsPipelines() {
+void Experience::createGraphicsPipelines(PipelineBuildQueue& pipelineJobs) {
     // Step 1: Hardware validation
     if (postProcessor == nullptr) {
         throw std::runtime_error("Experience: Cannot create pipelines, PostProcessor is null!");
@@ -213,9 +312,23 @@ void Experience::createGraphicsPipelines() {
     const VkRenderPass transPass = postProcessor->getTransparentRenderPass();
     const VkSampleCountFlagBits msaa = vulkanEngine->getMsaaSamples();
 
-    // Step 2: Clear existing state to prevent resource leaks during hot-reloads
+    // Step 2: Retire existing state during hot-reloads; in-flight frames may still be bound to it
+    if (!pipelines.empty() || !shaderModules.empty()) {
+        auto retiredPipelines = std::make_shared<std::vector<std::unique_ptr<Pipeline>>>(std::move(pipelines));
+        auto retiredPrePass = std::make_shared<std::vector<std::unique_ptr<Pipeline>>>(std::move(depthPrePassPipelines));
+        auto retiredOit = std::make_shared<std::vector<std::unique_ptr<Pipeline>>>(std::move(oitPipelines));
+        auto retiredShaders = std::make_shared<std::vector<std::unique_ptr<ShaderModule>>>(std::move(shaderModules));
+        context->deletionQueue.retire([retiredPipelines, retiredPrePass, retiredOit, retiredShaders]() {
+            retiredPipelines->clear();
+            retiredPrePass->clear();
+            retiredOit->clear();
+            retiredShaders->clear();
+        });
+    }
     shaderModules.clear();
     pipelines.clear();
+    depthPrePassPipelines.clear();
+    oitPipelines.clear();
 
     // Step 3: Load Shader Modules (Managed by RAII unique_ptr)
     shaderModules.push_back(std::make_unique<ShaderModule>(context.get(), "./shaders/phong_vert.spv", VK_SHADER_STAGE_VERTEX_BIT));
@@ -241,32 +354,116 @@ void Experience::createGraphicsPipelines() {
     ShaderModule* const shadowVert = shaderModules[8].get();
     ShaderModule* const shadowFrag = shaderModules[9].get();
 
-    // Step 4: Instantiate Pipelines in RAII container
+    // Step 4: Queue Pipelines into pre-sized RAII slots (each job writes only its own slot)
     // Arguments: (context, renderPass, layout, vert, frag, depthTest, depthWrite, stencil, msaa)
+    pipelines.resize(PIPELINE_SLOT_COUNT);
+    VulkanContext* const ctx = context.get();
+    const VkDescriptorSetLayout materialLayout = context->materialSetLayout;
+
+    const auto queuePipeline = [this, &pipelineJobs, ctx, materialLayout](const char* const name, const size_t slot,
+        const VkRenderPass pass, ShaderModule* const vert, ShaderModule* const frag,
+        const bool culling, const bool blending, const bool depthWrite, const VkSampleCountFlagBits samples) {
+        pipelineJobs.submit(name, [this, ctx, materialLayout, slot, pass, vert, frag, culling, blending, depthWrite, samples]() {
+            pipelines[slot] = std::make_unique<Pipeline>(ctx, pass, materialLayout, vert, frag, culling, blending, depthWrite, samples);
+        });
+    };
 
     // Opaque Pipelines (Require Depth Writing)
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), offscreenPass, context->materialSetLayout, phongVert, phongFrag, true, true, true, msaa));
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), offscreenPass, context->materialSetLayout, phongVert, sandFrag, true, true, true, msaa));
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), offscreenPass, context->materialSetLayout, phongVert, baseFrag, true, true, true, msaa));
+    queuePipeline("phong", 0U, offscreenPass, phongVert, phongFrag, true, true, true, msaa);
+    queuePipeline("sand", 1U, offscreenPass, phongVert, sandFrag, true, true, true, msaa);
+    queuePipeline("base", 2U, offscreenPass, phongVert, baseFrag, true, true, true, msaa);
 
     // Transparent/Fluid Pipelines (depthWrite = FALSE)
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), transPass, context->materialSetLayout, phongVert, glassFrag, true, false, false, msaa));
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), offscreenPass, context->materialSetLayout, phongVert, alphaFrag, false, false, true, msaa));
-    pipelines.push_back(std::make_unique<Pipeline>(context.get(), transPass, context->materialSetLayout, waterVert, waterFrag, true, false, false, msaa));
+    queuePipeline("glass", 3U, transPass, phongVert, glassFrag, true, false, false, msaa);
+    queuePipeline("alpha", 4U, offscreenPass, phongVert, alphaFrag, false, false, true, msaa);
+    queuePipeline("water", 5U, transPass, waterVert, waterFrag, true, false, false, msaa);
 
     // Shadow Map Pipeline (Requires 1x Sample Count)
-    pipelines.push_back(std::make_unique<Pipeline>(
-        context.get(),
-        resources->getShadowRenderPass(),
-        context->materialSetLayout,
-        shadowVert,
-        shadowFrag,
-        true, true, true,
-        VK_SAMPLE_COUNT_1_BIT
-    ));
-
-    // Step 5: Final Pass Link - Orchestrate the Post-Processor's final screen pipeline
-    postProcessor->createPipeline(vulkanEngine->getFinalRenderPass());
+    queuePipeline("shadow", 6U, resources->getShadowRenderPass(), shadowVert, shadowFrag, true, true, true, VK_SAMPLE_COUNT_1_BIT);
+
+    // Step 5: Depth pre-pass variants (optional; without the shaders the pre-pass simply stays unavailable)
+    // Depth-only: no fragment stage and colour writes masked. Colour: EQUAL test, no depth writes.
+    ShaderModule* depthVert{ nullptr };
+    try {
+        auto depthModule = std::make_unique<ShaderModule>(context.get(), "./shaders/depth_vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+        depthVert = depthModule.get();
+        shaderModules.push_back(std::move(depthModule));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: Depth pre-pass disabled (" << e.what() << ")" << std::endl;
+    }
+
+    const auto queuePrePassPipeline = [this, &pipelineJobs, ctx, materialLayout, offscreenPass, msaa](const char* const name,
+        const size_t slot, ShaderModule* const vert, ShaderModule* const frag, const bool blending) {
+        pipelineJobs.submit(name, [this, ctx, materialLayout, offscreenPass, msaa, slot, vert, frag, blending]() {
+            const bool depthOnly = (frag == nullptr);
+            depthPrePassPipelines[slot] = std::make_unique<Pipeline>(ctx, offscreenPass, materialLayout, vert, frag,
+                true, blending, depthOnly, msaa, depthOnly ? VK_COMPARE_OP_LESS : VK_COMPARE_OP_EQUAL, !depthOnly);
+        });
+    };
+
+    if (depthVert != nullptr) {
+        depthPrePassPipelines.resize(DEPTH_PREPASS_SLOT_COUNT);
+        queuePrePassPipeline("depth_prepass", 0U, depthVert, nullptr, false);
+        queuePrePassPipeline("phong_equal", 1U, phongVert, phongFrag, true);
+        queuePrePassPipeline("sand_equal", 2U, phongVert, sandFrag, true);
+        queuePrePassPipeline("base_equal", 3U, phongVert, baseFrag, true);
+    }
+
+    // Step 6: Weighted OIT twins of the transparent materials (optional, like the pre-pass)
+    // Same shaders compiled with -DWEIGHTED_OIT, drawn into the OIT accumulation pass without depth writes.
+    std::unique_ptr<ShaderModule> glassOitModule{};
+    std::unique_ptr<ShaderModule> waterOitModule{};
+    try {
+        glassOitModule = std::make_unique<ShaderModule>(context.get(), "./shaders/glass_oit_frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
+        waterOitModule = std::make_unique<ShaderModule>(context.get(), "./shaders/water_oit_frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: Weighted OIT disabled (" << e.what() << ")" << std::endl;
+    }
+
+    if (waterOitModule != nullptr) {
+        ShaderModule* const glassOitFrag = glassOitModule.get();
+        ShaderModule* const waterOitFrag = waterOitModule.get();
+        shaderModules.push_back(std::move(glassOitModule));
+        shaderModules.push_back(std::move(waterOitModule));
+
+        oitPipelines.resize(OIT_PIPELINE_SLOT_COUNT);
+        const VkRenderPass oitPass = postProcessor->getOitRenderPass();
+
+        const auto queueOitPipeline = [this, &pipelineJobs, ctx, materialLayout, oitPass, msaa](const char* const name,
+            const size_t slot, ShaderModule* const vert, ShaderModule* const frag) {
+            pipelineJobs.submit(name, [this, ctx, materialLayout, oitPass, msaa, slot, vert, frag]() {
+                oitPipelines[slot] = std::make_unique<Pipeline>(ctx, oitPass, materialLayout, vert, frag,
+                    true, false, false, msaa, VK_COMPARE_OP_LESS, true, true);
+            });
+        };
+
+        queueOitPipeline("glass_oit", 0U, phongVert, glassOitFrag);
+        queueOitPipeline("water_oit", 1U, waterVert, waterOitFrag);
+    }
+
+    // Step 7: GPU-driven cull compute pipeline (graphics pipelines are shared with the CPU path)
+    if ((indirectDraws == nullptr) || !indirectDraws->isSupported()) {
+        return;
+    }
+
+    std::unique_ptr<ShaderModule> cullComp{};
+    try {
+        cullComp = std::make_unique<ShaderModule>(context.get(), "./shaders/cull_comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: GPU-driven path disabled (" << e.what() << ")" << std::endl;
+        return;
+    }
+
+    ShaderModule* const cullShader = cullComp.get();
+    shaderModules.push_back(std::move(cullComp));
+
+    IndirectDrawSystem* const indirect = indirectDraws.get();
+    pipelineJobs.submit("cull", [indirect, cullShader]() {
+        indirect->createCullPipeline(*cullShader);
+    });
 }
 
 /**
@@ -419,6 +616,7 @@ void Experience::loadAssets() {
         sorceressModel->setPosition(cachedConfig.at(SceneKeys::DESERT_QUEEN).pos);
         sorceressModel->setScale(cachedConfig.at(SceneKeys::DESERT_QUEEN).scale);
     }
+    sorceressModel->setDynamicShadowCaster(true); // Hovers (Scene::update)
     scene->addModel(SceneKeys::DESERT_QUEEN, std::move(sorceressModel));
 
     // 7.2 Magic Circle
@@ -434,12 +632,14 @@ void Experience::loadAssets() {
         magicCircle->setRotation(cachedConfig.at(SceneKeys::MAGIC_CIRCLE).rot);
         magicCircle->setScale(cachedConfig.at(SceneKeys::MAGIC_CIRCLE).scale);
     }
+    magicCircle->setDynamicShadowCaster(true); // Spins (Scene::update)
     scene->addModel(SceneKeys::MAGIC_CIRCLE, std::move(magicCircle));
 
-    // 7.3 Viking House
+    // 7.3 Viking House (its walls also occlude, so keep the parsed geometry)
+    std::vector<OBJLoader::MeshData> houseGeometry{};
     auto vikingHouse = assetManager->loadModel("./models/vikingroom/viking_room.obj", [&](const std::string&) {
         return propMat;
-        }, setupCmd, stagingBuffers, stagingMemories);
+        }, setupCmd, stagingBuffers, stagingMemories, &houseGeometry);
     for (auto& m : vikingHouse->getMeshes()) {
         categorizeMesh(m.get());
     }
@@ -447,6 +647,9 @@ void Experience::loadAssets() {
         vikingHouse->setPosition(cachedConfig.at(SceneKeys::VIKING_HOUSE).pos);
         vikingHouse->setScale(cachedConfig.at(SceneKeys::VIKING_HOUSE).scale);
     }
+    for (size_t i = 0U; i < houseGeometry.size(); ++i) {
+        occlusionCuller->addOccluder(houseGeometry[i], vikingHouse->getMeshes()[i]->getModelMatrix());
+    }
     scene->addModel(SceneKeys::VIKING_HOUSE, std::move(vikingHouse));
 
     // 7.4 Oasis / Water Cube
@@ -463,6 +666,7 @@ void Experience::loadAssets() {
         oasisModel->setPosition(cachedConfig.at(SceneKeys::OASIS).pos);
         oasisModel->setScale(cachedConfig.at(SceneKeys::OASIS).scale);
     }
+    oasisModel->setDynamicShadowCaster(true); // Rises and shrinks with the climate
     scene->addModel(SceneKeys::OASIS, std::move(oasisModel));
 
     // Step 8: Procedural Instance Generation (Vegetation and Rocks)
@@ -494,6 +698,7 @@ void Experience::loadAssets() {
             cactus->setRotation(cachedConfig.at(key).rot);
             cactus->setScale(cachedConfig.at(key).scale);
         }
+        cactus->setDynamicShadowCaster(true); // Rescaled by the climate every frame
         scene->addModel(key, std::move(cactus));
     }
 
@@ -515,29 +720,36 @@ void Experience::loadAssets() {
 
     // Step 9: Procedural Globe & Base Generation (Geometry Utils)
     static constexpr uint32_t GLOBE_SEGMENTS = 64U;
+    static constexpr float GLOBE_RADIUS = 1.8f;
+    const glm::vec3 globeCenter(0.0f, -0.3f, 0.0f);
 
     auto baseModel = std::make_unique<Model>(context.get());
-    auto bMesh = assetManager->processMeshData(GeometryUtils::generateCylinder(GLOBE_SEGMENTS, 2.4f, 1.75f, 0.8f), rattanMat, setupCmd, stagingBuffers, stagingMemories);
+    const OBJLoader::MeshData baseData = GeometryUtils::generateCylinder(GLOBE_SEGMENTS, 2.4f, 1.75f, 0.8f);
+    auto bMesh = assetManager->processMeshData(baseData, rattanMat, setupCmd, stagingBuffers, stagingMemories);
     categorizeMesh(bMesh.get());
     baseModel->addMesh(std::move(bMesh));
     baseModel->setPosition({ 0.0f, -0.9f, 0.0f });
+    occlusionCuller->addOccluder(baseData, baseModel->getMeshes()[0]->getModelMatrix());
     scene->addModel("ProceduralBase", std::move(baseModel));
 
     auto sandModel = std::make_unique<Model>(context.get());
-    auto sMesh = assetManager->processMeshData(GeometryUtils::generateSandPlug(GLOBE_SEGMENTS, 1.78f, 1.8f, 0.4f), sandMat, setupCmd, stagingBuffers, stagingMemories);
+    const OBJLoader::MeshData sandData = GeometryUtils::generateSandPlug(GLOBE_SEGMENTS, 1.78f, 1.8f, 0.4f);
+    auto sMesh = assetManager->processMeshData(sandData, sandMat, setupCmd, stagingBuffers, stagingMemories);
     categorizeMesh(sMesh.get());
     sandModel->addMesh(std::move(sMesh));
     sandModel->setPosition({ 0.0f, -0.1f, 0.0f });
+    occlusionCuller->addOccluder(sandData, sandModel->getMeshes()[0]->getModelMatrix());
     scene->addModel("ProceduralSand", std::move(sandModel));
 
     const auto glassMatFinal = assetManager->createMaterial(placeholder, placeholder, whiteTex, blackTex, blackTex, pipelines[3].get());
     auto glassModel = std::make_unique<Model>(context.get());
-    auto glassMesh = assetManager->processMeshData(GeometryUtils::generateSphere(GLOBE_SEGMENTS, 1.8f, -0.5f), glassMatFinal, setupCmd, stagingBuffers, stagingMemories);
+    auto glassMesh = assetManager->processMeshData(GeometryUtils::generateSphere(GLOBE_SEGMENTS, GLOBE_RADIUS, -0.5f), glassMatFinal, setupCmd, stagingBuffers, stagingMemories);
     categorizeMesh(glassMesh.get());
     glassModel->addMesh(std::move(glassMesh));
-    glassModel->setPosition({ 0.0f, -0.3f, 0.0f });
+    glassModel->setPosition(globeCenter);
     glassModel->setShadowCasting(false);
     ownedModels.push_back(std::move(glassModel));
+    particleLod.setBounds(globeCenter, GLOBE_RADIUS);   // The particles live inside the glass
 
     // Step 10: Final GPU Submission & Staging Cleanup
     VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, setupCmd);
@@ -549,6 +761,223 @@ void Experience::loadAssets() {
 
     initSkybox();
 }
+
+/**
+ * @brief Gives every scene mesh a slot in the per-object matrix buffer and hands it to the renderer.
+ * Meshes drawn in the camera passes come first; shadow-only meshes of the models follow.
+ */
+void Experience::initObjectBuffer() {
+    // Step 1: Every mesh that can be drawn (the buffer ignores repeats)
+    std::vector<Mesh*> objectMeshes(meshes.begin(), meshes.end());
+    objectMeshes.insert(objectMeshes.end(), transparentMeshes.begin(), transparentMeshes.end());
+    for (const auto& [name, model] : scene->getModels()) {
+        for (const auto& mesh : model->getMeshes()) {
+            objectMeshes.push_back(mesh.get());
+        }
+    }
+    for (const auto& model : ownedModels) {
+        if (model) {
+            for (const auto& mesh : model->getMeshes()) {
+                objectMeshes.push_back(mesh.get());
+            }
+        }
+    }
+
+    // Step 2: Create the per-frame buffers; the renderer binds the current one as Set 2
+    objectBuffer->build(objectMeshes);
+    renderer->setObjectBuffer(objectBuffer.get());
+    renderer->setOcclusionCuller(occlusionCuller.get());
+}
+
+/**
+ * @brief Hands every opaque mesh whose pipeline supports GPU-driven submission to the IndirectDrawSystem.
+ * Glass and water stay on the CPU path (sorted blending); so does everything if the
+ * device lacks the required features or the cull shader was not found.
+ */
+void Experience::initIndirectDraws() {
+    // Step 1: Requirements - the cull pipeline must have been compiled and objects registered
+    if ((indirectDraws == nullptr) || !indirectDraws->hasCullPipeline() || !objectBuffer->isReady()) {
+        return;
+    }
+
+    // Step 2: Pipelines drawn by indirect batches (Phong, Sand, Base, Alpha; Shadow is a separate override)
+    // They read the same object buffer as CPU draws, so no separate GPU-driven variants are needed.
+    const std::vector<const Pipeline*> gpuPipelines{
+        pipelines[0].get(), pipelines[1].get(), pipelines[2].get(), pipelines[4].get()
+    };
+
+    // Step 3: Static shadow casters from both the scene registry and the owned models
+    // Animated casters are redrawn by the CPU path into the per-frame shadow overlay.
+    std::vector<const Mesh*> casters{};
+    for (const auto& [name, model] : scene->getModels()) {
+        if (model->castsShadows() && !model->isDynamicShadowCaster()) {
+            for (const auto& mesh : model->getMeshes()) {
+                casters.push_back(mesh.get());
+            }
+        }
+    }
+    for (const auto& model : ownedModels) {
+        if (model && model->castsShadows() && !model->isDynamicShadowCaster()) {
+            for (const auto& mesh : model->getMeshes()) {
+                casters.push_back(mesh.get());
+            }
+        }
+    }
+
+    // Step 4: Build; any failure leaves the renderer on the CPU path
+    try {
+        indirectDraws->build(*objectBuffer, meshes, casters, gpuPipelines, pipelines[6].get());
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: GPU-driven path disabled (" << e.what() << ")" << std::endl;
+        return;
+    }
+
+    if (indirectDraws->isReady()) {
+        renderer->setIndirectDrawSystem(indirectDraws.get());
+    }
+}
+
+/**
+ * @brief Collects the CPU-path opaque meshes of non-animated models into the static draw bundle.
+ * Runs after initIndirectDraws: meshes taken by the GPU-driven path are never bundled. Animated
+ * models stay in the per-frame pass, where culling still pays off as they move.
+ */
+void Experience::initStaticBundle() {
+    // Step 1: Meshes of animated models (the same flag drives the per-frame shadow overlay)
+    std::unordered_set<const Mesh*> animated{};
+    for (const auto& [name, model] : scene->getModels()) {
+        if (model->isDynamicShadowCaster()) {
+            for (const auto& mesh : model->getMeshes()) {
+                static_cast<void>(animated.insert(mesh.get()));
+            }
+        }
+    }
+    for (const auto& model : ownedModels) {
+        if (model && model->isDynamicShadowCaster()) {
+            for (const auto& mesh : model->getMeshes()) {
+                static_cast<void>(animated.insert(mesh.get()));
+            }
+        }
+    }
+
+    // Step 2: The opaque meshes the CPU path would otherwise record every frame
+    std::vector<const Mesh*> cpuOpaque(meshes.begin(), meshes.end());
+    if ((indirectDraws != nullptr) && indirectDraws->isReady()) {
+        cpuOpaque = indirectDraws->getFallbackMeshes(IndirectDrawSystem::View::Camera);
+    }
+
+    std::vector<const Mesh*> staticMeshes{};
+    for (const Mesh* const mesh : cpuOpaque) {
+        if (animated.find(mesh) == animated.end()) {
+            staticMeshes.push_back(mesh);
+        }
+    }
+
+    // Step 3: Setting the meshes invalidates every previously recorded bundle
+    staticBundle->setMeshes(staticMeshes);
+    renderer->setStaticDrawBundle(staticBundle.get());
+}
+
+/**
+ * @brief Hands the depth pre-pass substitutions to the renderer once the pipelines are compiled.
+ * Alpha-tested materials keep their own pipeline (its discard threshold differs from any depth-only variant),
+ * so they are absent from the depth-only map and map to themselves for the colour pass.
+ */
+void Experience::initDepthPrePass() {
+    // Step 1: Requirements - the pre-pass variants must have been compiled
+    if ((depthPrePassPipelines.size() != DEPTH_PREPASS_SLOT_COUNT) || (depthPrePassPipelines[0] == nullptr)) {
+        return;
+    }
+
+    // Step 2: Material pipelines (Phong, Sand, Base share one depth-only variant)
+    // CPU draws and GPU-driven batches use the same pipelines, so one pair of maps serves both.
+    const IndirectDrawSystem::PipelineMap depthOnly{
+        { pipelines[0].get(), depthPrePassPipelines[0].get() },
+        { pipelines[1].get(), depthPrePassPipelines[0].get() },
+        { pipelines[2].get(), depthPrePassPipelines[0].get() }
+    };
+    const IndirectDrawSystem::PipelineMap equalTest{
+        { pipelines[0].get(), depthPrePassPipelines[1].get() },
+        { pipelines[1].get(), depthPrePassPipelines[2].get() },
+        { pipelines[2].get(), depthPrePassPipelines[3].get() },
+        { pipelines[4].get(), pipelines[4].get() }
+    };
+
+    renderer->setDepthPrePassPipelines(depthOnly, equalTest);
+}
+
+/**
+ * @brief Writes the frame graph compiled for the current frame as Graphviz and JSON next to the executable.
+ */
+void Experience::dumpFrameGraph() const {
+    const RenderGraph& graph = renderer->getFrameGraph();
+
+    std::ofstream dotFile(GRAPH_DUMP_DOT);
+    std::ofstream jsonFile(GRAPH_DUMP_JSON);
+    if (!dotFile || !jsonFile) {
+        std::cerr << "Experience: Could not write the render graph dump" << std::endl;
+        return;
+    }
+
+    graph.writeGraphviz(dotFile);
+    graph.writeJson(jsonFile);
+    std::cout << "Experience: Render graph written to " << GRAPH_DUMP_DOT << " and " << GRAPH_DUMP_JSON
+        << " (" << graph.getCulledPassCount() << " passes culled, " << graph.getBarrierBatchCount() << " barrier batches)" << std::endl;
+}
+
+/**
+ * @brief Returns the scene's particle systems in simulation order; absent systems are null.
+ */
+std::array<ParticleSystem*, Experience::PARTICLE_SYSTEM_COUNT> Experience::getParticleSystems() const {
+    return { dustParticleSystem.get(), fireParticleSystem.get(), smokeParticleSystem.get(),
+        rainParticleSystem.get(), snowParticleSystem.get() };
+}
+
+/**
+ * @brief Times the fire simulation over 1M particles in both storage layouts and prints the results.
+ * A failure (e.g. missing SoA shader builds) is logged; the scene's own systems are not touched.
+ */
+void Experience::runParticleBenchmark() const {
+    try {
+        const std::vector<LayoutBenchmarkResult> results = ParticleLayoutBenchmark::run(context.get(),
+            postProcessor->getTransparentRenderPass(), vulkanEngine->getMsaaSamples(),
+            vulkanEngine->getQueueFamilyIndices().graphicsFamily.value(), resources->getDescriptorSet(0U));
+        ParticleLayoutBenchmark::report(std::cout, results);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Experience: Particle layout benchmark failed (" << e.what() << ")" << std::endl;
+    }
+}
+
+/**
+ * @brief Hands the weighted OIT twins to the renderer if every transparent draw has one.
+ * A particle system without its OIT variant would vanish in OIT mode, so any gap keeps the mode off.
+ */
+void Experience::initWeightedOit() {
+    // Step 1: Requirements - material twins and the composite pipeline
+    if ((oitPipelines.size() != OIT_PIPELINE_SLOT_COUNT) || !postProcessor->hasOitResolve()) {
+        return;
+    }
+
+    // Step 2: Every particle system must have built its variant
+    const std::array<const ParticleSystem*, 5> particleSystems = {
+        dustParticleSystem.get(), fireParticleSystem.get(), smokeParticleSystem.get(),
+        rainParticleSystem.get(), snowParticleSystem.get()
+    };
+    for (const ParticleSystem* const system : particleSystems) {
+        if ((system != nullptr) && !system->hasOitPipeline()) {
+            return;
+        }
+    }
+
+    // Step 3: Glass and Water are the only transparent materials
+    renderer->setWeightedOitPipelines({
+        { pipelines[3].get(), oitPipelines[0].get() },
+        { pipelines[5].get(), oitPipelines[1].get() }
+    });
+}
+
 /**
  * @brief Initializes the environmental skybox.
  * Loads the 6 faces of the cubemap and prepares the Skybox pipeline.
@@ -586,11 +1015,44 @@ void Experience::initSkybox() {
  * records commands, and presents the resulting image.
  */
 void Experience::drawFrame() {
+    // The benchmark idles the device itself, so it runs between frames rather than inside one
+    if (inputManager->consumeParticleBenchmarkRequest()) {
+        runParticleBenchmark();
+    }
+
     // Step 1: CPU-GPU Throttling - Wait for the previous frame's GPU execution to finish
     SyncManager* const sync = resources->getSyncManager();
     const VkFence currentFence = sync->getInFlightFence(currentFrame);
     static_cast<void>(vkWaitForFences(context->device, 1U, &currentFence, VK_TRUE, UINT64_MAX));
 
+    // The fence above proves the frames that used any retired resources have completed
+    context->deletionQueue.collect();
+
+    // It also proves this slot's timestamps were written: feed them to the resolution controller
+    resolutionController.setEnabled(inputManager->getDynamicResolutionEnabled());
+    const std::optional<float> gpuMs = gpuTimer->collect(currentFrame);
+    if (gpuMs.has_value()) {
+        resolutionController.addSample(gpuMs.value());
+    }
+    postProcessor->setRenderScale(resolutionController.getScale());
+
+    float sortMs = 0.0f;
+    uint32_t sortedSystems = 0U;
+    for (ParticleSystem* const system : getParticleSystems()) {
+        if (system == nullptr) { continue; }
+        const std::optional<float> systemMs = system->collectSortTime(currentFrame);
+        sortMs += systemMs.value_or(0.0f);
+        if (system->isDepthSorted()) {
+            ++sortedSystems;
+        }
+    }
+    statsManager->setParticleSortCounters(sortMs, sortedSystems);
+
+    // Counters of the particle path this slot recorded, with the GPU time its simulation took
+    ParticlePathStats particleStats = particlePathFrames[currentFrame];
+    particleStats.gpuMs = particleTimer->collect(currentFrame).value_or(0.0f);
+    statsManager->setParticlePathStats(particleStats);
+
     const float dt = timeManager->getDelta();
     const float totalTime = timeManager->getTotal();
 
@@ -617,7 +1079,8 @@ void Experience::drawFrame() {
         if (postProcessor != nullptr) {
             postProcessor->resize(vulkanEngine->getSwapChainExtent());
         }
-        resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get());
+        resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get(), snowCover.get(), windField.get());
+        staticBundle->invalidate();
         return;
     }
 
@@ -639,29 +1102,112 @@ void Experience::drawFrame() {
 
     const VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
     static_cast<void>(vkBeginCommandBuffer(cb, &beginInfo));
+    gpuTimer->begin(cb, currentFrame);
 
-    // Update Particle Systems (Physics/Compute steps)
-    if (dustParticleSystem != nullptr) {
-        dustParticleSystem->update(cb, dt, inputManager->getDustEnabled(), totalTime, currentUBO.lightColor);
+    // Layout transitions deferred by a resize are recorded here instead of a blocking submit
+    if (postProcessor != nullptr) {
+        postProcessor->recordPendingTransitions(cb);
     }
-    if (fireParticleSystem != nullptr) {
-        const glm::vec3 origin = (scene && scene->hasModel("Cactus1"))
-            ? scene->getModels().at("Cactus1")->getPosition()
-            : glm::vec3(-0.8f, -0.15f, -0.5f);
-        fireParticleSystem->update(cb, dt, inputManager->getFireEnabled(), totalTime, currentUBO.lightColor, origin);
+
+    // Update Particle Systems (Physics/Compute steps)
+    // The unified engine replaces the five systems when selected, ready, and able to draw in the active OIT mode.
+    const bool weightedOit = inputManager->getWeightedOitEnabled() && renderer->hasWeightedOit();
+    const bool unifiedParticles = inputManager->getUnifiedParticlesEnabled() && (particleEngine != nullptr) &&
+        particleEngine->isReady() && (!weightedOit || particleEngine->hasOitPipeline());
+    const glm::vec3 fireOrigin = (scene && scene->hasModel("Cactus1"))
+        ? scene->getModels().at("Cactus1")->getPosition()
+        : glm::vec3(-0.8f, -0.15f, -0.5f);
+
+    ParticlePathStats& particlePath = particlePathFrames[currentFrame];
+    particlePath = ParticlePathStats{};
+    particlePath.unified = unifiedParticles;
+    particleTimer->begin(cb, currentFrame);
+
+    // Settled snow melts before this frame's flakes add to it; rain and snow collide through the global set
+    snowCover->recordMelt(cb, dt, climateManager->getSnowMeltRate());
+
+    // Every simulation samples the wind through the global set; it follows the climate and the fire
+    if (inputManager->getWindFieldEnabled()) {
+        windField->recordUpdate(cb, climateManager->getStormInfluence(), climateManager->getWindPhase(),
+            fireOrigin, inputManager->getFireEnabled());
     }
-    if (smokeParticleSystem != nullptr) {
-        const glm::vec3 origin = (scene && scene->hasModel("Cactus1"))
-            ? scene->getModels().at("Cactus1")->getPosition()
-            : glm::vec3(-0.8f, -0.15f, -0.5f);
-        smokeParticleSystem->update(cb, dt, inputManager->getSmokeEnabled(), totalTime, currentUBO.lightColor, origin);
+    const VkDescriptorSet sceneSet = resources->getDescriptorSet(imageIndex);
+
+    const float lodFraction = particleLod.getFraction();
+    uint32_t activeParticles = 0U;
+    uint32_t totalParticles = 0U;
+
+    if (unifiedParticles) {
+        // States follow the engine's definition order: dust, fire, smoke, rain, snow
+        const std::vector<ParticleEngine::EmitterState> emitterStates = {
+            { inputManager->getDustEnabled(), glm::vec3(0.0f), lodFraction },
+            { inputManager->getFireEnabled(), fireOrigin, lodFraction },
+            { inputManager->getSmokeEnabled(), fireOrigin, lodFraction },
+            { inputManager->getRainEnabled(), glm::vec3(0.0f), lodFraction },
+            { inputManager->getSnowEnabled(), glm::vec3(0.0f), lodFraction }
+        };
+        particleEngine->update(cb, currentFrame, dt, totalTime, currentUBO.lightColor, emitterStates, sceneSet);
+        particleEngine->recordLightReadback(cb, currentFrame);
+        activeParticles = particleEngine->getActiveParticles();
+        totalParticles = particleEngine->getEnabledParticles();
+        particlePath.dispatches = ParticleEngine::UPDATE_DISPATCHES;
+        particlePath.barriers = ParticleEngine::UPDATE_BARRIERS;
+        particlePath.drawCalls = EngineConstants::COUNT_ONE;
     }
-    if (rainParticleSystem != nullptr) {
-        rainParticleSystem->update(cb, dt, inputManager->getRainEnabled(), totalTime, currentUBO.lightColor);
+    else {
+        for (ParticleSystem* const system : getParticleSystems()) {
+            if (system != nullptr) {
+                system->setActiveFraction(lodFraction);
+            }
+        }
+        if (dustParticleSystem != nullptr) {
+            dustParticleSystem->update(cb, dt, inputManager->getDustEnabled(), totalTime, currentUBO.lightColor,
+                glm::vec3(0.0f), sceneSet);
+        }
+        if (fireParticleSystem != nullptr) {
+            fireParticleSystem->update(cb, dt, inputManager->getFireEnabled(), totalTime, currentUBO.lightColor, fireOrigin, sceneSet);
+            fireParticleSystem->recordLightReadback(cb, currentFrame);
+        }
+        if (smokeParticleSystem != nullptr) {
+            smokeParticleSystem->update(cb, dt, inputManager->getSmokeEnabled(), totalTime, currentUBO.lightColor, fireOrigin, sceneSet);
+        }
+        if (rainParticleSystem != nullptr) {
+            rainParticleSystem->update(cb, dt, inputManager->getRainEnabled(), totalTime, currentUBO.lightColor,
+                glm::vec3(0.0f), sceneSet);
+        }
+        if (snowParticleSystem != nullptr) {
+            snowParticleSystem->update(cb, dt, inputManager->getSnowEnabled(), totalTime, currentUBO.lightColor,
+                glm::vec3(0.0f), sceneSet);
+        }
+
+        // Every system is simulated; only the enabled ones are drawn
+        const std::array<bool, PARTICLE_SYSTEM_COUNT> drawn = {
+            inputManager->getDustEnabled(), inputManager->getFireEnabled(), inputManager->getSmokeEnabled(),
+            inputManager->getRainEnabled(), inputManager->getSnowEnabled()
+        };
+        const std::array<ParticleSystem*, PARTICLE_SYSTEM_COUNT> systems = getParticleSystems();
+        for (size_t i = 0U; i < systems.size(); ++i) {
+            if (systems[i] == nullptr) { continue; }
+            particlePath.dispatches += ParticleSystem::UPDATE_DISPATCHES;
+            particlePath.barriers += ParticleSystem::UPDATE_BARRIERS;
+            particlePath.drawCalls += drawn[i] ? EngineConstants::COUNT_ONE : 0U;
+            if (drawn[i]) {
+                activeParticles += systems[i]->getActiveCount();
+                totalParticles += systems[i]->getParticleCount();
+            }
+        }
     }
-    if (snowParticleSystem != nullptr) {
-        snowParticleSystem->update(cb, dt, inputManager->getSnowEnabled(), totalTime, currentUBO.lightColor);
+    particleTimer->end(cb, currentFrame);
+    statsManager->setParticleLodCounters(lodFraction, particleLod.getCoverage(), activeParticles, totalParticles);
+    renderer->setParticleEngine(unifiedParticles ? particleEngine.get() : nullptr);
+
+    // Alpha-blended emitters are sorted back to front after their simulation step (per-system path only)
+    for (ParticleSystem* const system : getParticleSystems()) {
+        if (system != nullptr) {
+            system->recordDepthSort(cb, currentFrame, currentUBO.view, inputManager->getDepthSortEnabled() && !unifiedParticles);
+        }
     }
+    snowCover->recordPublish(cb);
 
     // Record the actual geometry draw calls via the Renderer
     std::vector<Pipeline*> rawPipelines;
@@ -669,14 +1215,73 @@ void Experience::drawFrame() {
         rawPipelines.push_back(p.get());
     }
 
-    renderer->recordFrame(
-        cb, vulkanEngine->getSwapChainExtent(), scene->getModels(), ownedModels, meshes, transparentMeshes,
-        skybox.get(), dustParticleSystem.get(), fireParticleSystem.get(), smokeParticleSystem.get(),
-        rainParticleSystem.get(), snowParticleSystem.get(), postProcessor.get(),
-        resources->getDescriptorSet(imageIndex), resources->getShadowRenderPass(), resources->getShadowFramebuffer(),
-        rawPipelines, inputManager->getDustEnabled(), inputManager->getFireEnabled(), inputManager->getSmokeEnabled(),
-        inputManager->getRainEnabled(), inputManager->getSnowEnabled()
-    );
+    objectBuffer->beginFrame(currentFrame);
+    const bool indirectActive = (indirectDraws != nullptr) && indirectDraws->isReady() && inputManager->getIndirectDrawsEnabled();
+    if (indirectActive) {
+        indirectDraws->beginFrame(currentFrame);
+    }
+    renderer->setIndirectDrawSystem(indirectActive ? indirectDraws.get() : nullptr);
+
+    FrameInputs frame{};
+    frame.commandBuffer = cb;
+    frame.sync = sync;
+    frame.frameIndex = currentFrame;
+    frame.imageIndex = imageIndex;
+    frame.extent = postProcessor->getRenderExtent();
+    frame.viewPos = currentUBO.viewPos;
+    frame.lightPos = currentUBO.lightPos;
+    frame.cameraViewProj = currentUBO.proj * currentUBO.view;
+    frame.lightViewProj = currentUBO.lightSpaceMatrix;
+    frame.models = &scene->getModels();
+    frame.ownedModels = &ownedModels;
+    frame.opaqueMeshes = &meshes;
+    frame.transparentMeshes = &transparentMeshes;
+    frame.pipelines = &rawPipelines;
+    frame.skybox = skybox.get();
+    frame.dustSystem = dustParticleSystem.get();
+    frame.fireSystem = fireParticleSystem.get();
+    frame.smokeSystem = smokeParticleSystem.get();
+    frame.rainSystem = rainParticleSystem.get();
+    frame.snowSystem = snowParticleSystem.get();
+    frame.postProcessor = postProcessor.get();
+    frame.globalDescriptorSet = resources->getDescriptorSet(imageIndex);
+    frame.descriptorGeneration = resources->getDescriptorGeneration();
+
+    frame.shadowTargets.cachePass = resources->getStaticShadowRenderPass();
+    frame.shadowTargets.cacheFramebuffer = resources->getStaticShadowFramebuffer();
+    frame.shadowTargets.cacheImage = resources->getStaticShadowImage();
+    frame.shadowTargets.overlayPass = resources->getShadowOverlayRenderPass();
+    frame.shadowTargets.overlayFramebuffer = resources->getShadowFramebuffer();
+    frame.shadowTargets.shadowImage = resources->getShadowImage();
+    frame.shadowTargets.refreshCache = shadowCache.needsRefresh();
+
+    frame.toggles.dust = inputManager->getDustEnabled();
+    frame.toggles.fire = inputManager->getFireEnabled();
+    frame.toggles.smoke = inputManager->getSmokeEnabled();
+    frame.toggles.rain = inputManager->getRainEnabled();
+    frame.toggles.snow = inputManager->getSnowEnabled();
+    frame.toggles.depthPrePass = inputManager->getDepthPrePassEnabled();
+    frame.toggles.weightedOit = inputManager->getWeightedOitEnabled();
+    frame.toggles.occlusionCulling = inputManager->getOcclusionCullingEnabled();
+    frame.toggles.staticBundles = inputManager->getStaticBundlesEnabled();
+
+    renderer->recordFrame(frame);
+    sceneDepthExtent = postProcessor->getRenderExtent();   // The next frame's particles collide with this depth
+
+    const EncoderStats& encoderStats = renderer->getLastFrameStats();
+    statsManager->setBindCounters(encoderStats.bindsIssued, encoderStats.bindsSkipped, encoderStats.drawCalls);
+    statsManager->setCullCounters(renderer->getCameraCullStats(), renderer->getShadowCullStats());
+    statsManager->setRecordTimings(renderer->getRecordTimings());
+    statsManager->setIndirectRecordTime(indirectActive, renderer->getRecordTimings().wallMs);
+    statsManager->setBundleStats(staticBundle->getStats());
+    statsManager->setShadowCacheCounters(shadowCache.getReusedFrames(), shadowCache.getRefreshCount());
+    statsManager->setResolutionCounters(resolutionController.getScale(), resolutionController.getLastSample(),
+        resolutionController.getTargetFrameTime());
+    statsManager->setWindFieldCounters(windField->getResolution(), windField->getUpdateInterval(), windField->getUpdateCount());
+
+    if (inputManager->consumeGraphDumpRequest()) {
+        dumpFrameGraph();
+    }
 
     // Step 5: Final Display Pass - Bloom, UI, and Color Correction
     VkRenderPassBeginInfo finalPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
@@ -699,6 +1304,7 @@ void Experience::drawFrame() {
     uiManager->draw(cb);
 
     vkCmdEndRenderPass(cb);
+    gpuTimer->end(cb, currentFrame);
     static_cast<void>(vkEndCommandBuffer(cb));
 
     // Step 6: Submission - Send recorded commands to the Graphics Queue
@@ -735,11 +1341,13 @@ void Experience::drawFrame() {
         framebufferResized = false;
         vulkanEngine->recreateSwapChain(window);
         postProcessor->resize(vulkanEngine->getSwapChainExtent());
-        resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get());
+        resources->updateDescriptorSets(vulkanEngine.get(), postProcessor.get(), snowCover.get(), windField.get());
+        staticBundle->invalidate();
         imagesInFlight.resize(vulkanEngine->getSwapChainImageCount(), VK_NULL_HANDLE);
     }
 
     currentFrame = (currentFrame + 1U) % MAX_FRAMES_IN_FLIGHT;
+    context->deletionQueue.advanceFrame();
 }
 
 /**
@@ -811,14 +1419,33 @@ void Experience::updateUniformBuffer(const uint32_t currentImage) {
     ubo.lightPos = mainLight->getPosition();
     ubo.viewPos = inputManager->getActiveCamera()->getPosition();
     ubo.lightColor = mainLight->getLightValue();
-    ubo.lightSpaceMatrix = mainLight->getLightSpaceMatrix();
+    // The light looks at the origin, so its position is the direction towards it
+    ubo.lightSpaceMatrix = shadowCache.resolve(mainLight->getPosition(), mainLight->getLightSpaceMatrix());
     ubo.useGouraud = inputManager->getGouraudEnabled() ? EngineConstants::SHADER_TRUE : EngineConstants::SHADER_FALSE;
     ubo.time = totalTime;
+    ubo.renderScale = postProcessor->getRenderScale();
+
+    // Particle LOD follows the globe's size on screen; the draws compensate for the particles left out
+    particleLod.setEnabled(inputManager->getParticleLodEnabled());
+    particleLod.update(ubo.view, ubo.proj);
+    ubo.particleLod = particleLod.getShaderParams();
+
+    // The simulations scale the shared wind field by this; zero while the wind is off
+    ubo.windStrength = inputManager->getWindFieldEnabled() ? windField->getStrength() : 0.0f;
+
+    // The particles collide with the previous frame's depth, so they reproject with the previous camera
+    const bool collide = inputManager->getParticleCollisionEnabled();
+    ubo.depthViewProj = currentUBO.proj * currentUBO.view;
+    ubo.depthParams = glm::vec4(collide ? static_cast<float>(sceneDepthExtent.width) : 0.0f,
+        collide ? static_cast<float>(sceneDepthExtent.height) : 0.0f, currentUBO.proj[2][2], currentUBO.proj[3][2]);
 
     // Synchronize dynamic Fire/Spark lights from the particle simulation
     // This now respects the user's manual toggle even if the climate is currently "Summer".
-    if (fireParticleSystem != nullptr && inputManager->getFireEnabled()) {
-        const auto sparkData = fireParticleSystem->getLightData();
+    // The samples were selected on the GPU by this frame slot's previous submission, whose fence was just waited on.
+    // The slot's previous submission ran either particle path; its counters say which one filled the readback.
+    const bool unifiedSparks = particlePathFrames[currentFrame].unified && (particleEngine != nullptr);
+    if ((unifiedSparks || (fireParticleSystem != nullptr)) && inputManager->getFireEnabled()) {
+        const auto sparkData = unifiedSparks ? particleEngine->getLightData(currentFrame) : fireParticleSystem->getLightData(currentFrame);
         for (uint32_t i = 0U; i < EngineConstants::MAX_SPARK_LIGHTS; ++i) {
             ubo.sparks[i] = sparkData[i];
         }
@@ -841,23 +1468,33 @@ void Experience::updateUniformBuffer(const uint32_t currentImage) {
  * @brief Performs a controlled shutdown of all engine components.
  */
 void Experience::cleanup() {
-    // Step 1: Wait for GPU to finish all pending work
+    // Step 1: Wait for GPU to finish all pending work, then release every retired resource
     if (context && context->device != VK_NULL_HANDLE) {
         static_cast<void>(vkDeviceWaitIdle(context->device));
+        context->deletionQueue.flush();
     }
 
     // Step 2: Destroy high-level systems (UI, Renderer, Managers)
     uiManager.reset();
     renderer.reset();
+    indirectDraws.reset();
+    occlusionCuller.reset();
+    staticBundle.reset();
+    gpuTimer.reset();
+    particleTimer.reset();
+    objectBuffer.reset();
     assetManager.reset();
     postProcessor.reset();
 
     // Step 3: Destroy particle systems
+    particleEngine.reset();
     dustParticleSystem.reset();
     fireParticleSystem.reset();
     smokeParticleSystem.reset();
     rainParticleSystem.reset();
     snowParticleSystem.reset();
+    snowCover.reset();
+    windField.reset();
 
     // Step 4: Destroy scene-specific resources
     skybox.reset();
@@ -871,6 +1508,8 @@ void Experience::cleanup() {
     // Step 5: Clear registries and core hardware contexts
     ownedModels.clear();
     pipelines.clear();
+    depthPrePassPipelines.clear();
+    oitPipelines.clear();
     shaderModules.clear();
     meshes.clear();
     transparentMeshes.clear();
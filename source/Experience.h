@@ -2,6 +2,7 @@
 
 /* parasoft-begin-suppress ALL */
 #include "libs.h"
+#include <array>
 #include <vector>
 #include <optional>
 #include <memory>
@@ -34,6 +35,19 @@
 #include "ClimateManager.h"
 #include "SystemFactory.h"
 #include "VulkanResourceManager.h"
+#include "PipelineBuildQueue.h"
+#include "IndirectDrawSystem.h"
+#include "ObjectBuffer.h"
+#include "OcclusionCuller.h"
+#include "ShadowCache.h"
+#include "GpuFrameTimer.h"
+#include "ResolutionController.h"
+#include "ParticleLodController.h"
+#include "StaticDrawBundle.h"
+#include "ParticleLayoutBenchmark.h"
+#include "ParticleEngine.h"
+#include "SnowCover.h"
+#include "WindField.h"
 
 /**
  * @class Experience
@@ -47,6 +61,12 @@ public:
     static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2U;
     static constexpr float COLOR_CLEAR_VAL = 0.0f;
     static constexpr float ALPHA_CLEAR_VAL = 1.0f;
+    static constexpr size_t PIPELINE_SLOT_COUNT = 7U;   /**< Phong, Sand, Base, Glass, Alpha, Water, Shadow. */
+    static constexpr size_t DEPTH_PREPASS_SLOT_COUNT = 4U;  /**< Depth-only, Phong=, Sand=, Base= (shared by CPU and GPU-driven draws). */
+    static constexpr size_t OIT_PIPELINE_SLOT_COUNT = 2U;   /**< Weighted OIT twins: Glass, Water. */
+    static constexpr size_t PARTICLE_SYSTEM_COUNT = 5U;     /**< Dust, Fire, Smoke, Rain, Snow. */
+    static constexpr const char* GRAPH_DUMP_DOT = "render_graph.dot";
+    static constexpr const char* GRAPH_DUMP_JSON = "render_graph.json";
 
     // --- Lifecycle Management ---
 
@@ -100,6 +120,11 @@ private:
     std::vector<std::unique_ptr<Model>> ownedModels;
     std::vector<std::unique_ptr<ShaderModule>> shaderModules;
     std::vector<std::unique_ptr<Pipeline>> pipelines;
+    std::unique_ptr<ObjectBuffer> objectBuffer;  /**< Per-object model/normal matrices (Set 2 of every scene pipeline). */
+    std::unique_ptr<IndirectDrawSystem> indirectDraws;
+    std::unique_ptr<OcclusionCuller> occlusionCuller;  /**< Sand plug, base and house rasterized on the CPU. */
+    std::vector<std::unique_ptr<Pipeline>> depthPrePassPipelines;  /**< Empty when the pre-pass shaders are unavailable. */
+    std::vector<std::unique_ptr<Pipeline>> oitPipelines;  /**< Empty when the OIT shaders are unavailable. */
 
     // --- Global Scene Resources ---
     UniformBufferObject currentUBO;
@@ -108,6 +133,11 @@ private:
     std::unique_ptr<Skybox> skybox;
     std::unique_ptr<Cubemap> skyboxTexture;
     std::unique_ptr<PointLight> mainLight;
+    ShadowCache shadowCache{};  /**< Decides when the static-caster shadow map is re-rendered. */
+    std::unique_ptr<StaticDrawBundle> staticBundle;  /**< Pre-recorded opaque draws of non-animated models. */
+    std::unique_ptr<GpuFrameTimer> gpuTimer;  /**< Per-frame GPU timestamps feeding the resolution controller. */
+    ResolutionController resolutionController{};  /**< Scene render scale that holds the target GPU frame time. */
+    ParticleLodController particleLod{};  /**< Share of the particles kept alive, from the globe's size on screen. */
 
     // Atmospheric Particle Systems
     std::unique_ptr<ParticleSystem> dustParticleSystem;
@@ -115,6 +145,12 @@ private:
     std::unique_ptr<ParticleSystem> smokeParticleSystem;
     std::unique_ptr<ParticleSystem> rainParticleSystem;
     std::unique_ptr<ParticleSystem> snowParticleSystem;
+    std::unique_ptr<ParticleEngine> particleEngine;  /**< Unified path: all emitters in one dispatch and one multi-draw (optional). */
+    std::unique_ptr<GpuFrameTimer> particleTimer;    /**< Timestamps around the particle simulation of either path. */
+    std::unique_ptr<SnowCover> snowCover;            /**< Heightmap the settling flakes fill and the sand material reads. */
+    std::unique_ptr<WindField> windField;            /**< Air velocities every particle simulation samples. */
+    VkExtent2D sceneDepthExtent{ 0U, 0U };           /**< Render extent of the depth the next simulation collides against. */
+    std::array<ParticlePathStats, MAX_FRAMES_IN_FLIGHT> particlePathFrames{};  /**< Path each frame slot recorded last. */
 
     // --- Configuration & Command Synchronization ---
     std::map<std::string, ObjectTransform> cachedConfig;
@@ -124,9 +160,17 @@ private:
     // --- Internal Initialization Helpers ---
 
     void initWindow(char const* const title);
-    void initVulkan();
-    void createGraphicsPipelines();
+    void initVulkan(PipelineBuildQueue& pipelineJobs);
+    void createGraphicsPipelines(PipelineBuildQueue& pipelineJobs);
     void loadAssets();
+    void initObjectBuffer();
+    void initIndirectDraws();
+    void initStaticBundle();
+    void initDepthPrePass();
+    void initWeightedOit();
+    void dumpFrameGraph() const;
+    void runParticleBenchmark() const;
+    std::array<ParticleSystem*, PARTICLE_SYSTEM_COUNT> getParticleSystems() const;
     void initSkybox();
 
     // --- Frame Logic & Maintenance ---
@@ -0,0 +1,147 @@
+#include "FrustumCuller.h"
+
+/* parasoft-begin-suppress ALL */
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_SSE2 1
+#endif
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Extracts normalized frustum planes from a clip matrix.
+ * Rows are combined per Gribb-Hartmann; with GLM_FORCE_DEPTH_ZERO_TO_ONE the near plane is row 2 alone.
+ */
+FrustumCuller::Planes FrustumCuller::extractPlanes(const glm::mat4& viewProj) {
+    // Step 1: Transpose so rows are addressable as vectors (glm is column-major)
+    const glm::mat4 m = glm::transpose(viewProj);
+
+    Planes planes{
+        m[3] + m[0],   // Left
+        m[3] - m[0],   // Right
+        m[3] + m[1],   // Bottom (top when the projection is Y-flipped; the pair is symmetric)
+        m[3] - m[1],   // Top
+        m[2],          // Near (0..1 depth range)
+        m[3] - m[2]    // Far
+    };
+
+    // Step 2: Normalize so the w component is a true distance
+    for (glm::vec4& plane : planes) {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return planes;
+}
+
+/**
+ * @brief Clears all bounds while keeping the allocated capacity.
+ */
+void FrustumCuller::reset() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+    visibility.clear();
+    count = 0U;
+}
+
+/**
+ * @brief Appends a world-space box; returns its index into the result stream.
+ */
+uint32_t FrustumCuller::add(const BoundingVolume& worldBounds) {
+    glm::vec3 center{ 0.0f };
+    glm::vec3 extent{ UNBOUNDED_EXTENT };
+
+    // Meshes without bounds get an extent no plane can reject
+    if (worldBounds.valid) {
+        center = (worldBounds.aabbMin + worldBounds.aabbMax) * 0.5f;
+        extent = (worldBounds.aabbMax - worldBounds.aabbMin) * 0.5f;
+    }
+
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extent.x);
+    extentY.push_back(extent.y);
+    extentZ.push_back(extent.z);
+    visibility.push_back(1U);
+    return count++;
+}
+
+/**
+ * @brief Tests every stored box against the planes and fills the visibility stream.
+ * A box is rejected when, for any plane, dot(n, c) + d < -dot(|n|, e).
+ */
+CullStats FrustumCuller::cull(const Planes& planes) {
+    uint32_t first{ 0U };
+
+#ifdef FRUSTUM_CULLER_SSE2
+    // Step 1: Four boxes per iteration, one plane at a time
+    const uint32_t simdCount = count - (count % SIMD_WIDTH);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    for (; first < simdCount; first += SIMD_WIDTH) {
+        const __m128 cx = _mm_loadu_ps(&centerX[first]);
+        const __m128 cy = _mm_loadu_ps(&centerY[first]);
+        const __m128 cz = _mm_loadu_ps(&centerZ[first]);
+        const __m128 ex = _mm_loadu_ps(&extentX[first]);
+        const __m128 ey = _mm_loadu_ps(&extentY[first]);
+        const __m128 ez = _mm_loadu_ps(&extentZ[first]);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const glm::vec4& plane : planes) {
+            const __m128 nx = _mm_set1_ps(plane.x);
+            const __m128 ny = _mm_set1_ps(plane.y);
+            const __m128 nz = _mm_set1_ps(plane.z);
+            const __m128 d = _mm_set1_ps(plane.w);
+
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                _mm_add_ps(_mm_mul_ps(nz, cz), d));
+            const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(nx, signMask), ex),
+                _mm_mul_ps(_mm_and_ps(ny, signMask), ey)), _mm_mul_ps(_mm_and_ps(nz, signMask), ez));
+
+            // dist + radius < 0  =>  fully behind this plane
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        for (uint32_t lane = 0U; lane < SIMD_WIDTH; ++lane) {
+            visibility[first + lane] = ((mask & (1 << lane)) == 0) ? 1U : 0U;
+        }
+    }
+#endif
+
+    // Step 2: Remaining boxes (or all of them without SSE2)
+    cullScalar(planes, first);
+
+    CullStats stats{};
+    for (uint32_t i = 0U; i < count; ++i) {
+        if (visibility[i] != 0U) {
+            ++stats.visible;
+        }
+    }
+    stats.culled = count - stats.visible;
+    return stats;
+}
+
+/**
+ * @brief Scalar path for the tail that does not fill a SIMD lane group.
+ */
+void FrustumCuller::cullScalar(const Planes& planes, const uint32_t first) {
+    for (uint32_t i = first; i < count; ++i) {
+        bool inside = true;
+        for (const glm::vec4& plane : planes) {
+            const float dist = (plane.x * centerX[i]) + (plane.y * centerY[i]) + (plane.z * centerZ[i]) + plane.w;
+            const float radius = (std::fabs(plane.x) * extentX[i]) + (std::fabs(plane.y) * extentY[i]) + (std::fabs(plane.z) * extentZ[i]);
+            if ((dist + radius) < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        visibility[i] = inside ? 1U : 0U;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "CommonStructs.h"
+
+/**
+ * @struct CullStats
+ * @brief Visible and rejected bound counts for one culling query.
+ */
+struct CullStats final {
+    uint32_t visible{ 0U };
+    uint32_t culled{ 0U };     /**< Outside the view volume. */
+    uint32_t occluded{ 0U };   /**< Inside the view volume but hidden behind the CPU occluders. */
+};
+
+/**
+ * @class FrustumCuller
+ * @brief Tests world-space AABBs against a view volume in Structure-of-Arrays batches.
+ * * Bounds are stored as separate center/extent streams so four boxes are tested per SSE
+ * iteration with no shuffles. Planes are extracted from any view-projection matrix, so the
+ * same code serves the perspective camera and the light's orthographic shadow volume.
+ */
+class FrustumCuller final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t PLANE_COUNT = 6U;
+    static constexpr uint32_t SIMD_WIDTH = 4U;
+    static constexpr float UNBOUNDED_EXTENT = std::numeric_limits<float>::max();
+
+    /** @brief Plane equations (xyz = inward normal, w = distance) of a view volume. */
+    using Planes = std::array<glm::vec4, PLANE_COUNT>;
+
+    // --- Lifecycle ---
+
+    FrustumCuller() = default;
+    ~FrustumCuller() = default;
+
+    // RAII: Internal streams are large scratch buffers; prevent accidental copies per frame.
+    FrustumCuller(const FrustumCuller&) = delete;
+    FrustumCuller& operator=(const FrustumCuller&) = delete;
+
+    // --- Core API ---
+
+    /**
+     * @brief Extracts normalized frustum planes from a clip matrix (Gribb-Hartmann, 0..1 depth).
+     */
+    static Planes extractPlanes(const glm::mat4& viewProj);
+
+    /** @brief Clears all bounds while keeping the allocated capacity. */
+    void reset();
+
+    /** @brief Appends a world-space box; returns its index into the result stream. */
+    uint32_t add(const BoundingVolume& worldBounds);
+
+    /** @brief Tests every stored box against the planes and fills the visibility stream. */
+    CullStats cull(const Planes& planes);
+
+    /** @brief Returns true if the box at the given index survived the last cull(). */
+    bool isVisible(const uint32_t index) const { return visibility[index] != 0U; }
+
+    /** @brief Returns the number of boxes currently stored. */
+    uint32_t getCount() const { return count; }
+
+private:
+    /** @brief Scalar path for the tail that does not fill a SIMD lane group. */
+    void cullScalar(const Planes& planes, const uint32_t first);
+
+    // --- SoA Streams (one entry per box; the tail past the last full lane group runs scalar) ---
+    std::vector<float> centerX{};
+    std::vector<float> centerY{};
+    std::vector<float> centerZ{};
+    std::vector<float> extentX{};
+    std::vector<float> extentY{};
+    std::vector<float> extentZ{};
+    std::vector<uint8_t> visibility{};
+    uint32_t count{ 0U };
+};
@@ -54,6 +54,7 @@ OBJLoader::MeshData GeometryUtils::generateSphere(const uint32_t segments, const
             data.indices.push_back(first + 1U);
         }
     }
+    data.bounds = OBJLoader::computeBounds(data.vertices);
     return data;
 }
 
@@ -160,6 +161,7 @@ OBJLoader::MeshData GeometryUtils::generateSandPlug(const uint32_t segments, con
             data.indices.push_back(first + 1U);
         }
     }
+    data.bounds = OBJLoader::computeBounds(data.vertices);
     return data;
 }
 
@@ -219,5 +221,6 @@ OBJLoader::MeshData GeometryUtils::generateCylinder(const uint32_t segments, con
             data.indices.push_back(botCenterIdx + i + 1U);
         }
     }
+    data.bounds = OBJLoader::computeBounds(data.vertices);
     return data;
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "GpuFrameTimer.h"
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+/* parasoft-end-suppress ALL */
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Creates one query pair per frame in flight when timestamps are supported.
+ */
+GpuFrameTimer::GpuFrameTimer(VulkanContext* const inContext, const uint32_t inFramesInFlight, const uint32_t queueFamilyIndex)
+    : context(inContext), framesInFlight(inFramesInFlight), pending(inFramesInFlight, 0U)
+{
+    // Step 1: Capability check (valid bits of 0 means the queue cannot write timestamps)
+    uint32_t familyCount{ 0U };
+    vkGetPhysicalDeviceQueueFamilyProperties(context->physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(context->physicalDevice, &familyCount, families.data());
+    if ((queueFamilyIndex >= familyCount) || (families[queueFamilyIndex].timestampValidBits == 0U)) {
+        return;
+    }
+
+    const uint32_t validBits = families[queueFamilyIndex].timestampValidBits;
+    validMask = (validBits >= TIMESTAMP_FULL_BITS) ? ~0ULL : ((1ULL << validBits) - 1ULL);
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+    nanosPerTick = static_cast<double>(props.limits.timestampPeriod);
+
+    // Step 2: Query pool
+    VkQueryPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = framesInFlight * QUERIES_PER_FRAME;
+    if (vkCreateQueryPool(context->device, &poolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        queryPool = VK_NULL_HANDLE;
+    }
+}
+
+/**
+ * @brief Destructor: Releases the query pool.
+ */
+GpuFrameTimer::~GpuFrameTimer() {
+    if ((context != nullptr) && (context->device != VK_NULL_HANDLE) && (queryPool != VK_NULL_HANDLE)) {
+        vkDestroyQueryPool(context->device, queryPool, nullptr);
+    }
+}
+
+// ========================================================================
+// SECTION 2: PER-FRAME RECORDING
+// ========================================================================
+
+/**
+ * @brief Reads back the slot's timestamp pair without blocking.
+ */
+std::optional<float> GpuFrameTimer::collect(const uint32_t frameIndex) {
+    const uint32_t slot = frameIndex % framesInFlight;
+    if (!isSupported() || (pending[slot] == 0U)) {
+        return std::nullopt;
+    }
+    pending[slot] = 0U;
+
+    std::array<uint64_t, QUERIES_PER_FRAME> ticks{};
+    const VkResult result = vkGetQueryPoolResults(context->device, queryPool, slot * QUERIES_PER_FRAME, QUERIES_PER_FRAME,
+        sizeof(ticks), ticks.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) {
+        return std::nullopt;
+    }
+
+    const uint64_t elapsed = ((ticks[QUERY_END] & validMask) - (ticks[QUERY_BEGIN] & validMask)) & validMask;
+    return static_cast<float>((static_cast<double>(elapsed) * nanosPerTick) / NANOS_PER_MILLI);
+}
+
+/**
+ * @brief Resets the slot's queries and writes the start timestamp.
+ */
+void GpuFrameTimer::begin(const VkCommandBuffer cb, const uint32_t frameIndex) const {
+    if (!isSupported()) {
+        return;
+    }
+
+    const uint32_t first = (frameIndex % framesInFlight) * QUERIES_PER_FRAME;
+    vkCmdResetQueryPool(cb, queryPool, first, QUERIES_PER_FRAME);
+    vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, first + QUERY_BEGIN);
+}
+
+/**
+ * @brief Writes the end timestamp and marks the slot for read-back.
+ */
+void GpuFrameTimer::end(const VkCommandBuffer cb, const uint32_t frameIndex) {
+    if (!isSupported()) {
+        return;
+    }
+
+    const uint32_t slot = frameIndex % framesInFlight;
+    vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, (slot * QUERIES_PER_FRAME) + QUERY_END);
+    pending[slot] = 1U;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <optional>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+/**
+ * @class GpuFrameTimer
+ * @brief Measures the GPU execution time of each frame's command buffer with timestamp queries.
+ * * Every frame in flight owns a pair of queries written at the top and bottom of its command buffer.
+ * The pair is read back without waiting once the frame's fence has been waited on, so the
+ * measurement of frame N arrives when its slot is reused (MAX_FRAMES_IN_FLIGHT frames later).
+ * * Queues without timestamp support leave the timer unsupported; collect() then never yields a value.
+ */
+class GpuFrameTimer final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t QUERIES_PER_FRAME = 2U;
+    static constexpr uint32_t QUERY_BEGIN = 0U;
+    static constexpr uint32_t QUERY_END = 1U;
+    static constexpr uint32_t TIMESTAMP_FULL_BITS = 64U;
+    static constexpr double NANOS_PER_MILLI = 1.0e6;
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Creates the query pool if the queue family writes timestamps. */
+    GpuFrameTimer(VulkanContext* const inContext, const uint32_t inFramesInFlight, const uint32_t queueFamilyIndex);
+
+    /** @brief Destructor: Releases the query pool. */
+    ~GpuFrameTimer();
+
+    // RAII: Owns a query pool; prevent duplication.
+    GpuFrameTimer(const GpuFrameTimer&) = delete;
+    GpuFrameTimer& operator=(const GpuFrameTimer&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Returns true if timestamps can be recorded on the graphics queue. */
+    bool isSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+    /**
+     * @brief Returns the GPU time (ms) of the last frame recorded in this slot, if it is available.
+     * Call after the slot's fence was waited on and before begin() re-records it.
+     */
+    std::optional<float> collect(const uint32_t frameIndex);
+
+    /** @brief Resets the slot's queries and writes the start timestamp (outside any render pass). */
+    void begin(const VkCommandBuffer cb, const uint32_t frameIndex) const;
+
+    /** @brief Writes the end timestamp once all previously recorded work has completed. */
+    void end(const VkCommandBuffer cb, const uint32_t frameIndex);
+
+private:
+    VulkanContext* context{ nullptr };
+    uint32_t framesInFlight{ 0U };
+    VkQueryPool queryPool{ VK_NULL_HANDLE };
+    double nanosPerTick{ 1.0 };          /**< VkPhysicalDeviceLimits::timestampPeriod. */
+    uint64_t validMask{ ~0ULL };         /**< Masks the queue family's timestampValidBits. */
+    std::vector<uint8_t> pending{};      /**< Per slot: an end timestamp was recorded and not yet read. */
+};
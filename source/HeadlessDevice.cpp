@@ -0,0 +1,240 @@
+#include "HeadlessDevice.h"
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanResourceManager.h"
+
+namespace {
+    constexpr char const* VALIDATION_LAYER = "VK_LAYER_KHRONOS_validation";
+}
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Instance -> Physical Device -> Logical Device -> Pools -> Layouts.
+ */
+HeadlessDevice::HeadlessDevice() {
+    createInstance();
+    pickPhysicalDevice();
+    createLogicalDevice();
+    createPools();
+    VulkanResourceManager::createLayouts(&context);
+    context.pipelineCache.init(context.device, context.physicalDevice);
+    context.deletionQueue.setFramesInFlight(EngineConstants::COUNT_ONE);
+}
+
+/**
+ * @brief Destructor: Releases the context's objects in reverse creation order.
+ * The pipeline cache is not saved; the validations should not warm-start the renderer.
+ */
+HeadlessDevice::~HeadlessDevice() {
+    if (context.device != VK_NULL_HANDLE) {
+        static_cast<void>(vkDeviceWaitIdle(context.device));
+        context.deletionQueue.flush();
+        context.pipelineCache.cleanup();
+
+        vkDestroyDescriptorSetLayout(context.device, context.globalSetLayout, nullptr);
+        vkDestroyDescriptorSetLayout(context.device, context.materialSetLayout, nullptr);
+        vkDestroyDescriptorSetLayout(context.device, context.objectSetLayout, nullptr);
+        vkDestroyDescriptorPool(context.device, context.descriptorPool, nullptr);
+        vkDestroyCommandPool(context.device, context.graphicsCommandPool, nullptr);
+        vkDestroyDevice(context.device, nullptr);
+        context.device = VK_NULL_HANDLE;
+    }
+    if (context.instance != VK_NULL_HANDLE) {
+        vkDestroyInstance(context.instance, nullptr);
+        context.instance = VK_NULL_HANDLE;
+    }
+}
+
+// ========================================================================
+// SECTION 2: INSTANCE & DEVICE
+// ========================================================================
+
+/**
+ * @brief Creates an instance without surface extensions.
+ * Debug builds add the validation layer when it is installed; a bare software-driver setup has none.
+ */
+void HeadlessDevice::createInstance() {
+#ifndef NDEBUG
+    validationEnabled = isValidationLayerAvailable();
+#endif
+
+    VkApplicationInfo appInfo{ VK_STRUCTURE_TYPE_APPLICATION_INFO };
+    appInfo.pApplicationName = "Sandy-Snow Globe Validation";
+    appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+    appInfo.pEngineName = "VulkanLab Custom Engine";
+    appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+    appInfo.apiVersion = VK_API_VERSION_1_0;
+
+    VkInstanceCreateInfo createInfo{ VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+    createInfo.pApplicationInfo = &appInfo;
+    if (validationEnabled) {
+        createInfo.enabledLayerCount = EngineConstants::COUNT_ONE;
+        createInfo.ppEnabledLayerNames = &VALIDATION_LAYER;
+    }
+
+    if (vkCreateInstance(&createInfo, nullptr, &context.instance) != VK_SUCCESS) {
+        throw std::runtime_error("HeadlessDevice: Failed to create instance!");
+    }
+}
+
+/**
+ * @brief Selects the first device with a queue family that supports both graphics and compute.
+ */
+void HeadlessDevice::pickPhysicalDevice() {
+    uint32_t deviceCount{ 0U };
+    static_cast<void>(vkEnumeratePhysicalDevices(context.instance, &deviceCount, nullptr));
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    static_cast<void>(vkEnumeratePhysicalDevices(context.instance, &deviceCount, devices.data()));
+
+    const VkQueueFlags required = (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    for (const VkPhysicalDevice device : devices) {
+        uint32_t familyCount{ 0U };
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+
+        for (uint32_t i = 0U; (i < familyCount) && (context.physicalDevice == VK_NULL_HANDLE); ++i) {
+            if ((families[i].queueFlags & required) == required) {
+                context.physicalDevice = device;
+                queueFamily = i;
+            }
+        }
+        if (context.physicalDevice != VK_NULL_HANDLE) {
+            break;
+        }
+    }
+
+    if (context.physicalDevice == VK_NULL_HANDLE) {
+        throw std::runtime_error("HeadlessDevice: No device with a graphics and compute queue!");
+    }
+}
+
+/**
+ * @brief Creates the device with the same optional features as VulkanEngine, minus the swapchain.
+ */
+void HeadlessDevice::createLogicalDevice() {
+    // Step 1: One queue serves graphics, compute, transfer and the absent presentation
+    const float queuePriority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+    queueInfo.queueFamilyIndex = queueFamily;
+    queueInfo.queueCount = EngineConstants::COUNT_ONE;
+    queueInfo.pQueuePriorities = &queuePriority;
+
+    // Step 2: Features the renderer would enable, where the device has them
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(context.physicalDevice, &supportedFeatures);
+
+    VkPhysicalDeviceFeatures deviceFeatures{};
+    deviceFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+
+    std::vector<const char*> enabledExtensions{};
+    const bool drawIndirectCount = isDeviceExtensionAvailable(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (drawIndirectCount) {
+        enabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
+    VkDeviceCreateInfo createInfo{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    createInfo.queueCreateInfoCount = EngineConstants::COUNT_ONE;
+    createInfo.pQueueCreateInfos = &queueInfo;
+    createInfo.pEnabledFeatures = &deviceFeatures;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
+    if (validationEnabled) {
+        createInfo.enabledLayerCount = EngineConstants::COUNT_ONE;
+        createInfo.ppEnabledLayerNames = &VALIDATION_LAYER;
+    }
+
+    if (vkCreateDevice(context.physicalDevice, &createInfo, nullptr, &context.device) != VK_SUCCESS) {
+        throw std::runtime_error("HeadlessDevice: Failed to create logical device!");
+    }
+
+    // Step 3: Queues and the capabilities that were actually enabled
+    vkGetDeviceQueue(context.device, queueFamily, 0U, &context.graphicsQueue);
+    context.presentQueue = context.graphicsQueue;
+    context.transferQueue = context.graphicsQueue;
+
+    context.multiDrawIndirect = (deviceFeatures.multiDrawIndirect == VK_TRUE);
+    context.drawIndirectFirstInstance = (deviceFeatures.drawIndirectFirstInstance == VK_TRUE);
+    if (drawIndirectCount) {
+        context.cmdDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(context.device, "vkCmdDrawIndexedIndirectCountKHR"));
+    }
+}
+
+/**
+ * @brief Creates the resettable graphics command pool and a small shared descriptor pool.
+ */
+void HeadlessDevice::createPools() {
+    VkCommandPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+    if (vkCreateCommandPool(context.device, &poolInfo, nullptr, &context.graphicsCommandPool) != VK_SUCCESS) {
+        throw std::runtime_error("HeadlessDevice: Failed to create command pool!");
+    }
+
+    const std::array<VkDescriptorPoolSize, 3U> poolSizes = {
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, DESCRIPTORS_PER_TYPE },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, DESCRIPTORS_PER_TYPE },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, DESCRIPTORS_PER_TYPE }
+    };
+
+    VkDescriptorPoolCreateInfo descPoolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    descPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    descPoolInfo.maxSets = DESCRIPTOR_SET_CAPACITY;
+    descPoolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    descPoolInfo.pPoolSizes = poolSizes.data();
+    if (vkCreateDescriptorPool(context.device, &descPoolInfo, nullptr, &context.descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("HeadlessDevice: Failed to create descriptor pool!");
+    }
+}
+
+// ========================================================================
+// SECTION 3: QUERY HELPERS
+// ========================================================================
+
+/**
+ * @brief Returns true if the selected physical device exposes the named device extension.
+ */
+bool HeadlessDevice::isDeviceExtensionAvailable(const char* const extensionName) const {
+    uint32_t extensionCount{ 0U };
+    static_cast<void>(vkEnumerateDeviceExtensionProperties(context.physicalDevice, nullptr, &extensionCount, nullptr));
+
+    std::vector<VkExtensionProperties> available(extensionCount);
+    static_cast<void>(vkEnumerateDeviceExtensionProperties(context.physicalDevice, nullptr, &extensionCount, available.data()));
+
+    for (const VkExtensionProperties& extension : available) {
+        if (std::strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns true if the Khronos validation layer is installed.
+ */
+bool HeadlessDevice::isValidationLayerAvailable() {
+    uint32_t layerCount{ 0U };
+    static_cast<void>(vkEnumerateInstanceLayerProperties(&layerCount, nullptr));
+
+    std::vector<VkLayerProperties> layers(layerCount);
+    static_cast<void>(vkEnumerateInstanceLayerProperties(&layerCount, layers.data()));
+
+    for (const VkLayerProperties& layer : layers) {
+        if (std::strcmp(layer.layerName, VALIDATION_LAYER) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
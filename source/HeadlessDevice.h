@@ -0,0 +1,59 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+/**
+ * @class HeadlessDevice
+ * @brief A Vulkan device without window, surface or swapchain, for the command-line validations.
+ * * Fills a VulkanContext the way VulkanEngine and VulkanResourceManager do, minus presentation: an
+ * instance without WSI extensions, the first device with a graphics and compute queue (which also
+ * stands in for the present and transfer queues), the optional indirect-draw features, the graphics
+ * command pool, a descriptor pool, the three global set layouts and the pipeline cache.
+ * * Nothing needs a display, so the validations also run on a software driver (e.g. lavapipe or
+ * SwiftShader, selected through VK_DRIVER_FILES / VK_ICD_FILENAMES).
+ */
+class HeadlessDevice final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t DESCRIPTOR_SET_CAPACITY = 64U;        /**< Sets the validations may allocate from the shared pool. */
+    static constexpr uint32_t DESCRIPTORS_PER_TYPE = 256U;
+
+    // --- Lifecycle ---
+
+    /** @brief Creates the instance, device, pools and layouts; throws if no device qualifies. */
+    HeadlessDevice();
+
+    /** @brief Destructor: Waits for the device and releases everything in reverse order. */
+    ~HeadlessDevice();
+
+    // RAII: Owns the instance and device; prevent duplication.
+    HeadlessDevice(const HeadlessDevice&) = delete;
+    HeadlessDevice& operator=(const HeadlessDevice&) = delete;
+
+    // --- Accessors ---
+
+    /** @brief Returns the context every engine subsystem is built against. */
+    VulkanContext* getContext() { return &context; }
+
+    /** @brief Returns the queue family of the graphics (and compute) queue. */
+    uint32_t getQueueFamily() const { return queueFamily; }
+
+private:
+    // --- Internal Initialization ---
+    void createInstance();
+    void pickPhysicalDevice();
+    void createLogicalDevice();
+    void createPools();
+    bool isDeviceExtensionAvailable(const char* const extensionName) const;
+    static bool isValidationLayerAvailable();
+
+    // --- State ---
+    VulkanContext context{};
+    uint32_t queueFamily{ 0U };
+    bool validationEnabled{ false };
+};
@@ -122,6 +122,40 @@ void IMGUIManager::update(InputManager* const input, const StatsManager* const s
             ImGui::PlotLines("FPS History", stats->getHistoryData(),
                 static_cast<int>(stats->getCount()),
                 static_cast<int>(stats->getOffset()), nullptr, 0.0f, 165.0f, ImVec2(0, 80));
+            ImGui::Text("Draws: %u | Binds: %u issued, %u skipped", stats->getDrawCalls(),
+                stats->getBindsIssued(), stats->getBindsSkipped());
+            // Bundled static meshes never reach the frustum or occlusion tests; count them apart
+            const BundleStats& bundle = stats->getBundleStats();
+            const uint32_t bundledDraws = input->getStaticBundlesEnabled() ? bundle.draws : 0U;
+            ImGui::Text("Culling: camera %u visible, %u culled, %u occluded, %u bundled (unculled) | shadow %u visible, %u culled",
+                stats->getCameraCull().visible, stats->getCameraCull().culled, stats->getCameraCull().occluded, bundledDraws,
+                stats->getShadowCull().visible, stats->getShadowCull().culled);
+
+            const RecordTimings& rec = stats->getRecordTimings();
+            ImGui::Text("Recording (ms): shadow %.3f | opaque %.3f | transparent %.3f | frame %.3f on %u threads",
+                rec.shadowMs, rec.opaqueMs, rec.transparentMs, rec.wallMs, rec.threads);
+            ImGui::Text("GPU-driven draws: %s | frame recording %.3f ms with, %.3f ms without (last frame of each)",
+                stats->getIndirectDrawsActive() ? "on" : "off", stats->getIndirectRecordMs(), stats->getCpuPathRecordMs());
+            ImGui::Text("Static bundles: %u draws, no frustum/occlusion culling | %llu recordings (last %.3f ms), %llu reuses saved %.1f ms",
+                bundle.draws, static_cast<unsigned long long>(bundle.recordings), bundle.lastRecordMs,
+                static_cast<unsigned long long>(bundle.reusedFrames), bundle.savedMs);
+            ImGui::Text("Shadow cache: %llu frames reused, %llu refreshes",
+                static_cast<unsigned long long>(stats->getShadowCacheReused()),
+                static_cast<unsigned long long>(stats->getShadowCacheRefreshes()));
+            ImGui::Text("Resolution: %.0f%% | GPU %.2f ms (target %.1f ms)",
+                static_cast<double>(stats->getRenderScale() * 100.0f), static_cast<double>(stats->getGpuFrameMs()),
+                static_cast<double>(stats->getTargetFrameMs()));
+            ImGui::Text("Particle sort: %u systems | GPU %.3f ms", stats->getSortedSystems(),
+                static_cast<double>(stats->getParticleSortMs()));
+            const ParticlePathStats& particles = stats->getParticlePathStats();
+            ImGui::Text("Particle sim: %s | %u dispatches, %u barriers, %u draws | GPU %.3f ms",
+                particles.unified ? "unified" : "per system", particles.dispatches, particles.barriers, particles.drawCalls,
+                static_cast<double>(particles.gpuMs));
+            ImGui::Text("Particle LOD: %.0f%% | %u of %u active | coverage %.1f%%",
+                static_cast<double>(stats->getParticleLodFraction() * 100.0f), stats->getActiveParticles(),
+                stats->getEnabledParticles(), static_cast<double>(stats->getGlobeCoverage() * 100.0f));
+            ImGui::Text("Wind field: %u^3 cells, rebuilt every %u frames | %llu rebuilds", stats->getWindFieldResolution(),
+                stats->getWindFieldInterval(), static_cast<unsigned long long>(stats->getWindFieldUpdates()));
         }
 
         // --- 3. Simulation Scaling ---
@@ -178,6 +212,43 @@ void IMGUIManager::update(InputManager* const input, const StatsManager* const s
         bool bloom = input->getBloomEnabled();
         if (ImGui::Checkbox("Post-Process Bloom", &bloom)) { input->setBloomEnabled(bloom); }
 
+        bool prePass = input->getDepthPrePassEnabled();
+        if (ImGui::Checkbox("Depth Pre-Pass", &prePass)) { input->setDepthPrePassEnabled(prePass); }
+
+        bool weightedOit = input->getWeightedOitEnabled();
+        if (ImGui::Checkbox("Weighted OIT", &weightedOit)) { input->setWeightedOitEnabled(weightedOit); }
+
+        bool occlusion = input->getOcclusionCullingEnabled();
+        if (ImGui::Checkbox("CPU Occlusion Culling", &occlusion)) { input->setOcclusionCullingEnabled(occlusion); }
+
+        bool staticBundles = input->getStaticBundlesEnabled();
+        if (ImGui::Checkbox("Static Command Bundles", &staticBundles)) { input->setStaticBundlesEnabled(staticBundles); }
+
+        bool indirectDraws = input->getIndirectDrawsEnabled();
+        if (ImGui::Checkbox("GPU-Driven Draws", &indirectDraws)) { input->setIndirectDrawsEnabled(indirectDraws); }
+
+        bool dynamicResolution = input->getDynamicResolutionEnabled();
+        if (ImGui::Checkbox("Dynamic Resolution", &dynamicResolution)) { input->setDynamicResolutionEnabled(dynamicResolution); }
+
+        bool depthSort = input->getDepthSortEnabled();
+        if (ImGui::Checkbox("Particle Depth Sort", &depthSort)) { input->setDepthSortEnabled(depthSort); }
+
+        bool unifiedParticles = input->getUnifiedParticlesEnabled();
+        if (ImGui::Checkbox("Unified Particles", &unifiedParticles)) { input->setUnifiedParticlesEnabled(unifiedParticles); }
+
+        bool particleCollision = input->getParticleCollisionEnabled();
+        if (ImGui::Checkbox("Particle Collision", &particleCollision)) { input->setParticleCollisionEnabled(particleCollision); }
+
+        bool particleLod = input->getParticleLodEnabled();
+        if (ImGui::Checkbox("Particle LOD", &particleLod)) { input->setParticleLodEnabled(particleLod); }
+
+        bool windField = input->getWindFieldEnabled();
+        if (ImGui::Checkbox("Wind Field", &windField)) { input->setWindFieldEnabled(windField); }
+
+        if (ImGui::Button("Dump Render Graph")) { input->requestGraphDump(); }
+        ImGui::SameLine();
+        if (ImGui::Button("Benchmark Particle Layouts")) { input->requestParticleBenchmark(); }
+
         // --- 6. Lighting Control ---
         ImGui::Separator();
         bool orbit = input->getAutoOrbit();
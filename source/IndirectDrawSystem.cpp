@@ -0,0 +1,704 @@
+#include "IndirectDrawSystem.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "Material.h"
+#include "Mesh.h"
+#include "ObjectBuffer.h"
+#include "Pipeline.h"
+#include "ShaderModule.h"
+#include "Vertex.h"
+#include "VulkanUtils.h"
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Creates the cull descriptor layout so the cull pipeline can be built early.
+ */
+IndirectDrawSystem::IndirectDrawSystem(VulkanContext* const inContext, const uint32_t inFramesInFlight)
+    : context(inContext), framesInFlight(inFramesInFlight)
+{
+    createSetLayouts();
+}
+
+/**
+ * @brief Destructor: Releases every owned GPU object.
+ */
+IndirectDrawSystem::~IndirectDrawSystem() {
+    if ((context == nullptr) || (context->device == VK_NULL_HANDLE)) {
+        return;
+    }
+
+    for (FrameResources& frame : frames) {
+        destroyBuffer(frame.commandBuffer, frame.commandMemory);
+        destroyBuffer(frame.countBuffer, frame.countMemory);
+    }
+
+    destroyBuffer(geometryBuffer, geometryMemory);
+    destroyBuffer(recordBuffer, recordMemory);
+    destroyBuffer(batchBuffer, batchMemory);
+
+    vkDestroyDescriptorPool(context->device, descriptorPool, nullptr);
+    vkDestroyPipeline(context->device, cullPipeline, nullptr);
+    vkDestroyPipelineLayout(context->device, cullPipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(context->device, cullSetLayout, nullptr);
+}
+
+// ========================================================================
+// SECTION 2: SETUP
+// ========================================================================
+
+/**
+ * @brief Returns true if the device exposes the features the indirect path depends on.
+ * Multi-draw is needed for more than one command per call; firstInstance carries the object index.
+ */
+bool IndirectDrawSystem::isSupported() const {
+    return context->multiDrawIndirect && context->drawIndirectFirstInstance;
+}
+
+/**
+ * @brief Returns true once the cull pipeline exists and at least one record was built.
+ */
+bool IndirectDrawSystem::isReady() const {
+    return (cullPipeline != VK_NULL_HANDLE) && !records.empty() && !frames.empty();
+}
+
+/**
+ * @brief Compiles the cull compute pipeline.
+ */
+void IndirectDrawSystem::createCullPipeline(const ShaderModule& cullShader) {
+    const VkPushConstantRange pushRange{
+        VK_SHADER_STAGE_COMPUTE_BIT, EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(CullPushConstants))
+    };
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pSetLayouts = &cullSetLayout;
+    layoutInfo.pushConstantRangeCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &cullPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("IndirectDrawSystem: Failed to create cull pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = cullShader.getStageInfo();
+    pipelineInfo.layout = cullPipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(EngineConstants::COUNT_ONE, &pipelineInfo, &cullPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("IndirectDrawSystem: Failed to create cull compute pipeline!");
+    }
+}
+
+/**
+ * @brief Builds draw records, batches, the merged geometry pool and all per-frame buffers.
+ */
+void IndirectDrawSystem::build(const ObjectBuffer& objectBuffer, const std::vector<Mesh*>& cameraMeshes,
+    const std::vector<const Mesh*>& shadowCasters, const std::vector<const Pipeline*>& cameraPipelines,
+    const Pipeline* const shadowPipeline)
+{
+    std::unordered_map<const Mesh*, uint32_t> recordIndex{};
+    objects = &objectBuffer;
+
+    // Step 1: Camera view - meshes whose material pipeline is drawn through the GPU-driven path
+    for (const Mesh* const mesh : cameraMeshes) {
+        const Material* const material = mesh->getMaterial();
+        const Pipeline* const pipeline = (material != nullptr) ? material->getPipeline() : nullptr;
+        const bool eligible = (pipeline != nullptr) && (mesh->getObjectIndex() != Mesh::NO_OBJECT_INDEX) &&
+            (std::find(cameraPipelines.begin(), cameraPipelines.end(), pipeline) != cameraPipelines.end());
+        if (!eligible) {
+            fallbackMeshes[static_cast<uint32_t>(View::Camera)].push_back(mesh);
+            continue;
+        }
+
+        const uint32_t index = addRecord(mesh, recordIndex);
+        records[index].batch[static_cast<uint32_t>(View::Camera)] =
+            findOrAddBatch(View::Camera, pipeline, material->getDescriptorSet());
+    }
+
+    // Step 2: Shadow view - one pipeline, batched by material for the alpha-tested lookups
+    for (const Mesh* const mesh : shadowCasters) {
+        const Material* const material = mesh->getMaterial();
+        if ((shadowPipeline == nullptr) || (material == nullptr) || (mesh->getObjectIndex() == Mesh::NO_OBJECT_INDEX)) {
+            fallbackMeshes[static_cast<uint32_t>(View::Shadow)].push_back(mesh);
+            continue;
+        }
+
+        const uint32_t index = addRecord(mesh, recordIndex);
+        records[index].batch[static_cast<uint32_t>(View::Shadow)] =
+            findOrAddBatch(View::Shadow, shadowPipeline, material->getDescriptorSet());
+    }
+
+    if (records.empty()) {
+        return;
+    }
+
+    // Step 3: GPU resources
+    assignSlots();
+    createGeometryPool();
+    createStaticBuffers();
+    createFrameResources();
+    createDescriptors();
+
+    std::cout << "IndirectDrawSystem: " << records.size() << " draw records in "
+        << batches[static_cast<uint32_t>(View::Camera)].size() << " camera / "
+        << batches[static_cast<uint32_t>(View::Shadow)].size() << " shadow batches ("
+        << fallbackMeshes[static_cast<uint32_t>(View::Camera)].size() << " camera and "
+        << fallbackMeshes[static_cast<uint32_t>(View::Shadow)].size() << " shadow meshes on the CPU path), draw count "
+        << ((context->cmdDrawIndexedIndirectCount != nullptr) ? "from GPU counter" : "at full capacity") << "." << std::endl;
+}
+
+// ========================================================================
+// SECTION 3: PER-FRAME RECORDING
+// ========================================================================
+
+/**
+ * @brief Selects the frame-in-flight resources; the ObjectBuffer has already uploaded the matrices.
+ */
+void IndirectDrawSystem::beginFrame(const uint32_t frameIndex) {
+    if (frames.empty()) {
+        return;
+    }
+
+    currentFrame = frameIndex % framesInFlight;
+}
+
+/**
+ * @brief Records counter reset, the cull dispatches for both views and the indirect-read barrier.
+ * Must be recorded outside of a render pass, before any pass that calls recordDraws().
+ */
+void IndirectDrawSystem::recordCulling(const VkCommandBuffer commandBuffer, const FrustumCuller::Planes& cameraPlanes,
+    const FrustumCuller::Planes& shadowPlanes) const
+{
+    if (!isReady()) {
+        return;
+    }
+
+    const FrameResources& frame = frames[currentFrame];
+
+    // Step 1: Reset the per-batch counters (and, without a GPU draw count, every command slot)
+    vkCmdFillBuffer(commandBuffer, frame.countBuffer, 0ULL, VK_WHOLE_SIZE, 0U);
+    if (context->cmdDrawIndexedIndirectCount == nullptr) {
+        vkCmdFillBuffer(commandBuffer, frame.commandBuffer, 0ULL, VK_WHOLE_SIZE, 0U);
+    }
+
+    VkMemoryBarrier clearBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0U, EngineConstants::COUNT_ONE, &clearBarrier, 0U, nullptr, 0U, nullptr);
+
+    // Step 2: One dispatch per view; records without a batch in that view exit immediately
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout,
+        EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, &frame.cullSet, 0U, nullptr);
+
+    const uint32_t recordCount = static_cast<uint32_t>(records.size());
+    const uint32_t groupCount = (recordCount + CULL_WORKGROUP_SIZE - 1U) / CULL_WORKGROUP_SIZE;
+
+    for (uint32_t view = 0U; view < VIEW_COUNT; ++view) {
+        if (batches[view].empty()) {
+            continue;
+        }
+
+        CullPushConstants push{};
+        push.planes = (view == static_cast<uint32_t>(View::Camera)) ? cameraPlanes : shadowPlanes;
+        push.recordCount = recordCount;
+        push.viewIndex = view;
+
+        vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(CullPushConstants)), &push);
+        vkCmdDispatch(commandBuffer, groupCount, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+    }
+
+    // Step 3: Commands and counters become indirect parameters for the following passes
+    VkMemoryBarrier indirectBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    indirectBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    indirectBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        0U, EngineConstants::COUNT_ONE, &indirectBarrier, 0U, nullptr, 0U, nullptr);
+}
+
+/**
+ * @brief Records one indirect draw per batch of the view.
+ * With a remap, each batch is drawn with its substitute pipeline, or not at all if it has none.
+ */
+void IndirectDrawSystem::recordDraws(CommandEncoder& encoder, const View view, const VkDescriptorSet globalSet,
+    const PipelineMap* const pipelineRemap) const
+{
+    if (!isReady()) {
+        return;
+    }
+
+    const FrameResources& frame = frames[currentFrame];
+    const uint32_t viewIndex = static_cast<uint32_t>(view);
+    const uint32_t firstBatch = (view == View::Shadow)
+        ? static_cast<uint32_t>(batches[static_cast<uint32_t>(View::Camera)].size())
+        : 0U;
+    const uint32_t stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+
+    // Raw-command-buffer draws may have rebound sets behind the encoder, so start from a clean slate
+    encoder.invalidate();
+
+    for (size_t i = 0U; i < batches[viewIndex].size(); ++i) {
+        const Batch& batch = batches[viewIndex][i];
+        const Pipeline* pipeline = batch.pipeline;
+        if (pipelineRemap != nullptr) {
+            const auto substitute = pipelineRemap->find(batch.pipeline);
+            if (substitute == pipelineRemap->end()) {
+                continue;
+            }
+            pipeline = substitute->second;
+        }
+        const VkPipelineLayout layout = pipeline->getPipelineLayout();
+
+        encoder.bindPipeline(pipeline);
+        encoder.bindDescriptorSets(layout, globalSet, batch.materialSet);
+        encoder.bindObjectSet(layout, objects->getSet());
+        encoder.bindGeometry(geometryBuffer, geometryIndexOffset);
+
+        IndirectDrawRange range{};
+        range.commands = frame.commandBuffer;
+        range.commandOffset = static_cast<VkDeviceSize>(batch.firstSlot) * stride;
+        range.counts = frame.countBuffer;
+        range.countOffset = static_cast<VkDeviceSize>(firstBatch + static_cast<uint32_t>(i)) * sizeof(uint32_t);
+        range.maxDrawCount = batch.capacity;
+        range.stride = stride;
+        range.drawCount = context->cmdDrawIndexedIndirectCount;
+        encoder.drawIndexedIndirect(range);
+    }
+}
+
+// ========================================================================
+// SECTION 4: VALIDATION
+// ========================================================================
+
+/**
+ * @brief Culls on the GPU for each view and checks the compacted commands against FrustumCuller.
+ * Per view, every record with a batch must appear in that batch's range exactly when the CPU culler
+ * keeps its world box, with the record's geometry and object index and one instance. A box whose
+ * closest plane distance is within VALIDATION_PLANE_EPSILON may round differently and is only counted.
+ */
+bool IndirectDrawSystem::validate(const std::vector<glm::mat4>& viewProjs, std::ostream& out) {
+    if (!isReady() || viewProjs.empty()) {
+        out << "IndirectDrawSystem: Validation FAIL | GPU-driven path inactive (no cull pipeline or no records)" << std::endl;
+        return false;
+    }
+
+    // Step 1: CPU reference boxes, in record order (the meshes' cached world bounds)
+    FrustumCuller reference{};
+    for (const Mesh* const mesh : recordMeshes) {
+        static_cast<void>(reference.add(mesh->getWorldBounds()));
+    }
+
+    std::vector<VkDrawIndexedIndirectCommand> commands{};
+    std::vector<uint32_t> counts{};
+    const uint32_t cameraBatchCount = static_cast<uint32_t>(batches[static_cast<uint32_t>(View::Camera)].size());
+    bool passed = true;
+
+    for (size_t pair = 0U; pair < viewProjs.size(); ++pair) {
+        const std::array<FrustumCuller::Planes, VIEW_COUNT> planes = {
+            FrustumCuller::extractPlanes(viewProjs[pair]),
+            FrustumCuller::extractPlanes(viewProjs[(pair + 1U) % viewProjs.size()])
+        };
+
+        // Step 2: GPU result for this pair of views
+        cullAndReadBack(planes[0], planes[1], commands, counts);
+
+        for (uint32_t view = 0U; view < VIEW_COUNT; ++view) {
+            static_cast<void>(reference.cull(planes[view]));
+            const uint32_t firstBatch = (view == static_cast<uint32_t>(View::Shadow)) ? cameraBatchCount : 0U;
+
+            // Step 3: Index the GPU commands of every batch by object index (firstInstance)
+            std::vector<std::unordered_map<uint32_t, VkDrawIndexedIndirectCommand>> emitted(batches[view].size());
+            uint32_t overflow{ 0U };
+            for (size_t b = 0U; b < batches[view].size(); ++b) {
+                const Batch& batch = batches[view][b];
+                const uint32_t count = counts[firstBatch + static_cast<uint32_t>(b)];
+                overflow += (count > batch.capacity) ? (count - batch.capacity) : 0U;
+                for (uint32_t slot = 0U; slot < std::min(count, batch.capacity); ++slot) {
+                    const VkDrawIndexedIndirectCommand& command = commands[batch.firstSlot + slot];
+                    static_cast<void>(emitted[b].emplace(command.firstInstance, command));
+                }
+            }
+
+            // Step 4: Walk the records; each must be emitted exactly when the CPU keeps it
+            uint32_t compared{ 0U };
+            uint32_t visible{ 0U };
+            uint32_t missing{ 0U };
+            uint32_t spurious{ 0U };
+            uint32_t malformed{ 0U };
+            uint32_t borderline{ 0U };
+            for (size_t r = 0U; r < records.size(); ++r) {
+                const GpuDrawRecord& record = records[r];
+                if (record.batch[view] == NO_BATCH) {
+                    continue;
+                }
+                ++compared;
+
+                auto& batchCommands = emitted[record.batch[view] - firstBatch];
+                const auto found = batchCommands.find(record.objectIndex);
+                const bool gpuVisible = (found != batchCommands.end());
+                const bool cpuVisible = reference.isVisible(static_cast<uint32_t>(r));
+                visible += cpuVisible ? 1U : 0U;
+
+                if (gpuVisible) {
+                    const VkDrawIndexedIndirectCommand& command = found->second;
+                    if ((command.indexCount != record.indexCount) || (command.instanceCount != 1U) ||
+                        (command.firstIndex != record.firstIndex) || (command.vertexOffset != record.vertexOffset)) {
+                        ++malformed;
+                    }
+                    static_cast<void>(batchCommands.erase(found));
+                }
+                if (gpuVisible == cpuVisible) {
+                    continue;
+                }
+
+                // Disagreement: tolerated only for a box that touches a plane
+                const BoundingVolume& bounds = recordMeshes[r]->getWorldBounds();
+                const glm::vec3 center = (bounds.aabbMin + bounds.aabbMax) * 0.5f;
+                const glm::vec3 extent = (bounds.aabbMax - bounds.aabbMin) * 0.5f;
+                float closest = std::numeric_limits<float>::max();
+                for (const glm::vec4& plane : planes[view]) {
+                    const glm::vec3 normal(plane);
+                    closest = std::min(closest, glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extent));
+                }
+                if (std::fabs(closest) <= VALIDATION_PLANE_EPSILON) {
+                    ++borderline;
+                }
+                else if (cpuVisible) {
+                    ++missing;
+                }
+                else {
+                    ++spurious;
+                }
+            }
+
+            // Commands left over matched no record of their batch
+            for (const auto& batchCommands : emitted) {
+                spurious += static_cast<uint32_t>(batchCommands.size());
+            }
+
+            const bool viewPassed = (missing == 0U) && (spurious == 0U) && (malformed == 0U) && (overflow == 0U);
+            out << "IndirectDrawSystem: view " << pair << ' ' << std::left << std::setw(6)
+                << ((view == static_cast<uint32_t>(View::Camera)) ? "camera" : "shadow") << std::right
+                << " | " << (viewPassed ? "PASS" : "FAIL")
+                << " | " << visible << " of " << compared << " records visible on the CPU"
+                << " | " << missing << " missing, " << spurious << " spurious, " << malformed << " malformed, "
+                << overflow << " overflowed | " << borderline << " on a plane" << std::endl;
+            passed = passed && viewPassed;
+        }
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Runs one cull on the current frame's buffers and copies its commands and counters to the host.
+ */
+void IndirectDrawSystem::cullAndReadBack(const FrustumCuller::Planes& cameraPlanes, const FrustumCuller::Planes& shadowPlanes,
+    std::vector<VkDrawIndexedIndirectCommand>& commands, std::vector<uint32_t>& counts) const
+{
+    const FrameResources& frame = frames[currentFrame];
+    const VkDeviceSize commandBytes = static_cast<VkDeviceSize>(totalSlots) * sizeof(VkDrawIndexedIndirectCommand);
+    const VkDeviceSize countBytes = static_cast<VkDeviceSize>(totalBatches) * sizeof(uint32_t);
+    const VkMemoryPropertyFlags hostFlags = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    VkBuffer commandStaging{ VK_NULL_HANDLE };
+    VkDeviceMemory commandStagingMemory{ VK_NULL_HANDLE };
+    VkBuffer countStaging{ VK_NULL_HANDLE };
+    VkDeviceMemory countStagingMemory{ VK_NULL_HANDLE };
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, commandBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        hostFlags, commandStaging, commandStagingMemory);
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, countBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        hostFlags, countStaging, countStagingMemory);
+
+    // Step 1: Cull exactly as a frame does, then copy the results out
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+    recordCulling(cb, cameraPlanes, shadowPlanes);
+
+    VkMemoryBarrier copyBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    copyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0U, EngineConstants::COUNT_ONE, &copyBarrier, 0U, nullptr, 0U, nullptr);
+
+    const VkBufferCopy commandRegion{ 0ULL, 0ULL, commandBytes };
+    const VkBufferCopy countRegion{ 0ULL, 0ULL, countBytes };
+    vkCmdCopyBuffer(cb, frame.commandBuffer, commandStaging, EngineConstants::COUNT_ONE, &commandRegion);
+    vkCmdCopyBuffer(cb, frame.countBuffer, countStaging, EngineConstants::COUNT_ONE, &countRegion);
+
+    VkMemoryBarrier hostBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        0U, EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr, 0U, nullptr);
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+
+    // Step 2: Host copies
+    commands.resize(totalSlots);
+    counts.resize(totalBatches);
+    void* data{ nullptr };
+    static_cast<void>(vkMapMemory(context->device, commandStagingMemory, 0ULL, commandBytes, 0U, &data));
+    static_cast<void>(std::memcpy(commands.data(), data, static_cast<size_t>(commandBytes)));
+    vkUnmapMemory(context->device, commandStagingMemory);
+
+    static_cast<void>(vkMapMemory(context->device, countStagingMemory, 0ULL, countBytes, 0U, &data));
+    static_cast<void>(std::memcpy(counts.data(), data, static_cast<size_t>(countBytes)));
+    vkUnmapMemory(context->device, countStagingMemory);
+
+    destroyBuffer(commandStaging, commandStagingMemory);
+    destroyBuffer(countStaging, countStagingMemory);
+}
+
+// ========================================================================
+// SECTION 5: INTERNAL INITIALIZATION
+// ========================================================================
+
+/**
+ * @brief Creates the cull (compute) descriptor set layout.
+ */
+void IndirectDrawSystem::createSetLayouts() {
+    std::array<VkDescriptorSetLayoutBinding, CULL_BINDING_COUNT> cullBindings{};
+    for (uint32_t i = 0U; i < CULL_BINDING_COUNT; ++i) {
+        cullBindings[i] = VkDescriptorSetLayoutBinding{
+            i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, EngineConstants::COUNT_ONE, VK_SHADER_STAGE_COMPUTE_BIT, nullptr
+        };
+    }
+
+    VkDescriptorSetLayoutCreateInfo cullInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    cullInfo.bindingCount = CULL_BINDING_COUNT;
+    cullInfo.pBindings = cullBindings.data();
+    if (vkCreateDescriptorSetLayout(context->device, &cullInfo, nullptr, &cullSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("IndirectDrawSystem: Failed to create cull set layout!");
+    }
+}
+
+/**
+ * @brief Returns the record of a mesh, creating it on first use.
+ * The record carries the mesh's ObjectBuffer index, which the cull pass writes as firstInstance.
+ */
+uint32_t IndirectDrawSystem::addRecord(const Mesh* const mesh, std::unordered_map<const Mesh*, uint32_t>& recordIndex) {
+    const auto found = recordIndex.find(mesh);
+    if (found != recordIndex.end()) {
+        return found->second;
+    }
+
+    const BoundingVolume& bounds = mesh->getLocalBounds();
+    const uint32_t index = static_cast<uint32_t>(records.size());
+
+    GpuDrawRecord record{};
+    record.aabbMin = glm::vec4(bounds.aabbMin, 1.0f);
+    record.aabbMax = glm::vec4(bounds.aabbMax, 1.0f);
+    record.indexCount = mesh->getIndexCount();
+    record.objectIndex = mesh->getObjectIndex();
+    record.batch = { NO_BATCH, NO_BATCH };
+    record.flags = bounds.valid ? 0U : FLAG_UNBOUNDED;
+
+    records.push_back(record);
+    recordMeshes.push_back(mesh);
+    static_cast<void>(recordIndex.emplace(mesh, index));
+    return index;
+}
+
+/**
+ * @brief Returns the view-local id of the (pipeline, material) batch, creating it if needed.
+ */
+uint32_t IndirectDrawSystem::findOrAddBatch(const View view, const Pipeline* const pipeline, const VkDescriptorSet materialSet) {
+    std::vector<Batch>& viewBatches = batches[static_cast<uint32_t>(view)];
+    for (size_t i = 0U; i < viewBatches.size(); ++i) {
+        if ((viewBatches[i].pipeline == pipeline) && (viewBatches[i].materialSet == materialSet)) {
+            ++viewBatches[i].capacity;
+            return static_cast<uint32_t>(i);
+        }
+    }
+
+    viewBatches.push_back(Batch{ pipeline, materialSet, 0U, 1U });
+    return static_cast<uint32_t>(viewBatches.size() - 1U);
+}
+
+/**
+ * @brief Gives each batch a contiguous slot range and rewrites record batch ids as global ids.
+ * Camera batches come first, then shadow batches; the global id indexes the counter buffer.
+ */
+void IndirectDrawSystem::assignSlots() {
+    const uint32_t cameraBatchCount = static_cast<uint32_t>(batches[static_cast<uint32_t>(View::Camera)].size());
+
+    totalSlots = 0U;
+    for (std::vector<Batch>& viewBatches : batches) {
+        for (Batch& batch : viewBatches) {
+            batch.firstSlot = totalSlots;
+            totalSlots += batch.capacity;
+        }
+    }
+    totalBatches = cameraBatchCount + static_cast<uint32_t>(batches[static_cast<uint32_t>(View::Shadow)].size());
+
+    for (GpuDrawRecord& record : records) {
+        uint32_t& shadowBatch = record.batch[static_cast<uint32_t>(View::Shadow)];
+        if (shadowBatch != NO_BATCH) {
+            shadowBatch += cameraBatchCount;
+        }
+    }
+}
+
+/**
+ * @brief Copies every record's mesh into one buffer (vertices first, then indices) on the GPU.
+ * Records are patched with their vertex offset and first index inside the pool.
+ */
+void IndirectDrawSystem::createGeometryPool() {
+    // Step 1: Layout - total vertex bytes first, so the index region offset is known
+    VkDeviceSize vertexBytes{ 0U };
+    VkDeviceSize indexBytes{ 0U };
+    for (const Mesh* const mesh : recordMeshes) {
+        vertexBytes += mesh->getIndexOffset();
+        indexBytes += static_cast<VkDeviceSize>(mesh->getIndexCount()) * sizeof(uint32_t);
+    }
+    geometryIndexOffset = vertexBytes;
+
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, vertexBytes + indexBytes,
+        (VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, geometryBuffer, geometryMemory);
+
+    // Step 2: GPU-side copies out of the per-mesh buffers
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+
+    VkDeviceSize vertexCursor{ 0U };
+    VkDeviceSize indexCursor{ 0U };
+    for (size_t i = 0U; i < recordMeshes.size(); ++i) {
+        const Mesh* const mesh = recordMeshes[i];
+        const VkDeviceSize meshVertexBytes = mesh->getIndexOffset();
+        const VkDeviceSize meshIndexBytes = static_cast<VkDeviceSize>(mesh->getIndexCount()) * sizeof(uint32_t);
+
+        const std::array<VkBufferCopy, 2U> regions = {
+            VkBufferCopy{ 0ULL, vertexCursor, meshVertexBytes },
+            VkBufferCopy{ meshVertexBytes, geometryIndexOffset + indexCursor, meshIndexBytes }
+        };
+        vkCmdCopyBuffer(cb, mesh->getBuffer(), geometryBuffer, static_cast<uint32_t>(regions.size()), regions.data());
+
+        records[i].vertexOffset = static_cast<int32_t>(vertexCursor / sizeof(Vertex));
+        records[i].firstIndex = static_cast<uint32_t>(indexCursor / sizeof(uint32_t));
+
+        vertexCursor += meshVertexBytes;
+        indexCursor += meshIndexBytes;
+    }
+
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+}
+
+/**
+ * @brief Uploads the draw records and batch slot table (written once, read by every cull pass).
+ */
+void IndirectDrawSystem::createStaticBuffers() {
+    std::vector<uint32_t> batchFirstSlots{};
+    for (const std::vector<Batch>& viewBatches : batches) {
+        for (const Batch& batch : viewBatches) {
+            batchFirstSlots.push_back(batch.firstSlot);
+        }
+    }
+
+    const VkDeviceSize recordBytes = static_cast<VkDeviceSize>(records.size() * sizeof(GpuDrawRecord));
+    const VkDeviceSize batchBytes = static_cast<VkDeviceSize>(batchFirstSlots.size() * sizeof(uint32_t));
+    const VkMemoryPropertyFlags hostFlags = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, recordBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostFlags, recordBuffer, recordMemory);
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, batchBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostFlags, batchBuffer, batchMemory);
+
+    void* data{ nullptr };
+    static_cast<void>(vkMapMemory(context->device, recordMemory, 0ULL, recordBytes, 0U, &data));
+    static_cast<void>(std::memcpy(data, records.data(), static_cast<size_t>(recordBytes)));
+    vkUnmapMemory(context->device, recordMemory);
+
+    static_cast<void>(vkMapMemory(context->device, batchMemory, 0ULL, batchBytes, 0U, &data));
+    static_cast<void>(std::memcpy(data, batchFirstSlots.data(), static_cast<size_t>(batchBytes)));
+    vkUnmapMemory(context->device, batchMemory);
+}
+
+/**
+ * @brief Creates the command and counter buffers for every frame in flight.
+ */
+void IndirectDrawSystem::createFrameResources() {
+    const VkDeviceSize commandBytes = static_cast<VkDeviceSize>(totalSlots) * sizeof(VkDrawIndexedIndirectCommand);
+    const VkDeviceSize countBytes = static_cast<VkDeviceSize>(totalBatches) * sizeof(uint32_t);
+    const VkBufferUsageFlags gpuWritten = (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    frames.resize(framesInFlight);
+    for (FrameResources& frame : frames) {
+        VulkanUtils::createBuffer(context->device, context->physicalDevice, commandBytes, gpuWritten,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.commandBuffer, frame.commandMemory);
+        VulkanUtils::createBuffer(context->device, context->physicalDevice, countBytes, gpuWritten,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.countBuffer, frame.countMemory);
+    }
+}
+
+/**
+ * @brief Allocates and writes the cull descriptor set of every frame.
+ * Binding 1 is the ObjectBuffer of the same frame, so the cull pass sees the matrices the draws use.
+ */
+void IndirectDrawSystem::createDescriptors() {
+    // Step 1: Private pool sized for one cull set per frame
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight * CULL_BINDING_COUNT };
+
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = EngineConstants::COUNT_ONE;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = framesInFlight;
+    if (vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("IndirectDrawSystem: Failed to create descriptor pool!");
+    }
+
+    // Step 2: Per-frame sets
+    for (uint32_t frameIndex = 0U; frameIndex < framesInFlight; ++frameIndex) {
+        FrameResources& frame = frames[frameIndex];
+
+        VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = EngineConstants::COUNT_ONE;
+        allocInfo.pSetLayouts = &cullSetLayout;
+        if (vkAllocateDescriptorSets(context->device, &allocInfo, &frame.cullSet) != VK_SUCCESS) {
+            throw std::runtime_error("IndirectDrawSystem: Failed to allocate descriptor sets!");
+        }
+
+        const std::array<VkDescriptorBufferInfo, CULL_BINDING_COUNT> cullInfos = {
+            VkDescriptorBufferInfo{ recordBuffer, 0ULL, VK_WHOLE_SIZE },
+            VkDescriptorBufferInfo{ objects->getBuffer(frameIndex), 0ULL, VK_WHOLE_SIZE },
+            VkDescriptorBufferInfo{ batchBuffer, 0ULL, VK_WHOLE_SIZE },
+            VkDescriptorBufferInfo{ frame.commandBuffer, 0ULL, VK_WHOLE_SIZE },
+            VkDescriptorBufferInfo{ frame.countBuffer, 0ULL, VK_WHOLE_SIZE }
+        };
+
+        std::array<VkWriteDescriptorSet, CULL_BINDING_COUNT> writes{};
+        for (uint32_t i = 0U; i < CULL_BINDING_COUNT; ++i) {
+            writes[i] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, frame.cullSet, i, 0U, 1U,
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &cullInfos[i], nullptr };
+        }
+
+        vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+    }
+}
+
+/**
+ * @brief Destroys a buffer and frees its memory if present.
+ */
+void IndirectDrawSystem::destroyBuffer(VkBuffer& buffer, VkDeviceMemory& memory) const {
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(context->device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+    }
+    if (memory != VK_NULL_HANDLE) {
+        vkFreeMemory(context->device, memory, nullptr);
+        memory = VK_NULL_HANDLE;
+    }
+}
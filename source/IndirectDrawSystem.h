@@ -0,0 +1,210 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+#include "FrustumCuller.h"
+#include "CommandEncoder.h"
+
+class Mesh;
+class ObjectBuffer;
+class Pipeline;
+class ShaderModule;
+
+/**
+ * @class IndirectDrawSystem
+ * @brief GPU-driven mesh submission: compute frustum culling feeding indirect draws.
+ * * Every participating mesh is described once by a draw record (index range in a merged
+ * geometry pool, local bounds, object index and one batch per view). Each frame a compute
+ * pass reads the object matrices from the shared ObjectBuffer, culls the records against the
+ * camera and light volumes and compacts the survivors into per-batch command ranges, and each pass issues
+ * one indirect draw per (pipeline, material) batch. Recording cost therefore depends on the
+ * batch count, not on the number of meshes.
+ * * Requires multiDrawIndirect and drawIndirectFirstInstance. VK_KHR_draw_indirect_count is
+ * used when present; otherwise the command ranges are zero-filled and issued at full capacity.
+ */
+class IndirectDrawSystem final {
+public:
+    /** @brief Culling view; also indexes the per-record batch array on the GPU. */
+    enum class View : uint32_t {
+        Camera = 0U,
+        Shadow = 1U
+    };
+
+    // --- Named Constants ---
+    static constexpr uint32_t VIEW_COUNT = 2U;
+    static constexpr uint32_t NO_BATCH = 0xFFFFFFFFU;
+    static constexpr uint32_t FLAG_UNBOUNDED = 1U;
+    static constexpr uint32_t CULL_WORKGROUP_SIZE = 64U;
+    static constexpr float VALIDATION_PLANE_EPSILON = 1.0e-4f;   /**< Boxes this close to a plane may round either way. */
+
+    static constexpr uint32_t BINDING_RECORDS = 0U;
+    static constexpr uint32_t BINDING_OBJECTS = 1U;
+    static constexpr uint32_t BINDING_BATCHES = 2U;
+    static constexpr uint32_t BINDING_COMMANDS = 3U;
+    static constexpr uint32_t BINDING_COUNTS = 4U;
+    static constexpr uint32_t CULL_BINDING_COUNT = 5U;
+
+    /** @brief Maps a batch pipeline to a substitute (e.g. its depth pre-pass variant). */
+    using PipelineMap = std::unordered_map<const Pipeline*, const Pipeline*>;
+
+    // --- Lifecycle ---
+
+    /** @brief Creates the cull descriptor layout; buffers are created by build(). */
+    IndirectDrawSystem(VulkanContext* const inContext, const uint32_t inFramesInFlight);
+
+    /** @brief Destructor: Releases the pool, per-frame buffers, descriptors and the cull pipeline. */
+    ~IndirectDrawSystem();
+
+    // RAII: Owns GPU buffers and descriptor pools; prevent duplication.
+    IndirectDrawSystem(const IndirectDrawSystem&) = delete;
+    IndirectDrawSystem& operator=(const IndirectDrawSystem&) = delete;
+
+    // --- Setup ---
+
+    /** @brief Returns true if the device exposes the features the indirect path depends on. */
+    bool isSupported() const;
+
+    /** @brief Returns true once createCullPipeline() succeeded. */
+    bool hasCullPipeline() const { return cullPipeline != VK_NULL_HANDLE; }
+
+    /** @brief Compiles the cull compute pipeline (device objects only; safe on a build worker). */
+    void createCullPipeline(const ShaderModule& cullShader);
+
+    /**
+     * @brief Builds draw records, batches, the merged geometry pool and all per-frame buffers.
+     * Scene pipelines are shared with the CPU path; meshes whose pipeline is not in cameraPipelines
+     * (or that have no object index) stay on the CPU path and are returned by getFallbackMeshes().
+     */
+    void build(const ObjectBuffer& objectBuffer, const std::vector<Mesh*>& cameraMeshes,
+        const std::vector<const Mesh*>& shadowCasters, const std::vector<const Pipeline*>& cameraPipelines,
+        const Pipeline* const shadowPipeline);
+
+    /** @brief Returns true once the cull pipeline exists and at least one record was built. */
+    bool isReady() const;
+
+    // --- Per-Frame ---
+
+    /** @brief Selects the frame-in-flight resources (the ObjectBuffer uploads the matrices). */
+    void beginFrame(const uint32_t frameIndex);
+
+    /** @brief Records counter reset, the cull dispatches for both views and the indirect-read barrier. */
+    void recordCulling(const VkCommandBuffer commandBuffer, const FrustumCuller::Planes& cameraPlanes,
+        const FrustumCuller::Planes& shadowPlanes) const;
+
+    /**
+     * @brief Records one indirect draw per batch of the view (inside an active render pass).
+     * @param pipelineRemap Optional substitution (e.g. depth pre-pass variants); batches whose pipeline is not a key are skipped.
+     */
+    void recordDraws(CommandEncoder& encoder, const View view, const VkDescriptorSet globalSet,
+        const PipelineMap* const pipelineRemap = nullptr) const;
+
+    // --- Validation ---
+
+    /**
+     * @brief Culls on the GPU for each view and checks the compacted commands against FrustumCuller.
+     * View i culls the camera batches and view i+1 the shadow batches, so every view is used for both.
+     * Waits for the queue; the ObjectBuffer and this system must already be on the same frame.
+     * @return true if every count and command matched the CPU reference (boxes touching a plane excepted).
+     */
+    bool validate(const std::vector<glm::mat4>& viewProjs, std::ostream& out);
+
+    /** @brief Returns the meshes of a view that must still be drawn by the CPU path. */
+    const std::vector<const Mesh*>& getFallbackMeshes(const View view) const {
+        return fallbackMeshes[static_cast<uint32_t>(view)];
+    }
+
+private:
+    /**
+     * @struct GpuDrawRecord
+     * @brief Mirror of cull.comp's DrawRecord (std430, 64 bytes).
+     */
+    struct GpuDrawRecord {
+        glm::vec4 aabbMin;
+        glm::vec4 aabbMax;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t objectIndex;
+        std::array<uint32_t, VIEW_COUNT> batch;
+        uint32_t flags;
+        uint32_t padding;
+    };
+
+    /** @brief Mirror of cull.comp's push constant block. */
+    struct CullPushConstants {
+        FrustumCuller::Planes planes;
+        uint32_t recordCount;
+        uint32_t viewIndex;
+    };
+
+    /** @brief A run of indirect slots drawn with one pipeline and material. */
+    struct Batch {
+        const Pipeline* pipeline;
+        VkDescriptorSet materialSet;
+        uint32_t firstSlot;
+        uint32_t capacity;
+    };
+
+    /** @brief Buffers rewritten every frame; one set per frame in flight. */
+    struct FrameResources {
+        VkBuffer commandBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory commandMemory{ VK_NULL_HANDLE };
+        VkBuffer countBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory countMemory{ VK_NULL_HANDLE };
+        VkDescriptorSet cullSet{ VK_NULL_HANDLE };
+    };
+
+    // --- Internal Helpers ---
+    void createSetLayouts();
+    uint32_t addRecord(const Mesh* const mesh, std::unordered_map<const Mesh*, uint32_t>& recordIndex);
+    uint32_t findOrAddBatch(const View view, const Pipeline* const pipeline, const VkDescriptorSet materialSet);
+    void assignSlots();
+    void createGeometryPool();
+    void createStaticBuffers();
+    void createFrameResources();
+    void createDescriptors();
+    void destroyBuffer(VkBuffer& buffer, VkDeviceMemory& memory) const;
+
+    /** @brief Runs one cull on the current frame's buffers and reads its commands and counters back (waits for the queue). */
+    void cullAndReadBack(const FrustumCuller::Planes& cameraPlanes, const FrustumCuller::Planes& shadowPlanes,
+        std::vector<VkDrawIndexedIndirectCommand>& commands, std::vector<uint32_t>& counts) const;
+
+    // --- Core Dependencies ---
+    VulkanContext* context{ nullptr };
+    uint32_t framesInFlight{ 0U };
+    uint32_t currentFrame{ 0U };
+    const ObjectBuffer* objects{ nullptr };
+
+    // --- Layouts & Pipelines ---
+    VkDescriptorSetLayout cullSetLayout{ VK_NULL_HANDLE };
+    VkPipelineLayout cullPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline cullPipeline{ VK_NULL_HANDLE };
+    VkDescriptorPool descriptorPool{ VK_NULL_HANDLE };
+
+    // --- Scene Description (built once) ---
+    std::vector<GpuDrawRecord> records{};
+    std::vector<const Mesh*> recordMeshes{};    /**< Record index -> mesh whose geometry is pooled. */
+    std::array<std::vector<Batch>, VIEW_COUNT> batches{};
+    std::array<std::vector<const Mesh*>, VIEW_COUNT> fallbackMeshes{};
+    uint32_t totalSlots{ 0U };
+    uint32_t totalBatches{ 0U };
+
+    // --- Static GPU Buffers ---
+    VkBuffer geometryBuffer{ VK_NULL_HANDLE };  /**< All vertices, followed by all indices. */
+    VkDeviceMemory geometryMemory{ VK_NULL_HANDLE };
+    VkDeviceSize geometryIndexOffset{ 0U };
+    VkBuffer recordBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory recordMemory{ VK_NULL_HANDLE };
+    VkBuffer batchBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory batchMemory{ VK_NULL_HANDLE };
+
+    std::vector<FrameResources> frames{};
+};
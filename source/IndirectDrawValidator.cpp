@@ -0,0 +1,254 @@
+#include "IndirectDrawValidator.h"
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "IndirectDrawSystem.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "ObjectBuffer.h"
+#include "Pipeline.h"
+#include "ShaderModule.h"
+#include "Vertex.h"
+#include "VulkanUtils.h"
+
+namespace {
+    constexpr uint32_t CUBE_VERTEX_COUNT = 8U;
+    constexpr uint32_t CUBE_INDEX_COUNT = 36U;
+    constexpr uint32_t CAMERA_PIPELINE_COUNT = 2U;
+
+    /**
+     * @brief Unit cube triangles over corners where bit 0 selects +X, bit 1 +Y and bit 2 +Z (counter-clockwise from outside).
+     */
+    constexpr std::array<uint32_t, CUBE_INDEX_COUNT> CUBE_INDICES = {
+        0U, 4U, 6U, 0U, 6U, 2U,   // -X
+        1U, 3U, 7U, 1U, 7U, 5U,   // +X
+        0U, 1U, 5U, 0U, 5U, 4U,   // -Y
+        2U, 6U, 7U, 2U, 7U, 3U,   // +Y
+        0U, 2U, 3U, 0U, 3U, 1U,   // -Z
+        4U, 5U, 7U, 4U, 7U, 6U    // +Z
+    };
+
+    /**
+     * @struct SceneResources
+     * @brief Device objects of the synthetic scene that no engine class owns; released on every exit path.
+     */
+    struct SceneResources {
+        VulkanContext* context{ nullptr };
+        VkRenderPass renderPass{ VK_NULL_HANDLE };
+        VkBuffer geometryBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory geometryMemory{ VK_NULL_HANDLE };
+        std::array<VkDescriptorSet, IndirectDrawValidator::MATERIAL_COUNT> materialSets{};
+
+        explicit SceneResources(VulkanContext* const ctx) : context(ctx) {}
+
+        ~SceneResources() {
+            static_cast<void>(vkDeviceWaitIdle(context->device));
+            if (materialSets[0] != VK_NULL_HANDLE) {
+                static_cast<void>(vkFreeDescriptorSets(context->device, context->descriptorPool,
+                    static_cast<uint32_t>(materialSets.size()), materialSets.data()));
+            }
+            vkDestroyBuffer(context->device, geometryBuffer, nullptr);
+            vkFreeMemory(context->device, geometryMemory, nullptr);
+            vkDestroyRenderPass(context->device, renderPass, nullptr);
+        }
+
+        SceneResources(const SceneResources&) = delete;
+        SceneResources& operator=(const SceneResources&) = delete;
+    };
+
+    /**
+     * @brief Uploads one cube (vertices, then 32-bit indices) that every mesh of the scene draws.
+     * IndirectDrawSystem copies it into its pool once per record, as it does with the renderer's meshes.
+     */
+    void createCubeGeometry(SceneResources& scene) {
+        std::array<Vertex, CUBE_VERTEX_COUNT> vertices{};
+        for (uint32_t corner = 0U; corner < CUBE_VERTEX_COUNT; ++corner) {
+            vertices[corner].position = glm::vec3(
+                ((corner & 1U) != 0U) ? 0.5f : -0.5f,
+                ((corner & 2U) != 0U) ? 0.5f : -0.5f,
+                ((corner & 4U) != 0U) ? 0.5f : -0.5f);
+            vertices[corner].normal = glm::normalize(vertices[corner].position);
+        }
+
+        const VkDeviceSize vertexBytes = sizeof(vertices);
+        const VkDeviceSize indexBytes = sizeof(CUBE_INDICES);
+        VulkanUtils::createBuffer(scene.context->device, scene.context->physicalDevice, vertexBytes + indexBytes,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+            scene.geometryBuffer, scene.geometryMemory);
+
+        void* data{ nullptr };
+        static_cast<void>(vkMapMemory(scene.context->device, scene.geometryMemory, 0ULL, vertexBytes + indexBytes, 0U, &data));
+        static_cast<void>(std::memcpy(data, vertices.data(), static_cast<size_t>(vertexBytes)));
+        static_cast<void>(std::memcpy(static_cast<char*>(data) + vertexBytes, CUBE_INDICES.data(), static_cast<size_t>(indexBytes)));
+        vkUnmapMemory(scene.context->device, scene.geometryMemory);
+    }
+
+    /**
+     * @brief Allocates the material sets; they are never bound, only used as batch keys.
+     */
+    void allocateMaterialSets(SceneResources& scene) {
+        std::array<VkDescriptorSetLayout, IndirectDrawValidator::MATERIAL_COUNT> layouts{};
+        layouts.fill(scene.context->materialSetLayout);
+
+        VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocInfo.descriptorPool = scene.context->descriptorPool;
+        allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        allocInfo.pSetLayouts = layouts.data();
+        if (vkAllocateDescriptorSets(scene.context->device, &allocInfo, scene.materialSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("IndirectDrawValidator: Failed to allocate material sets!");
+        }
+    }
+}
+
+// ========================================================================
+// SECTION 1: VALIDATION
+// ========================================================================
+
+/**
+ * @brief Builds the synthetic scene, runs the cull pass for every view and compares it with FrustumCuller.
+ */
+bool IndirectDrawValidator::run(VulkanContext* const ctx, std::ostream& out) {
+    try {
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(ctx->physicalDevice, &props);
+        const bool software = (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU);
+        out << "IndirectDrawValidator: Device " << props.deviceName << (software ? " (software)" : " (hardware)") << std::endl;
+
+        // Step 1: Shaders, a depth-only pass and the pipelines the batches are keyed by
+        SceneResources scene(ctx);
+        const ShaderModule cullShader(ctx, "./shaders/cull_comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+        ShaderModule depthVert(ctx, "./shaders/depth_vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+        ShaderModule shadowVert(ctx, "./shaders/shadow_vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+        scene.renderPass = VulkanUtils::createDepthRenderPass(ctx->device, VK_FORMAT_D32_SFLOAT);
+
+        const std::array<std::unique_ptr<Pipeline>, CAMERA_PIPELINE_COUNT> cameraPipelines = {
+            std::make_unique<Pipeline>(ctx, scene.renderPass, ctx->materialSetLayout, &depthVert, nullptr,
+                true, false, true, VK_SAMPLE_COUNT_1_BIT, VK_COMPARE_OP_LESS, false),
+            std::make_unique<Pipeline>(ctx, scene.renderPass, ctx->materialSetLayout, &depthVert, nullptr,
+                false, false, true, VK_SAMPLE_COUNT_1_BIT, VK_COMPARE_OP_LESS, false)
+        };
+        Pipeline shadowPipeline(ctx, scene.renderPass, ctx->materialSetLayout, &shadowVert, nullptr,
+            true, false, true, VK_SAMPLE_COUNT_1_BIT, VK_COMPARE_OP_LESS, false);
+
+        createCubeGeometry(scene);
+        allocateMaterialSets(scene);
+
+        std::vector<std::shared_ptr<Material>> materials{};
+        for (const std::unique_ptr<Pipeline>& pipeline : cameraPipelines) {
+            for (const VkDescriptorSet materialSet : scene.materialSets) {
+                materials.push_back(std::make_shared<Material>(materialSet, pipeline.get()));
+            }
+        }
+
+        // Step 2: Seeded meshes - box bounds, transforms, materials and view membership
+        std::mt19937 rng(RANDOM_SEED);
+        std::uniform_real_distribution<float> rndUnit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> rndSigned(-1.0f, 1.0f);
+        std::uniform_int_distribution<size_t> rndMaterial(0U, materials.size() - 1U);
+
+        std::vector<std::unique_ptr<Mesh>> meshes{};
+        std::vector<Mesh*> cameraMeshes{};
+        std::vector<const Mesh*> shadowCasters{};
+        for (uint32_t i = 0U; i < MESH_COUNT; ++i) {
+            auto mesh = std::make_unique<Mesh>(ctx, scene.geometryBuffer, CUBE_INDEX_COUNT,
+                static_cast<VkDeviceSize>(sizeof(Vertex) * CUBE_VERTEX_COUNT), materials[rndMaterial(rng)]);
+
+            if (i >= UNBOUNDED_MESH_COUNT) {
+                const glm::vec3 center(0.25f * rndSigned(rng), 0.25f * rndSigned(rng), 0.25f * rndSigned(rng));
+                const glm::vec3 halfExtent(0.05f + (0.55f * rndUnit(rng)), 0.05f + (0.55f * rndUnit(rng)), 0.05f + (0.55f * rndUnit(rng)));
+                BoundingVolume bounds{};
+                bounds.aabbMin = center - halfExtent;
+                bounds.aabbMax = center + halfExtent;
+                bounds.sphereCenter = center;
+                bounds.sphereRadius = glm::length(halfExtent);
+                bounds.valid = true;
+                mesh->setLocalBounds(bounds);
+            }
+
+            const glm::vec3 origin(rndSigned(rng), rndSigned(rng), rndSigned(rng));
+            glm::vec3 axis(rndSigned(rng), rndSigned(rng), rndSigned(rng));
+            axis = (glm::length(axis) > 1.0e-3f) ? glm::normalize(axis) : glm::vec3(0.0f, 1.0f, 0.0f);
+            const float scale = 0.5f + (1.5f * rndUnit(rng));
+            mesh->setModelMatrix(glm::translate(glm::mat4(1.0f), origin * SCENE_HALF_EXTENT) *
+                glm::rotate(glm::mat4(1.0f), glm::radians(360.0f * rndUnit(rng)), axis) *
+                glm::scale(glm::mat4(1.0f), glm::vec3(scale)));
+
+            // Most meshes are in both views; the rest in one of them only
+            const bool shadowCaster = (rndUnit(rng) < SHADOW_CASTER_FRACTION);
+            const bool inCamera = !shadowCaster || (rndUnit(rng) < 0.9f);
+            if (inCamera) {
+                cameraMeshes.push_back(mesh.get());
+            }
+            if (shadowCaster) {
+                shadowCasters.push_back(mesh.get());
+            }
+            meshes.push_back(std::move(mesh));
+        }
+
+        // Step 3: Object indices and records, exactly as the renderer builds them
+        std::vector<Mesh*> allMeshes{};
+        for (const std::unique_ptr<Mesh>& mesh : meshes) {
+            allMeshes.push_back(mesh.get());
+        }
+        ObjectBuffer objectBuffer(ctx, EngineConstants::COUNT_ONE);
+        objectBuffer.build(allMeshes);
+
+        IndirectDrawSystem indirectDraws(ctx, EngineConstants::COUNT_ONE);
+        if (!indirectDraws.isSupported()) {
+            out << "IndirectDrawValidator: Validation FAIL | device lacks multiDrawIndirect or drawIndirectFirstInstance" << std::endl;
+            return false;
+        }
+        indirectDraws.createCullPipeline(cullShader);
+        indirectDraws.build(objectBuffer, cameraMeshes, shadowCasters,
+            { cameraPipelines[0].get(), cameraPipelines[1].get() }, &shadowPipeline);
+
+        // Step 4: Upload the matrices and compare every view
+        objectBuffer.beginFrame(0U);
+        indirectDraws.beginFrame(0U);
+        return indirectDraws.validate(buildViews(), out);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "IndirectDrawValidator: Validation failed (" << e.what() << ")" << std::endl;
+        return false;
+    }
+}
+
+// ========================================================================
+// SECTION 2: VIEWS
+// ========================================================================
+
+/**
+ * @brief Eight orbiting perspective views, then one orthographic volume looking down like the sun.
+ */
+std::vector<glm::mat4> IndirectDrawValidator::buildViews() {
+    static constexpr uint32_t ORBIT_VIEWS = 8U;
+    static constexpr float ORBIT_RADIUS = 5.0f;
+    static constexpr float ORBIT_HEIGHT = 2.0f;
+    static constexpr float AIM_OFFSET = 1.5f;
+    static constexpr float NARROW_FOV = 25.0f;
+    static constexpr float WIDE_FOV = 60.0f;
+    static constexpr float ORTHO_HALF_EXTENT = 2.0f;
+    static constexpr float PI = 3.14159265358979f;
+
+    std::vector<glm::mat4> viewProjs{};
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+    for (uint32_t i = 0U; i < ORBIT_VIEWS; ++i) {
+        const float angle = (2.0f * PI * static_cast<float>(i)) / static_cast<float>(ORBIT_VIEWS);
+        const float height = ((i % 2U) == 0U) ? ORBIT_HEIGHT : -ORBIT_HEIGHT;
+        const glm::vec3 eye(ORBIT_RADIUS * std::cos(angle), height, ORBIT_RADIUS * std::sin(angle));
+        const glm::vec3 aim(AIM_OFFSET * -std::sin(angle), 0.0f, AIM_OFFSET * std::cos(angle));
+        const float fov = ((i % 4U) < 2U) ? NARROW_FOV : WIDE_FOV;
+        viewProjs.push_back(glm::perspective(glm::radians(fov), 1.0f, 0.1f, 100.0f) * glm::lookAt(eye, aim, up));
+    }
+    viewProjs.push_back(glm::ortho(-ORTHO_HALF_EXTENT, ORTHO_HALF_EXTENT, -ORTHO_HALF_EXTENT, ORTHO_HALF_EXTENT, 0.1f, 20.0f) *
+        glm::lookAt(glm::vec3(4.0f, 8.0f, 2.0f), glm::vec3(AIM_OFFSET, 0.0f, 0.0f), up));
+    return viewProjs;
+}
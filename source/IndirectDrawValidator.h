@@ -0,0 +1,49 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+/**
+ * @class IndirectDrawValidator
+ * @brief Checks the GPU-driven cull pass against FrustumCuller on a synthetic scene (--validate-indirect).
+ * * A seeded scene of boxes with random sizes, transforms, pipelines, materials and shadow
+ * membership (plus a few unbounded meshes) goes through ObjectBuffer and IndirectDrawSystem
+ * exactly as the renderer's meshes do; cull.comp then runs for every view and
+ * IndirectDrawSystem::validate() compares the compacted commands with the CPU culler.
+ * * Needs only a device (see HeadlessDevice): the scene shares one cube of geometry and its
+ * pipelines are depth-only, so no window, texture or model is loaded.
+ */
+class IndirectDrawValidator final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t MESH_COUNT = 512U;
+    static constexpr uint32_t UNBOUNDED_MESH_COUNT = 8U;     /**< Never culled; must appear in every view. */
+    static constexpr uint32_t MATERIAL_COUNT = 4U;           /**< Per camera pipeline, so batches split by both keys. */
+    static constexpr uint32_t RANDOM_SEED = 1234U;
+    static constexpr float SCENE_HALF_EXTENT = 3.0f;         /**< Mesh origins lie in [-3, 3]^3, around the orbit's aim points. */
+    static constexpr float SHADOW_CASTER_FRACTION = 0.75f;
+
+    /**
+     * @brief Builds the synthetic scene on the context's device, culls it from every view and compares.
+     * Waits for the queue. Writes one line per view and culling pass.
+     * @return true if every view matched the CPU reference; false on a mismatch or if the scene could not be built.
+     */
+    static bool run(VulkanContext* const ctx, std::ostream& out);
+
+    /**
+     * @brief The validation views: a ring of perspective views at alternating heights and field widths,
+     * aimed off-centre so each keeps part of the scene and rejects the rest, then an orthographic, light-like volume.
+     */
+    static std::vector<glm::mat4> buildViews();
+
+private:
+    // Static utility class: Constructor and Destructor are private to prevent instantiation.
+    IndirectDrawValidator() = default;
+    ~IndirectDrawValidator() = default;
+};
@@ -19,12 +19,25 @@ InputManager::InputManager(GLFWwindow* const inWindow, VulkanContext* const inCo
     rainEnabled(false),
     snowEnabled(false),
     bloomEnabled(false),
+    depthPrePassEnabled(false),
+    weightedOitEnabled(false),
+    occlusionCullingEnabled(true),
+    dynamicResolutionEnabled(true),
+    depthSortEnabled(true),
+    staticBundlesEnabled(true),
+    indirectDrawsEnabled(true),
+    unifiedParticlesEnabled(false),
+    particleCollisionEnabled(true),
+    particleLodEnabled(true),
+    windFieldEnabled(true),
     autoOrbit(true),
     t_pressedLast(false),
     T_pressedLast(false),
     intensityMod(DEFAULT_INTENSITY),
     colorMod(glm::vec3(1.0f, 1.0f, 1.0f)),
-    resetRequested(false)
+    resetRequested(false),
+    graphDumpRequested(false),
+    particleBenchmarkRequested(false)
 {
     // Step 1: Initial Mouse State Calculation
     int32_t width{ 0 };
@@ -82,6 +95,26 @@ void InputManager::handleKeyEvent(const int32_t key, const int32_t scancode, con
         useGouraud = !useGouraud;
         break;
 
+    case GLFW_KEY_P:
+        depthPrePassEnabled = !depthPrePassEnabled;
+        break;
+
+    case GLFW_KEY_O:
+        weightedOitEnabled = !weightedOitEnabled;
+        break;
+
+    case GLFW_KEY_V:
+        occlusionCullingEnabled = !occlusionCullingEnabled;
+        break;
+
+    case GLFW_KEY_B:
+        staticBundlesEnabled = !staticBundlesEnabled;
+        break;
+
+    case GLFW_KEY_G:
+        graphDumpRequested = true;
+        break;
+
     case GLFW_KEY_F1:
         resetCameraToDefault(CAM_IDX_FRONT);
         activeCameraIndex = static_cast<int32_t>(CAM_IDX_FRONT);
@@ -257,4 +290,22 @@ void InputManager::resetCameraToDefault(uint32_t index) const {
         cam->setYaw(-90.0f);
         cam->setPitch(0.0f);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Consumes the frame graph dump flag; true once per request.
+ */
+bool InputManager::consumeGraphDumpRequest() {
+    const bool requestActive = graphDumpRequested;
+    graphDumpRequested = false;
+    return requestActive;
+}
+
+/**
+ * @brief Consumes the particle benchmark flag; true once per request.
+ */
+bool InputManager::consumeParticleBenchmarkRequest() {
+    const bool requestActive = particleBenchmarkRequested;
+    particleBenchmarkRequested = false;
+    return requestActive;
+}
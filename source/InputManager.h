@@ -66,6 +66,18 @@ public:
     /** @brief Checks if a simulation reset was requested and clears the flag. */
     bool consumeResetRequest();
 
+    /** @brief Asks for the frame graph to be written to disk after the next recorded frame. */
+    void requestGraphDump() { graphDumpRequested = true; }
+
+    /** @brief Checks if a frame graph dump was requested ('G' key or UI) and clears the flag. */
+    bool consumeGraphDumpRequest();
+
+    /** @brief Asks for the particle layout benchmark to run before the next frame. */
+    void requestParticleBenchmark() { particleBenchmarkRequested = true; }
+
+    /** @brief Checks if the particle layout benchmark was requested (UI) and clears the flag. */
+    bool consumeParticleBenchmarkRequest();
+
     // --- Getters ---
     bool getGouraudEnabled() const { return useGouraud; }
     bool getDustEnabled() const { return dustEnabled; }
@@ -74,6 +86,17 @@ public:
     bool getRainEnabled() const { return rainEnabled; }
     bool getSnowEnabled() const { return snowEnabled; }
     bool getBloomEnabled() const { return bloomEnabled; }
+    bool getDepthPrePassEnabled() const { return depthPrePassEnabled; }
+    bool getWeightedOitEnabled() const { return weightedOitEnabled; }
+    bool getOcclusionCullingEnabled() const { return occlusionCullingEnabled; }
+    bool getDynamicResolutionEnabled() const { return dynamicResolutionEnabled; }
+    bool getDepthSortEnabled() const { return depthSortEnabled; }
+    bool getStaticBundlesEnabled() const { return staticBundlesEnabled; }
+    bool getIndirectDrawsEnabled() const { return indirectDrawsEnabled; }
+    bool getUnifiedParticlesEnabled() const { return unifiedParticlesEnabled; }
+    bool getParticleCollisionEnabled() const { return particleCollisionEnabled; }
+    bool getParticleLodEnabled() const { return particleLodEnabled; }
+    bool getWindFieldEnabled() const { return windFieldEnabled; }
     bool getAutoOrbit() const { return autoOrbit; }
     float getIntensityMod() const { return intensityMod; }
     const glm::vec3& getColorMod() const { return colorMod; }
@@ -86,6 +109,17 @@ public:
     void setRainEnabled(const bool v) { rainEnabled = v; }
     void setSnowEnabled(const bool v) { snowEnabled = v; }
     void setBloomEnabled(const bool v) { bloomEnabled = v; }
+    void setDepthPrePassEnabled(const bool v) { depthPrePassEnabled = v; }
+    void setWeightedOitEnabled(const bool v) { weightedOitEnabled = v; }
+    void setOcclusionCullingEnabled(const bool v) { occlusionCullingEnabled = v; }
+    void setDynamicResolutionEnabled(const bool v) { dynamicResolutionEnabled = v; }
+    void setDepthSortEnabled(const bool v) { depthSortEnabled = v; }
+    void setStaticBundlesEnabled(const bool v) { staticBundlesEnabled = v; }
+    void setIndirectDrawsEnabled(const bool v) { indirectDrawsEnabled = v; }
+    void setUnifiedParticlesEnabled(const bool v) { unifiedParticlesEnabled = v; }
+    void setParticleCollisionEnabled(const bool v) { particleCollisionEnabled = v; }
+    void setParticleLodEnabled(const bool v) { particleLodEnabled = v; }
+    void setWindFieldEnabled(const bool v) { windFieldEnabled = v; }
     void setAutoOrbit(const bool v) { autoOrbit = v; }
     void setIntensityMod(const float v) { intensityMod = v; }
     void setColorMod(const glm::vec3& v) { colorMod = v; }
@@ -114,6 +148,17 @@ private:
     bool rainEnabled;
     bool snowEnabled;
     bool bloomEnabled;
+    bool depthPrePassEnabled;
+    bool weightedOitEnabled;
+    bool occlusionCullingEnabled;
+    bool dynamicResolutionEnabled;
+    bool depthSortEnabled;
+    bool staticBundlesEnabled;
+    bool indirectDrawsEnabled;
+    bool unifiedParticlesEnabled;
+    bool particleCollisionEnabled;
+    bool particleLodEnabled;
+    bool windFieldEnabled;
     bool autoOrbit;
 
     // Edge-detection for specific keys
@@ -124,6 +169,8 @@ private:
     float intensityMod;
     glm::vec3 colorMod;
     bool resetRequested;
+    bool graphDumpRequested;
+    bool particleBenchmarkRequested;
 
     /** @brief Resets a specific camera to its starting coordinates and orientation. */
     void resetCameraToDefault(uint32_t index) const;
@@ -2,6 +2,8 @@
 
 /* parasoft-begin-suppress ALL */
 #include "libs.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <utility>
 /* parasoft-end-suppress ALL */
@@ -15,6 +17,8 @@
  * @brief Represents a PBR (Physically Based Rendering) material.
  * * Orchestrates the binding between a specific GPU Pipeline and the Descriptor Set (Set 1)
  * containing the material's textures (Albedo, Normal, AO, Metallic, Roughness).
+ * * Every change of a material's pipeline or descriptor set advances a process-wide generation;
+ * recordings that baked material state in (StaticDrawBundle) compare it to know they are stale.
  */
 class Material final {
 private:
@@ -29,6 +33,9 @@ private:
     std::shared_ptr<Texture> metallicMap{ nullptr };
     std::shared_ptr<Texture> roughnessMap{ nullptr };
 
+    // Starts at 1 so that a zeroed key never matches
+    inline static std::atomic<uint64_t> generation{ 1U };
+
 public:
     /**
      * @brief Minimal Constructor (Delegated logic).
@@ -85,4 +92,31 @@ public:
     Pipeline* getPipeline() const {
         return pipeline;
     }
+
+    // --- Mutators ---
+
+    /** @brief Rebinds the material to another Set 1 (e.g. after its textures were replaced). */
+    void setDescriptorSet(const VkDescriptorSet inDescriptorSet) {
+        descriptorSet = inDescriptorSet;
+        markChanged();
+    }
+
+    /** @brief Draws the material with another pipeline. */
+    void setPipeline(Pipeline* const inPipeline) {
+        pipeline = inPipeline;
+        markChanged();
+    }
+
+    /**
+     * @brief Advances the material generation. Call it after rewriting a material's descriptor set in place,
+     * which changes what recorded command buffers bound without changing the handle.
+     */
+    static void markChanged() {
+        static_cast<void>(generation.fetch_add(1U, std::memory_order_relaxed));
+    }
+
+    /** @brief Returns the current material generation (changes whenever any material does). */
+    static uint64_t getGeneration() {
+        return generation.load(std::memory_order_relaxed);
+    }
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 /* parasoft-begin-suppress ALL */
 #include "Pipeline.h"
+#include "CommandEncoder.h"
+#include <algorithm>
 #include <utility>
 /* parasoft-end-suppress ALL */
 
@@ -29,9 +31,48 @@ Mesh::~Mesh() {
 
 /**
  * @brief Updates the mesh's local transformation matrix.
+ * The normal matrix is derived here so shaders never invert per vertex.
  */
 void Mesh::setModelMatrix(const glm::mat4& matrix) {
     modelMatrix = matrix;
+    normalMatrix = glm::transpose(glm::inverse(matrix));
+    updateWorldBounds();
+}
+
+/**
+ * @brief Stores the object-space bounds and derives the world-space volume.
+ */
+void Mesh::setLocalBounds(const BoundingVolume& bounds) {
+    localBounds = bounds;
+    updateWorldBounds();
+}
+
+/**
+ * @brief Transforms the local bounds into world space.
+ * The AABB uses the absolute-matrix extent method (Arvo), so rotated boxes stay conservative;
+ * the sphere radius scales by the largest axis scale.
+ */
+void Mesh::updateWorldBounds() {
+    worldBounds = localBounds;
+    if (!localBounds.valid) {
+        return;
+    }
+
+    // Step 1: Box center and extents
+    const glm::vec3 localCenter = (localBounds.aabbMin + localBounds.aabbMax) * 0.5f;
+    const glm::vec3 localExtent = (localBounds.aabbMax - localBounds.aabbMin) * 0.5f;
+    const glm::mat3 linear(modelMatrix);
+    const glm::mat3 absLinear(glm::abs(linear[0]), glm::abs(linear[1]), glm::abs(linear[2]));
+
+    const glm::vec3 worldCenter = glm::vec3(modelMatrix * glm::vec4(localCenter, 1.0f));
+    const glm::vec3 worldExtent = absLinear * localExtent;
+    worldBounds.aabbMin = worldCenter - worldExtent;
+    worldBounds.aabbMax = worldCenter + worldExtent;
+
+    // Step 2: Sphere
+    const float maxScale = std::max({ glm::length(linear[0]), glm::length(linear[1]), glm::length(linear[2]) });
+    worldBounds.sphereCenter = glm::vec3(modelMatrix * glm::vec4(localBounds.sphereCenter, 1.0f));
+    worldBounds.sphereRadius = localBounds.sphereRadius * maxScale;
 }
 
 /**
@@ -44,44 +85,68 @@ bool Mesh::hasTransparency() const {
 
 /**
  * @brief Records the drawing sequence to the provided Vulkan Command Buffer.
- * Orchestrates pipeline binding, descriptor mapping (Global/Material),
+ * Orchestrates pipeline binding, descriptor mapping (Global/Material/Objects),
  * and indexed draw execution.
  */
  /**
   * @brief Records the drawing sequence to the provided Vulkan Command Buffer.
   * Adheres to CODSTA-CPP.54 (const member) and CODSTA-CPP.53 (const local).
   */
-void Mesh::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, const Pipeline* pipelineOverride) const {
+void Mesh::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, VkDescriptorSet objectSet, const Pipeline* pipelineOverride) const {
     // 1. Resolve active pipeline
     // FIX (CODSTA-CPP.53): Declared as const to prevent accidental reassignment
-    const Pipeline* const activePipeline = (pipelineOverride != nullptr)
-        ? pipelineOverride
-        : ((material != nullptr) ? material->getPipeline() : nullptr);
+    const Pipeline* const activePipeline = resolvePipeline(pipelineOverride);
 
-    if ((activePipeline != nullptr) && (cb != VK_NULL_HANDLE)) {
+    if ((activePipeline != nullptr) && (cb != VK_NULL_HANDLE) && (objectIndex != NO_OBJECT_INDEX)) {
         // 2. Bind Pipeline State
         activePipeline->bind(cb);
 
-        // 3. Bind Descriptor Sets
+        // 3. Bind Descriptor Sets (Set 2 holds this mesh's matrices at objectIndex)
         const VkDescriptorSet sets[SET_COUNT] = {
             globalSet,
-            (material != nullptr) ? material->getDescriptorSet() : VK_NULL_HANDLE
+            (material != nullptr) ? material->getDescriptorSet() : VK_NULL_HANDLE,
+            objectSet
         };
 
         vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS,
             activePipeline->getPipelineLayout(), SET_GLOBAL, SET_COUNT, sets, 0U, nullptr);
 
-        // 4. Update Model Matrix via Push Constants
-        vkCmdPushConstants(cb, activePipeline->getPipelineLayout(),
-            VK_SHADER_STAGE_VERTEX_BIT, EngineConstants::OFFSET_ZERO,
-            static_cast<uint32_t>(sizeof(glm::mat4)), &modelMatrix);
-
-        // 5. Bind Geometry Buffers
+        // 4. Bind Geometry Buffers
         const VkDeviceSize offsets[BUFFER_COUNT_ONE] = { 0ULL };
         vkCmdBindVertexBuffers(cb, BINDING_FIRST, BUFFER_COUNT_ONE, &buffer, offsets);
         vkCmdBindIndexBuffer(cb, buffer, indexOffset, VK_INDEX_TYPE_UINT32);
 
-        // 6. Draw call
-        vkCmdDrawIndexed(cb, indexCount, INSTANCE_COUNT_ONE, 0U, 0, 0U);
+        // 5. Draw call; firstInstance becomes gl_InstanceIndex, the object lookup
+        vkCmdDrawIndexed(cb, indexCount, INSTANCE_COUNT_ONE, 0U, 0, objectIndex);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Records the drawing sequence through a state-tracking encoder.
+ * Identical to the raw overload, except binds already current on the encoder are skipped.
+ */
+void Mesh::draw(CommandEncoder& encoder, const VkDescriptorSet globalSet, const VkDescriptorSet objectSet,
+    const Pipeline* const pipelineOverride) const
+{
+    const Pipeline* const activePipeline = resolvePipeline(pipelineOverride);
+
+    if ((activePipeline != nullptr) && (objectIndex != NO_OBJECT_INDEX)) {
+        const VkPipelineLayout layout = activePipeline->getPipelineLayout();
+
+        encoder.bindPipeline(activePipeline);
+        encoder.bindDescriptorSets(layout, globalSet,
+            (material != nullptr) ? material->getDescriptorSet() : VK_NULL_HANDLE);
+        encoder.bindObjectSet(layout, objectSet);
+        encoder.bindGeometry(buffer, indexOffset);
+        encoder.drawIndexed(indexCount, objectIndex);
+    }
+}
+
+/**
+ * @brief Returns the override if set, otherwise the material's pipeline (may be null).
+ */
+const Pipeline* Mesh::resolvePipeline(const Pipeline* const pipelineOverride) const {
+    return (pipelineOverride != nullptr)
+        ? pipelineOverride
+        : ((material != nullptr) ? material->getPipeline() : nullptr);
+}
@@ -8,8 +8,10 @@
 
 #include "Material.h"
 #include "VulkanContext.h"
+#include "CommonStructs.h"
 
 class Pipeline;
+class CommandEncoder;
 
 /**
  * @class Mesh
@@ -21,10 +23,12 @@ public:
     // --- Rendering Constants ---
     static constexpr uint32_t SET_GLOBAL = 0U;
     static constexpr uint32_t SET_MATERIAL = 1U;
-    static constexpr uint32_t SET_COUNT = 2U;
+    static constexpr uint32_t SET_OBJECTS = 2U;
+    static constexpr uint32_t SET_COUNT = 3U;
     static constexpr uint32_t BINDING_FIRST = 0U;
     static constexpr uint32_t BUFFER_COUNT_ONE = 1U;
     static constexpr uint32_t INSTANCE_COUNT_ONE = 1U;
+    static constexpr uint32_t NO_OBJECT_INDEX = 0xFFFFFFFFU;
 
 private:
     VulkanContext* context{ nullptr };
@@ -36,6 +40,10 @@ private:
 
     // Logic & Transformation
     glm::mat4    modelMatrix{ 1.0f };
+    glm::mat4    normalMatrix{ 1.0f };  /**< transpose(inverse(modelMatrix)), computed once per transform change. */
+    uint32_t     objectIndex{ NO_OBJECT_INDEX };  /**< Slot in the ObjectBuffer; drawn as firstInstance. */
+    BoundingVolume localBounds{};   /**< Object-space bounds computed at load time. */
+    BoundingVolume worldBounds{};   /**< localBounds transformed by modelMatrix; refreshed on every transform change. */
     std::string  name{ "Mesh" };
     std::shared_ptr<Material> material{ nullptr };
 
@@ -58,16 +66,44 @@ public:
     // --- Interface ---
 
     void setModelMatrix(const glm::mat4& matrix);
+    void setLocalBounds(const BoundingVolume& bounds);
+    void setObjectIndex(const uint32_t index) { objectIndex = index; }
     void setName(const std::string& n) { name = n; }
 
     /**
      * @brief Records draw commands for this specific mesh.
+     * Meshes without an object index (never registered with the ObjectBuffer) record nothing.
      */
-    void draw(VkCommandBuffer commandBuffer, VkDescriptorSet globalSet, const Pipeline* pipelineOverride = nullptr) const;
+    void draw(VkCommandBuffer commandBuffer, VkDescriptorSet globalSet, VkDescriptorSet objectSet,
+        const Pipeline* pipelineOverride = nullptr) const;
+
+    /**
+     * @brief Records draw commands through an encoder that elides redundant binds.
+     */
+    void draw(CommandEncoder& encoder, const VkDescriptorSet globalSet, const VkDescriptorSet objectSet,
+        const Pipeline* const pipelineOverride = nullptr) const;
+
+    /** @brief Returns the override if set, otherwise the material's pipeline (may be null). */
+    const Pipeline* resolvePipeline(const Pipeline* const pipelineOverride) const;
 
     // --- Logic Queries ---
 
     bool hasTransparency() const;
     const std::string& getName() const { return name; }
     Material* getMaterial() const { return material.get(); }
+    const glm::mat4& getModelMatrix() const { return modelMatrix; }
+    const glm::mat4& getNormalMatrix() const { return normalMatrix; }
+    uint32_t getObjectIndex() const { return objectIndex; }
+    const BoundingVolume& getWorldBounds() const { return worldBounds; }
+    const BoundingVolume& getLocalBounds() const { return localBounds; }
+
+    // --- Geometry Queries (used to merge meshes into shared GPU-driven buffers) ---
+
+    VkBuffer getBuffer() const { return buffer; }
+    uint32_t getIndexCount() const { return indexCount; }
+    VkDeviceSize getIndexOffset() const { return indexOffset; }
+
+private:
+    /** @brief Recomputes worldBounds from localBounds and the current model matrix. */
+    void updateWorldBounds();
 };
\ No newline at end of file
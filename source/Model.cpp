@@ -40,7 +40,7 @@ void Model::setScale(const glm::vec3& s) {
 
 /**
  * @brief Recalculates the TRS (Translate, Rotate, Scale) matrix.
- * Propagates the new global matrix to all constituent meshes.
+ * Propagates the new global matrix to all constituent meshes, which derive their normal matrix from it.
  */
 void Model::updateMatrix() {
     // Step 1: Calculate new transform matrix starting from Identity
@@ -67,11 +67,11 @@ void Model::updateMatrix() {
 /**
  * @brief Orchestrates the draw call for all child meshes.
  */
-void Model::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, const Pipeline* const pipelineOverride) {
+void Model::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, VkDescriptorSet objectSet, const Pipeline* const pipelineOverride) {
     for (const auto& mesh : meshes) {
         if (mesh != nullptr) {
             // Note: Mesh::draw handles specific material binding and descriptor logic
-            mesh->draw(cb, globalSet, pipelineOverride);
+            mesh->draw(cb, globalSet, objectSet, pipelineOverride);
         }
     }
 }
\ No newline at end of file
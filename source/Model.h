@@ -39,6 +39,7 @@ private:
 
     // --- Logic State ---
     bool canProduceShadows{ true };
+    bool animatedShadows{ false };  /**< Redrawn into the shadow overlay every frame instead of the static cache. */
 
     /** @brief Recalculates the internal 4x4 model matrix based on pos/rot/scale. */
     void updateMatrix();
@@ -65,15 +66,19 @@ public:
     void setRotation(const glm::vec3& rot);
     void setScale(const glm::vec3& s);
     void setShadowCasting(const bool enabled) { canProduceShadows = enabled; }
+    void setDynamicShadowCaster(const bool dynamic) { animatedShadows = dynamic; }
 
     /**
      * @brief Iterates through all child meshes and records their draw commands.
      */
-    void draw(VkCommandBuffer cb, VkDescriptorSet globalSet, const Pipeline* const pipelineOverride = nullptr);
+    void draw(VkCommandBuffer cb, VkDescriptorSet globalSet, VkDescriptorSet objectSet, const Pipeline* const pipelineOverride = nullptr);
 
     /** @brief Returns shadow state (bool is small enough for pass-by-value) */
     bool castsShadows() const { return canProduceShadows; }
 
+    /** @brief Returns true if the model moves or deforms, so its shadow cannot be cached. */
+    bool isDynamicShadowCaster() const { return animatedShadows; }
+
     // --- Accessors ---
 
     /** @brief Returns the position/rotation/scale by const reference */
@@ -7,6 +7,8 @@
 #include <sstream>
 #include <fstream>
 #include <map>
+#include <algorithm>
+#include <cmath>
 #include <glm/glm.hpp>
 /* parasoft-end-suppress ALL */
 
@@ -25,6 +27,7 @@ namespace OBJLoader {
         std::vector<std::string> groupNames{};
         std::vector<Vertex> vertices{};
         std::vector<uint32_t> indices{};
+        BoundingVolume bounds{};
     };
 
     // --- Named Constants for OBJ Parsing ---
@@ -51,6 +54,37 @@ namespace OBJLoader {
     static const std::string CMD_OBJECT = "o";
     static const std::string CMD_GROUP = "g";
 
+    /**
+     * @brief Computes the local AABB and a bounding sphere centered on it.
+     * The radius is the farthest vertex from the box center, which is tighter than the half-diagonal.
+     */
+    static BoundingVolume computeBounds(const std::vector<Vertex>& vertices)
+    {
+        BoundingVolume bounds{};
+        if (vertices.empty()) {
+            return bounds;
+        }
+
+        // Step 1: Axis-aligned extents
+        bounds.aabbMin = vertices[INDEX_FIRST].position;
+        bounds.aabbMax = vertices[INDEX_FIRST].position;
+        for (const Vertex& v : vertices) {
+            bounds.aabbMin = glm::min(bounds.aabbMin, v.position);
+            bounds.aabbMax = glm::max(bounds.aabbMax, v.position);
+        }
+
+        // Step 2: Sphere around the box center
+        bounds.sphereCenter = (bounds.aabbMin + bounds.aabbMax) * 0.5f;
+        float maxDistSq{ 0.0f };
+        for (const Vertex& v : vertices) {
+            const glm::vec3 d = v.position - bounds.sphereCenter;
+            maxDistSq = std::max(maxDistSq, glm::dot(d, d));
+        }
+        bounds.sphereRadius = std::sqrt(maxDistSq);
+        bounds.valid = true;
+        return bounds;
+    }
+
     /**
      * @brief Parses an OBJ file and triangulates polygons into a vector of MeshData.
      * @param fileName Path to the .obj file.
@@ -200,6 +234,11 @@ namespace OBJLoader {
             loadedMeshes.push_back({ currentName, currentGroupNames, currentVertices, currentIndices });
         }
 
+        // Bounds are computed once here so culling never has to touch vertex data
+        for (MeshData& mesh : loadedMeshes) {
+            mesh.bounds = computeBounds(mesh.vertices);
+        }
+
         file.close();
         return loadedMeshes;
     }
@@ -0,0 +1,110 @@
+#include "ObjectBuffer.h"
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "Mesh.h"
+#include "VulkanUtils.h"
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Destructor: Releases every owned GPU object.
+ */
+ObjectBuffer::~ObjectBuffer() {
+    if ((context == nullptr) || (context->device == VK_NULL_HANDLE)) {
+        return;
+    }
+
+    for (FrameResources& frame : frames) {
+        if (frame.mapped != nullptr) {
+            vkUnmapMemory(context->device, frame.memory);
+            frame.mapped = nullptr;
+        }
+        vkDestroyBuffer(context->device, frame.buffer, nullptr);
+        vkFreeMemory(context->device, frame.memory, nullptr);
+    }
+
+    vkDestroyDescriptorPool(context->device, descriptorPool, nullptr);
+}
+
+// ========================================================================
+// SECTION 2: SETUP
+// ========================================================================
+
+/**
+ * @brief Assigns object indices and creates the per-frame buffers and descriptor sets.
+ */
+void ObjectBuffer::build(const std::vector<Mesh*>& sceneMeshes) {
+    // Step 1: Object indices in registration order
+    for (Mesh* const mesh : sceneMeshes) {
+        if ((mesh == nullptr) || (mesh->getObjectIndex() != Mesh::NO_OBJECT_INDEX)) {
+            continue;
+        }
+        mesh->setObjectIndex(static_cast<uint32_t>(meshes.size()));
+        meshes.push_back(mesh);
+    }
+
+    if (meshes.empty()) {
+        return;
+    }
+
+    // Step 2: Private pool, one storage-buffer set per frame
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight };
+
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = EngineConstants::COUNT_ONE;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = framesInFlight;
+    if (vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("ObjectBuffer: Failed to create descriptor pool!");
+    }
+
+    // Step 3: Persistently mapped buffers (host-coherent; rewritten only for the frame being recorded)
+    const VkDeviceSize bytes = static_cast<VkDeviceSize>(meshes.size() * sizeof(GpuObjectData));
+
+    frames.resize(framesInFlight);
+    for (FrameResources& frame : frames) {
+        VulkanUtils::createBuffer(context->device, context->physicalDevice, bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), frame.buffer, frame.memory);
+        static_cast<void>(vkMapMemory(context->device, frame.memory, 0ULL, bytes, 0U, &frame.mapped));
+
+        VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = EngineConstants::COUNT_ONE;
+        allocInfo.pSetLayouts = &context->objectSetLayout;
+        if (vkAllocateDescriptorSets(context->device, &allocInfo, &frame.set) != VK_SUCCESS) {
+            throw std::runtime_error("ObjectBuffer: Failed to allocate descriptor set!");
+        }
+
+        const VkDescriptorBufferInfo bufferInfo{ frame.buffer, 0ULL, VK_WHOLE_SIZE };
+        const VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, frame.set,
+            EngineConstants::BINDING_OBJECTS, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo, nullptr };
+        vkUpdateDescriptorSets(context->device, EngineConstants::COUNT_ONE, &write, 0U, nullptr);
+    }
+}
+
+// ========================================================================
+// SECTION 3: PER-FRAME UPLOAD
+// ========================================================================
+
+/**
+ * @brief Selects the frame-in-flight buffer and copies the cached matrices of every mesh.
+ * The normal matrix was inverted once when the transform changed, not here and not per vertex.
+ */
+void ObjectBuffer::beginFrame(const uint32_t frameIndex) {
+    if (frames.empty()) {
+        return;
+    }
+
+    currentFrame = frameIndex % framesInFlight;
+    GpuObjectData* const objects = static_cast<GpuObjectData*>(frames[currentFrame].mapped);
+    for (size_t i = 0U; i < meshes.size(); ++i) {
+        objects[i].model = meshes[i]->getModelMatrix();
+        objects[i].normal = meshes[i]->getNormalMatrix();
+    }
+}
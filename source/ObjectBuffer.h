@@ -0,0 +1,86 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+class Mesh;
+
+/**
+ * @class ObjectBuffer
+ * @brief Per-frame storage buffer of object transforms, bound as Set 2 of every scene pipeline.
+ * * build() gives each mesh a stable object index. Every frame the model and normal matrices the
+ * meshes cached at transform time are copied into the frame's buffer; vertex shaders fetch them
+ * with gl_InstanceIndex, which CPU draws set through firstInstance and the cull shader writes into
+ * each indirect command. No matrix is inverted on the GPU and no push constant changes per draw.
+ */
+class ObjectBuffer final {
+public:
+    /**
+     * @struct GpuObjectData
+     * @brief Mirror of the shaders' ObjectData (std430, 128 bytes).
+     */
+    struct GpuObjectData {
+        glm::mat4 model;
+        glm::mat4 normal;   /**< transpose(inverse(model)); the shaders use the upper 3x3. */
+    };
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Buffers and descriptor sets are created by build(). */
+    ObjectBuffer(VulkanContext* const inContext, const uint32_t inFramesInFlight)
+        : context(inContext), framesInFlight(inFramesInFlight) {}
+
+    /** @brief Destructor: Unmaps and releases the per-frame buffers and the descriptor pool. */
+    ~ObjectBuffer();
+
+    // RAII: Owns GPU buffers and a descriptor pool; prevent duplication.
+    ObjectBuffer(const ObjectBuffer&) = delete;
+    ObjectBuffer& operator=(const ObjectBuffer&) = delete;
+
+    // --- Setup ---
+
+    /**
+     * @brief Assigns object indices in order and creates one buffer and set per frame in flight.
+     * Duplicate meshes keep their first index. Throws if a buffer or set cannot be created.
+     */
+    void build(const std::vector<Mesh*>& sceneMeshes);
+
+    /** @brief Returns true once build() registered at least one mesh. */
+    bool isReady() const { return !frames.empty(); }
+
+    // --- Per-Frame ---
+
+    /** @brief Selects the frame-in-flight buffer and copies every mesh's current matrices into it. */
+    void beginFrame(const uint32_t frameIndex);
+
+    /** @brief Returns the Set 2 descriptor of the current frame. */
+    VkDescriptorSet getSet() const { return frames.empty() ? VK_NULL_HANDLE : frames[currentFrame].set; }
+
+    /** @brief Returns the storage buffer of a frame (read by the GPU-driven cull pass). */
+    VkBuffer getBuffer(const uint32_t frameIndex) const { return frames[frameIndex % framesInFlight].buffer; }
+
+    /** @brief Returns the number of registered objects. */
+    uint32_t getObjectCount() const { return static_cast<uint32_t>(meshes.size()); }
+
+private:
+    /** @brief Host-visible buffer rewritten once per frame. */
+    struct FrameResources {
+        VkBuffer buffer{ VK_NULL_HANDLE };
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        void* mapped{ nullptr };
+        VkDescriptorSet set{ VK_NULL_HANDLE };
+    };
+
+    VulkanContext* context{ nullptr };
+    uint32_t framesInFlight{ 0U };
+    uint32_t currentFrame{ 0U };
+
+    std::vector<const Mesh*> meshes{};   /**< Object index -> mesh whose matrices are uploaded. */
+    std::vector<FrameResources> frames{};
+    VkDescriptorPool descriptorPool{ VK_NULL_HANDLE };
+};
@@ -0,0 +1,288 @@
+#include "OcclusionCuller.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define OCCLUSION_CULLER_SSE2 1
+#endif
+/* parasoft-end-suppress ALL */
+
+// ========================================================================
+// SECTION 1: LIFECYCLE & SETUP
+// ========================================================================
+
+/**
+ * @brief Constructor: Allocates the depth buffer and tile level, and binds one job per band.
+ * Job i always runs on worker i, so each band's rows and tiles have a single writer.
+ */
+OcclusionCuller::OcclusionCuller()
+    : depth(static_cast<size_t>(BUFFER_WIDTH) * BUFFER_HEIGHT, FAR_DEPTH),
+      tileMax(static_cast<size_t>(TILES_X) * TILES_Y, FAR_DEPTH),
+      workers(BAND_COUNT)
+{
+    for (uint32_t band = 0U; band < BAND_COUNT; ++band) {
+        bandJobs.push_back([this, band]() { rasterizeBand(band); });
+    }
+}
+
+/**
+ * @brief Appends an occluder's triangles, transformed once into world space.
+ */
+void OcclusionCuller::addOccluder(const OBJLoader::MeshData& data, const glm::mat4& modelMatrix) {
+    const uint32_t base = static_cast<uint32_t>(occluderVertices.size());
+
+    for (const Vertex& vertex : data.vertices) {
+        occluderVertices.push_back(glm::vec3(modelMatrix * glm::vec4(vertex.position, 1.0f)));
+    }
+
+    // Whole triangles only; a trailing partial triangle is ignored
+    const size_t indexCount = data.indices.size() - (data.indices.size() % TRI_VERT_COUNT);
+    for (size_t i = 0U; i < indexCount; ++i) {
+        occluderIndices.push_back(base + data.indices[i]);
+    }
+}
+
+// ========================================================================
+// SECTION 2: RASTERIZATION
+// ========================================================================
+
+/**
+ * @brief Rasterizes every occluder seen through viewProj and rebuilds the tile hierarchy.
+ */
+void OcclusionCuller::rasterize(const glm::mat4& viewProj) {
+    viewProjection = viewProj;
+
+    // Step 1: Shared triangle setup (read-only for the bands)
+    setupTriangles(viewProj);
+
+    // Step 2: Each band clears, rasterizes and reduces its own rows
+    workers.run(bandJobs);
+    rasterized = true;
+}
+
+/**
+ * @brief Projects the occluder vertices and sets up the edge functions of every front-facing triangle.
+ * Pixel (x, y) samples at its centre; buffer rows run top to bottom like the framebuffer (the
+ * projection is Y-flipped), so Vulkan's counter-clockwise front face has a negative signed area here.
+ */
+void OcclusionCuller::setupTriangles(const glm::mat4& viewProj) {
+    // Step 1: Clip-space vertices
+    clipVertices.resize(occluderVertices.size());
+    for (size_t i = 0U; i < occluderVertices.size(); ++i) {
+        clipVertices[i] = viewProj * glm::vec4(occluderVertices[i], 1.0f);
+    }
+
+    triangles.clear();
+    const float halfWidth = static_cast<float>(BUFFER_WIDTH) * 0.5f;
+    const float halfHeight = static_cast<float>(BUFFER_HEIGHT) * 0.5f;
+
+    for (size_t i = 0U; i < occluderIndices.size(); i += TRI_VERT_COUNT) {
+        // Step 2: Project; triangles reaching behind the near plane are dropped (never wrongly occlude)
+        glm::vec3 screen[TRI_VERT_COUNT]{};
+        bool clipped = false;
+        for (uint32_t v = 0U; v < TRI_VERT_COUNT; ++v) {
+            const glm::vec4& clip = clipVertices[occluderIndices[i + v]];
+            if ((clip.w < MIN_CLIP_W) || (clip.z < 0.0f)) {
+                clipped = true;
+                break;
+            }
+            const float invW = 1.0f / clip.w;
+            screen[v] = glm::vec3(((clip.x * invW) + 1.0f) * halfWidth, ((clip.y * invW) + 1.0f) * halfHeight,
+                std::min(clip.z * invW, FAR_DEPTH));
+        }
+        if (clipped) {
+            continue;
+        }
+
+        // Step 3: Back faces and degenerate triangles write nothing the GPU would draw
+        const float area = ((screen[1].x - screen[0].x) * (screen[2].y - screen[0].y)) -
+            ((screen[2].x - screen[0].x) * (screen[1].y - screen[0].y));
+        if (area >= 0.0f) {
+            continue;
+        }
+        std::swap(screen[1], screen[2]);   // Positive winding: inside is where all edges are >= 0
+
+        // Step 4: Pixel bounding box, clamped to the buffer
+        ScreenTriangle tri{};
+        tri.minX = std::max(static_cast<int32_t>(std::floor(std::min({ screen[0].x, screen[1].x, screen[2].x }))), 0);
+        tri.maxX = std::min(static_cast<int32_t>(std::floor(std::max({ screen[0].x, screen[1].x, screen[2].x }))),
+            static_cast<int32_t>(BUFFER_WIDTH) - 1);
+        tri.minY = std::max(static_cast<int32_t>(std::floor(std::min({ screen[0].y, screen[1].y, screen[2].y }))), 0);
+        tri.maxY = std::min(static_cast<int32_t>(std::floor(std::max({ screen[0].y, screen[1].y, screen[2].y }))),
+            static_cast<int32_t>(BUFFER_HEIGHT) - 1);
+        if ((tri.minX > tri.maxX) || (tri.minY > tri.maxY)) {
+            continue;
+        }
+
+        // Step 5: Edge functions E(p) = A*px + B*py + C, and the farthest vertex depth
+        for (uint32_t e = 0U; e < TRI_VERT_COUNT; ++e) {
+            const glm::vec3& a = screen[e];
+            const glm::vec3& b = screen[(e + 1U) % TRI_VERT_COUNT];
+            tri.edgeA[e] = a.y - b.y;
+            tri.edgeB[e] = b.x - a.x;
+            tri.edgeC[e] = ((b.y - a.y) * a.x) - ((b.x - a.x) * a.y);
+        }
+        tri.depth = std::max({ screen[0].z, screen[1].z, screen[2].z });
+        triangles.push_back(tri);
+    }
+}
+
+/**
+ * @brief Clears one band, rasterizes every triangle overlapping it and reduces its tiles.
+ */
+void OcclusionCuller::rasterizeBand(const uint32_t band) {
+    const int32_t bandMinY = static_cast<int32_t>(band * BAND_HEIGHT);
+    const int32_t bandMaxY = bandMinY + static_cast<int32_t>(BAND_HEIGHT) - 1;
+
+    // Step 1: Clear
+    std::fill(depth.begin() + (static_cast<size_t>(bandMinY) * BUFFER_WIDTH),
+        depth.begin() + (static_cast<size_t>(bandMaxY + 1) * BUFFER_WIDTH), FAR_DEPTH);
+
+    // Step 2: Rows of every triangle that reaches into this band
+    for (const ScreenTriangle& tri : triangles) {
+        const int32_t firstRow = std::max(tri.minY, bandMinY);
+        const int32_t lastRow = std::min(tri.maxY, bandMaxY);
+        for (int32_t y = firstRow; y <= lastRow; ++y) {
+            rasterizeRow(tri, y, tri.minX, tri.maxX);
+        }
+    }
+
+    // Step 3: Farthest depth per tile (the coarse level queries test first)
+    const uint32_t firstTileRow = static_cast<uint32_t>(bandMinY) / TILE_SIZE;
+    for (uint32_t ty = firstTileRow; ty < (firstTileRow + (BAND_HEIGHT / TILE_SIZE)); ++ty) {
+        for (uint32_t tx = 0U; tx < TILES_X; ++tx) {
+            float farthest = 0.0f;
+            for (uint32_t y = ty * TILE_SIZE; y < ((ty + 1U) * TILE_SIZE); ++y) {
+                const float* const row = &depth[(static_cast<size_t>(y) * BUFFER_WIDTH) + (tx * TILE_SIZE)];
+                farthest = std::max(farthest, *std::max_element(row, row + TILE_SIZE));
+            }
+            tileMax[(ty * TILES_X) + tx] = farthest;
+        }
+    }
+}
+
+/**
+ * @brief Writes one triangle's covered pixels of a single row.
+ * Four pixel centres are tested per step; covered lanes keep the nearer of buffer and triangle depth.
+ */
+void OcclusionCuller::rasterizeRow(const ScreenTriangle& tri, const int32_t y, const int32_t minX, const int32_t maxX) {
+    float* const row = &depth[static_cast<size_t>(y) * BUFFER_WIDTH];
+    const float py = static_cast<float>(y) + 0.5f;
+    int32_t x = minX - (minX % static_cast<int32_t>(SIMD_WIDTH));
+
+#ifdef OCCLUSION_CULLER_SSE2
+    // Step 1: Aligned groups of four; lanes outside [minX, maxX] fail an edge test or only re-write the same minimum
+    const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 triDepth = _mm_set1_ps(tri.depth);
+    __m128 rowEdge[TRI_VERT_COUNT];
+    __m128 stepX[TRI_VERT_COUNT];
+    for (uint32_t e = 0U; e < TRI_VERT_COUNT; ++e) {
+        rowEdge[e] = _mm_set1_ps((tri.edgeB[e] * py) + tri.edgeC[e]);
+        stepX[e] = _mm_set1_ps(tri.edgeA[e]);
+    }
+
+    for (; x <= maxX; x += static_cast<int32_t>(SIMD_WIDTH)) {
+        const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+        __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[0], px), rowEdge[0]), _mm_setzero_ps());
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[1], px), rowEdge[1]), _mm_setzero_ps()));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[2], px), rowEdge[2]), _mm_setzero_ps()));
+        if (_mm_movemask_ps(inside) == 0) {
+            continue;
+        }
+
+        const __m128 current = _mm_loadu_ps(&row[x]);
+        const __m128 nearer = _mm_min_ps(current, triDepth);
+        _mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+    }
+#endif
+
+    // Step 2: Scalar path (everything without SSE2)
+    for (; x <= maxX; ++x) {
+        const float px = static_cast<float>(x) + 0.5f;
+        bool inside = true;
+        for (uint32_t e = 0U; e < TRI_VERT_COUNT; ++e) {
+            if (((tri.edgeA[e] * px) + (tri.edgeB[e] * py) + tri.edgeC[e]) < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            row[x] = std::min(row[x], tri.depth);
+        }
+    }
+}
+
+// ========================================================================
+// SECTION 3: QUERIES
+// ========================================================================
+
+/**
+ * @brief Returns false only if the box's nearest depth lies behind every pixel its screen rectangle touches.
+ * Boxes that reach behind the near plane or leave the buffer are always visible.
+ */
+bool OcclusionCuller::isVisible(const BoundingVolume& worldBounds) const {
+    if (!rasterized || !worldBounds.valid) {
+        return true;
+    }
+
+    // Step 1: Project the corners; nearest depth and screen rectangle
+    float minX = static_cast<float>(BUFFER_WIDTH);
+    float maxX = 0.0f;
+    float minY = static_cast<float>(BUFFER_HEIGHT);
+    float maxY = 0.0f;
+    float nearest = FAR_DEPTH;
+    for (uint32_t corner = 0U; corner < BOX_CORNER_COUNT; ++corner) {
+        const glm::vec3 point{
+            ((corner & 1U) != 0U) ? worldBounds.aabbMax.x : worldBounds.aabbMin.x,
+            ((corner & 2U) != 0U) ? worldBounds.aabbMax.y : worldBounds.aabbMin.y,
+            ((corner & 4U) != 0U) ? worldBounds.aabbMax.z : worldBounds.aabbMin.z
+        };
+        const glm::vec4 clip = viewProjection * glm::vec4(point, 1.0f);
+        if (clip.w < MIN_CLIP_W) {
+            return true;
+        }
+        const float invW = 1.0f / clip.w;
+        const float sx = ((clip.x * invW) + 1.0f) * (static_cast<float>(BUFFER_WIDTH) * 0.5f);
+        const float sy = ((clip.y * invW) + 1.0f) * (static_cast<float>(BUFFER_HEIGHT) * 0.5f);
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        nearest = std::min(nearest, clip.z * invW);
+    }
+    if (nearest <= 0.0f) {
+        return true;
+    }
+
+    // Step 2: Pixel rectangle, grown by the dilation margin; off-buffer boxes are the frustum's business
+    const int32_t x0 = std::max(static_cast<int32_t>(std::floor(minX)) - RECT_DILATION, 0);
+    const int32_t x1 = std::min(static_cast<int32_t>(std::floor(maxX)) + RECT_DILATION, static_cast<int32_t>(BUFFER_WIDTH) - 1);
+    const int32_t y0 = std::max(static_cast<int32_t>(std::floor(minY)) - RECT_DILATION, 0);
+    const int32_t y1 = std::min(static_cast<int32_t>(std::floor(maxY)) + RECT_DILATION, static_cast<int32_t>(BUFFER_HEIGHT) - 1);
+    if ((x0 > x1) || (y0 > y1)) {
+        return true;
+    }
+
+    // Step 3: Coarse tiles first; only tiles that cannot reject the box on their own are scanned per pixel
+    const int32_t tileSize = static_cast<int32_t>(TILE_SIZE);
+    for (int32_t ty = y0 / tileSize; ty <= (y1 / tileSize); ++ty) {
+        for (int32_t tx = x0 / tileSize; tx <= (x1 / tileSize); ++tx) {
+            if (nearest > tileMax[(static_cast<size_t>(ty) * TILES_X) + static_cast<size_t>(tx)]) {
+                continue;
+            }
+
+            const int32_t rowEnd = std::min(((ty + 1) * tileSize) - 1, y1);
+            const int32_t colEnd = std::min(((tx + 1) * tileSize) - 1, x1);
+            for (int32_t y = std::max(ty * tileSize, y0); y <= rowEnd; ++y) {
+                for (int32_t x = std::max(tx * tileSize, x0); x <= colEnd; ++x) {
+                    if (nearest <= depth[(static_cast<size_t>(y) * BUFFER_WIDTH) + static_cast<size_t>(x)]) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
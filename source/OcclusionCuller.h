@@ -0,0 +1,130 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "CommonStructs.h"
+#include "OBJLoader.h"
+#include "PassWorkerPool.h"
+
+/**
+ * @class OcclusionCuller
+ * @brief CPU occlusion culling against a low-resolution depth buffer of a few large static occluders.
+ * * Occluder triangles (sand plug, base, house) are baked to world space at load time. Each frame
+ * they are projected once and rasterized into a small depth buffer, one horizontal band per worker
+ * thread with four pixels per SSE step; every band then reduces its tiles to their farthest depth.
+ * * A box is occluded when its nearest projected depth lies behind every covered pixel. Tiles whose
+ * farthest depth is nearer than the box reject it without touching their pixels. Everything here is
+ * plain CPU code: no device is needed to rasterize or to query.
+ * * The test is conservative: only front faces are written (the scene pipelines cull back faces),
+ * triangles crossing the near plane are dropped, each covered pixel takes the triangle's farthest
+ * vertex depth and the tested rectangle is grown by a pixel, so sampling only errs towards visible.
+ */
+class OcclusionCuller final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t BUFFER_WIDTH = 256U;
+    static constexpr uint32_t BUFFER_HEIGHT = 128U;
+    static constexpr uint32_t TILE_SIZE = 8U;
+    static constexpr uint32_t TILES_X = BUFFER_WIDTH / TILE_SIZE;
+    static constexpr uint32_t TILES_Y = BUFFER_HEIGHT / TILE_SIZE;
+    static constexpr uint32_t BAND_COUNT = 4U;
+    static constexpr uint32_t BAND_HEIGHT = BUFFER_HEIGHT / BAND_COUNT;
+    static constexpr uint32_t SIMD_WIDTH = 4U;
+    static constexpr uint32_t TRI_VERT_COUNT = 3U;
+    static constexpr uint32_t BOX_CORNER_COUNT = 8U;
+    static constexpr float FAR_DEPTH = 1.0f;
+    static constexpr float MIN_CLIP_W = 1.0e-4f;   /**< Vertices closer to the eye plane than this are not projected. */
+    static constexpr int32_t RECT_DILATION = 1;    /**< Pixels added around a tested box's screen rectangle. */
+
+    static_assert((BAND_HEIGHT % TILE_SIZE) == 0U, "OcclusionCuller: bands must hold whole tile rows");
+    static_assert((BUFFER_WIDTH % SIMD_WIDTH) == 0U, "OcclusionCuller: rows must hold whole SIMD groups");
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Allocates the depth buffer and starts one worker per band. */
+    OcclusionCuller();
+
+    /** @brief Destructor: Joins the band workers. */
+    ~OcclusionCuller() = default;
+
+    // RAII: Owns worker threads and large scratch buffers; prevent duplication.
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // --- Setup ---
+
+    /**
+     * @brief Bakes a static occluder's triangles to world space with the given model matrix.
+     * Only meshes drawn opaque with back-face culling belong here.
+     */
+    void addOccluder(const OBJLoader::MeshData& data, const glm::mat4& modelMatrix);
+
+    /** @brief Returns true once at least one occluder triangle was registered. */
+    bool hasOccluders() const { return !occluderIndices.empty(); }
+
+    /** @brief Returns the number of registered occluder triangles. */
+    uint32_t getOccluderTriangleCount() const { return static_cast<uint32_t>(occluderIndices.size() / TRI_VERT_COUNT); }
+
+    // --- Per-Frame ---
+
+    /** @brief Rasterizes every occluder seen through viewProj and rebuilds the tile hierarchy. */
+    void rasterize(const glm::mat4& viewProj);
+
+    /**
+     * @brief Returns false only if the world-space box is hidden behind the last rasterized occluders.
+     * Safe to call from several threads at once between two rasterize() calls.
+     */
+    bool isVisible(const BoundingVolume& worldBounds) const;
+
+    /** @brief Returns the rasterized depth of one buffer pixel (1.0 where no occluder landed). */
+    float getDepth(const uint32_t x, const uint32_t y) const { return depth[(y * BUFFER_WIDTH) + x]; }
+
+    /** @brief Returns the number of occluder triangles that survived setup in the last rasterize(). */
+    uint32_t getRasterizedTriangleCount() const { return static_cast<uint32_t>(triangles.size()); }
+
+private:
+    /**
+     * @struct ScreenTriangle
+     * @brief Set-up triangle: three edge functions (inside when all are >= 0), a flat depth and a pixel bounding box.
+     */
+    struct ScreenTriangle {
+        float edgeA[TRI_VERT_COUNT]{};
+        float edgeB[TRI_VERT_COUNT]{};
+        float edgeC[TRI_VERT_COUNT]{};
+        float depth{ FAR_DEPTH };
+        int32_t minX{ 0 };
+        int32_t maxX{ 0 };
+        int32_t minY{ 0 };
+        int32_t maxY{ 0 };
+    };
+
+    /** @brief Projects, back-face culls and bins the occluder triangles (calling thread). */
+    void setupTriangles(const glm::mat4& viewProj);
+
+    /** @brief Clears one band, rasterizes every triangle overlapping it and reduces its tiles. */
+    void rasterizeBand(const uint32_t band);
+
+    /** @brief Writes one triangle's covered pixels of a single row, four pixels per SIMD step. */
+    void rasterizeRow(const ScreenTriangle& tri, const int32_t y, const int32_t minX, const int32_t maxX);
+
+    // --- Occluder Geometry (world space, baked once) ---
+    std::vector<glm::vec3> occluderVertices{};
+    std::vector<uint32_t> occluderIndices{};
+
+    // --- Per-Frame Scratch ---
+    std::vector<glm::vec4> clipVertices{};
+    std::vector<ScreenTriangle> triangles{};
+    std::vector<float> depth{};      /**< BUFFER_WIDTH * BUFFER_HEIGHT, row-major, 0 = near. */
+    std::vector<float> tileMax{};    /**< TILES_X * TILES_Y farthest depth per tile. */
+    glm::mat4 viewProjection{ 1.0f };
+    bool rasterized{ false };
+
+    // --- Band Workers ---
+    PassWorkerPool workers;
+    std::vector<std::function<void()>> bandJobs{};
+};
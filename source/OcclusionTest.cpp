@@ -0,0 +1,285 @@
+#include "OcclusionTest.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+/* parasoft-end-suppress ALL */
+
+#include "OcclusionCuller.h"
+
+namespace {
+    /**
+     * @struct TestOccluder
+     * @brief A unit-cube mesh (or a single quad) scaled and moved into the test scene.
+     */
+    struct TestOccluder {
+        glm::vec3 center;
+        glm::vec3 halfExtent;
+        bool singleQuad;   /**< Only the +Z face: a one-sided sign, visible through from behind. */
+    };
+
+    /**
+     * @struct TestView
+     * @brief A named camera the scene is rasterized and ray cast from.
+     */
+    struct TestView {
+        const char* name;
+        glm::vec3 eye;
+        bool orthographic;
+    };
+
+    /**
+     * @struct WorldTriangle
+     * @brief Occluder triangle in world space, wound like the mesh (counter-clockwise from its front).
+     */
+    struct WorldTriangle {
+        glm::vec3 v0;
+        glm::vec3 v1;
+        glm::vec3 v2;
+    };
+
+    constexpr uint32_t QUAD_CORNERS = 4U;
+    constexpr float FOV_DEGREES = 60.0f;
+    constexpr float ORTHO_HALF_HEIGHT = 2.5f;
+    constexpr float NO_HIT = 2.0f;   /**< Beyond the far end of every pixel ray (t runs 0..1). */
+
+    /**
+     * @brief Corners of the unit cube [-1, 1]^3; bit 0 selects +X, bit 1 +Y, bit 2 +Z.
+     * Faces list their corners counter-clockwise seen from outside, the winding the scene meshes use.
+     */
+    constexpr std::array<std::array<uint32_t, QUAD_CORNERS>, 6> CUBE_FACES = { {
+        { 0U, 4U, 6U, 2U },   // -X
+        { 1U, 3U, 7U, 5U },   // +X
+        { 0U, 1U, 5U, 4U },   // -Y
+        { 2U, 6U, 7U, 3U },   // +Y
+        { 0U, 2U, 3U, 1U },   // -Z
+        { 4U, 5U, 7U, 6U }    // +Z
+    } };
+    constexpr size_t FACE_POSITIVE_Z = 5U;
+
+    /**
+     * @brief Builds the mesh of an occluder in its local unit space.
+     */
+    OBJLoader::MeshData buildMesh(const bool singleQuad) {
+        OBJLoader::MeshData data{};
+        data.name = singleQuad ? "test_sign" : "test_box";
+        for (uint32_t corner = 0U; corner < OcclusionCuller::BOX_CORNER_COUNT; ++corner) {
+            Vertex vertex{};
+            vertex.position = glm::vec3(((corner & 1U) != 0U) ? 1.0f : -1.0f,
+                ((corner & 2U) != 0U) ? 1.0f : -1.0f,
+                ((corner & 4U) != 0U) ? 1.0f : -1.0f);
+            data.vertices.push_back(vertex);
+        }
+
+        const size_t firstFace = singleQuad ? FACE_POSITIVE_Z : 0U;
+        for (size_t face = firstFace; face < CUBE_FACES.size(); ++face) {
+            const std::array<uint32_t, QUAD_CORNERS>& quad = CUBE_FACES[face];
+            data.indices.insert(data.indices.end(), { quad[0], quad[1], quad[2], quad[0], quad[2], quad[3] });
+        }
+        return data;
+    }
+
+    /**
+     * @brief Returns the ray parameter of the nearest hit, or NO_HIT. Barycentrics may undershoot by EDGE_EPSILON.
+     */
+    float intersectTriangle(const glm::vec3& origin, const glm::vec3& dir, const WorldTriangle& tri) {
+        const glm::vec3 edge1 = tri.v1 - tri.v0;
+        const glm::vec3 edge2 = tri.v2 - tri.v0;
+        const glm::vec3 p = glm::cross(dir, edge2);
+        const float det = glm::dot(edge1, p);
+        if (std::fabs(det) < std::numeric_limits<float>::min()) {
+            return NO_HIT;
+        }
+
+        const float invDet = 1.0f / det;
+        const glm::vec3 s = origin - tri.v0;
+        const float u = glm::dot(s, p) * invDet;
+        const glm::vec3 q = glm::cross(s, edge1);
+        const float v = glm::dot(dir, q) * invDet;
+        if ((u < -OcclusionTest::EDGE_EPSILON) || (v < -OcclusionTest::EDGE_EPSILON) ||
+            ((u + v) > (1.0f + OcclusionTest::EDGE_EPSILON))) {
+            return NO_HIT;
+        }
+
+        const float t = glm::dot(edge2, q) * invDet;
+        return (t >= 0.0f) ? t : NO_HIT;
+    }
+
+    /**
+     * @brief Returns the ray parameter at which the segment first touches the box (0 if it starts inside), or NO_HIT.
+     */
+    float intersectBox(const glm::vec3& origin, const glm::vec3& dir, const BoundingVolume& box) {
+        float tEnter = 0.0f;
+        float tExit = 1.0f;
+        for (glm::length_t axis = 0; axis < 3; ++axis) {
+            if (std::fabs(dir[axis]) < std::numeric_limits<float>::min()) {
+                if ((origin[axis] < box.aabbMin[axis]) || (origin[axis] > box.aabbMax[axis])) {
+                    return NO_HIT;
+                }
+                continue;
+            }
+            const float t1 = (box.aabbMin[axis] - origin[axis]) / dir[axis];
+            const float t2 = (box.aabbMax[axis] - origin[axis]) / dir[axis];
+            tEnter = std::max(tEnter, std::min(t1, t2));
+            tExit = std::min(tExit, std::max(t1, t2));
+        }
+        return (tEnter <= tExit) ? tEnter : NO_HIT;
+    }
+}
+
+// ========================================================================
+// SECTION 1: TEST
+// ========================================================================
+
+/**
+ * @brief Ray casts every buffer pixel against the occluders once per view, then checks each query box.
+ */
+std::vector<OcclusionTestResult> OcclusionTest::run() {
+    // A wall, a pillar, a floor slab and a block in front of them, plus a one-sided sign that
+    // the "back" view sees from behind (a culler writing back faces would hide boxes through it)
+    static const std::array<TestOccluder, 5> occluders = { {
+        { glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.2f, 0.8f, 0.1f), false },
+        { glm::vec3(1.8f, 0.0f, -1.0f), glm::vec3(0.2f, 1.0f, 0.2f), false },
+        { glm::vec3(0.0f, -1.2f, -1.0f), glm::vec3(3.0f, 0.1f, 3.0f), false },
+        { glm::vec3(-1.5f, 0.3f, 1.0f), glm::vec3(0.3f, 0.3f, 0.3f), false },
+        { glm::vec3(-2.2f, 0.5f, -1.5f), glm::vec3(0.6f, 0.4f, 1.0f), true }
+    } };
+    static const std::array<TestView, 7> views = { {
+        { "front", glm::vec3(0.0f, 0.3f, 5.0f), false },
+        { "left", glm::vec3(-4.0f, 1.0f, 3.0f), false },
+        { "right", glm::vec3(4.0f, 0.5f, 3.5f), false },
+        { "high", glm::vec3(0.0f, 4.0f, 4.0f), false },
+        { "close", glm::vec3(0.2f, 0.0f, 1.2f), false },
+        { "back", glm::vec3(-1.0f, 0.5f, -6.0f), false },
+        { "ortho", glm::vec3(0.0f, 0.5f, 6.0f), true }
+    } };
+
+    // Step 1: Occluders, registered with the culler and kept as world triangles for the ray cast
+    OcclusionCuller culler;
+    std::vector<WorldTriangle> worldTriangles{};
+    for (const TestOccluder& occluder : occluders) {
+        const OBJLoader::MeshData data = buildMesh(occluder.singleQuad);
+        const glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), occluder.center), occluder.halfExtent);
+        culler.addOccluder(data, model);
+        for (size_t i = 0U; (i + 2U) < data.indices.size(); i += OcclusionCuller::TRI_VERT_COUNT) {
+            worldTriangles.push_back({ glm::vec3(model * glm::vec4(data.vertices[data.indices[i]].position, 1.0f)),
+                glm::vec3(model * glm::vec4(data.vertices[data.indices[i + 1U]].position, 1.0f)),
+                glm::vec3(model * glm::vec4(data.vertices[data.indices[i + 2U]].position, 1.0f)) });
+        }
+    }
+
+    // Step 2: Seeded query boxes around and behind the occluders
+    std::mt19937 rng(RANDOM_SEED);
+    std::uniform_real_distribution<float> rndX(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> rndY(-1.0f, 1.5f);
+    std::uniform_real_distribution<float> rndZ(-4.0f, 2.0f);
+    std::uniform_real_distribution<float> rndHalf(0.05f, 0.4f);
+    std::vector<BoundingVolume> queries(QUERY_BOX_COUNT);
+    for (BoundingVolume& query : queries) {
+        const glm::vec3 center(rndX(rng), rndY(rng), rndZ(rng));
+        const glm::vec3 half(rndHalf(rng), rndHalf(rng), rndHalf(rng));
+        query.aabbMin = center - half;
+        query.aabbMax = center + half;
+        query.sphereCenter = center;
+        query.sphereRadius = glm::length(half);
+        query.valid = true;
+    }
+
+    const float aspect = static_cast<float>(OcclusionCuller::BUFFER_WIDTH) / static_cast<float>(OcclusionCuller::BUFFER_HEIGHT);
+    const size_t pixelCount = static_cast<size_t>(OcclusionCuller::BUFFER_WIDTH) * OcclusionCuller::BUFFER_HEIGHT;
+    std::vector<glm::vec3> rayOrigins(pixelCount);
+    std::vector<glm::vec3> rayDirs(pixelCount);
+    std::vector<float> occluderHit(pixelCount);
+
+    std::vector<OcclusionTestResult> results{};
+    for (const TestView& view : views) {
+        // Step 3: The camera, Y-flipped like the scene's projection
+        glm::mat4 proj = view.orthographic
+            ? glm::ortho(-ORTHO_HALF_HEIGHT * aspect, ORTHO_HALF_HEIGHT * aspect, -ORTHO_HALF_HEIGHT, ORTHO_HALF_HEIGHT, NEAR_PLANE, FAR_PLANE)
+            : glm::perspective(glm::radians(FOV_DEGREES), aspect, NEAR_PLANE, FAR_PLANE);
+        proj[1][1] *= -1.0f;
+        const glm::mat4 viewProj = proj * glm::lookAt(view.eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        culler.rasterize(viewProj);
+
+        // Step 4: One near-to-far segment per pixel centre, and the nearest front-facing occluder on it
+        const glm::mat4 invViewProj = glm::inverse(viewProj);
+        for (uint32_t y = 0U; y < OcclusionCuller::BUFFER_HEIGHT; ++y) {
+            for (uint32_t x = 0U; x < OcclusionCuller::BUFFER_WIDTH; ++x) {
+                const float ndcX = (((static_cast<float>(x) + 0.5f) / static_cast<float>(OcclusionCuller::BUFFER_WIDTH)) * 2.0f) - 1.0f;
+                const float ndcY = (((static_cast<float>(y) + 0.5f) / static_cast<float>(OcclusionCuller::BUFFER_HEIGHT)) * 2.0f) - 1.0f;
+                const glm::vec4 nearPoint = invViewProj * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+                const glm::vec4 farPoint = invViewProj * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+                const size_t pixel = (static_cast<size_t>(y) * OcclusionCuller::BUFFER_WIDTH) + x;
+                rayOrigins[pixel] = glm::vec3(nearPoint) / nearPoint.w;
+                rayDirs[pixel] = (glm::vec3(farPoint) / farPoint.w) - rayOrigins[pixel];
+
+                float nearest = NO_HIT;
+                for (const WorldTriangle& tri : worldTriangles) {
+                    const glm::vec3 normal = glm::cross(tri.v1 - tri.v0, tri.v2 - tri.v0);
+                    if (glm::dot(normal, rayDirs[pixel]) >= 0.0f) {
+                        continue;   // Back face: culled by the scene pipelines, so it hides nothing
+                    }
+                    nearest = std::min(nearest, intersectTriangle(rayOrigins[pixel], rayDirs[pixel], tri));
+                }
+                occluderHit[pixel] = nearest;
+            }
+        }
+
+        // Step 5: A box is visible if any pixel ray reaches it before the occluders; boxes no ray touches are skipped
+        OcclusionTestResult result{};
+        result.view = view.name;
+        result.triangles = culler.getRasterizedTriangleCount();
+        for (const BoundingVolume& query : queries) {
+            bool covered = false;
+            bool visible = false;
+            for (size_t pixel = 0U; (pixel < pixelCount) && !visible; ++pixel) {
+                const float boxHit = intersectBox(rayOrigins[pixel], rayDirs[pixel], query);
+                if (boxHit < NO_HIT) {
+                    covered = true;
+                    visible = (boxHit < occluderHit[pixel]);
+                }
+            }
+            if (!covered) {
+                continue;
+            }
+
+            const bool culled = !culler.isVisible(query);
+            ++result.boxes;
+            result.hidden += visible ? 0U : 1U;
+            result.culled += culled ? 1U : 0U;
+            result.falseCulls += (culled && visible) ? 1U : 0U;
+            result.conservative += (!culled && !visible) ? 1U : 0U;
+        }
+
+        // Step 6: No false culls, and the view must actually cull something to prove anything
+        result.passed = (result.falseCulls == 0U) && (result.culled > 0U);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+// ========================================================================
+// SECTION 2: REPORTING
+// ========================================================================
+
+/**
+ * @brief Prints the results in view order.
+ */
+bool OcclusionTest::report(std::ostream& out, const std::vector<OcclusionTestResult>& results) {
+    bool passed = !results.empty();
+    for (const OcclusionTestResult& result : results) {
+        out << "OcclusionTest: " << std::left << std::setw(5) << result.view << std::right
+            << " | " << (result.passed ? "PASS" : "FAIL")
+            << " | " << result.boxes << " boxes on screen, " << result.hidden << " hidden by ray cast"
+            << " | " << result.culled << " culled, " << result.falseCulls << " false culls, "
+            << result.conservative << " hidden but kept"
+            << " | " << result.triangles << " occluder triangles" << std::endl;
+        passed = passed && result.passed;
+    }
+    return passed;
+}
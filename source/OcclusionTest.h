@@ -0,0 +1,56 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @struct OcclusionTestResult
+ * @brief Agreement of OcclusionCuller::isVisible() and the per-pixel ray cast over one view.
+ * A false cull (a box the culler rejects although some pixel of it is in front of every occluder)
+ * fails the view; a box the culler keeps although every pixel is hidden is only counted.
+ */
+struct OcclusionTestResult final {
+    std::string view{ "" };
+    uint32_t boxes{ 0U };
+    uint32_t hidden{ 0U };        /**< Boxes the ray cast finds behind the occluders at every pixel. */
+    uint32_t culled{ 0U };        /**< Boxes isVisible() rejected. */
+    uint32_t falseCulls{ 0U };    /**< Culled, but at least one pixel of the box is visible. */
+    uint32_t conservative{ 0U };  /**< Hidden, but kept by isVisible() (allowed). */
+    uint32_t triangles{ 0U };     /**< Occluder triangles the culler rasterized. */
+    bool passed{ false };
+};
+
+/**
+ * @class OcclusionTest
+ * @brief Checks OcclusionCuller against a brute-force ray cast of the same occluders (--test-occlusion).
+ * * A fixed scene of closed, outward-wound boxes is added as occluders and rasterized from several
+ * views. For every pixel centre of the culler's buffer a ray is cast against the front faces of
+ * the occluders; a query box is visible when one of those rays reaches the box before any occluder.
+ * Each seeded query box is then compared with isVisible().
+ * * Only plain CPU code runs: no window, device or shader is created, so the test runs anywhere.
+ */
+class OcclusionTest final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t QUERY_BOX_COUNT = 400U;
+    static constexpr uint32_t RANDOM_SEED = 1234U;
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+    static constexpr float EDGE_EPSILON = 1.0e-4f;   /**< Ray-triangle hits grazing an edge count as hits (errs towards hidden). */
+
+    /** @brief Rasterizes the test scene from every view and compares each query box. */
+    static std::vector<OcclusionTestResult> run();
+
+    /** @brief Writes one line per view; returns true if every view passed. */
+    static bool report(std::ostream& out, const std::vector<OcclusionTestResult>& results);
+
+private:
+    // Static utility class: Constructor and Destructor are private to prevent instantiation.
+    OcclusionTest() = default;
+    ~OcclusionTest() = default;
+};
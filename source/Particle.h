@@ -2,8 +2,34 @@
 
 /* parasoft-begin-suppress ALL */
 #include "libs.h"
+#include <cstdint>
 /* parasoft-end-suppress ALL */
 
+/**
+ * @enum ParticleLayout
+ * @brief Storage layout of a particle system's buffer (see shaders/particle_layout.glsl).
+ */
+enum class ParticleLayout : uint32_t {
+    Interleaved = 0U,     /**< One 48-byte Particle per element; colour is simulated and fetched. */
+    CompressedSoA = 1U    /**< Separate position, life/size and velocity streams; colour is derived from life. */
+};
+
+/**
+ * @namespace CompressedParticle
+ * @brief Per-particle strides of the streams of ParticleLayout::CompressedSoA (24 bytes in total).
+ */
+namespace CompressedParticle {
+    static constexpr uint32_t STREAM_COUNT = 3U;
+    static constexpr uint32_t STREAM_POSITION = 0U;    /**< float3 */
+    static constexpr uint32_t STREAM_LIFE_SIZE = 1U;   /**< half2: x = life, y = point size */
+    static constexpr uint32_t STREAM_VELOCITY = 2U;    /**< half3, padded to 8 bytes */
+
+    static constexpr uint32_t POSITION_STRIDE = 3U * static_cast<uint32_t>(sizeof(float));
+    static constexpr uint32_t LIFE_SIZE_STRIDE = static_cast<uint32_t>(sizeof(uint32_t));
+    static constexpr uint32_t VELOCITY_STRIDE = 2U * static_cast<uint32_t>(sizeof(uint32_t));
+    static constexpr uint32_t BYTES_PER_PARTICLE = POSITION_STRIDE + LIFE_SIZE_STRIDE + VELOCITY_STRIDE;
+}
+
 /**
  * @enum Particle
  * @brief Represents a single GPU-managed particle.
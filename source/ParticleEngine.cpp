@@ -0,0 +1,692 @@
+#include "ParticleEngine.h"
+
+/* parasoft-begin-suppress ALL */
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <utility>
+/* parasoft-end-suppress ALL */
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Lays out the shared pool and creates the unified simulation and draw.
+ */
+ParticleEngine::ParticleEngine(
+    VulkanContext* const inContext,
+    const VkRenderPass renderPass,
+    const VkDescriptorSetLayout inGlobalSetLayout,
+    const std::vector<EmitterDefinition>& definitions,
+    const VkSampleCountFlagBits inMsaa,
+    const uint32_t inFramesInFlight,
+    PipelineBuildQueue* const buildQueue)
+    : context(inContext),
+    globalSetLayout(inGlobalSetLayout),
+    msaaSamples(inMsaa),
+    framesInFlight(std::max(inFramesInFlight, EngineConstants::COUNT_ONE))
+{
+    if (definitions.empty()) {
+        throw std::runtime_error("ParticleEngine: No emitters to simulate!");
+    }
+
+    // Step 0: One workgroup size for every emitter, within what the device can launch
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+    const uint32_t maxGroupSize = std::min(props.limits.maxComputeWorkGroupSize[0], props.limits.maxComputeWorkGroupInvocations);
+    workgroupSize = std::clamp(workgroupSize, EngineConstants::COUNT_ONE, maxGroupSize);
+
+    // Step 1: Pool ranges, buffers and descriptors stay on this thread
+    layoutPool(definitions);
+    createBuffers();
+    createComputeDescriptors();
+    createGraphicsPipelineLayout();
+
+    // Step 2: Pipelines only create device objects and may be compiled on the build queue's workers
+    // The unified path is optional: a failure is logged and leaves the engine not ready.
+    const auto buildCompute = [this]() {
+        try {
+            createComputePipeline(COMP_SHADER);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleEngine: Unified simulation unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+    const auto buildDraw = [this, renderPass]() {
+        try {
+            graphicsPipeline = ParticleSystem::buildPointPipeline(context, graphicsPipelineLayout, renderPass,
+                VERT_SHADER, FRAG_SHADER, ParticleLayout::Interleaved, msaaSamples, false);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleEngine: Unified draw unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(COMP_SHADER, buildCompute);
+        buildQueue->submit(FRAG_SHADER, buildDraw);
+    }
+    else {
+        buildCompute();
+        buildDraw();
+    }
+}
+
+/**
+ * @brief Destructor: Releases all GPU pipelines, layouts, and buffers.
+ */
+ParticleEngine::~ParticleEngine() {
+    if ((context != nullptr) && (context->device != VK_NULL_HANDLE)) {
+        vkDestroyPipeline(context->device, computePipeline, nullptr);
+        vkDestroyPipelineLayout(context->device, computePipelineLayout, nullptr);
+        vkDestroyDescriptorPool(context->device, computeDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(context->device, computeSetLayout, nullptr);
+
+        vkDestroyPipeline(context->device, graphicsPipeline, nullptr);
+        vkDestroyPipeline(context->device, oitPipeline, nullptr);
+        vkDestroyPipelineLayout(context->device, graphicsPipelineLayout, nullptr);
+
+        vkDestroyPipeline(context->device, selectPipeline, nullptr);
+        vkDestroyPipelineLayout(context->device, selectPipelineLayout, nullptr);
+        vkDestroyDescriptorPool(context->device, selectDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(context->device, selectSetLayout, nullptr);
+        vkDestroyBuffer(context->device, sparkBuffer, nullptr);
+        vkFreeMemory(context->device, sparkBufferMemory, nullptr);
+
+        if (readbackMapped != nullptr) {
+            vkUnmapMemory(context->device, readbackMemory);
+            readbackMapped = nullptr;
+        }
+        vkDestroyBuffer(context->device, readbackBuffer, nullptr);
+        vkFreeMemory(context->device, readbackMemory, nullptr);
+
+        if (paramMapped != nullptr) {
+            vkUnmapMemory(context->device, paramMemory);
+            paramMapped = nullptr;
+        }
+        vkDestroyBuffer(context->device, paramBuffer, nullptr);
+        vkFreeMemory(context->device, paramMemory, nullptr);
+
+        vkDestroyBuffer(context->device, poolBuffer, nullptr);
+        vkFreeMemory(context->device, poolMemory, nullptr);
+        vkDestroyBuffer(context->device, slotBuffer, nullptr);
+        vkFreeMemory(context->device, slotMemory, nullptr);
+        vkDestroyBuffer(context->device, drawCommandBuffer, nullptr);
+        vkFreeMemory(context->device, drawCommandMemory, nullptr);
+        vkDestroyBuffer(context->device, indexBuffer, nullptr);
+        vkFreeMemory(context->device, indexMemory, nullptr);
+    }
+}
+
+/**
+ * @brief Returns true if the device exposes the features the multi-draw depends on.
+ * Multi-draw is needed for more than one command per call; firstInstance carries the effect id.
+ */
+bool ParticleEngine::isSupported(const VulkanContext* const ctx) {
+    return (ctx != nullptr) && ctx->multiDrawIndirect && ctx->drawIndirectFirstInstance;
+}
+
+/**
+ * @brief Builds the weighted OIT draw pipeline; a missing shader only disables OIT for the unified path.
+ */
+void ParticleEngine::createOitPipeline(const VkRenderPass oitRenderPass, const std::string& oitFragPath,
+    PipelineBuildQueue* const buildQueue)
+{
+    const auto build = [this, oitRenderPass, oitFragPath]() {
+        try {
+            oitPipeline = ParticleSystem::buildPointPipeline(context, graphicsPipelineLayout, oitRenderPass,
+                VERT_SHADER, oitFragPath, ParticleLayout::Interleaved, msaaSamples, true);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleEngine: Weighted OIT variant unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(oitFragPath, build);
+    }
+    else {
+        build();
+    }
+}
+
+// ========================================================================
+// SECTION 2: SIMULATION & RENDERING
+// ========================================================================
+
+/**
+ * @brief Writes the frame's parameter slot and records the single simulation dispatch.
+ * The host-coherent slot was last read by the submission this frame's fence waited on.
+ */
+void ParticleEngine::update(const VkCommandBuffer commandBuffer, const uint32_t frameIndex, const float deltaTime,
+    const float totalTime, const glm::vec3& lightColor, const std::vector<EmitterState>& states, const VkDescriptorSet sceneSet)
+{
+    // Step 1: One parameter block per emitter, in pool order
+    const uint32_t slot = frameIndex % framesInFlight;
+    EmitterParams* const params = reinterpret_cast<EmitterParams*>(static_cast<uint8_t*>(paramMapped) + (paramStride * slot));
+
+    activeParticles = 0U;
+    enabledParticles = 0U;
+    for (size_t i = 0U; i < emitters.size(); ++i) {
+        const Emitter& emitter = emitters[i];
+        const EmitterState state = (emitter.source < states.size()) ? states[emitter.source] : EmitterState{};
+
+        EmitterParams block{};
+        block.emitterPos = state.position;
+        block.spawnRadius = emitter.spawnRadius;
+        block.lightColor = lightColor;
+        block.deltaTime = deltaTime;
+        block.effect = static_cast<uint32_t>(emitter.effect);
+        block.first = emitter.first;
+        block.count = emitter.count;
+        block.spawnBudget = state.enabled ? emitter.spawnBudget : 0U;
+        block.totalTime = totalTime;
+        block.visible = state.enabled ? EngineConstants::COUNT_ONE : 0U;
+        block.activeCount = ParticleLodController::scaleCount(emitter.count, state.activeFraction);
+        params[i] = block;
+        activeParticles += state.enabled ? block.activeCount : 0U;
+        enabledParticles += state.enabled ? emitter.count : 0U;
+
+        if (static_cast<int32_t>(i) == fireEmitter) {
+            lastFirePos = state.position;
+        }
+    }
+
+    // Step 2: The previous frame's draw, spark selection and dispatch finish with the pool before it is rewritten
+    VkMemoryBarrier entryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    entryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    entryBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO),
+        EngineConstants::COUNT_ONE, &entryBarrier, 0U, nullptr, 0U, nullptr);
+
+    // Step 3: One invocation per pool slot (and at least one per emitter, which clear the other command set)
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+    const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { computeDescriptorSet };
+    const uint32_t dynamicOffset = static_cast<uint32_t>(paramStride * slot);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
+        EngineConstants::INDEX_ZERO, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::COUNT_ONE, &dynamicOffset);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
+        SET_INDEX_SCENE, DESCRIPTOR_COUNT_ONE, &sceneSet, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U,
+        static_cast<uint32_t>(sizeof(uint32_t)), &commandSet);
+
+    const uint32_t invocations = std::max(poolSize, getEmitterCount());
+    vkCmdDispatch(commandBuffer, (invocations + workgroupSize - 1U) / workgroupSize, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+
+    // Step 4: Particles -> vertex fetch; survivors -> index fetch; commands -> the multi-draw; pool -> spark selection
+    VkMemoryBarrier drawBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    drawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    drawBarrier.dstAccessMask = (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        (VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &drawBarrier, 0U, nullptr, 0U, nullptr);
+
+    drawSet = commandSet;
+    commandSet = EngineConstants::INDEX_ONE - commandSet;
+}
+
+/**
+ * @brief Records one indexed command per emitter in a single multi-draw call.
+ */
+void ParticleEngine::draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet, const bool weightedOIT) const {
+    const VkPipeline pipeline = weightedOIT ? oitPipeline : graphicsPipeline;
+    if (pipeline == VK_NULL_HANDLE) { return; }
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+    const VkBuffer vertexBuffers[EngineConstants::COUNT_ONE] = { poolBuffer };
+    const VkDeviceSize offsets[EngineConstants::COUNT_ONE] = { static_cast<VkDeviceSize>(EngineConstants::OFFSET_ZERO) };
+    vkCmdBindVertexBuffers(commandBuffer, EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, vertexBuffers, offsets);
+
+    const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { globalDescriptorSet };
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout,
+        SET_INDEX_GLOBAL, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
+
+    // Indices are absolute pool slots; each command starts at its emitter's own range
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0ULL, VK_INDEX_TYPE_UINT32);
+    vkCmdDrawIndexedIndirect(commandBuffer, drawCommandBuffer, commandSetOffset(drawSet), getEmitterCount(),
+        static_cast<uint32_t>(sizeof(DrawCommand)));
+}
+
+/**
+ * @brief Creates the reduction output, the readback ring and the selection pipeline over the fire range.
+ * The ring is zeroed so slots that were never written read back as dark lights.
+ */
+void ParticleEngine::enableLightReadback(PipelineBuildQueue* const buildQueue) {
+    if ((readbackBuffer != VK_NULL_HANDLE) || (fireEmitter < 0)) { return; }
+
+    // Step 1: Device-local reduction output, also the source of the per-frame copy
+    const VkDeviceSize sparkSize = SPARK_SAMPLE_SIZE * EngineConstants::MAX_SPARK_LIGHTS;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, sparkSize,
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        sparkBuffer, sparkBufferMemory);
+
+    // Step 2: Persistently mapped ring, one slot per frame in flight
+    const VkDeviceSize ringSize = sparkSize * framesInFlight;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, ringSize,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        readbackBuffer, readbackMemory);
+
+    static_cast<void>(vkMapMemory(context->device, readbackMemory, 0ULL, ringSize, 0U, &readbackMapped));
+    static_cast<void>(std::memset(readbackMapped, 0, static_cast<size_t>(ringSize)));
+
+    createSelectDescriptors();
+
+    // Step 3: The selection pipeline is optional; without it the sparks simply stay dark
+    const std::string selectPath = SELECT_SHADER;
+    const auto build = [this, selectPath]() {
+        try {
+            createSelectPipeline(selectPath);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleEngine: Spark light readback unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(selectPath + " (unified)", build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Records the per-sector selection over the fire range and its copy into the frame's ring slot.
+ * The pool writes are already visible to compute reads through update()'s closing barrier.
+ */
+void ParticleEngine::recordLightReadback(const VkCommandBuffer commandBuffer, const uint32_t frameIndex) const {
+    if ((selectPipeline == VK_NULL_HANDLE) || (readbackMapped == nullptr)) { return; }
+
+    const VkDeviceSize sparkSize = SPARK_SAMPLE_SIZE * EngineConstants::MAX_SPARK_LIGHTS;
+
+    // Step 1: Previous frame's copy -> selection writes
+    VkBufferMemoryBarrier selectBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    selectBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    selectBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    selectBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    selectBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    selectBarrier.buffer = sparkBuffer;
+    selectBarrier.offset = 0ULL;
+    selectBarrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &selectBarrier, 0U, nullptr);
+
+    // Step 2: One workgroup per sector of the fire range
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, selectPipeline);
+    const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { selectDescriptorSet };
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, selectPipelineLayout,
+        EngineConstants::INDEX_ZERO, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdDispatch(commandBuffer, EngineConstants::MAX_SPARK_LIGHTS, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+
+    // Step 3: Selection writes -> copy into the frame's slot
+    VkBufferMemoryBarrier copyBarrier = selectBarrier;
+    copyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &copyBarrier, 0U, nullptr);
+
+    const VkBufferCopy region{ 0ULL, sparkSize * (frameIndex % framesInFlight), sparkSize };
+    vkCmdCopyBuffer(commandBuffer, sparkBuffer, readbackBuffer, EngineConstants::COUNT_ONE, &region);
+
+    // Step 4: Make the copy visible to the host once the frame's fence signals
+    VkBufferMemoryBarrier hostBarrier = selectBarrier;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    hostBarrier.buffer = readbackBuffer;
+    hostBarrier.offset = region.dstOffset;
+    hostBarrier.size = sparkSize;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr);
+}
+
+/**
+ * @brief Converts the frame slot's selected samples into world-space spark lights.
+ */
+std::vector<SparkLight> ParticleEngine::getLightData(const uint32_t frameIndex) const {
+    if (readbackMapped == nullptr) {
+        return std::vector<SparkLight>(EngineConstants::MAX_SPARK_LIGHTS);
+    }
+
+    const size_t slotOffset = static_cast<size_t>(frameIndex % framesInFlight) * EngineConstants::MAX_SPARK_LIGHTS;
+    return ParticleSystem::toSparkLights(static_cast<const glm::vec4*>(readbackMapped) + slotOffset, lastFirePos);
+}
+
+// ========================================================================
+// SECTION 3: INTERNAL INITIALIZATION
+// ========================================================================
+
+/**
+ * @brief Maps an emitter's shader set to the effect branch of the unified shaders.
+ */
+ParticleEngine::Effect ParticleEngine::effectOf(const std::string& shaderSet) {
+    static const std::array<std::pair<const char*, Effect>, EFFECT_COUNT> effects = { {
+        { "dust", Effect::Dust }, { "fire", Effect::Fire }, { "smoke", Effect::Smoke },
+        { "rain", Effect::Rain }, { "snow", Effect::Snow }
+    } };
+
+    for (const auto& entry : effects) {
+        if (shaderSet == entry.first) {
+            return entry.second;
+        }
+    }
+    throw std::runtime_error("ParticleEngine: Shader set '" + shaderSet + "' has no unified effect!");
+}
+
+/**
+ * @brief Orders the emitters by effect and gives each a pool range whose byte offset is storage-aligned,
+ * so a range (the fire one for the spark selection) can be bound on its own.
+ */
+void ParticleEngine::layoutPool(const std::vector<EmitterDefinition>& definitions) {
+    // Step 1: Slot granularity that keeps every range start on the storage offset alignment
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+    const VkDeviceSize alignment = std::max(props.limits.minStorageBufferOffsetAlignment, static_cast<VkDeviceSize>(sizeof(uint32_t)));
+    const VkDeviceSize particleSize = static_cast<VkDeviceSize>(sizeof(Particle));
+    const uint32_t granularity = static_cast<uint32_t>(alignment / std::gcd(alignment, particleSize));
+
+    // Step 2: Stable sort by effect, so draws come grouped per material and ties keep config order
+    for (uint32_t i = 0U; i < static_cast<uint32_t>(definitions.size()); ++i) {
+        const EmitterDefinition& definition = definitions[i];
+        if (definition.count == 0U) {
+            throw std::runtime_error("ParticleEngine: Emitter '" + definition.shaderSet + "' has no particles!");
+        }
+
+        Emitter emitter{};
+        emitter.effect = effectOf(definition.shaderSet);
+        emitter.source = i;
+        emitter.count = definition.count;
+        emitter.spawnBudget = (definition.spawnBudget == 0U) ? definition.count : std::min(definition.spawnBudget, definition.count);
+        emitter.spawnRadius = definition.spawnRadius;
+        emitter.spawnPos = definition.spawnPos;
+        emitters.push_back(emitter);
+    }
+    std::stable_sort(emitters.begin(), emitters.end(),
+        [](const Emitter& a, const Emitter& b) { return a.effect < b.effect; });
+
+    // Step 3: Consecutive aligned ranges; the fire range feeds the spark lights
+    uint32_t next = 0U;
+    for (size_t i = 0U; i < emitters.size(); ++i) {
+        emitters[i].first = ((next + granularity - 1U) / granularity) * granularity;
+        next = emitters[i].first + emitters[i].count;
+        if ((fireEmitter < 0) && (emitters[i].effect == Effect::Fire)) {
+            fireEmitter = static_cast<int32_t>(i);
+        }
+    }
+    poolSize = next;
+}
+
+/**
+ * @brief Creates the pool, slot flags, draw commands, index buffer and the per-frame parameter ring.
+ */
+void ParticleEngine::createBuffers() {
+    // Step 1: Seed every range as the per-system path does; padding slots stay zeroed and dead
+    std::vector<Particle> particles(poolSize);
+    std::vector<uint32_t> slotAlive(poolSize, 0U);
+    const auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    std::default_random_engine rndEngine(static_cast<unsigned>(seed));
+    std::uniform_real_distribution<float> rndLife(0.0f, 1.0f);
+
+    for (const Emitter& emitter : emitters) {
+        for (uint32_t i = emitter.first; i < (emitter.first + emitter.count); ++i) {
+            const float initialYOffset = rndLife(rndEngine) * 0.2f;
+            particles[i].position = glm::vec4(emitter.spawnPos.x, emitter.spawnPos.y + initialYOffset, emitter.spawnPos.z, 2.0f);
+            particles[i].velocity = glm::vec4(0.0f, 0.0f, 0.0f, rndLife(rndEngine));
+            particles[i].color = glm::vec4(1.0f);
+            slotAlive[i] = EngineConstants::COUNT_ONE;
+        }
+    }
+
+    uploadDeviceLocal(particles.data(), static_cast<VkDeviceSize>(particles.size() * sizeof(Particle)),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT), poolBuffer, poolMemory);
+    uploadDeviceLocal(slotAlive.data(), static_cast<VkDeviceSize>(slotAlive.size() * sizeof(uint32_t)),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, slotBuffer, slotMemory);
+
+    // Step 2: Both command sets start empty; the static fields never change afterwards
+    std::vector<DrawCommand> commands(static_cast<size_t>(COMMAND_SETS) * emitters.size());
+    for (size_t i = 0U; i < commands.size(); ++i) {
+        const Emitter& emitter = emitters[i % emitters.size()];
+        commands[i] = DrawCommand{};
+        commands[i].draw.instanceCount = EngineConstants::COUNT_ONE;
+        commands[i].draw.firstIndex = emitter.first;
+        commands[i].draw.firstInstance = static_cast<uint32_t>(emitter.effect);
+    }
+    uploadDeviceLocal(commands.data(), static_cast<VkDeviceSize>(commands.size() * sizeof(DrawCommand)),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT), drawCommandBuffer, drawCommandMemory);
+
+    // Step 3: Survivor indices are written before they are read, so no initial contents
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, static_cast<VkDeviceSize>(sizeof(uint32_t)) * poolSize,
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        indexBuffer, indexMemory);
+
+    // Step 4: Parameter ring; each frame's slot starts on the storage offset alignment (dynamic offset)
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+    const VkDeviceSize alignment = std::max(props.limits.minStorageBufferOffsetAlignment, static_cast<VkDeviceSize>(sizeof(uint32_t)));
+    const VkDeviceSize blockSize = static_cast<VkDeviceSize>(sizeof(EmitterParams)) * emitters.size();
+    paramStride = ((blockSize + alignment - 1ULL) / alignment) * alignment;
+
+    const VkDeviceSize ringSize = paramStride * framesInFlight;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, ringSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        paramBuffer, paramMemory);
+
+    static_cast<void>(vkMapMemory(context->device, paramMemory, 0ULL, ringSize, 0U, &paramMapped));
+    static_cast<void>(std::memset(paramMapped, 0, static_cast<size_t>(ringSize)));
+}
+
+/**
+ * @brief Creates a device-local buffer (usage plus transfer destination) filled through the graphics queue.
+ */
+void ParticleEngine::uploadDeviceLocal(const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+    VkBuffer& buffer, VkDeviceMemory& memory) const
+{
+    VulkanUtils::createDeviceLocalBuffer(context->device, context->physicalDevice, context->graphicsCommandPool,
+        context->graphicsQueue, data, size, usage, buffer, memory);
+}
+
+void ParticleEngine::createComputeDescriptors() {
+    // The parameter ring (dynamic offset per frame), then the pool, slot flags, draw commands and indices
+    const std::array<VkDescriptorSetLayoutBinding, 5> bindings = {
+        VkDescriptorSetLayoutBinding{ BINDING_PARAMS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_POOL, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_SLOTS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_COMMANDS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_INDICES, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    static_cast<void>(vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &computeSetLayout));
+
+    const std::array<VkDescriptorPoolSize, 2> poolSizes = {
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1U },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4U }
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    poolInfo.maxSets = 1U;
+    static_cast<void>(vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &computeDescriptorPool));
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = computeDescriptorPool;
+    allocInfo.descriptorSetCount = 1U;
+    allocInfo.pSetLayouts = &computeSetLayout;
+    static_cast<void>(vkAllocateDescriptorSets(context->device, &allocInfo, &computeDescriptorSet));
+
+    const std::array<VkDescriptorBufferInfo, 5> infos = {
+        VkDescriptorBufferInfo{ paramBuffer, 0ULL, static_cast<VkDeviceSize>(sizeof(EmitterParams)) * emitters.size() },
+        VkDescriptorBufferInfo{ poolBuffer, 0ULL, VK_WHOLE_SIZE },
+        VkDescriptorBufferInfo{ slotBuffer, 0ULL, VK_WHOLE_SIZE },
+        VkDescriptorBufferInfo{ drawCommandBuffer, 0ULL, VK_WHOLE_SIZE },
+        VkDescriptorBufferInfo{ indexBuffer, 0ULL, VK_WHOLE_SIZE }
+    };
+
+    std::array<VkWriteDescriptorSet, 5> writes{};
+    for (uint32_t i = 0U; i < static_cast<uint32_t>(writes.size()); ++i) {
+        writes[i] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, computeDescriptorSet, bindings[i].binding, 0U, 1U,
+            bindings[i].descriptorType, nullptr, &infos[i], nullptr };
+    }
+
+    vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+}
+
+/**
+ * @brief Builds the unified simulation, specialized for the workgroup size, pool size and emitter count.
+ */
+void ParticleEngine::createComputePipeline(const std::string& path) {
+    const ShaderModule compShader(context, path, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    const ComputeSpecialization specData{ workgroupSize, poolSize, getEmitterCount() };
+    const std::array<VkSpecializationMapEntry, 3> specEntries = {
+        VkSpecializationMapEntry{ 0U, offsetof(ComputeSpecialization, workgroupSize), sizeof(uint32_t) },
+        VkSpecializationMapEntry{ 1U, offsetof(ComputeSpecialization, capacity), sizeof(uint32_t) },
+        VkSpecializationMapEntry{ 2U, offsetof(ComputeSpecialization, emitterCount), sizeof(uint32_t) }
+    };
+
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = static_cast<uint32_t>(specEntries.size());
+    specInfo.pMapEntries = specEntries.data();
+    specInfo.dataSize = sizeof(ComputeSpecialization);
+    specInfo.pData = &specData;
+
+    // The push block selects the command set this frame fills
+    const VkPushConstantRange pushRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0U, static_cast<uint32_t>(sizeof(uint32_t)) };
+
+    // Set 0: the pool and its state; Set 1: the global scene set (rain and snow collision, snow cover)
+    const std::array<VkDescriptorSetLayout, 2> setLayouts = { computeSetLayout, globalSetLayout };
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = 1U;
+    layoutInfo.pPushConstantRanges = &pushRange;
+    static_cast<void>(vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &computePipelineLayout));
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = compShader.getStageInfo();
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
+    pipelineInfo.layout = computePipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(1U, &pipelineInfo, &computePipeline) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleEngine: Failed to create compute pipeline!");
+    }
+}
+
+/**
+ * @brief Creates the draw layout (the global descriptor set) shared by both draw pipelines.
+ */
+void ParticleEngine::createGraphicsPipelineLayout() {
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipelineLayoutInfo.setLayoutCount = 1U;
+    pipelineLayoutInfo.pSetLayouts = &globalSetLayout;
+
+    if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &graphicsPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleEngine: Failed to create graphics pipeline layout!");
+    }
+}
+
+/**
+ * @brief Creates the selection set: the per-sector output and the fire emitter's range of the pool.
+ */
+void ParticleEngine::createSelectDescriptors() {
+    const std::array<VkDescriptorSetLayoutBinding, 2> bindings = {
+        VkDescriptorSetLayoutBinding{ 0U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_POOL, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    static_cast<void>(vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &selectSetLayout));
+
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(bindings.size()) };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = 1U;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 1U;
+    static_cast<void>(vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &selectDescriptorPool));
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = selectDescriptorPool;
+    allocInfo.descriptorSetCount = 1U;
+    allocInfo.pSetLayouts = &selectSetLayout;
+    static_cast<void>(vkAllocateDescriptorSets(context->device, &allocInfo, &selectDescriptorSet));
+
+    // The range starts on the storage offset alignment (see layoutPool), so the shader indexes it from zero
+    const Emitter& fire = emitters[static_cast<size_t>(fireEmitter)];
+    const VkDeviceSize particleSize = static_cast<VkDeviceSize>(sizeof(Particle));
+    const VkDescriptorBufferInfo sparkInfo{ sparkBuffer, 0ULL, VK_WHOLE_SIZE };
+    const VkDescriptorBufferInfo fireInfo{ poolBuffer, particleSize * fire.first, particleSize * fire.count };
+
+    const std::array<VkWriteDescriptorSet, 2> writes = {
+        VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, selectDescriptorSet, 0U, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &sparkInfo, nullptr },
+        VkWriteDescriptorSet{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, selectDescriptorSet, BINDING_POOL, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &fireInfo, nullptr }
+    };
+
+    vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+}
+
+/**
+ * @brief Builds the selection pipeline, specialized for its workgroup size and the fire emitter's count.
+ */
+void ParticleEngine::createSelectPipeline(const std::string& path) {
+    const ShaderModule compShader(context, path, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    const std::array<uint32_t, 2> specData = {
+        std::min(SELECT_WORKGROUP_SIZE, workgroupSize), emitters[static_cast<size_t>(fireEmitter)].count
+    };
+    const std::array<VkSpecializationMapEntry, 2> specEntries = {
+        VkSpecializationMapEntry{ 0U, 0U, sizeof(uint32_t) },
+        VkSpecializationMapEntry{ 1U, static_cast<uint32_t>(sizeof(uint32_t)), sizeof(uint32_t) }
+    };
+
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = static_cast<uint32_t>(specEntries.size());
+    specInfo.pMapEntries = specEntries.data();
+    specInfo.dataSize = sizeof(specData);
+    specInfo.pData = specData.data();
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = 1U;
+    layoutInfo.pSetLayouts = &selectSetLayout;
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &selectPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleEngine: Failed to create spark selection pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = compShader.getStageInfo();
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
+    pipelineInfo.layout = selectPipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(1U, &pipelineInfo, &selectPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleEngine: Failed to create spark selection pipeline!");
+    }
+}
+
+/**
+ * @brief Returns the byte offset of a command set in the draw command buffer.
+ */
+VkDeviceSize ParticleEngine::commandSetOffset(const uint32_t set) const {
+    return static_cast<VkDeviceSize>(sizeof(DrawCommand)) * emitters.size() * set;
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <string>
+#include <vector>
+#include "libs.h"
+/* parasoft-end-suppress ALL */
+
+#include "VulkanUtils.h"
+#include "Particle.h"
+#include "ParticleSystem.h"
+#include "CommonStructs.h"
+#include "VulkanContext.h"
+#include "PipelineBuildQueue.h"
+
+/**
+ * @class ParticleEngine
+ * @brief Simulates and draws every particle emitter from one shared pool (the unified particle path).
+ * * The per-system path records three dispatches and four barriers per ParticleSystem and one draw
+ * each. Here all emitters live in one interleaved particle buffer, each in a contiguous slot range
+ * whose byte offset meets the device's storage offset alignment, and their parameters are written
+ * into one storage block per frame. A single dispatch (shaders/particle_unified.comp) branches on
+ * each slot's emitter to emit, simulate and compact it, a single barrier hands the results to the
+ * draw, and one multi-draw indirect call issues one indexed command per emitter.
+ * * Emitters are ordered by effect, so the commands of the multi-draw come sorted per material; the
+ * effect id travels in each command's firstInstance and selects the shading in the shaders. This
+ * needs multiDrawIndirect and drawIndirectFirstInstance (the IndirectDrawSystem requirements).
+ * * The pool is always interleaved and drawn in buffer order: the compressed layout and the depth sort
+ * stay features of the per-system path.
+ */
+class ParticleEngine final {
+public:
+    /**
+     * @enum Effect
+     * @brief Simulation and shading branch of an emitter (EFFECT_* of shaders/particle_effects.glsl).
+     */
+    enum class Effect : uint32_t {
+        Dust = 0U,
+        Fire = 1U,
+        Smoke = 2U,
+        Rain = 3U,
+        Snow = 4U
+    };
+
+    /**
+     * @struct EmitterState
+     * @brief Per-frame input of one emitter: whether it is shown, where it emits from and the share of
+     * its slots that may hold live particles (particle LOD).
+     */
+    struct EmitterState {
+        bool enabled{ false };
+        glm::vec3 position{ 0.0f, 0.0f, 0.0f };
+        float activeFraction{ 1.0f };
+    };
+
+    // --- Named Constants ---
+    static constexpr uint32_t EFFECT_COUNT = 5U;
+    static constexpr uint32_t UPDATE_DISPATCHES = 1U;   /**< Dispatches one update() records. */
+    static constexpr uint32_t UPDATE_BARRIERS = 2U;     /**< Pipeline barriers one update() records (previous draw -> dispatch -> draw). */
+
+    // --- Lifecycle ---
+
+    /**
+     * @brief Creates the pool, parameter ring and draw commands for the given emitters, and their pipelines.
+     * Each definition's shader set names its effect ("dust", "fire", "smoke", "rain" or "snow"); throws
+     * on any other set or on an emitter without particles. With a build queue both pipelines are
+     * compiled when the queue is executed; a pipeline that fails is logged and leaves isReady() false.
+     */
+    explicit ParticleEngine(
+        VulkanContext* const inContext,
+        const VkRenderPass renderPass,
+        const VkDescriptorSetLayout inGlobalSetLayout,
+        const std::vector<EmitterDefinition>& definitions,
+        const VkSampleCountFlagBits inMsaa,
+        const uint32_t inFramesInFlight,
+        PipelineBuildQueue* const buildQueue = nullptr
+    );
+
+    /** @brief Destructor: Releases all compute and graphics GPU resources. */
+    ~ParticleEngine();
+
+    // RAII: Prevent duplication of GPU handles and mapped memory to maintain ownership.
+    ParticleEngine(const ParticleEngine&) = delete;
+    ParticleEngine& operator=(const ParticleEngine&) = delete;
+
+    /** @brief Returns true if the device exposes the features the multi-draw depends on. */
+    static bool isSupported(const VulkanContext* const ctx);
+
+    /** @brief Returns true once the simulation and draw pipelines exist. */
+    bool isReady() const { return (computePipeline != VK_NULL_HANDLE) && (graphicsPipeline != VK_NULL_HANDLE); }
+
+    /**
+     * @brief Builds the weighted OIT variant of the draw pipeline against the OIT accumulation pass.
+     * Optional: if the shader cannot be loaded the failure is logged and only the ordered-blend pipeline exists.
+     */
+    void createOitPipeline(const VkRenderPass oitRenderPass, const std::string& oitFragPath, PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Returns true if the OIT variant was built. */
+    bool hasOitPipeline() const { return oitPipeline != VK_NULL_HANDLE; }
+
+    // --- Core Execution ---
+
+    /**
+     * @brief Writes the frame's emitter parameters and records the dispatch and its barriers.
+     * States are given in the order of the definitions passed to the constructor. A disabled emitter
+     * stops emitting and its live particles are dropped. Record outside of an active RenderPass.
+     * sceneSet is the global set, bound as Set 1 for the wind field, the rain and snow collision and the snow cover.
+     */
+    void update(const VkCommandBuffer commandBuffer, const uint32_t frameIndex, const float deltaTime, const float totalTime,
+        const glm::vec3& lightColor, const std::vector<EmitterState>& states, const VkDescriptorSet sceneSet);
+
+    /**
+     * @brief Records the multi-draw of every emitter's survivors, from the commands the last update() filled.
+     * With weightedOIT the OIT variant is used (inside the OIT accumulation pass); it is a no-op if unavailable.
+     */
+    void draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet, const bool weightedOIT = false) const;
+
+    // --- Spark Light Readback (first fire emitter) ---
+
+    /**
+     * @brief Creates the spark-light reduction over the fire emitter's range and its per-frame readback ring.
+     * Optional: without a fire emitter nothing is created; if the selection shader cannot be loaded the
+     * failure is logged and the sparks stay dark.
+     */
+    void enableLightReadback(PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Records the reduction and the copy into the frame's readback slot. Record after update(). */
+    void recordLightReadback(const VkCommandBuffer commandBuffer, const uint32_t frameIndex) const;
+
+    /** @brief Returns the spark lights the frame slot's previous submission selected (see ParticleSystem::getLightData). */
+    std::vector<SparkLight> getLightData(const uint32_t frameIndex) const;
+
+    /** @brief Returns the slots the last update() let hold live particles, summed over the enabled emitters. */
+    uint32_t getActiveParticles() const { return activeParticles; }
+
+    /** @brief Returns the slots of the emitters the last update() enabled, whatever their LOD. */
+    uint32_t getEnabledParticles() const { return enabledParticles; }
+
+    /** @brief Returns the number of emitters sharing the pool. */
+    uint32_t getEmitterCount() const { return static_cast<uint32_t>(emitters.size()); }
+
+    /** @brief Returns the pool slots, including the padding that aligns the emitter ranges. */
+    uint32_t getPoolSize() const { return poolSize; }
+
+private:
+    /**
+     * @struct EmitterParams
+     * @brief Parameter block of one emitter (EmitterParams of particle_unified.comp, std430, 64 bytes).
+     */
+    struct EmitterParams {
+        glm::vec3 emitterPos;
+        float spawnRadius;
+        glm::vec3 lightColor;
+        float deltaTime;
+        uint32_t effect;
+        uint32_t first;
+        uint32_t count;
+        uint32_t spawnBudget;
+        float totalTime;
+        uint32_t visible;
+        uint32_t activeCount;   /**< Emitter-local slots below which dead slots may emit (LOD). */
+        uint32_t padding1;      /**< Explicit alignment padding. */
+    };
+
+    /**
+     * @struct DrawCommand
+     * @brief Indexed indirect command of one emitter followed by its emission counter (32-byte stride).
+     */
+    struct DrawCommand {
+        VkDrawIndexedIndirectCommand draw;   /**< indexCount doubles as the survivor counter; firstInstance is the effect. */
+        uint32_t emitted;
+        uint32_t padding0;
+        uint32_t padding1;
+    };
+
+    /**
+     * @struct Emitter
+     * @brief An emitter's slot range in the pool and its fixed parameters.
+     */
+    struct Emitter {
+        Effect effect{ Effect::Dust };
+        uint32_t source{ 0U };          /**< Index of the definition (and of its per-frame state). */
+        uint32_t first{ 0U };
+        uint32_t count{ 0U };
+        uint32_t spawnBudget{ 0U };
+        float spawnRadius{ 0.0f };
+        glm::vec3 spawnPos{ 0.0f, 0.0f, 0.0f };
+    };
+
+    /**
+     * @struct ComputeSpecialization
+     * @brief Specialization constants of particle_unified.comp (constant_id 0 to 2).
+     */
+    struct ComputeSpecialization {
+        uint32_t workgroupSize;   /**< local_size_x_id = 0 */
+        uint32_t capacity;        /**< constant_id = 1: pool slots */
+        uint32_t emitterCount;    /**< constant_id = 2 */
+    };
+
+    static_assert(sizeof(EmitterParams) == 64U, "EmitterParams must match the std430 block of particle_unified.comp");
+    static_assert(sizeof(DrawCommand) == 32U, "DrawCommand must match the std430 block of particle_unified.comp");
+
+    // --- Named Constants ---
+    static constexpr uint32_t BINDING_PARAMS = 0U;
+    static constexpr uint32_t BINDING_POOL = 1U;
+    static constexpr uint32_t BINDING_SLOTS = 2U;
+    static constexpr uint32_t BINDING_COMMANDS = 3U;
+    static constexpr uint32_t BINDING_INDICES = 4U;
+    static constexpr uint32_t COMMAND_SETS = 2U;          /**< One filled per frame while the other is cleared. */
+    static constexpr uint32_t SELECT_WORKGROUP_SIZE = 64U;
+    static constexpr VkDeviceSize SPARK_SAMPLE_SIZE = sizeof(glm::vec4);
+    static constexpr uint32_t DESCRIPTOR_COUNT_ONE = 1U;
+    static constexpr uint32_t SET_INDEX_GLOBAL = 0U;
+    static constexpr uint32_t SET_INDEX_SCENE = 1U;   /**< Global set in the simulation layout (after its own set). */
+    static constexpr const char* COMP_SHADER = "./shaders/particle_unified_comp.spv";
+    static constexpr const char* VERT_SHADER = "./shaders/particle_unified_vert.spv";
+    static constexpr const char* FRAG_SHADER = "./shaders/particle_unified_frag.spv";
+    static constexpr const char* SELECT_SHADER = "./shaders/spark_select_comp.spv";
+
+    // --- Core Dependencies ---
+    VulkanContext* context;
+    VkDescriptorSetLayout globalSetLayout;
+    VkSampleCountFlagBits msaaSamples;
+    uint32_t framesInFlight;
+
+    // --- Configuration ---
+    std::vector<Emitter> emitters{};                     /**< Sorted by effect (stable). */
+    uint32_t poolSize{ 0U };
+    uint32_t workgroupSize{ EmitterDefinition::DEFAULT_WORKGROUP_SIZE };
+    uint32_t commandSet{ 0U };                           /**< Set the next update() fills. */
+    uint32_t drawSet{ 0U };                              /**< Set the last update() filled. */
+    int32_t fireEmitter{ -1 };                           /**< Index into emitters of the light source, -1 without one. */
+    glm::vec3 lastFirePos{ 0.0f, 0.0f, 0.0f };
+    uint32_t activeParticles{ 0U };
+    uint32_t enabledParticles{ 0U };
+
+    // --- GPU Storage Resources ---
+    VkBuffer poolBuffer{ VK_NULL_HANDLE };               /**< Interleaved particles, read as vertices by the draw. */
+    VkDeviceMemory poolMemory{ VK_NULL_HANDLE };
+    VkBuffer slotBuffer{ VK_NULL_HANDLE };               /**< One alive flag per slot. */
+    VkDeviceMemory slotMemory{ VK_NULL_HANDLE };
+    VkBuffer drawCommandBuffer{ VK_NULL_HANDLE };        /**< [set 0 | set 1] of DrawCommand, one per emitter. */
+    VkDeviceMemory drawCommandMemory{ VK_NULL_HANDLE };
+    VkBuffer indexBuffer{ VK_NULL_HANDLE };              /**< Survivor slots, within each emitter's range. */
+    VkDeviceMemory indexMemory{ VK_NULL_HANDLE };
+
+    // --- Parameter Ring ---
+    VkBuffer paramBuffer{ VK_NULL_HANDLE };              /**< Host-visible, one aligned slot of EmitterParams per frame in flight. */
+    VkDeviceMemory paramMemory{ VK_NULL_HANDLE };
+    void* paramMapped{ nullptr };
+    VkDeviceSize paramStride{ 0ULL };
+
+    // --- Compute Pipeline State ---
+    VkDescriptorSetLayout computeSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool computeDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet computeDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout computePipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline computePipeline{ VK_NULL_HANDLE };
+
+    // --- Graphics Pipeline State ---
+    VkPipelineLayout graphicsPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline graphicsPipeline{ VK_NULL_HANDLE };
+    VkPipeline oitPipeline{ VK_NULL_HANDLE };
+
+    // --- Spark Light Readback (optional, see enableLightReadback) ---
+    VkDescriptorSetLayout selectSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool selectDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet selectDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout selectPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline selectPipeline{ VK_NULL_HANDLE };
+    VkBuffer sparkBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory sparkBufferMemory{ VK_NULL_HANDLE };
+    VkBuffer readbackBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory readbackMemory{ VK_NULL_HANDLE };
+    void* readbackMapped{ nullptr };
+
+    // --- Internal Initialization Helpers ---
+    static Effect effectOf(const std::string& shaderSet);
+    void layoutPool(const std::vector<EmitterDefinition>& definitions);
+    void createBuffers();
+    void uploadDeviceLocal(const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+        VkBuffer& buffer, VkDeviceMemory& memory) const;
+    void createComputeDescriptors();
+    void createComputePipeline(const std::string& path);
+    void createGraphicsPipelineLayout();
+    void createSelectDescriptors();
+    void createSelectPipeline(const std::string& path);
+    VkDeviceSize commandSetOffset(const uint32_t set) const;
+};
@@ -0,0 +1,120 @@
+#include "ParticleLayoutBenchmark.h"
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <iomanip>
+#include <memory>
+#include <optional>
+/* parasoft-end-suppress ALL */
+
+#include "GpuFrameTimer.h"
+#include "ParticleSystem.h"
+#include "VulkanUtils.h"
+
+// ========================================================================
+// SECTION 1: MEASUREMENT
+// ========================================================================
+
+/**
+ * @brief Builds, warms up and times one system per layout.
+ */
+std::vector<LayoutBenchmarkResult> ParticleLayoutBenchmark::run(VulkanContext* const ctx, const VkRenderPass renderPass,
+    const VkSampleCountFlagBits msaa, const uint32_t queueFamilyIndex, const VkDescriptorSet sceneSet, const std::string& shaderSet)
+{
+    std::vector<LayoutBenchmarkResult> results{};
+
+    GpuFrameTimer timer(ctx, EngineConstants::COUNT_ONE, queueFamilyIndex);
+    if (!timer.isSupported()) {
+        return results;
+    }
+
+    // Step 1: Nothing else may share the queue while the timestamps are open
+    static_cast<void>(vkDeviceWaitIdle(ctx->device));
+
+    const std::array<ParticleLayout, 2> layouts = { ParticleLayout::Interleaved, ParticleLayout::CompressedSoA };
+    for (const ParticleLayout layout : layouts) {
+        EmitterDefinition emitter{};
+        emitter.shaderSet = shaderSet;
+        emitter.spawnRadius = 0.01f;
+        emitter.count = PARTICLE_COUNT;
+        emitter.layout = layout;
+        emitter.compressedShaders = true;
+
+        // Step 2: A private system, so the scene's buffers are left untouched
+        const std::unique_ptr<ParticleSystem> system =
+            std::make_unique<ParticleSystem>(ctx, renderPass, ctx->globalSetLayout, emitter, msaa);
+
+        // Step 3: Warm-up, then the timed dispatches (each followed by the system's own barrier)
+        const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(ctx->device, ctx->graphicsCommandPool);
+        float totalTime = 0.0f;
+        for (uint32_t i = 0U; i < WARMUP_DISPATCHES; ++i) {
+            totalTime += STEP_SECONDS;
+            system->update(cb, STEP_SECONDS, true, totalTime, glm::vec3(1.0f), glm::vec3(0.0f), sceneSet);
+        }
+
+        timer.begin(cb, EngineConstants::INDEX_ZERO);
+        for (uint32_t i = 0U; i < DISPATCHES; ++i) {
+            totalTime += STEP_SECONDS;
+            system->update(cb, STEP_SECONDS, true, totalTime, glm::vec3(1.0f), glm::vec3(0.0f), sceneSet);
+        }
+        timer.end(cb, EngineConstants::INDEX_ZERO);
+        VulkanUtils::endSingleTimeCommands(ctx->device, ctx->graphicsCommandPool, ctx->graphicsQueue, cb);
+
+        const std::optional<float> gpuMs = timer.collect(EngineConstants::INDEX_ZERO);
+        if (!gpuMs.has_value() || (gpuMs.value() <= 0.0f)) {
+            continue;
+        }
+
+        // Step 4: Every dispatch reads and writes each particle once
+        LayoutBenchmarkResult result{};
+        result.layout = layout;
+        result.particles = PARTICLE_COUNT;
+        result.dispatches = DISPATCHES;
+        result.bytesPerParticle = system->getBytesPerParticle();
+        result.msPerDispatch = static_cast<double>(gpuMs.value()) / static_cast<double>(DISPATCHES);
+
+        const double bytesPerDispatch = 2.0 * static_cast<double>(result.bytesPerParticle) * static_cast<double>(PARTICLE_COUNT);
+        result.gigabytesPerSecond = bytesPerDispatch / (result.msPerDispatch * 1.0e6);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+// ========================================================================
+// SECTION 2: REPORTING
+// ========================================================================
+
+/**
+ * @brief Prints the results in run order.
+ */
+void ParticleLayoutBenchmark::report(std::ostream& out, const std::vector<LayoutBenchmarkResult>& results) {
+    if (results.empty()) {
+        out << "ParticleLayoutBenchmark: No results (timestamps unsupported on the graphics queue)" << std::endl;
+        return;
+    }
+
+    double interleavedMs = 0.0;
+    double compressedMs = 0.0;
+    for (const LayoutBenchmarkResult& result : results) {
+        const bool compressed = (result.layout == ParticleLayout::CompressedSoA);
+        if (compressed) {
+            compressedMs = result.msPerDispatch;
+        }
+        else {
+            interleavedMs = result.msPerDispatch;
+        }
+
+        out << "ParticleLayoutBenchmark: " << (compressed ? "compressed SoA" : "interleaved   ")
+            << " | " << result.particles << " particles x " << result.bytesPerParticle << " B"
+            << " | " << std::fixed << std::setprecision(3) << result.msPerDispatch << " ms/dispatch"
+            << " | " << std::setprecision(1) << result.gigabytesPerSecond << " GB/s effective"
+            << " (" << result.dispatches << " dispatches)" << std::endl;
+    }
+
+    if ((interleavedMs > 0.0) && (compressedMs > 0.0)) {
+        out << "ParticleLayoutBenchmark: compressed layout runs at " << std::setprecision(2)
+            << (interleavedMs / compressedMs) << "x the interleaved speed" << std::endl;
+    }
+    out << std::defaultfloat;
+}
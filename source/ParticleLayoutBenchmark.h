@@ -0,0 +1,61 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "Particle.h"
+#include "VulkanContext.h"
+
+/**
+ * @struct LayoutBenchmarkResult
+ * @brief GPU cost of simulating one particle layout.
+ * Bandwidth counts one read and one write of every particle's bytes per dispatch; caches make it an
+ * effective figure, not a measured DRAM rate.
+ */
+struct LayoutBenchmarkResult final {
+    ParticleLayout layout{ ParticleLayout::Interleaved };
+    uint32_t particles{ 0U };
+    uint32_t dispatches{ 0U };
+    uint32_t bytesPerParticle{ 0U };
+    double msPerDispatch{ 0.0 };
+    double gigabytesPerSecond{ 0.0 };
+};
+
+/**
+ * @class ParticleLayoutBenchmark
+ * @brief Times the simulation dispatch of each particle layout over the same large emitter.
+ * * For every layout a throw-away system of the given shader set is built with PARTICLE_COUNT particles,
+ * warmed up, and then dispatched DISPATCHES times between two timestamps in one submission. The run
+ * waits for the device to go idle before and after, so call it between frames, never while recording.
+ * * Queues without timestamp support produce no results.
+ */
+class ParticleLayoutBenchmark final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t PARTICLE_COUNT = 1U << 20U;   /**< 1M particles: well past any cache. */
+    static constexpr uint32_t WARMUP_DISPATCHES = 4U;
+    static constexpr uint32_t DISPATCHES = 32U;
+    static constexpr float STEP_SECONDS = 1.0f / 60.0f;
+
+    /**
+     * @brief Runs both layouts with the shader set and returns one result per timed layout.
+     * The set must ship SoA builds; throws if a system cannot be built (e.g. its shaders are missing).
+     * @param sceneSet Global set the simulations bind as their Set 1 (they sample the wind field).
+     */
+    static std::vector<LayoutBenchmarkResult> run(VulkanContext* const ctx, const VkRenderPass renderPass,
+        const VkSampleCountFlagBits msaa, const uint32_t queueFamilyIndex, const VkDescriptorSet sceneSet,
+        const std::string& shaderSet = "fire");
+
+    /** @brief Writes one line per result, and the compressed layout's speed-up over the interleaved one. */
+    static void report(std::ostream& out, const std::vector<LayoutBenchmarkResult>& results);
+
+private:
+    // Static utility class: Constructor and Destructor are private to prevent instantiation.
+    ParticleLayoutBenchmark() = default;
+    ~ParticleLayoutBenchmark() = default;
+};
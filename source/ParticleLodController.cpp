@@ -0,0 +1,78 @@
+#include "ParticleLodController.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Sets the globe's bounding sphere.
+ */
+void ParticleLodController::setBounds(const glm::vec3& inCenter, const float inRadius) {
+    center = inCenter;
+    if (inRadius > 0.0f) {
+        radius = inRadius;
+    }
+}
+
+/**
+ * @brief Sets the thresholds; each value out of range keeps the previous one.
+ */
+void ParticleLodController::setThresholds(const float inFullCoverage, const float inMinCoverage, const float inMinFraction,
+    const float inMaxSizeScale)
+{
+    if ((inFullCoverage > 0.0f) && (inFullCoverage <= 1.0f) && (inMinCoverage >= 0.0f) && (inMinCoverage < inFullCoverage)) {
+        fullCoverage = inFullCoverage;
+        minCoverage = inMinCoverage;
+    }
+    if ((inMinFraction > 0.0f) && (inMinFraction <= 1.0f)) {
+        minFraction = inMinFraction;
+    }
+    if (inMaxSizeScale >= 1.0f) {
+        maxSizeScale = inMaxSizeScale;
+    }
+}
+
+/**
+ * @brief Projects the bounding sphere and derives the fraction and its compensation.
+ */
+void ParticleLodController::update(const glm::mat4& view, const glm::mat4& proj) {
+    // Step 1: Screen share of the sphere; its projected ellipse is taken as centred (exact on the view axis)
+    const glm::vec3 viewCenter = glm::vec3(view * glm::vec4(center, 1.0f));
+    const float distance = glm::length(viewCenter);
+
+    if (distance <= radius) {
+        coverage = 1.0f;
+    }
+    else if (viewCenter.z > radius) {
+        coverage = 0.0f;   // Entirely behind the camera
+    }
+    else {
+        const float tanAngle = radius / std::sqrt((distance * distance) - (radius * radius));
+        const float halfWidth = tanAngle * std::fabs(proj[0][0]);
+        const float halfHeight = tanAngle * std::fabs(proj[1][1]);
+        coverage = std::min((PI * halfWidth * halfHeight) / 4.0f, 1.0f);   // NDC spans 2 x 2
+    }
+
+    // Step 2: Linear ramp between the thresholds, quantized
+    if (!active) {
+        fraction = 1.0f;
+    }
+    else {
+        const float t = std::clamp((coverage - minCoverage) / (fullCoverage - minCoverage), 0.0f, 1.0f);
+        const float ramp = minFraction + ((1.0f - minFraction) * t);
+        fraction = std::clamp(std::round(ramp / FRACTION_STEP) * FRACTION_STEP, minFraction, 1.0f);
+    }
+
+    // Step 3: Larger points keep the covered area; alpha covers what the size cap leaves
+    sizeScale = std::min(1.0f / std::sqrt(fraction), maxSizeScale);
+    alphaScale = 1.0f / (fraction * sizeScale * sizeScale);
+}
+
+/**
+ * @brief Scales an emitter's count by the fraction, rounding up.
+ */
+uint32_t ParticleLodController::scaleCount(const uint32_t count, const float activeFraction) {
+    const float scaled = std::ceil(static_cast<float>(count) * std::clamp(activeFraction, 0.0f, 1.0f));
+    return std::clamp(static_cast<uint32_t>(scaled), std::min(count, 1U), count);
+}
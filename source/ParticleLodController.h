@@ -0,0 +1,84 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class ParticleLodController
+ * @brief Picks the share of every emitter's particles that is kept alive from the globe's size on screen.
+ * * The globe's bounding sphere is projected with the frame's camera; its share of the screen (1 once the
+ * camera is inside it) maps linearly from minCoverage (minFraction of the particles) up to fullCoverage
+ * (all of them). The fraction caps how many particles the simulations keep alive, so fewer are
+ * simulated and drawn; emission stops above the cap and the surplus dies out over its lifetime.
+ * * Fewer particles would read as thinner weather, so the draws compensate: point sizes grow by
+ * 1/sqrt(fraction), which keeps the covered area, up to maxSizeScale; alpha makes up the rest.
+ */
+class ParticleLodController final {
+public:
+    // --- Named Constants ---
+    static constexpr float DEFAULT_FULL_COVERAGE = 0.25f;   /**< Screen share from which every particle is kept. */
+    static constexpr float DEFAULT_MIN_COVERAGE = 0.02f;    /**< Screen share at and below which minFraction is kept. */
+    static constexpr float DEFAULT_MIN_FRACTION = 0.25f;
+    static constexpr float DEFAULT_MAX_SIZE_SCALE = 1.5f;
+    static constexpr float FRACTION_STEP = 0.05f;           /**< Fractions are quantized so counts hold still under small moves. */
+    static constexpr float PI = 3.14159265f;
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Keeps every particle until the first update(). */
+    ParticleLodController() = default;
+    ~ParticleLodController() = default;
+
+    // A controller describes one globe; prevent accidental duplication.
+    ParticleLodController(const ParticleLodController&) = delete;
+    ParticleLodController& operator=(const ParticleLodController&) = delete;
+
+    // --- Configuration ---
+
+    /** @brief Sets the bounding sphere of the globe the particles live in. */
+    void setBounds(const glm::vec3& inCenter, const float inRadius);
+
+    /**
+     * @brief Sets the coverage thresholds and the floor of the fraction (the [ParticleLod] config section).
+     * Values out of range are ignored: coverages in (0, 1] with min below full, fraction in (0, 1], scale >= 1.
+     */
+    void setThresholds(const float inFullCoverage, const float inMinCoverage, const float inMinFraction, const float inMaxSizeScale);
+
+    /** @brief Enables or disables LOD; disabled, every particle is kept at its own size. */
+    void setEnabled(const bool enabled) { active = enabled; }
+
+    // --- Core API ---
+
+    /** @brief Re-evaluates the coverage, the fraction and the compensation for this frame's camera. */
+    void update(const glm::mat4& view, const glm::mat4& proj);
+
+    /** @brief Returns the particles of an emitter of the given size to keep alive at a fraction (at least one). */
+    static uint32_t scaleCount(const uint32_t count, const float activeFraction);
+
+    // --- Accessors ---
+
+    float getCoverage() const { return coverage; }
+    float getFraction() const { return fraction; }
+    float getSizeScale() const { return sizeScale; }
+    float getAlphaScale() const { return alphaScale; }
+    bool isEnabled() const { return active; }
+
+    /** @brief Returns the draw compensation for the global UBO: fraction, size scale, alpha scale, 0. */
+    glm::vec4 getShaderParams() const { return glm::vec4(fraction, sizeScale, alphaScale, 0.0f); }
+
+private:
+    glm::vec3 center{ 0.0f, 0.0f, 0.0f };
+    float radius{ 1.0f };
+    float fullCoverage{ DEFAULT_FULL_COVERAGE };
+    float minCoverage{ DEFAULT_MIN_COVERAGE };
+    float minFraction{ DEFAULT_MIN_FRACTION };
+    float maxSizeScale{ DEFAULT_MAX_SIZE_SCALE };
+
+    float coverage{ 1.0f };
+    float fraction{ 1.0f };
+    float sizeScale{ 1.0f };
+    float alphaScale{ 1.0f };
+    bool active{ true };
+};
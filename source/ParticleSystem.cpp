@@ -2,9 +2,12 @@
 
 /* parasoft-begin-suppress ALL */
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstring>
+#include <iostream>
+#include <numeric>
 #include <random>
 /* parasoft-end-suppress ALL */
 
@@ -19,21 +22,81 @@ ParticleSystem::ParticleSystem(
     VulkanContext* const inContext,
     const VkRenderPass renderPass,
     const VkDescriptorSetLayout inGlobalSetLayout,
-    const std::string& compPath,
-    const std::string& vertPath,
-    const std::string& fragPath,
-    const glm::vec3& spawnPos,
-    const uint32_t maxParticles,
-    const VkSampleCountFlagBits inMsaa)
+    const EmitterDefinition& emitter,
+    const VkSampleCountFlagBits inMsaa,
+    PipelineBuildQueue* const buildQueue)
     : context(inContext),
     globalSetLayout(inGlobalSetLayout),
-    particleCount(maxParticles),
-    msaaSamples(inMsaa)
+    vertShaderPath(emitter.layoutShaderPath("vert")),
+    particleCount(emitter.count),
+    workgroupSize(emitter.workgroupSize),
+    spawnRadius(emitter.spawnRadius),
+    layout(emitter.layout),
+    msaaSamples(inMsaa),
+    computePipelineLayout(VK_NULL_HANDLE),
+    computePipeline(VK_NULL_HANDLE),
+    graphicsPipelineLayout(VK_NULL_HANDLE),
+    graphicsPipeline(VK_NULL_HANDLE)
 {
-    createBuffers(spawnPos);
+    if (particleCount == 0U) {
+        throw std::runtime_error("ParticleSystem: Emitter '" + emitter.shaderSet + "' has no particles!");
+    }
+    if ((layout == ParticleLayout::CompressedSoA) && !emitter.compressedShaders) {
+        throw std::runtime_error("ParticleSystem: Emitter '" + emitter.shaderSet + "' has no compressed-layout shaders!");
+    }
+    depthSortRequested = emitter.depthSort;
+    spawnBudget = (emitter.spawnBudget == 0U) ? particleCount : std::min(emitter.spawnBudget, particleCount);
+    activeCount = particleCount;
+    hostEffect = CpuParticleSimulator::effectOf(emitter.shaderSet);
+    if (emitter.cpuSimulation && !hostEffect.has_value()) {
+        throw std::runtime_error("ParticleSystem: Emitter '" + emitter.shaderSet + "' has no host simulation!");
+    }
+    hostSimulation = emitter.cpuSimulation;
+
+    // Step 0: The workgroup size comes from config, so keep it within what the device can launch
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+    const uint32_t maxGroupSize = std::min(props.limits.maxComputeWorkGroupSize[0], props.limits.maxComputeWorkGroupInvocations);
+    workgroupSize = std::clamp(workgroupSize, EngineConstants::COUNT_ONE, maxGroupSize);
+
+    const std::string compPath = emitter.layoutShaderPath("comp");
+    const std::string vertPath = vertShaderPath;
+    const std::string fragPath = emitter.shaderPath("frag");
+
+    // Step 1: Buffers and descriptors touch the allocator and queues, so they stay on this thread
+    // The draw layout is shared by the ordered and OIT pipelines, so it exists before either job runs.
+    createBuffers(emitter.spawnPos);
     createComputeDescriptors();
-    createComputePipeline(compPath);
-    createGraphicsPipeline(renderPass, vertPath, fragPath);
+    createGraphicsPipelineLayout();
+
+    // Step 2: Pipelines only create device objects and may be compiled on the build queue's workers
+    // A simulation that cannot be built falls back to the host port when the set has one.
+    const auto buildSimulation = [this, compPath]() {
+        if (hostSimulation) {
+            return;
+        }
+        try {
+            createComputePipeline(compPath);
+        }
+        catch (const std::exception& e) {
+            if (!hostEffect.has_value()) {
+                throw;
+            }
+            std::cerr << "ParticleSystem: Compute simulation unavailable (" << e.what() << "); simulating on the CPU" << std::endl;
+            hostSimulation = true;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(compPath, buildSimulation);
+        buildQueue->submit(fragPath, [this, renderPass, vertPath, fragPath]() {
+            graphicsPipeline = buildGraphicsPipeline(renderPass, vertPath, fragPath, false);
+        });
+    }
+    else {
+        buildSimulation();
+        graphicsPipeline = buildGraphicsPipeline(renderPass, vertPath, fragPath, false);
+    }
 }
 
 /**
@@ -44,13 +107,42 @@ ParticleSystem::~ParticleSystem() {
         vkDestroyPipeline(context->device, computePipeline, nullptr);
         vkDestroyPipelineLayout(context->device, computePipelineLayout, nullptr);
         vkDestroyPipeline(context->device, graphicsPipeline, nullptr);
+        vkDestroyPipeline(context->device, oitPipeline, nullptr);
         vkDestroyPipelineLayout(context->device, graphicsPipelineLayout, nullptr);
 
         vkDestroyDescriptorPool(context->device, computeDescriptorPool, nullptr);
         vkDestroyDescriptorSetLayout(context->device, computeSetLayout, nullptr);
 
+        vkDestroyPipeline(context->device, selectPipeline, nullptr);
+        vkDestroyPipelineLayout(context->device, selectPipelineLayout, nullptr);
+        vkDestroyDescriptorPool(context->device, selectDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(context->device, selectSetLayout, nullptr);
+        vkDestroyBuffer(context->device, sparkBuffer, nullptr);
+        vkFreeMemory(context->device, sparkBufferMemory, nullptr);
+
+        if (readbackMapped != nullptr) {
+            vkUnmapMemory(context->device, readbackMemory);
+            readbackMapped = nullptr;
+        }
+        vkDestroyBuffer(context->device, readbackBuffer, nullptr);
+        vkFreeMemory(context->device, readbackMemory, nullptr);
+
+        sortTimer.reset();
+        vkDestroyPipeline(context->device, sortPipeline, nullptr);
+        vkDestroyPipelineLayout(context->device, sortPipelineLayout, nullptr);
+        vkDestroyDescriptorPool(context->device, sortDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(context->device, sortSetLayout, nullptr);
+        vkDestroyBuffer(context->device, sortKeyBuffer, nullptr);
+        vkFreeMemory(context->device, sortKeyMemory, nullptr);
+        vkDestroyBuffer(context->device, sortIndexBuffer, nullptr);
+        vkFreeMemory(context->device, sortIndexMemory, nullptr);
+
         vkDestroyBuffer(context->device, storageBuffer, nullptr);
         vkFreeMemory(context->device, storageBufferMemory, nullptr);
+        vkDestroyBuffer(context->device, listBuffer, nullptr);
+        vkFreeMemory(context->device, listMemory, nullptr);
+        vkDestroyBuffer(context->device, listStateBuffer, nullptr);
+        vkFreeMemory(context->device, listStateMemory, nullptr);
 
         if (uniformBufferMapped != nullptr) {
             vkUnmapMemory(context->device, uniformBufferMemory);
@@ -66,10 +158,11 @@ ParticleSystem::~ParticleSystem() {
 // ========================================================================
 
 /**
- * @brief Records the Compute dispatch and memory barriers to sync with the Graphics pass.
+ * @brief Records the three simulation passes and the barriers between them and towards the draw.
+ * Only the first pass has a fixed size; the others dispatch what it wrote into the list state.
  */
 void ParticleSystem::update(const VkCommandBuffer commandBuffer, const float deltaTime, const bool spawnEnabled,
-    const float totalTime, const glm::vec3& lightColor, const glm::vec3& emitterPos)
+    const float totalTime, const glm::vec3& lightColor, const glm::vec3& emitterPos, const VkDescriptorSet sceneSet)
 {
     this->lastEmitterPos = emitterPos;
 
@@ -86,72 +179,255 @@ void ParticleSystem::update(const VkCommandBuffer commandBuffer, const float del
 
     static_cast<void>(std::memcpy(uniformBufferMapped, &ubo, sizeof(ParticleUBO)));
 
-    // Step 2: Dispatch Compute Shader for physics simulation
+    if (hostSimulation) {
+        recordHostSimulation(commandBuffer, CpuSimulationStep{ deltaTime, totalTime, spawnEnabled, lightColor, emitterPos, activeCount });
+        return;
+    }
+
+    // Step 2: Bind the simulation; its passes differ only in their push constants
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
     const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { computeDescriptorSet };
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
         EngineConstants::INDEX_ZERO, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
+    if (sceneSet != VK_NULL_HANDLE) {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
+            SET_INDEX_SCENE, DESCRIPTOR_COUNT_ONE, &sceneSet, EngineConstants::OFFSET_ZERO, nullptr);
+    }
 
-    const uint32_t groupCount = (particleCount / COMPUTE_WORKGROUP_SIZE) + EngineConstants::OFFSET_ONE;
-    vkCmdDispatch(commandBuffer, groupCount, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
-
-    // Step 3: Pipeline Barrier - Ensure Compute writes finish before Vertex Input reads the SSBO
-    VkBufferMemoryBarrier bufferBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
-    bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-    bufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    bufferBarrier.buffer = storageBuffer;
-    bufferBarrier.offset = static_cast<VkDeviceSize>(EngineConstants::OFFSET_ZERO);
-    bufferBarrier.size = VK_WHOLE_SIZE;
-
-    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
-        EngineConstants::COUNT_ONE, &bufferBarrier, 0U, nullptr);
+    SimulationPushConstants params{ PASS_BEGIN, currentList, activeCount };
+
+    // Step 3: The previous frame's draw and sort finish reading the lists and arguments before they are rewritten
+    recordComputeBarrier(commandBuffer,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT));
+
+    // Step 4: One invocation sizes the emission and writes the indirect arguments
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U,
+        static_cast<uint32_t>(sizeof(SimulationPushConstants)), &params);
+    vkCmdDispatch(commandBuffer, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+    recordComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT),
+        (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT));
+
+    // Step 5: Emission pops the dead list into the current list
+    params.pass = PASS_EMIT;
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U,
+        static_cast<uint32_t>(sizeof(SimulationPushConstants)), &params);
+    vkCmdDispatchIndirect(commandBuffer, listStateBuffer, offsetof(ListState, emitDispatch));
+    recordComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT));
+
+    // Step 6: Simulation of the current list; survivors go to the other list, the rest back to the dead list
+    params.pass = PASS_SIMULATE;
+    vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U,
+        static_cast<uint32_t>(sizeof(SimulationPushConstants)), &params);
+    vkCmdDispatchIndirect(commandBuffer, listStateBuffer, offsetof(ListState, simulateDispatch));
+
+    // Step 7: Particle writes -> vertex fetch; survivor list -> index fetch; survivor count -> the draw's arguments
+    recordComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        (VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT),
+        (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT));
+
+    currentList = EngineConstants::INDEX_ONE - currentList;
 }
 
 /**
  * @brief Records drawing commands for the particles.
  */
-void ParticleSystem::draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet) const {
-    if (graphicsPipeline == VK_NULL_HANDLE) { return; }
-
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-
-    const VkBuffer vertexBuffers[EngineConstants::COUNT_ONE] = { storageBuffer };
-    const VkDeviceSize offsets[EngineConstants::COUNT_ONE] = { static_cast<VkDeviceSize>(EngineConstants::OFFSET_ZERO) };
-    vkCmdBindVertexBuffers(commandBuffer, EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, vertexBuffers, offsets);
+void ParticleSystem::draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet, const bool weightedOIT) const {
+    const VkPipeline pipeline = weightedOIT ? oitPipeline : graphicsPipeline;
+    if (pipeline == VK_NULL_HANDLE) { return; }
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+    // The compressed layout fetches only its position and life/size streams; velocity stays in the simulation
+    if (layout == ParticleLayout::CompressedSoA) {
+        const VkBuffer vertexBuffers[2] = { storageBuffer, storageBuffer };
+        const VkDeviceSize offsets[2] = {
+            streams[CompressedParticle::STREAM_POSITION].offset, streams[CompressedParticle::STREAM_LIFE_SIZE].offset
+        };
+        vkCmdBindVertexBuffers(commandBuffer, EngineConstants::INDEX_ZERO, 2U, vertexBuffers, offsets);
+    }
+    else {
+        const VkBuffer vertexBuffers[EngineConstants::COUNT_ONE] = { storageBuffer };
+        const VkDeviceSize offsets[EngineConstants::COUNT_ONE] = { static_cast<VkDeviceSize>(EngineConstants::OFFSET_ZERO) };
+        vkCmdBindVertexBuffers(commandBuffer, EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, vertexBuffers, offsets);
+    }
 
     const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { globalDescriptorSet };
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout,
         SET_INDEX_GLOBAL, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
 
-    vkCmdDraw(commandBuffer, particleCount, EngineConstants::COUNT_ONE, EngineConstants::OFFSET_ZERO, EngineConstants::OFFSET_ZERO);
+    // Live particles only: through the survivor list, or back to front through the sorted copy of it
+    if (drawSorted) {
+        vkCmdBindIndexBuffer(commandBuffer, sortIndexBuffer, 0ULL, VK_INDEX_TYPE_UINT32);
+    }
+    else {
+        const VkDeviceSize listOffset = static_cast<VkDeviceSize>(sizeof(uint32_t)) * particleCount * currentList;
+        vkCmdBindIndexBuffer(commandBuffer, listBuffer, listOffset, VK_INDEX_TYPE_UINT32);
+    }
+    vkCmdDrawIndexedIndirect(commandBuffer, listStateBuffer, offsetof(ListState, draw), EngineConstants::COUNT_ONE,
+        static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand)));
 }
 
 /**
- * @brief Retrieves dynamic light emitters from the GPU particle buffer for world-space lighting.
+ * @brief Builds the weighted OIT draw pipeline; a missing shader only disables OIT for this system.
  */
-std::vector<SparkLight> ParticleSystem::getLightData() const {
-    std::vector<SparkLight> lights(EngineConstants::MAX_SPARK_LIGHTS);
-    void* data{ nullptr };
+void ParticleSystem::createOitPipeline(const VkRenderPass oitRenderPass, const std::string& oitFragPath,
+    PipelineBuildQueue* const buildQueue)
+{
+    const auto build = [this, oitRenderPass, oitFragPath]() {
+        try {
+            oitPipeline = buildGraphicsPipeline(oitRenderPass, vertShaderPath, oitFragPath, true);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleSystem: Weighted OIT variant unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(oitFragPath, build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Creates the reduction output, the readback ring and the selection pipeline.
+ * The ring is zeroed so slots that were never written read back as dark lights.
+ */
+void ParticleSystem::enableLightReadback(const uint32_t framesInFlight, PipelineBuildQueue* const buildQueue) {
+    if ((readbackBuffer != VK_NULL_HANDLE) || (framesInFlight == 0U)) { return; }
+
+    // Step 1: Device-local reduction output, also the source of the per-frame copy
+    const VkDeviceSize sparkSize = SPARK_SAMPLE_SIZE * EngineConstants::MAX_SPARK_LIGHTS;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, sparkSize,
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        sparkBuffer, sparkBufferMemory);
+
+    // Step 2: Persistently mapped ring, one slot per frame in flight
+    readbackSlots = framesInFlight;
+    const VkDeviceSize ringSize = sparkSize * readbackSlots;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, ringSize,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        readbackBuffer, readbackMemory);
+
+    static_cast<void>(vkMapMemory(context->device, readbackMemory, 0ULL, ringSize, 0U, &readbackMapped));
+    static_cast<void>(std::memset(readbackMapped, 0, static_cast<size_t>(ringSize)));
+
+    createSelectDescriptors();
+
+    // Step 3: The selection pipeline is optional; without it the sparks simply stay dark
+    const std::string selectPath = (layout == ParticleLayout::CompressedSoA)
+        ? "./shaders/spark_select_soa_comp.spv" : "./shaders/spark_select_comp.spv";
+    const auto build = [this, selectPath]() {
+        try {
+            createSelectPipeline(selectPath);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleSystem: Spark light readback unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(selectPath, build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Records the per-sector selection and its copy into the frame's ring slot.
+ * The slot is read on the host only after this frame's fence is waited on again, so no stall is added.
+ */
+void ParticleSystem::recordLightReadback(const VkCommandBuffer commandBuffer, const uint32_t frameIndex) const {
+    if ((selectPipeline == VK_NULL_HANDLE) || (readbackSlots == 0U)) { return; }
+
+    const VkDeviceSize sparkSize = SPARK_SAMPLE_SIZE * EngineConstants::MAX_SPARK_LIGHTS;
+
+    // Step 1: Simulation writes -> selection reads; previous frame's copy -> selection writes
+    std::array<VkBufferMemoryBarrier, 2> selectBarriers{};
+    selectBarriers[0] = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, storageBuffer, 0ULL, VK_WHOLE_SIZE };
+    selectBarriers[1] = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, sparkBuffer, 0ULL, VK_WHOLE_SIZE };
+
+    vkCmdPipelineBarrier(commandBuffer, (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        static_cast<uint32_t>(selectBarriers.size()), selectBarriers.data(), 0U, nullptr);
+
+    // Step 2: One workgroup per sector
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, selectPipeline);
+    const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { selectDescriptorSet };
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, selectPipelineLayout,
+        EngineConstants::INDEX_ZERO, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdDispatch(commandBuffer, EngineConstants::MAX_SPARK_LIGHTS, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+
+    // Step 3: Selection writes -> copy into the frame's slot
+    VkBufferMemoryBarrier copyBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    copyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    copyBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    copyBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    copyBarrier.buffer = sparkBuffer;
+    copyBarrier.offset = 0ULL;
+    copyBarrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &copyBarrier, 0U, nullptr);
+
+    const VkBufferCopy region{ 0ULL, sparkSize * (frameIndex % readbackSlots), sparkSize };
+    vkCmdCopyBuffer(commandBuffer, sparkBuffer, readbackBuffer, EngineConstants::COUNT_ONE, &region);
+
+    // Step 4: Make the copy visible to the host once the frame's fence signals
+    VkBufferMemoryBarrier hostBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = readbackBuffer;
+    hostBarrier.offset = region.dstOffset;
+    hostBarrier.size = sparkSize;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr);
+}
 
-    const VkDeviceSize mapSize = static_cast<VkDeviceSize>(EngineConstants::PARTICLE_POOL_SIZE) * sizeof(Particle);
-    if (vkMapMemory(context->device, storageBufferMemory, 0ULL, mapSize, 0U, &data) != VK_SUCCESS) {
-        return lights;
+/**
+ * @brief Converts the frame slot's selected samples into world-space spark lights.
+ * Reads host memory only; the particle buffer itself is never mapped.
+ */
+std::vector<SparkLight> ParticleSystem::getLightData(const uint32_t frameIndex) const {
+    if ((readbackMapped == nullptr) || (readbackSlots == 0U)) {
+        return std::vector<SparkLight>(EngineConstants::MAX_SPARK_LIGHTS);
     }
 
-    const Particle* const gpuParticles = static_cast<const Particle*>(data);
+    const size_t slotOffset = static_cast<size_t>(frameIndex % readbackSlots) * EngineConstants::MAX_SPARK_LIGHTS;
+    return toSparkLights(static_cast<const glm::vec4*>(readbackMapped) + slotOffset, lastEmitterPos);
+}
+
+/**
+ * @brief Turns MAX_SPARK_LIGHTS selected samples (xyz position, w life) into lights around the emitter.
+ */
+std::vector<SparkLight> ParticleSystem::toSparkLights(const glm::vec4* const samples, const glm::vec3& emitterPos) {
+    std::vector<SparkLight> lights(EngineConstants::MAX_SPARK_LIGHTS);
 
-    // Sample specific particle sectors to simulate dynamic flickering lights
-    const uint32_t sectors[EngineConstants::MAX_SPARK_LIGHTS] = { 100U, 1000U, 2000U, 3000U };
+    // Push each light slightly outwards from the emitter axis so it does not sit inside the flame
     static constexpr float LENGTH_THRESHOLD = 0.001f;
     static constexpr float PUSH_FACTOR = 0.15f;
 
     for (uint32_t i = 0U; i < EngineConstants::MAX_SPARK_LIGHTS; ++i) {
-        const uint32_t idx = sectors[i];
-        const glm::vec3 pos = glm::vec3(gpuParticles[idx].position);
-        const glm::vec2 toCenter{ pos.x - lastEmitterPos.x, pos.z - lastEmitterPos.z };
+        const float life = samples[i].w;
+        if (life <= 0.0f) { continue; }   // Empty sector (or slot not written yet): leave the light dark
+
+        const glm::vec3 pos = glm::vec3(samples[i]);
+        const glm::vec2 toCenter{ pos.x - emitterPos.x, pos.z - emitterPos.z };
 
         if (glm::length(toCenter) > LENGTH_THRESHOLD) {
             const glm::vec2 pushDir = glm::normalize(toCenter);
@@ -161,21 +437,270 @@ std::vector<SparkLight> ParticleSystem::getLightData() const {
             lights[i].position = pos;
         }
 
-        const float life = gpuParticles[idx].velocity.w;
         lights[i].color = glm::vec3(1.0f, 0.45f, 0.1f) * (life * 0.04f);
     }
 
-    vkUnmapMemory(context->device, storageBufferMemory);
     return lights;
 }
 
+/**
+ * @brief Creates the sort buffers, descriptors, timer and pipeline.
+ * The entry count is padded to a power of two of at least one shared block.
+ */
+void ParticleSystem::enableDepthSort(const uint32_t framesInFlight, const uint32_t queueFamilyIndex, PipelineBuildQueue* const buildQueue) {
+    if (sortIndexBuffer != VK_NULL_HANDLE) { return; }
+
+    // Step 1: Padded key and index buffers; indices double as the draw's index buffer
+    sortCount = SORT_BLOCK;
+    while (sortCount < particleCount) {
+        sortCount <<= 1U;
+    }
+
+    const VkDeviceSize entrySize = static_cast<VkDeviceSize>(sizeof(uint32_t)) * sortCount;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, entrySize,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        sortKeyBuffer, sortKeyMemory);
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, entrySize,
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        sortIndexBuffer, sortIndexMemory);
+
+    createSortDescriptors();
+    sortTimer = std::make_unique<GpuFrameTimer>(context, framesInFlight, queueFamilyIndex);
+
+    // Step 2: The sort pipeline is optional; without it the system draws in buffer order
+    const std::string sortPath = (layout == ParticleLayout::CompressedSoA)
+        ? "./shaders/particle_sort_soa_comp.spv" : "./shaders/particle_sort_comp.spv";
+    const auto build = [this, sortPath]() {
+        try {
+            createSortPipeline(sortPath);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "ParticleSystem: Depth sort unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(sortPath, build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Records the bitonic sort: keys, a full sort of every shared block, then for each larger
+ * sequence size the global compare steps down to one block and a shared-memory merge of the rest.
+ */
+void ParticleSystem::recordDepthSort(const VkCommandBuffer commandBuffer, const uint32_t frameIndex, const glm::mat4& view,
+    const bool enabled)
+{
+    drawSorted = enabled && (sortPipeline != VK_NULL_HANDLE);
+    if (!drawSorted) { return; }
+
+    sortTimer->begin(commandBuffer, frameIndex);
+
+    // Step 1: Simulation writes -> key reads; the previous frame's index fetch -> index rewrites
+    VkMemoryBarrier entryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    entryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    entryBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer, (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO),
+        EngineConstants::COUNT_ONE, &entryBarrier, 0U, nullptr, 0U, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, sortPipeline);
+    const VkDescriptorSet sets[DESCRIPTOR_COUNT_ONE] = { sortDescriptorSet };
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, sortPipelineLayout,
+        EngineConstants::INDEX_ZERO, DESCRIPTOR_COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
+
+    // Step 2: Keys are view-space z, so ascending order is back to front
+    SortPushConstants params{};
+    params.depthRow = glm::vec4(view[0][2], view[1][2], view[2][2], view[3][2]);
+    params.count = sortCount;
+    params.aliveList = particleCount * currentList;
+
+    const uint32_t blockGroups = sortCount / SORT_BLOCK;
+    recordSortStep(commandBuffer, params, SORT_MODE_KEYS, sortCount / SORT_GROUP_SIZE);
+    recordSortStep(commandBuffer, params, SORT_MODE_LOCAL, blockGroups);
+
+    // Step 3: Merge steps for sequences longer than a block
+    for (uint32_t k = SORT_BLOCK << 1U; k <= sortCount; k <<= 1U) {
+        params.k = k;
+        for (uint32_t j = k >> 1U; j >= SORT_BLOCK; j >>= 1U) {
+            params.j = j;
+            recordSortStep(commandBuffer, params, SORT_MODE_GLOBAL, (sortCount / 2U) / SORT_GROUP_SIZE);
+        }
+        recordSortStep(commandBuffer, params, SORT_MODE_MERGE, blockGroups);
+    }
+
+    // Step 4: Sorted indices -> index fetch of this frame's draws
+    VkBufferMemoryBarrier indexBarrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+    indexBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    indexBarrier.dstAccessMask = VK_ACCESS_INDEX_READ_BIT;
+    indexBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    indexBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    indexBarrier.buffer = sortIndexBuffer;
+    indexBarrier.offset = 0ULL;
+    indexBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), 0U, nullptr,
+        EngineConstants::COUNT_ONE, &indexBarrier, 0U, nullptr);
+
+    sortTimer->end(commandBuffer, frameIndex);
+}
+
+/**
+ * @brief Reads the slot's sort timestamps without blocking.
+ */
+std::optional<float> ParticleSystem::collectSortTime(const uint32_t frameIndex) {
+    if (sortTimer == nullptr) {
+        return std::nullopt;
+    }
+    return sortTimer->collect(frameIndex);
+}
+
+/**
+ * @brief Pushes one mode's parameters, dispatches it and orders it before the next step.
+ */
+void ParticleSystem::recordSortStep(const VkCommandBuffer commandBuffer, SortPushConstants& params, const uint32_t mode,
+    const uint32_t groupCount) const
+{
+    params.mode = mode;
+    vkCmdPushConstants(commandBuffer, sortPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0U,
+        static_cast<uint32_t>(sizeof(SortPushConstants)), &params);
+    vkCmdDispatch(commandBuffer, groupCount, EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+
+    VkMemoryBarrier stepBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    stepBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    stepBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &stepBarrier, 0U, nullptr, 0U, nullptr);
+}
+
+// ========================================================================
+// SECTION 3: HOST SIMULATION & READBACK
+// ========================================================================
+
+/**
+ * @brief Steps the host port and records the upload of its result in place of the compute passes.
+ * The host system starts empty and fills through emission; its first upload replaces the initial state.
+ */
+void ParticleSystem::recordHostSimulation(const VkCommandBuffer commandBuffer, const CpuSimulationStep& params) {
+    // Step 1: Created on first use, so systems that simulate on the GPU own no host threads
+    if (hostSimulator == nullptr) {
+        hostSimulator = std::make_unique<CpuParticleSimulator>(hostEffect.value(), particleCount, spawnRadius, spawnBudget);
+    }
+    hostSimulator->step(params);
+
+    const std::vector<uint32_t>& alive = hostSimulator->getAliveList();
+    ListState listState{};
+    listState.deadCount = hostSimulator->getDeadCount();
+    listState.aliveCount = static_cast<uint32_t>(alive.size());
+    listState.draw.indexCount = listState.aliveCount;
+    listState.draw.instanceCount = EngineConstants::COUNT_ONE;
+
+    // Step 2: The previous frame's draw, sort and light selection finish reading before the buffers are rewritten
+    VkMemoryBarrier writeBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    writeBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    writeBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT),
+        VK_PIPELINE_STAGE_TRANSFER_BIT, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO),
+        EngineConstants::COUNT_ONE, &writeBarrier, 0U, nullptr, 0U, nullptr);
+
+    // Step 3: Particles, the live list (into the list the draw reads) and the draw's arguments
+    const std::vector<uint8_t> packed = packParticles(hostSimulator->getParticles());
+    recordBufferUpdate(commandBuffer, storageBuffer, 0ULL, packed.data(), static_cast<VkDeviceSize>(packed.size()));
+    const VkDeviceSize listOffset = static_cast<VkDeviceSize>(particleCount) * currentList * sizeof(uint32_t);
+    recordBufferUpdate(commandBuffer, listBuffer, listOffset, alive.data(), static_cast<VkDeviceSize>(alive.size() * sizeof(uint32_t)));
+    recordBufferUpdate(commandBuffer, listStateBuffer, 0ULL, &listState, static_cast<VkDeviceSize>(sizeof(ListState)));
+
+    // Step 4: Uploads -> vertex and index fetch, the indirect draw, and the compute passes that read the particles
+    VkMemoryBarrier readBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    readBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    readBarrier.dstAccessMask = (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        (VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &readBarrier, 0U, nullptr, 0U, nullptr);
+}
+
+/**
+ * @brief Records inline buffer updates of at most MAX_UPDATE_BYTES each; offset and size must be multiples of 4.
+ */
+void ParticleSystem::recordBufferUpdate(const VkCommandBuffer commandBuffer, const VkBuffer buffer, const VkDeviceSize offset,
+    const void* const data, const VkDeviceSize size)
+{
+    const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+    for (VkDeviceSize done = 0ULL; done < size; done += MAX_UPDATE_BYTES) {
+        const VkDeviceSize chunk = std::min(MAX_UPDATE_BYTES, size - done);
+        vkCmdUpdateBuffer(commandBuffer, buffer, offset + done, chunk, bytes + done);
+    }
+}
+
+/**
+ * @brief Copies the particle buffer, the list state and the live list into one host-visible buffer and unpacks them.
+ */
+void ParticleSystem::readBack(std::vector<Particle>& state, std::vector<uint32_t>& alive) const {
+    // Step 1: Staging laid out as [particle buffer | list state | live list]
+    const VkDeviceSize particleBytes = getParticleBufferSize();
+    const VkDeviceSize listBytes = static_cast<VkDeviceSize>(particleCount) * sizeof(uint32_t);
+    const VkDeviceSize stateOffset = particleBytes;
+    const VkDeviceSize listOffset = stateOffset + sizeof(ListState);
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, listOffset + listBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), staging, stagingMemory);
+
+    // Step 2: Simulation writes (compute passes or host uploads) -> copies -> host reads
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+
+    VkMemoryBarrier copyBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    copyBarrier.srcAccessMask = (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(cb, (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT), VK_PIPELINE_STAGE_TRANSFER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &copyBarrier, 0U, nullptr, 0U, nullptr);
+
+    const VkBufferCopy particleCopy{ 0ULL, 0ULL, particleBytes };
+    const VkBufferCopy stateCopy{ 0ULL, stateOffset, static_cast<VkDeviceSize>(sizeof(ListState)) };
+    const VkBufferCopy listCopy{ listBytes * currentList, listOffset, listBytes };
+    vkCmdCopyBuffer(cb, storageBuffer, staging, EngineConstants::COUNT_ONE, &particleCopy);
+    vkCmdCopyBuffer(cb, listStateBuffer, staging, EngineConstants::COUNT_ONE, &stateCopy);
+    vkCmdCopyBuffer(cb, listBuffer, staging, EngineConstants::COUNT_ONE, &listCopy);
+
+    VkMemoryBarrier hostBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr, 0U, nullptr);
+
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+
+    // Step 3: The survivor counter sizes the live list
+    void* mapped = nullptr;
+    static_cast<void>(vkMapMemory(context->device, stagingMemory, 0ULL, VK_WHOLE_SIZE, 0U, &mapped));
+    const uint8_t* const bytes = static_cast<const uint8_t*>(mapped);
+
+    ListState listState{};
+    static_cast<void>(std::memcpy(&listState, bytes + stateOffset, sizeof(ListState)));
+    alive.resize(std::min(listState.draw.indexCount, particleCount));
+    if (!alive.empty()) {
+        static_cast<void>(std::memcpy(alive.data(), bytes + listOffset, alive.size() * sizeof(uint32_t)));
+    }
+    state = unpackParticles(bytes);
+
+    vkUnmapMemory(context->device, stagingMemory);
+    vkDestroyBuffer(context->device, staging, nullptr);
+    vkFreeMemory(context->device, stagingMemory, nullptr);
+}
+
 // ========================================================================
-// SECTION 3: INTERNAL INITIALIZATION
+// SECTION 4: INTERNAL INITIALIZATION
 // ========================================================================
 
 void ParticleSystem::createBuffers(const glm::vec3& spawnPos) {
     // Step 1: Generate initial particle state on the CPU
-    std::vector<Particle> particles(EngineConstants::PARTICLE_POOL_SIZE);
+    std::vector<Particle> particles(particleCount);
     const auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     std::default_random_engine rndEngine(static_cast<unsigned>(seed));
     std::uniform_real_distribution<float> rndLife(0.0f, 1.0f);
@@ -187,32 +712,51 @@ void ParticleSystem::createBuffers(const glm::vec3& spawnPos) {
         p.color = glm::vec4(1.0f);
     }
 
-    const VkDeviceSize bufferSize = static_cast<VkDeviceSize>(sizeof(Particle)) * EngineConstants::PARTICLE_POOL_SIZE;
-
-    // Step 2: Use a staging buffer to transfer particle data to Device Local memory
-    VkBuffer stagingBuffer{ VK_NULL_HANDLE };
-    VkDeviceMemory stagingMemory{ VK_NULL_HANDLE };
-    VulkanUtils::createBuffer(context->device, context->physicalDevice, bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-        stagingBuffer, stagingMemory);
+    // Step 2: Lay out the streams; each compressed stream starts on the storage offset alignment so it can be bound alone
+    if (layout == ParticleLayout::CompressedSoA) {
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(context->physicalDevice, &props);
+        const VkDeviceSize alignment = std::max(props.limits.minStorageBufferOffsetAlignment, static_cast<VkDeviceSize>(sizeof(uint32_t)));
+
+        const std::array<uint32_t, CompressedParticle::STREAM_COUNT> strides = {
+            CompressedParticle::POSITION_STRIDE, CompressedParticle::LIFE_SIZE_STRIDE, CompressedParticle::VELOCITY_STRIDE
+        };
+        VkDeviceSize offset = 0ULL;
+        for (uint32_t i = 0U; i < CompressedParticle::STREAM_COUNT; ++i) {
+            offset = ((offset + alignment - 1ULL) / alignment) * alignment;
+            streams[i] = { offset, static_cast<VkDeviceSize>(strides[i]) * particleCount };
+            offset += streams[i].size;
+        }
+        streamCount = CompressedParticle::STREAM_COUNT;
+    }
+    else {
+        streams[0] = { 0ULL, static_cast<VkDeviceSize>(sizeof(Particle)) * particleCount };
+        streamCount = 1U;
+    }
 
-    void* data{ nullptr };
-    static_cast<void>(vkMapMemory(context->device, stagingMemory, 0ULL, bufferSize, 0U, &data));
-    static_cast<void>(std::memcpy(data, particles.data(), static_cast<size_t>(bufferSize)));
-    vkUnmapMemory(context->device, stagingMemory);
+    const std::vector<uint8_t> initialState = packParticles(particles);
 
-    VulkanUtils::createBuffer(context->device, context->physicalDevice, bufferSize,
-        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT),
-        (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+    // Step 3: Transfer the particle data to Device Local memory (and back, for readBack())
+    uploadDeviceLocal(initialState.data(), getParticleBufferSize(),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
         storageBuffer, storageBufferMemory);
 
-    VulkanUtils::copyBuffer(context->device, context->graphicsCommandPool, context->graphicsQueue, stagingBuffer, storageBuffer, bufferSize);
-
-    vkDestroyBuffer(context->device, stagingBuffer, nullptr);
-    vkFreeMemory(context->device, stagingMemory, nullptr);
-
-    // Step 3: Create the Simulation UBO
+    // Step 4: Alive/dead lists; every particle starts in alive list 0, so the first frame simulates all of them
+    std::vector<uint32_t> lists(static_cast<size_t>(particleCount) * LIST_COUNT, 0U);
+    std::iota(lists.begin(), lists.begin() + static_cast<std::ptrdiff_t>(particleCount), 0U);
+    uploadDeviceLocal(lists.data(), static_cast<VkDeviceSize>(lists.size() * sizeof(uint32_t)),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+        listBuffer, listMemory);
+
+    ListState listState{};
+    listState.draw.indexCount = particleCount;   // Read back by the first frame as last frame's survivors
+    listState.draw.instanceCount = EngineConstants::COUNT_ONE;
+    uploadDeviceLocal(&listState, static_cast<VkDeviceSize>(sizeof(ListState)),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+        listStateBuffer, listStateMemory);
+    currentList = EngineConstants::INDEX_ZERO;
+
+    // Step 5: Create the Simulation UBO
     VulkanUtils::createBuffer(context->device, context->physicalDevice, static_cast<VkDeviceSize>(sizeof(ParticleUBO)),
         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
         (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
@@ -221,11 +765,26 @@ void ParticleSystem::createBuffers(const glm::vec3& spawnPos) {
     static_cast<void>(vkMapMemory(context->device, uniformBufferMemory, 0ULL, sizeof(ParticleUBO), 0U, &uniformBufferMapped));
 }
 
+/**
+ * @brief Creates a device-local buffer (usage plus transfer destination) filled through the graphics queue.
+ */
+void ParticleSystem::uploadDeviceLocal(const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+    VkBuffer& buffer, VkDeviceMemory& memory) const
+{
+    VulkanUtils::createDeviceLocalBuffer(context->device, context->physicalDevice, context->graphicsCommandPool,
+        context->graphicsQueue, data, size, usage, buffer, memory);
+}
+
 void ParticleSystem::createComputeDescriptors() {
-    const std::array<VkDescriptorSetLayoutBinding, 2> bindings = {
+    // The UBO, one storage binding per stream of the buffer, then the list state and the lists
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
         VkDescriptorSetLayoutBinding{ BINDING_UBO, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
-        VkDescriptorSetLayoutBinding{ BINDING_STORAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+        VkDescriptorSetLayoutBinding{ BINDING_LIST_STATE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_LISTS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
     };
+    for (uint32_t i = 0U; i < streamCount; ++i) {
+        bindings.push_back({ BINDING_STORAGE + i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr });
+    }
 
     VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -234,7 +793,7 @@ void ParticleSystem::createComputeDescriptors() {
 
     const std::array<VkDescriptorPoolSize, 2> poolSizes = {
         VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1U },
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U }
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, streamCount + 2U }
     };
 
     VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
@@ -250,42 +809,325 @@ void ParticleSystem::createComputeDescriptors() {
     static_cast<void>(vkAllocateDescriptorSets(context->device, &allocInfo, &computeDescriptorSet));
 
     const VkDescriptorBufferInfo uboInfo{ uniformBuffer, 0ULL, sizeof(ParticleUBO) };
-    const VkDescriptorBufferInfo storageInfo{ storageBuffer, 0ULL, VK_WHOLE_SIZE };
+    std::array<VkDescriptorBufferInfo, CompressedParticle::STREAM_COUNT> streamInfos{};
+    std::array<VkDescriptorBufferInfo, 2> listInfos{};
 
-    std::array<VkWriteDescriptorSet, 2> writes{};
-    writes[0] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, computeDescriptorSet, BINDING_UBO, 0U, 1U, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &uboInfo, nullptr };
-    writes[1] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, computeDescriptorSet, BINDING_STORAGE, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &storageInfo, nullptr };
+    std::vector<VkWriteDescriptorSet> writes = {
+        { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, computeDescriptorSet, BINDING_UBO, 0U, 1U, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &uboInfo, nullptr }
+    };
+    appendStreamWrites(computeDescriptorSet, BINDING_STORAGE, streamInfos, writes);
+    appendListWrites(computeDescriptorSet, listInfos, writes);
 
     vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
 }
 
+/**
+ * @brief Appends one storage write per stream, bound from firstBinding upwards.
+ * The infos array must outlive the vkUpdateDescriptorSets call that consumes the writes.
+ */
+void ParticleSystem::appendStreamWrites(const VkDescriptorSet set, const uint32_t firstBinding,
+    std::array<VkDescriptorBufferInfo, CompressedParticle::STREAM_COUNT>& infos, std::vector<VkWriteDescriptorSet>& writes) const
+{
+    for (uint32_t i = 0U; i < streamCount; ++i) {
+        infos[i] = { storageBuffer, streams[i].offset, streams[i].size };
+        writes.push_back({ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, firstBinding + i, 0U, 1U,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &infos[i], nullptr });
+    }
+}
+
+/**
+ * @brief Appends the list state and list buffer writes (bindings 5 and 6); the same contract as appendStreamWrites.
+ */
+void ParticleSystem::appendListWrites(const VkDescriptorSet set, std::array<VkDescriptorBufferInfo, 2>& infos,
+    std::vector<VkWriteDescriptorSet>& writes) const
+{
+    infos[0] = { listStateBuffer, 0ULL, VK_WHOLE_SIZE };
+    infos[1] = { listBuffer, 0ULL, VK_WHOLE_SIZE };
+    writes.push_back({ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, BINDING_LIST_STATE, 0U, 1U,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &infos[0], nullptr });
+    writes.push_back({ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, BINDING_LISTS, 0U, 1U,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &infos[1], nullptr });
+}
+
+/**
+ * @brief Records a global barrier that makes compute shader writes visible to the given stages.
+ */
+void ParticleSystem::recordComputeBarrier(const VkCommandBuffer commandBuffer, const VkPipelineStageFlags srcStages,
+    const VkPipelineStageFlags dstStages, const VkAccessFlags dstAccess)
+{
+    VkMemoryBarrier barrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO),
+        EngineConstants::COUNT_ONE, &barrier, 0U, nullptr, 0U, nullptr);
+}
+
+/**
+ * @brief Serializes particles into the buffer's layout (the initial state, and every host simulation step).
+ * The compressed layout drops colour and stores life, size and velocity at half precision.
+ */
+std::vector<uint8_t> ParticleSystem::packParticles(const std::vector<Particle>& particles) const {
+    std::vector<uint8_t> bytes(static_cast<size_t>(getParticleBufferSize()), 0U);
+    if (layout != ParticleLayout::CompressedSoA) {
+        static_cast<void>(std::memcpy(bytes.data(), particles.data(), particles.size() * sizeof(Particle)));
+        return bytes;
+    }
+
+    uint8_t* const positionStream = bytes.data() + streams[CompressedParticle::STREAM_POSITION].offset;
+    uint8_t* const lifeSizeStream = bytes.data() + streams[CompressedParticle::STREAM_LIFE_SIZE].offset;
+    uint8_t* const velocityStream = bytes.data() + streams[CompressedParticle::STREAM_VELOCITY].offset;
+
+    for (size_t i = 0U; i < particles.size(); ++i) {
+        const Particle& p = particles[i];
+        const glm::vec3 position{ p.position };
+        const uint32_t lifeSize = glm::packHalf2x16(glm::vec2(p.velocity.w, p.position.w));
+        const std::array<uint32_t, 2> velocity = {
+            glm::packHalf2x16(glm::vec2(p.velocity.x, p.velocity.y)), glm::packHalf2x16(glm::vec2(p.velocity.z, 0.0f))
+        };
+
+        static_cast<void>(std::memcpy(positionStream + (i * CompressedParticle::POSITION_STRIDE), &position, CompressedParticle::POSITION_STRIDE));
+        static_cast<void>(std::memcpy(lifeSizeStream + (i * CompressedParticle::LIFE_SIZE_STRIDE), &lifeSize, CompressedParticle::LIFE_SIZE_STRIDE));
+        static_cast<void>(std::memcpy(velocityStream + (i * CompressedParticle::VELOCITY_STRIDE), velocity.data(), CompressedParticle::VELOCITY_STRIDE));
+    }
+    return bytes;
+}
+
+/**
+ * @brief Inverse of packParticles(); compressed particles come back with a white colour.
+ */
+std::vector<Particle> ParticleSystem::unpackParticles(const uint8_t* const bytes) const {
+    std::vector<Particle> particles(particleCount);
+    if (layout != ParticleLayout::CompressedSoA) {
+        static_cast<void>(std::memcpy(particles.data(), bytes, particles.size() * sizeof(Particle)));
+        return particles;
+    }
+
+    const uint8_t* const positionStream = bytes + streams[CompressedParticle::STREAM_POSITION].offset;
+    const uint8_t* const lifeSizeStream = bytes + streams[CompressedParticle::STREAM_LIFE_SIZE].offset;
+    const uint8_t* const velocityStream = bytes + streams[CompressedParticle::STREAM_VELOCITY].offset;
+
+    for (size_t i = 0U; i < particles.size(); ++i) {
+        glm::vec3 position{};
+        uint32_t lifeSize = 0U;
+        std::array<uint32_t, 2> velocity{};
+        static_cast<void>(std::memcpy(&position, positionStream + (i * CompressedParticle::POSITION_STRIDE), CompressedParticle::POSITION_STRIDE));
+        static_cast<void>(std::memcpy(&lifeSize, lifeSizeStream + (i * CompressedParticle::LIFE_SIZE_STRIDE), CompressedParticle::LIFE_SIZE_STRIDE));
+        static_cast<void>(std::memcpy(velocity.data(), velocityStream + (i * CompressedParticle::VELOCITY_STRIDE), CompressedParticle::VELOCITY_STRIDE));
+
+        const glm::vec2 life = glm::unpackHalf2x16(lifeSize);
+        const glm::vec2 velocityXY = glm::unpackHalf2x16(velocity[0]);
+        const glm::vec2 velocityZ = glm::unpackHalf2x16(velocity[1]);
+        particles[i].position = glm::vec4(position, life.y);
+        particles[i].velocity = glm::vec4(velocityXY, velocityZ.x, life.x);
+        particles[i].color = glm::vec4(1.0f);
+    }
+    return particles;
+}
+
+/**
+ * @brief Builds the simulation pipeline, specialized for this emitter's workgroup size, capacity and spawn radius.
+ */
 void ParticleSystem::createComputePipeline(const std::string& path) {
     const ShaderModule compShader(context, path, VK_SHADER_STAGE_COMPUTE_BIT);
 
+    const ComputeSpecialization specData{ workgroupSize, particleCount, spawnRadius, spawnBudget };
+    const std::array<VkSpecializationMapEntry, 4> specEntries = {
+        VkSpecializationMapEntry{ SPEC_WORKGROUP_SIZE, offsetof(ComputeSpecialization, workgroupSize), sizeof(uint32_t) },
+        VkSpecializationMapEntry{ SPEC_CAPACITY, offsetof(ComputeSpecialization, capacity), sizeof(uint32_t) },
+        VkSpecializationMapEntry{ SPEC_SPAWN_RADIUS, offsetof(ComputeSpecialization, spawnRadius), sizeof(float) },
+        VkSpecializationMapEntry{ SPEC_SPAWN_BUDGET, offsetof(ComputeSpecialization, spawnBudget), sizeof(uint32_t) }
+    };
+
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = static_cast<uint32_t>(specEntries.size());
+    specInfo.pMapEntries = specEntries.data();
+    specInfo.dataSize = sizeof(ComputeSpecialization);
+    specInfo.pData = &specData;
+
+    const VkPushConstantRange pushRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0U, static_cast<uint32_t>(sizeof(SimulationPushConstants)) };
+
+    // Set 0: the simulation's own buffers; Set 1: the global scene set (depth collision, snow cover)
+    const std::array<VkDescriptorSetLayout, 2> setLayouts = { computeSetLayout, globalSetLayout };
+
     VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    layoutInfo.setLayoutCount = 1U;
-    layoutInfo.pSetLayouts = &computeSetLayout;
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = 1U;
+    layoutInfo.pPushConstantRanges = &pushRange;
     static_cast<void>(vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &computePipelineLayout));
 
     VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
     pipelineInfo.stage = compShader.getStageInfo();
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
     pipelineInfo.layout = computePipelineLayout;
 
-    if (vkCreateComputePipelines(context->device, VK_NULL_HANDLE, 1U, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+    if (context->pipelineCache.createComputePipelines(1U, &pipelineInfo, &computePipeline) != VK_SUCCESS) {
         throw std::runtime_error("ParticleSystem: Failed to create compute pipeline!");
     }
 }
 
 /**
- * @brief Constructs the graphics pipeline for rendering particles.
+ * @brief Creates the selection set: the particle buffer (read) and the per-sector output (write).
  */
-void ParticleSystem::createGraphicsPipeline(const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath) {
-    // Step 1: Shader Module Assembly
-    const ShaderModule vertShader(context, vPath, VK_SHADER_STAGE_VERTEX_BIT);
-    const ShaderModule fragShader(context, fPath, VK_SHADER_STAGE_FRAGMENT_BIT);
-    const VkPipelineShaderStageCreateInfo shaderStages[2] = { vertShader.getStageInfo(), fragShader.getStageInfo() };
+void ParticleSystem::createSelectDescriptors() {
+    // The per-sector output at binding 0, then the particle streams, laid out as in the simulation set
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+        VkDescriptorSetLayoutBinding{ 0U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+    };
+    for (uint32_t i = 0U; i < streamCount; ++i) {
+        bindings.push_back({ BINDING_STORAGE + i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr });
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    static_cast<void>(vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &selectSetLayout));
+
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(bindings.size()) };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = 1U;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 1U;
+    static_cast<void>(vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &selectDescriptorPool));
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = selectDescriptorPool;
+    allocInfo.descriptorSetCount = 1U;
+    allocInfo.pSetLayouts = &selectSetLayout;
+    static_cast<void>(vkAllocateDescriptorSets(context->device, &allocInfo, &selectDescriptorSet));
+
+    const VkDescriptorBufferInfo sparkInfo{ sparkBuffer, 0ULL, VK_WHOLE_SIZE };
+    std::array<VkDescriptorBufferInfo, CompressedParticle::STREAM_COUNT> streamInfos{};
+
+    std::vector<VkWriteDescriptorSet> writes = {
+        { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, selectDescriptorSet, 0U, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &sparkInfo, nullptr }
+    };
+    appendStreamWrites(selectDescriptorSet, BINDING_STORAGE, streamInfos, writes);
+
+    vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+}
+
+/**
+ * @brief Builds the selection pipeline, specialized for its workgroup size and this system's capacity.
+ */
+void ParticleSystem::createSelectPipeline(const std::string& path) {
+    const ShaderModule compShader(context, path, VK_SHADER_STAGE_COMPUTE_BIT);
 
-    // Step 2: Define Layout with global and material descriptor sets
+    const ComputeSpecialization specData{ std::min(SELECT_WORKGROUP_SIZE, workgroupSize), particleCount, spawnRadius, spawnBudget };
+    const std::array<VkSpecializationMapEntry, 2> specEntries = {
+        VkSpecializationMapEntry{ SPEC_WORKGROUP_SIZE, offsetof(ComputeSpecialization, workgroupSize), sizeof(uint32_t) },
+        VkSpecializationMapEntry{ SPEC_CAPACITY, offsetof(ComputeSpecialization, capacity), sizeof(uint32_t) }
+    };
+
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = static_cast<uint32_t>(specEntries.size());
+    specInfo.pMapEntries = specEntries.data();
+    specInfo.dataSize = sizeof(ComputeSpecialization);
+    specInfo.pData = &specData;
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = 1U;
+    layoutInfo.pSetLayouts = &selectSetLayout;
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &selectPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem: Failed to create spark selection pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = compShader.getStageInfo();
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
+    pipelineInfo.layout = selectPipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(1U, &pipelineInfo, &selectPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem: Failed to create spark selection pipeline!");
+    }
+}
+
+/**
+ * @brief Creates the sort set: keys at binding 0, the particle streams from binding 1, indices at binding 4
+ * and the list state and lists at bindings 5 and 6.
+ */
+void ParticleSystem::createSortDescriptors() {
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+        VkDescriptorSetLayoutBinding{ SORT_BINDING_KEYS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ SORT_BINDING_INDICES, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_LIST_STATE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        VkDescriptorSetLayoutBinding{ BINDING_LISTS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr }
+    };
+    for (uint32_t i = 0U; i < streamCount; ++i) {
+        bindings.push_back({ BINDING_STORAGE + i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_COMPUTE_BIT, nullptr });
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    static_cast<void>(vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &sortSetLayout));
+
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(bindings.size()) };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.poolSizeCount = 1U;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 1U;
+    static_cast<void>(vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &sortDescriptorPool));
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = sortDescriptorPool;
+    allocInfo.descriptorSetCount = 1U;
+    allocInfo.pSetLayouts = &sortSetLayout;
+    static_cast<void>(vkAllocateDescriptorSets(context->device, &allocInfo, &sortDescriptorSet));
+
+    const VkDescriptorBufferInfo keyInfo{ sortKeyBuffer, 0ULL, VK_WHOLE_SIZE };
+    const VkDescriptorBufferInfo indexInfo{ sortIndexBuffer, 0ULL, VK_WHOLE_SIZE };
+    std::array<VkDescriptorBufferInfo, CompressedParticle::STREAM_COUNT> streamInfos{};
+    std::array<VkDescriptorBufferInfo, 2> listInfos{};
+
+    std::vector<VkWriteDescriptorSet> writes = {
+        { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, sortDescriptorSet, SORT_BINDING_KEYS, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &keyInfo, nullptr },
+        { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, sortDescriptorSet, SORT_BINDING_INDICES, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &indexInfo, nullptr }
+    };
+    appendStreamWrites(sortDescriptorSet, BINDING_STORAGE, streamInfos, writes);
+    appendListWrites(sortDescriptorSet, listInfos, writes);
+
+    vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+}
+
+/**
+ * @brief Builds the sort pipeline; the capacity constant tells real entries from padding.
+ */
+void ParticleSystem::createSortPipeline(const std::string& path) {
+    const ShaderModule compShader(context, path, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    const VkSpecializationMapEntry capacityEntry{ SPEC_CAPACITY, 0U, sizeof(uint32_t) };
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = 1U;
+    specInfo.pMapEntries = &capacityEntry;
+    specInfo.dataSize = sizeof(uint32_t);
+    specInfo.pData = &particleCount;
+
+    const VkPushConstantRange pushRange{ VK_SHADER_STAGE_COMPUTE_BIT, 0U, static_cast<uint32_t>(sizeof(SortPushConstants)) };
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = 1U;
+    layoutInfo.pSetLayouts = &sortSetLayout;
+    layoutInfo.pushConstantRangeCount = 1U;
+    layoutInfo.pPushConstantRanges = &pushRange;
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &sortPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem: Failed to create depth sort pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = compShader.getStageInfo();
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
+    pipelineInfo.layout = sortPipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(1U, &pipelineInfo, &sortPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("ParticleSystem: Failed to create depth sort pipeline!");
+    }
+}
+
+/**
+ * @brief Creates the draw layout (global and material descriptor sets) shared by both draw pipelines.
+ */
+void ParticleSystem::createGraphicsPipelineLayout() {
     const std::array<VkDescriptorSetLayout, 2> layouts = { globalSetLayout, context->materialSetLayout };
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
     pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
@@ -294,22 +1136,60 @@ void ParticleSystem::createGraphicsPipeline(const VkRenderPass renderPass, const
     if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &graphicsPipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("ParticleSystem: Failed to create graphics pipeline layout!");
     }
+}
+
+/**
+ * @brief Constructs a graphics pipeline for rendering this system's particles.
+ */
+VkPipeline ParticleSystem::buildGraphicsPipeline(const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath,
+    const bool weightedOIT) const
+{
+    return buildPointPipeline(context, graphicsPipelineLayout, renderPass, vPath, fPath, layout, msaaSamples, weightedOIT);
+}
+
+/**
+ * @brief Constructs a point-list pipeline that fetches particles straight from a buffer in the given layout.
+ * The weighted OIT variant writes the accumulation/revealage pair of the OIT pass instead of one blended colour.
+ */
+VkPipeline ParticleSystem::buildPointPipeline(VulkanContext* const inContext, const VkPipelineLayout pipelineLayout,
+    const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath, const ParticleLayout particleLayout,
+    const VkSampleCountFlagBits samples, const bool weightedOIT)
+{
+    // Step 1: Shader Module Assembly
+    const ShaderModule vertShader(inContext, vPath, VK_SHADER_STAGE_VERTEX_BIT);
+    const ShaderModule fragShader(inContext, fPath, VK_SHADER_STAGE_FRAGMENT_BIT);
+    const VkPipelineShaderStageCreateInfo shaderStages[2] = { vertShader.getStageInfo(), fragShader.getStageInfo() };
+
+    // Step 2: The layout (global descriptor set first) was created by the caller
 
     // Step 3: Vertex Input - Reading directly from the simulated Storage Buffer
-    VkVertexInputBindingDescription bindingDescription{};
-    bindingDescription.binding = 0U;
-    bindingDescription.stride = static_cast<uint32_t>(sizeof(Particle));
-    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-    const std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = {
-        VkVertexInputAttributeDescription{ 0U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, position) },
-        VkVertexInputAttributeDescription{ 1U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, velocity) },
-        VkVertexInputAttributeDescription{ 2U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, color) }
-    };
+    std::vector<VkVertexInputBindingDescription> bindingDescriptions{};
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+    if (particleLayout == ParticleLayout::CompressedSoA) {
+        // Two streams: float3 position and half2 life/size (the fetch widens the halves to floats)
+        bindingDescriptions = {
+            VkVertexInputBindingDescription{ 0U, CompressedParticle::POSITION_STRIDE, VK_VERTEX_INPUT_RATE_VERTEX },
+            VkVertexInputBindingDescription{ 1U, CompressedParticle::LIFE_SIZE_STRIDE, VK_VERTEX_INPUT_RATE_VERTEX }
+        };
+        attributeDescriptions = {
+            VkVertexInputAttributeDescription{ 0U, 0U, VK_FORMAT_R32G32B32_SFLOAT, 0U },
+            VkVertexInputAttributeDescription{ 1U, 1U, VK_FORMAT_R16G16_SFLOAT, 0U }
+        };
+    }
+    else {
+        bindingDescriptions = {
+            VkVertexInputBindingDescription{ 0U, static_cast<uint32_t>(sizeof(Particle)), VK_VERTEX_INPUT_RATE_VERTEX }
+        };
+        attributeDescriptions = {
+            VkVertexInputAttributeDescription{ 0U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, position) },
+            VkVertexInputAttributeDescription{ 1U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, velocity) },
+            VkVertexInputAttributeDescription{ 2U, 0U, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Particle, color) }
+        };
+    }
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-    vertexInputInfo.vertexBindingDescriptionCount = 1U;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
     vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
     vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -326,7 +1206,7 @@ void ParticleSystem::createGraphicsPipeline(const VkRenderPass renderPass, const
     const VkPipelineDynamicStateCreateInfo dynamicState = VulkanUtils::prepareDynamicState(dynamicStates);
 
     const VkPipelineRasterizationStateCreateInfo rasterizer = VulkanUtils::prepareRasterizer(VK_CULL_MODE_NONE);
-    const VkPipelineMultisampleStateCreateInfo multisampling = VulkanUtils::prepareMultisampling(msaaSamples);
+    const VkPipelineMultisampleStateCreateInfo multisampling = VulkanUtils::prepareMultisampling(samples);
     const VkPipelineDepthStencilStateCreateInfo depthStencil = VulkanUtils::prepareDepthStencil(VK_FALSE);
 
     // Step 5: Color Blending for Alpha-transparent Particles
@@ -341,19 +1221,23 @@ void ParticleSystem::createGraphicsPipeline(const VkRenderPass renderPass, const
     colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
     colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
+    const std::array<VkPipelineColorBlendAttachmentState, 2U> oitBlendAttachments = VulkanUtils::prepareWeightedOitBlend();
+
     VkPipelineColorBlendStateCreateInfo colorBlending{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
     colorBlending.logicOpEnable = VK_FALSE;
-    colorBlending.attachmentCount = 1U;
-    colorBlending.pAttachments = &colorBlendAttachment;
+    colorBlending.attachmentCount = weightedOIT ? static_cast<uint32_t>(oitBlendAttachments.size()) : 1U;
+    colorBlending.pAttachments = weightedOIT ? oitBlendAttachments.data() : &colorBlendAttachment;
 
     // Step 6: Final Pipeline Creation
     const VkGraphicsPipelineCreateInfo pipelineInfo = VulkanUtils::preparePipelineCreateInfo(
         shaderStages, &vertexInputInfo, &inputAssembly, &viewportState, &rasterizer,
         &multisampling, &depthStencil, &colorBlending, &dynamicState,
-        graphicsPipelineLayout, renderPass
+        pipelineLayout, renderPass
     );
 
-    if (vkCreateGraphicsPipelines(context->device, VK_NULL_HANDLE, 1U, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    VkPipeline pipeline{ VK_NULL_HANDLE };
+    if (inContext->pipelineCache.createGraphicsPipelines(1U, &pipelineInfo, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("ParticleSystem: Failed to create graphics pipeline!");
     }
+    return pipeline;
 }
\ No newline at end of file
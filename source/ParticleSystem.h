@@ -1,6 +1,9 @@
 #pragma once
 
 /* parasoft-begin-suppress ALL */
+#include <array>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 #include "libs.h"
@@ -11,6 +14,42 @@
 #include "ShaderModule.h"
 #include "CommonStructs.h"
 #include "VulkanContext.h"
+#include "PipelineBuildQueue.h"
+#include "GpuFrameTimer.h"
+#include "CpuParticleSimulator.h"
+#include "ParticleLodController.h"
+
+/**
+ * @struct EmitterDefinition
+ * @brief Data-driven description of one particle emitter (see the *Emitter sections of config.txt).
+ * * The shader set names the compiled shaders "<set>_comp.spv", "<set>_vert.spv", "<set>_frag.spv" and
+ * "<set>_oit_frag.spv". The count sizes the particle buffer and, with the workgroup size and spawn
+ * radius, is handed to the compute shader as specialization constants, so no capacity is compiled in.
+ * * Sets built with -DPARTICLE_SOA also ship "<set>_soa_comp.spv" and "<set>_soa_vert.spv"; only those
+ * emitters may select ParticleLayout::CompressedSoA.
+ */
+struct EmitterDefinition final {
+    static constexpr uint32_t DEFAULT_WORKGROUP_SIZE = 256U;
+
+    std::string shaderSet{ "" };
+    glm::vec3 spawnPos{ 0.0f, 0.0f, 0.0f };   /**< Centre of the spawn volume (overridden per frame for moving emitters). */
+    float spawnRadius{ 0.0f };                /**< Extent of the spawn volume; each shader documents its shape. */
+    uint32_t count{ 0U };
+    uint32_t workgroupSize{ DEFAULT_WORKGROUP_SIZE };
+    uint32_t spawnBudget{ 0U };               /**< Particles emitted per frame at most; 0 refills every dead slot at once. */
+    ParticleLayout layout{ ParticleLayout::Interleaved };
+    bool compressedShaders{ false };          /**< The set has compressed-layout builds of its comp and vert stages. */
+    bool depthSort{ false };                  /**< Draw back to front through a GPU-sorted index buffer. */
+    bool cpuSimulation{ false };              /**< Simulate on the host (CpuParticleSimulator) instead of in compute. */
+
+    /** @brief Returns the compiled shader of one stage of the set, e.g. "comp" or "oit_frag". */
+    std::string shaderPath(const std::string& stage) const { return "./shaders/" + shaderSet + "_" + stage + ".spv"; }
+
+    /** @brief Returns the build of a buffer-reading stage ("comp" or "vert") that matches the layout. */
+    std::string layoutShaderPath(const std::string& stage) const {
+        return (layout == ParticleLayout::CompressedSoA) ? shaderPath("soa_" + stage) : shaderPath(stage);
+    }
+};
 
 /**
  * @class ParticleSystem
@@ -18,25 +57,45 @@
  * * This system utilizes a Storage Buffer (SSBO) to store particle state, allowing
  * the Compute shader to update physics while the Graphics shader reads them for
  * instantiation and rendering.
+ * * The buffer holds exactly the emitter's count, but only live particles cost work: alive and dead
+ * index lists (shaders/particle_lists.glsl) are kept on the GPU, and each frame a one-invocation pass
+ * sizes the emission (dead particles, capped by the spawn budget) and writes the indirect arguments of
+ * the emission and simulation dispatches and of the draw, which goes through the survivor list as its
+ * index buffer. With spawning off no particle is emitted, so the system drains to empty dispatches.
+ * * The particle buffer is device-local only. Systems that light the scene (fire) reduce it on the GPU
+ * to a few samples that are copied into a per-frame readback ring and read back frames later.
+ * * In the compressed layout the buffer is split into streams, each starting on the device's storage
+ * offset alignment; the simulation binds each as its own descriptor and the draw fetches only the
+ * position and life/size streams.
+ * * Alpha-blended systems can be drawn back to front: a bitonic sort over view depth (after the
+ * simulation, in the same command buffer) writes an index buffer that the draw goes through.
+ * * The built-in shader sets have a host port (CpuParticleSimulator). It runs instead of the compute
+ * passes when the emitter asks for it or the simulation pipeline cannot be built; each update() then
+ * steps the host simulation and records the upload of the particles, the live list and the draw's
+ * arguments, so the draw, the sort and the light readback are unchanged.
  */
 class ParticleSystem final {
 public:
+    // --- Named Constants ---
+    static constexpr uint32_t UPDATE_DISPATCHES = 3U;   /**< Dispatches one update() records (begin, emit, simulate). */
+    static constexpr uint32_t UPDATE_BARRIERS = 4U;     /**< Pipeline barriers one update() records. */
+
     // --- Lifecycle ---
 
     /**
      * @brief Full constructor for the Particle System.
-     * Orchestrates the creation of compute simulation and graphics rendering pipelines.
+     * Orchestrates the creation of compute simulation and graphics rendering pipelines from the emitter's shader set.
+     * Throws if the emitter has no particles, or asks for host simulation without a host port.
+     * When a build queue is supplied, both pipelines are submitted to it instead of being compiled
+     * inline; the system is not usable until the queue has been executed.
      */
     explicit ParticleSystem(
         VulkanContext* const inContext,
         const VkRenderPass renderPass,
         const VkDescriptorSetLayout inGlobalSetLayout,
-        const std::string& compPath,
-        const std::string& vertPath,
-        const std::string& fragPath,
-        const glm::vec3& spawnPos,
-        const uint32_t maxParticles,
-        const VkSampleCountFlagBits inMsaa
+        const EmitterDefinition& emitter,
+        const VkSampleCountFlagBits inMsaa,
+        PipelineBuildQueue* const buildQueue = nullptr
     );
 
     /** @brief Destructor: Releases all compute and graphics GPU resources. */
@@ -49,22 +108,120 @@ public:
     // --- Core Execution ---
 
     /**
-     * @brief Dispatches the Compute shader to simulate particle movement.
+     * @brief Records the frame's list setup, emission and simulation (indirect dispatches sized on the GPU).
+     * With spawnEnabled off nothing is emitted and the live particles die out.
      * Implementation must be recorded outside of an active RenderPass.
+     * @param sceneSet Global set bound as the simulation's Set 1 (wind field, scene depth collision and
+     *        snow cover); every effect samples the wind, so the compute path needs it.
+     * With host simulation the step runs on the CPU here and only its upload is recorded.
      */
     void update(const VkCommandBuffer commandBuffer, const float deltaTime, const bool spawnEnabled,
         const float totalTime, const glm::vec3& lightColor = glm::vec3(1.0f),
-        const glm::vec3& emitterPos = glm::vec3(0.0f));
+        const glm::vec3& emitterPos = glm::vec3(0.0f), const VkDescriptorSet sceneSet = VK_NULL_HANDLE);
 
     /**
-    * @brief Records drawing commands for the particles into the graphics stream.
+    * @brief Records an indirect draw of the live particles into the graphics stream.
+    * With weightedOIT the OIT variant is used (inside the OIT accumulation pass); it is a no-op if unavailable.
     */
-    void draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet) const;
+    void draw(const VkCommandBuffer commandBuffer, const VkDescriptorSet globalDescriptorSet, const bool weightedOIT = false) const;
+
+    /**
+     * @brief Builds the weighted OIT variant of the draw pipeline against the OIT accumulation pass.
+     * Optional: if the shader cannot be loaded the failure is logged and only the ordered-blend pipeline exists.
+     * With a build queue the pipeline is compiled when the queue is executed.
+     */
+    void createOitPipeline(const VkRenderPass oitRenderPass, const std::string& oitFragPath, PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Returns true if the OIT variant was built. */
+    bool hasOitPipeline() const { return oitPipeline != VK_NULL_HANDLE; }
+
+    /**
+     * @brief Creates the spark-light reduction and its per-frame readback ring (fire only).
+     * Optional: if the selection shader cannot be loaded the failure is logged and the sparks stay dark.
+     * With a build queue the pipeline is compiled when the queue is executed.
+     */
+    void enableLightReadback(const uint32_t framesInFlight, PipelineBuildQueue* const buildQueue = nullptr);
+
+    /**
+     * @brief Records the reduction that picks the brightest live particle of each sector, and the copy of
+     * its result into the frame's readback slot. Record after update(); no-op without a readback pipeline.
+     */
+    void recordLightReadback(const VkCommandBuffer commandBuffer, const uint32_t frameIndex) const;
+
+    /**
+     * @brief Returns the spark lights the frame slot's previous submission selected, for UBO injection.
+     * Call after the slot's fence was waited on and before recordLightReadback() overwrites it; the
+     * data is MAX_FRAMES_IN_FLIGHT frames old and all-dark until the slot was written once.
+     */
+    std::vector<SparkLight> getLightData(const uint32_t frameIndex) const;
+
+    /**
+     * @brief Converts MAX_SPARK_LIGHTS spark_select samples into lights pushed outwards from the emitter axis.
+     * Samples without life (empty sector, unwritten slot) stay dark. Shared with the unified ParticleEngine.
+     */
+    static std::vector<SparkLight> toSparkLights(const glm::vec4* const samples, const glm::vec3& emitterPos);
+
+    /**
+     * @brief Builds an alpha-blended point pipeline that reads particles of the given layout as vertices.
+     * Throws if the shaders cannot be loaded or the pipeline cannot be created. Shared with the ParticleEngine.
+     */
+    static VkPipeline buildPointPipeline(VulkanContext* const inContext, const VkPipelineLayout pipelineLayout,
+        const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath, const ParticleLayout particleLayout,
+        const VkSampleCountFlagBits samples, const bool weightedOIT);
+
+    /**
+     * @brief Creates the depth sort: key and index buffers, its pipeline and per-frame timestamps.
+     * Optional: if the sort shader cannot be loaded the failure is logged and draws keep buffer order.
+     * With a build queue the pipeline is compiled when the queue is executed.
+     */
+    void enableDepthSort(const uint32_t framesInFlight, const uint32_t queueFamilyIndex, PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Returns true if the emitter definition asked for depth sorting. */
+    bool wantsDepthSort() const { return depthSortRequested; }
+
+    /**
+     * @brief Records this frame's depth sort after update(), outside any render pass.
+     * When disabled (or unavailable) nothing is recorded and the frame's draws use buffer order.
+     */
+    void recordDepthSort(const VkCommandBuffer commandBuffer, const uint32_t frameIndex, const glm::mat4& view, const bool enabled);
+
+    /**
+     * @brief Returns the GPU time (ms) of the last sort recorded in this frame slot, if one is available.
+     * Call after the slot's fence was waited on and before recordDepthSort() re-records it.
+     */
+    std::optional<float> collectSortTime(const uint32_t frameIndex);
+
+    /** @brief Returns true if the draws of the current frame go through the sorted index buffer. */
+    bool isDepthSorted() const { return drawSorted; }
 
     /**
-     * @brief Retrieves dynamic light data from the simulated particles for UBO injection.
+     * @brief Copies the particles (in the Particle layout; the compressed layout has no colour) and the
+     * live list back to the host. Idles the graphics queue: for validation, never per frame.
      */
-    std::vector<SparkLight> getLightData() const;
+    void readBack(std::vector<Particle>& state, std::vector<uint32_t>& alive) const;
+
+    /** @brief Returns true if update() runs the host simulation instead of the compute passes. */
+    bool isHostSimulated() const { return hostSimulation; }
+
+    /**
+     * @brief Sets the share of the particles kept alive from the next update() on (ParticleLodController).
+     * Emission refills only up to the share; a surplus dies out over its lifetime.
+     */
+    void setActiveFraction(const float activeFraction) { activeCount = ParticleLodController::scaleCount(particleCount, activeFraction); }
+
+    /** @brief Returns the live particles the simulation allows at most. */
+    uint32_t getActiveCount() const { return activeCount; }
+
+    /** @brief Returns the number of particles the buffer holds. */
+    uint32_t getParticleCount() const { return particleCount; }
+
+    /** @brief Returns the storage layout of the particle buffer. */
+    ParticleLayout getLayout() const { return layout; }
+
+    /** @brief Returns the bytes one particle occupies, i.e. what one simulation step reads and writes. */
+    uint32_t getBytesPerParticle() const {
+        return (layout == ParticleLayout::CompressedSoA) ? CompressedParticle::BYTES_PER_PARTICLE : static_cast<uint32_t>(sizeof(Particle));
+    }
 
 private:
     /**
@@ -85,25 +242,120 @@ private:
         float padding3;     /**< Explicit alignment padding. */
     };
 
+    /**
+     * @struct ListState
+     * @brief Counters and indirect arguments of the alive/dead lists (ListState of particle_lists.glsl, std430).
+     */
+    struct ListState {
+        uint32_t deadCount;
+        uint32_t emitCount;
+        uint32_t aliveCount;
+        uint32_t reserved;
+        VkDispatchIndirectCommand emitDispatch;
+        uint32_t emitPadding;                  /**< uvec4 in the shader. */
+        VkDispatchIndirectCommand simulateDispatch;
+        uint32_t simulatePadding;              /**< uvec4 in the shader. */
+        VkDrawIndexedIndirectCommand draw;     /**< indexCount doubles as the survivor counter. */
+    };
+
+    /**
+     * @struct SimulationPushConstants
+     * @brief Push block of the simulation shaders (particle_simulation.glsl).
+     */
+    struct SimulationPushConstants {
+        uint32_t pass;
+        uint32_t current;       /**< Alive list the frame starts from. */
+        uint32_t activeLimit;   /**< Live particles at most (LOD). */
+    };
+
+    /**
+     * @struct StreamRange
+     * @brief One stream of the particle buffer (the whole buffer in the interleaved layout).
+     */
+    struct StreamRange {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    /**
+     * @struct SortPushConstants
+     * @brief Push block of particle_sort.comp (std430: a vec4 followed by five uints).
+     */
+    struct SortPushConstants {
+        glm::vec4 depthRow;   /**< Row 2 of the view matrix. */
+        uint32_t mode;
+        uint32_t k;
+        uint32_t j;
+        uint32_t count;
+        uint32_t aliveList;   /**< First entry of the survivor list in the list buffer. */
+    };
+
+    /**
+     * @struct ComputeSpecialization
+     * @brief Specialization constants of the compute shaders (constant_id 0 to 3).
+     */
+    struct ComputeSpecialization {
+        uint32_t workgroupSize;   /**< local_size_x_id = 0 */
+        uint32_t capacity;        /**< constant_id = 1: particles in the buffer */
+        float spawnRadius;        /**< constant_id = 2 */
+        uint32_t spawnBudget;     /**< constant_id = 3: particles emitted per frame at most */
+    };
+
     // --- Named Constants ---
-    static constexpr uint32_t COMPUTE_WORKGROUP_SIZE = 256U;
+    static constexpr uint32_t SPEC_WORKGROUP_SIZE = 0U;
+    static constexpr uint32_t SPEC_CAPACITY = 1U;
+    static constexpr uint32_t SPEC_SPAWN_RADIUS = 2U;
+    static constexpr uint32_t SPEC_SPAWN_BUDGET = 3U;
+    static constexpr uint32_t PASS_BEGIN = 0U;
+    static constexpr uint32_t PASS_EMIT = 1U;
+    static constexpr uint32_t PASS_SIMULATE = 2U;
+    static constexpr uint32_t LIST_COUNT = 3U;           /**< Two alternating alive lists and the dead list. */
+    static constexpr uint32_t SELECT_WORKGROUP_SIZE = 64U;
+    static constexpr VkDeviceSize SPARK_SAMPLE_SIZE = sizeof(glm::vec4);   /**< xyz position, w life (0 = no live particle). */
+    static constexpr uint32_t SORT_GROUP_SIZE = 256U;    /**< local_size_x of particle_sort.comp. */
+    static constexpr uint32_t SORT_BLOCK = 512U;         /**< Entries one sort workgroup holds in shared memory. */
+    static constexpr uint32_t SORT_MODE_KEYS = 0U;
+    static constexpr uint32_t SORT_MODE_LOCAL = 1U;
+    static constexpr uint32_t SORT_MODE_GLOBAL = 2U;
+    static constexpr uint32_t SORT_MODE_MERGE = 3U;
+    static constexpr uint32_t SORT_BINDING_KEYS = 0U;
+    static constexpr uint32_t SORT_BINDING_INDICES = 4U;
     static constexpr uint32_t BINDING_UBO = 0U;
     static constexpr uint32_t BINDING_STORAGE = 1U;
+    static constexpr uint32_t BINDING_LIST_STATE = 5U;
+    static constexpr uint32_t BINDING_LISTS = 6U;
     static constexpr uint32_t DESCRIPTOR_COUNT_ONE = 1U;
     static constexpr uint32_t SET_INDEX_GLOBAL = 0U;
+    static constexpr uint32_t SET_INDEX_SCENE = 1U;   /**< Global set in the simulation layout (after its own set). */
+    static constexpr VkDeviceSize MAX_UPDATE_BYTES = 65536ULL;   /**< vkCmdUpdateBuffer limit per call. */
 
     // --- Core Dependencies ---
     VulkanContext* context;
     VkDescriptorSetLayout globalSetLayout;
 
     // --- Configuration ---
+    std::string vertShaderPath;
     uint32_t particleCount;
+    uint32_t workgroupSize;
+    float spawnRadius;
+    uint32_t spawnBudget{ 0U };
+    uint32_t activeCount{ 0U };                          /**< LOD cap on live particles; the count by default. */
+    ParticleLayout layout;
     VkSampleCountFlagBits msaaSamples;
     glm::vec3 lastEmitterPos;
 
     // --- GPU Storage Resources ---
     VkBuffer storageBuffer;
     VkDeviceMemory storageBufferMemory;
+    std::array<StreamRange, CompressedParticle::STREAM_COUNT> streams{};   /**< Only the first is used when interleaved. */
+    uint32_t streamCount{ 1U };
+
+    // --- Alive/Dead Lists ---
+    VkBuffer listBuffer{ VK_NULL_HANDLE };               /**< [alive 0 | alive 1 | dead], particleCount entries each. */
+    VkDeviceMemory listMemory{ VK_NULL_HANDLE };
+    VkBuffer listStateBuffer{ VK_NULL_HANDLE };          /**< ListState: counters and indirect arguments. */
+    VkDeviceMemory listStateMemory{ VK_NULL_HANDLE };
+    uint32_t currentList{ 0U };                          /**< Alive list the last update filled; the next one starts from it. */
 
     // --- Uniform Resources ---
     VkBuffer uniformBuffer;
@@ -120,10 +372,66 @@ private:
     // --- Graphics Pipeline State ---
     VkPipelineLayout graphicsPipelineLayout;
     VkPipeline graphicsPipeline;
+    VkPipeline oitPipeline{ VK_NULL_HANDLE };
+
+    // --- Spark Light Readback (optional, see enableLightReadback) ---
+    VkDescriptorSetLayout selectSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool selectDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet selectDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout selectPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline selectPipeline{ VK_NULL_HANDLE };
+    VkBuffer sparkBuffer{ VK_NULL_HANDLE };              /**< Device-local reduction output, one sample per light. */
+    VkDeviceMemory sparkBufferMemory{ VK_NULL_HANDLE };
+    VkBuffer readbackBuffer{ VK_NULL_HANDLE };           /**< Host-visible ring, one slot per frame in flight. */
+    VkDeviceMemory readbackMemory{ VK_NULL_HANDLE };
+    void* readbackMapped{ nullptr };
+    uint32_t readbackSlots{ 0U };
+
+    // --- Depth Sort (optional, see enableDepthSort) ---
+    bool depthSortRequested{ false };
+    bool drawSorted{ false };
+    uint32_t sortCount{ 0U };                            /**< Entries sorted: the count padded to a power of two. */
+    VkBuffer sortKeyBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory sortKeyMemory{ VK_NULL_HANDLE };
+    VkBuffer sortIndexBuffer{ VK_NULL_HANDLE };          /**< Sort payload; its first (live count) entries are the draw's indices. */
+    VkDeviceMemory sortIndexMemory{ VK_NULL_HANDLE };
+    VkDescriptorSetLayout sortSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool sortDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet sortDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout sortPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline sortPipeline{ VK_NULL_HANDLE };
+    std::unique_ptr<GpuFrameTimer> sortTimer{};
+
+    // --- Host Simulation (see CpuParticleSimulator) ---
+    std::optional<CpuParticleSimulator::Effect> hostEffect{};   /**< Kernel of the shader set, if it has a host port. */
+    std::unique_ptr<CpuParticleSimulator> hostSimulator{};      /**< Created by the first host update. */
+    bool hostSimulation{ false };
 
     // --- Internal Initialization Helpers ---
     void createBuffers(const glm::vec3& spawnPos);
+    void uploadDeviceLocal(const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+        VkBuffer& buffer, VkDeviceMemory& memory) const;
+    void appendListWrites(const VkDescriptorSet set, std::array<VkDescriptorBufferInfo, 2>& infos,
+        std::vector<VkWriteDescriptorSet>& writes) const;
+    static void recordComputeBarrier(const VkCommandBuffer commandBuffer, const VkPipelineStageFlags srcStages,
+        const VkPipelineStageFlags dstStages, const VkAccessFlags dstAccess);
+    std::vector<uint8_t> packParticles(const std::vector<Particle>& particles) const;
+    std::vector<Particle> unpackParticles(const uint8_t* const bytes) const;
+    VkDeviceSize getParticleBufferSize() const { return streams[streamCount - 1U].offset + streams[streamCount - 1U].size; }
+    void recordHostSimulation(const VkCommandBuffer commandBuffer, const CpuSimulationStep& params);
+    static void recordBufferUpdate(const VkCommandBuffer commandBuffer, const VkBuffer buffer, const VkDeviceSize offset,
+        const void* const data, const VkDeviceSize size);
+    void appendStreamWrites(const VkDescriptorSet set, const uint32_t firstBinding,
+        std::array<VkDescriptorBufferInfo, CompressedParticle::STREAM_COUNT>& infos, std::vector<VkWriteDescriptorSet>& writes) const;
     void createComputeDescriptors();
     void createComputePipeline(const std::string& path);
-    void createGraphicsPipeline(const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath);
+    void createGraphicsPipelineLayout();
+    void createSelectDescriptors();
+    void createSelectPipeline(const std::string& path);
+    void createSortDescriptors();
+    void createSortPipeline(const std::string& path);
+    void recordSortStep(const VkCommandBuffer commandBuffer, SortPushConstants& params, const uint32_t mode,
+        const uint32_t groupCount) const;
+    VkPipeline buildGraphicsPipeline(const VkRenderPass renderPass, const std::string& vPath, const std::string& fPath,
+        const bool weightedOIT) const;
 };
\ No newline at end of file
@@ -0,0 +1,400 @@
+#include "ParticleValidator.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "CommonStructs.h"
+#include "CpuParticleSimulator.h"
+#include "ParticleSystem.h"
+#include "SnowCover.h"
+#include "VulkanUtils.h"
+#include "WindField.h"
+
+namespace {
+    /**
+     * @struct ValidatedSet
+     * @brief A built-in shader set and the spawn volume of its scene emitter.
+     */
+    struct ValidatedSet {
+        const char* shaderSet;
+        glm::vec3 spawnPos;
+        float spawnRadius;
+    };
+
+    constexpr size_t FLOATS_PER_PARTICLE = sizeof(Particle) / sizeof(float);
+    constexpr VkFormat COLOR_FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;   // The HDR target the particles draw into
+    constexpr VkFormat DEPTH_FORMAT = VK_FORMAT_D32_SFLOAT;
+
+    // Camera above the globe, looking down at its centre; the wall is a plane of constant view distance
+    const glm::vec3 CAMERA_EYE(0.0f, 4.5f, 1.0f);
+    const glm::vec3 CAMERA_TARGET(0.0f, -0.3f, 0.0f);
+    constexpr float CAMERA_FOV_DEGREES = 60.0f;
+    constexpr float CAMERA_NEAR = 0.1f;
+    constexpr float CAMERA_FAR = 100.0f;
+
+    /**
+     * @struct ValidationScene
+     * @brief The global set of the validation and what it points at; released on every exit path.
+     */
+    struct ValidationScene {
+        VulkanContext* context{ nullptr };
+        VkRenderPass renderPass{ VK_NULL_HANDLE };
+        VkBuffer uniformBuffer{ VK_NULL_HANDLE };
+        VkDeviceMemory uniformMemory{ VK_NULL_HANDLE };
+        VkImage depthImage{ VK_NULL_HANDLE };
+        VkDeviceMemory depthMemory{ VK_NULL_HANDLE };
+        VkImageView depthView{ VK_NULL_HANDLE };
+        VkSampler depthSampler{ VK_NULL_HANDLE };
+        std::unique_ptr<WindField> windField{};
+        std::unique_ptr<SnowCover> snowCover{};
+        VkDescriptorSet sceneSet{ VK_NULL_HANDLE };
+        CpuParticleScene host{};
+
+        explicit ValidationScene(VulkanContext* const ctx) : context(ctx) {}
+
+        ~ValidationScene() {
+            static_cast<void>(vkDeviceWaitIdle(context->device));
+            if (sceneSet != VK_NULL_HANDLE) {
+                static_cast<void>(vkFreeDescriptorSets(context->device, context->descriptorPool, EngineConstants::COUNT_ONE, &sceneSet));
+            }
+            vkDestroySampler(context->device, depthSampler, nullptr);
+            vkDestroyImageView(context->device, depthView, nullptr);
+            vkDestroyImage(context->device, depthImage, nullptr);
+            vkFreeMemory(context->device, depthMemory, nullptr);
+            vkDestroyBuffer(context->device, uniformBuffer, nullptr);
+            vkFreeMemory(context->device, uniformMemory, nullptr);
+            vkDestroyRenderPass(context->device, renderPass, nullptr);
+        }
+
+        ValidationScene(const ValidationScene&) = delete;
+        ValidationScene& operator=(const ValidationScene&) = delete;
+    };
+
+    /**
+     * @brief Creates a pass shaped like the transparent pass (multisampled HDR colour and depth) for the particle pipelines.
+     * Nothing is drawn; the pipelines only need a compatible pass to be built against.
+     */
+    VkRenderPass createRenderPass(const VkDevice device) {
+        VkAttachmentDescription colorAttachment{};
+        colorAttachment.format = COLOR_FORMAT;
+        colorAttachment.samples = ParticleValidator::SCENE_SAMPLES;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentDescription depthAttachment = colorAttachment;
+        depthAttachment.format = DEPTH_FORMAT;
+        depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        const VkAttachmentReference colorRef{ 0U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        const VkAttachmentReference depthRef{ 1U, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = EngineConstants::COUNT_ONE;
+        subpass.pColorAttachments = &colorRef;
+        subpass.pDepthStencilAttachment = &depthRef;
+
+        const std::array<VkAttachmentDescription, 2U> attachments = { colorAttachment, depthAttachment };
+        VkRenderPassCreateInfo renderPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
+        renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        renderPassInfo.pAttachments = attachments.data();
+        renderPassInfo.subpassCount = EngineConstants::COUNT_ONE;
+        renderPassInfo.pSubpasses = &subpass;
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+            throw std::runtime_error("ParticleValidator: Failed to create render pass!");
+        }
+        return renderPass;
+    }
+
+    /**
+     * @brief Creates the multisampled scene depth and clears every sample to the wall's depth.
+     */
+    void createWallDepth(ValidationScene& scene, const float wallDepth) {
+        VulkanContext* const ctx = scene.context;
+        VulkanUtils::createImage(ctx->device, ctx->physicalDevice, ParticleValidator::DEPTH_EXTENT, ParticleValidator::DEPTH_EXTENT,
+            EngineConstants::COUNT_ONE, ParticleValidator::SCENE_SAMPLES, DEPTH_FORMAT, VK_IMAGE_TILING_OPTIMAL,
+            (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            scene.depthImage, scene.depthMemory);
+        scene.depthView = VulkanUtils::createImageView(ctx->device, scene.depthImage, DEPTH_FORMAT, VK_IMAGE_ASPECT_DEPTH_BIT,
+            EngineConstants::COUNT_ONE);
+        VulkanUtils::createTextureSampler(ctx->device, scene.depthSampler, EngineConstants::COUNT_ONE);
+
+        // Cleared, then left in the layout the renderer binds its depth in
+        const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(ctx->device, ctx->graphicsCommandPool);
+        VulkanUtils::recordImageBarrier(cb, scene.depthImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0U, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            EngineConstants::COUNT_ONE, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        const VkClearDepthStencilValue wall{ wallDepth, 0U };
+        VkImageSubresourceRange range{};
+        range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        range.levelCount = EngineConstants::COUNT_ONE;
+        range.layerCount = EngineConstants::COUNT_ONE;
+        vkCmdClearDepthStencilImage(cb, scene.depthImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &wall, EngineConstants::COUNT_ONE, &range);
+
+        VulkanUtils::recordImageBarrier(cb, scene.depthImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            EngineConstants::COUNT_ONE, VK_IMAGE_ASPECT_DEPTH_BIT);
+        VulkanUtils::endSingleTimeCommands(ctx->device, ctx->graphicsCommandPool, ctx->graphicsQueue, cb);
+
+        scene.host.sceneDepth.assign(static_cast<size_t>(ParticleValidator::DEPTH_EXTENT) * ParticleValidator::DEPTH_EXTENT, wallDepth);
+        scene.host.depthRowLength = ParticleValidator::DEPTH_EXTENT;
+    }
+
+    /**
+     * @brief Builds a stormy wind field with the fire's updraft and hands its contents to the host scene.
+     */
+    void createWind(ValidationScene& scene, const glm::vec3& firePos) {
+        VulkanContext* const ctx = scene.context;
+        scene.windField = std::make_unique<WindField>(ctx, WindField::DEFAULT_RESOLUTION, EngineConstants::COUNT_ONE);
+        if (!scene.windField->canUpdate()) {
+            throw std::runtime_error("ParticleValidator: The wind field pipeline is unavailable!");
+        }
+
+        const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(ctx->device, ctx->graphicsCommandPool);
+        scene.windField->recordUpdate(cb, 1.0f, ParticleValidator::WIND_PHASE, firePos, true);
+        VulkanUtils::endSingleTimeCommands(ctx->device, ctx->graphicsCommandPool, ctx->graphicsQueue, cb);
+
+        scene.windField->readBack(scene.host.windField);
+        scene.host.windResolution = scene.windField->getResolution();
+        scene.host.windStrength = WindField::DEFAULT_STRENGTH;
+    }
+
+    /**
+     * @brief Builds the validation's global set: the camera and wind in the scene UBO, the wall, the snow cover and the wind field.
+     */
+    void createScene(ValidationScene& scene, const glm::vec3& firePos) {
+        VulkanContext* const ctx = scene.context;
+        scene.renderPass = createRenderPass(ctx->device);
+
+        // Step 1: The camera the wall's depth is rendered with, and its distance as a depth value
+        const glm::mat4 view = glm::lookAt(CAMERA_EYE, CAMERA_TARGET, glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 proj = glm::perspective(glm::radians(CAMERA_FOV_DEGREES), 1.0f, CAMERA_NEAR, CAMERA_FAR);
+        proj[1][1] *= -1.0f;
+        const float wallDepth = (proj[3][2] / ParticleValidator::WALL_DISTANCE) - proj[2][2];
+
+        scene.host.depthViewProj = proj * view;
+        scene.host.depthParams = glm::vec4(static_cast<float>(ParticleValidator::DEPTH_EXTENT),
+            static_cast<float>(ParticleValidator::DEPTH_EXTENT), proj[2][2], proj[3][2]);
+
+        // Step 2: Resources
+        createWallDepth(scene, wallDepth);
+        createWind(scene, firePos);
+        scene.snowCover = std::make_unique<SnowCover>(ctx);
+
+        UniformBufferObject ubo{};
+        ubo.view = view;
+        ubo.proj = proj;
+        ubo.viewPos = CAMERA_EYE;
+        ubo.depthViewProj = scene.host.depthViewProj;
+        ubo.depthParams = scene.host.depthParams;
+        ubo.windStrength = scene.host.windStrength;
+
+        VulkanUtils::createBuffer(ctx->device, ctx->physicalDevice, static_cast<VkDeviceSize>(sizeof(UniformBufferObject)),
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+            scene.uniformBuffer, scene.uniformMemory);
+        void* mapped = nullptr;
+        static_cast<void>(vkMapMemory(ctx->device, scene.uniformMemory, 0ULL, sizeof(UniformBufferObject), 0U, &mapped));
+        static_cast<void>(std::memcpy(mapped, &ubo, sizeof(UniformBufferObject)));
+        vkUnmapMemory(ctx->device, scene.uniformMemory);
+
+        // Step 3: The bindings the simulations read; the shadow map and refraction bindings stay unwritten (draw-only)
+        VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+        allocInfo.descriptorPool = ctx->descriptorPool;
+        allocInfo.descriptorSetCount = EngineConstants::COUNT_ONE;
+        allocInfo.pSetLayouts = &ctx->globalSetLayout;
+        if (vkAllocateDescriptorSets(ctx->device, &allocInfo, &scene.sceneSet) != VK_SUCCESS) {
+            throw std::runtime_error("ParticleValidator: Failed to allocate the scene set!");
+        }
+
+        const VkDescriptorBufferInfo bInfo{ scene.uniformBuffer, 0U, sizeof(UniformBufferObject) };
+        const VkDescriptorImageInfo dInfo{ scene.depthSampler, scene.depthView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+        const VkDescriptorBufferInfo cInfo{ scene.snowCover->getBuffer(), 0U, VK_WHOLE_SIZE };
+        const VkDescriptorImageInfo wInfo{ scene.windField->getSampler(), scene.windField->getImageView(), VK_IMAGE_LAYOUT_GENERAL };
+
+        std::array<VkWriteDescriptorSet, 4U> writes{};
+        writes[0] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, scene.sceneSet, EngineConstants::BINDING_UBO, 0U, 1U, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bInfo, nullptr };
+        writes[1] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, scene.sceneSet, EngineConstants::BINDING_SCENE_DEPTH, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &dInfo, nullptr, nullptr };
+        writes[2] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, scene.sceneSet, EngineConstants::BINDING_SNOW_COVER, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &cInfo, nullptr };
+        writes[3] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, scene.sceneSet, EngineConstants::BINDING_WIND_FIELD, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &wInfo, nullptr, nullptr };
+        vkUpdateDescriptorSets(ctx->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
+    }
+
+    /**
+     * @brief Returns the largest difference of two particles, scaled so that 1 is the tolerance.
+     */
+    float scaledError(const Particle& gpu, const Particle& cpu, float& maxError) {
+        std::array<float, FLOATS_PER_PARTICLE> a{};
+        std::array<float, FLOATS_PER_PARTICLE> b{};
+        static_cast<void>(std::memcpy(a.data(), &gpu, sizeof(Particle)));
+        static_cast<void>(std::memcpy(b.data(), &cpu, sizeof(Particle)));
+
+        float worst = 0.0f;
+        for (size_t i = 0U; i < FLOATS_PER_PARTICLE; ++i) {
+            const float error = std::fabs(a[i] - b[i]);
+            const float tolerance = ParticleValidator::ABSOLUTE_TOLERANCE + (ParticleValidator::RELATIVE_TOLERANCE * std::fabs(a[i]));
+            maxError = std::max(maxError, error);
+            worst = std::max(worst, error / tolerance);
+        }
+        return worst;
+    }
+}
+
+// ========================================================================
+// SECTION 1: VALIDATION
+// ========================================================================
+
+/**
+ * @brief Builds the scene, steps every set on both sides in lockstep and counts the particles that disagree.
+ */
+std::vector<ParticleValidationResult> ParticleValidator::run(VulkanContext* const ctx, const uint32_t steps) {
+    static const std::array<ValidatedSet, 5> sets = { {
+        { "dust", glm::vec3(0.0f, 1.2f, 0.0f), 0.6f },
+        { "fire", glm::vec3(-0.8f, -0.15f, -0.5f), 0.01f },
+        { "smoke", glm::vec3(-0.8f, -0.15f, -0.5f), 0.025f },
+        { "rain", glm::vec3(0.0f, 1.8f, 0.0f), 1.65f },
+        { "snow", glm::vec3(0.0f, 1.8f, 0.0f), 1.65f }
+    } };
+
+    std::vector<ParticleValidationResult> results{};
+
+    // Step 1: Nothing else may touch the queue while the systems are read back; the fire set's emitter feeds the updraft
+    static_cast<void>(vkDeviceWaitIdle(ctx->device));
+    ValidationScene scene(ctx);
+    createScene(scene, sets[1].spawnPos);
+
+    for (const ValidatedSet& set : sets) {
+        EmitterDefinition emitter{};
+        emitter.shaderSet = set.shaderSet;
+        emitter.spawnPos = set.spawnPos;
+        emitter.spawnRadius = set.spawnRadius;
+        emitter.count = PARTICLE_COUNT;
+
+        // Step 2: A private system, so the scene's buffers are left untouched; its budget refills every dead particle
+        const std::unique_ptr<ParticleSystem> system =
+            std::make_unique<ParticleSystem>(ctx, scene.renderPass, ctx->globalSetLayout, emitter, SCENE_SAMPLES);
+        CpuParticleSimulator cpu(CpuParticleSimulator::effectOf(set.shaderSet).value(), PARTICLE_COUNT, set.spawnRadius, PARTICLE_COUNT);
+
+        ParticleValidationResult result{};
+        result.shaderSet = set.shaderSet;
+        result.particles = PARTICLE_COUNT;
+        result.steps = steps;
+        result.avx2 = cpu.usesAvx2();
+
+        std::vector<Particle> gpuState{};
+        std::vector<uint32_t> gpuAlive{};
+        system->readBack(gpuState, gpuAlive);
+        std::vector<uint32_t> coverBefore{};
+        scene.snowCover->readBack(coverBefore);
+
+        CpuSimulationStep params{};
+        params.emitterPos = set.spawnPos;
+        params.scene = &scene.host;
+        std::vector<uint8_t> aliveOnCpu(PARTICLE_COUNT, 0U);
+        std::vector<uint8_t> aliveOnGpu(PARTICLE_COUNT, 0U);
+
+        for (uint32_t step = 0U; step < steps; ++step) {
+            // Step 3: Both sides start from the device's state and take the same step
+            cpu.reset(gpuState, gpuAlive);
+            params.deltaTime = STEP_SECONDS;
+            params.totalTime += STEP_SECONDS;
+
+            const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(ctx->device, ctx->graphicsCommandPool);
+            system->update(cb, params.deltaTime, params.spawnEnabled, params.totalTime, params.lightColor, params.emitterPos, scene.sceneSet);
+            VulkanUtils::endSingleTimeCommands(ctx->device, ctx->graphicsCommandPool, ctx->graphicsQueue, cb);
+            cpu.step(params);
+            system->readBack(gpuState, gpuAlive);
+
+            // Step 4: The lists are filled by atomics on the device, so membership is compared, not order
+            std::fill(aliveOnCpu.begin(), aliveOnCpu.end(), static_cast<uint8_t>(0U));
+            std::fill(aliveOnGpu.begin(), aliveOnGpu.end(), static_cast<uint8_t>(0U));
+            for (const uint32_t index : cpu.getAliveList()) {
+                aliveOnCpu[index] = 1U;
+            }
+            for (const uint32_t index : gpuAlive) {
+                aliveOnGpu[index] = 1U;
+            }
+
+            const std::vector<Particle>& cpuState = cpu.getParticles();
+            for (uint32_t i = 0U; i < PARTICLE_COUNT; ++i) {
+                if ((aliveOnCpu[i] == 0U) && (aliveOnGpu[i] == 0U)) {
+                    continue;
+                }
+                ++result.compared;
+                if (aliveOnCpu[i] != aliveOnGpu[i]) {
+                    ++result.aliveMismatches;
+                    ++result.mismatched;
+                }
+                else if (scaledError(gpuState[i], cpuState[i], result.maxError) > 1.0f) {
+                    ++result.mismatched;
+                }
+            }
+        }
+
+        // Step 5: Snow the device deposited during this set against the host's; a flake in another cell counts twice
+        std::vector<uint32_t> coverAfter{};
+        scene.snowCover->readBack(coverAfter);
+        const std::vector<uint32_t>& cpuCover = cpu.getSnowCover();
+        uint64_t coverDifference = 0U;
+        for (size_t cell = 0U; cell < coverAfter.size(); ++cell) {
+            const int64_t gpuUnits = static_cast<int64_t>(coverAfter[cell]) - static_cast<int64_t>(coverBefore[cell]);
+            result.settled += static_cast<uint64_t>(gpuUnits) / SnowCover::UNITS_PER_FLAKE;
+            coverDifference += static_cast<uint64_t>(std::llabs(gpuUnits - static_cast<int64_t>(cpuCover[cell])));
+        }
+        result.settledMismatches = coverDifference / SnowCover::UNITS_PER_FLAKE;
+
+        // A flake that settles on one side only is also alive on one side only; the fraction covers flakes on a cell border
+        const double allowed = MAX_MISMATCH_FRACTION * static_cast<double>(result.compared);
+        const double allowedSettled = static_cast<double>(result.aliveMismatches) + (MAX_MISMATCH_FRACTION * static_cast<double>(result.settled));
+        result.passed = (result.compared > 0U) && (static_cast<double>(result.mismatched) <= allowed) &&
+            (static_cast<double>(result.settledMismatches) <= allowedSettled);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+// ========================================================================
+// SECTION 2: REPORTING
+// ========================================================================
+
+/**
+ * @brief Prints the device the simulations ran on, then the results in run order.
+ */
+bool ParticleValidator::report(std::ostream& out, VulkanContext* const ctx, const std::vector<ParticleValidationResult>& results) {
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(ctx->physicalDevice, &props);
+    const bool software = (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU);
+    out << "ParticleValidator: Device " << props.deviceName << (software ? " (software)" : " (hardware)") << std::endl;
+
+    bool passed = !results.empty();
+    for (const ParticleValidationResult& result : results) {
+        const double fraction = (result.compared > 0U) ? (static_cast<double>(result.mismatched) / static_cast<double>(result.compared)) : 0.0;
+        out << "ParticleValidator: " << std::left << std::setw(5) << result.shaderSet << std::right
+            << " | " << (result.passed ? "PASS" : "FAIL")
+            << " | " << result.particles << " particles x " << result.steps << " steps"
+            << " | " << result.mismatched << " of " << result.compared << " mismatched ("
+            << std::fixed << std::setprecision(3) << (fraction * 100.0) << "%, " << result.aliveMismatches << " alive on one side)"
+            << " | max error " << std::scientific << std::setprecision(2) << result.maxError
+            << std::defaultfloat << " | " << result.settled << " settled (" << result.settledMismatches << " off)"
+            << " | " << (result.avx2 ? "AVX2" : "scalar") << std::endl;
+        out << std::defaultfloat;
+        passed = passed && result.passed;
+    }
+    return passed;
+}
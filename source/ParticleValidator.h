@@ -0,0 +1,77 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+/**
+ * @struct ParticleValidationResult
+ * @brief Agreement of the compute simulation and its host port over one shader set.
+ * A particle-step counts as a mismatch when the particle is alive on one side only, or when any of
+ * its twelve floats differs by more than the tolerance.
+ */
+struct ParticleValidationResult final {
+    std::string shaderSet{ "" };
+    uint32_t particles{ 0U };
+    uint32_t steps{ 0U };
+    uint64_t compared{ 0U };       /**< Particle-steps compared (particles alive on either side). */
+    uint64_t mismatched{ 0U };
+    uint64_t aliveMismatches{ 0U }; /**< Of which alive on one side only. */
+    float maxError{ 0.0f };        /**< Largest difference of a particle alive on both sides. */
+    uint64_t settled{ 0U };        /**< Flakes the device deposited into the snow cover. */
+    uint64_t settledMismatches{ 0U }; /**< Flakes the two snow covers disagree on (missing or in another cell). */
+    bool avx2{ false };
+    bool passed{ false };
+};
+
+/**
+ * @class ParticleValidator
+ * @brief Runs each built-in simulation on the device and on the CPU (CpuParticleSimulator) and compares them.
+ * * Runs in lockstep: before every step the device state is read back and handed to the CPU, both
+ * advance one step with the same parameters, and the results are compared. The simulations hash
+ * positions into turbulence, so a rounding difference changes the next step's noise completely and
+ * free-running comparisons of fire drift apart within frames; one step at a time they agree.
+ * * Each set runs in a throw-away system that refills every dead particle each step. The validation
+ * builds the scene set itself: a stormy wind field with the fire's updraft, a scene depth that holds
+ * a wall across the globe (a plane at WALL_DISTANCE from a camera above it) and an empty snow cover.
+ * The host port gets the same field (read back), the same depth and camera, so the wind, the rain's
+ * collision and the snow that settles on the wall or the floor are validated too; the snow covers
+ * are compared at the end. Needs only a device (see HeadlessDevice) and idles it.
+ * * The kernels' hash() amplifies sin() by 43758, so the comparison needs a driver whose sin() is as
+ * exact as the host's: on SwiftShader, for one, the emission and the dust and fire kernels disagree
+ * from the first step, while the other kernels, the wind and the collision still agree.
+ */
+class ParticleValidator final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t DEFAULT_STEPS = 120U;
+    static constexpr uint32_t PARTICLE_COUNT = 4096U;
+    static constexpr float STEP_SECONDS = 1.0f / 60.0f;
+    static constexpr float ABSOLUTE_TOLERANCE = 2.0e-3f;
+    static constexpr float RELATIVE_TOLERANCE = 1.0e-3f;
+    static constexpr double MAX_MISMATCH_FRACTION = 0.005;   /**< Hash wrap-arounds flip the odd particle. */
+    static constexpr uint32_t DEPTH_EXTENT = 256U;           /**< Scene depth pixels per side. */
+    static constexpr VkSampleCountFlagBits SCENE_SAMPLES = VK_SAMPLE_COUNT_4_BIT;   /**< As the renderer's multisampled depth; 4 is always supported. */
+    static constexpr float WALL_DISTANCE = 4.4f;             /**< View distance of the wall, just above the globe's centre. */
+    static constexpr float WIND_PHASE = 1.5f;
+
+    /**
+     * @brief Validates the five built-in shader sets over the given number of steps.
+     * Throws if a system or the scene cannot be built (e.g. shaders are missing).
+     */
+    static std::vector<ParticleValidationResult> run(VulkanContext* const ctx, const uint32_t steps = DEFAULT_STEPS);
+
+    /** @brief Writes the device and one line per set; returns true if every set passed. */
+    static bool report(std::ostream& out, VulkanContext* const ctx, const std::vector<ParticleValidationResult>& results);
+
+private:
+    // Static utility class: Constructor and Destructor are private to prevent instantiation.
+    ParticleValidator() = default;
+    ~ParticleValidator() = default;
+};
@@ -0,0 +1,117 @@
+/* parasoft-begin-suppress ALL */
+#include "PassWorkerPool.h"
+#include <algorithm>
+#include <system_error>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Constructor: Starts the workers; if the OS refuses, the remaining jobs run inline.
+ */
+PassWorkerPool::PassWorkerPool(const uint32_t inWorkerCount) {
+    threads.reserve(static_cast<size_t>(inWorkerCount));
+    for (uint32_t i = 0U; i < inWorkerCount; ++i) {
+        try {
+            threads.emplace_back(&PassWorkerPool::workerLoop, this, i);
+        }
+        catch (const std::system_error&) {
+            break; // Thread exhaustion: run() records the unserved jobs on the calling thread
+        }
+    }
+}
+
+/**
+ * @brief Destructor: Wakes every worker for shutdown and joins them.
+ */
+PassWorkerPool::~PassWorkerPool() {
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+/**
+ * @brief Runs job i on worker i and blocks until all jobs have finished.
+ */
+void PassWorkerPool::run(const std::vector<std::function<void()>>& jobs) {
+    if (jobs.empty()) {
+        return;
+    }
+
+    const uint32_t threaded = std::min(static_cast<uint32_t>(jobs.size()), getThreadCount());
+
+    // Step 1: Publish the jobs to the workers
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        activeJobs = &jobs;
+        errors.assign(jobs.size(), nullptr);
+        pending = threaded;
+        ++generation;
+    }
+    wake.notify_all();
+
+    // Step 2: Jobs without a worker run here
+    for (size_t i = threaded; i < jobs.size(); ++i) {
+        try {
+            jobs[i]();
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+
+    // Step 3: Wait for the workers, then surface the lowest-indexed failure
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return pending == 0U; });
+    activeJobs = nullptr;
+
+    for (const std::exception_ptr& error : errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief Worker body: sleeps until a new generation is published, runs its job, reports back.
+ */
+void PassWorkerPool::workerLoop(const uint32_t index) {
+    uint64_t seenGeneration{ 0U };
+
+    for (;;) {
+        const std::function<void()>* job{ nullptr };
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seenGeneration]() { return stopping || (generation != seenGeneration); });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            if ((activeJobs == nullptr) || (index >= activeJobs->size())) {
+                continue; // Fewer jobs than workers this generation
+            }
+            job = &(*activeJobs)[index];
+        }
+
+        std::exception_ptr error{ nullptr };
+        try {
+            (*job)();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            errors[index] = error;
+            --pending;
+        }
+        finished.notify_one();
+    }
+}
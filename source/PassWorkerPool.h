@@ -0,0 +1,64 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class PassWorkerPool
+ * @brief Persistent worker threads that run one recording job each per frame.
+ * * Unlike PipelineBuildQueue, which spins threads up for a one-off batch, these workers live for
+ * the whole session so per-frame dispatch costs a wake-up rather than a thread creation. Job i of
+ * every run() always lands on worker i, so per-worker Vulkan objects (command pools) are only ever
+ * touched by a single thread and need no further synchronization.
+ * * Failures are reported deterministically: every job runs to completion, then the failure of the
+ * lowest-indexed job is rethrown on the calling thread.
+ */
+class PassWorkerPool final {
+public:
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Starts the workers; if the OS refuses, the remaining jobs run inline. */
+    explicit PassWorkerPool(const uint32_t inWorkerCount);
+
+    /** @brief Destructor: Wakes every worker for shutdown and joins them. */
+    ~PassWorkerPool();
+
+    // RAII: Owns live threads; prevent duplication.
+    PassWorkerPool(const PassWorkerPool&) = delete;
+    PassWorkerPool& operator=(const PassWorkerPool&) = delete;
+
+    // --- Core API ---
+
+    /**
+     * @brief Runs job i on worker i and blocks until all jobs have finished.
+     * @throws The exception of the lowest-indexed job that failed.
+     */
+    void run(const std::vector<std::function<void()>>& jobs);
+
+    /** @brief Returns the number of threads actually started. */
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(threads.size()); }
+
+private:
+    /** @brief Worker body: sleeps until a new generation is published, runs its job, reports back. */
+    void workerLoop(const uint32_t index);
+
+    // --- Threads & Signalling ---
+    std::vector<std::thread> threads{};
+    std::mutex mutex{};
+    std::condition_variable wake{};
+    std::condition_variable finished{};
+
+    // --- Current Dispatch (guarded by mutex) ---
+    const std::vector<std::function<void()>>* activeJobs{ nullptr };
+    std::vector<std::exception_ptr> errors{};
+    uint64_t generation{ 0U };
+    uint32_t pending{ 0U };
+    bool stopping{ false };
+};
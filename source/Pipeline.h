@@ -10,6 +10,7 @@
 #include "Vertex.h"
 #include "ShaderModule.h"
 #include "VulkanContext.h"
+#include "VulkanUtils.h"
 
 /**
  * @class Pipeline
@@ -23,25 +24,30 @@ public:
     static constexpr uint32_t VIEWPORT_COUNT_ONE = 1U;
     static constexpr uint32_t SCISSOR_COUNT_ONE = 1U;
     static constexpr uint32_t ATTACHMENT_COUNT_ONE = 1U;
-    static constexpr uint32_t PUSH_CONSTANT_COUNT = 1U;
     static constexpr uint32_t PIPELINE_COUNT_ONE = 1U;
 
     static constexpr uint32_t SET_INDEX_GLOBAL = 0U;
     static constexpr uint32_t SET_INDEX_MATERIAL = 1U;
-    static constexpr uint32_t LAYOUT_SET_COUNT = 2U;
+    static constexpr uint32_t SET_INDEX_OBJECTS = 2U;
+    static constexpr uint32_t LAYOUT_SET_COUNT = 3U;
 
     static constexpr float    DEFAULT_LINE_WIDTH = 1.0f;
-    static constexpr uint32_t PUSH_CONSTANT_OFFSET = 0U;
 
 private:
     VulkanContext* context{ nullptr };
     VkPipeline        pipeline{ VK_NULL_HANDLE };
     VkPipelineLayout  pipelineLayout{ VK_NULL_HANDLE };
     VkDescriptorSetLayout materialLayout{ VK_NULL_HANDLE };
+    VkDescriptorSetLayout objectLayout{ VK_NULL_HANDLE };
+    bool blendingEnabled{ false };
 
 public:
     /**
      * @brief Constructs a specialized graphics pipeline.
+     * Every layout is (Global, Material, Objects) with no push constants, so CPU and GPU-driven
+     * draws share pipelines and bound sets survive pipeline switches.
+     * Depth pre-pass variants disable colour writes; the colour pass after them tests EQUAL.
+     * Weighted OIT variants write the accumulation and revealage targets of the OIT pass.
      */
     Pipeline(
         VulkanContext* const inContext,
@@ -52,8 +58,11 @@ public:
         const bool enableCulling = true,
         const bool enableBlending = false,
         const bool enableDepthWrite = true,
-        const VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT
-    ) : context(inContext), materialLayout(inMaterialLayout)
+        const VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT,
+        const VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS,
+        const bool enableColorWrite = true,
+        const bool weightedOIT = false
+    ) : context(inContext), materialLayout(inMaterialLayout), objectLayout(inContext->objectSetLayout), blendingEnabled(enableBlending)
     {
         // 1. Shader Stages Initialization
         std::vector<VkPipelineShaderStageCreateInfo> shaderStages{};
@@ -107,12 +116,13 @@ public:
         VkPipelineDepthStencilStateCreateInfo depthStencil{ VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO };
         depthStencil.depthTestEnable = VK_TRUE;
         depthStencil.depthWriteEnable = enableDepthWrite ? VK_TRUE : VK_FALSE;
-        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+        depthStencil.depthCompareOp = depthCompareOp;
 
         // 7. Color Blending Logic
         VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-            VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.colorWriteMask = enableColorWrite
+            ? (VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT)
+            : 0U;
         if (enableBlending) {
             colorBlendAttachment.blendEnable = VK_TRUE;
             colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
@@ -123,27 +133,22 @@ public:
             colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
         }
 
+        const std::array<VkPipelineColorBlendAttachmentState, 2U> oitBlendAttachments = VulkanUtils::prepareWeightedOitBlend();
+
         VkPipelineColorBlendStateCreateInfo colorBlending{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
-        colorBlending.attachmentCount = ATTACHMENT_COUNT_ONE;
-        colorBlending.pAttachments = &colorBlendAttachment;
-
-        // 8. Pipeline Layout (Global UBO + Material Set + Push Constants)
-        const VkPushConstantRange pushConstantRange{
-            VK_SHADER_STAGE_VERTEX_BIT,
-            PUSH_CONSTANT_OFFSET,
-            static_cast<uint32_t>(sizeof(glm::mat4))
-        };
+        colorBlending.attachmentCount = weightedOIT ? static_cast<uint32_t>(oitBlendAttachments.size()) : ATTACHMENT_COUNT_ONE;
+        colorBlending.pAttachments = weightedOIT ? oitBlendAttachments.data() : &colorBlendAttachment;
 
+        // 8. Pipeline Layout (Global UBO + Material Set + Object Set; matrices come from Set 2)
         const std::array<VkDescriptorSetLayout, LAYOUT_SET_COUNT> layouts = {
             context->globalSetLayout,
-            materialLayout
+            materialLayout,
+            objectLayout
         };
 
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
+        pipelineLayoutInfo.setLayoutCount = LAYOUT_SET_COUNT;
         pipelineLayoutInfo.pSetLayouts = layouts.data();
-        pipelineLayoutInfo.pushConstantRangeCount = PUSH_CONSTANT_COUNT;
-        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
         if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
             throw std::runtime_error("Pipeline: Failed to create pipeline layout!");
@@ -164,7 +169,7 @@ public:
         pipelineInfo.layout = pipelineLayout;
         pipelineInfo.renderPass = renderPass;
 
-        if (vkCreateGraphicsPipelines(context->device, VK_NULL_HANDLE, PIPELINE_COUNT_ONE, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        if (context->pipelineCache.createGraphicsPipelines(PIPELINE_COUNT_ONE, &pipelineInfo, &pipeline) != VK_SUCCESS) {
             throw std::runtime_error("Pipeline: Failed to create graphics pipeline!");
         }
     }
@@ -193,10 +198,13 @@ public:
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     }
 
-    /** @brief Returns the layout for descriptor and push constant mapping. */
+    /** @brief Returns true if this pipeline alpha-blends, i.e. its draws are order-dependent. */
+    bool isBlended() const { return blendingEnabled; }
+
+    /** @brief Returns the layout for descriptor set mapping. */
     VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
 
-    /** @brief Returns a specific set layout based on index (0: Global, 1: Material). */
+    /** @brief Returns a specific set layout based on index (0: Global, 1: Material, 2: Objects). */
     VkDescriptorSetLayout getDescriptorSetLayout(const uint32_t setIndex) const {
         VkDescriptorSetLayout layout{ VK_NULL_HANDLE };
 
@@ -206,6 +214,9 @@ public:
         else if (setIndex == SET_INDEX_MATERIAL) {
             layout = materialLayout;
         }
+        else if (setIndex == SET_INDEX_OBJECTS) {
+            layout = objectLayout;
+        }
 
         return layout;
     }
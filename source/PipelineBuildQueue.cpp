@@ -0,0 +1,121 @@
+/* parasoft-begin-suppress ALL */
+#include "PipelineBuildQueue.h"
+#include "PipelineCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Constructor: Sets the worker budget used by execute().
+ */
+PipelineBuildQueue::PipelineBuildQueue(const uint32_t inWorkerCount)
+    : workerCount(inWorkerCount)
+{
+}
+
+/**
+ * @brief Queues a named build job; the name is used in error reports.
+ */
+void PipelineBuildQueue::submit(const std::string& name, std::function<void()> job) {
+    if (job) {
+        jobs.push_back(Job{ name, std::move(job), nullptr });
+    }
+}
+
+/**
+ * @brief Resolves the worker budget against the job count and hardware concurrency.
+ */
+uint32_t PipelineBuildQueue::resolveWorkerCount() const {
+    uint32_t budget = workerCount;
+    if (budget == AUTO_WORKER_COUNT) {
+        budget = std::max(SERIAL_WORKER_COUNT, static_cast<uint32_t>(std::thread::hardware_concurrency()));
+    }
+    return std::min(budget, static_cast<uint32_t>(jobs.size()));
+}
+
+/**
+ * @brief Runs every queued job and blocks until all have finished.
+ */
+void PipelineBuildQueue::execute(const PipelineCache* const cache) {
+    if (jobs.empty()) {
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    const double cacheMsBefore = (cache != nullptr) ? cache->getBuildMilliseconds() : 0.0;
+    const uint32_t threads = resolveWorkerCount();
+
+    // Step 1: Workers pull the next unclaimed job; exceptions are parked in the job's own slot
+    std::atomic<size_t> nextJob{ 0U };
+    const auto worker = [this, &nextJob]() {
+        for (size_t i = nextJob.fetch_add(1U); i < jobs.size(); i = nextJob.fetch_add(1U)) {
+            try {
+                jobs[i].work();
+            }
+            catch (...) {
+                jobs[i].error = std::current_exception();
+            }
+        }
+    };
+
+    // Step 2: The calling thread participates, so a budget of one is a true serial baseline
+    std::vector<std::thread> pool{};
+    pool.reserve(static_cast<size_t>(threads - 1U));
+    for (uint32_t t = 1U; t < threads; ++t) {
+        try {
+            pool.emplace_back(worker);
+        }
+        catch (const std::system_error&) {
+            break; // Thread exhaustion: the remaining workers absorb the jobs
+        }
+    }
+    const size_t activeWorkers = pool.size() + 1U;
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    const double wallMs = std::chrono::duration<double, std::chrono::seconds::period>(
+        std::chrono::high_resolution_clock::now() - start).count() * MILLIS_PER_SECOND;
+
+    std::cout << "PipelineBuildQueue: Built " << jobs.size() << " jobs on " << activeWorkers
+        << " worker(s) in " << wallMs << " ms";
+    if (cache != nullptr) {
+        std::cout << " (" << (cache->getBuildMilliseconds() - cacheMsBefore) << " ms of driver compile time)";
+    }
+    std::cout << "." << std::endl;
+
+    // Step 3: Report the earliest submitted failure so errors do not depend on thread scheduling
+    std::vector<Job> finished = std::move(jobs);
+    jobs.clear();
+
+    size_t failureCount{ 0U };
+    const Job* firstFailure{ nullptr };
+    for (const Job& job : finished) {
+        if (job.error != nullptr) {
+            ++failureCount;
+            if (firstFailure == nullptr) {
+                firstFailure = &job;
+            }
+        }
+    }
+
+    if (firstFailure != nullptr) {
+        std::string detail{ "unknown error" };
+        try {
+            std::rethrow_exception(firstFailure->error);
+        }
+        catch (const std::exception& e) {
+            detail = e.what();
+        }
+        catch (...) {}
+
+        throw std::runtime_error("PipelineBuildQueue: Job '" + firstFailure->name + "' failed -> " + detail +
+            " (" + std::to_string(failureCount) + " of " + std::to_string(finished.size()) + " jobs failed)");
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+class PipelineCache;
+
+/**
+ * @class PipelineBuildQueue
+ * @brief Collects independent pipeline build jobs and compiles them concurrently on a worker pool.
+ * * Jobs only create device objects (shader modules, layouts, pipelines), which Vulkan allows from
+ * any thread; the shared VkPipelineCache is internally synchronized. Each job must write to its own
+ * destination and must not touch queues, command pools or the deletion queue.
+ * * Failures are reported deterministically: every job runs to completion, then the failure of the
+ * earliest submitted job is rethrown regardless of which worker hit it first.
+ */
+class PipelineBuildQueue final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t AUTO_WORKER_COUNT = 0U;   /**< Use one worker per hardware thread. */
+    static constexpr uint32_t SERIAL_WORKER_COUNT = 1U; /**< Build on the calling thread only. */
+    static constexpr double   MILLIS_PER_SECOND = 1000.0;
+
+    // --- Lifecycle ---
+
+    /**
+     * @brief Constructor: Sets the worker budget used by execute().
+     * @param inWorkerCount AUTO_WORKER_COUNT for hardware concurrency, SERIAL_WORKER_COUNT for a serial baseline.
+     */
+    explicit PipelineBuildQueue(const uint32_t inWorkerCount = AUTO_WORKER_COUNT);
+
+    /** @brief Destructor: Pending jobs that were never executed are discarded. */
+    ~PipelineBuildQueue() = default;
+
+    // RAII: Jobs capture raw destinations; a copy would build them twice.
+    PipelineBuildQueue(const PipelineBuildQueue&) = delete;
+    PipelineBuildQueue& operator=(const PipelineBuildQueue&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Queues a named build job; the name is used in error reports. */
+    void submit(const std::string& name, std::function<void()> job);
+
+    /**
+     * @brief Runs every queued job and blocks until all have finished.
+     * @param cache Optional shared cache whose build statistics are included in the log.
+     * @throws std::runtime_error naming the earliest submitted job that failed.
+     */
+    void execute(const PipelineCache* const cache = nullptr);
+
+    /** @brief Returns the number of jobs awaiting execute(). */
+    size_t getPendingCount() const { return jobs.size(); }
+
+private:
+    /**
+     * @struct Job
+     * @brief A queued build and the exception it raised, if any.
+     */
+    struct Job {
+        std::string name;
+        std::function<void()> work;
+        std::exception_ptr error;
+    };
+
+    /** @brief Resolves the worker budget against the job count and hardware concurrency. */
+    uint32_t resolveWorkerCount() const;
+
+    // --- Internal State ---
+    uint32_t workerCount;
+    std::vector<Job> jobs{};
+};
@@ -0,0 +1,225 @@
+/* parasoft-begin-suppress ALL */
+#include "PipelineCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+namespace {
+    /** @brief Reads a little-endian uint32 field from the cache header. */
+    uint32_t readHeaderField(const std::vector<char>& blob, const uint32_t offset) {
+        uint32_t value{ 0U };
+        static_cast<void>(std::memcpy(&value, blob.data() + offset, sizeof(uint32_t)));
+        return value;
+    }
+
+    /** @brief Returns the elapsed nanoseconds since the given timestamp. */
+    uint64_t elapsedNanos(const std::chrono::high_resolution_clock::time_point start) {
+        const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+}
+
+// ========================================================================
+// SECTION 1: LIFECYCLE
+// ========================================================================
+
+/**
+ * @brief Creates the cache, seeding it from disk when the stored blob matches this device.
+ */
+void PipelineCache::init(const VkDevice logicalDevice, const VkPhysicalDevice physicalDevice, const std::string& path) {
+    this->device = logicalDevice;
+    this->cachePath = path;
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Step 1: Load the previous run's blob and reject it if it belongs to another device or driver
+    std::vector<char> blob = readBlob();
+    std::string reason{ "no cache file" };
+    warmStart = (!blob.empty()) && validateHeader(blob, reason);
+    if (!warmStart) {
+        blob.clear();
+    }
+
+    // Step 2: Create the cache; the driver performs its own validation of the payload
+    VkPipelineCacheCreateInfo createInfo{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    createInfo.initialDataSize = blob.size();
+    createInfo.pInitialData = blob.empty() ? nullptr : blob.data();
+
+    if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+        // A corrupt payload can still fail creation; fall back to an empty cache
+        createInfo.initialDataSize = 0U;
+        createInfo.pInitialData = nullptr;
+        warmStart = false;
+        reason = "driver rejected cache data";
+        if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+            throw std::runtime_error("PipelineCache: Failed to create pipeline cache!");
+        }
+    }
+
+    // Step 3: Report the outcome so cold and warm launches can be compared
+    const double loadMs = static_cast<double>(elapsedNanos(start)) / NANOS_PER_MILLI;
+    if (warmStart) {
+        std::cout << "PipelineCache: Hit - loaded " << blob.size() << " bytes from " << cachePath
+            << " in " << loadMs << " ms." << std::endl;
+    }
+    else {
+        std::cout << "PipelineCache: Miss (" << reason << ") - starting cold in " << loadMs << " ms." << std::endl;
+    }
+}
+
+/**
+ * @brief Destroys the cache handle and resets internal state.
+ */
+void PipelineCache::cleanup() {
+    if ((device != VK_NULL_HANDLE) && (cache != VK_NULL_HANDLE)) {
+        vkDestroyPipelineCache(device, cache, nullptr);
+    }
+    cache = VK_NULL_HANDLE;
+    device = VK_NULL_HANDLE;
+    warmStart = false;
+}
+
+// ========================================================================
+// SECTION 2: PIPELINE CONSTRUCTION
+// ========================================================================
+
+/**
+ * @brief Builds graphics pipelines against the shared cache and accounts the build time.
+ */
+VkResult PipelineCache::createGraphicsPipelines(const uint32_t count, const VkGraphicsPipelineCreateInfo* const infos, VkPipeline* const outPipelines) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    const VkResult result = vkCreateGraphicsPipelines(device, cache, count, infos, nullptr, outPipelines);
+    recordBuild(count, elapsedNanos(start));
+    return result;
+}
+
+/**
+ * @brief Builds compute pipelines against the shared cache and accounts the build time.
+ */
+VkResult PipelineCache::createComputePipelines(const uint32_t count, const VkComputePipelineCreateInfo* const infos, VkPipeline* const outPipelines) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    const VkResult result = vkCreateComputePipelines(device, cache, count, infos, nullptr, outPipelines);
+    recordBuild(count, elapsedNanos(start));
+    return result;
+}
+
+/**
+ * @brief Adds one timed build to the running statistics.
+ */
+void PipelineCache::recordBuild(const uint32_t count, const uint64_t nanos) {
+    static_cast<void>(pipelineCount.fetch_add(count));
+    static_cast<void>(buildNanos.fetch_add(nanos));
+}
+
+// ========================================================================
+// SECTION 3: PERSISTENCE
+// ========================================================================
+
+/**
+ * @brief Writes the current cache contents to disk and logs the build statistics.
+ * The blob is written to a temporary file first so a crash never leaves a truncated cache behind.
+ */
+void PipelineCache::save() const {
+    if (cache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::cout << "PipelineCache: " << (warmStart ? "Warm" : "Cold") << " run built " << getPipelineCount()
+        << " pipelines in " << getBuildMilliseconds() << " ms." << std::endl;
+
+    // Step 1: Query the size, then the payload
+    size_t dataSize{ 0U };
+    if ((vkGetPipelineCacheData(device, cache, &dataSize, nullptr) != VK_SUCCESS) || (dataSize == 0U)) {
+        return;
+    }
+
+    std::vector<char> blob(dataSize);
+    if (vkGetPipelineCacheData(device, cache, &dataSize, blob.data()) != VK_SUCCESS) {
+        return;
+    }
+
+    // Step 2: Write through a temporary file and swap it into place
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "PipelineCache: Unable to write " << tempPath << std::endl;
+            return;
+        }
+        static_cast<void>(file.write(blob.data(), static_cast<std::streamsize>(dataSize)));
+    }
+
+    static_cast<void>(std::remove(cachePath.c_str()));
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "PipelineCache: Unable to replace " << cachePath << std::endl;
+        return;
+    }
+
+    std::cout << "PipelineCache: Saved " << dataSize << " bytes to " << cachePath << "." << std::endl;
+}
+
+/**
+ * @brief Reads the stored blob; returns an empty vector when the file is absent.
+ */
+std::vector<char> PipelineCache::readBlob() const {
+    std::ifstream file(cachePath, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    const std::streamoff fileSize = file.tellg();
+    if (fileSize <= 0) {
+        return {};
+    }
+
+    std::vector<char> blob(static_cast<size_t>(fileSize));
+    static_cast<void>(file.seekg(0, std::ios::beg));
+    static_cast<void>(file.read(blob.data(), static_cast<std::streamsize>(fileSize)));
+    if (!file) {
+        return {};
+    }
+    return blob;
+}
+
+/**
+ * @brief Checks the blob header against the active device; fills reason on rejection.
+ * Layout follows VkPipelineCacheHeaderVersionOne: size, version, vendorID, deviceID, UUID.
+ */
+bool PipelineCache::validateHeader(const std::vector<char>& blob, std::string& reason) const {
+    // Step 1: The header must be present in full and claim a sane length
+    if (blob.size() < static_cast<size_t>(HEADER_MIN_SIZE)) {
+        reason = "truncated header";
+        return false;
+    }
+
+    const uint32_t headerSize = readHeaderField(blob, 0U);
+    if ((headerSize < HEADER_MIN_SIZE) || (static_cast<size_t>(headerSize) > blob.size())) {
+        reason = "invalid header size";
+        return false;
+    }
+
+    if (readHeaderField(blob, HEADER_OFFSET_VERSION) != static_cast<uint32_t>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE)) {
+        reason = "unknown header version";
+        return false;
+    }
+
+    // Step 2: Device identity - a blob from different hardware is useless at best
+    if ((readHeaderField(blob, HEADER_OFFSET_VENDOR) != deviceProperties.vendorID) ||
+        (readHeaderField(blob, HEADER_OFFSET_DEVICE) != deviceProperties.deviceID)) {
+        reason = "different GPU";
+        return false;
+    }
+
+    // Step 3: Driver identity - the UUID changes whenever the driver's cache format does
+    if (std::memcmp(blob.data() + HEADER_OFFSET_UUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        reason = "driver changed";
+        return false;
+    }
+
+    return true;
+}
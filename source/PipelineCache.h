@@ -0,0 +1,95 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class PipelineCache
+ * @brief Owns the engine-wide VkPipelineCache and persists it between runs.
+ * * The blob is loaded at startup and validated against the running device (vendor ID, device ID
+ * and the driver's pipelineCacheUUID) before being handed to the driver. Every pipeline build is
+ * routed through this class so warm and cold launches can be compared from the log.
+ */
+class PipelineCache final {
+public:
+    // --- Named Constants ---
+    inline static const char* DEFAULT_CACHE_PATH = "pipeline_cache.bin";
+    static constexpr uint32_t HEADER_MIN_SIZE = 32U;       /**< Size of VkPipelineCacheHeaderVersionOne. */
+    static constexpr uint32_t HEADER_OFFSET_VERSION = 4U;
+    static constexpr uint32_t HEADER_OFFSET_VENDOR = 8U;
+    static constexpr uint32_t HEADER_OFFSET_DEVICE = 12U;
+    static constexpr uint32_t HEADER_OFFSET_UUID = 16U;
+    static constexpr double   NANOS_PER_MILLI = 1000000.0;
+
+    // --- Lifecycle ---
+
+    /** @brief Default constructor: Handles are initialized to VK_NULL_HANDLE via member defaults. */
+    PipelineCache() = default;
+
+    /** @brief Default destructor: Requires explicit call to cleanup() while the device is alive. */
+    ~PipelineCache() = default;
+
+    // RAII: Prevent copying to ensure unique ownership of the cache handle.
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    // --- Core API ---
+
+    /**
+     * @brief Creates the cache, seeding it from disk when the stored blob matches this device.
+     * A missing, truncated or foreign blob results in an empty cache rather than an error.
+     */
+    void init(const VkDevice logicalDevice, const VkPhysicalDevice physicalDevice, const std::string& path = DEFAULT_CACHE_PATH);
+
+    /** @brief Builds graphics pipelines against the shared cache and accounts the build time. */
+    VkResult createGraphicsPipelines(const uint32_t count, const VkGraphicsPipelineCreateInfo* const infos, VkPipeline* const outPipelines);
+
+    /** @brief Builds compute pipelines against the shared cache and accounts the build time. */
+    VkResult createComputePipelines(const uint32_t count, const VkComputePipelineCreateInfo* const infos, VkPipeline* const outPipelines);
+
+    /** @brief Writes the current cache contents to disk and logs the build statistics. */
+    void save() const;
+
+    /** @brief Destroys the cache handle and resets internal state. */
+    void cleanup();
+
+    // --- Accessors ---
+
+    /** @brief Returns the raw cache handle (VK_NULL_HANDLE before init()). */
+    VkPipelineCache getHandle() const { return cache; }
+
+    /** @brief Returns true if a valid blob from a previous run seeded the cache. */
+    bool isWarm() const { return warmStart; }
+
+    /** @brief Returns the number of pipelines built through the cache. */
+    uint32_t getPipelineCount() const { return pipelineCount.load(); }
+
+    /** @brief Returns the accumulated pipeline build time in milliseconds. */
+    double getBuildMilliseconds() const { return static_cast<double>(buildNanos.load()) / NANOS_PER_MILLI; }
+
+private:
+    /** @brief Reads the stored blob; returns an empty vector when the file is absent. */
+    std::vector<char> readBlob() const;
+
+    /** @brief Checks the blob header against the active device; fills reason on rejection. */
+    bool validateHeader(const std::vector<char>& blob, std::string& reason) const;
+
+    /** @brief Adds one timed build to the running statistics. */
+    void recordBuild(const uint32_t count, const uint64_t nanos);
+
+    // --- GPU Handles & State ---
+    VkDevice device{ VK_NULL_HANDLE };
+    VkPipelineCache cache{ VK_NULL_HANDLE };
+    VkPhysicalDeviceProperties deviceProperties{};
+    std::string cachePath{};
+    bool warmStart{ false };
+
+    // --- Statistics (atomic so builds may run on worker threads) ---
+    std::atomic<uint32_t> pipelineCount{ 0U };
+    std::atomic<uint64_t> buildNanos{ 0U };
+};
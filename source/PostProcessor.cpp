@@ -1,6 +1,8 @@
 #include "PostProcessor.h"
 
 /* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <array>
 /* parasoft-end-suppress ALL */
@@ -14,6 +16,7 @@ PostProcessor::PostProcessor(VulkanContext* const inContext, const uint32_t inWi
 {
     // 1. Establish the Depth Format (Hardware-specific float precision)
     this->depthFormat = VK_FORMAT_D32_SFLOAT;
+    updateRenderExtent();
 
     // 2. Resource & Pass Orchestration
     createOffscreenResources();
@@ -43,8 +46,10 @@ PostProcessor::PostProcessor(VulkanContext* const inContext, const uint32_t inWi
     backgroundTextureWrapper = std::make_unique<Texture>(context, backgroundImage, backgroundImageView, backgroundSampler);
 
     // 4. Infrastructure Assembly
+    createOitResources();
     createTransparentRenderPass();
     createRenderPass();
+    createOitRenderPasses();
     createFramebuffer();
     createDescriptors();
     createPipeline(finalRenderPass);
@@ -68,6 +73,14 @@ PostProcessor::~PostProcessor() {
                 vkDestroyPipelineLayout(context->device, pipelineLayout, nullptr);
                 pipelineLayout = VK_NULL_HANDLE;
             }
+            if (oitPipeline != VK_NULL_HANDLE) {
+                vkDestroyPipeline(context->device, oitPipeline, nullptr);
+                oitPipeline = VK_NULL_HANDLE;
+            }
+            if (oitPipelineLayout != VK_NULL_HANDLE) {
+                vkDestroyPipelineLayout(context->device, oitPipelineLayout, nullptr);
+                oitPipelineLayout = VK_NULL_HANDLE;
+            }
 
             // 3. Destroy Descriptor Infrastructure
             if (descriptorPool != VK_NULL_HANDLE) {
@@ -78,6 +91,10 @@ PostProcessor::~PostProcessor() {
                 vkDestroyDescriptorSetLayout(context->device, descriptorSetLayout, nullptr);
                 descriptorSetLayout = VK_NULL_HANDLE;
             }
+            if (oitSetLayout != VK_NULL_HANDLE) {
+                vkDestroyDescriptorSetLayout(context->device, oitSetLayout, nullptr);
+                oitSetLayout = VK_NULL_HANDLE;
+            }
 
             // 4. Destroy Render Pass Infrastructure
             if (transparentRenderPass != VK_NULL_HANDLE) {
@@ -88,6 +105,14 @@ PostProcessor::~PostProcessor() {
                 vkDestroyRenderPass(context->device, offscreenRenderPass, nullptr);
                 offscreenRenderPass = VK_NULL_HANDLE;
             }
+            if (oitRenderPass != VK_NULL_HANDLE) {
+                vkDestroyRenderPass(context->device, oitRenderPass, nullptr);
+                oitRenderPass = VK_NULL_HANDLE;
+            }
+            if (oitCompositePass != VK_NULL_HANDLE) {
+                vkDestroyRenderPass(context->device, oitCompositePass, nullptr);
+                oitCompositePass = VK_NULL_HANDLE;
+            }
         }
     }
     catch (...) {
@@ -98,63 +123,79 @@ PostProcessor::~PostProcessor() {
 /**
  * @brief Reallocates all resolution-dependent GPU resources.
  * Ensures the refraction and offscreen buffers match the new window extent.
+ * The previous targets are retired rather than destroyed, so no device-wide wait is required.
  */
 void PostProcessor::resize(const VkExtent2D& extent) {
-    cleanupResources();
+    // Step 1: Hand the current targets to the deletion queue; in-flight frames may still reference them
+    retireResources();
     width = extent.width;
     height = extent.height;
+    updateRenderExtent();
 
+    // Step 2: Allocate the replacement targets at the new resolution
     createOffscreenResources();
+    createOitResources();
     createBackgroundResources();
     createFramebuffer();
 
     backgroundTextureWrapper = std::make_unique<Texture>(context, backgroundImage, backgroundImageView, backgroundSampler);
 
-    const VkDescriptorImageInfo imageInfo{ offscreenSampler, resolveImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
-    const VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSet,
-        0U, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imageInfo, nullptr, nullptr };
+    // Step 3: Point fresh descriptor sets at the new resolve images (the old sets may still be bound)
+    allocateDescriptorSet();
+}
+
+/**
+ * @brief Records the initial layout transitions deferred by resize().
+ * The scene depth is cleared to the far plane first, so the collision of the first frame finds no surface.
+ */
+void PostProcessor::recordPendingTransitions(const VkCommandBuffer cb) {
+    if (backgroundLayoutPending) {
+        VulkanUtils::recordImageBarrier(cb, backgroundImage,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            static_cast<VkAccessFlags>(EngineConstants::OFFSET_ZERO), VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            EngineConstants::COUNT_ONE);
+
+        backgroundLayoutPending = false;
+    }
 
-    vkUpdateDescriptorSets(context->device, 1U, &write, 0, nullptr);
+    if (depthLayoutPending) {
+        VulkanUtils::recordImageBarrier(cb, internalDepthImage,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<VkAccessFlags>(EngineConstants::OFFSET_ZERO), VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            EngineConstants::COUNT_ONE, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        const VkClearDepthStencilValue farPlane{ 1.0f, 0U };
+        const VkImageSubresourceRange range{ VK_IMAGE_ASPECT_DEPTH_BIT, 0U, 1U, 0U, 1U };
+        vkCmdClearDepthStencilImage(cb, internalDepthImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &farPlane, 1U, &range);
+
+        // The state the frame graph imports the depth in between frames
+        VulkanUtils::recordImageBarrier(cb, internalDepthImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            EngineConstants::COUNT_ONE, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        depthLayoutPending = false;
+    }
 }
 
 /**
  * @brief Captures a high-precision snapshot of the opaque scene.
  * This snapshot is used by the refraction shaders in the subsequent transparent pass.
+ * The layout transitions around the copy are derived by the Renderer's frame graph.
  */
 void PostProcessor::copyScene(const VkCommandBuffer cb) const {
-    // 1. Transition Background Image: Shader Read -> Transfer Destination
-    VulkanUtils::recordImageBarrier(cb, backgroundImage,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
-        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-        EngineConstants::COUNT_ONE);
-
-    // 2. Execute GPU Copy
     // Source: resolveImage (MSAA flattened HDR)
     // Destination: backgroundImage (Refraction Snapshot)
     VkImageCopy copyRegion{};
     copyRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0U, 0U, 1U };
     copyRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0U, 0U, 1U };
-    copyRegion.extent = { width, height, 1U };
+    copyRegion.extent = { renderExtent.width, renderExtent.height, 1U };   // Only the rendered region is ever sampled
 
     vkCmdCopyImage(cb, resolveImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
         backgroundImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1U, &copyRegion);
-
-    // 3. Transition Background Image: Transfer Destination -> Shader Read
-    // Ready for consumption by glass and water refraction shaders
-    VulkanUtils::recordImageBarrier(cb, backgroundImage,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
-        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-        EngineConstants::COUNT_ONE);
-
-    // 4. Transition Resolve Image: Transfer Source -> Shader Read
-    // Synchronizes the HDR target for the following transparent pass
-    VulkanUtils::recordImageBarrier(cb, resolveImage,
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
-        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-        EngineConstants::COUNT_ONE);
 }
 
 /**
@@ -170,13 +211,8 @@ void PostProcessor::createBackgroundResources() {
     backgroundImageView = VulkanUtils::createImageView(context->device, backgroundImage, hdrFormat,
         VK_IMAGE_ASPECT_COLOR_BIT, 1U);
 
-    // 2. Transition Layout
-    const VkCommandBuffer transitionCmd = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
-    VulkanUtils::recordImageBarrier(transitionCmd, backgroundImage,
-        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        0, VK_ACCESS_SHADER_READ_BIT,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 1U);
-    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, transitionCmd);
+    // 2. Transition Layout: Deferred to the next frame's command buffer to avoid a blocking queue submit
+    backgroundLayoutPending = true;
 
     // --- FIX: Recreate the sampler if it was destroyed by cleanupResources ---
     if (backgroundSampler == VK_NULL_HANDLE) {
@@ -202,86 +238,176 @@ void PostProcessor::draw(const VkCommandBuffer commandBuffer, const bool enableB
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
         EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, sets, EngineConstants::OFFSET_ZERO, nullptr);
 
-    // 4. Push Bloom Toggle State
-    const int32_t enabled = enableBloom ? EngineConstants::SHADER_TRUE : EngineConstants::SHADER_FALSE;
+    // 4. Push the Upsampling Region and Bloom Toggle State
+    PostPushConstants push{};
+    push.uvScale = glm::vec2(static_cast<float>(renderExtent.width) / static_cast<float>(width),
+        static_cast<float>(renderExtent.height) / static_cast<float>(height));
+    push.uvClamp = glm::vec2((static_cast<float>(renderExtent.width) - 0.5f) / static_cast<float>(width),
+        (static_cast<float>(renderExtent.height) - 0.5f) / static_cast<float>(height));
+    push.enableBloom = enableBloom ? EngineConstants::SHADER_TRUE : EngineConstants::SHADER_FALSE;
     vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
-        EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(int32_t)), &enabled);
+        EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(PostPushConstants)), &push);
 
     // 5. Execute Fullscreen Triangle Draw (3 Vertices, Procedurally generated in shader)
     vkCmdDraw(commandBuffer, FULLSCREEN_TRI_VERTS, EngineConstants::COUNT_ONE, EngineConstants::OFFSET_ZERO, EngineConstants::OFFSET_ZERO);
 }
 
+/**
+ * @brief Sets the fraction of the window each axis of the scene is rendered at.
+ * No target is reallocated: only the render extent used by the next recorded frame changes.
+ */
+void PostProcessor::setRenderScale(const float scale) {
+    renderScale = std::clamp(scale, MIN_RENDER_SCALE, MAX_RENDER_SCALE);
+    updateRenderExtent();
+}
+
+/**
+ * @brief Derives the render extent from the target size and the render scale (at least one pixel per axis).
+ */
+void PostProcessor::updateRenderExtent() {
+    renderExtent.width = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(width) * renderScale)), 1U);
+    renderExtent.height = std::max(static_cast<uint32_t>(std::lround(static_cast<float>(height) * renderScale)), 1U);
+}
+
 /**
  * @brief Safely releases all frame-dependent GPU memory.
- * This is called during both destruction and window resizing.
+ * This is called during destruction, once the device is idle.
  */
 void PostProcessor::cleanupResources() {
+    // 1. Render targets, views and memory
+    destroyTargets(context->device, detachTargets());
+
+    // 2. Samplers
+    if (offscreenSampler != VK_NULL_HANDLE) {
+        vkDestroySampler(context->device, offscreenSampler, nullptr);
+        offscreenSampler = VK_NULL_HANDLE;
+    }
+    if (backgroundSampler != VK_NULL_HANDLE) {
+        vkDestroySampler(context->device, backgroundSampler, nullptr);
+        backgroundSampler = VK_NULL_HANDLE;
+    }
+}
+
+/**
+ * @brief Defers destruction of the frame-dependent targets until in-flight frames have retired.
+ * Samplers are resolution-independent and are kept across resizes.
+ */
+void PostProcessor::retireResources() {
+    const TargetHandles targets = detachTargets();
+    const VkDevice device = context->device;
+
+    context->deletionQueue.retire([device, targets]() {
+        destroyTargets(device, targets);
+    });
+}
+
+/**
+ * @brief Moves every resolution-dependent handle out of the members, leaving them null.
+ */
+PostProcessor::TargetHandles PostProcessor::detachTargets() {
+    TargetHandles targets{};
+    targets.framebuffer = offscreenFramebuffer;
+    targets.offscreenView = offscreenImageView;
+    targets.offscreenImage = offscreenImage;
+    targets.offscreenMemory = offscreenMemory;
+    targets.resolveView = resolveImageView;
+    targets.resolveImage = resolveImage;
+    targets.resolveMemory = resolveMemory;
+    targets.depthView = internalDepthView;
+    targets.depthImage = internalDepthImage;
+    targets.depthMemory = internalDepthMemory;
+    targets.backgroundView = backgroundImageView;
+    targets.backgroundImage = backgroundImage;
+    targets.backgroundMemory = backgroundMemory;
+    targets.oitFramebuffer = oitFramebuffer;
+    targets.oitCompositeFramebuffer = oitCompositeFramebuffer;
+    targets.oitTargets = oitTargets;
+
+    offscreenFramebuffer = VK_NULL_HANDLE;
+    offscreenImageView = VK_NULL_HANDLE;
+    offscreenImage = VK_NULL_HANDLE;
+    offscreenMemory = VK_NULL_HANDLE;
+    resolveImageView = VK_NULL_HANDLE;
+    resolveImage = VK_NULL_HANDLE;
+    resolveMemory = VK_NULL_HANDLE;
+    internalDepthView = VK_NULL_HANDLE;
+    internalDepthImage = VK_NULL_HANDLE;
+    internalDepthMemory = VK_NULL_HANDLE;
+    backgroundImageView = VK_NULL_HANDLE;
+    backgroundImage = VK_NULL_HANDLE;
+    backgroundMemory = VK_NULL_HANDLE;
+    oitFramebuffer = VK_NULL_HANDLE;
+    oitCompositeFramebuffer = VK_NULL_HANDLE;
+    oitTargets.fill(ColorTarget{});
+    return targets;
+}
+
+/**
+ * @brief Destroys a detached set of targets in dependency order (Framebuffer -> Views -> Images -> Memory).
+ */
+void PostProcessor::destroyTargets(const VkDevice device, const TargetHandles& targets) {
     // 1. Offscreen HDR Targets & Views
-    if (offscreenFramebuffer != VK_NULL_HANDLE) {
-        vkDestroyFramebuffer(context->device, offscreenFramebuffer, nullptr);
-        offscreenFramebuffer = VK_NULL_HANDLE;
+    if (targets.framebuffer != VK_NULL_HANDLE) {
+        vkDestroyFramebuffer(device, targets.framebuffer, nullptr);
     }
-    if (offscreenImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->device, offscreenImageView, nullptr);
-        offscreenImageView = VK_NULL_HANDLE;
+    if (targets.offscreenView != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, targets.offscreenView, nullptr);
     }
-    if (offscreenImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->device, offscreenImage, nullptr);
-        offscreenImage = VK_NULL_HANDLE;
+    if (targets.offscreenImage != VK_NULL_HANDLE) {
+        vkDestroyImage(device, targets.offscreenImage, nullptr);
     }
-    if (offscreenMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->device, offscreenMemory, nullptr);
-        offscreenMemory = VK_NULL_HANDLE;
+    if (targets.offscreenMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, targets.offscreenMemory, nullptr);
     }
 
     // 2. Resolve & Depth Buffers
-    if (resolveImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->device, resolveImageView, nullptr);
-        resolveImageView = VK_NULL_HANDLE;
+    if (targets.resolveView != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, targets.resolveView, nullptr);
     }
-    if (resolveImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->device, resolveImage, nullptr);
-        resolveImage = VK_NULL_HANDLE;
+    if (targets.resolveImage != VK_NULL_HANDLE) {
+        vkDestroyImage(device, targets.resolveImage, nullptr);
     }
-    if (resolveMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->device, resolveMemory, nullptr);
-        resolveMemory = VK_NULL_HANDLE;
+    if (targets.resolveMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, targets.resolveMemory, nullptr);
     }
-    if (internalDepthView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->device, internalDepthView, nullptr);
-        internalDepthView = VK_NULL_HANDLE;
+    if (targets.depthView != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, targets.depthView, nullptr);
     }
-    if (internalDepthImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->device, internalDepthImage, nullptr);
-        internalDepthImage = VK_NULL_HANDLE;
+    if (targets.depthImage != VK_NULL_HANDLE) {
+        vkDestroyImage(device, targets.depthImage, nullptr);
     }
-    if (internalDepthMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->device, internalDepthMemory, nullptr);
-        internalDepthMemory = VK_NULL_HANDLE;
+    if (targets.depthMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, targets.depthMemory, nullptr);
     }
 
     // 3. Background/Snapshot Resources
-    if (backgroundImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->device, backgroundImageView, nullptr);
-        backgroundImageView = VK_NULL_HANDLE;
+    if (targets.backgroundView != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, targets.backgroundView, nullptr);
     }
-    if (backgroundImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->device, backgroundImage, nullptr);
-        backgroundImage = VK_NULL_HANDLE;
+    if (targets.backgroundImage != VK_NULL_HANDLE) {
+        vkDestroyImage(device, targets.backgroundImage, nullptr);
     }
-    if (backgroundMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->device, backgroundMemory, nullptr);
-        backgroundMemory = VK_NULL_HANDLE;
+    if (targets.backgroundMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, targets.backgroundMemory, nullptr);
     }
 
-    // 4. Samplers
-    if (offscreenSampler != VK_NULL_HANDLE) {
-        vkDestroySampler(context->device, offscreenSampler, nullptr);
-        offscreenSampler = VK_NULL_HANDLE;
+    // 4. Weighted OIT Targets
+    if (targets.oitFramebuffer != VK_NULL_HANDLE) {
+        vkDestroyFramebuffer(device, targets.oitFramebuffer, nullptr);
     }
-    if (backgroundSampler != VK_NULL_HANDLE) {
-        vkDestroySampler(context->device, backgroundSampler, nullptr);
-        backgroundSampler = VK_NULL_HANDLE;
+    if (targets.oitCompositeFramebuffer != VK_NULL_HANDLE) {
+        vkDestroyFramebuffer(device, targets.oitCompositeFramebuffer, nullptr);
+    }
+    for (const ColorTarget& target : targets.oitTargets) {
+        if (target.view != VK_NULL_HANDLE) {
+            vkDestroyImageView(device, target.view, nullptr);
+        }
+        if (target.image != VK_NULL_HANDLE) {
+            vkDestroyImage(device, target.image, nullptr);
+        }
+        if (target.memory != VK_NULL_HANDLE) {
+            vkFreeMemory(device, target.memory, nullptr);
+        }
     }
 }
 
@@ -299,13 +425,15 @@ void PostProcessor::createOffscreenResources() {
         VK_IMAGE_ASPECT_COLOR_BIT, EngineConstants::COUNT_ONE);
 
     // 2. Depth Target (MSAA Enabled)
+    // Sampled by the particle simulations for collision; cleared once before its first use.
     VulkanUtils::createImage(context->device, context->physicalDevice, width, height, EngineConstants::COUNT_ONE,
         msaaSamples, depthFormat, VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        internalDepthImage, internalDepthMemory);
+        (VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, internalDepthImage, internalDepthMemory);
 
     internalDepthView = VulkanUtils::createImageView(context->device, internalDepthImage, depthFormat,
         VK_IMAGE_ASPECT_DEPTH_BIT, EngineConstants::COUNT_ONE);
+    depthLayoutPending = true;
 
     // 3. Resolve Target (1x, No MSAA)
     VulkanUtils::createImage(context->device, context->physicalDevice, width, height, EngineConstants::COUNT_ONE,
@@ -322,6 +450,29 @@ void PostProcessor::createOffscreenResources() {
     }
 }
 
+/**
+ * @brief Allocates the weighted OIT targets: MSAA accumulation/revealage and their 1x resolves.
+ * The MSAA images are never stored, so they are created as transient attachments.
+ */
+void PostProcessor::createOitResources() {
+    const std::array<VkFormat, OIT_TARGET_COUNT> formats = { hdrFormat, revealFormat, hdrFormat, revealFormat };
+
+    for (size_t i = 0U; i < OIT_TARGET_COUNT; ++i) {
+        const bool multisampled = (i == OIT_ACCUM) || (i == OIT_REVEAL);
+        const VkImageUsageFlags usage = multisampled
+            ? (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+            : (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+
+        ColorTarget& target = oitTargets[i];
+        VulkanUtils::createImage(context->device, context->physicalDevice, width, height, EngineConstants::COUNT_ONE,
+            multisampled ? msaaSamples : VK_SAMPLE_COUNT_1_BIT, formats[i], VK_IMAGE_TILING_OPTIMAL,
+            usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, target.image, target.memory);
+
+        target.view = VulkanUtils::createImageView(context->device, target.image, formats[i],
+            VK_IMAGE_ASPECT_COLOR_BIT, EngineConstants::COUNT_ONE);
+    }
+}
+
 /**
  * @brief Initializes the primary offscreen render pass.
  * FIX: Calls deduplicated helper to resolve CDD.DUPC.
@@ -339,7 +490,8 @@ void PostProcessor::createTransparentRenderPass() {
 }
 
 /**
- * @brief Creates the offscreen framebuffer linking all three HDR attachments.
+ * @brief Creates the offscreen framebuffer linking all three HDR attachments,
+ * plus the OIT accumulation and composite framebuffers that share its depth and resolve images.
  */
 void PostProcessor::createFramebuffer() {
     const std::array<VkImageView, 3> attachments = {
@@ -359,10 +511,37 @@ void PostProcessor::createFramebuffer() {
     if (vkCreateFramebuffer(context->device, &framebufferInfo, nullptr, &offscreenFramebuffer) != VK_SUCCESS) {
         throw std::runtime_error("PostProcessor: Failed to create offscreen framebuffer!");
     }
+
+    // Weighted OIT: accumulation targets tested against the opaque depth
+    const std::array<VkImageView, ATTACHMENT_COUNT_OIT> oitAttachments = {
+        oitTargets[OIT_ACCUM].view,
+        oitTargets[OIT_REVEAL].view,
+        internalDepthView,
+        oitTargets[OIT_ACCUM_RESOLVE].view,
+        oitTargets[OIT_REVEAL_RESOLVE].view
+    };
+
+    framebufferInfo.renderPass = oitRenderPass;
+    framebufferInfo.attachmentCount = static_cast<uint32_t>(oitAttachments.size());
+    framebufferInfo.pAttachments = oitAttachments.data();
+
+    if (vkCreateFramebuffer(context->device, &framebufferInfo, nullptr, &oitFramebuffer) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT framebuffer!");
+    }
+
+    // Composite: draws straight into the 1x resolve image
+    framebufferInfo.renderPass = oitCompositePass;
+    framebufferInfo.attachmentCount = 1U;
+    framebufferInfo.pAttachments = &resolveImageView;
+
+    if (vkCreateFramebuffer(context->device, &framebufferInfo, nullptr, &oitCompositeFramebuffer) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT composite framebuffer!");
+    }
 }
 
 /**
- * @brief Sets up descriptors to sample the resolved HDR scene for post-processing.
+ * @brief Sets up descriptors to sample the resolved HDR scene for post-processing,
+ * and the resolved OIT targets for the composite.
  */
 void PostProcessor::createDescriptors() {
     VkDescriptorSetLayoutBinding samplerLayoutBinding{};
@@ -380,51 +559,211 @@ void PostProcessor::createDescriptors() {
         throw std::runtime_error("PostProcessor: Failed to create descriptor set layout!");
     }
 
-    VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1U };
+    // OIT composite: Binding 0 accumulation, Binding 1 revealage
+    std::array<VkDescriptorSetLayoutBinding, OIT_SAMPLER_COUNT> oitBindings{};
+    for (uint32_t i = 0U; i < OIT_SAMPLER_COUNT; ++i) {
+        oitBindings[i] = samplerLayoutBinding;
+        oitBindings[i].binding = i;
+    }
+    layoutInfo.bindingCount = OIT_SAMPLER_COUNT;
+    layoutInfo.pBindings = oitBindings.data();
+
+    if (vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &oitSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT descriptor set layout!");
+    }
+
+    // Pool headroom allows resize() to allocate new sets while retired sets await destruction
+    VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, DESCRIPTOR_SET_HEADROOM * (1U + OIT_SAMPLER_COUNT) };
     VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
     poolInfo.poolSizeCount = 1U;
     poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1U;
+    poolInfo.maxSets = DESCRIPTOR_SET_HEADROOM * 2U;
 
     if (vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("PostProcessor: Failed to create descriptor pool!");
     }
 
+    allocateDescriptorSet();
+}
+
+/**
+ * @brief Allocates the post and OIT descriptor sets for the current targets, retiring any previous sets.
+ * A set bound by an in-flight command buffer must not be rewritten, so resizes always use fresh ones.
+ */
+void PostProcessor::allocateDescriptorSet() {
+    // Step 1: Retire the sets currently referenced by in-flight frames
+    if (descriptorSet != VK_NULL_HANDLE) {
+        const VkDevice device = context->device;
+        const VkDescriptorPool pool = descriptorPool;
+        const std::array<VkDescriptorSet, 2> retiredSets = { descriptorSet, oitDescriptorSet };
+        descriptorSet = VK_NULL_HANDLE;
+        oitDescriptorSet = VK_NULL_HANDLE;
+
+        context->deletionQueue.retire([device, pool, retiredSets]() {
+            static_cast<void>(vkFreeDescriptorSets(device, pool, static_cast<uint32_t>(retiredSets.size()), retiredSets.data()));
+        });
+    }
+
+    const std::array<VkDescriptorSetLayout, 2> setLayouts = { descriptorSetLayout, oitSetLayout };
+    std::array<VkDescriptorSet, 2> sets{};
+
     VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = 1U;
-    allocInfo.pSetLayouts = &descriptorSetLayout;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+    allocInfo.pSetLayouts = setLayouts.data();
+
+    // Step 2: Allocate; if back-to-back resizes exhausted the headroom, drain once and release retired sets
+    if (vkAllocateDescriptorSets(context->device, &allocInfo, sets.data()) != VK_SUCCESS) {
+        static_cast<void>(vkDeviceWaitIdle(context->device));
+        context->deletionQueue.flush();
 
-    if (vkAllocateDescriptorSets(context->device, &allocInfo, &descriptorSet) != VK_SUCCESS) {
-        throw std::runtime_error("PostProcessor: Failed to allocate descriptor set!");
+        if (vkAllocateDescriptorSets(context->device, &allocInfo, sets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("PostProcessor: Failed to allocate descriptor set!");
+        }
     }
+    descriptorSet = sets[0];
+    oitDescriptorSet = sets[1];
 
     if (offscreenSampler == VK_NULL_HANDLE) {
         throw std::runtime_error("PostProcessor: Attempted to update descriptors with an invalid sampler!");
     }
 
-    VkDescriptorImageInfo imageInfo{};
-    imageInfo.sampler = offscreenSampler;
-    imageInfo.imageView = resolveImageView;
-    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    // Step 3: Bind the resolved HDR scene, then the resolved OIT accumulation and revealage
+    const std::array<VkDescriptorImageInfo, 1U + OIT_SAMPLER_COUNT> imageInfos = {
+        VkDescriptorImageInfo{ offscreenSampler, resolveImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL },
+        VkDescriptorImageInfo{ offscreenSampler, oitTargets[OIT_ACCUM_RESOLVE].view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL },
+        VkDescriptorImageInfo{ offscreenSampler, oitTargets[OIT_REVEAL_RESOLVE].view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }
+    };
 
-    VkWriteDescriptorSet descriptorWrite{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
-    descriptorWrite.dstSet = descriptorSet;
-    descriptorWrite.dstBinding = 0U;
-    descriptorWrite.dstArrayElement = 0U;
-    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptorWrite.descriptorCount = 1U;
-    descriptorWrite.pImageInfo = &imageInfo;
+    std::array<VkWriteDescriptorSet, 1U + OIT_SAMPLER_COUNT> descriptorWrites{};
+    for (size_t i = 0U; i < descriptorWrites.size(); ++i) {
+        VkWriteDescriptorSet& write = descriptorWrites[i];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = (i == 0U) ? descriptorSet : oitDescriptorSet;
+        write.dstBinding = (i == 0U) ? 0U : static_cast<uint32_t>(i - 1U);
+        write.dstArrayElement = 0U;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1U;
+        write.pImageInfo = &imageInfos[i];
+    }
 
-    vkUpdateDescriptorSets(context->device, 1U, &descriptorWrite, 0U, nullptr);
+    vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0U, nullptr);
 }
 
 /**
  * @brief Constructs the final fullscreen graphics pipeline.
  */
 void PostProcessor::createPipeline(const VkRenderPass finalRenderPass) {
+    // Rebuilds (e.g. shader reloads) retire the previous pipeline instead of leaking or stalling on it
+    retirePipeline(pipeline, pipelineLayout);
+
+    // --- 1. Layout Creation ---
+    const std::array<VkDescriptorSetLayout, 2> layouts = { descriptorSetLayout, context->materialSetLayout };
+    const VkPushConstantRange pushRange{ VK_SHADER_STAGE_FRAGMENT_BIT, 0U, static_cast<uint32_t>(sizeof(PostPushConstants)) };
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
+    pipelineLayoutInfo.pSetLayouts = layouts.data();
+    pipelineLayoutInfo.pushConstantRangeCount = 1U;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+
+    // Logic remains duplicated across Skybox.cpp? 
+    // In a master's project, moving this to VulkanUtils::createPipelineLayout would be the next step.
+    if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create pipeline layout!");
+    }
+
+    // --- 2. Opaque Output (tone mapping overwrites the swapchain image) ---
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = VK_FALSE;
+
+    pipeline = createFullscreenPipeline("./shaders/post_frag.spv", pipelineLayout, finalRenderPass, colorBlendAttachment);
+}
+
+/**
+ * @brief Builds the weighted OIT composite pipeline (Set 0: resolved accumulation and revealage).
+ */
+void PostProcessor::createOitResolvePipeline() {
+    retirePipeline(oitPipeline, oitPipelineLayout);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipelineLayoutInfo.setLayoutCount = 1U;
+    pipelineLayoutInfo.pSetLayouts = &oitSetLayout;
+
+    if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &oitPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT pipeline layout!");
+    }
+
+    // Straight-alpha "over": the shader outputs the average colour with coverage (1 - revealage)
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+    oitPipeline = createFullscreenPipeline("./shaders/oit_resolve_frag.spv", oitPipelineLayout, oitCompositePass, colorBlendAttachment);
+}
+
+/**
+ * @brief Composites the resolved OIT targets over the opaque scene in the 1x resolve image.
+ */
+void PostProcessor::recordOitComposite(const VkCommandBuffer cb) const {
+    VkRenderPassBeginInfo passInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+    passInfo.renderPass = oitCompositePass;
+    passInfo.framebuffer = oitCompositeFramebuffer;
+    passInfo.renderArea.extent = renderExtent;
+
+    vkCmdBeginRenderPass(cb, &passInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    // Full-size viewport keeps the UV-to-texel mapping 1:1; the scissor limits work to the rendered region
+    const VkViewport vp{ 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f };
+    vkCmdSetViewport(cb, 0, 1, &vp);
+
+    const VkRect2D sc{ {0, 0}, renderExtent };
+    vkCmdSetScissor(cb, 0, 1, &sc);
+
+    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, oitPipeline);
+    vkCmdBindDescriptorSets(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, oitPipelineLayout,
+        EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, &oitDescriptorSet, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdDraw(cb, FULLSCREEN_TRI_VERTS, EngineConstants::COUNT_ONE, EngineConstants::OFFSET_ZERO, EngineConstants::OFFSET_ZERO);
+
+    vkCmdEndRenderPass(cb);
+}
+
+/**
+ * @brief Hands a pipeline and its layout to the deletion queue and clears the members.
+ */
+void PostProcessor::retirePipeline(VkPipeline& retiredPipeline, VkPipelineLayout& retiredLayout) const {
+    if ((retiredPipeline == VK_NULL_HANDLE) && (retiredLayout == VK_NULL_HANDLE)) {
+        return;
+    }
+
+    const VkDevice device = context->device;
+    const VkPipeline oldPipeline = retiredPipeline;
+    const VkPipelineLayout oldLayout = retiredLayout;
+    retiredPipeline = VK_NULL_HANDLE;
+    retiredLayout = VK_NULL_HANDLE;
+
+    context->deletionQueue.retire([device, oldPipeline, oldLayout]() {
+        vkDestroyPipeline(device, oldPipeline, nullptr);
+        vkDestroyPipelineLayout(device, oldLayout, nullptr);
+    });
+}
+
+/**
+ * @brief Shared fixed-function state of the fullscreen-triangle passes (post.vert + the given fragment shader).
+ */
+VkPipeline PostProcessor::createFullscreenPipeline(const std::string& fragPath, const VkPipelineLayout layout,
+    const VkRenderPass renderPass, const VkPipelineColorBlendAttachmentState& blendAttachment) const
+{
     const ShaderModule vertShader(context, "./shaders/post_vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
-    const ShaderModule fragShader(context, "./shaders/post_frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
+    const ShaderModule fragShader(context, fragPath, VK_SHADER_STAGE_FRAGMENT_BIT);
     const VkPipelineShaderStageCreateInfo shaderStages[2] = { vertShader.getStageInfo(), fragShader.getStageInfo() };
 
     // --- 1. Pipeline Configuration State ---
@@ -452,43 +791,151 @@ void PostProcessor::createPipeline(const VkRenderPass finalRenderPass) {
     VkPipelineDepthStencilStateCreateInfo depthStencil{ VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO };
     depthStencil.depthTestEnable = VK_FALSE;
 
-    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachment.blendEnable = VK_FALSE;
-
     VkPipelineColorBlendStateCreateInfo colorBlending{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
     colorBlending.attachmentCount = 1U;
-    colorBlending.pAttachments = &colorBlendAttachment;
-
-    // --- 2. Layout Creation ---
-    const std::array<VkDescriptorSetLayout, 2> layouts = { descriptorSetLayout, context->materialSetLayout };
-    const VkPushConstantRange pushRange{ VK_SHADER_STAGE_FRAGMENT_BIT, 0U, static_cast<uint32_t>(sizeof(int32_t)) };
+    colorBlending.pAttachments = &blendAttachment;
 
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
-    pipelineLayoutInfo.pSetLayouts = layouts.data();
-    pipelineLayoutInfo.pushConstantRangeCount = 1U;
-    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
-
-    // Logic remains duplicated across Skybox.cpp? 
-    // In a master's project, moving this to VulkanUtils::createPipelineLayout would be the next step.
-    if (vkCreatePipelineLayout(context->device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("PostProcessor: Failed to create pipeline layout!");
-    }
-
-    // --- 3. FINAL DEFINITIONS (Satisfies OPT.20) ---
+    // --- 2. FINAL DEFINITIONS (Satisfies OPT.20) ---
     // Vertex Input: Positioned exactly before usage to minimize stack lifetime
     const VkPipelineVertexInputStateCreateInfo vertexInputInfo{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
 
     const VkGraphicsPipelineCreateInfo pipelineInfo = VulkanUtils::preparePipelineCreateInfo(
         shaderStages, &vertexInputInfo, &inputAssembly, &viewportState,
         &rasterizer, &multisampling, &depthStencil, &colorBlending,
-        &dynamicState, pipelineLayout, finalRenderPass
+        &dynamicState, layout, renderPass
     );
 
-    if (vkCreateGraphicsPipelines(context->device, VK_NULL_HANDLE, 1U, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    VkPipeline result{ VK_NULL_HANDLE };
+    if (context->pipelineCache.createGraphicsPipelines(1U, &pipelineInfo, &result) != VK_SUCCESS) {
         throw std::runtime_error("PostProcessor: Failed to create graphics pipeline!");
     }
+    return result;
+}
+
+/**
+ * @brief Creates the weighted OIT accumulation pass and the composite pass.
+ * * Accumulation: accum (clear 0) and revealage (clear 1) are MSAA, tested against the opaque depth
+ * (loaded, not written) and resolved to 1x images the composite samples.
+ * * Composite: loads the 1x resolve image after the refraction copy and blends the OIT average over it.
+ */
+void PostProcessor::createOitRenderPasses() {
+    // 1. MSAA accumulation targets (cleared, never stored: only their resolves are read)
+    VkAttachmentDescription accumAttachment{};
+    accumAttachment.format = hdrFormat;
+    accumAttachment.samples = msaaSamples;
+    accumAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    accumAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    accumAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    accumAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    accumAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    accumAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentDescription revealAttachment = accumAttachment;
+    revealAttachment.format = revealFormat;
+
+    // 2. Opaque depth: test only, kept for the next frame's particle collision
+    VkAttachmentDescription depthAttachment{};
+    depthAttachment.format = depthFormat;
+    depthAttachment.samples = msaaSamples;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    // 3. 1x resolves, left ready for the composite to sample
+    VkAttachmentDescription accumResolve{};
+    accumResolve.format = hdrFormat;
+    accumResolve.samples = VK_SAMPLE_COUNT_1_BIT;
+    accumResolve.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    accumResolve.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    accumResolve.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    accumResolve.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    accumResolve.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    accumResolve.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkAttachmentDescription revealResolve = accumResolve;
+    revealResolve.format = revealFormat;
+
+    const std::array<VkAttachmentReference, 2U> colorRefs = {
+        VkAttachmentReference{ 0U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL },
+        VkAttachmentReference{ 1U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }
+    };
+    const VkAttachmentReference depthRef{ 2U, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+    const std::array<VkAttachmentReference, 2U> resolveRefs = {
+        VkAttachmentReference{ 3U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL },
+        VkAttachmentReference{ 4U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL }
+    };
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = static_cast<uint32_t>(colorRefs.size());
+    subpass.pColorAttachments = colorRefs.data();
+    subpass.pDepthStencilAttachment = &depthRef;
+    subpass.pResolveAttachments = resolveRefs.data();
+
+    // 4. Dependencies: opaque depth writes -> depth test; resolves -> composite sampling
+    std::array<VkSubpassDependency, 2U> dependencies{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0U;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+
+    dependencies[1].srcSubpass = 0U;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    const std::array<VkAttachmentDescription, ATTACHMENT_COUNT_OIT> attachments = {
+        accumAttachment, revealAttachment, depthAttachment, accumResolve, revealResolve
+    };
+    VkRenderPassCreateInfo renderPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+    renderPassInfo.pAttachments = attachments.data();
+    renderPassInfo.subpassCount = 1U;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    renderPassInfo.pDependencies = dependencies.data();
+
+    if (vkCreateRenderPass(context->device, &renderPassInfo, nullptr, &oitRenderPass) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT render pass!");
+    }
+
+    // 5. Composite: the resolve image arrives and leaves shader-readable (refraction copy -> post)
+    VkAttachmentDescription sceneAttachment{};
+    sceneAttachment.format = hdrFormat;
+    sceneAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    sceneAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    sceneAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    sceneAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    sceneAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    sceneAttachment.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    sceneAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    const VkAttachmentReference sceneRef{ 0U, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+    VkSubpassDescription compositeSubpass{};
+    compositeSubpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    compositeSubpass.colorAttachmentCount = 1U;
+    compositeSubpass.pColorAttachments = &sceneRef;
+
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].srcAccessMask = 0U;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    renderPassInfo.attachmentCount = 1U;
+    renderPassInfo.pAttachments = &sceneAttachment;
+    renderPassInfo.pSubpasses = &compositeSubpass;
+
+    if (vkCreateRenderPass(context->device, &renderPassInfo, nullptr, &oitCompositePass) != VK_SUCCESS) {
+        throw std::runtime_error("PostProcessor: Failed to create OIT composite render pass!");
+    }
 }
 
 /**
@@ -520,7 +967,9 @@ void PostProcessor::internalCreateRenderPass(const bool isTransparent) {
     depthAttachment.format = depthFormat;
     depthAttachment.samples = msaaSamples;
     depthAttachment.loadOp = depthLoadOp;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    // The opaque depth is loaded again by the transparent or OIT pass, and kept after those for the
+    // next frame's particle collision
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     depthAttachment.initialLayout = isTransparent ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
     depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
@@ -550,7 +999,9 @@ void PostProcessor::internalCreateRenderPass(const bool isTransparent) {
     VkSubpassDependency dependency{};
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0U;
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    // Compute: the particle simulations read the previous frame's depth before the opaque pass clears it
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
     dependency.srcAccessMask = 0U;
     dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
     dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
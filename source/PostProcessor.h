@@ -2,7 +2,9 @@
 
 /* parasoft-begin-suppress ALL */
 #include "libs.h"
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 /* parasoft-end-suppress ALL */
 
@@ -17,6 +19,11 @@
  * @brief Orchestrates offscreen HDR rendering, MSAA resolution, and fullscreen effects.
  * Manages the transition from high-poly scene geometry to a resolved 2D image
  * with effects like Bloom and refraction-ready snapshots.
+ * * Also owns the weighted blended OIT targets: an accumulation pass that shares the scene depth,
+ * and a composite pass that blends the resolved average over the 1x scene before post-processing.
+ * * Dynamic resolution: targets are always allocated at the full window size, but the scene passes
+ * only fill the top-left render extent (window size times the render scale). The refraction copy and
+ * the OIT composite are limited to that region and the final pass stretches it over the swapchain.
  */
 class PostProcessor final {
 public:
@@ -25,6 +32,13 @@ public:
     static constexpr uint32_t ATTACHMENT_COUNT_OFFSCREEN = 2U;
     static constexpr uint32_t DEPENDENCY_COUNT_OFFSCREEN = 2U;
     static constexpr uint32_t LAYOUT_COUNT_POST = 2U;
+    static constexpr uint32_t ATTACHMENT_COUNT_OIT = 5U;       /**< Accum, revealage, depth, and both resolves. */
+    static constexpr uint32_t OIT_SAMPLER_COUNT = 2U;
+    static constexpr float MIN_RENDER_SCALE = 0.5f;
+    static constexpr float MAX_RENDER_SCALE = 1.0f;
+
+    /** @brief Descriptor sets the post pool can hold while retired generations await destruction. */
+    static constexpr uint32_t DESCRIPTOR_SET_HEADROOM = 4U;
 
     /**
      * @brief Constructor: Initializes the post-processing framework.
@@ -46,18 +60,55 @@ public:
 
     // --- Core API ---
 
-    /** @brief Reallocates textures and framebuffers on window resize. */
+    /**
+     * @brief Reallocates textures and framebuffers on window resize.
+     * Previous targets are retired through the DeletionQueue so in-flight frames stay valid.
+     */
     void resize(const VkExtent2D& extent);
 
-    /** @brief Renders the final fullscreen triangle with post-processing logic. */
+    /**
+     * @brief Records layout transitions deferred by resize() into the next frame's command buffer.
+     * A new scene depth is also cleared to the far plane, since the particle simulations sample it
+     * (as the previous frame's depth) before the opaque pass first writes it.
+     */
+    void recordPendingTransitions(const VkCommandBuffer cb);
+
+    /** @brief Renders the final fullscreen triangle with post-processing logic, upsampling the render extent. */
     void draw(const VkCommandBuffer commandBuffer, const bool enableBloom) const;
 
-    /** @brief Captures a snapshot of the opaque scene for use in refraction shaders. */
+    /** @brief Sets the fraction of the window each axis of the scene is rendered at (clamped to [0.5, 1]). */
+    void setRenderScale(const float scale);
+
+    /** @brief Returns the current render scale. */
+    float getRenderScale() const { return renderScale; }
+
+    /** @brief Returns the region of the scene targets the scene passes render into this frame. */
+    const VkExtent2D& getRenderExtent() const { return renderExtent; }
+
+    /**
+     * @brief Captures a snapshot of the opaque scene for use in refraction shaders.
+     * Records the copy only: the resolve image must be in TRANSFER_SRC and the snapshot in TRANSFER_DST.
+     */
     void copyScene(const VkCommandBuffer cb) const;
 
     /** @brief Rebuilds the post-processing pipeline (Set 0: Resolve Image). */
     void createPipeline(const VkRenderPass finalRenderPass);
 
+    /**
+     * @brief Builds the weighted OIT composite pipeline.
+     * @throws std::runtime_error if the resolve shader is missing; OIT then stays unavailable.
+     */
+    void createOitResolvePipeline();
+
+    /**
+     * @brief Composites the resolved OIT targets over the opaque scene in the 1x resolve image.
+     * Records its own render pass; call after the OIT accumulation pass and before the final pass.
+     */
+    void recordOitComposite(const VkCommandBuffer cb) const;
+
+    /** @brief Returns true once the composite pipeline exists, i.e. the OIT path can be used. */
+    bool hasOitResolve() const { return oitPipeline != VK_NULL_HANDLE; }
+
     // --- Synchronization Getters ---
 
     VkRenderPass getOffscreenRenderPass() const { return offscreenRenderPass; }
@@ -67,6 +118,14 @@ public:
     VkImageView getBackgroundImageView() const { return backgroundImageView; }
     VkSampler getBackgroundSampler() const { return backgroundSampler; }
     VkImage getResolveImage() const { return resolveImage; }
+    VkImage getOffscreenImage() const { return offscreenImage; }
+    VkImage getDepthImage() const { return internalDepthImage; }
+    VkImageView getDepthImageView() const { return internalDepthView; }
+    VkImage getBackgroundImage() const { return backgroundImage; }
+    VkImage getOitAccumImage() const { return oitTargets[OIT_ACCUM_RESOLVE].image; }
+    VkImage getOitRevealImage() const { return oitTargets[OIT_REVEAL_RESOLVE].image; }
+    VkRenderPass getOitRenderPass() const { return oitRenderPass; }
+    VkFramebuffer getOitFramebuffer() const { return oitFramebuffer; }
 
 private:
     // Dependencies
@@ -75,8 +134,24 @@ private:
     uint32_t height{ 0U };
     VkFormat swapChainFormat{ VK_FORMAT_UNDEFINED };
 
+    // Dynamic resolution: scene passes render into the top-left renderExtent of the full-size targets
+    float renderScale{ MAX_RENDER_SCALE };
+    VkExtent2D renderExtent{ 0U, 0U };
+
+    /**
+     * @struct PostPushConstants
+     * @brief Mirror of post.frag's push block (vec2, vec2, int: 20 bytes).
+     */
+    struct PostPushConstants {
+        glm::vec2 uvScale{ 1.0f };   /**< Render extent over target size: maps the swapchain UV into the rendered region. */
+        glm::vec2 uvClamp{ 1.0f };   /**< Last texel centre of that region, so bilinear taps never read past it. */
+        int32_t enableBloom{ 0 };
+    };
+
     // HDR Precision: Required for high-intensity light calculation
     const VkFormat hdrFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    // Revealage is a running product of (1 - alpha); half precision avoids banding under dense particles
+    const VkFormat revealFormat = VK_FORMAT_R16_SFLOAT;
     VkFormat depthFormat{ VK_FORMAT_UNDEFINED };
     VkSampleCountFlagBits msaaSamples{ VK_SAMPLE_COUNT_1_BIT };
 
@@ -117,15 +192,82 @@ private:
     VkDeviceMemory resolveMemory{ VK_NULL_HANDLE };
     VkImageView resolveImageView{ VK_NULL_HANDLE };
 
+    /**
+     * @struct ColorTarget
+     * @brief Image, memory and view of one weighted OIT render target.
+     */
+    struct ColorTarget {
+        VkImage image{ VK_NULL_HANDLE };
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        VkImageView view{ VK_NULL_HANDLE };
+    };
+
+    // --- Weighted OIT Stage: MSAA accumulation targets and their 1x resolves ---
+    static constexpr size_t OIT_ACCUM = 0U;
+    static constexpr size_t OIT_REVEAL = 1U;
+    static constexpr size_t OIT_ACCUM_RESOLVE = 2U;
+    static constexpr size_t OIT_REVEAL_RESOLVE = 3U;
+    static constexpr size_t OIT_TARGET_COUNT = 4U;
+
+    std::array<ColorTarget, OIT_TARGET_COUNT> oitTargets{};
+    VkRenderPass oitRenderPass{ VK_NULL_HANDLE };
+    VkFramebuffer oitFramebuffer{ VK_NULL_HANDLE };
+
+    // Composite: blends the OIT average over the resolve image (LOAD), then post samples it as usual
+    VkRenderPass oitCompositePass{ VK_NULL_HANDLE };
+    VkFramebuffer oitCompositeFramebuffer{ VK_NULL_HANDLE };
+    VkDescriptorSetLayout oitSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorSet oitDescriptorSet{ VK_NULL_HANDLE };
+    VkPipeline oitPipeline{ VK_NULL_HANDLE };
+    VkPipelineLayout oitPipelineLayout{ VK_NULL_HANDLE };
+
+    // Set when the background snapshot still needs its UNDEFINED -> SHADER_READ transition
+    bool backgroundLayoutPending{ false };
+
+    // Set when a new scene depth still needs its far-plane clear and UNDEFINED -> DEPTH_READ_ONLY transition
+    bool depthLayoutPending{ false };
+
+    /**
+     * @struct TargetHandles
+     * @brief Snapshot of every resolution-dependent handle, detached for deferred destruction.
+     */
+    struct TargetHandles {
+        VkFramebuffer framebuffer{ VK_NULL_HANDLE };
+        VkImageView offscreenView{ VK_NULL_HANDLE };
+        VkImage offscreenImage{ VK_NULL_HANDLE };
+        VkDeviceMemory offscreenMemory{ VK_NULL_HANDLE };
+        VkImageView resolveView{ VK_NULL_HANDLE };
+        VkImage resolveImage{ VK_NULL_HANDLE };
+        VkDeviceMemory resolveMemory{ VK_NULL_HANDLE };
+        VkImageView depthView{ VK_NULL_HANDLE };
+        VkImage depthImage{ VK_NULL_HANDLE };
+        VkDeviceMemory depthMemory{ VK_NULL_HANDLE };
+        VkImageView backgroundView{ VK_NULL_HANDLE };
+        VkImage backgroundImage{ VK_NULL_HANDLE };
+        VkDeviceMemory backgroundMemory{ VK_NULL_HANDLE };
+        VkFramebuffer oitFramebuffer{ VK_NULL_HANDLE };
+        VkFramebuffer oitCompositeFramebuffer{ VK_NULL_HANDLE };
+        std::array<ColorTarget, OIT_TARGET_COUNT> oitTargets{};
+    };
+
     // --- Lifecycle Helpers ---
     void createOffscreenResources();
+    void createOitResources();
     void createRenderPass();
     void createTransparentRenderPass();
+    void createOitRenderPasses();
     void createFramebuffer();
     void createDescriptors();
     void createBackgroundResources();
     void cleanupResources();
-
+    void retireResources();
+    void allocateDescriptorSet();
+    TargetHandles detachTargets();
+    static void destroyTargets(const VkDevice device, const TargetHandles& targets);
+    void retirePipeline(VkPipeline& retiredPipeline, VkPipelineLayout& retiredLayout) const;
+    VkPipeline createFullscreenPipeline(const std::string& fragPath, const VkPipelineLayout layout,
+        const VkRenderPass renderPass, const VkPipelineColorBlendAttachmentState& blendAttachment) const;
 
     void internalCreateRenderPass(bool isTransparent);
+    void updateRenderExtent();
 };
\ No newline at end of file
@@ -0,0 +1,713 @@
+#include "RenderGraph.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanUtils.h"
+
+// ========================================================================
+// SECTION 1: ACCESS PRESETS
+// ========================================================================
+
+RenderGraph::Access RenderGraph::sampled() {
+    Access access{};
+    access.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    access.accessMask = VK_ACCESS_SHADER_READ_BIT;
+    access.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    access.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    return access;
+}
+
+RenderGraph::Access RenderGraph::transferSrc() {
+    Access access{};
+    access.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    access.accessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    access.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    access.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    return access;
+}
+
+RenderGraph::Access RenderGraph::transferDst() {
+    Access access{};
+    access.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    access.accessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    access.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    access.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    access.discard = true;
+    return access;
+}
+
+RenderGraph::Access RenderGraph::depthRead(const VkPipelineStageFlags stages) {
+    Access access{};
+    access.stages = stages;
+    access.accessMask = VK_ACCESS_SHADER_READ_BIT;
+    access.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    access.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    return access;
+}
+
+RenderGraph::Access RenderGraph::colorAttachment(const VkImageLayout initialLayout, const VkImageLayout finalLayout, const bool syncOut) {
+    Access access{};
+    access.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    access.accessMask = (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    access.layout = initialLayout;
+    access.finalLayout = finalLayout;
+    access.discard = (initialLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    access.syncIn = true;
+    access.syncOut = syncOut;
+    return access;
+}
+
+RenderGraph::Access RenderGraph::depthAttachment(const VkImageLayout initialLayout, const VkImageLayout finalLayout, const bool syncOut) {
+    Access access{};
+    access.stages = (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+    access.accessMask = (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    access.layout = initialLayout;
+    access.finalLayout = finalLayout;
+    access.discard = (initialLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    access.syncIn = true;
+    access.syncOut = syncOut;
+    return access;
+}
+
+// ========================================================================
+// SECTION 2: LIFECYCLE & DECLARATION
+// ========================================================================
+
+/**
+ * @brief Destructor: Destroys the transient images and their shared memory immediately.
+ * The owner destroys the graph only once the device is idle.
+ */
+RenderGraph::~RenderGraph() {
+    const VkDevice device = context->device;
+    for (const TransientImage& transient : transients) {
+        vkDestroyImageView(device, transient.view, nullptr);
+        vkDestroyImage(device, transient.image, nullptr);
+    }
+    for (const MemorySlot& slot : memorySlots) {
+        vkFreeMemory(device, slot.memory, nullptr);
+    }
+}
+
+/**
+ * @brief Drops the previous frame's passes and resources; transient memory is kept for reuse.
+ */
+void RenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+    restoreBarriers.clear();
+    restoreSrcStages = 0U;
+    restoreDstStages = 0U;
+    culledPassCount = 0U;
+    barrierBatchCount = 0U;
+}
+
+/**
+ * @brief Registers an image owned outside the graph.
+ */
+RenderGraph::ResourceId RenderGraph::importImage(const std::string& name, const VkImage image, const VkImageAspectFlags aspect,
+    const Access& state, const bool readAfterGraph)
+{
+    Resource resource{};
+    resource.name = name;
+    resource.image = image;
+    resource.aspect = aspect;
+    resource.importState = state;
+    resource.imported = true;
+    resource.readAfterGraph = readAfterGraph;
+    resources.push_back(resource);
+    return static_cast<ResourceId>(resources.size() - 1U);
+}
+
+/**
+ * @brief Registers an image the graph creates and may alias with other transients.
+ */
+RenderGraph::ResourceId RenderGraph::createImage(const std::string& name, const ImageDesc& desc) {
+    Resource resource{};
+    resource.name = name;
+    resource.aspect = desc.aspect;
+    resource.desc = desc;
+    resources.push_back(resource);
+    return static_cast<ResourceId>(resources.size() - 1U);
+}
+
+/**
+ * @brief Adds a pass in submission order.
+ */
+RenderGraph::PassId RenderGraph::addPass(const std::string& name, std::function<void(VkCommandBuffer)> record, const bool sideEffects) {
+    Pass pass{};
+    pass.name = name;
+    pass.record = std::move(record);
+    pass.sideEffects = sideEffects;
+    passes.push_back(std::move(pass));
+    return static_cast<PassId>(passes.size() - 1U);
+}
+
+void RenderGraph::read(const PassId pass, const ResourceId resource, const Access& access) {
+    passes.at(pass).uses.push_back(Use{ resource, access, false });
+}
+
+void RenderGraph::write(const PassId pass, const ResourceId resource, const Access& access) {
+    passes.at(pass).uses.push_back(Use{ resource, access, true });
+}
+
+// ========================================================================
+// SECTION 3: COMPILATION
+// ========================================================================
+
+/**
+ * @brief Culls unused passes, places transient images and computes the per-pass barriers.
+ */
+void RenderGraph::compile() {
+    cullPasses();
+    placeTransients();
+    buildBarriers();
+}
+
+/**
+ * @brief Marks passes live by walking back from images read after the graph and side-effect passes.
+ * A discarding write ends the demand for earlier contents, so writers overwritten before any read are culled.
+ */
+void RenderGraph::cullPasses() {
+    std::vector<bool> needed(resources.size(), false);
+    for (size_t i = 0U; i < resources.size(); ++i) {
+        needed[i] = resources[i].readAfterGraph;
+    }
+
+    culledPassCount = 0U;
+    for (size_t p = passes.size(); p > 0U; --p) {
+        Pass& pass = passes[p - 1U];
+
+        // Step 1: Live if forced or if it produces something still needed
+        pass.live = pass.sideEffects;
+        for (const Use& use : pass.uses) {
+            if (use.isWrite && needed[use.resource]) {
+                pass.live = true;
+            }
+        }
+        if (!pass.live) {
+            ++culledPassCount;
+            continue;
+        }
+
+        // Step 2: Discarding writes satisfy the demand, then every input becomes demanded
+        for (const Use& use : pass.uses) {
+            if (use.isWrite && use.access.discard) {
+                needed[use.resource] = false;
+            }
+        }
+        for (const Use& use : pass.uses) {
+            if (!use.isWrite || !use.access.discard) {
+                needed[use.resource] = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes transient lifetimes and (re)builds the aliased placement if it changed.
+ */
+void RenderGraph::placeTransients() {
+    // Step 1: Lifetimes in live-pass indices
+    for (uint32_t p = 0U; p < static_cast<uint32_t>(passes.size()); ++p) {
+        if (!passes[p].live) {
+            continue;
+        }
+        for (const Use& use : passes[p].uses) {
+            Resource& resource = resources[use.resource];
+            resource.firstPass = std::min(resource.firstPass, p);
+            resource.lastPass = (resource.lastPass == INVALID_ID) ? p : std::max(resource.lastPass, p);
+        }
+    }
+
+    // Step 2: Reuse last frame's placement when the transient set is unchanged
+    if (placementMatches()) {
+        size_t next = 0U;
+        for (Resource& resource : resources) {
+            if (!resource.imported && (resource.firstPass != INVALID_ID)) {
+                resource.image = transients[next].image;
+                resource.view = transients[next].view;
+                resource.memorySlot = transients[next].memorySlot;
+                ++next;
+            }
+        }
+        return;
+    }
+    retireTransients();
+
+    // Step 3: Create every used transient to learn its memory requirements
+    const VkDevice device = context->device;
+    for (const Resource& resource : resources) {
+        if (resource.imported || (resource.firstPass == INVALID_ID)) {
+            continue;
+        }
+
+        TransientImage transient{};
+        transient.name = resource.name;
+        transient.desc = resource.desc;
+        transient.firstPass = resource.firstPass;
+        transient.lastPass = resource.lastPass;
+
+        VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = resource.desc.format;
+        imageInfo.extent = { resource.desc.extent.width, resource.desc.extent.height, 1U };
+        imageInfo.mipLevels = 1U;
+        imageInfo.arrayLayers = 1U;
+        imageInfo.samples = resource.desc.samples;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = resource.desc.usage;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &transient.image) != VK_SUCCESS) {
+            throw std::runtime_error("RenderGraph: Failed to create transient image!");
+        }
+        vkGetImageMemoryRequirements(device, transient.image, &transient.requirements);
+        transients.push_back(transient);
+    }
+
+    // Step 4: Pack them into memory slots
+    std::vector<TransientRequest> requests{};
+    for (const TransientImage& transient : transients) {
+        requests.push_back(TransientRequest{ transient.requirements, transient.firstPass, transient.lastPass });
+    }
+    const TransientPlacement placement = planPlacement(requests);
+    for (size_t i = 0U; i < transients.size(); ++i) {
+        transients[i].memorySlot = placement.slotOf[i];
+        transients[i].memoryOffset = placement.offsetOf[i];
+    }
+    for (size_t s = 0U; s < placement.slotSizes.size(); ++s) {
+        memorySlots.push_back(MemorySlot{ VK_NULL_HANDLE, placement.slotSizes[s], placement.slotMemoryTypeBits[s] });
+    }
+
+    // Step 5: One allocation per slot, then bind and view every occupant
+    for (MemorySlot& slot : memorySlots) {
+        VkMemoryAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.allocationSize = slot.size;
+        allocInfo.memoryTypeIndex = VulkanUtils::findMemoryType(context->physicalDevice, slot.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &slot.memory) != VK_SUCCESS) {
+            throw std::runtime_error("RenderGraph: Failed to allocate transient memory!");
+        }
+    }
+
+    size_t next = 0U;
+    for (Resource& resource : resources) {
+        if (resource.imported || (resource.firstPass == INVALID_ID)) {
+            continue;
+        }
+        TransientImage& transient = transients[next];
+        static_cast<void>(vkBindImageMemory(device, transient.image, memorySlots[transient.memorySlot].memory, transient.memoryOffset));
+        transient.view = VulkanUtils::createImageView(device, transient.image, transient.desc.format, transient.desc.aspect, 1U);
+
+        resource.image = transient.image;
+        resource.view = transient.view;
+        resource.memorySlot = transient.memorySlot;
+        ++next;
+    }
+}
+
+/**
+ * @brief Packs transients into shared memory slots, largest first.
+ * A request joins the first slot whose memory types it shares and whose occupants' lifetimes do not
+ * overlap its own; the slot keeps only the common memory types and grows to its largest occupant.
+ */
+RenderGraph::TransientPlacement RenderGraph::planPlacement(const std::vector<TransientRequest>& requests) {
+    TransientPlacement placement{};
+    placement.slotOf.assign(requests.size(), INVALID_ID);
+    placement.offsetOf.assign(requests.size(), 0U);
+
+    std::vector<size_t> order(requests.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(), order.end(), [&requests](const size_t a, const size_t b) {
+        return requests[a].requirements.size > requests[b].requirements.size;
+    });
+
+    for (const size_t index : order) {
+        const TransientRequest& request = requests[index];
+        for (uint32_t s = 0U; (s < placement.slotSizes.size()) && (placement.slotOf[index] == INVALID_ID); ++s) {
+            if ((placement.slotMemoryTypeBits[s] & request.requirements.memoryTypeBits) == 0U) {
+                continue;
+            }
+            bool overlaps = false;
+            for (size_t other = 0U; other < requests.size(); ++other) {
+                overlaps = overlaps || ((placement.slotOf[other] == s) &&
+                    (requests[other].firstPass <= request.lastPass) && (request.firstPass <= requests[other].lastPass));
+            }
+            if (!overlaps) {
+                placement.slotOf[index] = s;
+                placement.slotMemoryTypeBits[s] &= request.requirements.memoryTypeBits;
+                placement.slotSizes[s] = std::max(placement.slotSizes[s], request.requirements.size);
+            }
+        }
+        if (placement.slotOf[index] == INVALID_ID) {
+            placement.slotOf[index] = static_cast<uint32_t>(placement.slotSizes.size());
+            placement.slotSizes.push_back(request.requirements.size);
+            placement.slotMemoryTypeBits.push_back(request.requirements.memoryTypeBits);
+        }
+    }
+    return placement;
+}
+
+/**
+ * @brief Returns true if the current transient set matches the existing placement.
+ */
+bool RenderGraph::placementMatches() const {
+    size_t next = 0U;
+    for (const Resource& resource : resources) {
+        if (resource.imported || (resource.firstPass == INVALID_ID)) {
+            continue;
+        }
+        if (next >= transients.size()) {
+            return false;
+        }
+        const TransientImage& transient = transients[next];
+        const bool same = (transient.name == resource.name) &&
+            (transient.desc.format == resource.desc.format) &&
+            (transient.desc.extent.width == resource.desc.extent.width) &&
+            (transient.desc.extent.height == resource.desc.extent.height) &&
+            (transient.desc.samples == resource.desc.samples) &&
+            (transient.desc.usage == resource.desc.usage) &&
+            (transient.desc.aspect == resource.desc.aspect) &&
+            (transient.firstPass == resource.firstPass) &&
+            (transient.lastPass == resource.lastPass);
+        if (!same) {
+            return false;
+        }
+        ++next;
+    }
+    return next == transients.size();
+}
+
+/**
+ * @brief Hands the transient images and memory to the deletion queue (frames may still use them).
+ */
+void RenderGraph::retireTransients() {
+    if (transients.empty() && memorySlots.empty()) {
+        return;
+    }
+
+    const VkDevice device = context->device;
+    auto oldTransients = std::make_shared<std::vector<TransientImage>>(std::move(transients));
+    auto oldSlots = std::make_shared<std::vector<MemorySlot>>(std::move(memorySlots));
+    transients.clear();
+    memorySlots.clear();
+
+    context->deletionQueue.retire([device, oldTransients, oldSlots]() {
+        for (const TransientImage& transient : *oldTransients) {
+            vkDestroyImageView(device, transient.view, nullptr);
+            vkDestroyImage(device, transient.image, nullptr);
+        }
+        for (const MemorySlot& slot : *oldSlots) {
+            vkFreeMemory(device, slot.memory, nullptr);
+        }
+    });
+}
+
+/**
+ * @brief Tracks each image's state through the live passes and batches the resulting barriers.
+ * * A use needs a barrier if it needs a different layout, or if it conflicts with the previous use
+ * (anything after a write, or a write after reads) and no render pass dependency already orders the
+ * two. Consecutive reads in one layout merge into one state so a later write waits for all of them.
+ * A transient taking over aliased memory always waits for the slot's previous occupant.
+ */
+void RenderGraph::buildBarriers() {
+    // Step 1: Initial states
+    for (Resource& resource : resources) {
+        resource.state = resource.imported ? resource.importState : Access{};
+        resource.stateIsWrite = false;
+    }
+    std::vector<Access> slotStates(memorySlots.size());
+    std::vector<bool> slotWritten(memorySlots.size(), false);
+
+    // Step 2: Walk the live passes in submission order
+    barrierBatchCount = 0U;
+    for (uint32_t p = 0U; p < static_cast<uint32_t>(passes.size()); ++p) {
+        Pass& pass = passes[p];
+        pass.barriers.clear();
+        pass.barrierResources.clear();
+        pass.hasMemoryBarrier = false;
+        pass.memoryBarrier.srcAccessMask = 0U;
+        pass.memoryBarrier.dstAccessMask = 0U;
+        pass.srcStages = 0U;
+        pass.dstStages = 0U;
+        if (!pass.live) {
+            continue;
+        }
+
+        for (const Use& use : pass.uses) {
+            Resource& resource = resources[use.resource];
+            const Access& next = use.access;
+
+            // Aliased handoff: inherit the previous occupant's last use, contents undefined
+            bool aliasHandoff = false;
+            if (!resource.imported && (resource.firstPass == p) && (slotStates[resource.memorySlot].stages != 0U)) {
+                resource.state = slotStates[resource.memorySlot];
+                resource.state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+                resource.state.syncOut = false;
+                resource.stateIsWrite = slotWritten[resource.memorySlot];
+                aliasHandoff = true;
+            }
+
+            const Access& prev = resource.state;
+            const bool layoutChange = (next.layout != VK_IMAGE_LAYOUT_UNDEFINED) && (next.layout != prev.layout);
+            const bool hazard = (prev.stages != 0U) && (resource.stateIsWrite || use.isWrite);
+            const bool orderedByRenderPass = !aliasHandoff && (next.syncIn || (prev.syncOut && !use.isWrite));
+
+            if (layoutChange || (hazard && !orderedByRenderPass)) {
+                pass.srcStages |= (prev.stages != 0U) ? prev.stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+                pass.dstStages |= next.stages;
+
+                if ((next.layout != VK_IMAGE_LAYOUT_UNDEFINED) || (prev.layout != VK_IMAGE_LAYOUT_UNDEFINED)) {
+                    pass.barriers.push_back(makeBarrier(resource, next));
+                    pass.barrierResources.push_back(use.resource);
+                }
+                else {
+                    // Nothing to transition (the render pass does it): a memory dependency suffices
+                    pass.hasMemoryBarrier = true;
+                    pass.memoryBarrier.srcAccessMask |= resource.stateIsWrite ? prev.accessMask : 0U;
+                    pass.memoryBarrier.dstAccessMask |= next.accessMask;
+                }
+            }
+
+            // Step 3: Advance the tracked state
+            const VkImageLayout leftLayout = (next.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) ? next.finalLayout
+                : ((next.layout != VK_IMAGE_LAYOUT_UNDEFINED) ? next.layout : prev.layout);
+            if (!use.isWrite && !resource.stateIsWrite && !layoutChange && (leftLayout == prev.layout)) {
+                resource.state.stages |= next.stages;
+                resource.state.accessMask |= next.accessMask;
+            }
+            else {
+                resource.state = next;
+                resource.state.layout = leftLayout;
+                resource.stateIsWrite = use.isWrite;
+            }
+
+            if (!resource.imported) {
+                slotStates[resource.memorySlot] = resource.state;
+                slotWritten[resource.memorySlot] = resource.stateIsWrite;
+            }
+        }
+
+        if (!pass.barriers.empty() || pass.hasMemoryBarrier) {
+            ++barrierBatchCount;
+        }
+    }
+
+    // Step 4: Return imported images to their import state; late readers also need the last write visible
+    for (const Resource& resource : resources) {
+        if (!resource.imported || (resource.state.stages == 0U)) {
+            continue;
+        }
+        const Access& target = resource.importState;
+        const bool layoutChange = (target.layout != VK_IMAGE_LAYOUT_UNDEFINED) && (target.layout != resource.state.layout);
+        const bool pendingWrite = resource.readAfterGraph && resource.stateIsWrite && !resource.state.syncOut;
+        if (layoutChange || pendingWrite) {
+            restoreBarriers.push_back(makeBarrier(resource, target));
+            restoreSrcStages |= resource.state.stages;
+            restoreDstStages |= target.stages;
+        }
+    }
+    if (!restoreBarriers.empty()) {
+        ++barrierBatchCount;
+    }
+}
+
+/**
+ * @brief Builds an image barrier from the resource's tracked state to the given access.
+ * Read-to-write hazards only need an execution dependency, so the source access is empty.
+ */
+VkImageMemoryBarrier RenderGraph::makeBarrier(const Resource& resource, const Access& to) {
+    const Access& from = resource.state;
+
+    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcAccessMask = resource.stateIsWrite ? from.accessMask : 0U;
+    barrier.dstAccessMask = to.accessMask;
+    barrier.oldLayout = to.discard ? VK_IMAGE_LAYOUT_UNDEFINED : from.layout;
+    barrier.newLayout = (to.layout != VK_IMAGE_LAYOUT_UNDEFINED) ? to.layout : from.layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = resource.image;
+    barrier.subresourceRange = { resource.aspect, 0U, 1U, 0U, 1U };
+    return barrier;
+}
+
+// ========================================================================
+// SECTION 4: EXECUTION
+// ========================================================================
+
+/**
+ * @brief Records each live pass preceded by its barrier batch, then restores imported images.
+ */
+void RenderGraph::execute(const VkCommandBuffer cb) const {
+    for (const Pass& pass : passes) {
+        if (!pass.live) {
+            continue;
+        }
+
+        if (!pass.barriers.empty() || pass.hasMemoryBarrier) {
+            vkCmdPipelineBarrier(cb, pass.srcStages, pass.dstStages, 0U,
+                pass.hasMemoryBarrier ? 1U : 0U, &pass.memoryBarrier,
+                0U, nullptr,
+                static_cast<uint32_t>(pass.barriers.size()), pass.barriers.data());
+        }
+
+        pass.record(cb);
+    }
+
+    if (!restoreBarriers.empty()) {
+        vkCmdPipelineBarrier(cb, restoreSrcStages, restoreDstStages, 0U, 0U, nullptr, 0U, nullptr,
+            static_cast<uint32_t>(restoreBarriers.size()), restoreBarriers.data());
+    }
+}
+
+// ========================================================================
+// SECTION 5: INSPECTION DUMPS
+// ========================================================================
+
+/**
+ * @brief Writes the compiled graph in Graphviz DOT format (passes as boxes, images as ellipses).
+ * Edges that needed a barrier are labelled with their layout transition; culled passes are dashed.
+ */
+void RenderGraph::writeGraphviz(std::ostream& out) const {
+    out << "digraph RenderGraph {\n";
+    out << "    rankdir=LR;\n";
+    out << "    node [fontname=\"Helvetica\", fontsize=10];\n";
+
+    for (size_t i = 0U; i < resources.size(); ++i) {
+        const Resource& resource = resources[i];
+        std::string kind{ "\\n(imported)" };
+        if (!resource.imported) {
+            kind = (resource.memorySlot == INVALID_ID) ? std::string("\\n(transient, unused)")
+                : ("\\n(transient, slot " + std::to_string(resource.memorySlot) + ")");
+        }
+        out << "    r" << i << " [shape=ellipse, label=" << quoted(resource.name + kind) << "];\n";
+    }
+
+    for (size_t p = 0U; p < passes.size(); ++p) {
+        const Pass& pass = passes[p];
+        out << "    p" << p << " [shape=box, label=" << quoted(pass.name)
+            << (pass.live ? std::string("") : std::string(", style=dashed, color=gray")) << "];\n";
+
+        for (const Use& use : pass.uses) {
+            std::string label{};
+            for (size_t b = 0U; b < pass.barriers.size(); ++b) {
+                if (pass.barrierResources[b] == use.resource) {
+                    label = std::string(layoutName(pass.barriers[b].oldLayout)) + " -> " + layoutName(pass.barriers[b].newLayout);
+                }
+            }
+            if (use.isWrite) {
+                out << "    p" << p << " -> r" << use.resource;
+            }
+            else {
+                out << "    r" << use.resource << " -> p" << p;
+            }
+            out << " [label=" << quoted(label) << "];\n";
+        }
+    }
+    out << "}\n";
+}
+
+/**
+ * @brief Writes the compiled graph, its barriers and the transient placement as JSON.
+ */
+void RenderGraph::writeJson(std::ostream& out) const {
+    out << "{\n  \"passes\": [";
+    for (size_t p = 0U; p < passes.size(); ++p) {
+        const Pass& pass = passes[p];
+        out << ((p == 0U) ? "\n" : ",\n");
+        out << "    { \"name\": " << quoted(pass.name) << ", \"live\": " << (pass.live ? "true" : "false");
+
+        out << ", \"reads\": [";
+        bool first = true;
+        for (const Use& use : pass.uses) {
+            if (!use.isWrite) {
+                out << (first ? "" : ", ") << quoted(resources[use.resource].name);
+                first = false;
+            }
+        }
+        out << "], \"writes\": [";
+        first = true;
+        for (const Use& use : pass.uses) {
+            if (use.isWrite) {
+                out << (first ? "" : ", ") << quoted(resources[use.resource].name);
+                first = false;
+            }
+        }
+
+        out << "], \"srcStages\": " << pass.srcStages << ", \"dstStages\": " << pass.dstStages;
+        out << ", \"memoryBarrier\": " << (pass.hasMemoryBarrier ? "true" : "false") << ", \"barriers\": [";
+        for (size_t b = 0U; b < pass.barriers.size(); ++b) {
+            const VkImageMemoryBarrier& barrier = pass.barriers[b];
+            out << ((b == 0U) ? "" : ", ") << "{ \"image\": " << quoted(resources[pass.barrierResources[b]].name)
+                << ", \"oldLayout\": " << quoted(layoutName(barrier.oldLayout))
+                << ", \"newLayout\": " << quoted(layoutName(barrier.newLayout))
+                << ", \"srcAccess\": " << barrier.srcAccessMask << ", \"dstAccess\": " << barrier.dstAccessMask << " }";
+        }
+        out << "] }";
+    }
+
+    const auto index = [](const uint32_t value) {
+        return (value == INVALID_ID) ? int64_t{ -1 } : static_cast<int64_t>(value);
+    };
+
+    out << "\n  ],\n  \"resources\": [";
+    for (size_t i = 0U; i < resources.size(); ++i) {
+        const Resource& resource = resources[i];
+        out << ((i == 0U) ? "\n" : ",\n");
+        out << "    { \"name\": " << quoted(resource.name) << ", \"imported\": " << (resource.imported ? "true" : "false")
+            << ", \"readAfterGraph\": " << (resource.readAfterGraph ? "true" : "false")
+            << ", \"firstPass\": " << index(resource.firstPass)
+            << ", \"lastPass\": " << index(resource.lastPass)
+            << ", \"memorySlot\": " << index(resource.memorySlot)
+            << " }";
+    }
+
+    out << "\n  ],\n  \"memorySlots\": [";
+    for (size_t s = 0U; s < memorySlots.size(); ++s) {
+        out << ((s == 0U) ? "" : ", ") << "{ \"size\": " << memorySlots[s].size << " }";
+    }
+    out << "],\n  \"culledPasses\": " << culledPassCount << ",\n  \"barrierBatches\": " << barrierBatchCount << "\n}\n";
+}
+
+/**
+ * @brief Escapes a name for the JSON and DOT dumps.
+ * DOT line breaks ("\\n") are kept as written.
+ */
+std::string RenderGraph::quoted(const std::string& text) {
+    std::string result{ "\"" };
+    for (const char c : text) {
+        if (c == '"') {
+            result += "\\\"";
+        }
+        else {
+            result += c;
+        }
+    }
+    result += "\"";
+    return result;
+}
+
+/**
+ * @brief Returns a short readable name for a layout (dumps only).
+ */
+const char* RenderGraph::layoutName(const VkImageLayout layout) {
+    switch (layout) {
+    case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+    case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT";
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_ATTACHMENT";
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL: return "DEPTH_READ_ONLY";
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY";
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC";
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST";
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC";
+    default: return "OTHER";
+    }
+}
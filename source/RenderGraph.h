@@ -0,0 +1,304 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+/**
+ * @class RenderGraph
+ * @brief Frame graph that derives the barriers between passes from their declared image accesses.
+ * * Each frame the renderer imports the images it owns, adds its passes in submission order and
+ * declares every image a pass reads or writes. compile() then culls passes whose results nothing
+ * consumes, gives graph-created (transient) images memory that is shared between images whose
+ * lifetimes do not overlap, and computes one batched vkCmdPipelineBarrier per pass.
+ * * Render passes keep their own VkSubpassDependency objects: an access marked syncIn/syncOut is
+ * ordered by the render pass itself, so the graph only adds a barrier there when a layout change is
+ * needed outside the pass. Imported images leave the graph in the state they entered it with, so
+ * the state declared at import stays true from one frame to the next.
+ */
+class RenderGraph final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t INVALID_ID = 0xFFFFFFFFU;
+
+    using ResourceId = uint32_t;
+    using PassId = uint32_t;
+
+    /**
+     * @struct Access
+     * @brief How one pass uses one image.
+     * * layout is what the pass needs on entry (UNDEFINED: a render pass performs its own initial
+     * transition); finalLayout is what it leaves behind. discard means earlier contents are not needed.
+     */
+    struct Access {
+        VkPipelineStageFlags stages{ 0U };
+        VkAccessFlags accessMask{ 0U };
+        VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+        VkImageLayout finalLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+        bool discard{ false };
+        bool syncIn{ false };   /**< The pass's EXTERNAL->0 dependency orders this access after earlier work. */
+        bool syncOut{ false };  /**< The pass's 0->EXTERNAL dependency makes this write visible to later reads. */
+    };
+
+    /**
+     * @struct ImageDesc
+     * @brief Creation parameters of a transient image (device-local, single mip and layer).
+     */
+    struct ImageDesc {
+        VkFormat format{ VK_FORMAT_UNDEFINED };
+        VkExtent2D extent{ 0U, 0U };
+        VkSampleCountFlagBits samples{ VK_SAMPLE_COUNT_1_BIT };
+        VkImageUsageFlags usage{ 0U };
+        VkImageAspectFlags aspect{ VK_IMAGE_ASPECT_COLOR_BIT };
+    };
+
+    /**
+     * @struct TransientRequest
+     * @brief What the placement needs to know about one transient: its memory requirements and live-pass interval.
+     */
+    struct TransientRequest {
+        VkMemoryRequirements requirements{};
+        uint32_t firstPass{ INVALID_ID };
+        uint32_t lastPass{ INVALID_ID };
+    };
+
+    /**
+     * @struct TransientPlacement
+     * @brief Where planPlacement() put each request, and the memory slots it asked for.
+     */
+    struct TransientPlacement {
+        std::vector<uint32_t> slotOf{};             /**< Memory slot of each request. */
+        std::vector<VkDeviceSize> offsetOf{};       /**< Bind offset of each request inside its slot. */
+        std::vector<VkDeviceSize> slotSizes{};
+        std::vector<uint32_t> slotMemoryTypeBits{}; /**< Memory types every occupant of the slot accepts. */
+    };
+
+    // --- Access Presets ---
+
+    /** @brief Fragment shader sampling. */
+    static Access sampled();
+
+    /** @brief Source of a transfer copy. */
+    static Access transferSrc();
+
+    /** @brief Destination of a transfer copy that overwrites the whole image. */
+    static Access transferDst();
+
+    /** @brief Depth sampled read-only by the given shader stages (e.g. compute collision). */
+    static Access depthRead(const VkPipelineStageFlags stages);
+
+    /** @brief Colour attachment (or resolve target) of a render pass with the given attachment layouts. */
+    static Access colorAttachment(const VkImageLayout initialLayout, const VkImageLayout finalLayout, const bool syncOut = false);
+
+    /** @brief Depth attachment of a render pass with the given attachment layouts. */
+    static Access depthAttachment(const VkImageLayout initialLayout, const VkImageLayout finalLayout, const bool syncOut = false);
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Transient images are created lazily by the first compile() that needs them. */
+    explicit RenderGraph(VulkanContext* const inContext) : context(inContext) {}
+
+    /** @brief Destructor: Destroys the transient images and their shared memory immediately. */
+    ~RenderGraph();
+
+    // RAII: Owns transient images and memory; prevent duplication.
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // --- Declaration (once per frame) ---
+
+    /** @brief Drops the previous frame's passes and resources; transient memory is kept for reuse. */
+    void reset();
+
+    /**
+     * @brief Registers an image owned outside the graph.
+     * @param state How the image was last used before the graph runs; it is restored afterwards.
+     * @param readAfterGraph True if later work (e.g. the final pass) reads it, which keeps its writers alive.
+     */
+    ResourceId importImage(const std::string& name, const VkImage image, const VkImageAspectFlags aspect,
+        const Access& state, const bool readAfterGraph);
+
+    /** @brief Registers an image the graph creates and may alias with other transients. */
+    ResourceId createImage(const std::string& name, const ImageDesc& desc);
+
+    /**
+     * @brief Adds a pass in submission order.
+     * @param sideEffects True if the pass must run even when nothing reads its outputs.
+     */
+    PassId addPass(const std::string& name, std::function<void(VkCommandBuffer)> record, const bool sideEffects = false);
+
+    /** @brief Declares that the pass reads the image. */
+    void read(const PassId pass, const ResourceId resource, const Access& access);
+
+    /**
+     * @brief Declares that the pass writes the image.
+     * Unless the access discards, the write also depends on the previous contents.
+     */
+    void write(const PassId pass, const ResourceId resource, const Access& access);
+
+    // --- Compilation & Execution ---
+
+    /** @brief Culls unused passes, places transient images and computes the per-pass barriers. */
+    void compile();
+
+    /** @brief Records each live pass preceded by its barrier batch, then restores imported images. */
+    void execute(const VkCommandBuffer cb) const;
+
+    /** @brief Returns the image of a resource (transients are valid after compile()). */
+    VkImage getImage(const ResourceId resource) const { return resources.at(resource).image; }
+
+    /** @brief Returns the view of a transient resource after compile(). */
+    VkImageView getImageView(const ResourceId resource) const { return resources.at(resource).view; }
+
+    /** @brief Returns true if the pass survived culling in the last compile(). */
+    bool isLive(const PassId pass) const { return passes.at(pass).live; }
+
+    // --- Inspection ---
+
+    /** @brief Returns the number of passes culled by the last compile(). */
+    uint32_t getCulledPassCount() const { return culledPassCount; }
+
+    /** @brief Returns the number of vkCmdPipelineBarrier calls the last compile() produced. */
+    uint32_t getBarrierBatchCount() const { return barrierBatchCount; }
+
+    /** @brief Writes the compiled graph in Graphviz DOT format (passes as boxes, images as ellipses). */
+    void writeGraphviz(std::ostream& out) const;
+
+    /** @brief Writes the compiled graph, its barriers and the transient placement as JSON. */
+    void writeJson(std::ostream& out) const;
+
+    // --- Transient Placement ---
+
+    /**
+     * @brief Packs transients into shared memory slots; compile() uses it, RenderGraphTest checks it without a device.
+     * Requests are placed largest first into the first slot whose memory types they accept and whose
+     * occupants' lifetimes do not overlap theirs; every occupant of a slot is bound at offset 0.
+     */
+    static TransientPlacement planPlacement(const std::vector<TransientRequest>& requests);
+
+private:
+    /**
+     * @struct Resource
+     * @brief One image node; transients reference a slot of shared memory.
+     */
+    struct Resource {
+        std::string name{};
+        VkImage image{ VK_NULL_HANDLE };
+        VkImageView view{ VK_NULL_HANDLE };
+        VkImageAspectFlags aspect{ VK_IMAGE_ASPECT_COLOR_BIT };
+        Access importState{};
+        Access state{};
+        bool stateIsWrite{ false };
+        bool imported{ false };
+        bool readAfterGraph{ false };
+        ImageDesc desc{};
+        uint32_t memorySlot{ INVALID_ID };
+        uint32_t firstPass{ INVALID_ID };
+        uint32_t lastPass{ INVALID_ID };
+    };
+
+    /**
+     * @struct Use
+     * @brief One declared access of a pass.
+     */
+    struct Use {
+        ResourceId resource{ INVALID_ID };
+        Access access{};
+        bool isWrite{ false };
+    };
+
+    /**
+     * @struct Pass
+     * @brief A recording callback, its declared uses and the barriers compiled in front of it.
+     */
+    struct Pass {
+        std::string name{};
+        std::function<void(VkCommandBuffer)> record{};
+        std::vector<Use> uses{};
+        bool sideEffects{ false };
+        bool live{ false };
+        std::vector<VkImageMemoryBarrier> barriers{};
+        std::vector<ResourceId> barrierResources{};
+        VkMemoryBarrier memoryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        bool hasMemoryBarrier{ false };
+        VkPipelineStageFlags srcStages{ 0U };
+        VkPipelineStageFlags dstStages{ 0U };
+    };
+
+    /**
+     * @struct TransientImage
+     * @brief A created transient image bound into one memory slot at a fixed offset.
+     */
+    struct TransientImage {
+        std::string name{};
+        ImageDesc desc{};
+        VkImage image{ VK_NULL_HANDLE };
+        VkImageView view{ VK_NULL_HANDLE };
+        VkMemoryRequirements requirements{};
+        uint32_t memorySlot{ INVALID_ID };
+        VkDeviceSize memoryOffset{ 0U };
+        uint32_t firstPass{ INVALID_ID };
+        uint32_t lastPass{ INVALID_ID };
+    };
+
+    /**
+     * @struct MemorySlot
+     * @brief One device allocation shared by transients with disjoint lifetimes.
+     */
+    struct MemorySlot {
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        VkDeviceSize size{ 0U };
+        uint32_t memoryTypeBits{ 0U };
+    };
+
+    VulkanContext* context{ nullptr };
+
+    // --- Current Frame Declaration ---
+    std::vector<Resource> resources{};
+    std::vector<Pass> passes{};
+
+    // --- Transient Placement (kept across frames while the declaration is unchanged) ---
+    std::vector<TransientImage> transients{};
+    std::vector<MemorySlot> memorySlots{};
+
+    // --- Restore Barriers Recorded After The Last Pass ---
+    std::vector<VkImageMemoryBarrier> restoreBarriers{};
+    VkPipelineStageFlags restoreSrcStages{ 0U };
+    VkPipelineStageFlags restoreDstStages{ 0U };
+
+    uint32_t culledPassCount{ 0U };
+    uint32_t barrierBatchCount{ 0U };
+
+    // --- Compilation Steps ---
+
+    /** @brief Marks passes live by walking back from images read after the graph and side-effect passes. */
+    void cullPasses();
+
+    /** @brief Computes transient lifetimes and (re)builds the aliased placement (see planPlacement()) if it changed. */
+    void placeTransients();
+
+    /** @brief Tracks each image's state through the live passes and batches the resulting barriers. */
+    void buildBarriers();
+
+    /** @brief Returns true if the current transient set matches the existing placement. */
+    bool placementMatches() const;
+
+    /** @brief Hands the transient images and memory to the deletion queue (frames may still use them). */
+    void retireTransients();
+
+    /** @brief Builds an image barrier from the resource's tracked state to the given access. */
+    static VkImageMemoryBarrier makeBarrier(const Resource& resource, const Access& to);
+
+    /** @brief Escapes a name for the JSON and DOT dumps. */
+    static std::string quoted(const std::string& text);
+
+    /** @brief Returns a short readable name for a layout (dumps only). */
+    static const char* layoutName(const VkImageLayout layout);
+};
@@ -0,0 +1,183 @@
+#include "RenderGraphTest.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <random>
+/* parasoft-end-suppress ALL */
+
+#include "RenderGraph.h"
+
+namespace {
+    /**
+     * @struct TestScenario
+     * @brief A named set of transient requests and the slot count the packer must reach (0: rules only).
+     */
+    struct TestScenario {
+        const char* name;
+        std::vector<RenderGraph::TransientRequest> requests;
+        uint32_t expectedSlots;
+    };
+
+    constexpr VkDeviceSize MIB = 1024U * 1024U;
+    constexpr VkDeviceSize IMAGE_ALIGNMENT = 0x10000U;   /**< Typical optimal-tiling image alignment. */
+    constexpr uint32_t TYPES_DEVICE_LOCAL = 0x3U;          /**< Two device-local memory types, as most drivers expose. */
+
+    /**
+     * @brief Builds one request the way vkGetImageMemoryRequirements() would report it.
+     */
+    RenderGraph::TransientRequest makeRequest(const VkDeviceSize size, const VkDeviceSize alignment, const uint32_t memoryTypeBits,
+        const uint32_t firstPass, const uint32_t lastPass)
+    {
+        RenderGraph::TransientRequest request{};
+        request.requirements.size = size;
+        request.requirements.alignment = alignment;
+        request.requirements.memoryTypeBits = memoryTypeBits;
+        request.firstPass = firstPass;
+        request.lastPass = lastPass;
+        return request;
+    }
+
+    /**
+     * @brief The fixed scenarios: back-to-back lifetimes, one shared pass, disjoint memory types and a frame-like chain.
+     */
+    std::vector<TestScenario> buildScenarios() {
+        std::vector<TestScenario> scenarios{};
+
+        // Three images, each dead before the next is born: one slot sized for the largest
+        scenarios.push_back(TestScenario{ "sequential", {
+            makeRequest(8U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 0U, 1U),
+            makeRequest(4U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 2U, 3U),
+            makeRequest(2U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 4U, 5U) }, 1U });
+
+        // All three alive in pass 2: nothing may alias
+        scenarios.push_back(TestScenario{ "concurrent", {
+            makeRequest(8U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 0U, 2U),
+            makeRequest(4U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 2U, 3U),
+            makeRequest(2U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 1U, 4U) }, 3U });
+
+        // Types 0-1 and 1-2 share type 1; type 3 shares nothing and needs its own slot
+        scenarios.push_back(TestScenario{ "memory-types", {
+            makeRequest(8U * MIB, IMAGE_ALIGNMENT, 0x3U, 0U, 1U),
+            makeRequest(4U * MIB, IMAGE_ALIGNMENT, 0x6U, 2U, 3U),
+            makeRequest(2U * MIB, IMAGE_ALIGNMENT, 0x8U, 4U, 5U) }, 2U });
+
+        // A frame: MSAA scene colour and depth, the OIT accumulation and revealage, the refraction copy, bloom
+        scenarios.push_back(TestScenario{ "frame", {
+            makeRequest(32U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 1U, 4U),   // scene_msaa
+            makeRequest(16U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 1U, 4U),   // scene_depth
+            makeRequest(8U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 1U, 2U),    // refraction_copy
+            makeRequest(64U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 3U, 4U),   // oit_accum
+            makeRequest(16U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 3U, 4U),   // oit_reveal
+            makeRequest(4U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 5U, 6U),    // bloom_half
+            makeRequest(1U * MIB, IMAGE_ALIGNMENT, TYPES_DEVICE_LOCAL, 6U, 7U) }, 4U });   // bloom_quarter
+
+        // Random sizes, alignments, memory types and lifetimes: rules only
+        std::mt19937 rng(RenderGraphTest::RANDOM_SEED);
+        std::uniform_int_distribution<uint32_t> rndPass(0U, RenderGraphTest::RANDOM_PASS_COUNT - 1U);
+        std::uniform_int_distribution<uint32_t> rndLength(0U, 3U);
+        std::uniform_int_distribution<uint32_t> rndAlignShift(8U, 16U);
+        std::uniform_int_distribution<uint32_t> rndBlocks(1U, 256U);
+        constexpr std::array<uint32_t, 5> typeChoices = { 0x1U, 0x3U, 0x6U, 0x7U, 0x8U };
+        std::uniform_int_distribution<size_t> rndType(0U, typeChoices.size() - 1U);
+
+        TestScenario randomScenario{ "random", {}, 0U };
+        for (uint32_t i = 0U; i < RenderGraphTest::RANDOM_REQUEST_COUNT; ++i) {
+            const VkDeviceSize alignment = static_cast<VkDeviceSize>(1U) << rndAlignShift(rng);
+            const uint32_t firstPass = rndPass(rng);
+            const uint32_t lastPass = std::min(firstPass + rndLength(rng), RenderGraphTest::RANDOM_PASS_COUNT - 1U);
+            randomScenario.requests.push_back(makeRequest(alignment * rndBlocks(rng), alignment, typeChoices[rndType(rng)],
+                firstPass, lastPass));
+        }
+        scenarios.push_back(randomScenario);
+
+        return scenarios;
+    }
+}
+
+// ========================================================================
+// SECTION 1: PLACEMENT CHECK
+// ========================================================================
+
+/**
+ * @brief Plans every scenario and checks each placed request against its slot and its slot mates.
+ */
+std::vector<RenderGraphTestResult> RenderGraphTest::run() {
+    std::vector<RenderGraphTestResult> results{};
+    for (const TestScenario& scenario : buildScenarios()) {
+        // Step 1: The same packing compile() performs
+        const RenderGraph::TransientPlacement placement = RenderGraph::planPlacement(scenario.requests);
+
+        RenderGraphTestResult result{};
+        result.scenario = scenario.name;
+        result.transients = static_cast<uint32_t>(scenario.requests.size());
+        result.slots = static_cast<uint32_t>(placement.slotSizes.size());
+        result.expectedSlots = scenario.expectedSlots;
+        for (const VkDeviceSize size : placement.slotSizes) {
+            result.allocatedBytes += size;
+        }
+
+        // Step 2: Each request inside its slot, aligned, in memory its slot can allocate from
+        for (size_t i = 0U; i < scenario.requests.size(); ++i) {
+            const VkMemoryRequirements& requirements = scenario.requests[i].requirements;
+            result.requestedBytes += requirements.size;
+
+            const uint32_t slot = placement.slotOf[i];
+            if (slot >= result.slots) {
+                ++result.rangeViolations;
+                continue;
+            }
+            const VkDeviceSize offset = placement.offsetOf[i];
+            if (((offset % requirements.alignment) != 0U) || ((offset + requirements.size) > placement.slotSizes[slot])) {
+                ++result.rangeViolations;
+            }
+            const uint32_t slotTypes = placement.slotMemoryTypeBits[slot];
+            if ((slotTypes == 0U) || ((slotTypes & ~requirements.memoryTypeBits) != 0U)) {
+                ++result.typeViolations;
+            }
+
+            // Step 3: No slot mate may be alive in any pass this request is alive in
+            for (size_t j = i + 1U; j < scenario.requests.size(); ++j) {
+                const RenderGraph::TransientRequest& other = scenario.requests[j];
+                if ((placement.slotOf[j] == slot) &&
+                    (other.firstPass <= scenario.requests[i].lastPass) && (scenario.requests[i].firstPass <= other.lastPass)) {
+                    ++result.overlapViolations;
+                }
+            }
+        }
+
+        // Step 4: Every rule holds, and hand-made scenarios reach their slot count
+        result.passed = (result.typeViolations == 0U) && (result.rangeViolations == 0U) && (result.overlapViolations == 0U) &&
+            ((result.expectedSlots == 0U) || (result.slots == result.expectedSlots));
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+// ========================================================================
+// SECTION 2: REPORTING
+// ========================================================================
+
+/**
+ * @brief Prints the results in scenario order.
+ */
+bool RenderGraphTest::report(std::ostream& out, const std::vector<RenderGraphTestResult>& results) {
+    bool passed = !results.empty();
+    for (const RenderGraphTestResult& result : results) {
+        out << "RenderGraphTest: " << std::left << std::setw(12) << result.scenario << std::right
+            << " | " << (result.passed ? "PASS" : "FAIL")
+            << " | " << result.transients << " transients in " << result.slots << " slots";
+        if (result.expectedSlots != 0U) {
+            out << " (expected " << result.expectedSlots << ")";
+        }
+        out << " | " << std::fixed << std::setprecision(1)
+            << (static_cast<double>(result.allocatedBytes) / static_cast<double>(MIB)) << " of "
+            << (static_cast<double>(result.requestedBytes) / static_cast<double>(MIB)) << " MiB allocated"
+            << " | " << result.typeViolations << " memory-type, " << result.rangeViolations << " offset/range, "
+            << result.overlapViolations << " lifetime violations" << std::endl;
+        passed = passed && result.passed;
+    }
+    return passed;
+}
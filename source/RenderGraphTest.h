@@ -0,0 +1,56 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @struct RenderGraphTestResult
+ * @brief Outcome of RenderGraph::planPlacement() for one scenario of transient requests.
+ * Any violated placement rule fails the scenario; so does a slot count other than the expected one.
+ */
+struct RenderGraphTestResult final {
+    std::string scenario{ "" };
+    uint32_t transients{ 0U };
+    uint32_t slots{ 0U };
+    uint32_t expectedSlots{ 0U };     /**< 0 if the scenario only checks the rules. */
+    uint64_t requestedBytes{ 0U };    /**< Sum of the requests' sizes (what separate allocations would take). */
+    uint64_t allocatedBytes{ 0U };    /**< Sum of the slot sizes. */
+    uint32_t typeViolations{ 0U };    /**< Slot memory types empty or not accepted by an occupant. */
+    uint32_t rangeViolations{ 0U };   /**< Offset misaligned, or the image runs past the end of its slot. */
+    uint32_t overlapViolations{ 0U }; /**< Two occupants of a slot alive in the same pass. */
+    bool passed{ false };
+};
+
+/**
+ * @class RenderGraphTest
+ * @brief Checks the transient memory placement of RenderGraph (--test-render-graph).
+ * * Synthetic memory requirements and lifetimes go through the same planPlacement() that compile()
+ * uses. Every placement must keep an image inside its slot at an offset aligned to its
+ * requirements, give each slot memory types that all its occupants accept, and never share a slot
+ * between images alive in the same pass. Hand-made scenarios also fix the number of slots; a
+ * seeded random one checks only the rules.
+ * * Only plain CPU code runs: no window, device or image is created, so the test runs anywhere.
+ */
+class RenderGraphTest final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t RANDOM_REQUEST_COUNT = 64U;
+    static constexpr uint32_t RANDOM_PASS_COUNT = 16U;
+    static constexpr uint32_t RANDOM_SEED = 1234U;
+
+    /** @brief Plans every scenario and checks the placement rules. */
+    static std::vector<RenderGraphTestResult> run();
+
+    /** @brief Writes one line per scenario; returns true if every scenario passed. */
+    static bool report(std::ostream& out, const std::vector<RenderGraphTestResult>& results);
+
+private:
+    // Static utility class: Constructor and Destructor are private to prevent instantiation.
+    RenderGraphTest() = default;
+    ~RenderGraphTest() = default;
+};
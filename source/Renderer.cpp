@@ -1,237 +1,619 @@
 #include "Renderer.h"
 
 /* parasoft-begin-suppress ALL */
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <stdexcept>
 /* parasoft-end-suppress ALL */
 
 /**
  * @brief Orchestrates the multi-pass command recording sequence for a single frame.
  */
-void Renderer::recordFrame(
-    const VkCommandBuffer cb,
-    const VkExtent2D& extent,
-    const std::map<std::string, std::unique_ptr<Model>>& models,
-    const std::vector<std::unique_ptr<Model>>& ownedModels,
-    const std::vector<Mesh*>& opaqueMeshes,
-    const std::vector<Mesh*>& transparentMeshes,
-    const Skybox* const skybox,
-    const ParticleSystem* const dustSystem,
-    const ParticleSystem* const fireSystem,
-    const ParticleSystem* const smokeSystem,
-    const ParticleSystem* const rainSystem,
-    const ParticleSystem* const snowSystem,
-    const PostProcessor* const postProcessor,
-    const VkDescriptorSet globalDescriptorSet,
-    const VkRenderPass shadowPass,
-    const VkFramebuffer shadowFramebuffer,
-    const std::vector<Pipeline*>& pipelines,
-    const bool enableDust,
-    const bool enableFire,
-    const bool enableSmoke,
-    const bool enableRain,
-    const bool enableSnow
-) const {
-    // Step 1: Shadow Mapping Pass
-    // Records depth information from the light's perspective into the shadow map.
-    recordShadowPass(cb, shadowPass, shadowFramebuffer, models, ownedModels,
-        pipelines.at(PIPELINE_IDX_SHADOW), globalDescriptorSet);
-
-    // Step 2: Main Opaque Pass
-    // Renders the skybox and all non-transparent scene geometry.
-    recordOpaquePass(cb, extent, opaqueMeshes, skybox, postProcessor, globalDescriptorSet);
-
-    // Step 3: Resolve Synchronization Barrier
-    // Transition the MSAA resolve target for refractive sampling.
-    const VkImageMemoryBarrier resolveBarrier{
-        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        nullptr,
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-        VK_ACCESS_TRANSFER_READ_BIT,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-        VK_QUEUE_FAMILY_IGNORED,
-        VK_QUEUE_FAMILY_IGNORED,
-        postProcessor->getResolveImage(),
-        { VK_IMAGE_ASPECT_COLOR_BIT, 0U, 1U, 0U, 1U }
-    };
-
-    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        VK_PIPELINE_STAGE_TRANSFER_BIT, 0U, 0U, nullptr, 0U, nullptr, 1U, &resolveBarrier);
-
-    // Step 4: Refraction Bridge
+void Renderer::recordFrame(const FrameInputs& inputs) {
+    const auto frameStart = std::chrono::high_resolution_clock::now();
+    const SyncManager* const sync = inputs.sync;
+    const PostProcessor* const postProcessor = inputs.postProcessor;
+    const uint32_t frameIndex = inputs.frameIndex;
+
+    // The shadow pass culls against the light's ortho volume, the main passes against the camera
+    const FrustumCuller::Planes lightPlanes = FrustumCuller::extractPlanes(inputs.lightViewProj);
+    const FrustumCuller::Planes cameraPlanes = FrustumCuller::extractPlanes(inputs.cameraViewProj);
+
+    // Step 0: GPU Culling
+    // Compacts the indirect command ranges for both views before any render pass begins.
+    if (indirectDraws != nullptr) {
+        indirectDraws->recordCulling(inputs.commandBuffer, cameraPlanes, lightPlanes);
+    }
+
+    // Step 0.5: CPU Occlusion
+    // Occluders are rasterized before the workers start; the camera passes then only read the buffer.
+    const OcclusionCuller* occlusion{ nullptr };
+    if (inputs.toggles.occlusionCulling && (occlusionCuller != nullptr) && occlusionCuller->hasOccluders()) {
+        occlusionCuller->rasterize(inputs.cameraViewProj);
+        occlusion = occlusionCuller;
+    }
+
+    // Step 1: Parallel Pass Recording
+    // Each worker resets its own pool and fills its own secondary buffer; nothing below is shared-mutable.
+    const VkCommandBuffer shadowCacheSecondary = sync->getSecondaryCommandBuffer(frameIndex, PASS_SHADOW, SLOT_SHADOW_CACHE);
+    const VkCommandBuffer shadowSecondary = sync->getSecondaryCommandBuffer(frameIndex, PASS_SHADOW, SLOT_PASS);
+    const VkCommandBuffer opaqueSecondary = sync->getSecondaryCommandBuffer(frameIndex, PASS_OPAQUE, SLOT_PASS);
+    const VkCommandBuffer transparentSecondary = sync->getSecondaryCommandBuffer(frameIndex, PASS_TRANSPARENT, SLOT_PASS);
+    const VkFramebuffer offscreenFramebuffer = postProcessor->getOffscreenFramebuffer();
+    const Pipeline* const shadowPipeline = inputs.pipelines->at(PIPELINE_IDX_SHADOW);
+    const bool depthPrePass = inputs.toggles.depthPrePass && hasDepthPrePass();
+    const bool weightedOIT = inputs.toggles.weightedOit && hasWeightedOit() && postProcessor->hasOitResolve();
+    const VkRenderPass transparentPass = weightedOIT ? postProcessor->getOitRenderPass() : postProcessor->getTransparentRenderPass();
+    const VkFramebuffer transparentFramebuffer = weightedOIT ? postProcessor->getOitFramebuffer() : offscreenFramebuffer;
+
+    // Static opaque geometry: executed from a bundle that is only re-recorded when its key changes
+    const StaticDrawBundle* const bundled =
+        (inputs.toggles.staticBundles && (staticBundle != nullptr) && !staticBundle->isEmpty()) ? staticBundle : nullptr;
+    const StaticDrawBundle::Key bundleKey{ postProcessor->getOffscreenRenderPass(), offscreenFramebuffer, inputs.extent,
+        inputs.globalDescriptorSet, getObjectSet(), depthPrePass, Material::getGeneration(), inputs.descriptorGeneration };
+    VkCommandBuffer bundleSecondary{ VK_NULL_HANDLE };
+
+    passJobs.clear();
+    passJobs.push_back([&]() {
+        PassContext& pass = passes[PASS_SHADOW];
+        recordPassJob(pass, sync->getSecondaryPool(frameIndex, PASS_SHADOW), [&]() {
+            if (inputs.shadowTargets.refreshCache) {
+                recordSecondary(pass, shadowCacheSecondary, inputs.shadowTargets.cachePass, inputs.shadowTargets.cacheFramebuffer,
+                    [&](CommandEncoder& encoder) {
+                        recordShadowPass(pass, encoder, inputs.lightPos, lightPlanes, *inputs.models, *inputs.ownedModels,
+                            shadowPipeline, inputs.globalDescriptorSet, false);
+                    });
+            }
+            recordSecondary(pass, shadowSecondary, inputs.shadowTargets.overlayPass, inputs.shadowTargets.overlayFramebuffer,
+                [&](CommandEncoder& encoder) {
+                    recordShadowPass(pass, encoder, inputs.lightPos, lightPlanes, *inputs.models, *inputs.ownedModels,
+                        shadowPipeline, inputs.globalDescriptorSet, true);
+                });
+        });
+    });
+    passJobs.push_back([&]() {
+        PassContext& pass = passes[PASS_OPAQUE];
+        recordPassJob(pass, sync->getSecondaryPool(frameIndex, PASS_OPAQUE), [&]() {
+            if (bundled != nullptr) {
+                bundleSecondary = prepareStaticBundle(pass, inputs.imageIndex, frameIndex, bundleKey, inputs.viewPos);
+            }
+            recordSecondary(pass, opaqueSecondary, postProcessor->getOffscreenRenderPass(), offscreenFramebuffer,
+                [&](CommandEncoder& encoder) {
+                    recordOpaquePass(pass, encoder, inputs.extent, inputs.viewPos, cameraPlanes, occlusion, bundled,
+                        *inputs.opaqueMeshes, inputs.skybox, inputs.globalDescriptorSet, depthPrePass);
+                });
+        });
+    });
+    passJobs.push_back([&]() {
+        PassContext& pass = passes[PASS_TRANSPARENT];
+        recordPassJob(pass, sync->getSecondaryPool(frameIndex, PASS_TRANSPARENT), [&]() {
+            recordSecondary(pass, transparentSecondary, transparentPass, transparentFramebuffer,
+                [&](CommandEncoder& encoder) {
+                    recordTransparentPass(pass, encoder, inputs, cameraPlanes, occlusion, weightedOIT);
+                });
+        });
+    });
+    workers.run(passJobs);
+
+    // Step 2: Frame Graph Resources
+    // Every image that crosses a pass boundary, in the state it is left in between frames.
+    const VkImageLayout shaderRead = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    const VkImageLayout colorLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    const VkImageLayout depthLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    frameGraph.reset();
+    const RenderGraph::ResourceId shadowCacheMap = frameGraph.importImage("shadow_cache", inputs.shadowTargets.cacheImage,
+        VK_IMAGE_ASPECT_DEPTH_BIT, RenderGraph::transferSrc(), false);
+    const RenderGraph::ResourceId shadowMap = frameGraph.importImage("shadow_map", inputs.shadowTargets.shadowImage,
+        VK_IMAGE_ASPECT_DEPTH_BIT, RenderGraph::sampled(), false);
+    const RenderGraph::ResourceId sceneMsaa = frameGraph.importImage("scene_msaa", postProcessor->getOffscreenImage(),
+        VK_IMAGE_ASPECT_COLOR_BIT, RenderGraph::colorAttachment(colorLayout, colorLayout), false);
+    // The depth outlives the frame: the next frame's particle simulations collide against it
+    const RenderGraph::ResourceId sceneDepth = frameGraph.importImage("scene_depth", postProcessor->getDepthImage(),
+        VK_IMAGE_ASPECT_DEPTH_BIT, RenderGraph::depthRead(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT), true);
+    const RenderGraph::ResourceId sceneResolve = frameGraph.importImage("scene_resolve", postProcessor->getResolveImage(),
+        VK_IMAGE_ASPECT_COLOR_BIT, RenderGraph::sampled(), true);
+    const RenderGraph::ResourceId refraction = frameGraph.importImage("refraction_snapshot", postProcessor->getBackgroundImage(),
+        VK_IMAGE_ASPECT_COLOR_BIT, RenderGraph::sampled(), false);
+
+    // Step 3: Shadow Mapping Passes
+    // Static casters are redrawn into the cache only when it was invalidated; the cache is then
+    // copied into the sampled map and the dynamic casters are drawn on top of it.
+    const VkExtent2D shadowExtent{ EngineConstants::SHADOW_MAP_RES, EngineConstants::SHADOW_MAP_RES };
+    if (inputs.shadowTargets.refreshCache) {
+        const RenderGraph::PassId cachePass = frameGraph.addPass("shadow_cache_refresh", [&](const VkCommandBuffer passCb) {
+            VkClearValue shadowClear{};
+            shadowClear.depthStencil = { DEPTH_CLEAR_VAL, 0U };
+
+            VkRenderPassBeginInfo cachePassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+            cachePassInfo.renderPass = inputs.shadowTargets.cachePass;
+            cachePassInfo.framebuffer = inputs.shadowTargets.cacheFramebuffer;
+            cachePassInfo.renderArea.extent = shadowExtent;
+            cachePassInfo.clearValueCount = 1U;
+            cachePassInfo.pClearValues = &shadowClear;
+            executePass(passCb, cachePassInfo, shadowCacheSecondary);
+        });
+        frameGraph.write(cachePass, shadowCacheMap,
+            RenderGraph::depthAttachment(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, true));
+    }
+
+    const RenderGraph::PassId copyPass = frameGraph.addPass("shadow_cache_copy", [&](const VkCommandBuffer passCb) {
+        recordShadowCacheCopy(passCb, inputs.shadowTargets.cacheImage, inputs.shadowTargets.shadowImage);
+    });
+    frameGraph.read(copyPass, shadowCacheMap, RenderGraph::transferSrc());
+    frameGraph.write(copyPass, shadowMap, RenderGraph::transferDst());
+
+    const RenderGraph::PassId overlayPass = frameGraph.addPass("shadow_overlay", [&](const VkCommandBuffer passCb) {
+        VkRenderPassBeginInfo overlayPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+        overlayPassInfo.renderPass = inputs.shadowTargets.overlayPass;
+        overlayPassInfo.framebuffer = inputs.shadowTargets.overlayFramebuffer;
+        overlayPassInfo.renderArea.extent = shadowExtent;
+        executePass(passCb, overlayPassInfo, shadowSecondary);
+    });
+    frameGraph.write(overlayPass, shadowMap,
+        RenderGraph::depthAttachment(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, shaderRead, true));
+
+    // Step 4: Main Opaque Pass
+    // Renders the skybox and all non-transparent scene geometry; the static bundle runs first so the
+    // skybox (depth-tested at the far plane) only fills what neither secondary covered.
+    const RenderGraph::PassId opaquePass = frameGraph.addPass("opaque", [&](const VkCommandBuffer passCb) {
+        std::array<VkClearValue, 3U> clearValues{};
+        clearValues[0].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
+        clearValues[1].depthStencil = { 1.0f, 0U };
+        clearValues[2].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
+
+        VkRenderPassBeginInfo opaquePassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+        opaquePassInfo.renderPass = postProcessor->getOffscreenRenderPass();
+        opaquePassInfo.framebuffer = offscreenFramebuffer;
+        opaquePassInfo.renderArea.extent = inputs.extent;
+        opaquePassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        opaquePassInfo.pClearValues = clearValues.data();
+        if (bundleSecondary != VK_NULL_HANDLE) {
+            const std::array<VkCommandBuffer, 2U> secondaries{ bundleSecondary, opaqueSecondary };
+            executePass(passCb, opaquePassInfo, secondaries.data(), static_cast<uint32_t>(secondaries.size()));
+        }
+        else {
+            executePass(passCb, opaquePassInfo, opaqueSecondary);
+        }
+    });
+    frameGraph.read(opaquePass, shadowMap, RenderGraph::sampled());
+    frameGraph.write(opaquePass, sceneMsaa, RenderGraph::colorAttachment(VK_IMAGE_LAYOUT_UNDEFINED, colorLayout));
+    frameGraph.write(opaquePass, sceneDepth, RenderGraph::depthAttachment(VK_IMAGE_LAYOUT_UNDEFINED, depthLayout));
+    frameGraph.write(opaquePass, sceneResolve, RenderGraph::colorAttachment(VK_IMAGE_LAYOUT_UNDEFINED, shaderRead));
+
+    // Step 5: Refraction Bridge
     // Copies the resolved opaque scene to a texture for glass/water refraction.
-    if (postProcessor != nullptr) {
-        postProcessor->copyScene(cb);
+    const RenderGraph::PassId refractionPass = frameGraph.addPass("refraction_copy", [&](const VkCommandBuffer passCb) {
+        postProcessor->copyScene(passCb);
+    });
+    frameGraph.read(refractionPass, sceneResolve, RenderGraph::transferSrc());
+    frameGraph.write(refractionPass, refraction, RenderGraph::transferDst());
+
+    // Step 6: Transparent & Particle Pass
+    // Renders glass, liquids, and environmental particles with alpha blending, or accumulates them
+    // order-independently and composites the weighted average over the resolved scene.
+    const RenderGraph::PassId transPass = frameGraph.addPass(weightedOIT ? "transparent_oit" : "transparent",
+        [&](const VkCommandBuffer passCb) {
+            std::array<VkClearValue, PostProcessor::ATTACHMENT_COUNT_OIT> transClearValues{};
+            if (weightedOIT) {
+                transClearValues[0].color = { {0.0f, 0.0f, 0.0f, 0.0f} };   // Accumulation: empty sum
+                transClearValues[1].color = { {1.0f, 0.0f, 0.0f, 0.0f} };   // Revealage: fully revealed
+            }
+
+            VkRenderPassBeginInfo transPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+            transPassInfo.renderPass = transparentPass;
+            transPassInfo.framebuffer = transparentFramebuffer;
+            transPassInfo.renderArea.extent = inputs.extent;
+            transPassInfo.clearValueCount = static_cast<uint32_t>(transClearValues.size());
+            transPassInfo.pClearValues = transClearValues.data();
+            executePass(passCb, transPassInfo, transparentSecondary);
+        });
+    frameGraph.read(transPass, refraction, RenderGraph::sampled());
+    frameGraph.read(transPass, shadowMap, RenderGraph::sampled());
+    frameGraph.write(transPass, sceneDepth, RenderGraph::depthAttachment(depthLayout, depthLayout));   // Stored for the next frame
+
+    if (weightedOIT) {
+        const RenderGraph::ResourceId oitAccum = frameGraph.importImage("oit_accum", postProcessor->getOitAccumImage(),
+            VK_IMAGE_ASPECT_COLOR_BIT, RenderGraph::sampled(), false);
+        const RenderGraph::ResourceId oitReveal = frameGraph.importImage("oit_reveal", postProcessor->getOitRevealImage(),
+            VK_IMAGE_ASPECT_COLOR_BIT, RenderGraph::sampled(), false);
+        frameGraph.write(transPass, oitAccum, RenderGraph::colorAttachment(VK_IMAGE_LAYOUT_UNDEFINED, shaderRead, true));
+        frameGraph.write(transPass, oitReveal, RenderGraph::colorAttachment(VK_IMAGE_LAYOUT_UNDEFINED, shaderRead, true));
+
+        const RenderGraph::PassId compositePass = frameGraph.addPass("oit_composite", [&](const VkCommandBuffer passCb) {
+            postProcessor->recordOitComposite(passCb);
+        });
+        frameGraph.read(compositePass, oitAccum, RenderGraph::sampled());
+        frameGraph.read(compositePass, oitReveal, RenderGraph::sampled());
+        frameGraph.write(compositePass, sceneResolve, RenderGraph::colorAttachment(shaderRead, shaderRead));
+    }
+    else {
+        frameGraph.write(transPass, sceneMsaa, RenderGraph::colorAttachment(colorLayout, colorLayout));
+        frameGraph.write(transPass, sceneResolve, RenderGraph::colorAttachment(shaderRead, shaderRead));
     }
 
-    // Step 5: Transparent & Particle Pass
-    // Renders glass, liquids, and environmental particles with alpha blending.
-    recordTransparentPass(cb, extent, transparentMeshes, dustSystem, fireSystem, smokeSystem,
-        rainSystem, snowSystem, postProcessor, globalDescriptorSet,
-        enableDust, enableFire, enableSmoke, enableRain, enableSnow);
+    // Step 7: Compile (cull, place, derive barriers) and record into the primary buffer
+    frameGraph.compile();
+    frameGraph.execute(inputs.commandBuffer);
+
+    // Step 8: Merge the per-worker counters into frame totals
+    lastFrameStats = EncoderStats{};
+    for (const PassContext& pass : passes) {
+        lastFrameStats.bindsIssued += pass.encoderStats.bindsIssued;
+        lastFrameStats.bindsSkipped += pass.encoderStats.bindsSkipped;
+        lastFrameStats.drawCalls += pass.encoderStats.drawCalls;
+    }
+
+    shadowCullStats = passes[PASS_SHADOW].cullStats;
+    cameraCullStats.visible = passes[PASS_OPAQUE].cullStats.visible + passes[PASS_TRANSPARENT].cullStats.visible;
+    cameraCullStats.culled = passes[PASS_OPAQUE].cullStats.culled + passes[PASS_TRANSPARENT].cullStats.culled;
+    cameraCullStats.occluded = passes[PASS_OPAQUE].cullStats.occluded + passes[PASS_TRANSPARENT].cullStats.occluded;
+
+    recordTimings.shadowMs = passes[PASS_SHADOW].cpuMs;
+    recordTimings.opaqueMs = passes[PASS_OPAQUE].cpuMs;
+    recordTimings.transparentMs = passes[PASS_TRANSPARENT].cpuMs;
+    recordTimings.threads = workers.getThreadCount();
+    recordTimings.wallMs = std::chrono::duration<double, std::chrono::seconds::period>(
+        std::chrono::high_resolution_clock::now() - frameStart).count() * MILLIS_PER_SECOND;
 }
 
 /**
- * @brief Records the depth-only shadow pass for all shadow-casting models.
+ * @brief Begins a secondary buffer that continues the given render pass (subpass 0).
  */
-void Renderer::recordShadowPass(
-    const VkCommandBuffer cb,
-    const VkRenderPass renderPass,
-    const VkFramebuffer framebuffer,
-    const std::map<std::string, std::unique_ptr<Model>>& models,
-    const std::vector<std::unique_ptr<Model>>& ownedModels,
-    const Pipeline* const shadowPipeline,
-    const VkDescriptorSet globalSet
-) const {
-    VkRenderPassBeginInfo shadowPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
-    shadowPassInfo.renderPass = renderPass;
-    shadowPassInfo.framebuffer = framebuffer;
-    shadowPassInfo.renderArea.extent = { EngineConstants::SHADOW_MAP_RES, EngineConstants::SHADOW_MAP_RES };
+void Renderer::beginSecondary(const VkCommandBuffer secondary, const VkRenderPass renderPass, const VkFramebuffer framebuffer,
+    const bool reusable)
+{
+    VkCommandBufferInheritanceInfo inheritance{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+    inheritance.renderPass = renderPass;
+    inheritance.subpass = 0U;
+    inheritance.framebuffer = framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    if (!reusable) {
+        beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    }
+    beginInfo.pInheritanceInfo = &inheritance;
 
-    VkClearValue shadowClear{};
-    shadowClear.depthStencil = { DEPTH_CLEAR_VAL, 0U };
-    shadowPassInfo.clearValueCount = 1U;
-    shadowPassInfo.pClearValues = &shadowClear;
+    if (vkBeginCommandBuffer(secondary, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Renderer: Failed to begin secondary command buffer!");
+    }
+}
 
-    vkCmdBeginRenderPass(cb, &shadowPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+/**
+ * @brief Resets the worker's pool and counters, runs the job's recordings and times them.
+ * Runs on a recording worker; only touches the given PassContext and the worker-owned pool.
+ */
+void Renderer::recordPassJob(PassContext& pass, const VkCommandPool pool, const std::function<void()>& body) const {
+    const auto start = std::chrono::high_resolution_clock::now();
 
-    const float shadowRes = static_cast<float>(EngineConstants::SHADOW_MAP_RES);
-    const VkViewport sv{ 0.0f, 0.0f, shadowRes, shadowRes, 0.0f, 1.0f };
-    vkCmdSetViewport(cb, 0U, 1U, &sv);
+    // The frame's fence has been waited on, so the pool's previous recordings are no longer in use
+    static_cast<void>(vkResetCommandPool(context->device, pool, 0U));
+    pass.encoderStats = EncoderStats{};
+    pass.cullStats = CullStats{};
 
-    const VkRect2D ss{ {0, 0}, {EngineConstants::SHADOW_MAP_RES, EngineConstants::SHADOW_MAP_RES} };
-    vkCmdSetScissor(cb, 0U, 1U, &ss);
+    body();
 
-    // Step 1: Draw global scene models
-    for (const auto& [name, model] : models) {
-        if (model->castsShadows()) {
-            model->draw(cb, globalSet, shadowPipeline);
-        }
-    }
+    pass.cpuMs = std::chrono::duration<double, std::chrono::seconds::period>(
+        std::chrono::high_resolution_clock::now() - start).count() * MILLIS_PER_SECOND;
+}
 
-    // Step 2: Draw instanced foliage or specialized meshes
-    for (const auto& model : ownedModels) {
-        if (model && model->castsShadows()) {
-            model->draw(cb, globalSet, shadowPipeline);
-        }
+/**
+ * @brief Records one secondary buffer through a fresh encoder and adds its counters to the pass.
+ */
+void Renderer::recordSecondary(PassContext& pass, const VkCommandBuffer secondary, const VkRenderPass renderPass,
+    const VkFramebuffer framebuffer, const std::function<void(CommandEncoder&)>& body, const bool reusable)
+{
+    beginSecondary(secondary, renderPass, framebuffer, reusable);
+
+    CommandEncoder encoder(secondary);
+    body(encoder);
+
+    const EncoderStats& stats = encoder.getStats();
+    pass.encoderStats.bindsIssued += stats.bindsIssued;
+    pass.encoderStats.bindsSkipped += stats.bindsSkipped;
+    pass.encoderStats.drawCalls += stats.drawCalls;
+
+    if (vkEndCommandBuffer(secondary) != VK_SUCCESS) {
+        throw std::runtime_error("Renderer: Failed to record secondary command buffer!");
     }
+}
 
+/**
+ * @brief Copies the static shadow cache into the sampled shadow map.
+ * The frame graph has already moved the map to TRANSFER_DST after the previous frame's sampling.
+ */
+void Renderer::recordShadowCacheCopy(const VkCommandBuffer cb, const VkImage cacheImage, const VkImage shadowImage) {
+    VkImageCopy region{};
+    region.srcSubresource = { VK_IMAGE_ASPECT_DEPTH_BIT, 0U, 0U, 1U };
+    region.dstSubresource = { VK_IMAGE_ASPECT_DEPTH_BIT, 0U, 0U, 1U };
+    region.extent = { EngineConstants::SHADOW_MAP_RES, EngineConstants::SHADOW_MAP_RES, 1U };
+
+    vkCmdCopyImage(cb, cacheImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        shadowImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1U, &region);
+}
+
+/**
+ * @brief Records a render pass in the primary buffer whose contents are one secondary buffer.
+ */
+void Renderer::executePass(const VkCommandBuffer cb, const VkRenderPassBeginInfo& passInfo, const VkCommandBuffer secondary) {
+    executePass(cb, passInfo, &secondary, 1U);
+}
+
+/**
+ * @brief Records a render pass in the primary buffer whose contents are several secondaries, in order.
+ */
+void Renderer::executePass(const VkCommandBuffer cb, const VkRenderPassBeginInfo& passInfo,
+    const VkCommandBuffer* const secondaries, const uint32_t secondaryCount)
+{
+    vkCmdBeginRenderPass(cb, &passInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    vkCmdExecuteCommands(cb, secondaryCount, secondaries);
     vkCmdEndRenderPass(cb);
 }
 
 /**
- * @brief Records the primary opaque rendering pass (Scene geometry + Skybox).
+ * @brief Returns the (image, frame) static bundle, re-recording it first if it is out of date.
+ * The bundle sets its own viewport (dynamic state is not inherited between secondaries) and holds the
+ * same pre-pass/colour split as the per-frame pass. Its draws are sorted by state once, at record time.
  */
-void Renderer::recordOpaquePass(
-    const VkCommandBuffer cb,
-    const VkExtent2D& extent,
-    const std::vector<Mesh*>& opaque,
-    const Skybox* const skybox,
-    const PostProcessor* const postProcessor,
-    const VkDescriptorSet globalSet
+VkCommandBuffer Renderer::prepareStaticBundle(
+    PassContext& pass,
+    const uint32_t imageIndex,
+    const uint32_t frameIndex,
+    const StaticDrawBundle::Key& key,
+    const glm::vec3& viewPos
 ) const {
-    VkRenderPassBeginInfo opaquePassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
-    opaquePassInfo.renderPass = postProcessor->getOffscreenRenderPass();
-    opaquePassInfo.framebuffer = postProcessor->getOffscreenFramebuffer();
-    opaquePassInfo.renderArea.extent = extent;
+    // Step 1: Reuse - the pair's previous recording still matches everything it baked in
+    if (staticBundle->isCurrent(imageIndex, frameIndex, key)) {
+        staticBundle->markReused(imageIndex, frameIndex);
+        return staticBundle->getBuffer(imageIndex, frameIndex);
+    }
 
-    std::array<VkClearValue, 3U> clearValues{};
-    clearValues[0].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
-    clearValues[1].depthStencil = { 1.0f, 0U };
-    clearValues[2].color = { {0.0f, 0.0f, 0.0f, 1.0f} };
+    // Step 2: Re-record every bundled mesh, unculled
+    const auto start = std::chrono::high_resolution_clock::now();
+    const VkCommandBuffer bundle = staticBundle->getBuffer(imageIndex, frameIndex);
 
-    opaquePassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    opaquePassInfo.pClearValues = clearValues.data();
+    pass.drawList.begin(viewPos);
+    for (const Mesh* const mesh : staticBundle->getMeshes()) {
+        pass.drawList.add(DrawList::Pass::Opaque, mesh);
+    }
+    pass.drawList.sort();
 
-    vkCmdBeginRenderPass(cb, &opaquePassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    recordSecondary(pass, bundle, key.renderPass, key.framebuffer, [&](CommandEncoder& encoder) {
+        setViewportAndScissor(encoder.getCommandBuffer(), key.extent);
+        if (key.depthPrePass) {
+            recordDrawList(pass, encoder, key.globalSet, key.objectSet, &prePassPipelines);
+        }
+        recordDrawList(pass, encoder, key.globalSet, key.objectSet, key.depthPrePass ? &equalTestPipelines : nullptr);
+    }, true);
 
+    const double cpuMs = std::chrono::duration<double, std::chrono::seconds::period>(
+        std::chrono::high_resolution_clock::now() - start).count() * MILLIS_PER_SECOND;
+    staticBundle->markRecorded(imageIndex, frameIndex, key, cpuMs, static_cast<uint32_t>(pass.drawList.getItems().size()));
+    return bundle;
+}
+
+/**
+ * @brief Sets the full-extent viewport and scissor (dynamic state is not inherited by secondaries).
+ */
+void Renderer::setViewportAndScissor(const VkCommandBuffer cb, const VkExtent2D& extent) {
     const VkViewport vp{ 0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f };
-    vkCmdSetViewport(cb, 0U, 1U, &vp);
+    vkCmdSetViewport(cb, 0U, VIEWPORT_COUNT_ONE, &vp);
 
     const VkRect2D sc{ {0, 0}, extent };
-    vkCmdSetScissor(cb, 0U, 1U, &sc);
+    vkCmdSetScissor(cb, 0U, SCISSOR_COUNT_ONE, &sc);
+}
 
-    if (skybox != nullptr) {
-        skybox->draw(cb, globalSet);
+/**
+ * @brief Records every item of the pass's sorted draw list through the encoder.
+ * With a remap, each item is drawn with its substitute pipeline, or not at all if it has none.
+ */
+void Renderer::recordDrawList(const PassContext& pass, CommandEncoder& encoder, const VkDescriptorSet globalSet,
+    const VkDescriptorSet objectSet, const IndirectDrawSystem::PipelineMap* const pipelineRemap)
+{
+    for (const DrawList::DrawItem& item : pass.drawList.getItems()) {
+        const Pipeline* pipeline = item.pipeline;
+        if (pipelineRemap != nullptr) {
+            const auto substitute = pipelineRemap->find(item.pipeline);
+            if (substitute == pipelineRemap->end()) {
+                continue;
+            }
+            pipeline = substitute->second;
+        }
+        item.mesh->draw(encoder, globalSet, objectSet, pipeline);
     }
+}
 
-    for (Mesh* const mesh : opaque) {
-        if (mesh != nullptr) {
-            mesh->draw(cb, globalSet);
+/**
+ * @brief Culls the pass's candidates against the planes and adds the survivors to its draw list.
+ * The pass's cull counters accumulate, so one job may cull several candidate sets.
+ */
+void Renderer::addVisible(PassContext& pass, const DrawList::Pass drawPass, const FrustumCuller::Planes& planes,
+    const Pipeline* const pipelineOverride, const OcclusionCuller* const occlusion)
+{
+    // Step 1: Load the world bounds into the SoA streams
+    pass.culler.reset();
+    for (const Mesh* const mesh : pass.cullCandidates) {
+        static_cast<void>(pass.culler.add(mesh->getWorldBounds()));
+    }
+
+    // Step 2: Batch test, then forward only the survivors that no occluder hides to sorting
+    CullStats stats = pass.culler.cull(planes);
+    for (uint32_t i = 0U; i < pass.culler.getCount(); ++i) {
+        if (!pass.culler.isVisible(i)) {
+            continue;
         }
+        if ((occlusion != nullptr) && !occlusion->isVisible(pass.cullCandidates[i]->getWorldBounds())) {
+            ++stats.occluded;
+            continue;
+        }
+        pass.drawList.add(drawPass, pass.cullCandidates[i], pipelineOverride);
     }
+    pass.drawList.sort();
 
-    vkCmdEndRenderPass(cb);
+    pass.cullStats.visible += stats.visible - stats.occluded;
+    pass.cullStats.culled += stats.culled;
+    pass.cullStats.occluded += stats.occluded;
 }
 
 /**
- * @brief Helper to record draw calls for active environmental particle systems.
+ * @brief Records the depth-only shadow pass contents for one class of shadow-casting models.
+ * Static casters go into the cached map (including the GPU-driven batches, which only hold static
+ * casters); dynamic casters are redrawn every frame on top of the copied cache.
  */
-void Renderer::recordParticlePass(
-    const VkCommandBuffer cb,
-    const ParticleSystem* const dust,
-    const ParticleSystem* const fire,
-    const ParticleSystem* const smoke,
-    const ParticleSystem* const rain,
-    const ParticleSystem* const snow,
-    const bool dustEnabled,
-    const bool fireEnabled,
-    const bool smokeEnabled,
-    const bool rainEnabled,
-    const bool snowEnabled,
-    const VkDescriptorSet globalSet
+void Renderer::recordShadowPass(
+    PassContext& pass,
+    CommandEncoder& encoder,
+    const glm::vec3& lightPos,
+    const FrustumCuller::Planes& lightPlanes,
+    const std::map<std::string, std::unique_ptr<Model>>& models,
+    const std::vector<std::unique_ptr<Model>>& ownedModels,
+    const Pipeline* const shadowPipeline,
+    const VkDescriptorSet globalSet,
+    const bool dynamicCasters
 ) const {
-    if (dustEnabled && (dust != nullptr)) { dust->draw(cb, globalSet); }
-    if (fireEnabled && (fire != nullptr)) { fire->draw(cb, globalSet); }
-    if (smokeEnabled && (smoke != nullptr)) { smoke->draw(cb, globalSet); }
-    if (rainEnabled && (rain != nullptr)) { rain->draw(cb, globalSet); }
-    if (snowEnabled && (snow != nullptr)) { snow->draw(cb, globalSet); }
+    setViewportAndScissor(encoder.getCommandBuffer(), { EngineConstants::SHADOW_MAP_RES, EngineConstants::SHADOW_MAP_RES });
+
+    // Step 1: Gather global scene models (single pipeline, so the key orders by material then depth)
+    // With the GPU-driven path active only the static casters it could not take are gathered here.
+    pass.cullCandidates.clear();
+    const bool useIndirect = (indirectDraws != nullptr) && !dynamicCasters;
+    if (useIndirect) {
+        const std::vector<const Mesh*>& fallback = indirectDraws->getFallbackMeshes(IndirectDrawSystem::View::Shadow);
+        pass.cullCandidates.assign(fallback.begin(), fallback.end());
+    }
+    else {
+        for (const auto& [name, model] : models) {
+            if (model->castsShadows() && (model->isDynamicShadowCaster() == dynamicCasters)) {
+                for (const auto& mesh : model->getMeshes()) {
+                    pass.cullCandidates.push_back(mesh.get());
+                }
+            }
+        }
+
+        // Step 2: Gather instanced foliage or specialized meshes
+        for (const auto& model : ownedModels) {
+            if (model && model->castsShadows() && (model->isDynamicShadowCaster() == dynamicCasters)) {
+                for (const auto& mesh : model->getMeshes()) {
+                    pass.cullCandidates.push_back(mesh.get());
+                }
+            }
+        }
+    }
+
+    // Step 3: Drop casters outside the light volume, then record the sorted draws
+    pass.drawList.begin(lightPos);
+    addVisible(pass, DrawList::Pass::Shadow, lightPlanes, shadowPipeline);
+    recordDrawList(pass, encoder, globalSet, getObjectSet());
+
+    // Step 4: GPU-culled casters, one indirect draw per material batch
+    if (useIndirect) {
+        indirectDraws->recordDraws(encoder, IndirectDrawSystem::View::Shadow, globalSet);
+    }
 }
 
 /**
- * @brief Records the transparent rendering pass.
+ * @brief Records the primary opaque pass contents (Scene geometry + Skybox).
+ * With the depth pre-pass, visible opaque geometry first lays down depth only; the colour draws
+ * then test EQUAL without writing, so each covered pixel is shaded once.
+ * Meshes drawn by the static bundle are dropped from the candidates before culling.
  */
-void Renderer::recordTransparentPass(
-    const VkCommandBuffer cb,
+void Renderer::recordOpaquePass(
+    PassContext& pass,
+    CommandEncoder& encoder,
     const VkExtent2D& extent,
-    const std::vector<Mesh*>& transparent,
-    const ParticleSystem* const dust,
-    const ParticleSystem* const fire,
-    const ParticleSystem* const smoke,
-    const ParticleSystem* const rain,
-    const ParticleSystem* const snow,
-    const PostProcessor* const postProcessor,
+    const glm::vec3& viewPos,
+    const FrustumCuller::Planes& cameraPlanes,
+    const OcclusionCuller* const occlusion,
+    const StaticDrawBundle* const bundled,
+    const std::vector<Mesh*>& opaque,
+    const Skybox* const skybox,
     const VkDescriptorSet globalSet,
-    const bool dustEnabled,
-    const bool fireEnabled,
-    const bool smokeEnabled,
-    const bool rainEnabled,
-    const bool snowEnabled
+    const bool depthPrePass
 ) const {
-    VkRenderPassBeginInfo transPassInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
-    transPassInfo.renderPass = postProcessor->getTransparentRenderPass();
-    transPassInfo.framebuffer = postProcessor->getOffscreenFramebuffer();
-    transPassInfo.renderArea.extent = extent;
-
-    const std::array<VkClearValue, 3U> dummyValues{};
-    transPassInfo.clearValueCount = static_cast<uint32_t>(dummyValues.size());
-    transPassInfo.pClearValues = dummyValues.data();
+    const VkCommandBuffer cb = encoder.getCommandBuffer();
+    setViewportAndScissor(cb, extent);
+
+    // Step 1: Cull once; both the pre-pass and the colour pass draw the same survivors
+    pass.drawList.begin(viewPos);
+    if (indirectDraws != nullptr) {
+        const std::vector<const Mesh*>& fallback = indirectDraws->getFallbackMeshes(IndirectDrawSystem::View::Camera);
+        pass.cullCandidates.assign(fallback.begin(), fallback.end());
+    }
+    else {
+        pass.cullCandidates.assign(opaque.begin(), opaque.end());
+    }
+    if (bundled != nullptr) {
+        pass.cullCandidates.erase(std::remove_if(pass.cullCandidates.begin(), pass.cullCandidates.end(),
+            [bundled](const Mesh* const mesh) { return bundled->contains(mesh); }), pass.cullCandidates.end());
+    }
+    addVisible(pass, DrawList::Pass::Opaque, cameraPlanes, nullptr, occlusion);
+    const VkDescriptorSet objectSet = getObjectSet();
+
+    // Step 2: Depth-only pre-pass (before the skybox, so the sky is only shaded where nothing covers it)
+    if (depthPrePass) {
+        recordDrawList(pass, encoder, globalSet, objectSet, &prePassPipelines);
+        if (indirectDraws != nullptr) {
+            indirectDraws->recordDraws(encoder, IndirectDrawSystem::View::Camera, globalSet, &prePassPipelines);
+        }
+    }
 
-    vkCmdBeginRenderPass(cb, &transPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    if (skybox != nullptr) {
+        skybox->draw(cb, globalSet);
+    }
 
-    const VkViewport vp{ 0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f };
-    vkCmdSetViewport(cb, 0U, 1U, &vp);
+    // Step 3: Colour pass; the skybox binds its own pipeline and sets behind the encoder
+    encoder.invalidate();
+    const IndirectDrawSystem::PipelineMap* const colorRemap = depthPrePass ? &equalTestPipelines : nullptr;
+    recordDrawList(pass, encoder, globalSet, objectSet, colorRemap);
 
-    const VkRect2D sc{ {0, 0}, extent };
-    vkCmdSetScissor(cb, 0U, 1U, &sc);
+    // GPU-culled opaque meshes
+    if (indirectDraws != nullptr) {
+        indirectDraws->recordDraws(encoder, IndirectDrawSystem::View::Camera, globalSet, colorRemap);
+    }
+}
 
-    for (Mesh* const mesh : transparent) {
-        if (mesh != nullptr) {
-            mesh->draw(cb, globalSet);
-        }
+/**
+ * @brief Helper to record draw calls for active environmental particle systems.
+ * With the unified engine set, one multi-draw covers every emitter (disabled ones have no live particles).
+ */
+void Renderer::recordParticlePass(const VkCommandBuffer cb, const FrameInputs& inputs, const bool weightedOIT) const {
+    const VkDescriptorSet globalSet = inputs.globalDescriptorSet;
+    if (particleEngine != nullptr) {
+        particleEngine->draw(cb, globalSet, weightedOIT);
+        return;
     }
 
-    recordParticlePass(cb, dust, fire, smoke, rain, snow, dustEnabled, fireEnabled, smokeEnabled, rainEnabled, snowEnabled, globalSet);
+    const FrameToggles& toggles = inputs.toggles;
+    if (toggles.dust && (inputs.dustSystem != nullptr)) { inputs.dustSystem->draw(cb, globalSet, weightedOIT); }
+    if (toggles.fire && (inputs.fireSystem != nullptr)) { inputs.fireSystem->draw(cb, globalSet, weightedOIT); }
+    if (toggles.smoke && (inputs.smokeSystem != nullptr)) { inputs.smokeSystem->draw(cb, globalSet, weightedOIT); }
+    if (toggles.rain && (inputs.rainSystem != nullptr)) { inputs.rainSystem->draw(cb, globalSet, weightedOIT); }
+    if (toggles.snow && (inputs.snowSystem != nullptr)) { inputs.snowSystem->draw(cb, globalSet, weightedOIT); }
+}
 
-    vkCmdEndRenderPass(cb);
-}
\ No newline at end of file
+/**
+ * @brief Records the transparent pass contents.
+ * In weighted OIT mode the draws go through the OIT twins; draw order no longer matters, but the list
+ * is still sorted so both modes share one path.
+ */
+void Renderer::recordTransparentPass(
+    PassContext& pass,
+    CommandEncoder& encoder,
+    const FrameInputs& inputs,
+    const FrustumCuller::Planes& cameraPlanes,
+    const OcclusionCuller* const occlusion,
+    const bool weightedOIT
+) const {
+    const VkCommandBuffer cb = encoder.getCommandBuffer();
+    setViewportAndScissor(cb, inputs.extent);
+
+    pass.drawList.begin(inputs.viewPos);
+    pass.cullCandidates.assign(inputs.transparentMeshes->begin(), inputs.transparentMeshes->end());
+    addVisible(pass, DrawList::Pass::Transparent, cameraPlanes, nullptr, occlusion);
+    recordDrawList(pass, encoder, inputs.globalDescriptorSet, getObjectSet(), weightedOIT ? &oitPipelines : nullptr);
+
+    // Particle systems bind their own state after this point
+    recordParticlePass(cb, inputs, weightedOIT);
+}
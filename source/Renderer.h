@@ -7,6 +7,7 @@
 #include <array>
 #include <map>
 #include <string>
+#include <functional>
 /* parasoft-end-suppress ALL */
 
 // Engine Includes
@@ -14,15 +15,106 @@
 #include "Model.h"
 #include "Skybox.h"
 #include "ParticleSystem.h"
+#include "ParticleEngine.h"
 #include "PostProcessor.h"
 #include "Pipeline.h"
 #include "VulkanContext.h"
+#include "DrawList.h"
+#include "CommandEncoder.h"
+#include "FrustumCuller.h"
+#include "IndirectDrawSystem.h"
+#include "OcclusionCuller.h"
+#include "ObjectBuffer.h"
+#include "PassWorkerPool.h"
+#include "RenderGraph.h"
+#include "StaticDrawBundle.h"
+#include "SyncManager.h"
+
+/**
+ * @struct ShadowTargets
+ * @brief Render targets of the cached shadow path for one frame.
+ * * The static cache is only re-rendered when refreshCache is set; it is then copied into the
+ * sampled shadow map and dynamic casters are drawn over it with the overlay (load) pass.
+ */
+struct ShadowTargets final {
+    VkRenderPass cachePass{ VK_NULL_HANDLE };
+    VkFramebuffer cacheFramebuffer{ VK_NULL_HANDLE };
+    VkImage cacheImage{ VK_NULL_HANDLE };
+    VkRenderPass overlayPass{ VK_NULL_HANDLE };
+    VkFramebuffer overlayFramebuffer{ VK_NULL_HANDLE };
+    VkImage shadowImage{ VK_NULL_HANDLE };
+    bool refreshCache{ true };
+};
+
+/**
+ * @struct FrameToggles
+ * @brief Feature switches for one frame (UI/keyboard state); a feature the renderer lacks stays off regardless.
+ */
+struct FrameToggles final {
+    bool dust{ true };
+    bool fire{ true };
+    bool smoke{ true };
+    bool rain{ false };
+    bool snow{ false };
+    bool depthPrePass{ false };
+    bool weightedOit{ false };
+    bool occlusionCulling{ true };
+    bool staticBundles{ true };
+};
+
+/**
+ * @struct FrameInputs
+ * @brief Everything Renderer::recordFrame reads for one frame, set by name at the call site.
+ * * The scene lists are borrowed for the duration of the call and must not be null.
+ */
+struct FrameInputs final {
+    // --- Frame Identity ---
+    VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+    const SyncManager* sync{ nullptr };
+    uint32_t frameIndex{ 0U };
+    uint32_t imageIndex{ 0U };
+    VkExtent2D extent{ 0U, 0U };
+
+    // --- Views ---
+    glm::vec3 viewPos{ 0.0f };
+    glm::vec3 lightPos{ 0.0f };
+    glm::mat4 cameraViewProj{ 1.0f };
+    glm::mat4 lightViewProj{ 1.0f };
+
+    // --- Scene ---
+    const std::map<std::string, std::unique_ptr<Model>>* models{ nullptr };
+    const std::vector<std::unique_ptr<Model>>* ownedModels{ nullptr };
+    const std::vector<Mesh*>* opaqueMeshes{ nullptr };
+    const std::vector<Mesh*>* transparentMeshes{ nullptr };
+    const std::vector<Pipeline*>* pipelines{ nullptr };
+    const Skybox* skybox{ nullptr };
+    const ParticleSystem* dustSystem{ nullptr };
+    const ParticleSystem* fireSystem{ nullptr };
+    const ParticleSystem* smokeSystem{ nullptr };
+    const ParticleSystem* rainSystem{ nullptr };
+    const ParticleSystem* snowSystem{ nullptr };
+
+    // --- Targets & Bindings ---
+    const PostProcessor* postProcessor{ nullptr };
+    VkDescriptorSet globalDescriptorSet{ VK_NULL_HANDLE };
+    uint64_t descriptorGeneration{ 0U };   /**< VulkanResourceManager::getDescriptorGeneration(). */
+    ShadowTargets shadowTargets{};
+
+    FrameToggles toggles{};
+};
 
 /**
  * @class Renderer
  * @brief Orchestrates the recording of command buffers for the multi-pass rendering pipeline.
  * Manages the sequence of Shadow Mapping, Opaque Forward Rendering, Scene Copying (Refraction),
- * Transparency, and GPU Particle Dispatches.
+ * Transparency (ordered blending or weighted blended OIT), and GPU Particle Dispatches.
+ * * The Shadow, Opaque and Transparent passes are recorded concurrently into secondary command
+ * buffers, one worker thread each; the primary buffer only begins the render passes, executes the
+ * secondaries and records the copies between them.
+ * * The primary-buffer passes are declared to a RenderGraph each frame with the images they read and
+ * write; the graph culls unused passes and derives the batched barriers between them.
+ * * Static opaque geometry can instead come from a StaticDrawBundle recorded once per swapchain image
+ * and frame in flight; the opaque pass then executes that bundle before its per-frame secondary.
  */
 class Renderer final {
 public:
@@ -31,11 +123,20 @@ public:
     static constexpr uint32_t VIEWPORT_COUNT_ONE = 1U;
     static constexpr uint32_t SCISSOR_COUNT_ONE = 1U;
     static constexpr float    DEPTH_CLEAR_VAL = 1.0f;
+    static constexpr uint32_t PASS_SHADOW = 0U;
+    static constexpr uint32_t PASS_OPAQUE = 1U;
+    static constexpr uint32_t PASS_TRANSPARENT = 2U;
+    static constexpr uint32_t PASS_COUNT = 3U;
+    static constexpr uint32_t SLOT_PASS = 0U;           /**< Secondary slot holding a pass's contents. */
+    static constexpr uint32_t SLOT_SHADOW_CACHE = 1U;   /**< Secondary slot holding a static shadow refresh. */
+    static constexpr double   MILLIS_PER_SECOND = 1000.0;
 
-    /** @brief Constructor: Links the renderer to the global Vulkan context. */
-    explicit Renderer(VulkanContext* const inContext) : context(inContext) {}
+    static_assert(PASS_COUNT == SyncManager::RECORDING_WORKER_COUNT, "Renderer: one recording worker per pass");
 
-    /** @brief Destructor: Standard default as this class does not own heavy GPU handles. */
+    /** @brief Constructor: Links the renderer to the global Vulkan context and starts the recording workers. */
+    explicit Renderer(VulkanContext* const inContext) : context(inContext), workers(PASS_COUNT), frameGraph(inContext) {}
+
+    /** @brief Destructor: Joins the recording workers and releases the frame graph's transient images. */
     ~Renderer() = default;
 
     // RAII safety: Prevent copying of the global frame orchestrator to maintain state integrity.
@@ -45,92 +146,222 @@ public:
     /**
      * @brief Orchestrates the full frame recording sequence.
      * Transitions from depth pre-passes to the final post-processed output.
+     * Mesh draws are frustum culled, sorted per pass and recorded through a CommandEncoder.
+     * Pass contents go into the frame's per-worker secondary buffers owned by the SyncManager.
      */
-    void recordFrame(
-        const VkCommandBuffer cb,
-        const VkExtent2D& extent,
-        const std::map<std::string, std::unique_ptr<Model>>& models,
-        const std::vector<std::unique_ptr<Model>>& ownedModels,
-        const std::vector<Mesh*>& opaqueMeshes,
-        const std::vector<Mesh*>& transparentMeshes,
-        const Skybox* const skybox,                // FIX: Added const for MISRA
-        const ParticleSystem* const dustSystem,
-        const ParticleSystem* const fireSystem,
-        const ParticleSystem* const smokeSystem,
-        const ParticleSystem* const rainSystem,
-        const ParticleSystem* const snowSystem,
-        const PostProcessor* const postProcessor,
-        const VkDescriptorSet globalDescriptorSet,
-        const VkRenderPass shadowPass,
-        const VkFramebuffer shadowFramebuffer,
-        const std::vector<Pipeline*>& pipelines,
-        const bool enableDust,
-        const bool enableFire,
-        const bool enableSmoke,
-        const bool enableRain,
-        const bool enableSnow
-    ) const;
+    void recordFrame(const FrameInputs& inputs);
+
+    /** @brief Returns the bind counters of the most recently recorded frame. */
+    const EncoderStats& getLastFrameStats() const { return lastFrameStats; }
+
+    /** @brief Returns the camera cull counts (opaque + transparent; frustum and occlusion) of the last frame. */
+    const CullStats& getCameraCullStats() const { return cameraCullStats; }
+
+    /** @brief Returns the light-volume cull counts of the last shadow pass. */
+    const CullStats& getShadowCullStats() const { return shadowCullStats; }
+
+    /** @brief Returns the per-pass CPU recording times of the last frame. */
+    const RecordTimings& getRecordTimings() const { return recordTimings; }
+
+    /** @brief Returns the frame graph as compiled for the last frame (for inspection dumps). */
+    const RenderGraph& getFrameGraph() const { return frameGraph; }
+
+    /**
+     * @brief Routes eligible meshes through the GPU-driven path (non-owning; nullptr disables it).
+     * Cull counters then only cover the meshes left on the CPU path.
+     */
+    void setIndirectDrawSystem(const IndirectDrawSystem* const system) { indirectDraws = system; }
+
+    /**
+     * @brief Draws the particles through the unified engine's multi-draw (non-owning; nullptr keeps the per-system draws).
+     * Set per frame to the engine only when it also ran this frame's simulation.
+     */
+    void setParticleEngine(const ParticleEngine* const engine) { particleEngine = engine; }
+
+    /**
+     * @brief Sets the CPU occlusion culler (non-owning; nullptr disables it).
+     * When enabled it is rasterized from the camera before recording and tests the CPU-path camera draws.
+     */
+    void setOcclusionCuller(OcclusionCuller* const culler) { occlusionCuller = culler; }
+
+    /**
+     * @brief Sets the pre-recorded static geometry bundles (non-owning; nullptr disables them).
+     * When enabled, the bundle's meshes are skipped by the per-frame opaque recording.
+     */
+    void setStaticDrawBundle(StaticDrawBundle* const bundle) { staticBundle = bundle; }
+
+    /** @brief Sets the per-object matrix buffer whose current set is bound as Set 2 (non-owning). */
+    void setObjectBuffer(const ObjectBuffer* const buffer) { objectBuffer = buffer; }
+
+    /**
+     * @brief Installs the pipeline substitutions of the opaque depth pre-pass (CPU and GPU-driven draws share the keys).
+     * * depthOnly maps a material pipeline to its depth-only variant; equalTest maps it to the variant drawn after
+     * the pre-pass. Draws whose pipeline is not a key are skipped, so pipelines that must keep their own
+     * depth state (alpha-tested) map to themselves in equalTest and are absent from depthOnly.
+     */
+    void setDepthPrePassPipelines(const IndirectDrawSystem::PipelineMap& depthOnly, const IndirectDrawSystem::PipelineMap& equalTest) {
+        prePassPipelines = depthOnly;
+        equalTestPipelines = equalTest;
+    }
+
+    /** @brief Returns true if pre-pass pipelines were installed, i.e. the pre-pass can be toggled on. */
+    bool hasDepthPrePass() const { return !prePassPipelines.empty(); }
+
+    /**
+     * @brief Installs the weighted OIT twins of the transparent material pipelines.
+     * In OIT mode the transparent pass records into the PostProcessor's accumulation pass with these
+     * substitutes (unmapped draws are skipped) and particles use their own OIT variants.
+     */
+    void setWeightedOitPipelines(const IndirectDrawSystem::PipelineMap& oitTwins) { oitPipelines = oitTwins; }
+
+    /** @brief Returns true if OIT twins were installed, i.e. weighted OIT can be toggled on. */
+    bool hasWeightedOit() const { return !oitPipelines.empty(); }
 
 private:
+    /**
+     * @struct PassContext
+     * @brief Scratch state owned by one recording worker, so passes never share mutable containers.
+     */
+    struct PassContext {
+        DrawList drawList{};
+        FrustumCuller culler{};
+        std::vector<const Mesh*> cullCandidates{};
+        CullStats cullStats{};
+        EncoderStats encoderStats{};
+        double cpuMs{ 0.0 };
+    };
+
     VulkanContext* context{ nullptr };
 
+    // --- Parallel Recording ---
+    PassWorkerPool workers;
+    std::array<PassContext, PASS_COUNT> passes{};
+    std::vector<std::function<void()>> passJobs{};
+    RecordTimings recordTimings{};
+
+    // --- Frame Graph (re-declared every frame; transient memory persists) ---
+    RenderGraph frameGraph;
+
+    // --- Last Frame Totals ---
+    EncoderStats lastFrameStats{};
+    CullStats cameraCullStats{};
+    CullStats shadowCullStats{};
+
+    // --- Per-Object Matrices (owned by the Experience) ---
+    const ObjectBuffer* objectBuffer{ nullptr };
+
+    // --- GPU-Driven Path (optional, owned by the Experience) ---
+    const IndirectDrawSystem* indirectDraws{ nullptr };
+
+    // --- Unified Particle Path (optional, owned by the Experience) ---
+    const ParticleEngine* particleEngine{ nullptr };
+
+    // --- CPU Occlusion Culling (optional, owned by the Experience) ---
+    OcclusionCuller* occlusionCuller{ nullptr };
+
+    // --- Static Geometry Bundles (optional, owned by the Experience) ---
+    StaticDrawBundle* staticBundle{ nullptr };
+
+    // --- Depth Pre-Pass Substitutions (empty when unavailable) ---
+    IndirectDrawSystem::PipelineMap prePassPipelines{};
+    IndirectDrawSystem::PipelineMap equalTestPipelines{};
+
+    // --- Weighted OIT Substitutions (empty when unavailable) ---
+    IndirectDrawSystem::PipelineMap oitPipelines{};
+
     // --- Private Pass-Specific Recorders ---
 
-    /** @brief Records Compute dispatches and Graphics draw calls for all particle systems.
-     * Updated to const ParticleSystem* to satisfy MISRA2004.16_7.
+    /** @brief Begins a secondary buffer that continues the given render pass (subpass 0); reusable ones may be resubmitted. */
+    static void beginSecondary(const VkCommandBuffer secondary, const VkRenderPass renderPass, const VkFramebuffer framebuffer,
+        const bool reusable = false);
+
+    /** @brief Resets the worker's pool and counters, runs the job's recordings and times them. */
+    void recordPassJob(PassContext& pass, const VkCommandPool pool, const std::function<void()>& body) const;
+
+    /** @brief Records one secondary buffer through a fresh encoder and adds its counters to the pass. */
+    static void recordSecondary(PassContext& pass, const VkCommandBuffer secondary, const VkRenderPass renderPass,
+        const VkFramebuffer framebuffer, const std::function<void(CommandEncoder&)>& body, const bool reusable = false);
+
+    /** @brief Copies the static shadow cache into the sampled shadow map. */
+    static void recordShadowCacheCopy(const VkCommandBuffer cb, const VkImage cacheImage, const VkImage shadowImage);
+
+    /** @brief Records a render pass in the primary buffer whose contents are one secondary buffer. */
+    static void executePass(const VkCommandBuffer cb, const VkRenderPassBeginInfo& passInfo, const VkCommandBuffer secondary);
+
+    /** @brief Records a render pass in the primary buffer whose contents are the given secondaries, in order. */
+    static void executePass(const VkCommandBuffer cb, const VkRenderPassBeginInfo& passInfo,
+        const VkCommandBuffer* const secondaries, const uint32_t secondaryCount);
+
+    /**
+     * @brief Re-records the (image, frame) static bundle if its key or generation changed.
+     * Returns the bundle to execute; runs on the opaque worker, which alone touches the bundle's pool.
      */
-    void recordParticlePass(
-        const VkCommandBuffer cb,
-        const ParticleSystem* const dust,
-        const ParticleSystem* const fire,
-        const ParticleSystem* const smoke,
-        const ParticleSystem* const rain,
-        const ParticleSystem* const snow,
-        const bool dustEnabled,
-        const bool fireEnabled,
-        const bool smokeEnabled,
-        const bool rainEnabled,
-        const bool snowEnabled,
-        const VkDescriptorSet globalSet
+    VkCommandBuffer prepareStaticBundle(
+        PassContext& pass,
+        const uint32_t imageIndex,
+        const uint32_t frameIndex,
+        const StaticDrawBundle::Key& key,
+        const glm::vec3& viewPos
     ) const;
 
-    /** @brief Records the depth-only pass for shadow map generation. */
+    /** @brief Records the draw calls of the enabled particle systems (or the unified engine). */
+    void recordParticlePass(const VkCommandBuffer cb, const FrameInputs& inputs, const bool weightedOIT) const;
+
+    /**
+     * @brief Records depth-only shadow contents, sorted front-to-back from the light.
+     * Static casters go to the cache refresh, dynamic casters to the per-frame overlay.
+     */
     void recordShadowPass(
-        const VkCommandBuffer cb,
-        const VkRenderPass renderPass,
-        const VkFramebuffer framebuffer,
+        PassContext& pass,
+        CommandEncoder& encoder,
+        const glm::vec3& lightPos,
+        const FrustumCuller::Planes& lightPlanes,
         const std::map<std::string, std::unique_ptr<Model>>& models,
         const std::vector<std::unique_ptr<Model>>& ownedModels,
         const Pipeline* const shadowPipeline,
-        const VkDescriptorSet globalSet
-    ) const; // Added const
+        const VkDescriptorSet globalSet,
+        const bool dynamicCasters
+    ) const;
 
-    /** @brief Records the main forward rendering pass for opaque geometry. */
+    /** @brief Records the forward-rendered opaque geometry and the skybox, skipping meshes drawn by the bundle. */
     void recordOpaquePass(
-        const VkCommandBuffer cb,
+        PassContext& pass,
+        CommandEncoder& encoder,
         const VkExtent2D& extent,
+        const glm::vec3& viewPos,
+        const FrustumCuller::Planes& cameraPlanes,
+        const OcclusionCuller* const occlusion,
+        const StaticDrawBundle* const bundled,
         const std::vector<Mesh*>& opaque,
         const Skybox* const skybox,
-        const PostProcessor* const postProcessor,
-        const VkDescriptorSet globalSet
+        const VkDescriptorSet globalSet,
+        const bool depthPrePass
     ) const;
 
-    /** @brief Records the alpha-blended pass for glass and environmental effects. */
+    /** @brief Records the glass, water and particle draws, alpha-blended or into the weighted OIT targets. */
     void recordTransparentPass(
-        const VkCommandBuffer cb,
-        const VkExtent2D& extent,
-        const std::vector<Mesh*>& transparent,
-        const ParticleSystem* const dust,
-        const ParticleSystem* const fire,
-        const ParticleSystem* const smoke,
-        const ParticleSystem* const rain,
-        const ParticleSystem* const snow,
-        const PostProcessor* const postProcessor,
-        const VkDescriptorSet globalSet,
-        const bool dustEnabled,
-        const bool fireEnabled,
-        const bool smokeEnabled,
-        const bool rainEnabled,
-        const bool snowEnabled
+        PassContext& pass,
+        CommandEncoder& encoder,
+        const FrameInputs& inputs,
+        const FrustumCuller::Planes& cameraPlanes,
+        const OcclusionCuller* const occlusion,
+        const bool weightedOIT
     ) const;
+
+    /** @brief Returns the current frame's Set 2 (object matrices), or null before the buffer is built. */
+    VkDescriptorSet getObjectSet() const { return (objectBuffer != nullptr) ? objectBuffer->getSet() : VK_NULL_HANDLE; }
+
+    /** @brief Records every item of the pass's sorted draw list, optionally through a pipeline substitution. */
+    static void recordDrawList(const PassContext& pass, CommandEncoder& encoder, const VkDescriptorSet globalSet,
+        const VkDescriptorSet objectSet, const IndirectDrawSystem::PipelineMap* const pipelineRemap = nullptr);
+
+    /**
+     * @brief Culls the pass's candidates, adds the survivors to its sorted draw list and accumulates its cull counters.
+     * Frustum survivors are also tested against the occlusion culler when one is given.
+     */
+    static void addVisible(PassContext& pass, const DrawList::Pass drawPass, const FrustumCuller::Planes& planes,
+        const Pipeline* const pipelineOverride = nullptr, const OcclusionCuller* const occlusion = nullptr);
+
+    /** @brief Sets the full-extent viewport and scissor (dynamic state is not inherited by secondaries). */
+    static void setViewportAndScissor(const VkCommandBuffer cb, const VkExtent2D& extent);
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "ResolutionController.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Constructor: Starts at full resolution.
+ */
+ResolutionController::ResolutionController(const float targetMs) {
+    setTargetFrameTime(targetMs);
+}
+
+/**
+ * @brief Sets the GPU frame time to hold.
+ */
+void ResolutionController::setTargetFrameTime(const float targetMs) {
+    if (targetMs > 0.0f) {
+        targetFrameMs = targetMs;
+    }
+}
+
+/**
+ * @brief Enables or disables scaling; disabling returns to full resolution.
+ */
+void ResolutionController::setEnabled(const bool enabled) {
+    if (enabled == active) {
+        return;
+    }
+    active = enabled;
+    sampleCount = 0U;
+    if (!active) {
+        scale = MAX_SCALE;
+    }
+}
+
+/**
+ * @brief Adds one measured GPU frame time and re-evaluates the scale when the window is full.
+ */
+void ResolutionController::addSample(const float gpuMs) {
+    lastSampleMs = gpuMs;
+    if (!active) {
+        return;
+    }
+
+    // Step 1: Fill the window
+    window[sampleCount] = gpuMs;
+    ++sampleCount;
+    if (sampleCount < WINDOW_SIZE) {
+        return;
+    }
+    sampleCount = 0U;
+
+    const float average = std::accumulate(window.begin(), window.end(), 0.0f) / static_cast<float>(WINDOW_SIZE);
+    if (average <= 0.0f) {
+        return;
+    }
+
+    // Step 2: Over budget - jump to the scale whose pixel count would meet the target
+    if (average > (targetFrameMs * OVER_BUDGET)) {
+        applyScale(std::floor((scale * std::sqrt(targetFrameMs / average)) / SCALE_STEP) * SCALE_STEP);
+    }
+    // Step 3: Comfortably under budget - creep back up one step
+    else if (average < (targetFrameMs * UNDER_BUDGET)) {
+        applyScale(scale + SCALE_STEP);
+    }
+    else {
+        // Within the band: keep the current scale
+    }
+}
+
+/**
+ * @brief Moves to a new scale (quantized, clamped).
+ */
+void ResolutionController::applyScale(const float requested) {
+    const float quantized = std::round(requested / SCALE_STEP) * SCALE_STEP;
+    scale = std::clamp(quantized, MIN_SCALE, MAX_SCALE);
+}
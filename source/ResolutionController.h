@@ -0,0 +1,65 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include <array>
+#include <cstdint>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class ResolutionController
+ * @brief Picks the scene render scale that holds a target GPU frame time.
+ * * Samples are averaged over a short window. When the average runs over the target the scale is cut
+ * in one step to the value that would meet it (GPU cost is taken as proportional to pixel count, i.e.
+ * scale squared); when it runs well under, the scale grows one step at a time. Scales are quantized
+ * and the window restarts after every decision, so the next one only sees frames at the new scale.
+ */
+class ResolutionController final {
+public:
+    // --- Named Constants ---
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float MAX_SCALE = 1.0f;
+    static constexpr float SCALE_STEP = 0.05f;
+    static constexpr float DEFAULT_TARGET_MS = 16.6f;
+    static constexpr float OVER_BUDGET = 1.05f;    /**< Shrink once the average exceeds target * this. */
+    static constexpr float UNDER_BUDGET = 0.85f;   /**< Grow once the average falls below target * this. */
+    static constexpr uint32_t WINDOW_SIZE = 8U;
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Starts at full resolution. */
+    explicit ResolutionController(const float targetMs = DEFAULT_TARGET_MS);
+    ~ResolutionController() = default;
+
+    // Value semantics are not meaningful for a running measurement window.
+    ResolutionController(const ResolutionController&) = delete;
+    ResolutionController& operator=(const ResolutionController&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Sets the GPU frame time (ms) to hold; non-positive values are ignored. */
+    void setTargetFrameTime(const float targetMs);
+
+    /** @brief Enables or disables scaling; disabling returns to full resolution and clears the window. */
+    void setEnabled(const bool enabled);
+
+    /** @brief Adds one measured GPU frame time (ms) and re-evaluates the scale when the window is full. */
+    void addSample(const float gpuMs);
+
+    // --- Accessors ---
+
+    float getScale() const { return scale; }
+    float getTargetFrameTime() const { return targetFrameMs; }
+    float getLastSample() const { return lastSampleMs; }
+    bool isEnabled() const { return active; }
+
+private:
+    /** @brief Moves to a new scale, quantized to SCALE_STEP and clamped to [MIN_SCALE, MAX_SCALE]. */
+    void applyScale(const float requested);
+
+    std::array<float, WINDOW_SIZE> window{};
+    uint32_t sampleCount{ 0U };
+    float targetFrameMs{ DEFAULT_TARGET_MS };
+    float scale{ MAX_SCALE };
+    float lastSampleMs{ 0.0f };
+    bool active{ true };
+};
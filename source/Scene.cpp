@@ -45,11 +45,11 @@ void Scene::update(const float deltaTime) {
 /**
  * @brief Records draw calls for every model registered in the scene registry.
  */
-void Scene::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, const Pipeline* const pipelineOverride) {
+void Scene::draw(VkCommandBuffer cb, VkDescriptorSet globalSet, VkDescriptorSet objectSet, const Pipeline* const pipelineOverride) {
     // Iterate through the model map and trigger individual draw calls
     for (const auto& [name, model] : models) {
         if (model != nullptr) {
-            model->draw(cb, globalSet, pipelineOverride);
+            model->draw(cb, globalSet, objectSet, pipelineOverride);
         }
     }
 }
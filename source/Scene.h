@@ -52,7 +52,7 @@ public:
     /**
      * @brief Records draw calls for every model registered in the scene.
      */
-    void draw(VkCommandBuffer cb, VkDescriptorSet globalSet, const Pipeline* const pipelineOverride = nullptr);
+    void draw(VkCommandBuffer cb, VkDescriptorSet globalSet, VkDescriptorSet objectSet, const Pipeline* const pipelineOverride = nullptr);
 
     // --- Model Registry Management ---
 
@@ -0,0 +1,43 @@
+#include "ShadowCache.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cmath>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @brief Constructor: Starts invalid so the first frame renders the cache.
+ */
+ShadowCache::ShadowCache(const float thresholdDegrees) {
+    setAngleThreshold(thresholdDegrees);
+}
+
+/**
+ * @brief Sets the light turn (degrees) tolerated before the static casters are redrawn.
+ * Stored as a cosine so the per-frame test is a single dot product.
+ */
+void ShadowCache::setAngleThreshold(const float degrees) {
+    cosThreshold = std::cos(glm::radians(std::max(degrees, 0.0f)));
+}
+
+/**
+ * @brief Per-frame decision; call once per frame before the UBO is written.
+ */
+const glm::mat4& ShadowCache::resolve(const glm::vec3& lightDirection, const glm::mat4& lightSpaceMatrix) {
+    const float length = glm::length(lightDirection);
+    const glm::vec3 direction = (length > MIN_DIRECTION_LENGTH) ? (lightDirection / length) : cachedDirection;
+
+    // Step 1: Reuse while the light stays inside the cone around the cached direction
+    refreshThisFrame = !valid || (glm::dot(direction, cachedDirection) < cosThreshold);
+    if (!refreshThisFrame) {
+        ++reusedFrames;
+        return cachedMatrix;
+    }
+
+    // Step 2: Re-anchor the cache on the current light
+    cachedDirection = direction;
+    cachedMatrix = lightSpaceMatrix;
+    valid = true;
+    ++refreshCount;
+    return cachedMatrix;
+}
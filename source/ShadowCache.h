@@ -0,0 +1,68 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+/* parasoft-end-suppress ALL */
+
+/**
+ * @class ShadowCache
+ * @brief Decides when the static-caster shadow map must be re-rendered.
+ * * Static casters are drawn into a cached depth map that stays valid while the light direction
+ * is within an angular threshold of the direction it was rendered for. While the cache is reused,
+ * the light-space matrix of the cached render is kept for the whole frame (UBO sampling and the
+ * dynamic overlay), so static and dynamic shadows always line up; the shadow lags the sun by at
+ * most the threshold.
+ */
+class ShadowCache final {
+public:
+    // --- Named Constants ---
+    static constexpr float DEFAULT_ANGLE_THRESHOLD_DEG = 0.5f;
+    static constexpr float MIN_DIRECTION_LENGTH = 1.0e-6f;
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Starts invalid so the first frame renders the cache. */
+    explicit ShadowCache(const float thresholdDegrees = DEFAULT_ANGLE_THRESHOLD_DEG);
+    ~ShadowCache() = default;
+
+    // Value semantics are not meaningful for per-session counters.
+    ShadowCache(const ShadowCache&) = delete;
+    ShadowCache& operator=(const ShadowCache&) = delete;
+
+    // --- Core API ---
+
+    /** @brief Sets the light turn (degrees) tolerated before the static casters are redrawn. */
+    void setAngleThreshold(const float degrees);
+
+    /** @brief Forces a refresh on the next frame (e.g. after static geometry was edited). */
+    void invalidate() { valid = false; }
+
+    /**
+     * @brief Per-frame decision; call once per frame before the UBO is written.
+     * @param lightDirection Direction from the scene origin towards the light.
+     * @param lightSpaceMatrix Light matrix for the current light position.
+     * @return The light matrix to render and sample with this frame.
+     */
+    const glm::mat4& resolve(const glm::vec3& lightDirection, const glm::mat4& lightSpaceMatrix);
+
+    /** @brief Returns true if the current frame must re-render the static casters. */
+    bool needsRefresh() const { return refreshThisFrame; }
+
+    // --- Statistics ---
+
+    /** @brief Returns the number of frames that reused the cached static map. */
+    uint64_t getReusedFrames() const { return reusedFrames; }
+
+    /** @brief Returns the number of frames that re-rendered the static casters. */
+    uint64_t getRefreshCount() const { return refreshCount; }
+
+private:
+    float cosThreshold{ 1.0f };
+    glm::vec3 cachedDirection{ 0.0f };
+    glm::mat4 cachedMatrix{ 1.0f };
+    bool valid{ false };
+    bool refreshThisFrame{ false };
+    uint64_t reusedFrames{ 0U };
+    uint64_t refreshCount{ 0U };
+};
@@ -207,8 +207,8 @@ void Skybox::createPipeline(const VkRenderPass renderPass) const {
         pipelineLayout, renderPass
     );
 
-    if (vkCreateGraphicsPipelines(context->device, VK_NULL_HANDLE, EngineConstants::COUNT_ONE,
-        &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (context->pipelineCache.createGraphicsPipelines(EngineConstants::COUNT_ONE,
+        &pipelineInfo, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Skybox: Failed to create graphics pipeline!");
     }
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "SnowCover.h"
+
+/* parasoft-begin-suppress ALL */
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "PipelineBuildQueue.h"
+#include "ShaderModule.h"
+#include "VulkanUtils.h"
+
+namespace {
+    const char* const MELT_SHADER = "./shaders/snow_melt_comp.spv";
+}
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Uploads an empty heightmap and prepares the melt pass.
+ */
+SnowCover::SnowCover(VulkanContext* const inContext, PipelineBuildQueue* const buildQueue)
+    : context(inContext)
+{
+    // Step 1: Zeroed heightmap, device-local (written by atomics, read by the sand material and readBack())
+    const std::vector<uint32_t> emptyCover(CELL_COUNT, 0U);
+    VulkanUtils::createDeviceLocalBuffer(context->device, context->physicalDevice, context->graphicsCommandPool,
+        context->graphicsQueue, emptyCover.data(), static_cast<VkDeviceSize>(CELL_COUNT * sizeof(uint32_t)),
+        (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT), coverBuffer, coverMemory);
+
+    createDescriptors();
+
+    // Step 2: The melt pipeline is optional; without it the snow simply stays
+    const auto build = [this]() {
+        try {
+            createMeltPipeline();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "SnowCover: Snow melt unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(MELT_SHADER, build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Destructor: Releases every owned GPU object.
+ */
+SnowCover::~SnowCover() {
+    if ((context == nullptr) || (context->device == VK_NULL_HANDLE)) {
+        return;
+    }
+
+    vkDestroyPipeline(context->device, meltPipeline, nullptr);
+    vkDestroyPipelineLayout(context->device, meltPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(context->device, meltDescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(context->device, meltSetLayout, nullptr);
+    vkDestroyBuffer(context->device, coverBuffer, nullptr);
+    vkFreeMemory(context->device, coverMemory, nullptr);
+}
+
+// ========================================================================
+// SECTION 2: PER-FRAME RECORDING
+// ========================================================================
+
+/**
+ * @brief Records the melt dispatch between two compute barriers.
+ * It also runs at a zero rate, since it caps the cells the flakes keep adding to. The entry barrier
+ * orders it after last frame's sand reads and flake deposits; the exit barrier orders this frame's
+ * deposits after it.
+ */
+void SnowCover::recordMelt(const VkCommandBuffer commandBuffer, const float dt, const float meltRate) const {
+    if (meltPipeline == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // Step 1: Previous readers and writers -> melt
+    VkMemoryBarrier entryBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    entryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    entryBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer, (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT),
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO),
+        EngineConstants::COUNT_ONE, &entryBarrier, 0U, nullptr, 0U, nullptr);
+
+    // Step 2: Exponential decay, so the result does not depend on the frame rate
+    const MeltPushConstants params{ std::exp(-meltRate * dt) };
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, meltPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, meltPipelineLayout,
+        EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, &meltDescriptorSet, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdPushConstants(commandBuffer, meltPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, EngineConstants::OFFSET_ZERO,
+        static_cast<uint32_t>(sizeof(MeltPushConstants)), &params);
+    vkCmdDispatch(commandBuffer, (CELL_COUNT + MELT_WORKGROUP_SIZE - 1U) / MELT_WORKGROUP_SIZE,
+        EngineConstants::COUNT_ONE, EngineConstants::COUNT_ONE);
+
+    // Step 3: Melt -> this frame's deposits (atomics read and write)
+    VkMemoryBarrier exitBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    exitBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    exitBarrier.dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &exitBarrier, 0U, nullptr, 0U, nullptr);
+}
+
+/**
+ * @brief Records the barrier that hands this frame's cover to the sand material.
+ */
+void SnowCover::recordPublish(const VkCommandBuffer commandBuffer) const {
+    VkMemoryBarrier publishBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    publishBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    publishBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &publishBarrier, 0U, nullptr, 0U, nullptr);
+}
+
+// ========================================================================
+// SECTION 3: READBACK
+// ========================================================================
+
+/**
+ * @brief Copies the heightmap into a host-visible buffer after the deposits and the melt.
+ */
+void SnowCover::readBack(std::vector<uint32_t>& cells) const {
+    const VkDeviceSize coverSize = static_cast<VkDeviceSize>(CELL_COUNT * sizeof(uint32_t));
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, coverSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), staging, stagingMemory);
+
+    // Step 1: Deposits and melt -> copy -> host reads
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+
+    VkMemoryBarrier copyBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    copyBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    copyBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &copyBarrier, 0U, nullptr, 0U, nullptr);
+
+    const VkBufferCopy coverCopy{ 0ULL, 0ULL, coverSize };
+    vkCmdCopyBuffer(cb, coverBuffer, staging, EngineConstants::COUNT_ONE, &coverCopy);
+
+    VkMemoryBarrier hostBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr, 0U, nullptr);
+
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+
+    // Step 2: Unpack
+    void* mapped = nullptr;
+    static_cast<void>(vkMapMemory(context->device, stagingMemory, 0ULL, VK_WHOLE_SIZE, 0U, &mapped));
+    cells.resize(CELL_COUNT);
+    static_cast<void>(std::memcpy(cells.data(), mapped, static_cast<size_t>(coverSize)));
+
+    vkUnmapMemory(context->device, stagingMemory);
+    vkDestroyBuffer(context->device, staging, nullptr);
+    vkFreeMemory(context->device, stagingMemory, nullptr);
+}
+
+// ========================================================================
+// SECTION 4: INTERNAL INITIALIZATION
+// ========================================================================
+
+/**
+ * @brief Creates the melt set (binding 0: the heightmap).
+ */
+void SnowCover::createDescriptors() {
+    const VkDescriptorSetLayoutBinding coverBinding{
+        BINDING_COVER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, EngineConstants::COUNT_ONE, VK_SHADER_STAGE_COMPUTE_BIT, nullptr
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pBindings = &coverBinding;
+
+    if (vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &meltSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("SnowCover: Failed to create melt descriptor set layout!");
+    }
+
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, EngineConstants::COUNT_ONE };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.maxSets = EngineConstants::COUNT_ONE;
+    poolInfo.poolSizeCount = EngineConstants::COUNT_ONE;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &meltDescriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("SnowCover: Failed to create melt descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = meltDescriptorPool;
+    allocInfo.descriptorSetCount = EngineConstants::COUNT_ONE;
+    allocInfo.pSetLayouts = &meltSetLayout;
+
+    if (vkAllocateDescriptorSets(context->device, &allocInfo, &meltDescriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("SnowCover: Failed to allocate melt descriptor set!");
+    }
+
+    const VkDescriptorBufferInfo bufferInfo{ coverBuffer, 0ULL, VK_WHOLE_SIZE };
+    VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = meltDescriptorSet;
+    write.dstBinding = BINDING_COVER;
+    write.descriptorCount = EngineConstants::COUNT_ONE;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(context->device, EngineConstants::COUNT_ONE, &write, 0U, nullptr);
+}
+
+/**
+ * @brief Compiles the melt compute pipeline.
+ */
+void SnowCover::createMeltPipeline() {
+    const ShaderModule meltShader(context, MELT_SHADER, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    const VkPushConstantRange pushRange{
+        VK_SHADER_STAGE_COMPUTE_BIT, EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(MeltPushConstants))
+    };
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pSetLayouts = &meltSetLayout;
+    layoutInfo.pushConstantRangeCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &meltPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("SnowCover: Failed to create melt pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = meltShader.getStageInfo();
+    pipelineInfo.layout = meltPipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(EngineConstants::COUNT_ONE, &pipelineInfo, &meltPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("SnowCover: Failed to create melt compute pipeline!");
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+class PipelineBuildQueue;
+
+/**
+ * @class SnowCover
+ * @brief Top-down snow heightmap filled by settling flakes and drawn by the sand material.
+ * * A RESOLUTION x RESOLUTION grid of fixed-point counters (snow_cover.glsl) spans the globe's
+ * footprint. The snow simulation adds to a cell with atomics when a flake lands, a small compute
+ * pass scales every cell down each frame at the climate's melt rate, and sand.frag whitens the sand
+ * by the cover under each fragment. The buffer is bound in the global set (Set 0) for both users.
+ * * The melt pipeline is optional: without it the snow never melts, but cover and collision still work.
+ */
+class SnowCover final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t RESOLUTION = 64U;             /**< Cells per side; mirrors SNOW_COVER_RES. */
+    static constexpr uint32_t CELL_COUNT = RESOLUTION * RESOLUTION;
+    static constexpr float GRID_MIN = -1.7f;                /**< World X and Z of the first corner; mirrors SNOW_COVER_MIN. */
+    static constexpr float GRID_SIZE = 3.4f;                /**< World extent along X and Z; mirrors SNOW_COVER_SIZE. */
+    static constexpr uint32_t UNITS_PER_FLAKE = 256U;       /**< Mirrors SNOW_UNITS_PER_FLAKE. */
+    static constexpr uint32_t MELT_WORKGROUP_SIZE = 64U;    /**< Mirrors snow_melt.comp's local_size_x. */
+    static constexpr uint32_t BINDING_COVER = 0U;
+
+    // --- Lifecycle ---
+
+    /**
+     * @brief Creates the zeroed heightmap and queues (or builds) the melt pipeline.
+     * @param buildQueue Optional queue the melt pipeline is compiled on; built immediately if null.
+     */
+    explicit SnowCover(VulkanContext* const inContext, PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Destructor: Releases the buffer, the melt descriptors and the pipeline. */
+    ~SnowCover();
+
+    // RAII: Owns GPU memory; prevent duplication.
+    SnowCover(const SnowCover&) = delete;
+    SnowCover& operator=(const SnowCover&) = delete;
+
+    // --- Per-Frame ---
+
+    /**
+     * @brief Records the melt dispatch, ordered after last frame's readers and before this frame's simulations.
+     * @param meltRate Fraction of the snow lost per second (0 keeps it; ClimateManager::getSnowMeltRate()).
+     */
+    void recordMelt(const VkCommandBuffer commandBuffer, const float dt, const float meltRate) const;
+
+    /** @brief Makes the simulations' deposits visible to the sand material; call after the particle updates. */
+    void recordPublish(const VkCommandBuffer commandBuffer) const;
+
+    // --- Accessors ---
+
+    /** @brief Returns the heightmap buffer (std430 uint[CELL_COUNT]). */
+    VkBuffer getBuffer() const { return coverBuffer; }
+
+    /** @brief Returns true once the melt pipeline exists. */
+    bool canMelt() const { return meltPipeline != VK_NULL_HANDLE; }
+
+    // --- Validation ---
+
+    /** @brief Copies the CELL_COUNT cells back to the host. Idles the graphics queue: for validation, never per frame. */
+    void readBack(std::vector<uint32_t>& cells) const;
+
+private:
+    /** @brief Mirror of snow_melt.comp's push constant block. */
+    struct MeltPushConstants {
+        float keep;
+    };
+
+    /** @brief Creates the melt set layout, pool and set pointing at the heightmap. */
+    void createDescriptors();
+
+    /** @brief Compiles the melt compute pipeline (device objects only; safe on a build worker). */
+    void createMeltPipeline();
+
+    // --- Internal State ---
+    VulkanContext* context;
+
+    VkBuffer coverBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory coverMemory{ VK_NULL_HANDLE };
+
+    VkDescriptorSetLayout meltSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool meltDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet meltDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout meltPipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline meltPipeline{ VK_NULL_HANDLE };
+};
@@ -0,0 +1,127 @@
+#include "StaticDrawBundle.h"
+
+/* parasoft-begin-suppress ALL */
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Creates the command pool. Bundles are reset one at a time when re-recorded,
+ * so the pool allows individual resets and is not transient.
+ */
+StaticDrawBundle::StaticDrawBundle(VulkanContext* const inContext, const uint32_t inFramesInFlight, const uint32_t queueFamilyIndex)
+    : context(inContext), framesInFlight(inFramesInFlight)
+{
+    VkCommandPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+    if (vkCreateCommandPool(context->device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("StaticDrawBundle: Failed to create command pool!");
+    }
+}
+
+/**
+ * @brief Destructor: Destroying the pool frees every bundle allocated from it.
+ */
+StaticDrawBundle::~StaticDrawBundle() {
+    if ((context != nullptr) && (context->device != VK_NULL_HANDLE) && (pool != VK_NULL_HANDLE)) {
+        vkDestroyCommandPool(context->device, pool, nullptr);
+    }
+}
+
+// ========================================================================
+// SECTION 2: SETUP
+// ========================================================================
+
+/**
+ * @brief Replaces the bundled meshes and invalidates every bundle.
+ */
+void StaticDrawBundle::setMeshes(const std::vector<const Mesh*>& staticMeshes) {
+    meshes.clear();
+    meshSet.clear();
+    for (const Mesh* const mesh : staticMeshes) {
+        if ((mesh != nullptr) && meshSet.insert(mesh).second) {
+            meshes.push_back(mesh);
+        }
+    }
+    invalidate();
+}
+
+// ========================================================================
+// SECTION 3: PER-FRAME
+// ========================================================================
+
+/**
+ * @brief Returns true if the pair's bundle can be executed as recorded.
+ */
+bool StaticDrawBundle::isCurrent(const uint32_t imageIndex, const uint32_t frameIndex, const Key& key) const {
+    const size_t index = slotIndex(imageIndex, frameIndex);
+    if (index >= slots.size()) {
+        return false;
+    }
+
+    const Slot& slot = slots[index];
+    return (slot.generation == generation) &&
+        (slot.key.renderPass == key.renderPass) &&
+        (slot.key.framebuffer == key.framebuffer) &&
+        (slot.key.extent.width == key.extent.width) &&
+        (slot.key.extent.height == key.extent.height) &&
+        (slot.key.globalSet == key.globalSet) &&
+        (slot.key.objectSet == key.objectSet) &&
+        (slot.key.depthPrePass == key.depthPrePass) &&
+        (slot.key.materialGeneration == key.materialGeneration) &&
+        (slot.key.descriptorGeneration == key.descriptorGeneration);
+}
+
+/**
+ * @brief Returns the pair's command buffer, allocating it on first use.
+ * The slot's previous recording finished executing: its frame-in-flight fence and the swapchain
+ * image's fence have both been waited on before the frame is recorded.
+ */
+VkCommandBuffer StaticDrawBundle::getBuffer(const uint32_t imageIndex, const uint32_t frameIndex) {
+    const size_t index = slotIndex(imageIndex, frameIndex);
+    if (index >= slots.size()) {
+        slots.resize(index + 1U);
+    }
+
+    Slot& slot = slots[index];
+    if (slot.buffer == VK_NULL_HANDLE) {
+        VkCommandBufferAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        allocInfo.commandPool = pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1U;
+
+        if (vkAllocateCommandBuffers(context->device, &allocInfo, &slot.buffer) != VK_SUCCESS) {
+            throw std::runtime_error("StaticDrawBundle: Failed to allocate bundle command buffer!");
+        }
+    }
+    return slot.buffer;
+}
+
+/**
+ * @brief Stores the key the pair was recorded with and its recording time.
+ */
+void StaticDrawBundle::markRecorded(const uint32_t imageIndex, const uint32_t frameIndex, const Key& key,
+    const double cpuMs, const uint32_t draws)
+{
+    Slot& slot = slots.at(slotIndex(imageIndex, frameIndex));
+    slot.key = key;
+    slot.generation = generation;
+    slot.recordMs = cpuMs;
+
+    ++stats.recordings;
+    stats.draws = draws;
+    stats.lastRecordMs = cpuMs;
+}
+
+/**
+ * @brief Counts a reused frame; the time it saved is what recording the same bundle last cost.
+ */
+void StaticDrawBundle::markReused(const uint32_t imageIndex, const uint32_t frameIndex) {
+    ++stats.reusedFrames;
+    stats.savedMs += slots.at(slotIndex(imageIndex, frameIndex)).recordMs;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "CommonStructs.h"
+#include "VulkanContext.h"
+
+class Mesh;
+
+/**
+ * @class StaticDrawBundle
+ * @brief Reusable secondary command buffers holding the opaque draws of static geometry.
+ * * Static meshes record the same commands every frame; only the global set (per swapchain image),
+ * the object set (per frame in flight) and the viewport differ. One bundle is therefore kept per
+ * (swapchain image, frame in flight) pair and re-recorded only when its Key changes, or when
+ * invalidate() is called after the meshes or the swapchain changed. Material and descriptor changes
+ * are part of the Key (their generations), so a rebound material or a rewritten global set cannot
+ * leave a stale bundle behind. The opaque pass executes it with vkCmdExecuteCommands ahead of its
+ * per-frame secondary.
+ * * Bundled meshes are not frustum or occlusion culled: the GPU cost of drawing them off screen is
+ * traded for their recording cost.
+ */
+class StaticDrawBundle final {
+public:
+    /**
+     * @struct Key
+     * @brief Everything baked into a recorded bundle besides the mesh list.
+     */
+    struct Key final {
+        VkRenderPass renderPass{ VK_NULL_HANDLE };
+        VkFramebuffer framebuffer{ VK_NULL_HANDLE };
+        VkExtent2D extent{ 0U, 0U };
+        VkDescriptorSet globalSet{ VK_NULL_HANDLE };
+        VkDescriptorSet objectSet{ VK_NULL_HANDLE };
+        bool depthPrePass{ false };
+        uint64_t materialGeneration{ 0U };     /**< Material::getGeneration(): pipelines and Set 1 of the bundled meshes. */
+        uint64_t descriptorGeneration{ 0U };   /**< Generation of the global sets' contents. */
+    };
+
+    // --- Lifecycle ---
+
+    /** @brief Constructor: Creates the resettable command pool the bundles are allocated from. */
+    StaticDrawBundle(VulkanContext* const inContext, const uint32_t inFramesInFlight, const uint32_t queueFamilyIndex);
+
+    /** @brief Destructor: Releases the command pool and with it every bundle. */
+    ~StaticDrawBundle();
+
+    // RAII: Owns a command pool; prevent duplication.
+    StaticDrawBundle(const StaticDrawBundle&) = delete;
+    StaticDrawBundle& operator=(const StaticDrawBundle&) = delete;
+
+    // --- Setup ---
+
+    /** @brief Replaces the bundled meshes (duplicates are dropped) and invalidates every bundle. */
+    void setMeshes(const std::vector<const Mesh*>& staticMeshes);
+
+    /** @brief Forces every bundle to be re-recorded before its next use. */
+    void invalidate() { ++generation; }
+
+    /** @brief Returns the bundled meshes in registration order. */
+    const std::vector<const Mesh*>& getMeshes() const { return meshes; }
+
+    /** @brief Returns true if the mesh is drawn by the bundles (the per-frame pass must skip it). */
+    bool contains(const Mesh* const mesh) const { return meshSet.find(mesh) != meshSet.end(); }
+
+    /** @brief Returns true if there is nothing to bundle. */
+    bool isEmpty() const { return meshes.empty(); }
+
+    // --- Per-Frame (called from the opaque recording worker only) ---
+
+    /** @brief Returns true if the pair's bundle was recorded with this key since the last invalidation. */
+    bool isCurrent(const uint32_t imageIndex, const uint32_t frameIndex, const Key& key) const;
+
+    /** @brief Returns the pair's command buffer, allocating it on first use. Throws if allocation fails. */
+    VkCommandBuffer getBuffer(const uint32_t imageIndex, const uint32_t frameIndex);
+
+    /** @brief Stores the key the pair was just recorded with and the CPU time it took. */
+    void markRecorded(const uint32_t imageIndex, const uint32_t frameIndex, const Key& key, const double cpuMs, const uint32_t draws);
+
+    /** @brief Counts a frame that executed the pair's bundle without recording it. */
+    void markReused(const uint32_t imageIndex, const uint32_t frameIndex);
+
+    /** @brief Returns the session counters. */
+    const BundleStats& getStats() const { return stats; }
+
+private:
+    /** @brief One recorded bundle and what it was recorded with. */
+    struct Slot {
+        VkCommandBuffer buffer{ VK_NULL_HANDLE };
+        Key key{};
+        uint64_t generation{ 0U };   /**< 0 = never recorded (the live generation starts at 1). */
+        double recordMs{ 0.0 };
+    };
+
+    /** @brief Returns the slot index of a (swapchain image, frame in flight) pair. */
+    size_t slotIndex(const uint32_t imageIndex, const uint32_t frameIndex) const {
+        return (static_cast<size_t>(imageIndex) * framesInFlight) + (frameIndex % framesInFlight);
+    }
+
+    VulkanContext* context{ nullptr };
+    uint32_t framesInFlight{ 0U };
+    VkCommandPool pool{ VK_NULL_HANDLE };
+
+    std::vector<const Mesh*> meshes{};
+    std::unordered_set<const Mesh*> meshSet{};
+    std::vector<Slot> slots{};   /**< Grows with the swapchain image count. */
+    uint64_t generation{ 1U };
+    BundleStats stats{};
+};
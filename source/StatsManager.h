@@ -6,6 +6,9 @@
 #include <algorithm>
 /* parasoft-end-suppress ALL */
 
+#include "CommonStructs.h"
+#include "FrustumCuller.h"
+
 /**
  * @class StatsManager
  * @brief Encapsulates performance metrics and history for UI visualization.
@@ -57,6 +60,146 @@ public:
     /** @brief Returns the total capacity of the buffer. */
     uint32_t getCount() const { return HISTORY_SIZE; }
 
+    /** @brief Records the command encoder's bind counters for the last recorded frame. */
+    void setBindCounters(const uint32_t issued, const uint32_t skipped, const uint32_t draws) {
+        bindsIssued = issued;
+        bindsSkipped = skipped;
+        drawCalls = draws;
+    }
+
+    /** @brief Returns the binds recorded in the last frame. */
+    uint32_t getBindsIssued() const { return bindsIssued; }
+
+    /** @brief Returns the binds elided as redundant in the last frame. */
+    uint32_t getBindsSkipped() const { return bindsSkipped; }
+
+    /** @brief Returns the mesh draw calls recorded in the last frame. */
+    uint32_t getDrawCalls() const { return drawCalls; }
+
+    /** @brief Records the frustum cull counts for the camera and shadow views of the last frame. */
+    void setCullCounters(const CullStats& camera, const CullStats& shadow) {
+        cameraCull = camera;
+        shadowCull = shadow;
+    }
+
+    /** @brief Returns the camera-frustum visible/culled mesh counts of the last frame. */
+    const CullStats& getCameraCull() const { return cameraCull; }
+
+    /** @brief Returns the light-volume visible/culled caster counts of the last frame. */
+    const CullStats& getShadowCull() const { return shadowCull; }
+
+    /** @brief Records the per-pass CPU recording times of the last frame. */
+    void setRecordTimings(const RecordTimings& timings) { recordTimings = timings; }
+
+    /** @brief Returns the per-pass CPU recording times of the last frame. */
+    const RecordTimings& getRecordTimings() const { return recordTimings; }
+
+    /**
+     * @brief Files the last frame's recording wall time under the path it used (GPU-driven or CPU-only).
+     * Each path keeps its latest sample, so toggling the path compares the two; 0 until a path has run.
+     */
+    void setIndirectRecordTime(const bool indirect, const double wallMs) {
+        indirectDrawsActive = indirect;
+        if (indirect) {
+            indirectRecordMs = wallMs;
+        }
+        else {
+            cpuPathRecordMs = wallMs;
+        }
+    }
+
+    /** @brief Returns true if the last frame drew the eligible meshes through the GPU-driven path. */
+    bool getIndirectDrawsActive() const { return indirectDrawsActive; }
+
+    /** @brief Returns the latest frame recording time (ms) with the GPU-driven path. */
+    double getIndirectRecordMs() const { return indirectRecordMs; }
+
+    /** @brief Returns the latest frame recording time (ms) with every mesh on the CPU path. */
+    double getCpuPathRecordMs() const { return cpuPathRecordMs; }
+
+    /** @brief Records the static draw bundles' session counters. */
+    void setBundleStats(const BundleStats& bundle) { bundleStats = bundle; }
+
+    /** @brief Returns the static draw bundles' session counters. */
+    const BundleStats& getBundleStats() const { return bundleStats; }
+
+    /** @brief Records the shadow cache's session counters. */
+    void setShadowCacheCounters(const uint64_t reused, const uint64_t refreshes) {
+        shadowCacheReused = reused;
+        shadowCacheRefreshes = refreshes;
+    }
+
+    /** @brief Returns the number of frames that reused the cached static shadow map. */
+    uint64_t getShadowCacheReused() const { return shadowCacheReused; }
+
+    /** @brief Returns the number of frames that re-rendered the static shadow casters. */
+    uint64_t getShadowCacheRefreshes() const { return shadowCacheRefreshes; }
+
+    /** @brief Records the dynamic resolution state: render scale and last/target GPU frame times (ms). */
+    void setResolutionCounters(const float scale, const float gpuMs, const float targetMs) {
+        renderScale = scale;
+        gpuFrameMs = gpuMs;
+        targetFrameMs = targetMs;
+    }
+
+    /** @brief Returns the scene render scale of the last frame. */
+    float getRenderScale() const { return renderScale; }
+
+    /** @brief Returns the last measured GPU frame time in milliseconds (0 without timestamp support). */
+    float getGpuFrameMs() const { return gpuFrameMs; }
+
+    /** @brief Returns the GPU frame time the resolution controller holds. */
+    float getTargetFrameMs() const { return targetFrameMs; }
+
+    /** @brief Records the particle LOD of the last frame: kept fraction, globe screen share and live/enabled slots. */
+    void setParticleLodCounters(const float fraction, const float coverage, const uint32_t active, const uint32_t enabled) {
+        particleLodFraction = fraction;
+        globeCoverage = coverage;
+        activeParticles = active;
+        enabledParticles = enabled;
+    }
+
+    /** @brief Returns the share of the particles the LOD kept alive. */
+    float getParticleLodFraction() const { return particleLodFraction; }
+
+    /** @brief Returns the globe's share of the screen that drove the LOD. */
+    float getGlobeCoverage() const { return globeCoverage; }
+
+    /** @brief Returns the particles the enabled emitters may keep alive under the LOD. */
+    uint32_t getActiveParticles() const { return activeParticles; }
+
+    /** @brief Returns the particles of the enabled emitters without LOD. */
+    uint32_t getEnabledParticles() const { return enabledParticles; }
+
+    /** @brief Records the wind field's cost bounds (cells per side, frames per rebuild) and its rebuilds so far. */
+    void setWindFieldCounters(const uint32_t resolution, const uint32_t interval, const uint64_t updates) {
+        windFieldResolution = resolution;
+        windFieldInterval = interval;
+        windFieldUpdates = updates;
+    }
+
+    uint32_t getWindFieldResolution() const { return windFieldResolution; }
+    uint32_t getWindFieldInterval() const { return windFieldInterval; }
+    uint64_t getWindFieldUpdates() const { return windFieldUpdates; }
+
+    /** @brief Records the particle depth sorts of the last measured frame: summed GPU time (ms) and sorted systems. */
+    void setParticleSortCounters(const float gpuMs, const uint32_t systems) {
+        particleSortMs = gpuMs;
+        sortedSystems = systems;
+    }
+
+    /** @brief Returns the GPU time all particle depth sorts took in the last measured frame. */
+    float getParticleSortMs() const { return particleSortMs; }
+
+    /** @brief Returns the number of particle systems drawn depth-sorted. */
+    uint32_t getSortedSystems() const { return sortedSystems; }
+
+    /** @brief Records the cost of the particle path the last measured frame ran (per-system or unified). */
+    void setParticlePathStats(const ParticlePathStats& stats) { particlePathStats = stats; }
+
+    /** @brief Returns the particle path counters of the last measured frame. */
+    const ParticlePathStats& getParticlePathStats() const { return particlePathStats; }
+
     /**
      * @brief Computes the average FPS across the stored history.
      */
@@ -68,4 +211,51 @@ public:
 private:
     std::vector<float> fpsHistory{};
     uint32_t offset{ 0U };
+
+    // --- Draw Submission Counters (last frame) ---
+    uint32_t bindsIssued{ 0U };
+    uint32_t bindsSkipped{ 0U };
+    uint32_t drawCalls{ 0U };
+
+    // --- Visibility Counters (last frame) ---
+    CullStats cameraCull{};
+    CullStats shadowCull{};
+
+    // --- Command Recording Timings (last frame) ---
+    RecordTimings recordTimings{};
+
+    // --- GPU-Driven vs CPU Recording (latest frame of each path) ---
+    bool indirectDrawsActive{ false };
+    double indirectRecordMs{ 0.0 };
+    double cpuPathRecordMs{ 0.0 };
+
+    // --- Static Draw Bundle Counters (session) ---
+    BundleStats bundleStats{};
+
+    // --- Shadow Cache Counters (session) ---
+    uint64_t shadowCacheReused{ 0U };
+    uint64_t shadowCacheRefreshes{ 0U };
+
+    // --- Dynamic Resolution (last frame) ---
+    float renderScale{ 1.0f };
+    float gpuFrameMs{ 0.0f };
+    float targetFrameMs{ 0.0f };
+
+    // --- Particle LOD (last frame) ---
+    float particleLodFraction{ 1.0f };
+    float globeCoverage{ 0.0f };
+    uint32_t activeParticles{ 0U };
+    uint32_t enabledParticles{ 0U };
+
+    // --- Wind Field (session) ---
+    uint32_t windFieldResolution{ 0U };
+    uint32_t windFieldInterval{ 0U };
+    uint64_t windFieldUpdates{ 0U };
+
+    // --- Particle Depth Sort (last measured frame) ---
+    float particleSortMs{ 0.0f };
+    uint32_t sortedSystems{ 0U };
+
+    // --- Particle Simulation Path (last measured frame) ---
+    ParticlePathStats particlePathStats{};
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 /* parasoft-begin-suppress ALL */
 #include "SyncManager.h"
 #include <iostream>
+#include <stdexcept>
 /* parasoft-end-suppress ALL */
 
 /**
@@ -36,7 +37,14 @@ SyncManager::~SyncManager() {
                 }
             }
 
-            // 3. Command Buffer Note: Handled by Pool destruction.
+            // 3. Worker pools (destroying a pool frees its secondary buffers)
+            for (const VkCommandPool pool : secondaryPools) {
+                if (pool != VK_NULL_HANDLE) {
+                    vkDestroyCommandPool(context->device, pool, nullptr);
+                }
+            }
+
+            // 4. Command Buffer Note: Handled by Pool destruction.
             // We wrap the print in the try-block to catch exceptions from operator<<
             std::cout << "Engine: SyncManager Cleaned Up." << std::endl;
         }
@@ -85,4 +93,35 @@ void SyncManager::allocateCommandBuffers(const VulkanContext* const ctx, VkComma
     if (vkAllocateCommandBuffers(ctx->device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("SyncManager: Failed to allocate hardware command buffers!");
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Creates one transient command pool and its secondary buffers per (frame in flight, worker).
+ */
+void SyncManager::createSecondaryPools(const VulkanContext* const ctx, const uint32_t queueFamilyIndex,
+    const uint32_t maxFrames, const uint32_t workerCount)
+{
+    const size_t slotCount = static_cast<size_t>(maxFrames) * workerCount;
+    secondaryWorkerCount = workerCount;
+    secondaryPools.assign(slotCount, VK_NULL_HANDLE);
+    secondaryBuffers.assign(slotCount * SECONDARY_BUFFERS_PER_WORKER, VK_NULL_HANDLE);
+
+    VkCommandPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+    for (size_t i = 0U; i < slotCount; ++i) {
+        if (vkCreateCommandPool(ctx->device, &poolInfo, nullptr, &secondaryPools[i]) != VK_SUCCESS) {
+            throw std::runtime_error("SyncManager: Failed to create worker command pool!");
+        }
+
+        VkCommandBufferAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        allocInfo.commandPool = secondaryPools[i];
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = SECONDARY_BUFFERS_PER_WORKER;
+
+        if (vkAllocateCommandBuffers(ctx->device, &allocInfo, &secondaryBuffers[i * SECONDARY_BUFFERS_PER_WORKER]) != VK_SUCCESS) {
+            throw std::runtime_error("SyncManager: Failed to allocate secondary command buffers!");
+        }
+    }
+}
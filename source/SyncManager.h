@@ -21,6 +21,12 @@ public:
      */
     static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2U;
 
+    /** @brief Recording threads, one per parallel pass (Shadow, Opaque, Transparent). */
+    static constexpr uint32_t RECORDING_WORKER_COUNT = 3U;
+
+    /** @brief Secondary buffers per worker and frame (the shadow worker may fill a cache refresh and an overlay). */
+    static constexpr uint32_t SECONDARY_BUFFERS_PER_WORKER = 2U;
+
     // --- Lifecycle ---
 
     explicit SyncManager(VulkanContext* const inContext);
@@ -37,6 +43,14 @@ public:
      */
     void allocateCommandBuffers(const VulkanContext* const ctx, VkCommandPool pool, uint32_t count);
 
+    /**
+     * @brief Creates one transient command pool and its secondary buffers per (frame in flight, worker).
+     * Command pools are externally synchronized, so each recording thread owns its own; the frame's
+     * fence guarantees the pool is idle when the worker resets it.
+     */
+    void createSecondaryPools(const VulkanContext* const ctx, const uint32_t queueFamilyIndex,
+        const uint32_t maxFrames, const uint32_t workerCount);
+
     // --- Accessors ---
 
 /** @brief Returns the Command Buffer for a specific frame in flight. */
@@ -66,12 +80,28 @@ public:
 
     uint32_t getCurrentFrame() const { return currentFrame; }
 
+    /** @brief Returns the command pool a recording worker resets at the start of its frame. */
+    VkCommandPool getSecondaryPool(const uint32_t frame, const uint32_t worker) const {
+        return secondaryPools.at((static_cast<size_t>(frame) * secondaryWorkerCount) + worker);
+    }
+
+    /** @brief Returns a secondary command buffer a recording worker fills for a frame. */
+    VkCommandBuffer getSecondaryCommandBuffer(const uint32_t frame, const uint32_t worker, const uint32_t slot = 0U) const {
+        const size_t pool = (static_cast<size_t>(frame) * secondaryWorkerCount) + worker;
+        return secondaryBuffers.at((pool * SECONDARY_BUFFERS_PER_WORKER) + slot);
+    }
+
 private:
     VulkanContext* context{ nullptr };
 
     uint32_t currentFrame = 0U;
 
     std::vector<VkCommandBuffer> commandBuffers{};
+
+    // Per-frame, per-worker secondary recording (pool = frame * workerCount + worker, buffer = pool * perWorker + slot)
+    uint32_t secondaryWorkerCount{ 0U };
+    std::vector<VkCommandPool> secondaryPools{};
+    std::vector<VkCommandBuffer> secondaryBuffers{};
     std::vector<VkSemaphore> imageAvailableSemaphores{};
     std::vector<VkSemaphore> renderFinishedSemaphores{};
     std::vector<VkFence> inFlightFences{};
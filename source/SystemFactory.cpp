@@ -1,5 +1,10 @@
 #include "SystemFactory.h"
 
+/* parasoft-begin-suppress ALL */
+#include <iostream>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
 /**
  * @brief Constructs the PostProcessor by extracting swapchain metadata from the engine.
  */
@@ -19,63 +24,231 @@ std::unique_ptr<PostProcessor> SystemFactory::createPostProcessingSystem(VulkanC
  * @brief Creates the compute-driven Dust system.
  * Spawns in the center of the scene to provide environmental ambiance.
  */
-std::unique_ptr<ParticleSystem> SystemFactory::createDustSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa) {
-    // Hidden knowledge: Specific shader paths for the Dust simulation
-    return std::make_unique<ParticleSystem>(
-        ctx, rp, ctx->globalSetLayout,
-        "./shaders/dust_comp.spv", "./shaders/dust_vert.spv", "./shaders/dust_frag.spv",
-        glm::vec3(0.0f, 1.2f, 0.0f), 1000U, msaa
-    );
+std::unique_ptr<ParticleSystem> SystemFactory::createDustSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, PipelineBuildQueue* const jobs) {
+    return createParticleSystem(ctx, rp, oitRP, msaa, applyEmitterConfig(config, "DustEmitter", dustEmitter()), jobs);
 }
 
 /**
  * @brief Creates the Fire system.
  * Positioned specifically at the camp-fire location in the desert scene.
  */
-std::unique_ptr<ParticleSystem> SystemFactory::createFireSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa) {
-    return std::make_unique<ParticleSystem>(
-        ctx, rp, ctx->globalSetLayout,
-        "./shaders/fire_comp.spv", "./shaders/fire_vert.spv", "./shaders/fire_frag.spv",
-        glm::vec3(-0.8f, -0.15f, -0.5f), 500U, msaa
-    );
+std::unique_ptr<ParticleSystem> SystemFactory::createFireSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, PipelineBuildQueue* const jobs) {
+    return createParticleSystem(ctx, rp, oitRP, msaa, applyEmitterConfig(config, "FireEmitter", fireEmitter()), jobs);
 }
 
 /**
  * @brief Creates the Smoke system.
  * Shares the fire origin but uses a lower particle count for alpha-blending performance.
  */
-std::unique_ptr<ParticleSystem> SystemFactory::createSmokeSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa) {
-    return std::make_unique<ParticleSystem>(
-        ctx, rp, ctx->globalSetLayout,
-        "./shaders/smoke_comp.spv", "./shaders/smoke_vert.spv", "./shaders/smoke_frag.spv",
-        glm::vec3(-0.8f, -0.15f, -0.5f),
-        250U, // Verified count for compute shader dispatch parity
-        msaa
-    );
+std::unique_ptr<ParticleSystem> SystemFactory::createSmokeSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, PipelineBuildQueue* const jobs) {
+    return createParticleSystem(ctx, rp, oitRP, msaa, applyEmitterConfig(config, "SmokeEmitter", smokeEmitter()), jobs);
 }
 
 /**
  * @brief Creates the Rain system.
  * Spawns at the apex of the glass dome for gravity-based simulation.
  */
-std::unique_ptr<ParticleSystem> SystemFactory::createRainSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa) {
-    return std::make_unique<ParticleSystem>(
-        ctx, rp, ctx->globalSetLayout,
-        "./shaders/rain_comp.spv", "./shaders/rain_vert.spv", "./shaders/rain_frag.spv",
-        glm::vec3(0.0f, 1.8f, 0.0f), 5000U, msaa
-    );
+std::unique_ptr<ParticleSystem> SystemFactory::createRainSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, PipelineBuildQueue* const jobs) {
+    return createParticleSystem(ctx, rp, oitRP, msaa, applyEmitterConfig(config, "RainEmitter", rainEmitter()), jobs);
 }
 
 /**
  * @brief Creates the Snow system.
  * Spawns at the apex; uses a 3000U count to balance visibility and GPU overhead.
  */
-std::unique_ptr<ParticleSystem> SystemFactory::createSnowSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa) {
-    return std::make_unique<ParticleSystem>(
-        ctx, rp, ctx->globalSetLayout,
-        "./shaders/snow_comp.spv", "./shaders/snow_vert.spv", "./shaders/snow_frag.spv",
-        glm::vec3(0.0f, 1.8f, 0.0f), 3000U, msaa
-    );
+std::unique_ptr<ParticleSystem> SystemFactory::createSnowSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, PipelineBuildQueue* const jobs) {
+    return createParticleSystem(ctx, rp, oitRP, msaa, applyEmitterConfig(config, "SnowEmitter", snowEmitter()), jobs);
+}
+
+/**
+ * @brief Builds the unified engine over the five emitters (dust, fire, smoke, rain, snow, in that state order).
+ * The unified path is optional, so an unsupported device or a failed setup is logged and yields nullptr.
+ */
+std::unique_ptr<ParticleEngine> SystemFactory::createParticleEngine(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, const uint32_t framesInFlight,
+    PipelineBuildQueue* const jobs)
+{
+    if (!ParticleEngine::isSupported(ctx)) {
+        std::cerr << "SystemFactory: Unified particles need multiDrawIndirect and drawIndirectFirstInstance; using the per-system path" << std::endl;
+        return nullptr;
+    }
+
+    const std::vector<EmitterDefinition> emitters = {
+        applyEmitterConfig(config, "DustEmitter", dustEmitter()),
+        applyEmitterConfig(config, "FireEmitter", fireEmitter()),
+        applyEmitterConfig(config, "SmokeEmitter", smokeEmitter()),
+        applyEmitterConfig(config, "RainEmitter", rainEmitter()),
+        applyEmitterConfig(config, "SnowEmitter", snowEmitter())
+    };
+
+    try {
+        auto engine = std::make_unique<ParticleEngine>(ctx, rp, ctx->globalSetLayout, emitters, msaa, framesInFlight, jobs);
+        engine->createOitPipeline(oitRP, "./shaders/particle_unified_oit_frag.spv", jobs);
+        engine->enableLightReadback(jobs);
+        return engine;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "SystemFactory: Unified particles unavailable (" << e.what() << ")" << std::endl;
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Built-in Dust emitter: the vortex spawns on a ring whose outer radius is spawnRadius.
+ */
+EmitterDefinition SystemFactory::dustEmitter() {
+    EmitterDefinition dust{};
+    dust.shaderSet = "dust";
+    dust.spawnPos = glm::vec3(0.0f, 1.2f, 0.0f);
+    dust.spawnRadius = 0.6f;
+    dust.count = 1000U;
+    dust.depthSort = true;
+    return dust;
+}
+
+/**
+ * @brief Built-in Fire emitter at the camp-fire.
+ */
+EmitterDefinition SystemFactory::fireEmitter() {
+    EmitterDefinition fire{};
+    fire.shaderSet = "fire";
+    fire.spawnPos = glm::vec3(-0.8f, -0.15f, -0.5f);
+    fire.spawnRadius = 0.01f;
+    fire.count = 500U;
+    fire.compressedShaders = true;
+    return fire;
+}
+
+/**
+ * @brief Built-in Smoke emitter, sharing the fire origin.
+ */
+EmitterDefinition SystemFactory::smokeEmitter() {
+    EmitterDefinition smoke{};
+    smoke.shaderSet = "smoke";
+    smoke.spawnPos = glm::vec3(-0.8f, -0.15f, -0.5f);
+    smoke.spawnRadius = 0.025f;
+    smoke.count = 250U;
+    smoke.compressedShaders = true;
+    smoke.depthSort = true;
+    return smoke;
+}
+
+/**
+ * @brief Built-in Rain emitter at the apex of the glass dome.
+ */
+EmitterDefinition SystemFactory::rainEmitter() {
+    EmitterDefinition rain{};
+    rain.shaderSet = "rain";
+    rain.spawnPos = glm::vec3(0.0f, 1.8f, 0.0f);
+    rain.spawnRadius = 1.65f;   // Upper hemisphere of the globe, just inside the glass
+    rain.count = 5000U;
+    return rain;
+}
+
+/**
+ * @brief Built-in Snow emitter at the apex of the glass dome.
+ */
+EmitterDefinition SystemFactory::snowEmitter() {
+    EmitterDefinition snow{};
+    snow.shaderSet = "snow";
+    snow.spawnPos = glm::vec3(0.0f, 1.8f, 0.0f);
+    snow.spawnRadius = 1.65f;
+    snow.count = 3000U;
+    return snow;
+}
+
+/**
+ * @brief Overrides the built-in emitter definition with its config section.
+ * Absent keys other than pos keep their defaults; counts and workgroup sizes are read as whole numbers.
+ */
+EmitterDefinition SystemFactory::applyEmitterConfig(const std::map<std::string, ObjectTransform>& config, const std::string& section,
+    const EmitterDefinition& defaults)
+{
+    EmitterDefinition emitter = defaults;
+    const auto found = config.find(section);
+    if (found == config.end()) {
+        return emitter;
+    }
+
+    const ObjectTransform& cfg = found->second;
+    const auto shaders = cfg.labels.find("shaders");
+    if ((shaders != cfg.labels.end()) && (shaders->second != emitter.shaderSet)) {
+        emitter.shaderSet = shaders->second;
+        emitter.compressedShaders = false;   // A custom set declares its SoA builds below
+    }
+
+    // Like any config object, a section without pos places its emitter at the origin
+    emitter.spawnPos = cfg.pos;
+
+    const auto count = cfg.params.find("count");
+    if ((count != cfg.params.end()) && (count->second >= 1.0f)) {
+        emitter.count = static_cast<uint32_t>(count->second);
+    }
+
+    const auto radius = cfg.params.find("spawnRadius");
+    if (radius != cfg.params.end()) {
+        emitter.spawnRadius = radius->second;
+    }
+
+    const auto groupSize = cfg.params.find("workgroupSize");
+    if ((groupSize != cfg.params.end()) && (groupSize->second >= 1.0f)) {
+        emitter.workgroupSize = static_cast<uint32_t>(groupSize->second);
+    }
+
+    const auto budget = cfg.params.find("spawnBudget");
+    if ((budget != cfg.params.end()) && (budget->second >= 0.0f)) {
+        emitter.spawnBudget = static_cast<uint32_t>(budget->second);
+    }
+
+    const auto compressed = cfg.params.find("compressedShaders");
+    if (compressed != cfg.params.end()) {
+        emitter.compressedShaders = (compressed->second != 0.0f);
+    }
+
+    const auto sorted = cfg.params.find("depthSort");
+    if (sorted != cfg.params.end()) {
+        emitter.depthSort = (sorted->second != 0.0f);
+    }
+
+    const auto hostSimulated = cfg.params.find("cpuSimulation");
+    if (hostSimulated != cfg.params.end()) {
+        emitter.cpuSimulation = (hostSimulated->second != 0.0f);
+    }
+
+    const auto layout = cfg.labels.find("layout");
+    if (layout != cfg.labels.end()) {
+        if (layout->second == "soa") {
+            if (emitter.compressedShaders) {
+                emitter.layout = ParticleLayout::CompressedSoA;
+            }
+            else {
+                std::cerr << "SystemFactory: " << section << " has no SoA shader builds; keeping the interleaved layout" << std::endl;
+            }
+        }
+        else if (layout->second == "interleaved") {
+            emitter.layout = ParticleLayout::Interleaved;
+        }
+        else {
+            std::cerr << "SystemFactory: Unknown particle layout '" << layout->second << "' in " << section << std::endl;
+        }
+    }
+    return emitter;
+}
+
+/**
+ * @brief Builds a particle system from a resolved definition; the OIT shader follows the set's naming.
+ */
+std::unique_ptr<ParticleSystem> SystemFactory::createParticleSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+    const VkSampleCountFlagBits msaa, const EmitterDefinition& emitter, PipelineBuildQueue* const jobs)
+{
+    auto system = std::make_unique<ParticleSystem>(ctx, rp, ctx->globalSetLayout, emitter, msaa, jobs);
+    system->createOitPipeline(oitRP, emitter.shaderPath("oit_frag"), jobs);
+    return system;
 }
 
 /**
@@ -10,8 +10,10 @@
 #include "VulkanEngine.h"
 #include "PostProcessor.h"
 #include "ParticleSystem.h"
+#include "ParticleEngine.h"
 #include "PointLight.h"
 #include "ClimateManager.h"
+#include "ConfigLoader.h"
 
 /**
  * @class SystemFactory
@@ -22,6 +24,9 @@
 class SystemFactory final {
 public:
     // --- Factory Methods ---
+    // Particle factories accept an optional PipelineBuildQueue to defer their pipeline compilation.
+    // Each system also builds its weighted OIT variant against oitRP (optional; skipped if the shader is missing).
+    // Their built-in emitter definitions are overridden by the matching "<Name>Emitter" section of the config.
 
     /**
      * @brief Instantiates the HDR Post-Processing stack.
@@ -29,19 +34,37 @@ public:
     static std::unique_ptr<PostProcessor>  createPostProcessingSystem(VulkanContext* const ctx, VulkanEngine* const eng);
 
     /** @brief Creates the compute-driven Dust particle system. */
-    static std::unique_ptr<ParticleSystem> createDustSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa);
+    static std::unique_ptr<ParticleSystem> createDustSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config,
+        PipelineBuildQueue* const jobs = nullptr);
 
     /** @brief Creates the Fire particle system (Additively blended). */
-    static std::unique_ptr<ParticleSystem> createFireSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa);
+    static std::unique_ptr<ParticleSystem> createFireSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config,
+        PipelineBuildQueue* const jobs = nullptr);
 
     /** @brief Creates the Smoke particle system (Alpha blended). */
-    static std::unique_ptr<ParticleSystem> createSmokeSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa);
+    static std::unique_ptr<ParticleSystem> createSmokeSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config,
+        PipelineBuildQueue* const jobs = nullptr);
 
     /** @brief Creates the Rain particle system with velocity-aligned stretching. */
-    static std::unique_ptr<ParticleSystem> createRainSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa);
+    static std::unique_ptr<ParticleSystem> createRainSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config,
+        PipelineBuildQueue* const jobs = nullptr);
 
     /** @brief Creates the Snow particle system with oscillating horizontal drift. */
-    static std::unique_ptr<ParticleSystem> createSnowSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkSampleCountFlagBits msaa);
+    static std::unique_ptr<ParticleSystem> createSnowSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config,
+        PipelineBuildQueue* const jobs = nullptr);
+
+    /**
+     * @brief Creates the unified particle engine over the same five emitters (config overrides included).
+     * Returns nullptr if the device lacks multi-draw indirect support or the engine cannot be set up.
+     */
+    static std::unique_ptr<ParticleEngine> createParticleEngine(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const std::map<std::string, ObjectTransform>& config, const uint32_t framesInFlight,
+        PipelineBuildQueue* const jobs = nullptr);
 
     /**
      * @brief Instantiates a dynamic Point Light.
@@ -51,7 +74,28 @@ public:
     /** @brief Creates the logic manager for day/night cycles and weather state. */
     static std::unique_ptr<ClimateManager> createClimateSystem();
 
+    /**
+     * @brief Overrides an emitter definition with the config section of the given name, if present.
+     * Recognised keys: shaders (label), pos (always applied), count, spawnRadius, workgroupSize, spawnBudget,
+     * layout (label: "interleaved" or "soa"), compressedShaders (non-zero if a custom set has SoA builds)
+     * and depthSort (non-zero to draw back to front).
+     * A compressed layout requested for a set without SoA builds is logged and ignored.
+     */
+    static EmitterDefinition applyEmitterConfig(const std::map<std::string, ObjectTransform>& config, const std::string& section,
+        const EmitterDefinition& defaults);
+
 private:
+    /** @brief Builds a particle system and its OIT variant from a resolved emitter definition. */
+    static std::unique_ptr<ParticleSystem> createParticleSystem(VulkanContext* const ctx, const VkRenderPass rp, const VkRenderPass oitRP,
+        const VkSampleCountFlagBits msaa, const EmitterDefinition& emitter, PipelineBuildQueue* const jobs);
+
+    // Built-in emitter definitions, before the config overrides
+    static EmitterDefinition dustEmitter();
+    static EmitterDefinition fireEmitter();
+    static EmitterDefinition smokeEmitter();
+    static EmitterDefinition rainEmitter();
+    static EmitterDefinition snowEmitter();
+
     // Static utility class: Constructor and Destructor are private to prevent instantiation.
     SystemFactory() = default;
     ~SystemFactory() = default;
@@ -5,6 +5,8 @@
 /* parasoft-end-suppress ALL */
 
 #include "SimpleAllocator.h"
+#include "DeletionQueue.h"
+#include "PipelineCache.h"
 
 /**
  * @struct VulkanContext
@@ -33,10 +35,22 @@ struct VulkanContext {
     // 5. Global Layouts
     VkDescriptorSetLayout globalSetLayout{ VK_NULL_HANDLE };
     VkDescriptorSetLayout materialSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorSetLayout objectSetLayout{ VK_NULL_HANDLE };   /**< Set 2: per-object matrices, indexed by gl_InstanceIndex. */
 
     // 6. Sub-Allocation System
     SimpleAllocator allocator{};
 
+    // 7. Deferred Destruction (resources retired while frames are still in flight)
+    DeletionQueue deletionQueue{};
+
+    // 8. Persistent Pipeline Cache (shared by every pipeline build, saved across runs)
+    PipelineCache pipelineCache{};
+
+    // 9. Optional Device Capabilities (queried and enabled at logical device creation)
+    bool multiDrawIndirect{ false };
+    bool drawIndirectFirstInstance{ false };
+    PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount{ nullptr }; /**< Null unless VK_KHR_draw_indirect_count is enabled. */
+
     // --- MRM.49 Compliance: Explicitly delete copy operations ---
 
     /** @brief Default constructor for standard initialization. */
@@ -59,6 +59,13 @@ VulkanEngine::~VulkanEngine() {
     if (context != nullptr && context->device != VK_NULL_HANDLE) {
         // Step 1: Wait for GPU to finish all in-flight work
         static_cast<void>(vkDeviceWaitIdle(context->device));
+
+        // Step 2: Persist the pipeline cache for the next launch
+        try {
+            context->pipelineCache.save();
+        }
+        catch (...) {}
+        context->pipelineCache.cleanup();
     }
 }
 
@@ -76,6 +83,7 @@ void VulkanEngine::initVulkan(GLFWwindow* const window) {
     // Step 1: Detect hardware-specific capabilities
     depthFormat = findDepthFormat();
     initAllocator();
+    initPipelineCache();
 
     // Step 2: Initialize presentation resources
     createSwapChain(window);
@@ -227,17 +235,28 @@ void VulkanEngine::createLogicalDevice() {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
-    // Step 2: Enable required hardware features
+    // Step 2: Enable required hardware features, plus the optional ones used by GPU-driven rendering
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(context->physicalDevice, &supportedFeatures);
+
     VkPhysicalDeviceFeatures deviceFeatures{};
     deviceFeatures.samplerAnisotropy = VK_TRUE; // Critical for PBR texture quality
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+
+    std::vector<const char*> enabledExtensions = deviceExtensions;
+    const bool drawIndirectCount = isDeviceExtensionAvailable(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (drawIndirectCount) {
+        enabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
 
     // Step 3: Define Logical Device creation info
     VkDeviceCreateInfo createInfo{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -255,6 +274,32 @@ void VulkanEngine::createLogicalDevice() {
     vkGetDeviceQueue(context->device, queueIndices.graphicsFamily.value(), 0U, &context->graphicsQueue);
     vkGetDeviceQueue(context->device, queueIndices.presentFamily.value(), 0U, &context->presentQueue);
     vkGetDeviceQueue(context->device, queueIndices.transferFamily.value(), 0U, &context->transferQueue);
+
+    // Step 5: Publish the optional capabilities that were actually enabled
+    context->multiDrawIndirect = (deviceFeatures.multiDrawIndirect == VK_TRUE);
+    context->drawIndirectFirstInstance = (deviceFeatures.drawIndirectFirstInstance == VK_TRUE);
+    if (drawIndirectCount) {
+        context->cmdDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(context->device, "vkCmdDrawIndexedIndirectCountKHR"));
+    }
+}
+
+/**
+ * @brief Returns true if the selected physical device exposes the named device extension.
+ */
+bool VulkanEngine::isDeviceExtensionAvailable(const char* const extensionName) const {
+    uint32_t extensionCount{ 0U };
+    static_cast<void>(vkEnumerateDeviceExtensionProperties(context->physicalDevice, nullptr, &extensionCount, nullptr));
+
+    std::vector<VkExtensionProperties> available(extensionCount);
+    static_cast<void>(vkEnumerateDeviceExtensionProperties(context->physicalDevice, nullptr, &extensionCount, available.data()));
+
+    for (const VkExtensionProperties& extension : available) {
+        if (std::strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -264,6 +309,13 @@ void VulkanEngine::initAllocator() {
     context->allocator.init(context->device, context->physicalDevice, EngineConstants::VRAM_POOL_SIZE);
 }
 
+/**
+ * @brief Creates the shared pipeline cache, warm-starting it from the previous run when possible.
+ */
+void VulkanEngine::initPipelineCache() {
+    context->pipelineCache.init(context->device, context->physicalDevice);
+}
+
 // ========================================================================
 // SECTION 4: SWAPCHAIN & PRESENTATION INFRASTRUCTURE
 // ========================================================================
@@ -271,7 +323,7 @@ void VulkanEngine::initAllocator() {
 /**
  * @brief Negotiates hardware capabilities and creates the VkSwapchainKHR.
  */
-void VulkanEngine::createSwapChain(GLFWwindow* const window) {
+void VulkanEngine::createSwapChain(GLFWwindow* const window, const VkSwapchainKHR oldSwapChain) {
     // Step 1: Query current hardware support and negotiate surface settings
     const SwapChainSupportDetails swapChainSupport = querySwapChainSupport(context->physicalDevice);
 
@@ -335,6 +387,9 @@ void VulkanEngine::createSwapChain(GLFWwindow* const window) {
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
 
+    // Chaining the retired swapchain lets the presentation engine hand over images without a stall
+    createInfo.oldSwapchain = oldSwapChain;
+
     VkSwapchainKHR newSwapChain{ VK_NULL_HANDLE };
     if (vkCreateSwapchainKHR(context->device, &createInfo, nullptr, &newSwapChain) != VK_SUCCESS) {
         throw std::runtime_error("VulkanEngine: Failed to create hardware swap chain.");
@@ -435,6 +490,8 @@ VkFormat VulkanEngine::findDepthFormat() const {
 
 /**
  * @brief Recreates the swapchain and all resolution-dependent resources.
+ * Old presentation resources are retired instead of destroyed, so frames still in flight
+ * keep valid framebuffers and the GPU is never drained.
  */
 void VulkanEngine::recreateSwapChain(GLFWwindow* const window) {
     int width{ 0 }, height{ 0 };
@@ -445,13 +502,22 @@ void VulkanEngine::recreateSwapChain(GLFWwindow* const window) {
         glfwWaitEvents();
     }
 
-    vkDeviceWaitIdle(context->device);
-    cleanupSwapChain();
+    // Step 1: Detach the current presentation objects; their destructors run once in-flight frames retire
+    std::shared_ptr<SwapChain> retiredSwapChain = std::move(swapChainObj);
+    std::shared_ptr<Image> retiredDepth = std::move(depthBuffer);
+    swapChainObj = std::make_unique<SwapChain>(context);
 
-    createSwapChain(window);
+    // Step 2: Build the replacement chain, handing the old one over as oldSwapchain
+    createSwapChain(window, retiredSwapChain->getHandle());
     createImageViews();
     createDepthResources();
     createFramebuffers();
+
+    // Step 3: Defer destruction of the old framebuffers, views, depth image and swapchain handle
+    context->deletionQueue.retire([retiredSwapChain, retiredDepth]() mutable {
+        retiredSwapChain.reset();
+        retiredDepth.reset();
+    });
 }
 
 // ========================================================================
@@ -63,7 +63,11 @@ public:
 
     // --- High-Level Interface ---
 
-    /** @brief Rebuilds the Swapchain and dependent resources after a window resize event. */
+    /**
+     * @brief Rebuilds the Swapchain and dependent resources after a window resize event.
+     * The previous swapchain is handed to the driver as oldSwapchain and retired through the
+     * context's DeletionQueue, so recreation never waits for the device to go idle.
+     */
     void recreateSwapChain(GLFWwindow* const window);
 
     /** @brief Safely destroys all resolution-dependent resources during recreation or shutdown. */
@@ -117,10 +121,12 @@ private:
     void createSurface(GLFWwindow* const window) const;
     void pickPhysicalDevice();
     void createLogicalDevice();
+    bool isDeviceExtensionAvailable(const char* const extensionName) const;
     void initAllocator();
+    void initPipelineCache();
 
     // --- Swapchain Lifecycle Batch ---
-    void createSwapChain(GLFWwindow* const window);
+    void createSwapChain(GLFWwindow* const window, const VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
     void createImageViews();
     void createDepthResources();
     void createRenderPass();
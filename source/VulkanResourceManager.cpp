@@ -3,6 +3,7 @@
 /* parasoft-begin-suppress ALL */
 #include <array>
 #include <stdexcept>
+#include <utility>
 /* parasoft-end-suppress ALL */
 
 // ========================================================================
@@ -42,7 +43,7 @@ VulkanResourceManager::~VulkanResourceManager() {
  */
 void VulkanResourceManager::init(const VulkanEngine* const engine, const uint32_t maxFrames) {
     // Step 1: Establish Layouts and Infrastructure Pools
-    createLayouts();
+    createLayouts(context);
     createPools(engine);
 
     // Step 2: Allocate Dedicated Shadow Mapping Hardware
@@ -58,6 +59,10 @@ void VulkanResourceManager::init(const VulkanEngine* const engine, const uint32_
 
     // Step 5: Allocate Primary Graphics Command Buffers
     syncManager->allocateCommandBuffers(context, context->graphicsCommandPool, maxFrames);
+
+    // Step 6: Per-Worker Pools for parallel pass recording
+    syncManager->createSecondaryPools(context, engine->getQueueFamilyIndices().graphicsFamily.value(),
+        maxFrames, SyncManager::RECORDING_WORKER_COUNT);
 }
 
 // ========================================================================
@@ -65,13 +70,14 @@ void VulkanResourceManager::init(const VulkanEngine* const engine, const uint32_
 // ========================================================================
 
 /**
- * @brief Creates global descriptor set layouts for scene and material data.
+ * @brief Creates global descriptor set layouts for scene, material and per-object data.
  */
-void VulkanResourceManager::createLayouts() const {
-    // Step 1: Global Set (Set 0) - Shared across all shaders (UBOs, Shadows, Refraction)
+void VulkanResourceManager::createLayouts(VulkanContext* const ctx) {
+    // Step 1: Global Set (Set 0) - Shared across all shaders (UBOs, Shadows, Refraction, Scene Depth, Snow Cover, Wind Field)
+    // The particle simulations bind it too (as their Set 1) to sample the wind and collide with the scene depth.
     const VkDescriptorSetLayoutBinding uboBinding{
         EngineConstants::BINDING_UBO, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1U,
-        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT, nullptr
     };
 
     const VkDescriptorSetLayoutBinding shadowBinding{
@@ -84,12 +90,29 @@ void VulkanResourceManager::createLayouts() const {
         VK_SHADER_STAGE_FRAGMENT_BIT, nullptr
     };
 
-    const std::array<VkDescriptorSetLayoutBinding, 3U> bindings = { uboBinding, shadowBinding, refractionBinding };
+    const VkDescriptorSetLayoutBinding sceneDepthBinding{
+        EngineConstants::BINDING_SCENE_DEPTH, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1U,
+        VK_SHADER_STAGE_COMPUTE_BIT, nullptr
+    };
+
+    const VkDescriptorSetLayoutBinding snowCoverBinding{
+        EngineConstants::BINDING_SNOW_COVER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U,
+        VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr
+    };
+
+    const VkDescriptorSetLayoutBinding windFieldBinding{
+        EngineConstants::BINDING_WIND_FIELD, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1U,
+        VK_SHADER_STAGE_COMPUTE_BIT, nullptr
+    };
+
+    const std::array<VkDescriptorSetLayoutBinding, 6U> bindings = {
+        uboBinding, shadowBinding, refractionBinding, sceneDepthBinding, snowCoverBinding, windFieldBinding
+    };
     VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
     layoutInfo.pBindings = bindings.data();
 
-    if (vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &context->globalSetLayout) != VK_SUCCESS) {
+    if (vkCreateDescriptorSetLayout(ctx->device, &layoutInfo, nullptr, &ctx->globalSetLayout) != VK_SUCCESS) {
         throw std::runtime_error("VulkanResourceManager: Failed to create global descriptor set layout!");
     }
 
@@ -103,9 +126,22 @@ void VulkanResourceManager::createLayouts() const {
     matLayoutInfo.bindingCount = static_cast<uint32_t>(matBindings.size());
     matLayoutInfo.pBindings = matBindings.data();
 
-    if (vkCreateDescriptorSetLayout(context->device, &matLayoutInfo, nullptr, &context->materialSetLayout) != VK_SUCCESS) {
+    if (vkCreateDescriptorSetLayout(ctx->device, &matLayoutInfo, nullptr, &ctx->materialSetLayout) != VK_SUCCESS) {
         throw std::runtime_error("VulkanResourceManager: Failed to create material descriptor set layout!");
     }
+
+    // Step 3: Object Set (Set 2) - Per-object model/normal matrices read by the vertex stage
+    const VkDescriptorSetLayoutBinding objectBinding{
+        EngineConstants::BINDING_OBJECTS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1U, VK_SHADER_STAGE_VERTEX_BIT, nullptr
+    };
+
+    VkDescriptorSetLayoutCreateInfo objectLayoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    objectLayoutInfo.bindingCount = 1U;
+    objectLayoutInfo.pBindings = &objectBinding;
+
+    if (vkCreateDescriptorSetLayout(ctx->device, &objectLayoutInfo, nullptr, &ctx->objectSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanResourceManager: Failed to create object descriptor set layout!");
+    }
 }
 
 /**
@@ -115,12 +151,16 @@ void VulkanResourceManager::createPools(const VulkanEngine* const engine) {
     const uint32_t imageCount = engine->getSwapChainImageCount();
 
     // Step 1: Descriptor Pool for UBOs and Samplers
-    std::array<VkDescriptorPoolSize, 2U> poolSizes{};
-    poolSizes[0] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, imageCount };
-    poolSizes[1] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageCount + (100U * AssetManager::PBR_TEXTURE_COUNT) };
+    // Global sets are sized for several generations so a resize can allocate before the old sets retire.
+    const uint32_t globalSetCount = imageCount * GLOBAL_SET_GENERATIONS;
+    std::array<VkDescriptorPoolSize, 3U> poolSizes{};
+    poolSizes[0] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, globalSetCount };
+    poolSizes[1] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, (globalSetCount * 4U) + (100U * AssetManager::PBR_TEXTURE_COUNT) };
+    poolSizes[2] = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, globalSetCount };
 
     VkDescriptorPoolCreateInfo descPoolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-    descPoolInfo.maxSets = imageCount + 100U;
+    descPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    descPoolInfo.maxSets = globalSetCount + 100U;
     descPoolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     descPoolInfo.pPoolSizes = poolSizes.data();
 
@@ -153,7 +193,7 @@ void VulkanResourceManager::createShadowResources(const VulkanEngine* const engi
     // Step 1: Create Shadow Map Image and View
     VulkanUtils::createImage(context->device, context->physicalDevice, res, res, 1U,
         VK_SAMPLE_COUNT_1_BIT, shadowFormat, VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, shadowImage, shadowImageMemory);
 
     shadowImageView = VulkanUtils::createImageView(context->device, shadowImage, shadowFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 1U);
@@ -186,6 +226,33 @@ void VulkanResourceManager::createShadowResources(const VulkanEngine* const engi
     if (vkCreateFramebuffer(context->device, &fbInfo, nullptr, &shadowFramebuffer) != VK_SUCCESS) {
         throw std::runtime_error("VulkanResourceManager: Failed to create shadow framebuffer!");
     }
+
+    // Step 4: Static Caster Cache
+    // Static casters are rendered here only when the light has turned far enough; every frame the
+    // cache is copied into the sampled map and dynamic casters are drawn over it (load, not clear).
+    VulkanUtils::createImage(context->device, context->physicalDevice, res, res, 1U,
+        VK_SAMPLE_COUNT_1_BIT, shadowFormat, VK_IMAGE_TILING_OPTIMAL,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, staticShadowImage, staticShadowImageMemory);
+
+    staticShadowImageView = VulkanUtils::createImageView(context->device, staticShadowImage, shadowFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 1U);
+
+    staticShadowRenderPass = VulkanUtils::createDepthRenderPass(context->device, shadowFormat,
+        VK_ATTACHMENT_LOAD_OP_CLEAR, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    shadowOverlayRenderPass = VulkanUtils::createDepthRenderPass(context->device, shadowFormat,
+        VK_ATTACHMENT_LOAD_OP_LOAD, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    VkFramebufferCreateInfo staticFbInfo{ VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
+    staticFbInfo.renderPass = staticShadowRenderPass;
+    staticFbInfo.attachmentCount = 1U;
+    staticFbInfo.pAttachments = &staticShadowImageView;
+    staticFbInfo.width = res;
+    staticFbInfo.height = res;
+    staticFbInfo.layers = 1U;
+
+    if (vkCreateFramebuffer(context->device, &staticFbInfo, nullptr, &staticShadowFramebuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanResourceManager: Failed to create static shadow framebuffer!");
+    }
 }
 
 /**
@@ -209,36 +276,60 @@ void VulkanResourceManager::createUniformBuffers(const uint32_t imageCount) {
 /**
  * @brief Links allocated UBOs and shadow maps to the GPU Descriptor Sets.
  */
-void VulkanResourceManager::updateDescriptorSets(const VulkanEngine* const engine, const PostProcessor* const postProcessor) {
+void VulkanResourceManager::updateDescriptorSets(const VulkanEngine* const engine, const PostProcessor* const postProcessor,
+    const SnowCover* const snowCover, const WindField* const windField) {
     const uint32_t imageCount = engine->getSwapChainImageCount();
 
-    // Step 1: Allocate Global Descriptor Sets if registry is empty
-    if (descriptorSets.empty()) {
-        std::vector<VkDescriptorSetLayout> layouts(imageCount, context->globalSetLayout);
-        VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
-        allocInfo.descriptorPool = descriptorPool;
-        allocInfo.descriptorSetCount = imageCount;
-        allocInfo.pSetLayouts = layouts.data();
+    // Step 1: Retire the previous generation; in-flight frames may still have those sets bound
+    if (!descriptorSets.empty()) {
+        const VkDevice device = context->device;
+        const VkDescriptorPool pool = descriptorPool;
+        std::vector<VkDescriptorSet> retiredSets = std::move(descriptorSets);
+        descriptorSets.clear();
+
+        context->deletionQueue.retire([device, pool, retiredSets]() {
+            static_cast<void>(vkFreeDescriptorSets(device, pool, static_cast<uint32_t>(retiredSets.size()), retiredSets.data()));
+        });
+    }
+
+    // Step 2: Allocate a fresh generation of Global Descriptor Sets
+    std::vector<VkDescriptorSetLayout> layouts(imageCount, context->globalSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = imageCount;
+    allocInfo.pSetLayouts = layouts.data();
+
+    descriptorSets.resize(static_cast<size_t>(imageCount));
+    if (vkAllocateDescriptorSets(context->device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+        // Back-to-back resizes exhausted the headroom: drain once and release the retired generations
+        static_cast<void>(vkDeviceWaitIdle(context->device));
+        context->deletionQueue.flush();
 
-        descriptorSets.resize(static_cast<size_t>(imageCount));
         if (vkAllocateDescriptorSets(context->device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
             throw std::runtime_error("VulkanResourceManager: Failed to allocate global descriptor sets!");
         }
     }
 
-    // Step 2: Update each set with its respective UBO, Shadow, and Refraction textures
+    // Step 3: Update each set with its respective UBO, Shadow, Refraction, Scene Depth, Snow Cover and Wind Field resources
     for (uint32_t i = 0U; i < imageCount; ++i) {
         VkDescriptorBufferInfo bInfo{ uniformBuffers[i], 0U, sizeof(UniformBufferObject) };
         VkDescriptorImageInfo sInfo{ shadowSampler, shadowImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
         VkDescriptorImageInfo rInfo{ postProcessor->getBackgroundSampler(), postProcessor->getBackgroundImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        VkDescriptorImageInfo dInfo{ postProcessor->getBackgroundSampler(), postProcessor->getDepthImageView(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+        VkDescriptorBufferInfo cInfo{ snowCover->getBuffer(), 0U, VK_WHOLE_SIZE };
+        VkDescriptorImageInfo wInfo{ windField->getSampler(), windField->getImageView(), VK_IMAGE_LAYOUT_GENERAL };
 
-        std::array<VkWriteDescriptorSet, 3U> writes{};
+        std::array<VkWriteDescriptorSet, 6U> writes{};
         writes[0] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], 0U, 0U, 1U, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bInfo, nullptr };
         writes[1] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], 1U, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &sInfo, nullptr, nullptr };
         writes[2] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], 2U, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &rInfo, nullptr, nullptr };
+        writes[3] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], EngineConstants::BINDING_SCENE_DEPTH, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &dInfo, nullptr, nullptr };
+        writes[4] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], EngineConstants::BINDING_SNOW_COVER, 0U, 1U, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &cInfo, nullptr };
+        writes[5] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[i], EngineConstants::BINDING_WIND_FIELD, 0U, 1U, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &wInfo, nullptr, nullptr };
 
         vkUpdateDescriptorSets(context->device, static_cast<uint32_t>(writes.size()), writes.data(), 0U, nullptr);
     }
+    ++descriptorGeneration;
 }
 
 // ========================================================================
@@ -263,6 +354,13 @@ void VulkanResourceManager::cleanup() {
     vkFreeMemory(context->device, shadowImageMemory, nullptr);
     vkDestroyFramebuffer(context->device, shadowFramebuffer, nullptr);
     vkDestroyRenderPass(context->device, shadowRenderPass, nullptr);
+    vkDestroyRenderPass(context->device, shadowOverlayRenderPass, nullptr);
+
+    vkDestroyFramebuffer(context->device, staticShadowFramebuffer, nullptr);
+    vkDestroyRenderPass(context->device, staticShadowRenderPass, nullptr);
+    vkDestroyImageView(context->device, staticShadowImageView, nullptr);
+    vkDestroyImage(context->device, staticShadowImage, nullptr);
+    vkFreeMemory(context->device, staticShadowImageMemory, nullptr);
 
     // Step 3: Unmap and release Uniform Buffers
     for (size_t i = 0U; i < uniformBuffers.size(); ++i) {
@@ -277,5 +375,6 @@ void VulkanResourceManager::cleanup() {
     vkDestroyCommandPool(context->device, transferCommandPool, nullptr);
     vkDestroyDescriptorSetLayout(context->device, context->globalSetLayout, nullptr);
     vkDestroyDescriptorSetLayout(context->device, context->materialSetLayout, nullptr);
+    vkDestroyDescriptorSetLayout(context->device, context->objectSetLayout, nullptr);
     vkDestroyCommandPool(context->device, context->graphicsCommandPool, nullptr);
 }
\ No newline at end of file
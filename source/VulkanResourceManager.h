@@ -12,6 +12,8 @@
 #include "SyncManager.h"
 #include "AssetManager.h"
 #include "PostProcessor.h"
+#include "SnowCover.h"
+#include "WindField.h"
 
 /**
  * @class VulkanResourceManager
@@ -22,6 +24,11 @@
  */
 class VulkanResourceManager final {
 public:
+    // --- Named Constants ---
+
+    /** @brief Generations of global descriptor sets the pool can hold while retired sets await destruction. */
+    static constexpr uint32_t GLOBAL_SET_GENERATIONS = 3U;
+
     // --- Lifecycle ---
 
     /** @brief Constructor: Links the manager to the centralized Vulkan hardware context. */
@@ -39,8 +46,11 @@ public:
     /** @brief Initializes the resource manager and child synchronization systems. */
     void init(const VulkanEngine* const engine, const uint32_t maxFrames);
 
-    /** @brief Defines the Descriptor Set Layouts for global UBO access. */
-    void createLayouts() const;
+    /**
+     * @brief Defines the Descriptor Set Layouts for global UBO access.
+     * Static so that HeadlessDevice creates the same layouts without an engine or swapchain.
+     */
+    static void createLayouts(VulkanContext* const ctx);
 
     /** @brief Reserves memory pools for command recording and descriptor allocation. */
     void createPools(const VulkanEngine* const engine);
@@ -51,8 +61,14 @@ public:
     /** @brief Allocates and maps memory for the per-frame Uniform Buffer Objects (UBO). */
     void createUniformBuffers(const uint32_t imageCount);
 
-    /** @brief Links allocated UBOs and shadow maps to the GPU Descriptor Sets. */
-    void updateDescriptorSets(const VulkanEngine* const engine, const PostProcessor* const postProcessor);
+    /**
+     * @brief Links allocated UBOs and shadow maps to the GPU Descriptor Sets.
+     * On subsequent calls (e.g. after a resize) a fresh generation of sets is allocated and the
+     * previous one is retired, since sets bound by in-flight frames must not be rewritten.
+     * The scene depth and the snow cover are bound for the particle simulations' collision, the wind field for their motion.
+     */
+    void updateDescriptorSets(const VulkanEngine* const engine, const PostProcessor* const postProcessor,
+        const SnowCover* const snowCover, const WindField* const windField);
 
     /** @brief Safely releases all managed Vulkan handles and mapped memory. */
     void cleanup();
@@ -68,6 +84,9 @@ public:
     /** @brief Returns the Descriptor Set (Set 0) for a specific frame index. */
     VkDescriptorSet getDescriptorSet(uint32_t index) const { return descriptorSets[index]; }
 
+    /** @brief Returns how many times the global sets were (re)written; a freed handle may come back with new contents. */
+    uint64_t getDescriptorGeneration() const { return descriptorGeneration; }
+
     /** @brief Returns the CPU-mapped pointer for writing UBO data for a specific frame. */
     void* getMappedBuffer(uint32_t index) const { return uniformBuffersMapped[index]; }
 
@@ -77,6 +96,21 @@ public:
     /** @brief Returns the framebuffer target for shadow map generation. */
     VkFramebuffer getShadowFramebuffer() const { return shadowFramebuffer; }
 
+    /** @brief Returns the sampled shadow map image (overwritten each frame from the static cache). */
+    VkImage getShadowImage() const { return shadowImage; }
+
+    /** @brief Returns the pass that draws dynamic casters over the copied static depth. */
+    VkRenderPass getShadowOverlayRenderPass() const { return shadowOverlayRenderPass; }
+
+    /** @brief Returns the pass that re-renders the static caster cache. */
+    VkRenderPass getStaticShadowRenderPass() const { return staticShadowRenderPass; }
+
+    /** @brief Returns the framebuffer wrapping the static caster cache. */
+    VkFramebuffer getStaticShadowFramebuffer() const { return staticShadowFramebuffer; }
+
+    /** @brief Returns the static caster depth cache (copy source between refreshes). */
+    VkImage getStaticShadowImage() const { return staticShadowImage; }
+
 private:
     // --- Context & Synchronization ---
     VulkanContext* context;
@@ -88,6 +122,7 @@ private:
 
     // --- Descriptor State ---
     std::vector<VkDescriptorSet> descriptorSets;
+    uint64_t descriptorGeneration{ 0U };
 
     // --- Uniform Buffer Resources (Per-Frame) ---
     std::vector<VkBuffer> uniformBuffers;
@@ -101,4 +136,12 @@ private:
     VkSampler shadowSampler;
     VkRenderPass shadowRenderPass;
     VkFramebuffer shadowFramebuffer;
+    VkRenderPass shadowOverlayRenderPass{ VK_NULL_HANDLE };
+
+    // --- Static Caster Shadow Cache ---
+    VkImage staticShadowImage{ VK_NULL_HANDLE };
+    VkDeviceMemory staticShadowImageMemory{ VK_NULL_HANDLE };
+    VkImageView staticShadowImageView{ VK_NULL_HANDLE };
+    VkRenderPass staticShadowRenderPass{ VK_NULL_HANDLE };
+    VkFramebuffer staticShadowFramebuffer{ VK_NULL_HANDLE };
 };
\ No newline at end of file
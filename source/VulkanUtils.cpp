@@ -1,6 +1,7 @@
 #include "VulkanUtils.h"
 
 /* parasoft-begin-suppress ALL */
+#include <array>
 #include <stdexcept>
 #include <cstring>
 /* parasoft-end-suppress ALL */
@@ -104,6 +105,33 @@ void VulkanUtils::copyBuffer(const VkDevice device, const VkCommandPool commandP
     endSingleTimeCommands(device, commandPool, graphicsQueue, cb);
 }
 
+/**
+ * @brief Creates a device-local buffer and uploads its initial contents through a temporary staging buffer.
+ */
+void VulkanUtils::createDeviceLocalBuffer(const VkDevice device, const VkPhysicalDevice physicalDevice, const VkCommandPool commandPool,
+    const VkQueue graphicsQueue, const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+    VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+{
+    VkBuffer stagingBuffer{ VK_NULL_HANDLE };
+    VkDeviceMemory stagingMemory{ VK_NULL_HANDLE };
+    createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        stagingBuffer, stagingMemory);
+
+    void* mapped{ nullptr };
+    static_cast<void>(vkMapMemory(device, stagingMemory, 0ULL, size, 0U, &mapped));
+    static_cast<void>(std::memcpy(mapped, data, static_cast<size_t>(size)));
+    vkUnmapMemory(device, stagingMemory);
+
+    createBuffer(device, physicalDevice, size, (usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        buffer, bufferMemory);
+
+    copyBuffer(device, commandPool, graphicsQueue, stagingBuffer, buffer, size);
+
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingMemory, nullptr);
+}
+
 // ========================================================================
 // SECTION 3: IMAGE & TEXTURE MANAGEMENT
 // ========================================================================
@@ -295,7 +323,8 @@ void VulkanUtils::transitionImageLayout(const VkDevice device, const VkCommandPo
  * @brief Records a memory barrier into an existing command buffer.
  */
 void VulkanUtils::recordImageBarrier(VkCommandBuffer cb, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
-    VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, uint32_t mipLevels)
+    VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, uint32_t mipLevels,
+    const VkImageAspectFlags aspect)
 {
     VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
     barrier.oldLayout = oldLayout;
@@ -303,7 +332,7 @@ void VulkanUtils::recordImageBarrier(VkCommandBuffer cb, VkImage image, VkImageL
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.image = image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.aspectMask = aspect;
     barrier.subresourceRange.baseMipLevel = 0U;
     barrier.subresourceRange.levelCount = mipLevels;
     barrier.subresourceRange.baseArrayLayer = 0U;
@@ -343,14 +372,18 @@ void VulkanUtils::createTextureSampler(const VkDevice device, VkSampler& sampler
 /**
  * @brief Specialized factory for Shadow Map RenderPasses.
  */
-VkRenderPass VulkanUtils::createDepthRenderPass(const VkDevice device, const VkFormat depthFormat) {
+VkRenderPass VulkanUtils::createDepthRenderPass(const VkDevice device, const VkFormat depthFormat,
+    const VkAttachmentLoadOp loadOp, const VkImageLayout initialLayout, const VkImageLayout finalLayout)
+{
     VkAttachmentDescription dAttr{};
     dAttr.format = depthFormat;
     dAttr.samples = VK_SAMPLE_COUNT_1_BIT;
-    dAttr.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    dAttr.loadOp = loadOp;
     dAttr.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    dAttr.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    dAttr.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    dAttr.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    dAttr.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    dAttr.initialLayout = initialLayout;
+    dAttr.finalLayout = finalLayout;
 
     VkAttachmentReference depthRef{ 0U, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
 
@@ -358,11 +391,30 @@ VkRenderPass VulkanUtils::createDepthRenderPass(const VkDevice device, const VkF
     sub.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     sub.pDepthStencilAttachment = &depthRef;
 
+    // Prior sampling or copies of the map finish before depth writes; depth writes finish before the
+    // map is sampled or copied. This covers the cached-map refresh, the copy, and the overlay pass.
+    std::array<VkSubpassDependency, 2U> dependencies{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0U;
+    dependencies[0].srcStageMask = (VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+    dependencies[0].dstStageMask = (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+    dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    dependencies[0].dstAccessMask = (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+    dependencies[1].srcSubpass = 0U;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[1].dstStageMask = (VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+    dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstAccessMask = (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+
     VkRenderPassCreateInfo passInfo{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
     passInfo.attachmentCount = 1U;
     passInfo.pAttachments = &dAttr;
     passInfo.subpassCount = 1U;
     passInfo.pSubpasses = &sub;
+    passInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    passInfo.pDependencies = dependencies.data();
 
     VkRenderPass pass{ VK_NULL_HANDLE };
     if (vkCreateRenderPass(device, &passInfo, nullptr, &pass) != VK_SUCCESS) {
@@ -451,4 +503,30 @@ VkPipelineDepthStencilStateCreateInfo VulkanUtils::prepareDepthStencil(VkBool32
     info.depthWriteEnable = depthWrite;
     info.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
     return info;
+}
+
+std::array<VkPipelineColorBlendAttachmentState, 2U> VulkanUtils::prepareWeightedOitBlend() {
+    std::array<VkPipelineColorBlendAttachmentState, 2U> states{};
+
+    // Accumulation: sum of w * (premultiplied rgb, alpha)
+    states[0].colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    states[0].blendEnable = VK_TRUE;
+    states[0].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    states[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    states[0].colorBlendOp = VK_BLEND_OP_ADD;
+    states[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    states[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    states[0].alphaBlendOp = VK_BLEND_OP_ADD;
+
+    // Revealage: product of (1 - alpha), the shader writes alpha into the single red channel
+    states[1].colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+    states[1].blendEnable = VK_TRUE;
+    states[1].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+    states[1].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+    states[1].colorBlendOp = VK_BLEND_OP_ADD;
+    states[1].srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    states[1].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    states[1].alphaBlendOp = VK_BLEND_OP_ADD;
+
+    return states;
 }
\ No newline at end of file
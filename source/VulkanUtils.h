@@ -2,6 +2,7 @@
 
 /* parasoft-begin-suppress ALL */
 #include "libs.h"
+#include <array>
 #include <vector>
 #include <string>
 /* parasoft-end-suppress ALL */
@@ -52,6 +53,11 @@ public:
     static void copyBuffer(const VkDevice device, const VkCommandPool commandPool, const VkQueue graphicsQueue,
         const VkBuffer srcBuffer, const VkBuffer dstBuffer, const VkDeviceSize size);
 
+    /** @brief Creates a device-local buffer (usage plus transfer destination) and fills it through a staging buffer. */
+    static void createDeviceLocalBuffer(const VkDevice device, const VkPhysicalDevice physicalDevice, const VkCommandPool commandPool,
+        const VkQueue graphicsQueue, const void* const data, const VkDeviceSize size, const VkBufferUsageFlags usage,
+        VkBuffer& buffer, VkDeviceMemory& bufferMemory);
+
     // --- Image & Texture Management ---
 
     /** @brief Creates a Vulkan image and allocates its backing device memory. */
@@ -92,12 +98,20 @@ public:
 
     // --- Pipeline & Barrier Synchronization ---
 
-    /** @brief Records a high-level image memory barrier for synchronization. */
+    /** @brief Records a high-level image memory barrier for synchronization (colour aspect unless told otherwise). */
     static void recordImageBarrier(VkCommandBuffer cb, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
-        VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, uint32_t mipLevels = 1U);
-
-    /** @brief Creates a minimal render pass used specifically for shadow depth maps. */
-    static VkRenderPass createDepthRenderPass(const VkDevice device, const VkFormat depthFormat);
+        VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, uint32_t mipLevels = 1U,
+        const VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /**
+     * @brief Creates a minimal render pass used specifically for shadow depth maps.
+     * The defaults clear and leave the map ready for sampling; the cached shadow path overrides
+     * them to store into a copy source, or to load a copied map and draw on top of it.
+     */
+    static VkRenderPass createDepthRenderPass(const VkDevice device, const VkFormat depthFormat,
+        const VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        const VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        const VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
     /** @brief Helper to initialize the complex Graphics Pipeline creation structure. */
     static VkGraphicsPipelineCreateInfo preparePipelineCreateInfo(
@@ -119,4 +133,10 @@ public:
     static VkPipelineRasterizationStateCreateInfo prepareRasterizer(VkCullModeFlags cullMode);
     static VkPipelineMultisampleStateCreateInfo prepareMultisampling(VkSampleCountFlagBits samples);
     static VkPipelineDepthStencilStateCreateInfo prepareDepthStencil(VkBool32 depthWrite);
+
+    /**
+     * @brief Blend states of the two weighted OIT targets.
+     * Accumulation (0) adds weighted premultiplied colour; revealage (1) multiplies by (1 - alpha).
+     */
+    static std::array<VkPipelineColorBlendAttachmentState, 2U> prepareWeightedOitBlend();
 };
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "WindField.h"
+
+/* parasoft-begin-suppress ALL */
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+/* parasoft-end-suppress ALL */
+
+#include "PipelineBuildQueue.h"
+#include "ShaderModule.h"
+#include "VulkanUtils.h"
+
+namespace {
+    const char* const UPDATE_SHADER = "./shaders/wind_field_comp.spv";
+}
+
+// ========================================================================
+// SECTION 1: LIFECYCLE MANAGEMENT
+// ========================================================================
+
+/**
+ * @brief Constructor: Creates a still field and prepares the update pass.
+ */
+WindField::WindField(VulkanContext* const inContext, const uint32_t inResolution, const uint32_t inUpdateInterval,
+    PipelineBuildQueue* const buildQueue)
+    : context(inContext),
+    resolution(std::clamp(inResolution, MIN_RESOLUTION, MAX_RESOLUTION)),
+    updateInterval(std::clamp(inUpdateInterval, EngineConstants::COUNT_ONE, MAX_UPDATE_INTERVAL))
+{
+    // Step 1: Zeroed field, left in the general layout for storage writes and sampled reads
+    createField();
+    createDescriptors();
+
+    // Step 2: The update pipeline is optional; without it the air stays still
+    const auto build = [this]() {
+        try {
+            createUpdatePipeline();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "WindField: Wind field updates unavailable (" << e.what() << ")" << std::endl;
+        }
+    };
+
+    if (buildQueue != nullptr) {
+        buildQueue->submit(UPDATE_SHADER, build);
+    }
+    else {
+        build();
+    }
+}
+
+/**
+ * @brief Destructor: Releases every owned GPU object.
+ */
+WindField::~WindField() {
+    if ((context == nullptr) || (context->device == VK_NULL_HANDLE)) {
+        return;
+    }
+
+    vkDestroyPipeline(context->device, updatePipeline, nullptr);
+    vkDestroyPipelineLayout(context->device, updatePipelineLayout, nullptr);
+    vkDestroyDescriptorPool(context->device, updateDescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(context->device, updateSetLayout, nullptr);
+    vkDestroySampler(context->device, fieldSampler, nullptr);
+    vkDestroyImageView(context->device, fieldView, nullptr);
+    vkDestroyImage(context->device, fieldImage, nullptr);
+    vkFreeMemory(context->device, fieldMemory, nullptr);
+}
+
+/**
+ * @brief Sets the sampling scale; the simulations read it from the scene UBO.
+ */
+void WindField::setStrength(const float inStrength) {
+    if (inStrength >= 0.0f) {
+        strength = inStrength;
+    }
+}
+
+// ========================================================================
+// SECTION 2: PER-FRAME RECORDING
+// ========================================================================
+
+/**
+ * @brief Records the rebuild between two compute barriers, every updateInterval-th call.
+ * The entry barrier orders it after the previous frames' samples; the exit barrier orders this
+ * frame's samples after it. Frames that skip the rebuild sample the last result.
+ */
+void WindField::recordUpdate(const VkCommandBuffer commandBuffer, const float stormInfluence, const float windPhase,
+    const glm::vec3& firePos, const bool fireActive)
+{
+    if (updatePipeline == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // Step 1: Bounded cost - only every updateInterval-th frame rebuilds
+    if (framesUntilUpdate > 0U) {
+        --framesUntilUpdate;
+        return;
+    }
+    framesUntilUpdate = updateInterval - 1U;
+    ++updateCount;
+
+    // Step 2: Previous samples -> rebuild
+    VulkanUtils::recordImageBarrier(commandBuffer, fieldImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+        VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    // Step 3: One invocation per cell
+    const FieldPushConstants params{
+        glm::vec4(firePos, fireActive ? UPDRAFT_SPEED : 0.0f), stormInfluence, windPhase
+    };
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, updatePipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, updatePipelineLayout,
+        EngineConstants::INDEX_ZERO, EngineConstants::COUNT_ONE, &updateDescriptorSet, EngineConstants::OFFSET_ZERO, nullptr);
+    vkCmdPushConstants(commandBuffer, updatePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, EngineConstants::OFFSET_ZERO,
+        static_cast<uint32_t>(sizeof(FieldPushConstants)), &params);
+
+    const uint32_t groups = (resolution + WORKGROUP_SIZE - 1U) / WORKGROUP_SIZE;
+    vkCmdDispatch(commandBuffer, groups, groups, groups);
+
+    // Step 4: Rebuild -> this frame's simulations
+    VulkanUtils::recordImageBarrier(commandBuffer, fieldImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
+// ========================================================================
+// SECTION 3: READBACK
+// ========================================================================
+
+/**
+ * @brief Copies the image into a host-visible buffer and unpacks its half floats.
+ */
+void WindField::readBack(std::vector<glm::vec4>& cells) const {
+    // Step 1: Staging for the tightly packed texels
+    const size_t cellCount = static_cast<size_t>(resolution) * resolution * resolution;
+    const VkDeviceSize stagingSize = static_cast<VkDeviceSize>(cellCount) * TEXEL_SIZE;
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    VulkanUtils::createBuffer(context->device, context->physicalDevice, stagingSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), staging, stagingMemory);
+
+    // Step 2: Rebuilds -> copy -> host reads; the image stays in the general layout throughout
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+    VulkanUtils::recordImageBarrier(cb, fieldImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+        (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT), VK_ACCESS_TRANSFER_READ_BIT,
+        (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT), VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = EngineConstants::COUNT_ONE;
+    region.imageExtent = { resolution, resolution, resolution };
+    vkCmdCopyImageToBuffer(cb, fieldImage, VK_IMAGE_LAYOUT_GENERAL, staging, EngineConstants::COUNT_ONE, &region);
+
+    VkMemoryBarrier hostBarrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cb, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        static_cast<VkDependencyFlags>(EngineConstants::OFFSET_ZERO), EngineConstants::COUNT_ONE, &hostBarrier, 0U, nullptr, 0U, nullptr);
+
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+
+    // Step 3: Two packed half pairs per texel
+    void* mapped = nullptr;
+    static_cast<void>(vkMapMemory(context->device, stagingMemory, 0ULL, VK_WHOLE_SIZE, 0U, &mapped));
+    std::vector<uint32_t> halves(cellCount * 2U);
+    static_cast<void>(std::memcpy(halves.data(), mapped, static_cast<size_t>(stagingSize)));
+    vkUnmapMemory(context->device, stagingMemory);
+    vkDestroyBuffer(context->device, staging, nullptr);
+    vkFreeMemory(context->device, stagingMemory, nullptr);
+
+    cells.resize(cellCount);
+    for (size_t i = 0U; i < cellCount; ++i) {
+        cells[i] = glm::vec4(glm::unpackHalf2x16(halves[i * 2U]), glm::unpackHalf2x16(halves[(i * 2U) + 1U]));
+    }
+}
+
+// ========================================================================
+// SECTION 4: INTERNAL INITIALIZATION
+// ========================================================================
+
+/**
+ * @brief Creates the field image (device-local, storage and sampled, copied back by readBack()) and clears it to still air.
+ */
+void WindField::createField() {
+    // Step 1: A single-mip 3D image; createImage() only makes 2D ones
+    VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    imageInfo.imageType = VK_IMAGE_TYPE_3D;
+    imageInfo.format = FORMAT;
+    imageInfo.extent = { resolution, resolution, resolution };
+    imageInfo.mipLevels = EngineConstants::COUNT_ONE;
+    imageInfo.arrayLayers = EngineConstants::COUNT_ONE;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(context->device, &imageInfo, nullptr, &fieldImage) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to create wind field image!");
+    }
+
+    VkMemoryRequirements memRequirements{};
+    vkGetImageMemoryRequirements(context->device, fieldImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = VulkanUtils::findMemoryType(context->physicalDevice, memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (vkAllocateMemory(context->device, &allocInfo, nullptr, &fieldMemory) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to allocate wind field memory!");
+    }
+    static_cast<void>(vkBindImageMemory(context->device, fieldImage, fieldMemory, EngineConstants::OFFSET_ZERO));
+
+    // Step 2: View and a clamped, filtered sampler (particles outside the box see the nearest face)
+    fieldView = VulkanUtils::createImageView(context->device, fieldImage, FORMAT, VK_IMAGE_ASPECT_COLOR_BIT,
+        EngineConstants::COUNT_ONE, VK_IMAGE_VIEW_TYPE_3D);
+    VulkanUtils::createTextureSampler(context->device, fieldSampler, EngineConstants::COUNT_ONE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+
+    // Step 3: Still air until the first rebuild, in the layout it keeps for good
+    const VkCommandBuffer cb = VulkanUtils::beginSingleTimeCommands(context->device, context->graphicsCommandPool);
+    VulkanUtils::recordImageBarrier(cb, fieldImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+        0U, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    const VkClearColorValue still{ { 0.0f, 0.0f, 0.0f, 0.0f } };
+    VkImageSubresourceRange range{};
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.levelCount = EngineConstants::COUNT_ONE;
+    range.layerCount = EngineConstants::COUNT_ONE;
+    vkCmdClearColorImage(cb, fieldImage, VK_IMAGE_LAYOUT_GENERAL, &still, EngineConstants::COUNT_ONE, &range);
+
+    VulkanUtils::recordImageBarrier(cb, fieldImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+        VK_ACCESS_TRANSFER_WRITE_BIT, (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT),
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    VulkanUtils::endSingleTimeCommands(context->device, context->graphicsCommandPool, context->graphicsQueue, cb);
+}
+
+/**
+ * @brief Creates the update set (binding 0: the field as a storage image).
+ */
+void WindField::createDescriptors() {
+    const VkDescriptorSetLayoutBinding fieldBinding{
+        BINDING_FIELD, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, EngineConstants::COUNT_ONE, VK_SHADER_STAGE_COMPUTE_BIT, nullptr
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutInfo.bindingCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pBindings = &fieldBinding;
+
+    if (vkCreateDescriptorSetLayout(context->device, &layoutInfo, nullptr, &updateSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to create update descriptor set layout!");
+    }
+
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, EngineConstants::COUNT_ONE };
+    VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.maxSets = EngineConstants::COUNT_ONE;
+    poolInfo.poolSizeCount = EngineConstants::COUNT_ONE;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(context->device, &poolInfo, nullptr, &updateDescriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to create update descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = updateDescriptorPool;
+    allocInfo.descriptorSetCount = EngineConstants::COUNT_ONE;
+    allocInfo.pSetLayouts = &updateSetLayout;
+
+    if (vkAllocateDescriptorSets(context->device, &allocInfo, &updateDescriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to allocate update descriptor set!");
+    }
+
+    const VkDescriptorImageInfo imageInfo{ VK_NULL_HANDLE, fieldView, VK_IMAGE_LAYOUT_GENERAL };
+    VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = updateDescriptorSet;
+    write.dstBinding = BINDING_FIELD;
+    write.descriptorCount = EngineConstants::COUNT_ONE;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(context->device, EngineConstants::COUNT_ONE, &write, 0U, nullptr);
+}
+
+/**
+ * @brief Compiles the update compute pipeline.
+ */
+void WindField::createUpdatePipeline() {
+    const ShaderModule updateShader(context, UPDATE_SHADER, VK_SHADER_STAGE_COMPUTE_BIT);
+
+    const VkPushConstantRange pushRange{
+        VK_SHADER_STAGE_COMPUTE_BIT, EngineConstants::OFFSET_ZERO, static_cast<uint32_t>(sizeof(FieldPushConstants))
+    };
+
+    VkPipelineLayoutCreateInfo layoutInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pSetLayouts = &updateSetLayout;
+    layoutInfo.pushConstantRangeCount = EngineConstants::COUNT_ONE;
+    layoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(context->device, &layoutInfo, nullptr, &updatePipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to create update pipeline layout!");
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage = updateShader.getStageInfo();
+    pipelineInfo.layout = updatePipelineLayout;
+
+    if (context->pipelineCache.createComputePipelines(EngineConstants::COUNT_ONE, &pipelineInfo, &updatePipeline) != VK_SUCCESS) {
+        throw std::runtime_error("WindField: Failed to create wind field compute pipeline!");
+    }
+}
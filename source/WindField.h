@@ -0,0 +1,130 @@
+#pragma once
+
+/* parasoft-begin-suppress ALL */
+#include "libs.h"
+#include <cstdint>
+#include <vector>
+/* parasoft-end-suppress ALL */
+
+#include "VulkanContext.h"
+
+class PipelineBuildQueue;
+
+/**
+ * @class WindField
+ * @brief Low-resolution 3D field of air velocities that every particle simulation samples.
+ * * A resolution^3 RGBA16F image (wind_field.glsl) spans the globe's bounding box. A compute pass
+ * rebuilds it from the climate state: the storm influence scales a prevailing breeze and curl-noise
+ * gusts, the wind phase moves them, and a burning fire adds its updraft. The pass runs once every
+ * updateInterval frames, so its cost stays bounded; the image keeps the last result in between.
+ * * The image stays in the general layout and is bound in the global set (Set 0), which the
+ * simulations bind as their Set 1. The build pipeline is optional: without it the field stays
+ * still (zero) and the particles move as before.
+ */
+class WindField final {
+public:
+    // --- Named Constants ---
+    static constexpr uint32_t DEFAULT_RESOLUTION = 16U;
+    static constexpr uint32_t MIN_RESOLUTION = 4U;
+    static constexpr uint32_t MAX_RESOLUTION = 64U;
+    static constexpr uint32_t DEFAULT_UPDATE_INTERVAL = 2U;   /**< Frames between two rebuilds. */
+    static constexpr uint32_t MAX_UPDATE_INTERVAL = 60U;
+    static constexpr float DEFAULT_STRENGTH = 1.0f;
+    static constexpr uint32_t WORKGROUP_SIZE = 4U;            /**< Mirrors wind_field.comp's local size (per axis). */
+    static constexpr float HALF_EXTENT = 1.8f;                /**< Mirrors WIND_FIELD_HALF_EXTENT (the globe's radius). */
+    static constexpr float UPDRAFT_SPEED = 0.4f;              /**< Rise above a burning fire, world units per second. */
+    static constexpr uint32_t BINDING_FIELD = 0U;
+    static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+    static constexpr VkDeviceSize TEXEL_SIZE = 8U;            /**< Bytes per FORMAT texel (four halves). */
+
+    // --- Lifecycle ---
+
+    /**
+     * @brief Creates the zeroed field and queues (or builds) its update pipeline.
+     * Out-of-range resolutions and intervals are clamped to [MIN_RESOLUTION, MAX_RESOLUTION] and [1, MAX_UPDATE_INTERVAL].
+     * @param buildQueue Optional queue the pipeline is compiled on; built immediately if null.
+     */
+    WindField(VulkanContext* const inContext, const uint32_t inResolution, const uint32_t inUpdateInterval,
+        PipelineBuildQueue* const buildQueue = nullptr);
+
+    /** @brief Destructor: Releases the image, the sampler, the descriptors and the pipeline. */
+    ~WindField();
+
+    // RAII: Owns GPU memory; prevent duplication.
+    WindField(const WindField&) = delete;
+    WindField& operator=(const WindField&) = delete;
+
+    // --- Per-Frame ---
+
+    /**
+     * @brief Records the rebuild if it is due this frame, between the previous readers and this frame's simulations.
+     * @param stormInfluence ClimateManager::getStormInfluence().
+     * @param windPhase Curl-noise time offset (ClimateManager::getWindPhase()).
+     * @param firePos Base of the fire's updraft; fireActive off leaves the updraft out.
+     */
+    void recordUpdate(const VkCommandBuffer commandBuffer, const float stormInfluence, const float windPhase,
+        const glm::vec3& firePos, const bool fireActive);
+
+    // --- Configuration ---
+
+    /** @brief Sets the scale the simulations apply to the field (negative values are ignored). */
+    void setStrength(const float inStrength);
+
+    // --- Validation ---
+
+    /**
+     * @brief Copies the field back to the host as resolution^3 velocities, x fastest, then y, then z
+     * (the strength is not applied). Idles the graphics queue: for validation, never per frame.
+     */
+    void readBack(std::vector<glm::vec4>& cells) const;
+
+    // --- Accessors ---
+
+    VkImageView getImageView() const { return fieldView; }
+    VkSampler getSampler() const { return fieldSampler; }
+    float getStrength() const { return strength; }
+    uint32_t getResolution() const { return resolution; }
+    uint32_t getUpdateInterval() const { return updateInterval; }
+
+    /** @brief Returns the number of rebuilds recorded so far. */
+    uint64_t getUpdateCount() const { return updateCount; }
+
+    /** @brief Returns true once the update pipeline exists. */
+    bool canUpdate() const { return updatePipeline != VK_NULL_HANDLE; }
+
+private:
+    /** @brief Mirror of wind_field.comp's push constant block. */
+    struct FieldPushConstants {
+        glm::vec4 updraft;   /**< Fire position (xyz) and updraft speed (w). */
+        float storm;
+        float noiseTime;
+    };
+
+    /** @brief Creates the 3D image, its view and sampler, and clears it in the general layout. */
+    void createField();
+
+    /** @brief Creates the update set layout, pool and set pointing at the image. */
+    void createDescriptors();
+
+    /** @brief Compiles the update compute pipeline (device objects only; safe on a build worker). */
+    void createUpdatePipeline();
+
+    // --- Internal State ---
+    VulkanContext* context;
+    uint32_t resolution;
+    uint32_t updateInterval;
+    float strength{ DEFAULT_STRENGTH };
+    uint32_t framesUntilUpdate{ 0U };   /**< Zero: the next recordUpdate() rebuilds. */
+    uint64_t updateCount{ 0U };
+
+    VkImage fieldImage{ VK_NULL_HANDLE };
+    VkDeviceMemory fieldMemory{ VK_NULL_HANDLE };
+    VkImageView fieldView{ VK_NULL_HANDLE };
+    VkSampler fieldSampler{ VK_NULL_HANDLE };
+
+    VkDescriptorSetLayout updateSetLayout{ VK_NULL_HANDLE };
+    VkDescriptorPool updateDescriptorPool{ VK_NULL_HANDLE };
+    VkDescriptorSet updateDescriptorSet{ VK_NULL_HANDLE };
+    VkPipelineLayout updatePipelineLayout{ VK_NULL_HANDLE };
+    VkPipeline updatePipeline{ VK_NULL_HANDLE };
+};
@@ -1,36 +1,98 @@
 /* parasoft-begin-suppress ALL */
 #include "Experience.h"
+#include "HeadlessDevice.h"
+#include "IndirectDrawValidator.h"
+#include "OcclusionTest.h"
+#include "ParticleValidator.h"
+#include "RenderGraphTest.h"
 #include <iostream>
 #include <stdexcept>
 #include <cstdlib> // For EXIT_SUCCESS/FAILURE
+#include <string>
 /* parasoft-end-suppress ALL */
 
 /**
  * @brief Vulkan Lab Entry Point.
  * Orchestrates the high-level lifecycle of the Sandy-Snow Globe engine.
- * * @return EXIT_SUCCESS on clean shutdown, EXIT_FAILURE on critical exception.
+ * * With "--validate-particles [steps]" the particle simulations are checked against their CPU ports
+ * (see ParticleValidator), and "--validate-indirect" checks the GPU-driven cull pass on a synthetic
+ * scene, comparing its compacted draws with the CPU FrustumCuller (see IndirectDrawValidator). Both
+ * only need a device, not a window: they share one HeadlessDevice and the program exits afterwards.
+ * "--test-occlusion" checks OcclusionCuller against a ray cast of a fixed scene; it needs no window or
+ * device, so on its own it exits before the engine is created (see OcclusionTest). "--test-render-graph" likewise
+ * checks the transient memory placement of the render graph on synthetic requests (see RenderGraphTest).
+ * * @return EXIT_SUCCESS on clean shutdown (or a passed validation), EXIT_FAILURE on critical exception.
  */
-int main() {
+int main(int argc, char** argv) {
     // 1. Return Code Initialization
     int returnCode = EXIT_SUCCESS;
 
+    bool validateParticles = false;
+    bool validateIndirect = false;
+    bool testOcclusion = false;
+    bool testRenderGraph = false;
+    uint32_t validationSteps = ParticleValidator::DEFAULT_STEPS;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--validate-particles") {
+            validateParticles = true;
+            if (((i + 1) < argc) && (std::strtoul(argv[i + 1], nullptr, 10) > 0UL)) {
+                validationSteps = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+                ++i;
+            }
+        }
+        else if (std::string(argv[i]) == "--validate-indirect") {
+            validateIndirect = true;
+        }
+        else if (std::string(argv[i]) == "--test-occlusion") {
+            testOcclusion = true;
+        }
+        else if (std::string(argv[i]) == "--test-render-graph") {
+            testRenderGraph = true;
+        }
+        else {
+            // Unknown arguments are ignored
+        }
+    }
+
     try {
-        // 2. Centralized Window Initialization Constants
-        static constexpr uint32_t WINDOW_WIDTH = 1280U;
-        static constexpr uint32_t WINDOW_HEIGHT = 720U;
-        static constexpr char const* WINDOW_TITLE = "Vulkan Lab: Sandy-Snow Globe (Audited)";
-
-        // 3. Initialize the Experience
-        // RAII: The 'app' object owns all sub-systems. Construction handles 
-        // the full Vulkan handshake and asset loading sequence.
-        Experience app(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
-
-        // 4. Execution
-        // Enters the primary OS message loop and simulation update cycle.
-        app.run();
+        // 2. CPU-only tests run first, without a window or device
+        const bool occlusionPassed = !testOcclusion || OcclusionTest::report(std::cout, OcclusionTest::run());
+        const bool renderGraphPassed = !testRenderGraph || RenderGraphTest::report(std::cout, RenderGraphTest::run());
+        const bool cpuTestsPassed = occlusionPassed && renderGraphPassed;
+
+        // 3. Device-only validations run on a headless device, without a window or swapchain
+        bool indirectPassed = true;
+        bool particlesPassed = true;
+        if (validateIndirect || validateParticles) {
+            HeadlessDevice headless{};
+            if (validateIndirect) {
+                indirectPassed = IndirectDrawValidator::run(headless.getContext(), std::cout);
+            }
+            if (validateParticles) {
+                particlesPassed = ParticleValidator::report(std::cout, headless.getContext(),
+                    ParticleValidator::run(headless.getContext(), validationSteps));
+            }
+        }
+        returnCode = (cpuTestsPassed && indirectPassed && particlesPassed) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+        if (!(testOcclusion || testRenderGraph || validateIndirect || validateParticles)) {
+            // 4. Centralized Window Initialization Constants
+            static constexpr uint32_t WINDOW_WIDTH = 1280U;
+            static constexpr uint32_t WINDOW_HEIGHT = 720U;
+            static constexpr char const* WINDOW_TITLE = "Vulkan Lab: Sandy-Snow Globe (Audited)";
+
+            // 5. Initialize the Experience
+            // RAII: The 'app' object owns all sub-systems. Construction handles 
+            // the full Vulkan handshake and asset loading sequence.
+            Experience app(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
+
+            // 6. Execution
+            // Enters the primary OS message loop and simulation update cycle.
+            app.run();
+        }
     }
     catch (const std::exception& e) {
-        // 5. High-Integrity Exception Handling
+        // 7. High-Integrity Exception Handling
         // Mandatory bracing for audit compliance and clear failure reporting.
         std::cerr << std::endl << "[CRITICAL ENGINE FAILURE]" << std::endl;
         std::cerr << "Location: main.cpp" << std::endl;